@@ -1592,6 +1592,7 @@ class VectorValues {
   bool equals(const gtsam::VectorValues& expected, double tol) const;
   void insert(size_t j, Vector value);
   Vector vector() const;
+  Vector vector(const gtsam::KeyVector& keys) const;
   Vector at(size_t j) const;
   void update(const gtsam::VectorValues& values);
 
@@ -3237,6 +3238,7 @@ namespace utilities {
   Matrix extractPose2(const gtsam::Values& values);
   gtsam::Values allPose3s(gtsam::Values& values);
   Matrix extractPose3(const gtsam::Values& values);
+  Matrix extractVectors(const gtsam::Values& values, char c);
   void perturbPoint2(gtsam::Values& values, double sigma, int seed);
   void perturbPose2 (gtsam::Values& values, double sigmaT, double sigmaR, int seed);
   void perturbPoint3(gtsam::Values& values, double sigma, int seed);
@@ -0,0 +1,139 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    Arena.h
+ * @brief   A simple chunked bump allocator for short-lived, same-lifetime objects
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A chunked bump ("arena") allocator.  Memory is carved out of large chunks
+ * with a simple pointer increment, and is released wholesale by reset() or the
+ * destructor - individual deallocation is a no-op.  This makes it suitable for
+ * the many small, identical-lifetime allocations performed in each iteration
+ * of an optimizer, e.g. the JacobianFactors created by
+ * NonlinearFactorGraph::linearize.  An Arena is *not* thread-safe; use one
+ * arena per thread.
+ *
+ * @addtogroup base
+ */
+class Arena : private boost::noncopyable {
+ public:
+  /// Create an arena that requests memory in chunks of the given size
+  explicit Arena(size_t chunkSize = 1048576)
+      : chunkSize_(chunkSize), free_(0), remaining_(0) {}
+
+  ~Arena() {
+    for (char* chunk : chunks_) free(chunk);
+  }
+
+  /// Allocate raw memory with the given alignment (must be a power of two)
+  void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+    assert((alignment & (alignment - 1)) == 0);
+    // Round the bump pointer up to the requested alignment
+    size_t padding = (alignment - reinterpret_cast<size_t>(free_)) & (alignment - 1);
+    if (bytes + padding > remaining_) {
+      newChunk(bytes + alignment);
+      padding = (alignment - reinterpret_cast<size_t>(free_)) & (alignment - 1);
+    }
+    char* result = free_ + padding;
+    free_ = result + bytes;
+    remaining_ -= bytes + padding;
+    return result;
+  }
+
+  /**
+   * Release all allocations at once.  The chunks themselves are kept so that
+   * the next round of allocations (e.g. the next optimizer iteration) is
+   * served without going to the system allocator at all.
+   */
+  void reset() {
+    if (chunks_.empty()) return;
+    // Only the first chunk is retained; keeping all of them would make the
+    // bump pointer logic more complex for little gain once sizes stabilize.
+    for (size_t i = 1; i < chunks_.size(); ++i) free(chunks_[i]);
+    chunks_.resize(1);
+    chunkSizes_.resize(1);
+    free_ = chunks_.front();
+    remaining_ = chunkSizes_.front();
+  }
+
+  /// Total bytes currently held in chunks (allocated from the system)
+  size_t capacity() const {
+    size_t total = 0;
+    for (size_t size : chunkSizes_) total += size;
+    return total;
+  }
+
+ private:
+  void newChunk(size_t minimumSize) {
+    const size_t size = minimumSize > chunkSize_ ? minimumSize : chunkSize_;
+    char* chunk = static_cast<char*>(malloc(size));
+    if (!chunk) throw std::bad_alloc();
+    chunks_.push_back(chunk);
+    chunkSizes_.push_back(size);
+    free_ = chunk;
+    remaining_ = size;
+  }
+
+  size_t chunkSize_;               ///< Preferred size of newly requested chunks
+  std::vector<char*> chunks_;      ///< All chunks requested from the system
+  std::vector<size_t> chunkSizes_; ///< Size of each chunk in chunks_
+  char* free_;                     ///< Bump pointer into the current chunk
+  size_t remaining_;               ///< Bytes left in the current chunk
+};
+
+/**
+ * An STL-compatible allocator that draws from an Arena.  deallocate() is a
+ * no-op; memory is reclaimed when the arena is reset or destroyed, which must
+ * outlive any container or shared_ptr using this allocator.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  explicit ArenaAllocator(Arena& arena) : arena_(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, size_t) {} // Reclaimed wholesale by Arena::reset()
+
+  Arena* arena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const { return arena_ == other.arena(); }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const { return arena_ != other.arena(); }
+
+ private:
+  Arena* arena_;
+};
+
+}  // namespace gtsam
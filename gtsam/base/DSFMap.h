@@ -18,9 +18,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>  // Provides size_t
+#include <deque>
 #include <map>
 #include <set>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace gtsam {
 
@@ -112,6 +118,124 @@ class DSFMap {
   }
 };
 
+/**
+ * High-throughput alternative to DSFMap for segmentation-scale workloads
+ * such as SfM track formation.  Keys are interned once into contiguous
+ * indices; the forest itself is a flat array of atomic parent indices, so
+ * find() uses lock-free path splitting and merge() a compare-and-swap union
+ * by index.  After all keys are interned (intern() or the bulk merge have
+ * run), find() and merge() are safe to call from several threads at once;
+ * interning itself is not thread-safe.
+ * @addtogroup base
+ */
+template <class KEY>
+class ConcurrentDSFMap {
+ protected:
+  typedef typename std::map<KEY, size_t> IndexTable;
+  IndexTable indexOf_;           ///< Key-interning table
+  std::vector<KEY> keys_;        ///< inverse of the interning table
+  /// flat forest of parent indices; a deque keeps addresses stable as keys
+  /// are interned, and path splitting mutates it from const find()
+  mutable std::deque<std::atomic<size_t> > parent_;
+
+  /// Given index, find the root index, splitting paths as we go
+  size_t findIndex(size_t i) const {
+    for (;;) {
+      size_t p = parent_[i].load(std::memory_order_relaxed);
+      if (p == i) return i;
+      const size_t gp = parent_[p].load(std::memory_order_relaxed);
+      if (gp != p)  // point i past its parent; losing a race is harmless
+        parent_[i].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      i = gp;
+    }
+  }
+
+  /// Merge the sets of two interned indices, lock-free
+  void mergeIndices(size_t x, size_t y) {
+    for (;;) {
+      size_t xRoot = findIndex(x), yRoot = findIndex(y);
+      if (xRoot == yRoot) return;
+      // the smaller index stays representative, which keeps the forest
+      // acyclic under concurrent unions
+      if (xRoot > yRoot) std::swap(xRoot, yRoot);
+      size_t expected = yRoot;
+      if (parent_[yRoot].compare_exchange_strong(expected, xRoot,
+          std::memory_order_acq_rel))
+        return;
+      // lost a race: yRoot is no longer a root, retry with fresh roots
+    }
+  }
+
+ public:
+  typedef std::set<KEY> Set;
+
+  /// constructor
+  ConcurrentDSFMap() {}
+
+  /// Intern a key, returning its index; not thread-safe
+  size_t intern(const KEY& key) {
+    typename IndexTable::iterator it = indexOf_.find(key);
+    if (it != indexOf_.end()) return it->second;
+    const size_t index = keys_.size();
+    indexOf_.insert(std::make_pair(key, index));
+    keys_.push_back(key);
+    parent_.emplace_back(index);
+    return index;
+  }
+
+  /// Given key, find the representative key for the set in which it lives
+  KEY find(const KEY& key) const {
+    typename IndexTable::const_iterator it = indexOf_.find(key);
+    if (it == indexOf_.end()) return key;  // un-interned keys are singletons
+    return keys_[findIndex(it->second)];
+  }
+
+  /// Merge two sets, interning keys as needed (then not thread-safe)
+  void merge(const KEY& x, const KEY& y) {
+    mergeIndices(intern(x), intern(y));
+  }
+
+  /**
+   * Bulk merge: interns all keys sequentially, then partitions the pairs
+   * over worker threads that merge concurrently
+   */
+  void merge(const std::vector<std::pair<KEY, KEY> >& pairs) {
+    typedef std::pair<size_t, size_t> IndexPair_;
+    std::vector<IndexPair_> indexPairs;
+    indexPairs.reserve(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i)
+      indexPairs.push_back(
+          IndexPair_(intern(pairs[i].first), intern(pairs[i].second)));
+
+    size_t nrThreads = std::thread::hardware_concurrency();
+    if (nrThreads < 2 || indexPairs.size() < 2 * nrThreads) {
+      for (size_t i = 0; i < indexPairs.size(); ++i)
+        mergeIndices(indexPairs[i].first, indexPairs[i].second);
+      return;
+    }
+    std::vector<std::thread> workers;
+    const size_t chunk = (indexPairs.size() + nrThreads - 1) / nrThreads;
+    for (size_t t = 0; t < nrThreads; ++t) {
+      const size_t begin = t * chunk,
+          end = std::min(begin + chunk, indexPairs.size());
+      if (begin >= end) break;
+      workers.push_back(std::thread([this, &indexPairs, begin, end]() {
+        for (size_t i = begin; i < end; ++i)
+          mergeIndices(indexPairs[i].first, indexPairs[i].second);
+      }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+  }
+
+  /// return all sets, i.e. a partition of all interned keys
+  std::map<KEY, Set> sets() const {
+    std::map<KEY, Set> sets;
+    for (size_t i = 0; i < keys_.size(); ++i)
+      sets[keys_[findIndex(i)]].insert(keys_[i]);
+    return sets;
+  }
+};
+
 /// Small utility class for representing a wrappable pairs of ints.
 class IndexPair : public std::pair<size_t,size_t> {
  public:
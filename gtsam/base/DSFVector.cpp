@@ -42,12 +42,18 @@ DSFBase::DSFBase(const boost::shared_ptr<V>& v_in) {
 
 /* ************************************************************************* */
 size_t DSFBase::find(size_t key) const {
-  // follow parent pointers until we reach set representative
-  size_t parent = (*v_)[key];
-  if (parent != key)
-    parent = find(parent); // recursive call
-  (*v_)[key] = parent; // path compression
-  return parent;
+  // Follow parent pointers with path halving: every other node on the path
+  // is re-pointed at its grandparent, so the path shrinks while we walk it.
+  // Unlike the previous recursive full compression this is iterative (no
+  // deep recursion on long chains), and every write replaces a parent
+  // pointer with an ancestor of that node, so concurrent finds that race on
+  // these writes still terminate at the correct representative, as long as
+  // no merge runs concurrently.
+  while ((*v_)[key] != key) {
+    (*v_)[key] = (*v_)[(*v_)[key]];
+    key = (*v_)[key];
+  }
+  return key;
 }
 
 /* ************************************************************************* */
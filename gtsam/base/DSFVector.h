@@ -50,7 +50,10 @@ public:
   /// Constructor that uses an existing, pre-allocated vector.
   DSFBase(const boost::shared_ptr<V>& v_in);
 
-  /// Find the label of the set in which {key} lives.
+  /// Find the label of the set in which {key} lives.  Compresses paths by
+  /// halving; safe to call from several threads at once provided no merge
+  /// runs concurrently, since racing writes only shortcut parent pointers
+  /// to ancestors.
   size_t find(size_t key) const;
 
   /// Merge the sets containing i1 and i2. Does nothing if i1 and i2 are already in the same set.
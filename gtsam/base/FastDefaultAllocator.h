@@ -39,30 +39,45 @@
 #  include <memory>
 #endif
 
+#include <atomic>
+#include <cstddef>
+
 namespace gtsam
 {
 
   namespace internal
   {
-    /// Default allocator for list, map, and set types
+    template<typename T, typename BASE>
+    class CountingAllocator;
+
+    /// Default allocator for list, map, and set types.  Define
+    /// GTSAM_ALLOCATOR_AUDIT to wrap the chosen allocator in
+    /// CountingAllocator, so every Fast* container reports its traffic to
+    /// FastAllocatorStats - combined with the per-phase attribution in the
+    /// timing tree this shows which solver phase allocates what.
     template<typename T>
     struct FastDefaultAllocator
     {
 #if defined GTSAM_ALLOCATOR_BOOSTPOOL
-      typedef boost::fast_pool_allocator<T> type;
+      typedef boost::fast_pool_allocator<T> base_type;
       static const bool isBoost = true;
       static const bool isTBB = false;
       static const bool isSTL = false;
 #elif defined GTSAM_ALLOCATOR_TBB
-      typedef tbb::tbb_allocator<T> type;
+      typedef tbb::tbb_allocator<T> base_type;
       static const bool isBoost = false;
       static const bool isTBB = true;
       static const bool isSTL = false;
 #elif defined GTSAM_ALLOCATOR_STL
-      typedef std::allocator<T> type;
+      typedef std::allocator<T> base_type;
       static const bool isBoost = false;
       static const bool isTBB = false;
       static const bool isSTL = true;
+#endif
+#ifdef GTSAM_ALLOCATOR_AUDIT
+      typedef CountingAllocator<T, base_type> type;
+#else
+      typedef base_type type;
 #endif
     };
 
@@ -71,16 +86,111 @@ namespace gtsam
     struct FastDefaultVectorAllocator
     {
 #if defined GTSAM_ALLOCATOR_TBB
-      typedef tbb::tbb_allocator<T> type;
+      typedef tbb::tbb_allocator<T> base_type;
       static const bool isBoost = false;
       static const bool isTBB = true;
       static const bool isSTL = false;
 #else
-      typedef std::allocator<T> type;
+      typedef std::allocator<T> base_type;
       static const bool isBoost = false;
       static const bool isTBB = false;
       static const bool isSTL = true;
 #endif
+#ifdef GTSAM_ALLOCATOR_AUDIT
+      typedef CountingAllocator<T, base_type> type;
+#else
+      typedef base_type type;
+#endif
+    };
+
+    /**
+     * Process-wide counters for Fast* container allocator traffic, updated by
+     * CountingAllocator below.  When allocator contention shows up in a
+     * profile, wrap the suspect container's allocator in CountingAllocator and
+     * compare allocateCalls between runs - a high call count relative to
+     * bytesAllocated means many small node allocations that would benefit from
+     * an arena (see Arena.h).  The counters are relaxed atomics, so enabling
+     * them is cheap enough to leave on in timing runs.
+     */
+    struct FastAllocatorStats
+    {
+      static std::atomic<std::size_t>& allocateCalls() {
+        static std::atomic<std::size_t> count(0);
+        return count;
+      }
+      static std::atomic<std::size_t>& deallocateCalls() {
+        static std::atomic<std::size_t> count(0);
+        return count;
+      }
+      static std::atomic<std::size_t>& bytesAllocated() {
+        static std::atomic<std::size_t> count(0);
+        return count;
+      }
+      /// Bytes currently live through counting allocators (allocated minus freed)
+      static std::atomic<std::size_t>& bytesInUse() {
+        static std::atomic<std::size_t> count(0);
+        return count;
+      }
+      /// The largest value bytesInUse has reached since the last reset(), for
+      /// capacity planning: it bounds the container working set of the section
+      /// being profiled even when the end-of-section footprint is small
+      static std::atomic<std::size_t>& highWaterBytes() {
+        static std::atomic<std::size_t> count(0);
+        return count;
+      }
+      /// Zero all counters, e.g. before the section being profiled
+      static void reset() {
+        allocateCalls() = 0;
+        deallocateCalls() = 0;
+        bytesAllocated() = 0;
+        bytesInUse() = 0;
+        highWaterBytes() = 0;
+      }
+    };
+
+    /**
+     * An allocator adaptor that counts traffic in FastAllocatorStats before
+     * forwarding to the wrapped allocator (the Fast* default if none given).
+     * Intended for profiling: a FastMap<KEY, VALUE, CountingAllocator<...> >
+     * behaves identically to FastMap<KEY, VALUE> but reports its allocations.
+     */
+    template<typename T, typename BASE = typename FastDefaultAllocator<T>::base_type>
+    class CountingAllocator : public BASE
+    {
+    public:
+      typedef T value_type;
+      typedef typename BASE::pointer pointer;
+      typedef typename BASE::size_type size_type;
+
+      template<typename U>
+      struct rebind {
+        typedef CountingAllocator<U, typename BASE::template rebind<U>::other> other;
+      };
+
+      CountingAllocator() {}
+      template<typename U, typename B>
+      CountingAllocator(const CountingAllocator<U, B>& other) : BASE(other) {}
+
+      pointer allocate(size_type n, const void* hint = 0) {
+        FastAllocatorStats::allocateCalls().fetch_add(1, std::memory_order_relaxed);
+        FastAllocatorStats::bytesAllocated().fetch_add(n * sizeof(T), std::memory_order_relaxed);
+        const std::size_t inUse = FastAllocatorStats::bytesInUse().fetch_add(
+            n * sizeof(T), std::memory_order_relaxed) + n * sizeof(T);
+        // Raise the high-water mark if this allocation exceeded it; the loop
+        // resolves races between concurrently allocating threads
+        std::atomic<std::size_t>& highWater = FastAllocatorStats::highWaterBytes();
+        std::size_t previous = highWater.load(std::memory_order_relaxed);
+        while (previous < inUse
+            && !highWater.compare_exchange_weak(previous, inUse, std::memory_order_relaxed)) {
+        }
+        return BASE::allocate(n);
+      }
+
+      void deallocate(pointer p, size_type n) {
+        FastAllocatorStats::deallocateCalls().fetch_add(1, std::memory_order_relaxed);
+        FastAllocatorStats::bytesInUse().fetch_sub(n * sizeof(T), std::memory_order_relaxed);
+        BASE::deallocate(p, n);
+      }
     };
   }
 
@@ -34,22 +34,27 @@ namespace gtsam {
  * percent.
    * @addtogroup base
  */
-template<typename VALUE>
-class FastList: public std::list<VALUE, typename internal::FastDefaultAllocator<VALUE>::type> {
+template<typename VALUE,
+    typename ALLOCATOR = typename internal::FastDefaultAllocator<VALUE>::type>
+class FastList: public std::list<VALUE, ALLOCATOR> {
 
 public:
 
-  typedef std::list<VALUE, typename internal::FastDefaultAllocator<VALUE>::type> Base;
+  typedef std::list<VALUE, ALLOCATOR> Base;
 
   /** Default constructor */
   FastList() {}
 
+  /** Constructor from an allocator instance, for stateful allocators such as
+   * ArenaAllocator that tie the container to a particular arena */
+  explicit FastList(const ALLOCATOR& allocator) : Base(allocator) {}
+
   /** Constructor from a range, passes through to base class */
   template<typename INPUTITERATOR>
   explicit FastList(INPUTITERATOR first, INPUTITERATOR last) : Base(first, last) {}
 
   /** Copy constructor from another FastList */
-  FastList(const FastList<VALUE>& x) : Base(x) {}
+  FastList(const FastList& x) : Base(x) {}
 
   /** Copy constructor from the base list class */
   FastList(const Base& x) : Base(x) {}
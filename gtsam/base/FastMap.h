@@ -33,24 +33,27 @@ namespace gtsam {
  * percent.
  * @addtogroup base
  */
-template<typename KEY, typename VALUE>
-class FastMap : public std::map<KEY, VALUE, std::less<KEY>,
-  typename internal::FastDefaultAllocator<std::pair<const KEY, VALUE> >::type> {
+template<typename KEY, typename VALUE,
+  typename ALLOCATOR = typename internal::FastDefaultAllocator<std::pair<const KEY, VALUE> >::type>
+class FastMap : public std::map<KEY, VALUE, std::less<KEY>, ALLOCATOR> {
 
 public:
 
-  typedef std::map<KEY, VALUE, std::less<KEY>,
-    typename internal::FastDefaultAllocator<std::pair<const KEY, VALUE> >::type > Base;
+  typedef std::map<KEY, VALUE, std::less<KEY>, ALLOCATOR> Base;
 
   /** Default constructor */
   FastMap() {}
 
+  /** Constructor from an allocator instance, for stateful allocators such as
+   * ArenaAllocator that tie the container to a particular arena */
+  explicit FastMap(const ALLOCATOR& allocator) : Base(std::less<KEY>(), allocator) {}
+
   /** Constructor from a range, passes through to base class */
   template<typename INPUTITERATOR>
   explicit FastMap(INPUTITERATOR first, INPUTITERATOR last) : Base(first, last) {}
 
   /** Copy constructor from another FastMap */
-  FastMap(const FastMap<KEY,VALUE>& x) : Base(x) {}
+  FastMap(const FastMap& x) : Base(x) {}
 
   /** Copy constructor from the base map class */
   FastMap(const Base& x) : Base(x) {}
@@ -41,21 +41,26 @@ namespace gtsam {
  * we've seen that the fast_pool_allocator can lead to speedups of several %.
  * @addtogroup base
  */
-template<typename VALUE>
-class FastSet: public std::set<VALUE, std::less<VALUE>,
-    typename internal::FastDefaultAllocator<VALUE>::type> {
+template<typename VALUE,
+    typename ALLOCATOR = typename internal::FastDefaultAllocator<VALUE>::type>
+class FastSet: public std::set<VALUE, std::less<VALUE>, ALLOCATOR> {
 
   BOOST_CONCEPT_ASSERT ((IsTestable<VALUE> ));
 
 public:
 
-  typedef std::set<VALUE, std::less<VALUE>,
-  typename internal::FastDefaultAllocator<VALUE>::type> Base;
+  typedef std::set<VALUE, std::less<VALUE>, ALLOCATOR> Base;
 
   /** Default constructor */
   FastSet() {
   }
 
+  /** Constructor from an allocator instance, for stateful allocators such as
+   * ArenaAllocator that tie the container to a particular arena */
+  explicit FastSet(const ALLOCATOR& allocator) :
+  Base(std::less<VALUE>(), allocator) {
+  }
+
   /** Constructor from a range, passes through to base class */
   template<typename INPUTITERATOR>
   explicit FastSet(INPUTITERATOR first, INPUTITERATOR last) :
@@ -69,7 +74,7 @@ public:
   }
 
   /** Copy constructor from another FastSet */
-  FastSet(const FastSet<VALUE>& x) :
+  FastSet(const FastSet& x) :
   Base(x) {
   }
 
@@ -106,7 +111,7 @@ public:
   }
 
   /** Check for equality within tolerance to implement Testable */
-  bool equals(const FastSet<VALUE>& other, double tol = 1e-9) const {
+  bool equals(const FastSet& other, double tol = 1e-9) const {
     typename Base::const_iterator it1 = this->begin(), it2 = other.begin();
     while (it1 != this->end()) {
       if (it2 == other.end() || !traits<VALUE>::Equals(*it2, *it2, tol))
@@ -25,13 +25,31 @@
 
 #include <boost/make_shared.hpp>
 #include <boost/pool/pool_alloc.hpp>
+#include <boost/pool/singleton_pool.hpp>
 
 #include <cmath>
 #include <iostream>
+#include <new> // placement new
 #include <typeinfo> // operator typeid
 
 namespace gtsam {
 
+namespace internal {
+/// User allocator for the per-type value pools below: obtains pool blocks with
+/// Eigen's aligned allocator so that pooled values satisfy the alignment
+/// requirements of any fixed-size Eigen members they contain.
+struct PooledValueAllocator {
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  static char* malloc(const size_type bytes) {
+    return static_cast<char*>(Eigen::internal::aligned_malloc(bytes));
+  }
+  static void free(char* const block) {
+    Eigen::internal::aligned_free(block);
+  }
+};
+} // namespace internal
+
 /**
  * Wraps any type T so it can play as a Value
  */
@@ -88,19 +106,37 @@ public:
     traits<T>::Print(value_, str);
   }
 
+  /// The footprint of the wrapped object.  Exact for fixed-size types; types
+  /// that own additional heap storage (e.g. dynamically-sized matrices) are
+  /// reported by their in-object size only.
+  virtual size_t memoryUsage() const {
+    return sizeof(*this);
+  }
+
     /**
      * Create a duplicate object returned as a pointer to the generic Value interface.
+     * Allocated from a per-type singleton pool so that same-type values end up
+     * packed into contiguous slabs, keeping iteration over a Values container
+     * with many variables of one type (e.g. a million Point3 landmarks)
+     * cache-friendly.  Must be freed with deallocate_(), *not* 'delete'.
      */
     virtual Value* clone_() const {
-      GenericValue* ptr = new GenericValue(*this); // calls copy constructor to fill in
-      return ptr;
+      typedef boost::singleton_pool<GenericValue, sizeof(GenericValue),
+          internal::PooledValueAllocator> Pool;
+      void* place = Pool::malloc();
+      if (!place)
+        throw std::bad_alloc();
+      return new (place) GenericValue(*this); // calls copy constructor to fill in
     }
 
     /**
      * Destroy and deallocate this object, only if it was originally allocated using clone_().
      */
     virtual void deallocate_() const {
-      delete this;
+      typedef boost::singleton_pool<GenericValue, sizeof(GenericValue),
+          internal::PooledValueAllocator> Pool;
+      this->~GenericValue();
+      Pool::free(const_cast<GenericValue*>(this));
     }
 
     /**
@@ -110,12 +146,18 @@ public:
 		return boost::allocate_shared<GenericValue>(Eigen::aligned_allocator<GenericValue>(), *this);
     }
 
-    /// Generic Value interface version of retract
+    /// Generic Value interface version of retract.  The result comes from the
+    /// same pool as clone_() and must be freed with deallocate_().
     virtual Value* retract_(const Vector& delta) const {
       // Call retract on the derived class using the retract trait function
       const T retractResult = traits<T>::Retract(GenericValue<T>::value(), delta);
 
-      Value* resultAsValue = new GenericValue(retractResult);
+      typedef boost::singleton_pool<GenericValue, sizeof(GenericValue),
+          internal::PooledValueAllocator> Pool;
+      void* place = Pool::malloc();
+      if (!place)
+        throw std::bad_alloc();
+      Value* resultAsValue = new (place) GenericValue(retractResult);
 
       // Return the pointer to the Value base class
       return resultAsValue;
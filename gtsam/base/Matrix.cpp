@@ -483,8 +483,9 @@ void vector_scale_inplace(const Vector& v, Matrix& A, bool inf_mask) {
         A.row(i) *= vi;
     }
   } else {
-    for (DenseIndex i=0; i<m; ++i)
-      A.row(i) *= v(i);
+    // one vectorized pass down each (contiguous) column, rather than strided
+    // row-by-row updates
+    A.array().colwise() *= v.array();
   }
 }
 
@@ -508,8 +509,7 @@ Matrix vector_scale(const Matrix& A, const Vector& v, bool inf_mask) {
         M.col(j) *= vj;
     }
   } else {
-    for (size_t j=0; j<n; ++j)
-      M.col(j) *= v(j);
+    M.array().rowwise() *= v.transpose().array();
   }
   return M;
 }
@@ -633,6 +633,18 @@ void inplace_QR(Matrix& A){
   size_t cols = A.cols();
   size_t size = std::min(rows,cols);
 
+  // Fast path for the small blocks produced by binary factors: the blocked
+  // algorithm below degenerates to a single panel there, so go straight to
+  // the unblocked kernel with a stack-allocated workspace
+  static const size_t kSmallQR = 16;
+  if (rows <= kSmallQR && cols <= kSmallQR) {
+    Eigen::Matrix<double, Eigen::Dynamic, 1, 0, kSmallQR, 1> hCoeffs(size);
+    Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor, 1, kSmallQR> temp(cols);
+    Eigen::internal::householder_qr_inplace_unblocked(A, hCoeffs, temp.data());
+    zeroBelowDiagonal(A);
+    return;
+  }
+
   typedef Eigen::internal::plain_diag_type<Matrix>::type HCoeffsType;
   typedef Eigen::internal::plain_row_type<Matrix>::type RowVectorType;
   HCoeffsType hCoeffs(size);
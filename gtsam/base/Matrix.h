@@ -26,6 +26,7 @@
 #include <gtsam/base/OptionalJacobian.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/config.h>
+#include <Eigen/QR>
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
 #include <Eigen/Core>
 #include <Eigen/Cholesky>
@@ -301,6 +302,21 @@ GTSAM_EXPORT std::pair<Matrix,Matrix> qr(const Matrix& A);
  */
 GTSAM_EXPORT void inplace_QR(Matrix& A);
 
+/**
+ * In-place QR for small fixed-size matrices, e.g. the blocks handled by a
+ * BinaryJacobianFactor.  Applies the unblocked Householder kernel with fully
+ * stack-allocated workspace; the blocked (WY) algorithm of the dynamic
+ * overload only pays off for panels far larger than these.
+ * @param A is the input matrix, and is the output
+ */
+template<int M, int N>
+void inplace_QR(Eigen::Matrix<double, M, N>& A) {
+  Eigen::Matrix<double, (M < N ? M : N), 1> hCoeffs;
+  Eigen::Matrix<double, 1, N> temp;
+  Eigen::internal::householder_qr_inplace_unblocked(A, hCoeffs, temp.data());
+  A.template triangularView<Eigen::StrictlyLower>().setZero();
+}
+
 /**
  * Imperative algorithm for in-place full elimination with
  * weights and constraint handling
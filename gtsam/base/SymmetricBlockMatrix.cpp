@@ -62,10 +62,20 @@ Matrix SymmetricBlockMatrix::block(DenseIndex I, DenseIndex J) const {
 }
 
 /* ************************************************************************* */
-void SymmetricBlockMatrix::choleskyPartial(DenseIndex nFrontals) {
+void SymmetricBlockMatrix::choleskyPartial(DenseIndex nFrontals,
+    bool reducedPrecision) {
   gttic(VerticalBlockMatrix_choleskyPartial);
   DenseIndex topleft = variableColOffsets_[blockStart_];
-  if (!gtsam::choleskyPartial(matrix_, offset(nFrontals) - topleft, topleft)) {
+  if (reducedPrecision) {
+    // Stage the payload as float32 so the O(n^3) factorization streams a
+    // working set half the size; the kernel accumulates in double
+    Eigen::MatrixXf staged = matrix_.cast<float>();
+    if (!gtsam::choleskyPartial(staged, offset(nFrontals) - topleft, topleft)) {
+      throw CholeskyFailed();
+    }
+    matrix_ = staged.cast<double>();
+  } else if (!gtsam::choleskyPartial(matrix_, offset(nFrontals) - topleft,
+      topleft)) {
     throw CholeskyFailed();
   }
 }
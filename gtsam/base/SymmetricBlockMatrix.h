@@ -164,6 +164,16 @@ namespace gtsam {
       return block_(I, I, J - I, J - I).selfadjointView<Eigen::Upper>();
     }
 
+    /// Return the square sub-matrix that contains blocks(i:j, i:j) as a mutable
+    /// self adjoint view. Lets callers apply one blocked kernel across several
+    /// block columns at once, e.g. rankUpdate for a whole factor, instead of
+    /// paying the block offset arithmetic once per block pair.
+    Eigen::SelfAdjointView<Block, Eigen::Upper> selfadjointView(
+        DenseIndex I, DenseIndex J) {
+      assert(J > I);
+      return block_(I, I, J - I, J - I).selfadjointView<Eigen::Upper>();
+    }
+
     /// Return the square sub-matrix that contains blocks(i:j, i:j) as a triangular view.
     Eigen::TriangularView<constBlock, Eigen::Upper> triangularView(DenseIndex I,
                                                                    DenseIndex J) const {
@@ -216,17 +226,26 @@ namespace gtsam {
     template <typename XprType>
     void updateDiagonalBlock(DenseIndex I, const XprType& xpr) {
       // TODO(gareth): Eigen won't let us add triangular or self-adjoint views
-      // here, so we do it manually.
+      // here, so we add the upper triangle column by column: each column is a
+      // contiguous segment, which Eigen streams with vector instructions,
+      // unlike the scalar element loop this replaces.
       auto dest = block_(I, I);
       assert(dest.rows() == xpr.rows());
       assert(dest.cols() == xpr.cols());
+      const auto& source = xpr.eval(); // a no-op for plain matrices
       for (DenseIndex col = 0; col < dest.cols(); ++col) {
-        for (DenseIndex row = 0; row <= col; ++row) {
-          dest(row, col) += xpr(row, col);
-        }
+        dest.col(col).head(col + 1) += source.col(col).head(col + 1);
       }
     }
 
+    /// Overload for self adjoint views, e.g. another matrix' diagonalBlock:
+    /// the nested expression holds the same upper triangle.
+    template <typename Derived>
+    void updateDiagonalBlock(
+        DenseIndex I, const Eigen::SelfAdjointView<Derived, Eigen::Upper>& xpr) {
+      updateDiagonalBlock(I, xpr.nestedExpression());
+    }
+
     /// Update an off diagonal block.
     /// NOTE(emmett): This assumes noalias().
     template <typename XprType>
@@ -299,8 +318,15 @@ namespace gtsam {
      *   R'Sd = [A1'A2 A1'b]
      *   L'L is the augmented Hessian on the the separator x2
      * R and Sd can be interpreted as a GaussianConditional |R*x1 + S*x2 - d]^2
+     *
+     * With reducedPrecision set, the payload is staged in a float32 working
+     * copy and factored by the single-precision choleskyPartial overload,
+     * which still accumulates in double: for cliques whose working set
+     * exceeds the last-level cache this halves the bandwidth of the
+     * factorization, at the cost of rounding the stored factor to float32.
+     * Opt-in; the default factors in full precision as before.
      */
-    void choleskyPartial(DenseIndex nFrontals);
+    void choleskyPartial(DenseIndex nFrontals, bool reducedPrecision = false);
 
     /**
      * After partial Cholesky, we can optionally split off R and Sd, to be interpreted as
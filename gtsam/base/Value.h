@@ -74,6 +74,13 @@ namespace gtsam {
      */
     virtual Vector localCoordinates_(const Value& value) const = 0;
 
+    /** The number of bytes occupied by this value, including any owned heap
+     * storage.  Returns 0 when the size is unknown (the default for custom
+     * Value subclasses that do not override this). */
+    virtual size_t memoryUsage() const {
+      return 0;
+    }
+
     /** Assignment operator */
     virtual Value& operator=(const Value& /*rhs*/) {
       //needs a empty definition so recursion in implicit derived assignment operators work
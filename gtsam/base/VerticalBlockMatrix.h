@@ -20,6 +20,8 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/FastVector.h>
 
+#include <algorithm>
+
 namespace gtsam {
 
   // Forward declarations
@@ -189,6 +191,48 @@ namespace gtsam {
     /** Non-const access to full matrix (*including* any portions excluded by rowStart(), rowEnd(), and firstBlock()) */
     Matrix& matrix() { return matrix_; }
 
+    /** Number of allocated rows in the underlying matrix, including any
+     * headroom beyond rowEnd() set aside by reserveRows() for future
+     * appends. */
+    DenseIndex rowCapacity() const { return matrix_.rows(); }
+
+    /** Ensure the underlying matrix has at least \c rowCapacity allocated
+     * rows without changing the apparent view.  Reserving the total height
+     * up front lets a sequence of appendRows() calls assemble a combined
+     * factor in place with no further reallocation or copying. */
+    void reserveRows(DenseIndex rowCapacity) {
+      if (rowCapacity > matrix_.rows())
+        matrix_.conservativeResize(rowCapacity, Eigen::NoChange);
+      assertInvariants();
+    }
+
+    /** Append \c numRows rows to the apparent view and return a writeable
+     * block of just the new rows (all columns from firstBlock() on), to be
+     * filled in place by the caller.  The allocation grows geometrically
+     * only when the reserved capacity is exhausted, so appends after an
+     * adequate reserveRows() never reallocate. */
+    Block appendRows(DenseIndex numRows) {
+      assertInvariants();
+      const DenseIndex oldRowEnd = rowEnd_;
+      if (rowEnd_ + numRows > matrix_.rows())
+        matrix_.conservativeResize(
+            std::max(rowEnd_ + numRows, 2 * matrix_.rows()), Eigen::NoChange);
+      rowEnd_ += numRows;
+      return matrix_.block(oldRowEnd, variableColOffsets_[blockStart_],
+          numRows, this->cols());
+    }
+
+    /** Append the active view of \c source below this matrix in one copy,
+     * directly into rows obtained from appendRows().  The source view must
+     * have the same number of columns as this view; throws
+     * std::invalid_argument otherwise. */
+    void splice(const VerticalBlockMatrix& source) {
+      if (source.cols() != cols())
+        throw std::invalid_argument(
+            "VerticalBlockMatrix::splice: source view has a different number of columns");
+      appendRows(source.rows()) = source.full();
+    }
+
   protected:
     void assertInvariants() const {
       assert(matrix_.cols() == variableColOffsets_.back());
@@ -18,11 +18,18 @@
  */
 
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/FastVector.h>
 #include <gtsam/base/timing.h>
 
 #include <boost/format.hpp>
+#include <algorithm>
 #include <cmath>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 using namespace std;
 
 namespace gtsam {
@@ -31,6 +38,10 @@ static const double negativePivotThreshold = -1e-1;
 static const double zeroPivotThreshold = 1e-6;
 static const double underconstrainedPrior = 1e-5;
 static const int underconstrainedExponentDifference = 12;
+#ifdef GTSAM_USE_TBB
+static const DenseIndex blockedCholeskyThreshold = 500;
+static const DenseIndex blockedCholeskyPanel = 256;
+#endif
 
 /* ************************************************************************* */
 static inline int choleskyStep(Matrix& ATA, size_t k, size_t order) {
@@ -104,6 +115,72 @@ pair<size_t, bool> choleskyCareful(Matrix& ATA, int order) {
   return make_pair(maxrank, success);
 }
 
+/* ************************************************************************* */
+#ifdef GTSAM_USE_TBB
+// Blocked right-looking upper Cholesky A = R'*R on the leading nFrontal x
+// nFrontal block of ABC at offset topleft, used for cliques too large for
+// the single-threaded Eigen::LLT to handle quickly.  After each panel is
+// factored, the rank update of the trailing submatrix - which dominates the
+// cost - is distributed over TBB workers, one task per trailing block; the
+// written blocks are disjoint so no synchronization is needed.  Only the
+// upper triangle is referenced.  Returns false on an indefinite pivot block,
+// leaving the matrix partially factored (callers treat false as failure and
+// discard the contents).
+static bool choleskyPartialBlocked(Matrix& ABC, size_t nFrontal,
+                                   size_t topleft) {
+  const DenseIndex n = nFrontal;
+  const DenseIndex nb = blockedCholeskyPanel;
+  for (DenseIndex k = 0; k < n; k += nb) {
+    const DenseIndex pb = min(nb, n - k);
+
+    // Factor the diagonal panel block
+    auto Akk = ABC.block(topleft + k, topleft + k, pb, pb);
+    Eigen::LLT<Matrix, Eigen::Upper> llt(Akk);
+    if (llt.info() != Eigen::Success)
+      return false;
+    Akk.triangularView<Eigen::Upper>() = llt.matrixU();
+
+    const DenseIndex rem = n - k - pb;
+    if (rem == 0)
+      break;
+
+    // Panel row S = inv(R_kk') * A(k, k+pb:n)
+    auto S = ABC.block(topleft + k, topleft + k + pb, pb, rem);
+    Akk.triangularView<Eigen::Upper>().transpose().solveInPlace(S);
+
+    // Trailing update A(i,j) -= S_i' * S_j over the upper-triangle blocks
+    const DenseIndex nBlocks = (rem + nb - 1) / nb;
+    FastVector<pair<DenseIndex, DenseIndex> > updates;
+    updates.reserve(size_t(nBlocks * (nBlocks + 1) / 2));
+    for (DenseIndex bi = 0; bi < nBlocks; ++bi)
+      for (DenseIndex bj = bi; bj < nBlocks; ++bj)
+        updates.push_back(make_pair(bi, bj));
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, updates.size()),
+        [&ABC, &updates, topleft, k, pb, nb, rem](
+            const tbb::blocked_range<size_t>& range) {
+          for (size_t idx = range.begin(); idx != range.end(); ++idx) {
+            const DenseIndex bi = updates[idx].first, bj = updates[idx].second;
+            const DenseIndex rows = min(nb, rem - bi * nb);
+            const DenseIndex cols = min(nb, rem - bj * nb);
+            const auto Si =
+                ABC.block(topleft + k, topleft + k + pb + bi * nb, pb, rows);
+            const auto Sj =
+                ABC.block(topleft + k, topleft + k + pb + bj * nb, pb, cols);
+            auto Cij = ABC.block(topleft + k + pb + bi * nb,
+                                 topleft + k + pb + bj * nb, rows, cols);
+            if (bi == bj)
+              Cij.selfadjointView<Eigen::Upper>().rankUpdate(
+                  Si.transpose(), -1.0);
+            else
+              Cij.noalias() -= Si.transpose() * Sj;
+          }
+        });
+  }
+  return true;
+}
+#endif
+
 /* ************************************************************************* */
 bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
   gttic(choleskyPartial);
@@ -122,12 +199,21 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
 
   // Compute Cholesky factorization A = R'*R, overwrites A.
   gttic(LLT);
-  Eigen::LLT<Matrix, Eigen::Upper> llt(A);
-  Eigen::ComputationInfo lltResult = llt.info();
-  if (lltResult != Eigen::Success)
-    return false;
+#ifdef GTSAM_USE_TBB
+  if (DenseIndex(nFrontal) >= blockedCholeskyThreshold) {
+    // Large cliques: blocked factorization with parallel trailing updates
+    if (!choleskyPartialBlocked(ABC, nFrontal, topleft))
+      return false;
+  } else
+#endif
+  {
+    Eigen::LLT<Matrix, Eigen::Upper> llt(A);
+    Eigen::ComputationInfo lltResult = llt.info();
+    if (lltResult != Eigen::Success)
+      return false;
+    A.triangularView<Eigen::Upper>() = llt.matrixU();
+  }
   auto R = A.triangularView<Eigen::Upper>();
-  R = llt.matrixU();
   gttoc(LLT);
 
   // Compute S = inv(R') * B
@@ -157,4 +243,104 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
     return true;
   }
 }
+
+/* ************************************************************************* */
+bool choleskyPartial(Eigen::MatrixXf& ABC, size_t nFrontal, size_t topleft) {
+  gttic(choleskyPartialFloat);
+  if (nFrontal == 0)
+    return true;
+
+  assert(ABC.cols() == ABC.rows());
+  assert(size_t(ABC.rows()) >= topleft);
+  const size_t n = static_cast<size_t>(ABC.rows() - topleft);
+  assert(nFrontal <= n);
+  const DenseIndex m = DenseIndex(n - nFrontal);
+
+  // Promote the frontal block A and factor it in double, A = R'*R
+  Matrix R = ABC.block(topleft, topleft, nFrontal, nFrontal).cast<double>();
+  Eigen::LLT<Matrix, Eigen::Upper> llt(R);
+  if (llt.info() != Eigen::Success)
+    return false;
+  R = llt.matrixU();
+  const Eigen::MatrixXf Rf = R.cast<float>();
+  ABC.block(topleft, topleft, nFrontal, nFrontal)
+      .triangularView<Eigen::Upper>() = Rf;
+
+  if (m > 0) {
+    // Compute S = inv(R') * B with a double triangular solve
+    Matrix S = ABC.block(topleft, topleft + nFrontal, nFrontal, m).cast<double>();
+    R.triangularView<Eigen::Upper>().transpose().solveInPlace(S);
+    ABC.block(topleft, topleft + nFrontal, nFrontal, m) = S.cast<float>();
+
+    // Compute L = C - S' * S over column panels: each panel is promoted to
+    // double, updated with a double-accumulated product, and demoted again,
+    // so the O(m^2) separator Hessian is only ever streamed as float while
+    // the double working set stays at one panel
+    const DenseIndex panel = 256;
+    for (DenseIndex j = 0; j < m; j += panel) {
+      const DenseIndex pw = min(panel, m - j);
+      const DenseIndex rows = j + pw; // the upper triangle of C
+      Matrix Cd = ABC.block(topleft + nFrontal, topleft + nFrontal + j,
+                            rows, pw).cast<double>();
+      Cd.noalias() -= S.leftCols(rows).transpose() * S.middleCols(j, pw);
+      // Write back only the upper triangle, like the double version
+      if (j > 0)
+        ABC.block(topleft + nFrontal, topleft + nFrontal + j, j, pw) =
+            Cd.topRows(j).cast<float>();
+      const Eigen::MatrixXf Dd = Cd.bottomRows(pw).cast<float>();
+      ABC.block(topleft + nFrontal + j, topleft + nFrontal + j, pw, pw)
+          .triangularView<Eigen::Upper>() = Dd;
+    }
+  }
+
+  // Same underconstrained check as the double version, on the double factor
+  if (nFrontal >= 2) {
+    int exp2, exp1;
+    (void)frexp(R(nFrontal - 2, nFrontal - 2), &exp2);
+    (void)frexp(R(nFrontal - 1, nFrontal - 1), &exp1);
+    return (exp2 - exp1 < underconstrainedExponentDifference);
+  } else {
+    int exp1;
+    (void)frexp(R(0, 0), &exp1);
+    return (exp1 > -underconstrainedExponentDifference);
+  }
+}
+
+/* ************************************************************************* */
+bool choleskyDowndate(Matrix& R, const Matrix& A) {
+  gttic(choleskyDowndate);
+  const DenseIndex n = R.cols();
+  assert(R.rows() == n && A.cols() == n);
+
+  // Work on a copy so R is untouched if the downdate turns out indefinite
+  // partway through the rows of A.
+  Matrix Rd = R.triangularView<Eigen::Upper>();
+  Vector c(n), s(n);
+  for (DenseIndex row = 0; row < A.rows(); ++row) {
+    // One LINPACK dchdd sweep: solve R' p = a, then build the hyperbolic
+    // rotations that chase a out of the factor.
+    const Vector a = A.row(row);
+    const Vector p = Rd.transpose().triangularView<Eigen::Lower>().solve(a);
+    const double rho2 = 1.0 - p.squaredNorm();
+    if (rho2 <= 0.0)
+      return false; // Removing a would make R'R - A'A indefinite
+    double alpha = sqrt(rho2);
+    for (DenseIndex i = n - 1; i >= 0; --i) {
+      const double r = sqrt(alpha * alpha + p(i) * p(i));
+      c(i) = alpha / r;
+      s(i) = p(i) / r;
+      alpha = r;
+    }
+    for (DenseIndex j = 0; j < n; ++j) {
+      double aj = 0.0;
+      for (DenseIndex i = j; i >= 0; --i) {
+        const double t = c(i) * aj + s(i) * Rd(i, j);
+        Rd(i, j) = c(i) * Rd(i, j) - s(i) * aj;
+        aj = t;
+      }
+    }
+  }
+  R.triangularView<Eigen::Upper>() = Rd;
+  return true;
+}
 }  // namespace gtsam
@@ -62,5 +62,32 @@ GTSAM_EXPORT std::pair<size_t,bool> choleskyCareful(Matrix& ATA, int order = -1)
  */
 GTSAM_EXPORT bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft=0);
 
+/**
+ * Overload of choleskyPartial for float32 storage.  The matrix stays in
+ * single precision - halving the memory footprint and bandwidth of the
+ * factorization, which for large cliques is bound by the trailing update
+ * streaming the separator Hessian - while every arithmetic step (frontal
+ * LLT, triangular solve, trailing product) accumulates in double through
+ * panel-sized staging buffers.  Intended for well-scaled problems whose
+ * Jacobian entries do not need a 52-bit mantissa; the result is exact
+ * double arithmetic rounded once to float32 per panel.
+ */
+GTSAM_EXPORT bool choleskyPartial(Eigen::MatrixXf& ABC, size_t nFrontal, size_t topleft=0);
+
+/**
+ * Rank-k Cholesky downdate.  Given an upper-triangular factor R and a k x n
+ * matrix A, replaces R with the upper-triangular Rd satisfying
+ * Rd' * Rd = R' * R - A' * A, using one sweep of hyperbolic rotations per row
+ * of A (the LINPACK dchdd scheme), in O(k n^2) instead of refactoring.
+ *
+ * The diagonal of the downdated factor stays positive.  Entries of R below
+ * the diagonal are ignored and left untouched.
+ *
+ * @return \c true on success, \c false if the downdated matrix would not be
+ * positive-definite (i.e. A removes more information than R contains), in
+ * which case R is left unmodified.
+ */
+GTSAM_EXPORT bool choleskyDowndate(Matrix& R, const Matrix& A);
+
 }
 
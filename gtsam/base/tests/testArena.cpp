@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testArena.cpp
+ * @brief   Unit tests for the Arena bump allocator
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/base/Arena.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/make_shared.hpp>
+
+#include <vector>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(Arena, allocateAligned) {
+  Arena arena(64); // tiny chunks to force growth
+  void* p1 = arena.allocate(1, 1);
+  void* p2 = arena.allocate(8, 8);
+  void* p3 = arena.allocate(100, 16); // larger than the chunk size
+  CHECK(p1 != nullptr);
+  CHECK(reinterpret_cast<size_t>(p2) % 8 == 0);
+  CHECK(reinterpret_cast<size_t>(p3) % 16 == 0);
+  CHECK(arena.capacity() >= 164);
+}
+
+/* ************************************************************************* */
+TEST(Arena, resetKeepsFirstChunk) {
+  Arena arena(128);
+  for (size_t i = 0; i < 100; ++i)
+    arena.allocate(16);
+  const size_t grown = arena.capacity();
+  CHECK(grown >= 100 * 16);
+  arena.reset();
+  // After reset only the first chunk remains, and it is reused
+  CHECK(arena.capacity() < grown);
+  void* p = arena.allocate(16);
+  CHECK(p != nullptr);
+}
+
+/* ************************************************************************* */
+TEST(Arena, stlAllocator) {
+  Arena arena;
+  std::vector<int, ArenaAllocator<int> > v{ArenaAllocator<int>(arena)};
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(i);
+  LONGS_EQUAL(1000, v.size());
+  LONGS_EQUAL(999, v.back());
+  // allocate_shared places the object and control block in the arena
+  boost::shared_ptr<int> p =
+      boost::allocate_shared<int>(ArenaAllocator<int>(arena), 42);
+  LONGS_EQUAL(42, *p);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
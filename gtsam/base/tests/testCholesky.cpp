@@ -66,6 +66,76 @@ TEST(cholesky, choleskyPartial) {
   EXPECT(assert_equal(expected, actual, 1e-9));
 }
 
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialLarge) {
+  // Large enough to take the blocked parallel path in TBB builds
+  const DenseIndex n = 600;
+  Matrix A(n, n);
+  for (DenseIndex i = 0; i < n; ++i)
+    for (DenseIndex j = 0; j < n; ++j)
+      A(i, j) = std::sin(0.001 * double(i * j + i + 2 * j));
+  Matrix ATA = A.transpose() * A + 0.1 * Matrix::Identity(n, n);
+
+  Matrix R(ATA);
+  CHECK(choleskyPartial(R, n));
+
+  Matrix expected = ATA.selfadjointView<Eigen::Upper>();
+  Matrix actual = R.triangularView<Eigen::Upper>().transpose() *
+                  Matrix(R.triangularView<Eigen::Upper>());
+  EXPECT(assert_equal(expected, actual, 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialFloat) {
+  Matrix ABC = (Matrix(7,7) <<
+                      4.0375,   3.4584,   3.5735,   2.4815,   2.1471,   2.7400,   2.2063,
+                          0.,   4.7267,   3.8423,   2.3624,   2.8091,   2.9579,   2.5914,
+                          0.,       0.,   5.1600,   2.0797,   3.4690,   3.2419,   2.9992,
+                          0.,       0.,       0.,   1.8786,   1.0535,   1.4250,   1.3347,
+                          0.,       0.,       0.,       0.,   3.0788,   2.6283,   2.3791,
+                          0.,       0.,       0.,       0.,       0.,   2.9227,   2.4056,
+                          0.,       0.,       0.,       0.,       0.,       0.,   2.5776).finished();
+
+  // The float32 factorization matches the double one to float32 rounding
+  Matrix expected(ABC);
+  CHECK(choleskyPartial(expected, 3));
+  Eigen::MatrixXf actual = ABC.cast<float>();
+  CHECK(choleskyPartial(actual, 3));
+  EXPECT(assert_equal(expected, actual.cast<double>(), 1e-4));
+
+  // Passing 0 frontals leaves the matrix untouched, as in double
+  Eigen::MatrixXf untouched = ABC.cast<float>();
+  CHECK(choleskyPartial(untouched, 0));
+  EXPECT(assert_equal(Matrix(ABC.cast<float>().cast<double>()),
+      untouched.cast<double>(), 1e-9));
+
+  // An indefinite frontal block is reported, as in double
+  Eigen::MatrixXf indefinite(2, 2);
+  indefinite << -1.0, 0.0, 0.0, 1.0;
+  CHECK(!choleskyPartial(indefinite, 2));
+}
+
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialFloatLarge) {
+  // A separator wide enough that the trailing update spans several panels
+  const DenseIndex n = 600;
+  const size_t nFrontal = 40;
+  Matrix ATA(n, n);
+  for (DenseIndex i = 0; i < n; ++i)
+    for (DenseIndex j = 0; j < n; ++j)
+      ATA(i, j) = 0.01 * std::sin(0.001 * double(i * j + i + j));
+  ATA.diagonal().array() += 2.0;
+
+  Matrix expected(ATA);
+  CHECK(choleskyPartial(expected, nFrontal));
+  Eigen::MatrixXf actual = ATA.cast<float>();
+  CHECK(choleskyPartial(actual, nFrontal));
+
+  Matrix expectedUpper = expected.triangularView<Eigen::Upper>();
+  Matrix actualUpper = actual.cast<double>().triangularView<Eigen::Upper>();
+  EXPECT(assert_equal(expectedUpper, actualUpper, 1e-4));
+}
+
 /* ************************************************************************* */
 TEST(cholesky, BadScalingCholesky) {
   Matrix A = (Matrix(2,2) <<
@@ -137,6 +207,37 @@ TEST(cholesky, underconstrained) {
   LONGS_EQUAL(long(false), long(choleskyPartial(A3, 6)));
 }
 
+/* ************************************************************************* */
+TEST(cholesky, downdate) {
+  // A well-conditioned information matrix and two rows to remove from it
+  Matrix A = (Matrix(6, 4) <<
+      2.1,  0.3, -0.4,  0.7,
+      0.2,  1.8,  0.5, -0.1,
+     -0.6,  0.4,  2.5,  0.3,
+      0.1, -0.2,  0.7,  1.9,
+      0.8,  0.5, -0.3,  0.2,
+      0.4, -0.7,  0.1,  0.6).finished();
+  Matrix removed = 0.5 * A.bottomRows(2);
+  Matrix ATA = A.transpose() * A;
+
+  Matrix R = ATA.llt().matrixU();
+  EXPECT(choleskyDowndate(R, removed));
+
+  Matrix expected = ATA - removed.transpose() * removed;
+  Matrix actual = Matrix(R.triangularView<Eigen::Upper>()).transpose() *
+                  Matrix(R.triangularView<Eigen::Upper>());
+  EXPECT(assert_equal(expected, actual, 1e-9));
+  // The downdated factor should keep a positive diagonal
+  EXPECT(R.diagonal().minCoeff() > 0.0);
+
+  // Removing more information than the factor contains must fail and leave
+  // the factor untouched
+  Matrix R2 = ATA.llt().matrixU();
+  const Matrix R2before = R2;
+  EXPECT(!choleskyDowndate(R2, 10.0 * A.topRows(3)));
+  EXPECT(assert_equal(R2before, R2, 1e-15));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
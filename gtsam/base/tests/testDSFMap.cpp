@@ -139,6 +139,50 @@ TEST(DSFMap, sets){
   EXPECT(s2 == sets[4]);
 }
 
+/* ************************************************************************* */
+TEST(ConcurrentDSFMap, mergeAndSets) {
+  // Same semantics as DSFMap on the single-threaded interface
+  ConcurrentDSFMap<size_t> dsf;
+  EXPECT(dsf.find(0)==0);
+  dsf.merge(0,1);
+  dsf.merge(1,2);
+  dsf.merge(4,5);
+  dsf.merge(4,6);
+  EXPECT(dsf.find(0) == dsf.find(2));
+  EXPECT(dsf.find(4) == dsf.find(6));
+  EXPECT(dsf.find(0) != dsf.find(4));
+
+  map<size_t, set<size_t> > sets = dsf.sets();
+  set<size_t> s1, s2;
+  s1 += 0,1,2;
+  s2 += 4,5,6;
+  EXPECT(s1 == sets[dsf.find(0)]);
+  EXPECT(s2 == sets[dsf.find(4)]);
+}
+
+/* ************************************************************************* */
+TEST(ConcurrentDSFMap, bulkMerge) {
+  // A pairwise-match workload large enough to engage the worker threads:
+  // chains of ten consecutive numbers, specified in scrambled order
+  typedef pair<size_t,size_t> Match;
+  const size_t nrChains = 100, length = 10;
+  vector<Match> matches;
+  for (size_t j = 1; j < length; ++j)
+    for (size_t i = 0; i < nrChains; ++i)
+      matches.push_back(Match(i*length + j - 1, i*length + j));
+
+  ConcurrentDSFMap<size_t> dsf;
+  dsf.merge(matches);
+
+  // Every chain collapsed into one set
+  map<size_t, set<size_t> > sets = dsf.sets();
+  EXPECT_LONGS_EQUAL(nrChains, sets.size());
+  for (size_t i = 0; i < nrChains; ++i) {
+    EXPECT_LONGS_EQUAL(dsf.find(i*length), dsf.find(i*length + length - 1));
+    EXPECT_LONGS_EQUAL(length, sets[dsf.find(i*length)].size());
+  }
+}
+
 /* ************************************************************************* */
 TEST(DSFMap, findIndexPair) {
   DSFMap<IndexPair> dsf;
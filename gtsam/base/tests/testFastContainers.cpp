@@ -8,6 +8,8 @@
  */
 
 #include <gtsam/inference/Key.h>
+#include <gtsam/base/Arena.h>
+#include <gtsam/base/FastMap.h>
 #include <gtsam/base/FastSet.h>
 #include <gtsam/base/FastVector.h>
 
@@ -29,6 +31,59 @@ TEST( testFastContainers, KeySet ) {
   EXPECT(actSet == expSet);
 }
 
+/* ************************************************************************* */
+TEST( testFastContainers, arena_allocator_injection ) {
+
+  // A FastMap can be tied to a specific arena via its allocator parameter
+  typedef ArenaAllocator<std::pair<const Key, int> > Allocator;
+  Arena arena;
+  FastMap<Key, int, Allocator> map((Allocator(arena)));
+  for (Key key = 0; key < 100; ++key)
+    map.insert(std::make_pair(key, int(key)));
+  EXPECT_LONGS_EQUAL(100, map.size());
+  EXPECT(map.exists(42));
+  EXPECT(arena.capacity() > 0);
+}
+
+/* ************************************************************************* */
+TEST( testFastContainers, counting_allocator ) {
+
+  typedef internal::CountingAllocator<std::pair<const Key, int> > Allocator;
+  internal::FastAllocatorStats::reset();
+  FastMap<Key, int, Allocator> map;
+  for (Key key = 0; key < 10; ++key)
+    map.insert(std::make_pair(key, int(key)));
+  // One node allocation per insert, all still live
+  EXPECT(internal::FastAllocatorStats::allocateCalls() >= 10);
+  EXPECT(internal::FastAllocatorStats::bytesAllocated() > 0);
+}
+
+/* ************************************************************************* */
+TEST( testFastContainers, high_water_mark ) {
+
+  typedef internal::CountingAllocator<std::pair<const Key, int> > Allocator;
+  internal::FastAllocatorStats::reset();
+  {
+    FastMap<Key, int, Allocator> map;
+    for (Key key = 0; key < 10; ++key)
+      map.insert(std::make_pair(key, int(key)));
+    EXPECT(internal::FastAllocatorStats::bytesInUse() > 0);
+    EXPECT(internal::FastAllocatorStats::highWaterBytes()
+        >= internal::FastAllocatorStats::bytesInUse());
+  }
+  // The container is gone but the high-water mark records its peak footprint
+  const size_t highWater = internal::FastAllocatorStats::highWaterBytes();
+  EXPECT_LONGS_EQUAL(0, internal::FastAllocatorStats::bytesInUse());
+  EXPECT(highWater > 0);
+
+  // A smaller container does not raise the previous peak
+  {
+    FastMap<Key, int, Allocator> map;
+    map.insert(std::make_pair(Key(0), 0));
+  }
+  EXPECT_LONGS_EQUAL(highWater, internal::FastAllocatorStats::highWaterBytes());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -835,6 +835,15 @@ TEST(Matrix, eigen_QR )
       00, 10,0, 0, 0, -10, -1).finished());
   inplace_QR(A);
   EXPECT(assert_equal(expected, A, 1e-3));
+
+  // fixed-size overload takes the unblocked stack-workspace path
+  Eigen::Matrix<double, 4, 7> F;
+  F << -5, 0, 5, 0, 0, 0, -1,
+      00,-5, 0, 5, 0, 0, 1.5,
+      10, 0, 0,  0,-10,0,   2,
+      00, 10,0, 0, 0, -10, -1;
+  inplace_QR(F);
+  EXPECT(assert_equal(expected, Matrix(F), 1e-3));
 }
 
 /* ************************************************************************* */
@@ -151,6 +151,29 @@ TEST(SymmetricBlockMatrix, expressions)
   EXPECT(assert_equal(Matrix(expected2.selfadjointView()), bm6.selfadjointView()));
 }
 
+/* ************************************************************************* */
+TEST(SymmetricBlockMatrix, blockedRankUpdate)
+{
+  Matrix A = (Matrix(2, 5) <<
+      1, 2, 3, 4, 5,
+      6, 7, 8, 9, 10).finished();
+
+  // One blocked kernel across both block columns at once...
+  SymmetricBlockMatrix actual(list_of(2)(3)(1));
+  actual.setZero();
+  actual.selfadjointView(0, 2).rankUpdate(A.transpose());
+
+  // ... must match the per-block-pair updates it replaces
+  SymmetricBlockMatrix expected(list_of(2)(3)(1));
+  expected.setZero();
+  const Matrix A1 = A.leftCols(2), A2 = A.rightCols(3);
+  expected.diagonalBlock(0).rankUpdate(A1.transpose());
+  expected.updateOffDiagonalBlock(0, 1, A1.transpose() * A2);
+  expected.diagonalBlock(1).rankUpdate(A2.transpose());
+
+  EXPECT(assert_equal(Matrix(expected.selfadjointView()), actual.selfadjointView()));
+}
+
 /* ************************************************************************* */
 TEST(SymmetricBlockMatrix, inverseInPlace) {
   // generate an invertible matrix
@@ -168,6 +191,26 @@ TEST(SymmetricBlockMatrix, inverseInPlace) {
   EXPECT(assert_equal(expectedInverse, symmMatrix.selfadjointView()));
 }
 
+/* ************************************************************************* */
+TEST(SymmetricBlockMatrix, choleskyPartialReducedPrecision) {
+  // A well-scaled positive definite augmented Hessian
+  Matrix A = (Matrix(4, 6) <<
+      1.0, 0.2, 0.3, 0.1, 0.5, 0.4,
+      0.2, 1.1, 0.1, 0.3, 0.2, 0.6,
+      0.4, 0.1, 1.2, 0.2, 0.1, 0.3,
+      0.3, 0.5, 0.2, 1.3, 0.4, 0.2).finished();
+  const Matrix ATA = A.transpose() * A + Matrix::Identity(6, 6);
+
+  SymmetricBlockMatrix expected(list_of(2)(3)(1), ATA);
+  expected.choleskyPartial(1);
+
+  // The opt-in float32 staging matches full precision to float32 rounding
+  SymmetricBlockMatrix actual(list_of(2)(3)(1), ATA);
+  actual.choleskyPartial(1, true);
+  EXPECT(assert_equal(Matrix(expected.selfadjointView()),
+      Matrix(actual.selfadjointView()), 1e-4));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
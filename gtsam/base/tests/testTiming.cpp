@@ -0,0 +1,165 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testTiming.cpp
+ * @brief Unit tests for the chrome-tracing event recording in timing.h
+ */
+
+#include <gtsam/base/timing.h>
+#include <gtsam/base/FastDefaultAllocator.h>
+#include <gtsam/base/FastMap.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(timing, chromeTracing) {
+  // Nothing is recorded while tracing is disabled
+  CHECK(!internal::chromeTracingEnabled());
+  {
+    gttic_(disabledSection);
+  }
+
+  tictoc_enableChromeTracing_();
+  CHECK(internal::chromeTracingEnabled());
+  {
+    gttic_(tracedOuter);
+    gttic_(tracedInner);
+    gttoc_(tracedInner);
+  }
+  tictoc_enableChromeTracing_(false);
+  CHECK(!internal::chromeTracingEnabled());
+
+  std::stringstream trace;
+  internal::writeChromeTrace(trace);
+  const std::string json = trace.str();
+
+  // Begin/end events for both traced sections, none for the disabled one
+  EXPECT(json.find("\"name\": \"tracedOuter\", \"ph\": \"B\"") != std::string::npos);
+  EXPECT(json.find("\"name\": \"tracedOuter\", \"ph\": \"E\"") != std::string::npos);
+  EXPECT(json.find("\"name\": \"tracedInner\", \"ph\": \"B\"") != std::string::npos);
+  EXPECT(json.find("\"name\": \"tracedInner\", \"ph\": \"E\"") != std::string::npos);
+  EXPECT(json.find("disabledSection") == std::string::npos);
+
+  // gttoc balance: leave the global timing tree as we found it
+  tictoc_reset_();
+}
+
+/* ************************************************************************* */
+TEST(timing, chromeTracingPerThread) {
+  tictoc_enableChromeTracing_();
+
+  // Events recorded on a worker thread land in that thread's own buffer
+  internal::recordTraceEvent("mainWork", true);
+  internal::recordTraceEvent("mainWork", false);
+  std::thread worker([] {
+    internal::recordTraceEvent("workerWork", true);
+    internal::recordTraceEvent("workerWork", false);
+  });
+  worker.join();
+
+  tictoc_enableChromeTracing_(false);
+
+  std::stringstream trace;
+  internal::writeChromeTrace(trace);
+  const std::string json = trace.str();
+
+  // Both threads' events survive, tagged with different thread indices
+  const size_t mainPos = json.find("\"name\": \"mainWork\"");
+  const size_t workerPos = json.find("\"name\": \"workerWork\"");
+  CHECK(mainPos != std::string::npos);
+  CHECK(workerPos != std::string::npos);
+  const std::string mainTid = json.substr(json.find("\"tid\": ", mainPos), 10);
+  const std::string workerTid = json.substr(json.find("\"tid\": ", workerPos), 10);
+  EXPECT(mainTid != workerTid);
+
+  // Re-enabling clears previously recorded events
+  tictoc_enableChromeTracing_();
+  tictoc_enableChromeTracing_(false);
+  std::stringstream cleared;
+  internal::writeChromeTrace(cleared);
+  EXPECT(cleared.str().find("mainWork") == std::string::npos);
+}
+
+/* ************************************************************************* */
+TEST(timing, compileTimeLabelIds) {
+  // Label ids are constant expressions, usable at compile time
+  static_assert(internal::labelHash("myFunction") != 0,
+      "label hash must be constexpr");
+  static_assert(internal::labelHash("tic") != internal::labelHash("toc"),
+      "distinct labels must get distinct ids");
+
+  // Runtime registration computes the identical id
+  EXPECT_LONGS_EQUAL(internal::labelHash("myFunction"),
+      internal::getTicTocID("myFunction"));
+}
+
+/* ************************************************************************* */
+TEST(timing, flatProfile) {
+  internal::flatProfileReset();
+  LONGS_EQUAL(0, internal::flatProfileCount("flatSection"));
+
+  // Every toc adds one sample for its label
+  for (int i = 0; i < 3; ++i) {
+    gttic_(flatSection);
+  }
+  LONGS_EQUAL(3, internal::flatProfileCount("flatSection"));
+
+  std::stringstream os;
+  internal::flatProfilePrint(os);
+  EXPECT(os.str().find("flatSection") != std::string::npos);
+
+  internal::flatProfileReset();
+  LONGS_EQUAL(0, internal::flatProfileCount("flatSection"));
+  tictoc_reset_();
+}
+
+/* ************************************************************************* */
+TEST(timing, allocationAudit) {
+  typedef internal::CountingAllocator<std::pair<const int, double> > Alloc;
+  typedef std::map<int, double, std::less<int>, Alloc> CountedMap;
+
+  tictoc_reset_();
+  internal::FastAllocatorStats::reset();
+
+  // Counted allocations inside a timed block are attributed to its node
+  {
+    gttic_(auditedPhase);
+    CountedMap map;
+    for (int i = 0; i < 10; ++i)
+      map.insert(std::make_pair(i, 1.0 * i));
+  }
+  tictoc_getNode(audited, auditedPhase);
+  CHECK(audited->allocCalls() >= 10);
+  CHECK(audited->allocBytes() >= 10 * sizeof(std::pair<const int, double>));
+
+  // A block without counted allocations reports none
+  {
+    gttic_(quietPhase);
+  }
+  tictoc_getNode(quiet, quietPhase);
+  LONGS_EQUAL(0, quiet->allocCalls());
+  LONGS_EQUAL(0, quiet->allocBytes());
+
+  tictoc_reset_();
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -21,6 +21,8 @@
 
 #include <vector>
 #include <list>
+#include <mutex>
+#include <set>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/assign/std/list.hpp>
@@ -126,6 +128,94 @@ TEST(treeTraversal, DepthFirst)
   EXPECT(assert_container_equality(postOrderExpected, postVisitor.visited));
 }
 
+/* ************************************************************************* */
+struct StringVisitor {
+  // Accumulates the visit order as a string; the per-node data is the path
+  // string passed down from the parent, as in PrintForest.
+  std::string visited;
+  std::string operator()(const TestNode::shared_ptr& node, const std::string& parentData) {
+    visited += std::to_string(node->data) + " ";
+    return parentData + "| ";
+  }
+};
+
+/* ************************************************************************* */
+TEST(treeTraversal, DepthFirstWorkspace)
+{
+  // Get test forest
+  TestForest testForest = makeTestForest();
+
+  // Expected visit order
+  std::list<int> preOrderExpected;
+  preOrderExpected += 0, 2, 3, 4, 1;
+  std::list<int> postOrderExpected;
+  postOrderExpected += 2, 4, 3, 0, 1;
+
+  // One workspace serves repeated sweeps, including with different data types
+  treeTraversal::TraversalWorkspace workspace;
+  for (int sweep = 0; sweep < 2; ++sweep) {
+    PreOrderVisitor preVisitor;
+    PostOrderVisitor postVisitor;
+    int rootData = -1;
+    treeTraversal::DepthFirstForest(testForest, rootData, preVisitor,
+        postVisitor, workspace);
+    EXPECT(preVisitor.parentsMatched);
+    EXPECT(assert_container_equality(preOrderExpected, preVisitor.visited));
+    EXPECT(assert_container_equality(postOrderExpected, postVisitor.visited));
+  }
+
+  // A string-data sweep through the same workspace, as PrintForest would do
+  StringVisitor stringVisitor;
+  treeTraversal::no_op postVisitor;
+  std::string rootString = "";
+  treeTraversal::DepthFirstForest(testForest, rootString, stringVisitor,
+      postVisitor, workspace);
+  EXPECT(stringVisitor.visited == "0 2 3 4 1 ");
+}
+
+/* ************************************************************************* */
+struct CountingVisitor {
+  // Thread-safe visitor for the partitioned traversal: counts visits and
+  // checks the parent data passed down within each subtree.
+  std::mutex mutex;
+  std::multiset<int> visited;
+  bool parentsMatched;
+  CountingVisitor() : parentsMatched(true) {}
+  int operator()(const TestNode::shared_ptr& node, int parentData) {
+    const int expectedParentIndex =
+      node->data == 0 ? -1 :
+      node->data == 1 ? -1 :
+      node->data == 2 ? 0 :
+      node->data == 3 ? 0 :
+      node->data == 4 ? 3 : -2;
+    std::lock_guard<std::mutex> lock(mutex);
+    visited.insert(node->data);
+    if (expectedParentIndex != parentData)
+      parentsMatched = false;
+    return node->data;
+  }
+};
+
+TEST(treeTraversal, DepthFirstPartitioned)
+{
+  // Get test forest
+  TestForest testForest = makeTestForest();
+
+  // All nodes are visited exactly once, with correct parent data, no matter
+  // how the root subtrees are dealt to the worker threads
+  for (size_t nrDomains = 0; nrDomains <= 3; ++nrDomains) {
+    CountingVisitor preVisitor;
+    treeTraversal::no_op postVisitor;
+    int rootData = -1;
+    treeTraversal::DepthFirstForestPartitioned(testForest, rootData,
+        preVisitor, postVisitor, nrDomains);
+    std::multiset<int> expected;
+    for (int i = 0; i < 5; ++i) expected.insert(i);
+    EXPECT(preVisitor.parentsMatched);
+    EXPECT(expected == preVisitor.visited);
+  }
+}
+
 /* ************************************************************************* */
 TEST(treeTraversal, CloneForest)
 {
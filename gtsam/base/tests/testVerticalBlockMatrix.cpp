@@ -57,6 +57,45 @@ TEST(VerticalBlockMatrix, Constructor3) {
   EXPECT_LONGS_EQUAL(3,actual.nBlocks());
 }
 
+//*****************************************************************************
+TEST(VerticalBlockMatrix, AppendAndSplice) {
+  // Reserve the final height up front, then assemble in place
+  VerticalBlockMatrix actual(dimensions, 2);
+  actual.full().setConstant(1.0);
+  actual.reserveRows(6);
+  EXPECT_LONGS_EQUAL(2, actual.rows());
+  EXPECT_LONGS_EQUAL(6, actual.rowCapacity());
+
+  // Appended rows are filled through the returned block, no reallocation
+  actual.appendRows(1).setConstant(2.0);
+  EXPECT_LONGS_EQUAL(3, actual.rows());
+  EXPECT_LONGS_EQUAL(6, actual.rowCapacity());
+
+  // Splice copies another matrix with the same column structure in one go
+  VerticalBlockMatrix source(dimensions, 3);
+  source.full().setConstant(3.0);
+  actual.splice(source);
+  EXPECT_LONGS_EQUAL(6, actual.rows());
+  EXPECT_LONGS_EQUAL(6, actual.rowCapacity());
+
+  Matrix expected(6, 6);
+  expected.topRows<2>().setConstant(1.0);
+  expected.middleRows<1>(2).setConstant(2.0);
+  expected.bottomRows<3>().setConstant(3.0);
+  EXPECT(assert_equal(expected, Matrix(actual.full())));
+
+  // Appending beyond capacity grows the allocation and keeps the contents
+  actual.appendRows(2).setConstant(4.0);
+  EXPECT_LONGS_EQUAL(8, actual.rows());
+  EXPECT(actual.rowCapacity() >= 8);
+  EXPECT(assert_equal(expected, Matrix(actual.range(0, 3).topRows(6))));
+
+  // A source with a different column structure is rejected
+  vector<size_t> narrow(1, 2);
+  VerticalBlockMatrix mismatched(narrow, 1);
+  CHECK_EXCEPTION(actual.splice(mismatched), std::invalid_argument);
+}
+
 //*****************************************************************************
 int main() {
   TestResult tr;
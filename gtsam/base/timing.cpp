@@ -17,19 +17,27 @@
  */
 
 #include <gtsam/base/debug.h>
+#include <gtsam/base/FastDefaultAllocator.h>
 #include <gtsam/base/timing.h>
 
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/format.hpp>
+#include <boost/make_shared.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cassert>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace gtsam {
 namespace internal {
@@ -55,7 +63,8 @@ void TimingOutline::add(size_t usecs, size_t usecsWall) {
 /* ************************************************************************* */
 TimingOutline::TimingOutline(const std::string& label, size_t id) :
     id_(id), t_(0), tWall_(0), t2_(0.0), tIt_(0), tMax_(0), tMin_(0), n_(0), myOrder_(
-        0), lastChildOrder_(0), label_(label) {
+        0), lastChildOrder_(0), label_(label), allocCalls_(0), allocBytes_(0), allocCallsOnTic_(
+        0), allocBytesOnTic_(0) {
 #ifdef GTSAM_USING_NEW_BOOST_TIMERS
   timer_.stop();
 #endif
@@ -81,7 +90,10 @@ void TimingOutline::print(const std::string& outline) const {
   boost::replace_all(formattedLabel, "_", " ");
   std::cout << outline << "-" << formattedLabel << ": " << self() << " CPU ("
       << n_ << " times, " << wall() << " wall, " << secs() << " children, min: "
-      << min() << " max: " << max() << ")\n";
+      << min() << " max: " << max() << ")";
+  if (allocCalls_ > 0)
+    std::cout << " [" << allocCalls_ << " allocs, " << allocBytes_ << " bytes]";
+  std::cout << "\n";
   // Order children
   typedef FastMap<size_t, boost::shared_ptr<TimingOutline> > ChildOrder;
   ChildOrder childOrder;
@@ -155,6 +167,21 @@ const boost::shared_ptr<TimingOutline>& TimingOutline::child(size_t child,
   return result;
 }
 
+/* ************************************************************************* */
+const boost::shared_ptr<TimingOutline>& TimingOutline::child(size_t child,
+    const char* label, const boost::weak_ptr<TimingOutline>& thisPtr) {
+  assert(thisPtr.lock().get() == this);
+  boost::shared_ptr<TimingOutline>& result = children_[child];
+  if (!result) {
+    // Create child if necessary; the label is only turned into a string here
+    result.reset(new TimingOutline(label, child));
+    ++this->lastChildOrder_;
+    result->myOrder_ = this->lastChildOrder_;
+    result->parent_ = thisPtr;
+  }
+  return result;
+}
+
 /* ************************************************************************* */
 void TimingOutline::tic() {
 #ifdef GTSAM_USING_NEW_BOOST_TIMERS
@@ -169,6 +196,12 @@ void TimingOutline::tic() {
 #ifdef GTSAM_USE_TBB
   tbbTimer_ = tbb::tick_count::now();
 #endif
+
+  // Snapshot the allocator counters so toc can attribute the delta here
+  allocCallsOnTic_ = FastAllocatorStats::allocateCalls().load(
+      std::memory_order_relaxed);
+  allocBytesOnTic_ = FastAllocatorStats::bytesAllocated().load(
+      std::memory_order_relaxed);
 }
 
 /* ************************************************************************* */
@@ -200,6 +233,13 @@ void TimingOutline::toc() {
 #endif
 
   add(cpuTime, wallTime);
+  flatProfileRecord(id_, label_.c_str(), wallTime);
+
+  // Attribute the allocator traffic of the block to this node
+  allocCalls_ += FastAllocatorStats::allocateCalls().load(
+      std::memory_order_relaxed) - allocCallsOnTic_;
+  allocBytes_ += FastAllocatorStats::bytesAllocated().load(
+      std::memory_order_relaxed) - allocBytesOnTic_;
 }
 
 /* ************************************************************************* */
@@ -216,34 +256,210 @@ void TimingOutline::finishedIteration() {
 
 /* ************************************************************************* */
 size_t getTicTocID(const char *descriptionC) {
-  const std::string description(descriptionC);
-  // Global (static) map from strings to ID numbers and current next ID number
-  static size_t nextId = 0;
-  static gtsam::FastMap<std::string, size_t> idMap;
-
-  // Retrieve or add this string
-  gtsam::FastMap<std::string, size_t>::const_iterator it = idMap.find(
-      description);
-  if (it == idMap.end()) {
-    it = idMap.insert(std::make_pair(description, nextId)).first;
-    ++nextId;
+  // The same constexpr hash the gttic macros evaluate at compile time, so
+  // labels only known at runtime get identical ids
+  return labelHash(descriptionC);
+}
+
+/* ************************************************************************* */
+// Chrome-tracing event recording.  Each thread appends to its own buffer, so
+// the hot path takes no lock; the registry mutex is touched only when a
+// thread records its first event and when the trace is written.
+namespace {
+
+struct TraceEvent {
+  const char* label;  ///< string literal from the gttic macro
+  bool begin;         ///< begin (B) or end (E) event
+  double timestampUs; ///< wall time since tracing was enabled
+};
+
+struct TraceBuffer {
+  size_t threadIndex;
+  std::vector<TraceEvent> events;
+};
+
+std::atomic<bool> gTracingEnabled(false);
+std::mutex gTraceMutex;
+// Buffers are owned by the registry and outlive their threads, so events
+// recorded by short-lived worker threads survive until the trace is written
+std::vector<boost::shared_ptr<TraceBuffer> > gTraceBuffers;  // guarded by gTraceMutex
+std::chrono::steady_clock::time_point gTraceEpoch;           // guarded by gTraceMutex
+
+TraceBuffer& localTraceBuffer() {
+  static thread_local TraceBuffer* buffer = nullptr;
+  if (!buffer) {
+    auto owned = boost::make_shared<TraceBuffer>();
+    std::unique_lock<std::mutex> lock(gTraceMutex);
+    owned->threadIndex = gTraceBuffers.size();
+    gTraceBuffers.push_back(owned);
+    buffer = owned.get();
+  }
+  return *buffer;
+}
+
+} // namespace
+
+/* ************************************************************************* */
+void enableChromeTracing(bool enable) {
+  std::unique_lock<std::mutex> lock(gTraceMutex);
+  if (enable) {
+    for (const boost::shared_ptr<TraceBuffer>& buffer : gTraceBuffers)
+      buffer->events.clear();
+    gTraceEpoch = std::chrono::steady_clock::now();
+  }
+  gTracingEnabled.store(enable, std::memory_order_release);
+}
+
+/* ************************************************************************* */
+bool chromeTracingEnabled() {
+  return gTracingEnabled.load(std::memory_order_relaxed);
+}
+
+/* ************************************************************************* */
+void recordTraceEvent(const char* label, bool begin) {
+  TraceEvent event;
+  event.label = label;
+  event.begin = begin;
+  event.timestampUs = std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - gTraceEpoch).count();
+  localTraceBuffer().events.push_back(event);
+}
+
+/* ************************************************************************* */
+void writeChromeTrace(std::ostream& os) {
+  std::unique_lock<std::mutex> lock(gTraceMutex);
+  os << "[";
+  bool first = true;
+  for (const boost::shared_ptr<TraceBuffer>& buffer : gTraceBuffers) {
+    for (const TraceEvent& event : buffer->events) {
+      if (!first)
+        os << ",";
+      first = false;
+      os << "\n{\"name\": \"" << event.label << "\", \"ph\": \""
+         << (event.begin ? 'B' : 'E') << "\", \"pid\": 0, \"tid\": "
+         << buffer->threadIndex << ", \"ts\": " << std::fixed
+         << std::setprecision(3) << event.timestampUs << "}";
+    }
+  }
+  os << "\n]\n";
+}
+
+/* ************************************************************************* */
+void writeChromeTrace(const std::string& filename) {
+  std::ofstream os(filename.c_str());
+  writeChromeTrace(os);
+}
+
+/* ************************************************************************* */
+// Flat always-on profile.  A fixed table of slots, open-addressed by label
+// hash; recording a sample is a slot lookup plus two relaxed atomic
+// additions.  The table is statically zero-initialized, so recording works
+// from static initializers too.
+namespace {
+
+constexpr size_t kFlatProfileSlots = 512;
+
+struct FlatProfileSlot {
+  std::atomic<size_t> hash;         ///< label id, 0 marks an empty slot
+  std::atomic<const char*> label;   ///< string literal from the gttic macro
+  std::atomic<size_t> count;        ///< number of samples
+  std::atomic<size_t> usecs;        ///< total wall time
+};
+
+FlatProfileSlot gFlatProfile[kFlatProfileSlots];
+
+// Find the slot for a hash, claiming an empty one if requested; returns
+// nullptr if the label is absent (or, when claiming, if the table is full)
+FlatProfileSlot* findFlatSlot(size_t hash, bool claim) {
+  if (hash == 0)
+    hash = 1; // 0 marks an empty slot
+  for (size_t probe = 0; probe < kFlatProfileSlots; ++probe) {
+    FlatProfileSlot& slot = gFlatProfile[(hash + probe) % kFlatProfileSlots];
+    size_t stored = slot.hash.load(std::memory_order_relaxed);
+    if (stored == hash)
+      return &slot;
+    if (stored == 0) {
+      if (!claim)
+        return nullptr;
+      size_t expected = 0;
+      if (slot.hash.compare_exchange_strong(expected, hash,
+          std::memory_order_relaxed) || expected == hash)
+        return &slot;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+/* ************************************************************************* */
+void flatProfileRecord(size_t hash, const char* label, size_t usecs) {
+  FlatProfileSlot* slot = findFlatSlot(hash, true);
+  if (!slot)
+    return; // table full - drop the sample
+  if (!slot->label.load(std::memory_order_relaxed))
+    slot->label.store(label, std::memory_order_relaxed);
+  slot->count.fetch_add(1, std::memory_order_relaxed);
+  slot->usecs.fetch_add(usecs, std::memory_order_relaxed);
+}
+
+/* ************************************************************************* */
+size_t flatProfileCount(const char* label) {
+  const FlatProfileSlot* slot = findFlatSlot(labelHash(label), false);
+  return slot ? slot->count.load(std::memory_order_relaxed) : 0;
+}
+
+/* ************************************************************************* */
+void flatProfilePrint(std::ostream& os) {
+  // Gather the occupied slots and print the busiest first
+  typedef std::pair<size_t, const FlatProfileSlot*> Row;
+  std::vector<Row> rows;
+  for (const FlatProfileSlot& slot : gFlatProfile) {
+    if (slot.hash.load(std::memory_order_relaxed) != 0 &&
+        slot.count.load(std::memory_order_relaxed) > 0)
+      rows.push_back(std::make_pair(
+          slot.usecs.load(std::memory_order_relaxed), &slot));
   }
+  std::sort(rows.begin(), rows.end(),
+      [](const Row& a, const Row& b) { return a.first > b.first; });
+  for (const Row& row : rows) {
+    const char* label = row.second->label.load(std::memory_order_relaxed);
+    os << (label ? label : "(unknown)") << ": "
+       << row.second->count.load(std::memory_order_relaxed) << " (times), "
+       << double(row.first) / 1000000.0 << " (wall secs)\n";
+  }
+  os.flush();
+}
 
-  // Return ID
-  return it->second;
+/* ************************************************************************* */
+void flatProfilePrint() {
+  flatProfilePrint(std::cout);
+}
+
+/* ************************************************************************* */
+void flatProfileReset() {
+  for (FlatProfileSlot& slot : gFlatProfile) {
+    slot.hash.store(0, std::memory_order_relaxed);
+    slot.label.store(nullptr, std::memory_order_relaxed);
+    slot.count.store(0, std::memory_order_relaxed);
+    slot.usecs.store(0, std::memory_order_relaxed);
+  }
 }
 
 /* ************************************************************************* */
 void tic(size_t id, const char *labelC) {
-  const std::string label(labelC);
+  if (chromeTracingEnabled())
+    recordTraceEvent(labelC, true);
   boost::shared_ptr<TimingOutline> node = //
-      gCurrentTimer.lock()->child(id, label, gCurrentTimer);
+      gCurrentTimer.lock()->child(id, labelC, gCurrentTimer);
   gCurrentTimer = node;
   node->tic();
 }
 
 /* ************************************************************************* */
 void toc(size_t id, const char *label) {
+  if (chromeTracingEnabled())
+    recordTraceEvent(label, false);
   boost::shared_ptr<TimingOutline> current(gCurrentTimer.lock());
   if (id != current->id_) {
     gTimingRoot->print();
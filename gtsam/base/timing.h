@@ -26,6 +26,7 @@
 #include <boost/version.hpp>
 
 #include <cstddef>
+#include <iosfwd>
 #include <string>
 
 // This file contains the GTSAM timing instrumentation library, a low-overhead method for
@@ -130,7 +131,20 @@
 namespace gtsam {
 
   namespace internal {
-    // Generate/retrieve a unique global ID number that will be used to look up tic/toc statements
+    // Compile-time label ids.  Each gttic call site hashes its label with this
+    // constexpr FNV-1a hash, so the id is a constant baked into the call site -
+    // no registration map, no mutex, and no per-call-site static
+    // initialization guard.
+    constexpr size_t labelHash(const char* label,
+        size_t hash = 14695981039346656037ull) {
+      return *label ?
+          labelHash(label + 1,
+              (hash ^ static_cast<unsigned char>(*label)) * 1099511628211ull) :
+          hash;
+    }
+
+    // The same id computation for labels only known at runtime; kept for
+    // existing callers, equivalent to evaluating labelHash at runtime
     GTSAM_EXPORT size_t getTicTocID(const char *description);
 
     // Create new TimingOutline child for gCurrentTimer, make it gCurrentTimer, and call tic method
@@ -139,6 +153,56 @@ namespace gtsam {
     // Call toc on gCurrentTimer and then set gCurrentTimer to the parent of gCurrentTimer
     GTSAM_EXPORT void toc(size_t id, const char *label);
 
+    // Chrome-tracing event recording.  The TimingOutline tree above is built
+    // through a single global cursor and is therefore only meaningful on the
+    // main thread; inside TBB parallel sections it would race and add
+    // contention.  When tracing is enabled, every tic/toc additionally
+    // appends a begin/end event to a per-thread buffer - no locking on the
+    // hot path - and the buffers are aggregated lazily when the trace is
+    // written.  The resulting file loads in chrome://tracing (or perfetto)
+    // as a per-thread flame graph.  When tracing is disabled the cost is a
+    // single relaxed atomic load, and with ENABLE_TIMING undefined the
+    // gttic/gttoc macros compile away entirely as before.
+
+    /// Start (or stop) recording chrome-tracing events; starting clears any
+    /// previously recorded events
+    GTSAM_EXPORT void enableChromeTracing(bool enable = true);
+
+    /// Whether chrome-tracing events are currently being recorded
+    GTSAM_EXPORT bool chromeTracingEnabled();
+
+    /// Append a begin (or end) event for this thread; label must outlive the
+    /// trace, which holds for the string literals the gttic macros pass
+    GTSAM_EXPORT void recordTraceEvent(const char* label, bool begin);
+
+    /// Merge all per-thread buffers and write chrome://tracing JSON
+    GTSAM_EXPORT void writeChromeTrace(std::ostream& os);
+
+    /// As above, writing to the named file
+    GTSAM_EXPORT void writeChromeTrace(const std::string& filename);
+
+    // Flat always-on profile.  Every toc additionally adds its sample to a
+    // fixed-size slot table indexed by the label hash - two relaxed atomic
+    // additions - yielding per-label call counts and total wall time cheap
+    // enough to leave enabled in production, without walking the timing
+    // tree.  Distinct labels whose 64-bit hashes collide would share a slot;
+    // this is not a practical concern.
+
+    /// Add one sample for the label with the given id (called from toc)
+    GTSAM_EXPORT void flatProfileRecord(size_t hash, const char* label, size_t usecs);
+
+    /// Number of samples recorded for the label, 0 if never seen
+    GTSAM_EXPORT size_t flatProfileCount(const char* label);
+
+    /// Print all labels with their counts and total wall time, busiest first
+    GTSAM_EXPORT void flatProfilePrint(std::ostream& os);
+
+    /// As above, to stdout
+    GTSAM_EXPORT void flatProfilePrint();
+
+    /// Clear all recorded samples
+    GTSAM_EXPORT void flatProfileReset();
+
     /**
      * Timing Entry, arranged in a tree
      */
@@ -156,6 +220,16 @@ namespace gtsam {
       size_t lastChildOrder_;
       std::string label_;
 
+      // Allocation audit: counter snapshots taken on tic and the traffic
+      // attributed to this block on toc (see FastAllocatorStats; counts
+      // cover allocations made through counting allocators, i.e. all Fast*
+      // containers when GTSAM_ALLOCATOR_AUDIT is defined).  Like the times
+      // above these are inclusive of child blocks.
+      size_t allocCalls_;
+      size_t allocBytes_;
+      size_t allocCallsOnTic_;
+      size_t allocBytesOnTic_;
+
       // Tree structure
       boost::weak_ptr<TimingOutline> parent_; ///< parent pointer
       typedef FastMap<size_t, boost::shared_ptr<TimingOutline> > ChildMap;
@@ -182,10 +256,15 @@ namespace gtsam {
       double min()  const { return double(tMin_)  / 1000000.0;} ///< min time, in seconds
       double max()  const { return double(tMax_)  / 1000000.0;} ///< max time, in seconds
       double mean() const { return self() / double(n_); } ///< mean self time, in seconds
+      size_t allocCalls() const { return allocCalls_; } ///< allocations attributed to this block, including children
+      size_t allocBytes() const { return allocBytes_; } ///< bytes allocated in this block, including children
       GTSAM_EXPORT void print(const std::string& outline = "") const;
       GTSAM_EXPORT void print2(const std::string& outline = "", const double parentTotal = -1.0) const;
       GTSAM_EXPORT const boost::shared_ptr<TimingOutline>&
         child(size_t child, const std::string& label, const boost::weak_ptr<TimingOutline>& thisPtr);
+      /// As above, converting the label to a string only if the child must be created
+      GTSAM_EXPORT const boost::shared_ptr<TimingOutline>&
+        child(size_t child, const char* label, const boost::weak_ptr<TimingOutline>& thisPtr);
       GTSAM_EXPORT void tic();
       GTSAM_EXPORT void toc();
       GTSAM_EXPORT void finishedIteration();
@@ -221,14 +300,13 @@ namespace gtsam {
   }
 
 // Tic and toc functions that are always active (whether or not ENABLE_TIMING is defined)
-// There is a trick being used here to achieve near-zero runtime overhead, in that a
-// static variable is created for each tic/toc statement storing an integer ID, but the
-// integer ID is only looked up by string once when the static variable is initialized
-// as the program starts.
+// Each tic/toc statement hashes its label at compile time with labelHash, so the
+// integer ID is a constant folded into the call site - no string is hashed and no
+// registration map is consulted at runtime.
 
 // tic
 #define gttic_(label) \
-  static const size_t label##_id_tic = ::gtsam::internal::getTicTocID(#label); \
+  constexpr size_t label##_id_tic = ::gtsam::internal::labelHash(#label); \
   ::gtsam::internal::AutoTicToc label##_obj(label##_id_tic, #label)
 
 // toc
@@ -237,12 +315,12 @@ namespace gtsam {
 
 // tic
 #define longtic_(label) \
-  static const size_t label##_id_tic = ::gtsam::internal::getTicTocID(#label); \
+  constexpr size_t label##_id_tic = ::gtsam::internal::labelHash(#label); \
   ::gtsam::internal::ticInternal(label##_id_tic, #label)
 
 // toc
 #define longtoc_(label) \
-  static const size_t label##_id_toc = ::gtsam::internal::getTicTocID(#label); \
+  constexpr size_t label##_id_toc = ::gtsam::internal::labelHash(#label); \
   ::gtsam::internal::tocInternal(label##_id_toc, #label)
 
 // indicate iteration is finished
@@ -257,12 +335,24 @@ inline void tictoc_print_() {
 inline void tictoc_print2_() {
   ::gtsam::internal::gTimingRoot->print2(); }
 
+// print the flat always-on profile (per-label counts and total wall time)
+inline void tictoc_printFlat_() {
+  ::gtsam::internal::flatProfilePrint(); }
+
 // get a node by label and assign it to variable
 #define tictoc_getNode(variable, label) \
   static const size_t label##_id_getnode = ::gtsam::internal::getTicTocID(#label); \
   const boost::shared_ptr<const ::gtsam::internal::TimingOutline> variable = \
   ::gtsam::internal::gCurrentTimer.lock()->child(label##_id_getnode, #label, ::gtsam::internal::gCurrentTimer);
 
+// start/stop chrome-tracing event recording
+inline void tictoc_enableChromeTracing_(bool enable = true) {
+  ::gtsam::internal::enableChromeTracing(enable); }
+
+// write recorded events to a chrome://tracing JSON file
+inline void tictoc_writeChromeTrace_(const std::string& filename) {
+  ::gtsam::internal::writeChromeTrace(filename); }
+
 // reset
 inline void tictoc_reset_() {
   ::gtsam::internal::gTimingRoot.reset(new ::gtsam::internal::TimingOutline("Total", ::gtsam::internal::getTicTocID("Total")));
@@ -276,6 +366,8 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration tictoc_finishedIteration_
 #define tictoc_print tictoc_print_
 #define tictoc_reset tictoc_reset_
+#define tictoc_enableChromeTracing tictoc_enableChromeTracing_
+#define tictoc_writeChromeTrace tictoc_writeChromeTrace_
 #else
 #define gttic(label) ((void)0)
 #define gttoc(label) ((void)0)
@@ -284,6 +376,8 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration() ((void)0)
 #define tictoc_print() ((void)0)
 #define tictoc_reset() ((void)0)
+#define tictoc_enableChromeTracing(...) ((void)0)
+#define tictoc_writeChromeTrace(...) ((void)0)
 #endif
 
 }
@@ -24,12 +24,22 @@
 #include <gtsam/inference/Key.h>
 #include <gtsam/config.h> // for GTSAM_USE_TBB
 
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <stack>
+#include <thread>
 #include <vector>
 #include <string>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace gtsam {
 
 /** Internal functions used for traversing trees */
@@ -37,18 +47,6 @@ namespace treeTraversal {
 
 /* ************************************************************************* */
 namespace {
-// Internal node used in DFS preorder stack
-template<typename NODE, typename DATA>
-struct TraversalNode {
-  bool expanded;
-  const boost::shared_ptr<NODE>& treeNode;
-  DATA& parentData;
-  typename FastList<DATA>::iterator dataPointer;
-  TraversalNode(const boost::shared_ptr<NODE>& _treeNode, DATA& _parentData) :
-      expanded(false), treeNode(_treeNode), parentData(_parentData) {
-  }
-};
-
 // Do nothing - default argument for post-visitor for tree traversal
 struct no_op {
   template<typename NODE, typename DATA>
@@ -58,6 +56,24 @@ struct no_op {
 
 }
 
+/** Reusable workspace for the iterative depth-first engine below.  The entry
+ *  stack is type-erased (it stores the address of each node's shared pointer
+ *  and indices into the per-sweep data stack), so a single workspace can be
+ *  handed to successive sweeps of different tree algorithms - elimination,
+ *  backsubstitution, cloning - and the stack capacity is allocated only once
+ *  instead of per visit.  A default-constructed workspace is created
+ *  internally when none is supplied. */
+struct TraversalWorkspace {
+  /// One entry per node on the current root-to-leaf path plus pending siblings
+  struct Entry {
+    const void* treeNode; ///< Address of the shared pointer to the node
+    size_t parentData;    ///< Index of the parent's data on the data stack
+    size_t data;          ///< Index of this node's data, once pre-visited
+    bool expanded;        ///< Whether the children have been pushed
+  };
+  std::vector<Entry> stack;
+};
+
 /** Traverse a forest depth-first with pre-order and post-order visits.
  *  @param forest The forest of trees to traverse.  The method \c forest.roots() should exist
  *         and return a collection of (shared) pointers to \c FOREST::Node.
@@ -71,51 +87,82 @@ struct no_op {
  *         its children, and will be passed, by reference, the \c DATA object returned by the
  *         call to \c visitorPre (the \c DATA object may be modified by visiting the children).
  *  @param rootData The data to pass by reference to \c visitorPre when it is called on each
- *         root node. */
+ *         root node.
+ *  @param workspace A TraversalWorkspace whose entry stack is reused, so that repeated
+ *         sweeps (e.g. every iSAM2 update) pay no per-node allocation. */
 template<class FOREST, typename DATA, typename VISITOR_PRE,
     typename VISITOR_POST>
 void DepthFirstForest(FOREST& forest, DATA& rootData, VISITOR_PRE& visitorPre,
-    VISITOR_POST& visitorPost) {
+    VISITOR_POST& visitorPost, TraversalWorkspace& workspace) {
   // Typedefs
   typedef typename FOREST::Node Node;
   typedef boost::shared_ptr<Node> sharedNode;
+  typedef TraversalWorkspace::Entry Entry;
+  static const size_t kRootData = size_t(-1); // parentData index of the roots
 
-  // Depth first traversal stack
-  typedef TraversalNode<typename FOREST::Node, DATA> TraversalNode;
-  typedef FastList<TraversalNode> Stack;
-  Stack stack;
-  FastList<DATA> dataList; // List to store node data as it is returned from the pre-order visitor
-
-  // Add roots to stack (insert such that they are visited and processed in order
-  {
-    typename Stack::iterator insertLocation = stack.begin();
-    for(const sharedNode& root: forest.roots())
-      stack.insert(insertLocation, TraversalNode(root, rootData));
+  // Explicit traversal stack, reused across sweeps through the workspace.  Node data has
+  // strictly stack-like lifetime (created by the pre-visit, destroyed by the post-visit after
+  // all children), so it lives on a plain deque indexed by the stack entries - no per-node
+  // list allocation, and references handed to visitors stay valid across pushes.
+  std::vector<Entry>& stack = workspace.stack;
+  stack.clear();
+  std::deque<DATA> dataStack;
+
+  // Add roots to the stack, reversed so that they are visited and processed in order
+  for(const sharedNode& root: forest.roots()) {
+    Entry entry = { &root, kRootData, kRootData, false };
+    stack.push_back(entry);
   }
+  std::reverse(stack.begin(), stack.end());
 
   // Traverse
   while (!stack.empty()) {
     // Get next node
-    TraversalNode& node = stack.front();
-
-    if (node.expanded) {
-      // If already expanded, then the data stored in the node is no longer needed, so visit
-      // then delete it.
-      (void) visitorPost(node.treeNode, *node.dataPointer);
-      dataList.erase(node.dataPointer);
-      stack.pop_front();
+    Entry& entry = stack.back();
+    const sharedNode& treeNode = *static_cast<const sharedNode*>(entry.treeNode);
+
+    if (entry.expanded) {
+      // If already expanded, then the data stored for the node is no longer needed, so visit
+      // then release it.
+      (void) visitorPost(treeNode, dataStack[entry.data]);
+      dataStack.pop_back();
+      stack.pop_back();
     } else {
-      // If not already visited, visit the node and add its children (use reverse iterators so
-      // children are processed in the order they appear)
-      node.dataPointer = dataList.insert(dataList.end(),
-          visitorPre(node.treeNode, node.parentData));
-      typename Stack::iterator insertLocation = stack.begin();
-      for(const sharedNode& child: node.treeNode->children)
-        stack.insert(insertLocation, TraversalNode(child, *node.dataPointer));
-      node.expanded = true;
+      // If not already visited, visit the node and add its children, reversed so they are
+      // processed in the order they appear.  'entry' is invalidated by the child pushes, so
+      // record everything it needs first.
+      const size_t myData = dataStack.size();
+      entry.data = myData;
+      entry.expanded = true;
+      DATA& parentData = (entry.parentData == kRootData) ?
+          rootData : dataStack[entry.parentData];
+      dataStack.push_back(visitorPre(treeNode, parentData));
+      const size_t childrenBegin = stack.size();
+      for(const sharedNode& child: treeNode->children) {
+        Entry childEntry = { &child, myData, kRootData, false };
+        stack.push_back(childEntry);
+      }
+      std::reverse(stack.begin() + childrenBegin, stack.end());
     }
+
+#if defined(__GNUC__)
+    // Warm the node we will dereference on the next iteration; the visitor call above covers
+    // the latency of the pointer chase into the next clique.
+    if (!stack.empty())
+      __builtin_prefetch(static_cast<const sharedNode*>(stack.back().treeNode)->get());
+#endif
   }
-  assert(dataList.empty());
+  assert(dataStack.empty());
+}
+
+/** Traverse a forest depth-first with pre-order and post-order visits, using an internal
+ *  single-use workspace.  See the overload above for the visitor contract. */
+template<class FOREST, typename DATA, typename VISITOR_PRE,
+    typename VISITOR_POST>
+void DepthFirstForest(FOREST& forest, DATA& rootData, VISITOR_PRE& visitorPre,
+    VISITOR_POST& visitorPost) {
+  TraversalWorkspace workspace;
+  DepthFirstForest(forest, rootData, visitorPre, visitorPost, workspace);
 }
 
 /** Traverse a forest depth-first, with a pre-order visit but no post-order visit.
@@ -166,6 +213,89 @@ void DepthFirstForestParallel(FOREST& forest, DATA& rootData,
 #endif
 }
 
+/* ************************************************************************* */
+namespace {
+// Pin the calling thread to a contiguous block of CPUs for the given domain.
+// With one domain per socket the block partition approximates the socket
+// boundaries, so a domain's worker stays on one socket.  No-op off Linux.
+inline void pinThreadToDomain(size_t domain, size_t nrDomains) {
+#ifdef __linux__
+  const unsigned nrCpus = std::thread::hardware_concurrency();
+  if (nrCpus == 0 || nrDomains == 0) return;
+  const unsigned perDomain = std::max(1u, nrCpus / (unsigned)nrDomains);
+  if (domain * perDomain >= nrCpus) return;
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (unsigned cpu = domain * perDomain;
+      cpu < (domain + 1) * perDomain && cpu < nrCpus; ++cpu)
+    CPU_SET(cpu, &cpuset);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#else
+  (void)domain;
+  (void)nrDomains;
+#endif
+}
+}
+
+/** Traverse a forest with whole root subtrees partitioned over a fixed pool
+ *  of worker threads ("domains").  Each worker is pinned to its own
+ *  contiguous block of CPUs (Linux only; elsewhere only the partitioning
+ *  applies), so that with one domain per socket everything a subtree
+ *  allocates and first touches - in elimination, the clique workspace
+ *  matrices - lands in that socket's memory and the later bottom-up merge
+ *  reads mostly local pages.  Subtrees are dealt round-robin to domains;
+ *  visitors see the same contract as in DepthFirstForestParallel and must
+ *  tolerate concurrent visits of different subtrees.
+ *  @param nrDomains Number of worker threads / CPU blocks; 0 picks the
+ *         hardware concurrency. */
+template<class FOREST, typename DATA, typename VISITOR_PRE,
+    typename VISITOR_POST>
+void DepthFirstForestPartitioned(FOREST& forest, DATA& rootData,
+    VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+    size_t nrDomains = 0) {
+  typedef typename FOREST::Node TreeNode;
+  typedef boost::shared_ptr<TreeNode> sharedNode;
+
+  // A single-subtree view on the forest, traversed sequentially per worker
+  struct SubForest {
+    typedef TreeNode Node;
+    FastVector<sharedNode> roots_;
+    const FastVector<sharedNode>& roots() const { return roots_; }
+  };
+
+  if (nrDomains == 0) nrDomains = std::thread::hardware_concurrency();
+  const FastVector<sharedNode> roots(forest.roots().begin(),
+      forest.roots().end());
+  if (nrDomains < 2 || roots.size() < 2) {
+    DepthFirstForest(forest, rootData, visitorPre, visitorPost);
+    return;
+  }
+  nrDomains = std::min(nrDomains, roots.size());
+
+  std::vector<std::exception_ptr> errors(nrDomains);
+  std::vector<std::thread> workers;
+  for (size_t domain = 0; domain < nrDomains; ++domain) {
+    workers.push_back(std::thread(
+        [domain, nrDomains, &roots, &rootData, &visitorPre, &visitorPost,
+            &errors]() {
+          try {
+            pinThreadToDomain(domain, nrDomains);
+            for (size_t i = domain; i < roots.size(); i += nrDomains) {
+              SubForest subtree;
+              subtree.roots_.push_back(roots[i]);
+              DepthFirstForest(subtree, rootData, visitorPre, visitorPost);
+            }
+          } catch (...) {
+            errors[domain] = std::current_exception();
+          }
+        }));
+  }
+  for (size_t domain = 0; domain < nrDomains; ++domain)
+    workers[domain].join();
+  for (size_t domain = 0; domain < nrDomains; ++domain)
+    if (errors[domain]) std::rethrow_exception(errors[domain]);
+}
+
 /* ************************************************************************* */
 /** Traversal function for CloneForest */
 namespace {
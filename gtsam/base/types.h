@@ -189,6 +189,21 @@ namespace gtsam {
   }
 #endif
 
+/* ************************************************************************* */
+/** A contract check on a hot path whose condition is already guaranteed by a
+* graph-assembly boundary (see, e.g., VectorValues::hasSameStructure).
+* Checked by default, including in release builds.  Configure with
+* GTSAM_UNCHECKED_HOT_PATHS to compile these checks out of NDEBUG builds so
+* the inner loops run unchecked; debug builds always keep full checking. */
+#if defined(NDEBUG) && defined(GTSAM_UNCHECKED_HOT_PATHS)
+#define check_hot(CONDITION, EXCEPTION) ((void)0)
+#else
+#define check_hot(CONDITION, EXCEPTION) \
+  if (!(CONDITION)) { \
+  throw (EXCEPTION); \
+  }
+#endif
+
 #ifdef _MSC_VER
 
 // Define some common g++ functions and macros we use that MSVC does not have
@@ -126,9 +126,9 @@ namespace gtsam {
       return fC.apply_fC_op_gL(*this, op); // operand order back to normal
     }
 
-    /** choose a branch, create new memory ! */
+    /** choose a branch: a leaf does not depend on any label, share it */
     NodePtr choose(const L& label, size_t index) const {
-      return NodePtr(new Leaf(constant()));
+      return this->shared_from_this();
     }
 
     bool isLeaf() const { return true; }
@@ -164,8 +164,18 @@ namespace gtsam {
     /** If all branches of a choice node f are the same, just return a branch */
     static NodePtr Unique(const ChoicePtr& f) {
 #ifndef DT_NO_PRUNING
+      // With structural sharing the branches can all be the very same node, in
+      // which case the choice is redundant whatever the subtree holds
+      assert(f->branches().size() > 0);
+      bool allIdentical = true;
+      for (size_t i = 1; i < f->branches_.size(); i++)
+        if (f->branches_[i] != f->branches_[0]) {
+          allIdentical = false;
+          break;
+        }
+      if (allIdentical)
+        return f->branches_[0];
       if (f->allSame_) {
-        assert(f->branches().size() > 0);
         NodePtr f0 = f->branches_[0];
         assert(f0->isLeaf());
         NodePtr newLeaf(new Leaf(boost::dynamic_pointer_cast<const Leaf>(f0)->constant()));
@@ -277,6 +287,7 @@ namespace gtsam {
 
     /** equality up to tolerance */
     bool equals(const Node& q, double tol) const {
+      if (this == &q) return true; // shared subtrees compare in O(1)
       const Choice* other = dynamic_cast<const Choice*> (&q);
       if (!other) return false;
       if (this->label_ != other->label_) return false;
@@ -356,6 +367,11 @@ namespace gtsam {
       if (label_ == label)
         return branches_[index]; // choose branch
 
+      // labels are ordered with the highest at the root, so a label higher
+      // than ours cannot occur below: share the whole subtree
+      if (label > label_)
+        return this->shared_from_this();
+
       // second case, not label of interest, just recurse
       boost::shared_ptr<Choice> r(new Choice(label_, branches_.size()));
       for(const NodePtr& branch: branches_)
@@ -625,12 +641,55 @@ namespace gtsam {
     return DecisionTree(root_->apply(op));
   }
 
+  /*********************************************************************************/
+  // Recursive binary apply with a cache on (f, g) node pairs.  In a tree with
+  // shared subtrees the same pair is reached along many paths; the cache makes
+  // each pair cost one op and lets all paths share the resulting subtree,
+  // instead of blowing the shared structure back up into a full tree.
+  template<typename L, typename Y>
+  typename DecisionTree<L, Y>::NodePtr DecisionTree<L, Y>::applyBinary(
+      const NodePtr& f, const NodePtr& g, const Binary& op,
+      std::map<std::pair<const Node*, const Node*>, NodePtr>& memo) {
+    typedef std::pair<const Node*, const Node*> NodePair;
+    const NodePair key(f.get(), g.get());
+    typename std::map<NodePair, NodePtr>::const_iterator it = memo.find(key);
+    if (it != memo.end()) return it->second;
+
+    NodePtr result;
+    const Choice* fC = dynamic_cast<const Choice*>(f.get());
+    const Choice* gC = dynamic_cast<const Choice*>(g.get());
+    if (!fC && !gC) {
+      // two leaves, delegate to the leaf version of op
+      result = f->apply_f_op_g(*g, op);
+    } else {
+      // expand on the highest label, as in the Choice binary constructor
+      boost::shared_ptr<Choice> h;
+      if (fC && (!gC || fC->label() > gC->label())) {
+        h.reset(new Choice(fC->label(), fC->nrChoices()));
+        for(const NodePtr& branch: fC->branches())
+          h->push_back(applyBinary(branch, g, op, memo));
+      } else if (gC && (!fC || gC->label() > fC->label())) {
+        h.reset(new Choice(gC->label(), gC->nrChoices()));
+        for(const NodePtr& branch: gC->branches())
+          h->push_back(applyBinary(f, branch, op, memo));
+      } else {
+        h.reset(new Choice(fC->label(), fC->nrChoices()));
+        for (size_t i = 0; i < fC->nrChoices(); i++)
+          h->push_back(applyBinary(fC->branches()[i], gC->branches()[i], op, memo));
+      }
+      result = Choice::Unique(h);
+    }
+    memo[key] = result;
+    return result;
+  }
+
   /*********************************************************************************/
   template<typename L, typename Y>
   DecisionTree<L, Y> DecisionTree<L, Y>::apply(const DecisionTree& g,
       const Binary& op) const {
-    // apply the operaton on the root of both diagrams
-    NodePtr h = root_->apply_f_op_g(*g.root_, op);
+    // apply the operation on the root of both diagrams, with a per-call cache
+    std::map<std::pair<const Node*, const Node*>, NodePtr> memo;
+    NodePtr h = applyBinary(root_, g.root_, op, memo);
     // create a new class with the resulting root "h"
     DecisionTree result(h);
     return result;
@@ -20,8 +20,10 @@
 #pragma once
 
 #include <gtsam/discrete/Assignment.h>
+#include <boost/enable_shared_from_this.hpp>
 #include <boost/function.hpp>
 #include <iostream>
+#include <utility>
 #include <vector>
 #include <map>
 
@@ -49,7 +51,7 @@ namespace gtsam {
     class Choice;
 
     /** ------------------------ Node base class --------------------------- */
-    class Node {
+    class Node: public boost::enable_shared_from_this<Node> {
     public:
       typedef boost::shared_ptr<const Node> Ptr;
 
@@ -109,6 +111,13 @@ namespace gtsam {
     convert(const typename DecisionTree<M, X>::NodePtr& f, const std::map<M,
         L>& map, boost::function<Y(const X&)> op);
 
+    /** Internal recursive binary apply with a cache keyed on node pairs:
+     * subtree pairs reached along several paths are combined only once, and
+     * all those paths share the resulting subtree */
+    static NodePtr applyBinary(const NodePtr& f, const NodePtr& g,
+        const Binary& op,
+        std::map<std::pair<const Node*, const Node*>, NodePtr>& memo);
+
     /** Default constructor */
     DecisionTree();
 
@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file DiscreteAliasSampler.cpp
+ * @brief Compiled O(1) sampler for a DiscreteConditional using alias tables
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/discrete/DiscreteAliasSampler.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ******************************************************************************** */
+DiscreteAliasSampler::DiscreteAliasSampler(
+    const DiscreteConditional& conditional)
+    : rng_(2) {
+  if (conditional.nrFrontals() != 1)
+    throw invalid_argument(
+        "DiscreteAliasSampler: only single-frontal conditionals are supported");
+  frontalKey_ = conditional.firstFrontalKey();
+  frontalCardinality_ = conditional.cardinality(frontalKey_);
+
+  parents_ = KeyVector(conditional.beginParents(), conditional.endParents());
+  nrTables_ = 1;
+  for (Key parent : parents_) {
+    parentCardinalities_.push_back(conditional.cardinality(parent));
+    nrTables_ *= parentCardinalities_.back();
+  }
+
+  const size_t n = frontalCardinality_;
+  prob_.resize(nrTables_ * n);
+  alias_.resize(nrTables_ * n);
+
+  vector<double> p(n), scaled(n);
+  vector<size_t> small, large;
+  for (size_t t = 0; t < nrTables_; t++) {
+    // Decode table index into the parent assignment it stands for, using the
+    // same mixed-radix convention as tableIndex
+    Values values;
+    size_t remainder = t;
+    for (size_t i = parents_.size(); i > 0; i--) {
+      values[parents_[i - 1]] = remainder % parentCardinalities_[i - 1];
+      remainder /= parentCardinalities_[i - 1];
+    }
+
+    // Conditional probabilities of the frontal variable for this assignment
+    double sum = 0.0;
+    for (size_t v = 0; v < n; v++) {
+      values[frontalKey_] = v;
+      p[v] = conditional(values);
+      sum += p[v];
+    }
+    if (sum <= 0.0)
+      throw invalid_argument(
+          "DiscreteAliasSampler: conditional sums to zero for a parent assignment");
+
+    // Build the alias table with Vose's algorithm: probabilities scaled so
+    // the average slot is exactly full, then overfull slots donate to
+    // underfull ones until every slot holds at most two outcomes
+    small.clear();
+    large.clear();
+    for (size_t v = 0; v < n; v++) {
+      scaled[v] = p[v] * double(n) / sum;
+      (scaled[v] < 1.0 ? small : large).push_back(v);
+    }
+    double* prob = &prob_[t * n];
+    size_t* alias = &alias_[t * n];
+    while (!small.empty() && !large.empty()) {
+      const size_t underfull = small.back(), overfull = large.back();
+      small.pop_back();
+      large.pop_back();
+      prob[underfull] = scaled[underfull];
+      alias[underfull] = overfull;
+      scaled[overfull] -= 1.0 - scaled[underfull];
+      (scaled[overfull] < 1.0 ? small : large).push_back(overfull);
+    }
+    // Leftovers are full slots up to rounding
+    for (size_t v : small) prob[v] = 1.0, alias[v] = v;
+    for (size_t v : large) prob[v] = 1.0, alias[v] = v;
+  }
+}
+
+/* ******************************************************************************** */
+size_t DiscreteAliasSampler::tableIndex(const Values& parentsValues) const {
+  size_t index = 0;
+  for (size_t i = 0; i < parents_.size(); i++) {
+    const Values::const_iterator it = parentsValues.find(parents_[i]);
+    if (it == parentsValues.end())
+      throw invalid_argument(
+          "DiscreteAliasSampler: missing value for parent variable");
+    index = index * parentCardinalities_[i] + it->second;
+  }
+  return index;
+}
+
+/* ******************************************************************************** */
+size_t DiscreteAliasSampler::sample(const Values& parentsValues) const {
+  const size_t base = tableIndex(parentsValues) * frontalCardinality_;
+  uniform_int_distribution<size_t> slots(0, frontalCardinality_ - 1);
+  uniform_real_distribution<double> coin(0.0, 1.0);
+  const size_t slot = slots(rng_);
+  return coin(rng_) < prob_[base + slot] ? slot : alias_[base + slot];
+}
+
+/* ******************************************************************************** */
+vector<size_t> DiscreteAliasSampler::sample(const Values& parentsValues,
+    size_t count) const {
+  const size_t base = tableIndex(parentsValues) * frontalCardinality_;
+  const double* prob = &prob_[base];
+  const size_t* alias = &alias_[base];
+  uniform_int_distribution<size_t> slots(0, frontalCardinality_ - 1);
+  uniform_real_distribution<double> coin(0.0, 1.0);
+  vector<size_t> samples(count);
+  for (size_t i = 0; i < count; i++) {
+    const size_t slot = slots(rng_);
+    samples[i] = coin(rng_) < prob[slot] ? slot : alias[slot];
+  }
+  return samples;
+}
+
+/* ******************************************************************************** */
+
+}  // \ namespace gtsam
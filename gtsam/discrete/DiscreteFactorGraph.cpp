@@ -26,6 +26,11 @@
 #include <gtsam/inference/EliminateableFactorGraph-inst.h>
 #include <boost/make_shared.hpp>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_reduce.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 namespace gtsam {
 
   // Instantiate base classes
@@ -47,11 +52,33 @@ namespace gtsam {
   }
 
   /* ************************************************************************* */
-  DecisionTreeFactor DiscreteFactorGraph::product() const {
+  // Multiply a set of factors. With TBB, products of disjoint chunks are
+  // formed concurrently and combined pairwise; multiplication is associative
+  // and commutative and the decision trees are immutable, so this is safe.
+  static DecisionTreeFactor ProductOfFactors(const DiscreteFactorGraph& factors) {
+#ifdef GTSAM_USE_TBB
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, factors.size()), DecisionTreeFactor(),
+        [&factors](const tbb::blocked_range<size_t>& range,
+            DecisionTreeFactor result) {
+          for (size_t i = range.begin(); i != range.end(); ++i)
+            if (factors[i]) result = (*factors[i]) * result;
+          return result;
+        },
+        [](const DecisionTreeFactor& f, const DecisionTreeFactor& g) {
+          return f * g;
+        });
+#else
     DecisionTreeFactor result;
-    for(const sharedFactor& factor: *this)
+    for(const DiscreteFactor::shared_ptr& factor: factors)
       if (factor) result = (*factor) * result;
     return result;
+#endif
+  }
+
+  /* ************************************************************************* */
+  DecisionTreeFactor DiscreteFactorGraph::product() const {
+    return ProductOfFactors(*this);
   }
 
   /* ************************************************************************* */
@@ -104,11 +131,25 @@ namespace gtsam {
   std::pair<DiscreteConditional::shared_ptr, DecisionTreeFactor::shared_ptr>  //
   EliminateDiscrete(const DiscreteFactorGraph& factors, const Ordering& frontalKeys) {
 
-    // PRODUCT: multiply all factors
+    // Factors that do not involve any frontal key distribute over the sum
+    // below: sum_F (P * S) = (sum_F P) * S. Set them aside here and multiply
+    // them into the separator factor afterwards, so the full product is never
+    // materialized. They cancel in product/sum, leaving the conditional
+    // unchanged.
+    KeySet frontalSet(frontalKeys.begin(), frontalKeys.end());
+    DiscreteFactorGraph involved, spectators;
+    for(const DiscreteFactor::shared_ptr& factor: factors) {
+      if (!factor) continue;
+      bool touchesFrontal = false;
+      for(Key key: *factor)
+        if (frontalSet.count(key)) { touchesFrontal = true; break; }
+      if (touchesFrontal) involved.push_back(factor);
+      else spectators.push_back(factor);
+    }
+
+    // PRODUCT: multiply all factors involving a frontal key
     gttic(product);
-    DecisionTreeFactor product;
-    for(const DiscreteFactor::shared_ptr& factor: factors)
-      product = (*factor) * product;
+    DecisionTreeFactor product = ProductOfFactors(involved);
     gttoc(product);
 
     // sum out frontals, this is the factor on the separator
@@ -126,6 +167,11 @@ namespace gtsam {
     DiscreteConditional::shared_ptr cond(new DiscreteConditional(product, *sum, orderedKeys));
     gttoc(divide);
 
+    // multiply the spectator factors back into the separator factor
+    if (spectators.size() > 0)
+      sum = boost::make_shared<DecisionTreeFactor>(
+          (*sum) * ProductOfFactors(spectators));
+
     return std::make_pair(cond, sum);
   }
 
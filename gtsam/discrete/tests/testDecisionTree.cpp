@@ -174,6 +174,28 @@ TEST(DT, example)
   DOT(acnotb);
 }
 
+/* ******************************************************************************** */
+// test structural sharing introduced by choose and the apply cache
+TEST(DT, StructureSharing)
+{
+  string A("A"), B("B");
+
+  DT a(A, 1, 2), b(A, 3, 4);
+  DT f(B, a, b);
+
+  // choosing the root label returns the stored branch, not a copy
+  DT f0 = f.choose(B, 0);
+  CHECK(f0.root_ == a.root_);
+
+  // restricting on a label above the current root shares the whole tree
+  DT g = f0.choose(B, 1);
+  CHECK(g.root_ == f0.root_);
+
+  // apply still computes correct values on shared structure
+  DT sum = apply(f0, g, &Ring::add);
+  EXPECT(assert_equal(DT(A, 2, 4), sum));
+}
+
 /* ******************************************************************************** */
 // test Conversion
 enum Label {
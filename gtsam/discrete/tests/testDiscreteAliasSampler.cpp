@@ -0,0 +1,89 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/*
+ * @file    testDiscreteAliasSampler.cpp
+ * @brief   unit tests for DiscreteAliasSampler
+ * @author  Frank Dellaert
+ * @date Aug 30, 2026
+ */
+
+#include <gtsam/discrete/DiscreteAliasSampler.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(DiscreteAliasSampler, Prior) {
+  DiscreteKey X(0, 3);
+  DiscreteConditional prior(X % "1/2/7");
+  DiscreteAliasSampler sampler(prior);
+  EXPECT_LONGS_EQUAL(3, sampler.cardinality());
+  EXPECT_LONGS_EQUAL(1, sampler.nrTables());
+
+  // Empirical frequencies of a large batch match the distribution
+  DiscreteAliasSampler::Values noParents;
+  const size_t N = 100000;
+  vector<size_t> counts(3, 0);
+  for (size_t sampled : sampler.sample(noParents, N)) counts[sampled]++;
+  DOUBLES_EQUAL(0.1, double(counts[0]) / N, 0.01);
+  DOUBLES_EQUAL(0.2, double(counts[1]) / N, 0.01);
+  DOUBLES_EQUAL(0.7, double(counts[2]) / N, 0.01);
+}
+
+/* ************************************************************************* */
+TEST(DiscreteAliasSampler, Conditional) {
+  DiscreteKey X(0, 2), Y(1, 3);
+  DiscreteConditional conditional(X | Y = "1/3 2/2 3/1");
+  DiscreteAliasSampler sampler(conditional);
+  EXPECT_LONGS_EQUAL(2, sampler.cardinality());
+  EXPECT_LONGS_EQUAL(3, sampler.nrTables());
+
+  // For every parent assignment the sampler reproduces the conditional
+  const double expected[3] = { 0.25, 0.5, 0.75 };
+  const size_t N = 100000;
+  for (size_t y = 0; y < 3; y++) {
+    DiscreteAliasSampler::Values parents;
+    parents[Y.first] = y;
+    size_t count = 0;
+    for (size_t sampled : sampler.sample(parents, N))
+      if (sampled == 0) count++;
+    DOUBLES_EQUAL(expected[y], double(count) / N, 0.01);
+
+    // Single draws use the same tables
+    const size_t sampled = sampler.sample(parents);
+    CHECK(sampled < 2);
+  }
+
+  // Missing parent values are an error
+  DiscreteAliasSampler::Values empty;
+  CHECK_EXCEPTION(sampler.sample(empty), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(DiscreteAliasSampler, MultiFrontalThrows) {
+  DiscreteKey X(0, 2), Y(1, 2);
+  DecisionTreeFactor f(X & Y, "0.25 0.25 0.25 0.25");
+  DiscreteConditional joint(2, f);
+  CHECK_EXCEPTION(DiscreteAliasSampler sampler(joint), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -173,6 +173,38 @@ TEST( DiscreteFactorGraph, test)
   EXPECT(assert_equal(expectedValues, *actualValues));
 }
 
+/* ************************************************************************* */
+TEST( DiscreteFactorGraph, spectatorFactors)
+{
+  // Declare keys
+  DiscreteKey C(0,2), B(1,2), A(2,2);
+
+  // Same graph as above, plus a factor fAB that does not touch the
+  // eliminated variable C: it should end up in the separator factor
+  // without being multiplied into the product over C
+  DiscreteFactorGraph graph;
+  graph.add(A & C, "3 1 1 3");
+  graph.add(C & B, "3 1 1 3");
+  graph.add(B & A, "2 1 1 2");
+
+  Ordering frontalKeys;
+  frontalKeys += Key(0);
+  DiscreteConditional::shared_ptr conditional;
+  DecisionTreeFactor::shared_ptr newFactor;
+  boost::tie(conditional, newFactor) = EliminateDiscrete(graph, frontalKeys);
+
+  // The conditional is unaffected by fAB, which cancels in product/sum
+  CHECK(conditional);
+  DiscreteConditional expectedConditional((C | B, A) = "9/1 1/1 1/1 1/9");
+  EXPECT(assert_equal(expectedConditional, *conditional));
+
+  // The separator factor carries fAB
+  CHECK(newFactor);
+  DecisionTreeFactor expectedFactor = //
+      DecisionTreeFactor(B & A, "10 6 6 10") * DecisionTreeFactor(B & A, "2 1 1 2");
+  EXPECT(assert_equal(expectedFactor, *newFactor));
+}
+
 /* ************************************************************************* */
 TEST( DiscreteFactorGraph, testMPE)
 {
@@ -129,6 +129,33 @@ Point2 Cal3DS2_Base::uncalibrate(const Point2& p,
   return Point2(fx_ * pnx + s_ * pny + u0_, fy_ * pny + v0_);
 }
 
+/* ************************************************************************* */
+Point2Vector Cal3DS2_Base::uncalibrate(const Point2Vector& ps) const {
+  const Eigen::Index n = static_cast<Eigen::Index>(ps.size());
+  Eigen::ArrayXd x(n), y(n);
+  for (Eigen::Index i = 0; i < n; ++i) {
+    x[i] = ps[i].x();
+    y[i] = ps[i].y();
+  }
+
+  // Same distortion polynomial as the scalar version, evaluated column-wise
+  // so Eigen vectorizes across points
+  const Eigen::ArrayXd xx = x * x, yy = y * y, xy = x * y;
+  const Eigen::ArrayXd rr = xx + yy;
+  const Eigen::ArrayXd g = 1. + k1_ * rr + k2_ * rr * rr;
+  const Eigen::ArrayXd dx = 2. * p1_ * xy + p2_ * (rr + 2. * xx);
+  const Eigen::ArrayXd dy = 2. * p2_ * xy + p1_ * (rr + 2. * yy);
+  const Eigen::ArrayXd pnx = g * x + dx;
+  const Eigen::ArrayXd pny = g * y + dy;
+
+  Point2Vector pis;
+  pis.reserve(ps.size());
+  for (Eigen::Index i = 0; i < n; ++i)
+    pis.push_back(
+        Point2(fx_ * pnx[i] + s_ * pny[i] + u0_, fy_ * pny[i] + v0_));
+  return pis;
+}
+
 /* ************************************************************************* */
 Point2 Cal3DS2_Base::calibrate(const Point2& pi, const double tol) const {
   // Use the following fixed point iteration to invert the radial distortion.
@@ -125,6 +125,13 @@ public:
        OptionalJacobian<2,9> Dcal = boost::none,
        OptionalJacobian<2,2> Dp = boost::none) const ;
 
+  /**
+   * Batch version of uncalibrate without Jacobians: applies the distortion
+   * to all points in one structure-of-arrays evaluation, which Eigen
+   * vectorizes across points.  Front-end workhorse for large feature sets.
+   */
+  Point2Vector uncalibrate(const Point2Vector& ps) const;
+
   /// Convert (distorted) image coordinates uv to intrinsic coordinates xy
   Point2 calibrate(const Point2& p, const double tol=1e-5) const;
 
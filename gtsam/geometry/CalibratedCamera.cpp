@@ -122,16 +122,23 @@ Point2 PinholeBase::project2(const Point3& point, OptionalJacobian<2, 6> Dpose,
   if (q.z() <= 0)
     throw CheiralityException();
 #endif
-  const Point2 pn = Project(q);
-
-  if (Dpose || Dpoint) {
-    const double d = 1.0 / q.z();
-    if (Dpose)
-      *Dpose = PinholeBase::Dpose(pn, d);
-    if (Dpoint)
-      *Dpoint = PinholeBase::Dpoint(pn, d, Rt);
+  // One fused evaluation: the disparity d and normalized coordinates u,v are
+  // shared between the projection and both Jacobians, instead of being
+  // re-derived by the separate Dpose/Dpoint helpers
+  const double d = 1.0 / q.z();
+  const double u = q.x() * d, v = q.y() * d;
+  if (Dpose) {
+    const double uv = u * v, uu = u * u, vv = v * v;
+    *Dpose << uv, -1 - uu, v, -d, 0, d * u, //
+    /**/1 + vv, -uv, -u, 0, -d, d * v;
   }
-  return pn;
+  if (Dpoint) {
+    *Dpoint << //
+        Rt(0, 0) - u * Rt(2, 0), Rt(0, 1) - u * Rt(2, 1), Rt(0, 2) - u * Rt(2, 2), //
+    /**/Rt(1, 0) - v * Rt(2, 0), Rt(1, 1) - v * Rt(2, 1), Rt(1, 2) - v * Rt(2, 2);
+    *Dpoint *= d;
+  }
+  return Point2(u, v);
 }
 
 /* ************************************************************************* */
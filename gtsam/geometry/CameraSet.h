@@ -119,12 +119,12 @@ public:
     if (E) E->resize(ZDim * m, N);
     if (Fs) Fs->resize(m);
 
-    // Project and fill derivatives
+    // Project and fill derivatives in place: each camera writes its F block
+    // directly into Fs, and a single fixed-size buffer is reused for the rows
+    // of E, whose blocks are not contiguous in the column-major matrix.
+    Eigen::Matrix<double, ZDim, N> Ei;
     for (size_t i = 0; i < m; i++) {
-      MatrixZD Fi;
-      Eigen::Matrix<double, ZDim, N> Ei;
-      z.emplace_back(this->at(i).project2(point, Fs ? &Fi : 0, E ? &Ei : 0));
-      if (Fs) (*Fs)[i] = Fi;
+      z.emplace_back(this->at(i).project2(point, Fs ? &(*Fs)[i] : 0, E ? &Ei : 0));
       if (E) E->block<ZDim, N>(ZDim * i, 0) = Ei;
     }
 
@@ -159,29 +159,41 @@ public:
     dims.back() = 1;
     SymmetricBlockMatrix augmentedHessian(dims, Matrix::Zero(M1, M1));
 
+    // Blocked rank-N update: precompute, per camera,
+    //   Bi = Fi' * Ei * P  (DxN)  and  Ci = Ei' * Fi  (NxD)
+    // so that every Hessian block below is a single fixed-size product
+    // -Bi * Cj, instead of a chain of products with ZDim-wide intermediates
+    // recomputed in the inner loop over camera pairs
+    typedef Eigen::Matrix<double, D, N> MatrixDN;
+    typedef Eigen::Matrix<double, N, D> MatrixND;
+    std::vector<MatrixDN, Eigen::aligned_allocator<MatrixDN> > Bs(m);
+    std::vector<MatrixND, Eigen::aligned_allocator<MatrixND> > Cs(m);
+    const Eigen::Matrix<double, N, 1> Eb = E.transpose() * b; // same for all i
+    for (size_t i = 0; i < m; i++) {
+      const Eigen::Matrix<double, ZDim, N> Ei = //
+          E.template block<ZDim, N>(ZDim * i, 0);
+      Cs[i].noalias() = Ei.transpose() * Fs[i];
+      Bs[i].noalias() = Fs[i].transpose() * (Ei * P);
+    }
+
     // Blockwise Schur complement
     for (size_t i = 0; i < m; i++) { // for each camera
 
       const MatrixZD& Fi = Fs[i];
       const auto FiT = Fi.transpose();
-      const Eigen::Matrix<double, ZDim, N> Ei_P = //
-          E.block(ZDim * i, 0, ZDim, N) * P;
 
-      // D = (Dx2) * ZDim
+      // D = (DxZDim) * ZDim
       augmentedHessian.setOffDiagonalBlock(i, m, FiT * b.segment<ZDim>(ZDim * i) // F' * b
-      - FiT * (Ei_P * (E.transpose() * b))); // D = (DxZDim) * (ZDimx3) * (N*ZDimm) * (ZDimm x 1)
+      - Bs[i] * Eb); // D = (DxN) * (Nx1)
 
-      // (DxD) = (DxZDim) * ( (ZDimxD) - (ZDimx3) * (3xZDim) * (ZDimxD) )
-      augmentedHessian.setDiagonalBlock(i, FiT
-          * (Fi - Ei_P * E.block(ZDim * i, 0, ZDim, N).transpose() * Fi));
+      // (DxD) = (DxZDim) * (ZDimxD) - (DxN) * (NxD)
+      augmentedHessian.setDiagonalBlock(i, FiT * Fi - Bs[i] * Cs[i]);
 
       // upper triangular part of the hessian
       for (size_t j = i + 1; j < m; j++) { // for each camera
-        const MatrixZD& Fj = Fs[j];
 
-        // (DxD) = (Dx2) * ( (2x2) * (2xD) )
-        augmentedHessian.setOffDiagonalBlock(i, j, -FiT
-            * (Ei_P * E.block(ZDim * j, 0, ZDim, N).transpose() * Fj));
+        // (DxD) = (DxN) * (NxD)
+        augmentedHessian.setOffDiagonalBlock(i, j, -Bs[i] * Cs[j]);
       }
     } // end of for over cameras
 
@@ -264,13 +276,24 @@ public:
     size_t M = (augmentedHessian.rows() - 1) / D; // all cameras in the group
     assert(allKeys.size()==M);
 
+    // Precompute the blocked rank-N update kernels, as in SchurComplement
+    typedef Eigen::Matrix<double, D, N> MatrixDN;
+    typedef Eigen::Matrix<double, N, D> MatrixND;
+    std::vector<MatrixDN, Eigen::aligned_allocator<MatrixDN> > Bs(m);
+    std::vector<MatrixND, Eigen::aligned_allocator<MatrixND> > Cs(m);
+    const Eigen::Matrix<double, N, 1> Eb = E.transpose() * b; // same for all i
+    for (size_t i = 0; i < m; i++) {
+      const Eigen::Matrix<double, ZDim, N> Ei = //
+          E.template block<ZDim, N>(ZDim * i, 0);
+      Cs[i].noalias() = Ei.transpose() * Fs[i];
+      Bs[i].noalias() = Fs[i].transpose() * (Ei * P);
+    }
+
     // Blockwise Schur complement
     for (size_t i = 0; i < m; i++) { // for each camera in the current factor
 
       const MatrixZD& Fi = Fs[i];
       const auto FiT = Fi.transpose();
-      const Eigen::Matrix<double, 2, N> Ei_P = E.template block<ZDim, N>(
-          ZDim * i, 0) * P;
 
       // D = (DxZDim) * (ZDim)
       // allKeys are the list of all camera keys in the group, e.g, (1,3,4,5,7)
@@ -282,27 +305,25 @@ public:
       // vectorBlock = augmentedHessian(aug_i, aug_m).knownOffDiagonal();
       // add contribution of current factor
       augmentedHessian.updateOffDiagonalBlock(aug_i, M,
-          FiT * b.segment<ZDim>(ZDim * i)      // F' * b
-        - FiT * (Ei_P * (E.transpose() * b))); // D = (DxZDim) * (ZDimx3) * (N*ZDimm) * (ZDimm x 1)
+          FiT * b.segment<ZDim>(ZDim * i) // F' * b
+        - Bs[i] * Eb);                    // D = (DxN) * (Nx1)
 
-      // (DxD) += (DxZDim) * ( (ZDimxD) - (ZDimx3) * (3xZDim) * (ZDimxD) )
+      // (DxD) += (DxZDim) * (ZDimxD) - (DxN) * (NxD)
       // add contribution of current factor
       // TODO(gareth): Eigen doesn't let us pass the expression. Call eval() for now...
       augmentedHessian.updateDiagonalBlock(aug_i,
-         ((FiT * (Fi - Ei_P * E.template block<ZDim, N>(ZDim * i, 0).transpose() * Fi))).eval());
+          (FiT * Fi - Bs[i] * Cs[i]).eval());
 
       // upper triangular part of the hessian
       for (size_t j = i + 1; j < m; j++) { // for each camera
-        const MatrixZD& Fj = Fs[j];
 
         DenseIndex aug_j = KeySlotMap.at(keys[j]);
 
-        // (DxD) = (DxZDim) * ( (ZDimxZDim) * (ZDimxD) )
+        // (DxD) = (DxN) * (NxD)
         // off diagonal block - store previous block
         // matrixBlock = augmentedHessian(aug_i, aug_j).knownOffDiagonal();
         // add contribution of current factor
-        augmentedHessian.updateOffDiagonalBlock(aug_i, aug_j,
-                -FiT * (Ei_P * E.template block<ZDim, N>(ZDim * j, 0).transpose() * Fj));
+        augmentedHessian.updateOffDiagonalBlock(aug_i, aug_j, -Bs[i] * Cs[j]);
       }
     } // end of for over cameras
 
@@ -97,19 +97,23 @@ public:
       OptionalJacobian<2, FixedDimension<POINT>::value> Dpoint,
       OptionalJacobian<2, DimK> Dcal) const {
 
-    // project to normalized coordinates
-    const Point2 pn = PinholeBase::project2(pw, Dpose, Dpoint);
-
-    // uncalibrate to pixel coordinates
+    // project to normalized coordinates, Jacobians into locals so the chain
+    // rule below writes straight into the caller's blocks without aliasing
+    Matrix26 Dpn_pose;
+    Eigen::Matrix<double, 2, FixedDimension<POINT>::value> Dpn_point;
+    const Point2 pn = PinholeBase::project2(pw, Dpose ? &Dpn_pose : 0,
+        Dpoint ? &Dpn_point : 0);
+
+    // uncalibrate to pixel coordinates, sharing pn between all Jacobians
     Matrix2 Dpi_pn;
     const Point2 pi = calibration().uncalibrate(pn, Dcal,
         Dpose || Dpoint ? &Dpi_pn : 0);
 
-    // If needed, apply chain rule
+    // apply chain rule only for the Jacobians that were requested
     if (Dpose)
-      *Dpose = Dpi_pn * *Dpose;
+      Dpose->noalias() = Dpi_pn * Dpn_pose;
     if (Dpoint)
-      *Dpoint = Dpi_pn * *Dpoint;
+      Dpoint->noalias() = Dpi_pn * Dpn_point;
 
     return pi;
   }
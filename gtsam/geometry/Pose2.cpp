@@ -22,6 +22,7 @@
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
 
 using namespace std;
 
@@ -196,6 +197,41 @@ Pose2 Pose2::inverse() const {
   return Pose2(r_.inverse(), r_.unrotate(Point2(-t_.x(), -t_.y())));
 }
 
+/* ************************************************************************* */
+Pose2 Pose2::compose(const Pose2& g, ChartJacobian H1,
+    ChartJacobian H2) const {
+  if (H1) {
+    // Adjoint of g.inverse(), written out in the stored cos/sin of g so that
+    // neither the inverse pose nor its adjoint matrix is materialized
+    const double c2 = g.r_.c(), s2 = g.r_.s(), x2 = g.t_.x(), y2 = g.t_.y();
+    *H1 << c2,   s2,  s2 * x2 - c2 * y2,
+          -s2,   c2,  c2 * x2 + s2 * y2,
+          0.0,  0.0,                1.0;
+  }
+  if (H2) *H2 = I_3x3;
+  return *this * g;
+}
+
+/* ************************************************************************* */
+Pose2 Pose2::between(const Pose2& g, ChartJacobian H1,
+    ChartJacobian H2) const {
+  // result = inverse() * g, computed in scalars shared with the Jacobian
+  const double c1 = r_.c(), s1 = r_.s();
+  const double dx = g.t_.x() - t_.x(), dy = g.t_.y() - t_.y();
+  const Rot2 dR = r_.inverse() * g.r_;
+  const double x = c1 * dx + s1 * dy;  // R1' * (t2 - t1)
+  const double y = -s1 * dx + c1 * dy;
+  if (H1) {
+    // -AdjointMap of the inverse result, in the result's own cos/sin
+    const double c = dR.c(), s = dR.s();
+    *H1 << -c,  -s,  c * y - s * x,
+            s,  -c, -c * x - s * y,
+          0.0, 0.0,           -1.0;
+  }
+  if (H2) *H2 = I_3x3;
+  return Pose2(dR, Point2(x, y));
+}
+
 /* ************************************************************************* */
 // see doc/math.lyx, SE(2) section
 Point2 Pose2::transformTo(const Point2& point,
@@ -335,5 +371,39 @@ boost::optional<Pose2> align(const vector<Point2Pair>& pairs) {
   return Pose2(R, t);
 }
 
+/* ************************************************************************* */
+std::vector<Pose2> compose(const std::vector<Pose2>& g1,
+    const std::vector<Pose2>& g2, std::vector<Matrix3>* H1) {
+  if (g1.size() != g2.size())
+    throw std::invalid_argument("compose: pose arrays differ in size");
+  std::vector<Pose2> result;
+  result.reserve(g1.size());
+  if (H1) H1->resize(g1.size());
+  for (size_t i = 0; i < g1.size(); ++i) {
+    if (H1)
+      result.push_back(g1[i].compose(g2[i], (*H1)[i]));
+    else
+      result.push_back(g1[i] * g2[i]);
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+std::vector<Pose2> between(const std::vector<Pose2>& g1,
+    const std::vector<Pose2>& g2, std::vector<Matrix3>* H1) {
+  if (g1.size() != g2.size())
+    throw std::invalid_argument("between: pose arrays differ in size");
+  std::vector<Pose2> result;
+  result.reserve(g1.size());
+  if (H1) H1->resize(g1.size());
+  for (size_t i = 0; i < g1.size(); ++i) {
+    if (H1)
+      result.push_back(g1[i].between(g2[i], (*H1)[i]));
+    else
+      result.push_back(g1[i].between(g2[i]));
+  }
+  return result;
+}
+
 /* ************************************************************************* */
 } // namespace gtsam
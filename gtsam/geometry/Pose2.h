@@ -189,6 +189,19 @@ public:
   };
 
   using LieGroup<Pose2, 3>::inverse; // version with derivative
+  using LieGroup<Pose2, 3>::compose; // version without derivatives
+  using LieGroup<Pose2, 3>::between; // version without derivatives
+
+  /** compose this with g, with fused scalar Jacobians: the rotation entries
+   * are read once from the stored cos/sin and the adjoint of the inverse is
+   * filled directly, without materializing intermediate poses or matrices */
+  GTSAM_EXPORT Pose2 compose(const Pose2& g, ChartJacobian H1,
+      ChartJacobian H2 = boost::none) const;
+
+  /** between this and g, i.e. \f$ this^{-1} g \f$, with fused scalar
+   * Jacobians sharing the intermediates of the result */
+  GTSAM_EXPORT Pose2 between(const Pose2& g, ChartJacobian H1,
+      ChartJacobian H2 = boost::none) const;
 
   /// @}
   /// @name Group Action on Point2
@@ -334,6 +347,24 @@ inline Matrix wedge<Pose2>(const Vector& xi) {
 typedef std::pair<Point2,Point2> Point2Pair;
 GTSAM_EXPORT boost::optional<Pose2> align(const std::vector<Point2Pair>& pairs);
 
+/**
+ * Compose corresponding pairs of poses, result[i] = g1[i] * g2[i], optionally
+ * filling the Jacobians w.r.t. g1[i] (the Jacobian w.r.t. g2[i] is always
+ * identity).  Batch version amortizing per-call overhead over dense 2D graphs.
+ * @throws std::invalid_argument if the arrays differ in size
+ */
+GTSAM_EXPORT std::vector<Pose2> compose(const std::vector<Pose2>& g1,
+    const std::vector<Pose2>& g2, std::vector<Matrix3>* H1 = nullptr);
+
+/**
+ * Relative poses for corresponding pairs, result[i] = g1[i].between(g2[i]),
+ * optionally filling the Jacobians w.r.t. g1[i] (the Jacobian w.r.t. g2[i] is
+ * always identity).
+ * @throws std::invalid_argument if the arrays differ in size
+ */
+GTSAM_EXPORT std::vector<Pose2> between(const std::vector<Pose2>& g1,
+    const std::vector<Pose2>& g2, std::vector<Matrix3>* H1 = nullptr);
+
 template <>
 struct traits<Pose2> : public internal::LieGroup<Pose2> {};
 
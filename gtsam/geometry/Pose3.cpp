@@ -159,6 +159,50 @@ Vector6 Pose3::Logmap(const Pose3& pose, OptionalJacobian<6, 6> Hpose) {
   }
 }
 
+/* ************************************************************************* */
+std::vector<Pose3> Pose3::ExpmapBatch(const Matrix& xis) {
+  if (xis.rows() != 6)
+    throw std::invalid_argument("Pose3::ExpmapBatch: expected a 6xN matrix of twists");
+  const DenseIndex n = xis.cols();
+
+  // Precompute the angle-dependent coefficients for the whole sweep; these
+  // array expressions vectorize across the batch.
+  const Eigen::ArrayXd theta2 = xis.topRows<3>().colwise().squaredNorm().transpose();
+  const Eigen::ArrayXd theta = theta2.sqrt();
+  const Eigen::ArrayXd sinTheta = theta.sin();
+  const Eigen::ArrayXd oneMinusCosTheta = 1.0 - theta.cos();
+
+  std::vector<Pose3> poses;
+  poses.reserve(n);
+  for (DenseIndex i = 0; i < n; ++i) {
+    const Vector3 omega = xis.block<3, 1>(0, i), v = xis.block<3, 1>(3, i);
+    const Matrix3 W = skewSymmetric(omega);
+    if (theta2(i) > std::numeric_limits<double>::epsilon()) {
+      // Rodrigues formula with the precomputed trigonometry
+      const Matrix3 R = I_3x3 + (sinTheta(i) / theta(i)) * W
+          + (oneMinusCosTheta(i) / theta2(i)) * W * W;
+      const Vector3 omega_cross_v = omega.cross(v);
+      const Vector3 t = (omega_cross_v - R * omega_cross_v
+          + omega * omega.dot(v)) / theta2(i);
+      poses.push_back(Pose3(Rot3(R), t));
+    } else {
+      // First-order expansion, as in the scalar Expmap near zero
+      poses.push_back(Pose3(Rot3(I_3x3 + W), v));
+    }
+  }
+  return poses;
+}
+
+/* ************************************************************************* */
+Matrix Pose3::LogmapBatch(const std::vector<Pose3>& poses) {
+  // Logmap branches per pose on the rotation trace, so there is little shared
+  // arithmetic to hoist; the benefit here is the contiguous 6xN output layout.
+  Matrix xis(6, poses.size());
+  for (size_t i = 0; i < poses.size(); ++i)
+    xis.col(i) = Logmap(poses[i]);
+  return xis;
+}
+
 /* ************************************************************************* */
 Pose3 Pose3::ChartAtOrigin::Retract(const Vector6& xi, ChartJacobian Hxi) {
 #ifdef GTSAM_POSE3_EXPMAP
@@ -122,6 +122,21 @@ public:
   /// Log map at identity - return the canonical coordinates \f$ [R_x,R_y,R_z,T_x,T_y,T_z] \f$ of this rotation
   static Vector6 Logmap(const Pose3& pose, OptionalJacobian<6, 6> Hpose = boost::none);
 
+  /**
+   * Apply Expmap to every column of a 6xN matrix of twists in one sweep.
+   * The struct-of-arrays layout lets Eigen vectorize the angle-dependent
+   * coefficients (norms, sin, cos) across the whole batch instead of
+   * evaluating scalar trigonometry pose by pose, which pays off when
+   * retracting thousands of poses per optimizer iteration.
+   */
+  static std::vector<Pose3> ExpmapBatch(const Matrix& xis);
+
+  /**
+   * Apply Logmap to a batch of poses, returning the twists as columns of a
+   * 6xN matrix.  The inverse of ExpmapBatch.
+   */
+  static Matrix LogmapBatch(const std::vector<Pose3>& poses);
+
   /**
    * Calculate Adjoint map, transforming a twist in the this pose's (i.e, body) frame to the world spatial frame
    * Ad_pose is 6*6 matrix that when applied to twist xi \f$ [R_x,R_y,R_z,T_x,T_y,T_z] \f$, returns Ad_pose(xi)
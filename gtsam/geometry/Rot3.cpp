@@ -220,6 +220,54 @@ pair<Matrix3, Vector3> RQ(const Matrix3& A) {
   return make_pair(R, xyz);
 }
 
+/* ************************************************************************* */
+Matrix xyzBatch(const std::vector<Rot3>& Rs) {
+  Matrix xyz(Rs.size(), 3);
+  for (size_t i = 0; i < Rs.size(); i++) {
+    // Closed form of RQ restricted to rotation matrices: the Givens sweep
+    // reduces to reading the angles off the RzRyRx(x,y,z) entries, with
+    // cos(y) recovered as the (always non-negative) norm of the last row
+    // minus its first entry, matching the branch RQ selects.
+    const Matrix3 A = Rs[i].matrix();
+    xyz(i, 0) = atan2(A(2, 1), A(2, 2));
+    xyz(i, 1) = atan2(-A(2, 0), sqrt(A(2, 1) * A(2, 1) + A(2, 2) * A(2, 2)));
+    xyz(i, 2) = atan2(A(1, 0), A(0, 0));
+  }
+  return xyz;
+}
+
+/* ************************************************************************* */
+Matrix yprBatch(const std::vector<Rot3>& Rs) {
+  return xyzBatch(Rs).rowwise().reverse();
+}
+
+/* ************************************************************************* */
+std::vector<Rot3> RzRyRxBatch(const Matrix& xyz) {
+  if (xyz.cols() != 3)
+    throw invalid_argument("RzRyRxBatch: argument must have 3 columns");
+  // Evaluate all trig column-wise so Eigen's packet math covers the arrays
+  const Eigen::ArrayXd cx = xyz.col(0).array().cos(), sx = xyz.col(0).array().sin();
+  const Eigen::ArrayXd cy = xyz.col(1).array().cos(), sy = xyz.col(1).array().sin();
+  const Eigen::ArrayXd cz = xyz.col(2).array().cos(), sz = xyz.col(2).array().sin();
+  std::vector<Rot3> Rs;
+  Rs.reserve(xyz.rows());
+  for (int i = 0; i < xyz.rows(); i++) {
+    // Same products as Rot3M::RzRyRx, with the trig amortized above
+    const double ss_ = sx(i) * sy(i), cs_ = cx(i) * sy(i);
+    const double sc_ = sx(i) * cy(i), cc_ = cx(i) * cy(i);
+    const double c_s = cx(i) * sz(i), s_s = sx(i) * sz(i);
+    const double _cs = cy(i) * sz(i), c_c = cx(i) * cz(i);
+    const double s_c = sx(i) * cz(i), _cc = cy(i) * cz(i);
+    const double sss = ss_ * sz(i), csc = cs_ * cz(i);
+    const double ssc = ss_ * cz(i), css = cs_ * sz(i);
+    Rs.push_back(Rot3(
+        _cc, ssc - c_s, csc + s_s,
+        _cs, sss + c_c, css - s_c,
+        -sy(i), sc_, cc_));
+  }
+  return Rs;
+}
+
 /* ************************************************************************* */
 ostream &operator<<(ostream &os, const Rot3& R) {
   os << "\n";
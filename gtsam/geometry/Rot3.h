@@ -560,6 +560,32 @@ namespace gtsam {
    */
   GTSAM_EXPORT std::pair<Matrix3,Vector3> RQ(const Matrix3& A);
 
+  /**
+   * Batch version of Rot3::xyz, row i of the result is Rs[i].xyz().
+   * Extracts the angles in closed form from the rotation matrix entries
+   * instead of running the general RQ decomposition per element, so only
+   * three atan2 calls and no intermediate 3*3 products remain per rotation.
+   * Intended for trajectory export and telemetry, where thousands of poses
+   * are converted at once.
+   * @return an Rs.size() by 3 matrix of [thetax, thetay, thetaz] rows
+   */
+  GTSAM_EXPORT Matrix xyzBatch(const std::vector<Rot3>& Rs);
+
+  /**
+   * Batch version of Rot3::ypr, row i of the result is Rs[i].ypr().
+   * @return an Rs.size() by 3 matrix of [yaw, pitch, roll] rows
+   */
+  GTSAM_EXPORT Matrix yprBatch(const std::vector<Rot3>& Rs);
+
+  /**
+   * Batch version of Rot3::RzRyRx, result[i] = Rot3::RzRyRx(xyz.row(i)).
+   * The six trigonometric evaluations per rotation are done column-wise
+   * over the whole input so Eigen can vectorize them.
+   * @param xyz an N by 3 matrix of [thetax, thetay, thetaz] rows
+   * @throws std::invalid_argument if xyz does not have 3 columns
+   */
+  GTSAM_EXPORT std::vector<Rot3> RzRyRxBatch(const Matrix& xyz);
+
   template<>
   struct traits<Rot3> : public internal::LieGroup<Rot3> {};
 
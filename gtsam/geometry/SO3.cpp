@@ -203,6 +203,16 @@ SO3 SO3::Expmap(const Vector3& omega, ChartJacobian H) {
     *H = impl.dexp();
     return impl.expmap();
   } else {
+    // Small-angle fast path: below this tolerance the second-order expansion
+    // I + W + W^2/2 matches the exact exponential to double precision (the
+    // truncation error theta^3/6 is below 1e-17), so the trigonometry in
+    // ExpmapFunctor can be skipped.  Late optimizer iterations retract almost
+    // exclusively such tiny rotation deltas.
+    const double theta2 = omega.dot(omega);
+    if (theta2 < 1e-11) {
+      const Matrix3 W = skewSymmetric(omega);
+      return SO3(I_3x3 + W + 0.5 * W * W);
+    }
     return so3::ExpmapFunctor(omega).expmap();
   }
 }
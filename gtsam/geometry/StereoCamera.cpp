@@ -58,19 +58,25 @@ namespace gtsam {
 
     // check if derivatives need to be computed
     if (H1 || H2) {
-      // optimized version, see StereoCamera.nb
+      // optimized version, see StereoCamera.nb.  The left and right rows
+      // differ only through the fixed baseline, uL - uR = d*fx*b, so the
+      // right row is the left row plus a rank-one baseline correction.
+      const double dbf = dfx * b; // uL - uR
       if (H1) {
         const double v1 = v/fy, v2 = fx*v1, dx=d*x;
-        *H1  << uL*v1, -fx-dx*uL,     v2, -dfx,  0.0, d*uL,
-                uR*v1, -fx-dx*uR,     v2, -dfx,  0.0, d*uR,
-                fy + v*v1,    -dx*v , -x*dfy,  0.0, -dfy, d*v;
+        H1->row(0) << uL*v1, -fx-dx*uL,     v2, -dfx,  0.0, d*uL;
+        H1->row(2) << fy + v*v1,    -dx*v , -x*dfy,  0.0, -dfy, d*v;
+        Eigen::Matrix<double, 1, 6> dLeft; // derivative of row 0 in uL
+        dLeft << v1, -dx, 0.0, 0.0, 0.0, d;
+        H1->row(1) = H1->row(0) - dbf * dLeft;
       }
       if (H2) {
         const Matrix3 R(leftCamPose_.rotation().matrix());
-        *H2  << fx*R(0, 0) - R(0, 2)*uL, fx*R(1, 0) - R(1, 2)*uL, fx*R(2, 0) - R(2, 2)*uL,
-                fx*R(0, 0) - R(0, 2)*uR, fx*R(1, 0) - R(1, 2)*uR, fx*R(2, 0) - R(2, 2)*uR,
-                fy*R(0, 1) - R(0, 2)*v , fy*R(1, 1) - R(1, 2)*v , fy*R(2, 1) - R(2, 2)*v;
-        *H2 << d * (*H2);
+        H2->row(0) << dfx*R(0, 0) - d*R(0, 2)*uL, dfx*R(1, 0) - d*R(1, 2)*uL,
+            dfx*R(2, 0) - d*R(2, 2)*uL;
+        H2->row(2) << dfy*R(0, 1) - d*R(0, 2)*v , dfy*R(1, 1) - d*R(1, 2)*v ,
+            dfy*R(2, 1) - d*R(2, 2)*v;
+        H2->row(1) = H2->row(0) + (d * dbf) * R.col(2).transpose();
       }
     }
 
@@ -74,15 +74,27 @@ static Point3 CalculateBestAxis(const Point3& n) {
 
 /* ************************************************************************* */
 const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
+  // Lock-free fast path: once the needed caches are published, return them
+  // without touching the mutex.  The acquire loads pair with the release
+  // stores below, and the caches are never invalidated, so a true flag means
+  // the corresponding matrix is complete.
+  if (B_cached_.load(std::memory_order_acquire)
+      && (!H || H_B_cached_.load(std::memory_order_acquire))) {
+    if (H) *H = H_B_;
+    return B_;
+  }
+
 #ifdef GTSAM_USE_TBB
+  // Serialize cache misses so that only one thread computes the basis.
   // NOTE(hayk): At some point it seemed like this reproducably resulted in
   // deadlock. However, I don't know why and I can no longer reproduce it.
   // It either was a red herring or there is still a latent bug left to debug.
   std::unique_lock<std::mutex> lock(B_mutex_);
 #endif
 
-  const bool cachedBasis = static_cast<bool>(B_);
-  const bool cachedJacobian = static_cast<bool>(H_B_);
+  // Re-check under the lock: another thread may have filled the caches
+  const bool cachedBasis = B_cached_.load(std::memory_order_acquire);
+  const bool cachedJacobian = H_B_cached_.load(std::memory_order_acquire);
 
   if (H) {
     if (!cachedJacobian) {
@@ -108,16 +120,19 @@ const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
       auto H_b1_p = jacobian.block<3, 2>(0, 0);
       jacobian.block<3, 2>(3, 0) = H_b2_n * H_n_p + H_b2_b1 * H_b1_p;
 
-      // Cache the result and jacobian
-      H_B_.reset(jacobian);
-      B_.reset(B);
+      // Cache the result and jacobian, publishing with release semantics so
+      // the lock-free fast path sees complete matrices
+      H_B_ = jacobian;
+      B_ = B;
+      B_cached_.store(true, std::memory_order_release);
+      H_B_cached_.store(true, std::memory_order_release);
     }
 
     // Return cached jacobian, possibly computed just above
-    *H = *H_B_;
+    *H = H_B_;
   }
 
-  if (!cachedBasis) {
+  if (!cachedBasis && !B_cached_.load(std::memory_order_acquire)) {
     // Same calculation as above, without derivatives.
     // Done after H block, as that possibly computes B_ for the first time
     Matrix32 B;
@@ -126,10 +141,17 @@ const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
     const Point3 B1 = gtsam::cross(n, axis);
     B.col(0) = normalize(B1);
     B.col(1) = gtsam::cross(n, B.col(0));
-    B_.reset(B);
+    B_ = B;
+    B_cached_.store(true, std::memory_order_release);
   }
 
-  return *B_;
+  return B_;
+}
+
+/* ************************************************************************* */
+void Unit3::precomputeBasis() const {
+  Matrix62 H_B;
+  basis(H_B);  // fills both caches
 }
 
 /* ************************************************************************* */
@@ -29,6 +29,7 @@
 #include <boost/optional.hpp>
 #include <boost/serialization/nvp.hpp>
 
+#include <atomic>
 #include <random>
 #include <string>
 
@@ -44,11 +45,17 @@ class Unit3 {
 private:
 
   Vector3 p_; ///< The location of the point on the unit sphere
-  mutable boost::optional<Matrix32> B_; ///< Cached basis
-  mutable boost::optional<Matrix62> H_B_; ///< Cached basis derivative
+  mutable Matrix32 B_; ///< Cached basis
+  mutable Matrix62 H_B_; ///< Cached basis derivative
+  /// Publication flags for the caches: set with release semantics after the
+  /// matrices are written, read with acquire semantics in the lock-free fast
+  /// path of basis().  The direction never changes, so the caches are never
+  /// invalidated.
+  mutable std::atomic<bool> B_cached_;
+  mutable std::atomic<bool> H_B_cached_;
 
 #ifdef GTSAM_USE_TBB
-  mutable std::mutex B_mutex_; ///< Mutex to protect the cached basis.
+  mutable std::mutex B_mutex_; ///< Mutex serializing cache *misses* in basis().
 #endif
 
 public:
@@ -62,36 +69,43 @@ public:
 
   /// Default constructor
   Unit3() :
-      p_(1.0, 0.0, 0.0) {
+      p_(1.0, 0.0, 0.0), B_cached_(false), H_B_cached_(false) {
   }
 
   /// Construct from point
   explicit Unit3(const Vector3& p) :
-      p_(p.normalized()) {
+      p_(p.normalized()), B_cached_(false), H_B_cached_(false) {
   }
 
   /// Construct from x,y,z
   Unit3(double x, double y, double z) :
-      p_(x, y, z) {
+      p_(x, y, z), B_cached_(false), H_B_cached_(false) {
     p_.normalize();
   }
 
   /// Construct from 2D point in plane at focal length f
   /// Unit3(p,1) can be viewed as normalized homogeneous coordinates of 2D point
-  explicit Unit3(const Point2& p, double f) : p_(p.x(), p.y(), f) {
+  explicit Unit3(const Point2& p, double f)
+      : p_(p.x(), p.y(), f), B_cached_(false), H_B_cached_(false) {
     p_.normalize();
   }
 
   /// Copy constructor
-  Unit3(const Unit3& u) {
+  Unit3(const Unit3& u) : B_cached_(false), H_B_cached_(false) {
     p_ = u.p_;
   }
 
-  /// Copy assignment
+  /// Copy assignment, copies the cached basis along with the direction
   Unit3& operator=(const Unit3 & u) {
     p_ = u.p_;
-    B_ = u.B_;
-    H_B_ = u.H_B_;
+    // Copy each cache only if the source has filled it - the raw matrices
+    // stay uninitialized until then, so reading them would be undefined
+    const bool B_cached = u.B_cached_.load(std::memory_order_acquire);
+    if (B_cached) B_ = u.B_;
+    B_cached_.store(B_cached, std::memory_order_release);
+    const bool H_B_cached = u.H_B_cached_.load(std::memory_order_acquire);
+    if (H_B_cached) H_B_ = u.H_B_;
+    H_B_cached_.store(H_B_cached, std::memory_order_release);
     return *this;
   }
 
@@ -131,9 +145,22 @@ public:
    * It is a 3*2 matrix [b1 b2] composed of two orthogonal directions
    * tangent to the sphere at the current direction.
    * Provides derivatives of the basis with the two basis vectors stacked up as a 6x1.
+   *
+   * The basis and its derivative are cached after the first call; cache hits
+   * are lock-free, so concurrent linearization of many factors sharing the
+   * same directions does not contend once the caches are warm.  Call
+   * precomputeBasis() to warm them eagerly.
    */
   GTSAM_EXPORT const Matrix32& basis(OptionalJacobian<6, 2> H = boost::none) const;
 
+  /**
+   * Eagerly compute and cache the tangent basis and its derivative, so that
+   * every later basis() call - e.g. from factors linearized in parallel -
+   * takes the lock-free fast path.  Typically called once per direction when
+   * a direction-rich graph is assembled.
+   */
+  GTSAM_EXPORT void precomputeBasis() const;
+
   /// Return skew-symmetric associated with 3D point on unit sphere
   GTSAM_EXPORT Matrix3 skew() const;
 
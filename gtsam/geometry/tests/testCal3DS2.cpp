@@ -19,6 +19,7 @@
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/numericalDerivative.h>
 #include <gtsam/geometry/Cal3DS2.h>
+#include <gtsam/geometry/CalibrationLookup.h>
 
 using namespace gtsam;
 
@@ -51,6 +52,38 @@ TEST( Cal3DS2, calibrate )
   CHECK( traits<Point2>::Equals(pn, pn_hat, 1e-5));
 }
 
+TEST( Cal3DS2, uncalibrateBatch )
+{
+  Point2Vector pns;
+  pns.push_back(Point2(0.1, 0.2));
+  pns.push_back(Point2(-0.3, 0.15));
+  pns.push_back(Point2(0.0, 0.0));
+  Point2Vector pis = K.uncalibrate(pns);
+  LONGS_EQUAL(3, pis.size());
+  for (size_t i = 0; i < pns.size(); ++i)
+    CHECK(traits<Point2>::Equals(K.uncalibrate(pns[i]), pis[i], 1e-9));
+  CHECK(K.uncalibrate(Point2Vector()).empty());
+}
+
+TEST( Cal3DS2, calibrateLookup )
+{
+  // A grid over a small pixel window around the principal point
+  const Point2 pixelMin(250, 180), pixelMax(400, 300);
+  CalibrationLookup<Cal3DS2> lookup(K, pixelMin, pixelMax, 60, 75);
+
+  // Interpolated inverse tracks the exact iterative calibrate
+  Point2 pn(0.05, 0.04);
+  Point2 pi = K.uncalibrate(pn);
+  CHECK(traits<Point2>::Equals(K.calibrate(pi), lookup.calibrate(pi), 1e-5));
+
+  // Queries outside the sampled rectangle and degenerate grids are rejected
+  CHECK_EXCEPTION(lookup.calibrate(Point2(0, 0)), std::invalid_argument);
+  CHECK_EXCEPTION(CalibrationLookup<Cal3DS2>(K, pixelMin, pixelMax, 1, 75),
+      std::invalid_argument);
+  CHECK_EXCEPTION(CalibrationLookup<Cal3DS2>(K, pixelMax, pixelMin, 60, 75),
+      std::invalid_argument);
+}
+
 Point2 uncalibrate_(const Cal3DS2& k, const Point2& pt) { return k.uncalibrate(pt); }
 
 /* ************************************************************************* */
@@ -396,6 +396,37 @@ TEST(Pose2, compose_c)
   EXPECT(assert_equal(pose_expected, pose_actual_fcn));
 }
 
+/* ************************************************************************* */
+TEST(Pose2, batchComposeBetween)
+{
+  std::vector<Pose2> g1, g2;
+  g1.push_back(Pose2(M_PI/4.0, Point2(sqrt(0.5), sqrt(0.5))));
+  g1.push_back(Pose2(1.0, 2.0, M_PI/2.0));
+  g1.push_back(Pose2(0.2, -0.3, 0.1));
+  g2.push_back(Pose2(M_PI/2.0, Point2(0.0, 2.0)));
+  g2.push_back(Pose2(-1.0, 0.5, 0.3));
+  g2.push_back(Pose2(0.0, 0.0, -0.7));
+
+  // Batch results match the per-pair member functions, Jacobians included
+  std::vector<Matrix3> Hcompose, Hbetween;
+  std::vector<Pose2> composed = compose(g1, g2, &Hcompose);
+  std::vector<Pose2> relative = between(g1, g2, &Hbetween);
+  LONGS_EQUAL(3, composed.size());
+  LONGS_EQUAL(3, relative.size());
+  for (size_t i = 0; i < g1.size(); ++i) {
+    Matrix3 expectedHc, expectedHb;
+    EXPECT(assert_equal(g1[i].compose(g2[i], expectedHc), composed[i]));
+    EXPECT(assert_equal(Matrix(expectedHc), Matrix(Hcompose[i])));
+    EXPECT(assert_equal(g1[i].between(g2[i], expectedHb), relative[i]));
+    EXPECT(assert_equal(Matrix(expectedHb), Matrix(Hbetween[i])));
+  }
+
+  // Mismatched array sizes are rejected
+  g2.pop_back();
+  CHECK_EXCEPTION(compose(g1, g2), std::invalid_argument);
+  CHECK_EXCEPTION(between(g1, g2), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST(Pose2, inverse )
 {
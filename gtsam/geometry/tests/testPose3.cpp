@@ -205,6 +205,26 @@ TEST(Pose3, expmaps_galore_full)
   EXPECT(assert_equal(xi, Pose3::Logmap(actual),1e-9));
 }
 
+/* ************************************************************************* */
+TEST(Pose3, expmapBatch)
+{
+  // Columns cover the generic case, a near-zero twist, and a large rotation
+  Matrix xis(6, 4);
+  xis.col(0) << 0.1, 0.2, 0.3, 0.4, 0.5, 0.6;
+  xis.col(1) << 0, 0, 0, 0, 0, 0;
+  xis.col(2) << 1e-12, -1e-12, 1e-12, 0.1, -0.2, 0.3;
+  xis.col(3) << 2.0, -1.5, 0.8, 100.0, 120.0, -60.0;
+
+  std::vector<Pose3> actual = Pose3::ExpmapBatch(xis);
+  LONGS_EQUAL(4, actual.size());
+  for (size_t i = 0; i < actual.size(); ++i)
+    EXPECT(assert_equal(Pose3::Expmap(xis.col(i)), actual[i], 1e-9));
+
+  // LogmapBatch inverts ExpmapBatch
+  Matrix logs = Pose3::LogmapBatch(actual);
+  EXPECT(assert_equal(xis, logs, 1e-9));
+}
+
 /* ************************************************************************* */
 // Check translation and its pushforward
 TEST(Pose3, translation) {
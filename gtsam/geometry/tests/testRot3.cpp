@@ -521,6 +521,36 @@ TEST( Rot3, RQ)
   CHECK(assert_equal(expected,actual,1e-6));
 }
 
+/* ************************************************************************* */
+TEST( Rot3, BatchConversions )
+{
+  // Mix generic rotations with ones near the gimbal-lock pitch
+  std::vector<Rot3> Rs;
+  Rs.push_back(R);
+  Rs.push_back(Rot3::RzRyRx(0.1, 0.2, 0.3));
+  Rs.push_back(Rot3::RzRyRx(-2.5, 1.5, 3.0));
+  Rs.push_back(Rot3::Pitch(M_PI_2 - 1e-9));
+  Rs.push_back(Rot3::Ypr(0.3, -0.2, 0.1));
+
+  // Batch xyz/ypr must match the per-element RQ-based conversions
+  Matrix xyz = xyzBatch(Rs);
+  Matrix ypr = yprBatch(Rs);
+  EXPECT_LONGS_EQUAL(5, xyz.rows());
+  for (size_t i = 0; i < Rs.size(); i++) {
+    EXPECT(assert_equal((Vector)Rs[i].xyz(), (Vector)xyz.row(i).transpose(), 1e-9));
+    EXPECT(assert_equal((Vector)Rs[i].ypr(), (Vector)ypr.row(i).transpose(), 1e-9));
+  }
+
+  // Batch RzRyRx must round-trip the extracted angles
+  std::vector<Rot3> actual = RzRyRxBatch(xyz);
+  EXPECT_LONGS_EQUAL(5, actual.size());
+  for (size_t i = 0; i < Rs.size(); i++)
+    EXPECT(assert_equal(Rs[i], actual[i], 1e-9));
+
+  // Wrong number of columns is rejected
+  CHECK_EXCEPTION(RzRyRxBatch(Matrix::Zero(2, 4)), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST( Rot3, expmapStability ) {
   Vector w = Vector3(78e-9, 5e-8, 97e-7);
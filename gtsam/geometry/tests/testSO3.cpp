@@ -181,6 +181,24 @@ TEST(SO3, ExpmapFunctor) {
   CHECK(assert_equal(expected, actual4.matrix(), 1e-5));
 }
 
+/* ************************************************************************* */
+TEST(SO3, ExpmapSmallAngle) {
+  // The small-angle fast path in Expmap must agree with the full functor to
+  // machine precision and still return a proper rotation
+  const Vector3 tiny(1e-6, -2e-6, 3e-7);
+  const SO3 actual = SO3::Expmap(tiny);
+  const SO3 expected = so3::ExpmapFunctor(tiny).expmap();
+  CHECK(assert_equal(expected.matrix(), actual.matrix(), 1e-15));
+  CHECK(assert_equal(Matrix3(I_3x3),
+      Matrix3(actual.matrix().transpose() * actual.matrix()), 1e-15));
+  CHECK(assert_equal(Vector3(tiny), Vector3(SO3::Logmap(actual)), 1e-15));
+
+  // Just above the tolerance the regular path is taken; check continuity
+  const Vector3 small = Vector3(1., 2., -1.).normalized() * 1e-5;
+  CHECK(assert_equal(so3::ExpmapFunctor(small).expmap().matrix(),
+      SO3::Expmap(small).matrix(), 1e-15));
+}
+
 /* ************************************************************************* */
 namespace exmap_derivative {
 static const Vector3 w(0.1, 0.27, -0.2);
@@ -299,6 +299,40 @@ TEST( triangulation, outliersAndFarLandmarks) {
   EXPECT(actual.outlier());
 }
 
+//******************************************************************************
+// Batch version: many landmarks, same two cameras
+TEST( triangulation, safeBatch) {
+
+  CameraSet<PinholeCamera<Cal3_S2> > cameras;
+  cameras += camera1, camera2;
+
+  // two landmarks within the distance threshold, one beyond it
+  Point3 landmark2(6, -1.5, 0.9), farLandmark(20, 0.5, 1.2);
+
+  Point2Vector m1, m2, m3;
+  m1 += z1, z2;
+  m2 += camera1.project(landmark2), camera2.project(landmark2);
+  m3 += camera1.project(farLandmark), camera2.project(farLandmark);
+
+  vector<Point2Vector> measurementSets;
+  measurementSets += m1, m2, m3;
+
+  double landmarkDistanceThreshold = 10;
+  TriangulationParameters params(1.0, false, landmarkDistanceThreshold);
+  vector<TriangulationResult> results = //
+      triangulateSafeBatch(cameras, measurementSets, params);
+  LONGS_EQUAL(3, results.size());
+
+  CHECK(results[0].valid());
+  EXPECT(assert_equal(landmark, *results[0], 1e-7));
+  CHECK(results[1].valid());
+  EXPECT(assert_equal(landmark2, *results[1], 1e-7));
+  EXPECT(results[2].farPoint());
+
+  // batch results agree with triangulateSafe, one landmark at a time
+  EXPECT(assert_equal(*triangulateSafe(cameras, m2, params), *results[1], 1e-9));
+}
+
 //******************************************************************************
 TEST( triangulation, twoIdenticalPoses) {
   // create first camera. Looking along X-axis, 1 meter above ground plane (x-y)
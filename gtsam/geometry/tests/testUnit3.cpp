@@ -208,6 +208,18 @@ TEST(Unit3, error2) {
   }
 }
 
+//*******************************************************************************
+TEST(Unit3, precomputeBasis) {
+  // The eagerly warmed cache must return exactly what the lazy path computes
+  Unit3 lazy(0.1, -0.2, 0.9), eager(0.1, -0.2, 0.9);
+  eager.precomputeBasis();  // later basis() calls take the lock-free fast path
+  Matrix62 expectedH, actualH;
+  const Matrix32 expectedB = lazy.basis(expectedH);
+  const Matrix32 actualB = eager.basis(actualH);
+  EXPECT(assert_equal(Matrix(expectedB), Matrix(actualB)));
+  EXPECT(assert_equal(Matrix(expectedH), Matrix(actualH)));
+}
+
 //*******************************************************************************
 TEST(Unit3, distance) {
   Unit3 p(1, 0, 0), q = p.retract(Vector2(0.5, 0)), //
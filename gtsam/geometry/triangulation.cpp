@@ -27,11 +27,21 @@ Vector4 triangulateHomogeneousDLT(
     const std::vector<Matrix34, Eigen::aligned_allocator<Matrix34>>& projection_matrices,
     const Point2Vector& measurements, double rank_tol) {
 
+  // Allocate DLT matrix
+  Matrix A = Matrix::Zero(projection_matrices.size() * 2, 4);
+
+  return triangulateHomogeneousDLT(projection_matrices, measurements, rank_tol, A);
+}
+
+Vector4 triangulateHomogeneousDLT(
+    const std::vector<Matrix34, Eigen::aligned_allocator<Matrix34>>& projection_matrices,
+    const Point2Vector& measurements, double rank_tol, Matrix& A) {
+
   // number of cameras
   size_t m = projection_matrices.size();
 
-  // Allocate DLT matrix
-  Matrix A = Matrix::Zero(m * 2, 4);
+  // Size the DLT workspace, a no-op if the caller already sized it for m cameras
+  A.resize(m * 2, 4);
 
   for (size_t i = 0; i < m; i++) {
     size_t row = i * 2;
@@ -62,6 +72,39 @@ Point3 triangulateDLT(const std::vector<Matrix34, Eigen::aligned_allocator<Matri
   return Point3(v.head<3>() / v[3]);
 }
 
+Point3 triangulateDLT(const std::vector<Matrix34, Eigen::aligned_allocator<Matrix34>>& projection_matrices,
+    const Point2Vector& measurements, double rank_tol, Matrix& A) {
+
+  Vector4 v = triangulateHomogeneousDLT(projection_matrices, measurements, rank_tol, A);
+
+  // Create 3D point from homogeneous coordinates
+  return Point3(v.head<3>() / v[3]);
+}
+
+void triangulationNormalEquationsAppend(Matrix4& ATA,
+    const Matrix34& projection, const Point2& p) {
+  const Vector4 row1 = (p.x() * projection.row(2) - projection.row(0)).transpose();
+  const Vector4 row2 = (p.y() * projection.row(2) - projection.row(1)).transpose();
+  ATA += row1 * row1.transpose() + row2 * row2.transpose();
+}
+
+Vector4 triangulateHomogeneousFromNormalEquations(const Matrix4& ATA,
+    double rank_tol) {
+  // The eigenvalues of A'A are the squared singular values of A, so the
+  // rank check mirrors the SVD-based DLT
+  Eigen::SelfAdjointEigenSolver<Matrix4> eig(ATA);
+  int rank = 0;
+  for (int i = 0; i < 4; i++)
+    if (std::sqrt(std::max(eig.eigenvalues()[i], 0.0)) > rank_tol)
+      rank++;
+
+  if (rank < 3)
+    throw(TriangulationUnderconstrainedException());
+
+  // eigenvalues are sorted in increasing order
+  return eig.eigenvectors().col(0);
+}
+
 ///
 /**
  * Optimize for triangulation
@@ -25,6 +25,11 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/inference/Symbol.h>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 namespace gtsam {
 
 /// Exception thrown by triangulateDLT when SVD returns rank < 3
@@ -55,6 +60,19 @@ GTSAM_EXPORT Vector4 triangulateHomogeneousDLT(
     const std::vector<Matrix34, Eigen::aligned_allocator<Matrix34>>& projection_matrices,
     const Point2Vector& measurements, double rank_tol = 1e-9);
 
+/**
+ * DLT triangulation with a caller-supplied workspace, for triangulating many
+ * landmarks without allocating a fresh DLT matrix per call
+ * @param projection_matrices Projection matrices (K*P^-1)
+ * @param measurements 2D measurements
+ * @param rank_tol SVD rank tolerance
+ * @param A workspace for the 2m*4 DLT matrix, resized if needed
+ * @return Triangulated point, in homogeneous coordinates
+ */
+GTSAM_EXPORT Vector4 triangulateHomogeneousDLT(
+    const std::vector<Matrix34, Eigen::aligned_allocator<Matrix34>>& projection_matrices,
+    const Point2Vector& measurements, double rank_tol, Matrix& A);
+
 /**
  * DLT triangulation: See Hartley and Zisserman, 2nd Ed., page 312
  * @param projection_matrices Projection matrices (K*P^-1)
@@ -67,6 +85,45 @@ GTSAM_EXPORT Point3 triangulateDLT(
     const Point2Vector& measurements,
     double rank_tol = 1e-9);
 
+/**
+ * DLT triangulation with a caller-supplied workspace, see the corresponding
+ * triangulateHomogeneousDLT overload
+ * @param projection_matrices Projection matrices (K*P^-1)
+ * @param measurements 2D measurements
+ * @param rank_tol SVD rank tolerance
+ * @param A workspace for the 2m*4 DLT matrix, resized if needed
+ * @return Triangulated Point3
+ */
+GTSAM_EXPORT Point3 triangulateDLT(
+    const std::vector<Matrix34, Eigen::aligned_allocator<Matrix34>>& projection_matrices,
+    const Point2Vector& measurements,
+    double rank_tol, Matrix& A);
+
+/**
+ * Fold one measurement into the 4x4 normal equations A'A of the DLT system,
+ * a pair of rank-one updates.  Together with
+ * triangulateHomogeneousFromNormalEquations this allows appending
+ * observations of a landmark without rebuilding the DLT from scratch.
+ * @param ATA normal equations, start from a zero matrix
+ * @param projection Projection matrix (K*P^-1) of the new camera
+ * @param p 2D measurement in the new camera
+ */
+GTSAM_EXPORT void triangulationNormalEquationsAppend(Matrix4& ATA,
+    const Matrix34& projection, const Point2& p);
+
+/**
+ * Solve the DLT system from its accumulated 4x4 normal equations: the
+ * homogeneous point is the eigenvector of the smallest eigenvalue.
+ * Equivalent to triangulateHomogeneousDLT, at constant cost in the number
+ * of cameras.
+ * @param ATA normal equations built with triangulationNormalEquationsAppend
+ * @param rank_tol SVD rank tolerance, compared against the square roots of
+ *        the eigenvalues
+ * @return Triangulated point, in homogeneous coordinates
+ */
+GTSAM_EXPORT Vector4 triangulateHomogeneousFromNormalEquations(
+    const Matrix4& ATA, double rank_tol);
+
 /**
  * Create a factor graph with projection factors from poses and one calibration
  * @param poses Camera poses
@@ -456,6 +513,46 @@ private:
   }
 };
 
+/// Apply the quality checks of triangulateSafe to an already triangulated
+/// point, without re-triangulating
+template<class CAMERA>
+TriangulationResult checkTriangulatedPoint(const CameraSet<CAMERA>& cameras,
+    const typename CAMERA::MeasurementVector& measured,
+    const TriangulationParameters& params, const Point3& point) {
+
+  // Check landmark distance and re-projection errors to avoid outliers
+  size_t i = 0;
+  double maxReprojError = 0.0;
+  for(const CAMERA& camera: cameras) {
+    const Pose3& pose = camera.pose();
+    if (params.landmarkDistanceThreshold > 0
+        && distance3(pose.translation(), point)
+            > params.landmarkDistanceThreshold)
+      return TriangulationResult::FarPoint();
+#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
+    // verify that the triangulated point lies in front of all cameras
+    // Only needed if this was not yet handled by exception
+    const Point3& p_local = pose.transformTo(point);
+    if (p_local.z() <= 0)
+      return TriangulationResult::BehindCamera();
+#endif
+    // Check reprojection error
+    if (params.dynamicOutlierRejectionThreshold > 0) {
+      const Point2& zi = measured.at(i);
+      Point2 reprojectionError(camera.project(point) - zi);
+      maxReprojError = std::max(maxReprojError, reprojectionError.norm());
+    }
+    i += 1;
+  }
+  // Flag as degenerate if average reprojection error is too large
+  if (params.dynamicOutlierRejectionThreshold > 0
+      && maxReprojError > params.dynamicOutlierRejectionThreshold)
+    return TriangulationResult::Outlier();
+
+  // all good!
+  return TriangulationResult(point);
+}
+
 /// triangulateSafe: extensive checking of the outcome
 template<class CAMERA>
 TriangulationResult triangulateSafe(const CameraSet<CAMERA>& cameras,
@@ -472,38 +569,7 @@ TriangulationResult triangulateSafe(const CameraSet<CAMERA>& cameras,
     try {
       Point3 point = triangulatePoint3<CAMERA>(cameras, measured,
           params.rankTolerance, params.enableEPI);
-
-      // Check landmark distance and re-projection errors to avoid outliers
-      size_t i = 0;
-      double maxReprojError = 0.0;
-      for(const CAMERA& camera: cameras) {
-        const Pose3& pose = camera.pose();
-        if (params.landmarkDistanceThreshold > 0
-            && distance3(pose.translation(), point)
-                > params.landmarkDistanceThreshold)
-          return TriangulationResult::FarPoint();
-#ifdef GTSAM_THROW_CHEIRALITY_EXCEPTION
-        // verify that the triangulated point lies in front of all cameras
-        // Only needed if this was not yet handled by exception
-        const Point3& p_local = pose.transformTo(point);
-        if (p_local.z() <= 0)
-          return TriangulationResult::BehindCamera();
-#endif
-        // Check reprojection error
-        if (params.dynamicOutlierRejectionThreshold > 0) {
-          const Point2& zi = measured.at(i);
-          Point2 reprojectionError(camera.project(point) - zi);
-          maxReprojError = std::max(maxReprojError, reprojectionError.norm());
-        }
-        i += 1;
-      }
-      // Flag as degenerate if average reprojection error is too large
-      if (params.dynamicOutlierRejectionThreshold > 0
-          && maxReprojError > params.dynamicOutlierRejectionThreshold)
-        return TriangulationResult::Outlier();
-
-      // all good!
-      return TriangulationResult(point);
+      return checkTriangulatedPoint(cameras, measured, params, point);
     } catch (TriangulationUnderconstrainedException&) {
       // This exception is thrown if
       // 1) There is a single pose for triangulation - this should not happen because we checked the number of poses before
@@ -515,5 +581,106 @@ TriangulationResult triangulateSafe(const CameraSet<CAMERA>& cameras,
     }
 }
 
+/**
+ * Triangulate a batch of landmarks observed by the same set of cameras, e.g.
+ * all new landmarks of a keyframe during structure initialization. The
+ * projection matrices are built once and shared by all landmarks, and each
+ * chunk of landmarks reuses a single DLT workspace. With TBB the chunks are
+ * triangulated in parallel.
+ * @param cameras pinhole cameras, shared by all landmarks
+ * @param measurementSets one measurement vector per landmark, each of the
+ *        same size as cameras
+ * @param params triangulation parameters, as in triangulateSafe
+ * @return one TriangulationResult per landmark
+ */
+template<class CAMERA>
+std::vector<TriangulationResult> triangulateSafeBatch(
+    const CameraSet<CAMERA>& cameras,
+    const std::vector<typename CAMERA::MeasurementVector>& measurementSets,
+    const TriangulationParameters& params) {
+
+  const size_t m = cameras.size();
+  std::vector<TriangulationResult> results(measurementSets.size(),
+      TriangulationResult::Degenerate());
+
+  // if we have a single pose the corresponding factors are uninformative
+  if (m < 2)
+    return results;
+
+  // The projection matrices depend only on the cameras: build them once and
+  // share them across all landmarks in the batch
+  std::vector<Matrix34, Eigen::aligned_allocator<Matrix34>> projection_matrices;
+  for(const CAMERA& camera: cameras)
+    projection_matrices.push_back(
+        CameraProjectionMatrix<typename CAMERA::CalibrationType>(
+            camera.calibration())(camera.pose()));
+
+  // Triangulate a contiguous chunk of landmarks, reusing one DLT workspace
+  auto triangulateChunk = [&](size_t begin, size_t end) {
+    Matrix A(2 * m, 4); // DLT workspace, shared by all landmarks in the chunk
+    for (size_t k = begin; k != end; ++k) {
+      const typename CAMERA::MeasurementVector& measured = measurementSets[k];
+      assert(measured.size() == m);
+      try {
+        Point3 point = triangulateDLT(projection_matrices, measured,
+            params.rankTolerance, A);
+        if (params.enableEPI)
+          point = triangulateNonlinear<CAMERA>(cameras, measured, point);
+
+        // Same quality checks as triangulateSafe. Cheirality is checked
+        // explicitly here, as the DLT above never throws
+        bool farPoint = false, behindCamera = false;
+        double maxReprojError = 0.0;
+        size_t i = 0;
+        for(const CAMERA& camera: cameras) {
+          const Pose3& pose = camera.pose();
+          if (params.landmarkDistanceThreshold > 0
+              && distance3(pose.translation(), point)
+                  > params.landmarkDistanceThreshold) {
+            farPoint = true;
+            break;
+          }
+          const Point3& p_local = pose.transformTo(point);
+          if (p_local.z() <= 0) {
+            behindCamera = true;
+            break;
+          }
+          if (params.dynamicOutlierRejectionThreshold > 0) {
+            Point2 reprojectionError(camera.project(point) - measured.at(i));
+            maxReprojError = std::max(maxReprojError, reprojectionError.norm());
+          }
+          i += 1;
+        }
+        if (farPoint)
+          results[k] = TriangulationResult::FarPoint();
+        else if (behindCamera)
+          results[k] = TriangulationResult::BehindCamera();
+        else if (params.dynamicOutlierRejectionThreshold > 0
+            && maxReprojError > params.dynamicOutlierRejectionThreshold)
+          results[k] = TriangulationResult::Outlier();
+        else
+          results[k] = TriangulationResult(point);
+      } catch (TriangulationUnderconstrainedException&) {
+        // rank of the DLT matrix is < 3: rotation-only, parallel cameras
+        results[k] = TriangulationResult::Degenerate();
+      } catch (TriangulationCheiralityException&) {
+        // thrown by triangulateNonlinear if the refined point moved behind a camera
+        results[k] = TriangulationResult::BehindCamera();
+      }
+    }
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, measurementSets.size()),
+      [&triangulateChunk](const tbb::blocked_range<size_t>& range) {
+        triangulateChunk(range.begin(), range.end());
+      });
+#else
+  triangulateChunk(0, measurementSets.size());
+#endif
+
+  return results;
+}
+
 } // \namespace gtsam
 
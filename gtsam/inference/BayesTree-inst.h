@@ -22,12 +22,17 @@
 
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/BayesTree.h>
+#include <gtsam/base/FastDefaultAllocator.h>
+#include <gtsam/base/FastMap.h>
 #include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/base/timing.h>
 
 #include <boost/optional.hpp>
 #include <boost/assign/list_of.hpp>
+#include <boost/make_shared.hpp>
 #include <fstream>
+#include <set>
+#include <utility>
 
 using boost::assign::cref_list_of;
 
@@ -175,18 +180,141 @@ namespace gtsam {
       parentPointer->children.push_back(clone);
       return clone;
     }
+
+    // Deep-clone a single subtree, returning its detached root clone
+    template<typename NODE>
+    boost::shared_ptr<NODE> BayesTreeCloneSubtree(
+        const boost::shared_ptr<NODE>& subtree) {
+      struct SubForest {
+        typedef NODE Node;
+        FastVector<boost::shared_ptr<NODE> > roots_;
+        const FastVector<boost::shared_ptr<NODE> >& roots() const { return roots_; }
+      };
+      SubForest forest;
+      forest.roots_.push_back(subtree);
+      boost::shared_ptr<NODE> rootContainer = boost::make_shared<NODE>();
+      treeTraversal::DepthFirstForest(forest, rootContainer,
+          BayesTreeCloneForestVisitorPre<NODE>);
+      return rootContainer->children.front();
+    }
   }
 
   /* ************************************************************************* */
   template<class CLIQUE>
   BayesTree<CLIQUE>& BayesTree<CLIQUE>::operator=(const This& other) {
     this->clear();
-    boost::shared_ptr<Clique> rootContainer = boost::make_shared<Clique>();
-    treeTraversal::DepthFirstForest(other, rootContainer, BayesTreeCloneForestVisitorPre<Clique>);
-    for(const sharedClique& root: rootContainer->children) {
-      root->parent_ = typename Clique::weak_ptr(); // Reset the parent since it's set to the dummy clique
-      insertRoot(root);
+
+    // Expand a breadth-first frontier of subtree roots until there is enough
+    // independent work for the available threads; the few cliques above the
+    // frontier are cloned serially below, everything else in parallel.
+    const size_t nrThreads = std::thread::hardware_concurrency();
+    FastVector<sharedClique> frontier(other.roots_.begin(), other.roots_.end());
+    FastVector<sharedClique> top; // cliques above the frontier, parents first
+    if (nrThreads >= 2) {
+      for (int level = 0; level < 3 && frontier.size() < 2 * nrThreads; ++level) {
+        FastVector<sharedClique> next;
+        for(const sharedClique& clique: frontier) {
+          top.push_back(clique);
+          next.insert(next.end(), clique->children.begin(), clique->children.end());
+        }
+        frontier.swap(next);
+      }
+    }
+
+    if (nrThreads < 2 || frontier.size() < 2) {
+      // Serial deep-clone of the whole forest
+      boost::shared_ptr<Clique> rootContainer = boost::make_shared<Clique>();
+      treeTraversal::DepthFirstForest(other, rootContainer, BayesTreeCloneForestVisitorPre<Clique>);
+      for(const sharedClique& root: rootContainer->children) {
+        root->parent_ = typename Clique::weak_ptr(); // Reset the parent since it's set to the dummy clique
+        insertRoot(root);
+      }
+      return *this;
+    }
+
+    // Clone the top cliques serially, parents before children (BFS order)
+    FastMap<const Clique*, sharedClique> cloneOf;
+    for(const sharedClique& oldClique: top) {
+      sharedClique clone = boost::make_shared<Clique>(*oldClique);
+      clone->children.clear();
+      const sharedClique oldParent = oldClique->parent_.lock();
+      if (oldParent) {
+        const sharedClique& newParent = cloneOf.at(oldParent.get());
+        clone->parent_ = newParent;
+        newParent->children.push_back(clone);
+      } else {
+        clone->parent_ = typename Clique::weak_ptr();
+        roots_.push_back(clone);
+      }
+      cloneOf.insert(std::make_pair(oldClique.get(), clone));
+      for(Key j: clone->conditional()->frontals())
+        nodes_[j] = clone;
+    }
+
+    // Reserve an attachment slot per frontier subtree, so the workers write
+    // disjoint, pre-allocated elements and never mutate a shared container.
+    struct CloneTask {
+      sharedClique oldRoot;
+      sharedClique newParent;             // empty if the subtree is a root
+      FastVector<sharedClique>* container; // where the cloned root goes
+      size_t slot;
+    };
+    FastVector<CloneTask> tasks;
+    for(const sharedClique& subtree: frontier) {
+      CloneTask task;
+      task.oldRoot = subtree;
+      const sharedClique oldParent = subtree->parent_.lock();
+      if (oldParent) {
+        task.newParent = cloneOf.at(oldParent.get());
+        task.container = &task.newParent->children;
+      } else {
+        task.container = &roots_;
+      }
+      task.slot = task.container->size();
+      task.container->push_back(sharedClique());
+      tasks.push_back(task);
     }
+
+    // Deal the subtrees round-robin to the workers.  Each worker gathers its
+    // node index entries in a private buffer; the buffers are merged serially
+    // afterwards, so nodes_ itself is never touched concurrently.
+    const size_t nrWorkers = std::min(nrThreads, tasks.size());
+    std::vector<std::vector<std::pair<Key, sharedClique> > > indexBuffers(nrWorkers);
+    std::vector<std::exception_ptr> errors(nrWorkers);
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < nrWorkers; ++w) {
+      workers.push_back(std::thread([w, nrWorkers, &tasks, &indexBuffers, &errors]() {
+        try {
+          for (size_t i = w; i < tasks.size(); i += nrWorkers) {
+            const CloneTask& task = tasks[i];
+            sharedClique clone = BayesTreeCloneSubtree<Clique>(task.oldRoot);
+            clone->parent_ = task.newParent; // empty parent yields an empty weak_ptr
+            (*task.container)[task.slot] = clone;
+            // Gather the node index entries of the cloned subtree
+            std::vector<std::pair<Key, sharedClique> >& buffer = indexBuffers[w];
+            FastVector<sharedClique> stack(1, clone);
+            while (!stack.empty()) {
+              sharedClique current = stack.back();
+              stack.pop_back();
+              for(Key j: current->conditional()->frontals())
+                buffer.push_back(std::make_pair(j, current));
+              stack.insert(stack.end(), current->children.begin(),
+                  current->children.end());
+            }
+          }
+        } catch (...) {
+          errors[w] = std::current_exception();
+        }
+      }));
+    }
+    for (size_t w = 0; w < nrWorkers; ++w)
+      workers[w].join();
+    for (size_t w = 0; w < nrWorkers; ++w)
+      if (errors[w]) std::rethrow_exception(errors[w]);
+    for (size_t w = 0; w < nrWorkers; ++w)
+      for(const std::pair<Key, sharedClique>& entry: indexBuffers[w])
+        nodes_[entry.first] = entry.second;
+
     return *this;
   }
 
@@ -245,6 +373,42 @@ namespace gtsam {
     fillNodesIndex(subtree); // Populate nodes index
   }
 
+  /* ************************************************************************* */
+  template<class CLIQUE>
+  void BayesTree<CLIQUE>::pack() {
+    if (roots_.empty())
+      return;
+    gttic(BayesTree_pack);
+    Roots oldRoots;
+    oldRoots.swap(roots_);
+    nodes_.clear();
+    // Reallocate every clique in pre-order, so that parents are drawn from
+    // the pooled allocator immediately before their children and subtrees
+    // end up adjacent in memory.  Incremental updates scatter cliques all
+    // over the heap; after a big restructuring this restores the traversal
+    // locality of a batch elimination.
+    FastVector<std::pair<sharedClique, sharedClique> > stack;  // (old, new parent)
+    for (auto it = oldRoots.rbegin(); it != oldRoots.rend(); ++it)
+      stack.push_back(std::make_pair(*it, sharedClique()));
+    while (!stack.empty()) {
+      const sharedClique old = stack.back().first;
+      const sharedClique parent = stack.back().second;
+      stack.pop_back();
+      sharedClique packed = boost::allocate_shared<Clique>(
+          typename internal::FastDefaultAllocator<Clique>::type(), *old);
+      packed->children.clear();
+      packed->parent_ = parent;
+      if (parent)
+        parent->children.push_back(packed);
+      else
+        roots_.push_back(packed);
+      for (const Key& j : packed->conditional()->frontals())
+        nodes_.insert(std::make_pair(j, packed));
+      for (auto it = old->children.rbegin(); it != old->children.rend(); ++it)
+        stack.push_back(std::make_pair(*it, packed));
+    }
+  }
+
   /* ************************************************************************* */
   // First finds clique marginal then marginalizes that
   /* ************************************************************************* */
@@ -458,14 +622,44 @@ namespace gtsam {
   void BayesTree<CLIQUE>::removeTop(const KeyVector& keys, BayesNetType* bn,
                                     Cliques* orphans) {
     gttic(removetop);
-    // process each key of the new factor
+    // Batched version of repeated removePath calls: each path from a key's
+    // clique to its root is gathered first and then detached in one pass, and
+    // a membership set replaces the full orphan-list scan that removePath
+    // performs per removed clique.  The conditional, orphan, and removal
+    // order is identical to calling removePath for every key in turn.
+    std::set<const Clique*> orphaned; // cliques currently on the orphan list
+    FastVector<sharedClique> path;   // reused per-key scratch, bottom-up
     for (const Key& j : keys) {
       // get the clique
-      // TODO(frank): Nodes will be searched again in removeClique
       typename Nodes::const_iterator node = nodes_.find(j);
-      if (node != nodes_.end()) {
-        // remove path from clique to root
-        this->removePath(node->second, bn, orphans);
+      if (node == nodes_.end())
+        continue;
+
+      // gather the path from the clique to its root; the walk stops below
+      // cliques removed earlier because removeClique resets child parents
+      path.clear();
+      for (sharedClique clique = node->second; clique;
+          clique = clique->parent_.lock())
+        path.push_back(clique);
+
+      // detach bottom-up, so that by the time a parent is processed its
+      // removed children are already gone from its children list
+      for(const sharedClique& clique: path) {
+        if (orphaned.erase(clique.get()))
+          orphans->remove(clique); // was orphaned earlier, now removed instead
+        this->removeClique(clique);
+      }
+
+      // emit conditionals and orphans top-down, as removePath does
+      for (typename FastVector<sharedClique>::const_reverse_iterator it =
+          path.rbegin(); it != path.rend(); ++it) {
+        const sharedClique& clique = *it;
+        for(const sharedClique& child: clique->children)
+          orphaned.insert(child.get());
+        orphans->insert(orphans->begin(), clique->children.begin(),
+            clique->children.end());
+        clique->children.clear();
+        bn->push_back(clique->conditional_);
       }
     }
 
@@ -201,6 +201,13 @@ namespace gtsam {
     /** Remove all nodes */
     void clear();
 
+    /** Reallocate all cliques in depth-first order from the pooled allocator,
+     *  improving memory locality of tree traversals.  Incremental updates
+     *  scatter cliques through the heap in insertion order; calling this
+     *  after a big restructuring packs each subtree contiguously again.
+     *  Must not be called while external references to cliques are held. */
+    void pack();
+
     /** Clear all shortcut caches - use before timing on marginal calculation to avoid residual cache data */
     void deleteCachedShortcuts();
 
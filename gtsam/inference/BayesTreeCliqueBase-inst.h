@@ -19,6 +19,8 @@
 #include <gtsam/inference/BayesTreeCliqueBase.h>
 #include <gtsam/base/timing.h>
 
+#include <algorithm>
+
 namespace gtsam {
 
   /* ************************************************************************* */
@@ -43,9 +45,14 @@ namespace gtsam {
   KeyVector
     BayesTreeCliqueBase<DERIVED, FACTORGRAPH>::separator_setminus_B(const derived_ptr& B) const
   {
-    KeySet p_F_S_parents(this->conditional()->beginParents(), this->conditional()->endParents());
-    KeySet indicesB(B->conditional()->begin(), B->conditional()->end());
+    // Sorted KeyVectors avoid the per-node allocations of the tree-based
+    // KeySets previously built here on every shortcut computation
+    KeyVector p_F_S_parents(this->conditional()->beginParents(), this->conditional()->endParents());
+    std::sort(p_F_S_parents.begin(), p_F_S_parents.end());
+    KeyVector indicesB(B->conditional()->begin(), B->conditional()->end());
+    std::sort(indicesB.begin(), indicesB.end());
     KeyVector S_setminus_B;
+    S_setminus_B.reserve(p_F_S_parents.size());
     std::set_difference(p_F_S_parents.begin(), p_F_S_parents.end(),
       indicesB.begin(), indicesB.end(), back_inserter(S_setminus_B));
     return S_setminus_B;
@@ -57,10 +64,15 @@ namespace gtsam {
     const derived_ptr& B, const FactorGraphType& p_Cp_B) const
   {
     gttic(shortcut_indices);
-    KeySet allKeys = p_Cp_B.keys();
-    KeySet indicesB(B->conditional()->begin(), B->conditional()->end());
+    // Sorted unique KeyVectors, for the same reason as in separator_setminus_B
+    KeyVector allKeys = p_Cp_B.keyVector();
+    std::sort(allKeys.begin(), allKeys.end());
+    allKeys.erase(std::unique(allKeys.begin(), allKeys.end()), allKeys.end());
+    KeyVector indicesB(B->conditional()->begin(), B->conditional()->end());
+    std::sort(indicesB.begin(), indicesB.end());
     KeyVector S_setminus_B = separator_setminus_B(B);
     KeyVector keep;
+    keep.reserve(S_setminus_B.size() + indicesB.size());
     // keep = S\B intersect allKeys (S_setminus_B is already sorted)
     std::set_intersection(S_setminus_B.begin(), S_setminus_B.end(), //
       allKeys.begin(), allKeys.end(), back_inserter(keep));
@@ -12,9 +12,12 @@
 #include <gtsam/inference/ClusterTree.h>
 #include <gtsam/inference/BayesTree.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/base/FastDefaultAllocator.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/treeTraversal-inst.h>
 
+#include <boost/make_shared.hpp>
+
 namespace gtsam {
 
 /* ************************************************************************* */
@@ -122,7 +125,12 @@ struct EliminationData {
   boost::shared_ptr<BTNode> bayesTreeNode;
 
   EliminationData(EliminationData* _parentData, size_t nChildren) :
-      parentData(_parentData), bayesTreeNode(boost::make_shared<BTNode>()) {
+      parentData(_parentData),
+      // Draw the clique from the process-wide pooled allocator so that all
+      // trees in a process share size-segregated slabs instead of each
+      // fragmenting the heap with its own small node allocations
+      bayesTreeNode(boost::allocate_shared<BTNode>(
+          typename internal::FastDefaultAllocator<BTNode>::type())) {
     if (parentData) {
       myIndexInParent = parentData->childFactors.size();
       parentData->childFactors.push_back(sharedFactor());
@@ -218,7 +226,8 @@ EliminatableClusterTree<BAYESTREE, GRAPH>& EliminatableClusterTree<BAYESTREE, GR
 /* ************************************************************************* */
 template <class BAYESTREE, class GRAPH>
 std::pair<boost::shared_ptr<BAYESTREE>, boost::shared_ptr<GRAPH> >
-EliminatableClusterTree<BAYESTREE, GRAPH>::eliminate(const Eliminate& function) const {
+EliminatableClusterTree<BAYESTREE, GRAPH>::eliminate(const Eliminate& function,
+    int problemSizeThreshold) const {
   gttic(ClusterTree_eliminate);
   // Do elimination (depth-first traversal).  The rootsContainer stores a 'dummy' BayesTree node
   // that contains all of the roots as its children.  rootsContainer also stores the remaining
@@ -232,7 +241,7 @@ EliminatableClusterTree<BAYESTREE, GRAPH>::eliminate(const Eliminate& function)
   {
     TbbOpenMPMixedScope threadLimiter;  // Limits OpenMP threads since we're mixing TBB and OpenMP
     treeTraversal::DepthFirstForestParallel(*this, rootsContainer, Data::EliminationPreOrderVisitor,
-                                            visitorPost, 10);
+                                            visitorPost, problemSizeThreshold);
   }
 
   // Create BayesTree from roots stored in the dummy BayesTree node.
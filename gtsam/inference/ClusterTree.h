@@ -217,10 +217,15 @@ class EliminatableClusterTree : public ClusterTree<GRAPH> {
   /** Eliminate the factors to a Bayes tree and remaining factor graph
    * @param function The function to use to eliminate, see the namespace functions
    * in GaussianFactorGraph.h
+   * @param problemSizeThreshold When built with TBB, independent subtrees whose
+   * problem size reaches this threshold are eliminated in concurrent tasks;
+   * smaller subtrees are processed serially within their task.  Lowering the
+   * threshold to 1 forces a task per clique, guaranteeing that all independent
+   * subtrees run in parallel.  Ignored in non-TBB builds.
    * @return The Bayes tree and factor graph resulting from elimination
    */
   std::pair<boost::shared_ptr<BayesTreeType>, boost::shared_ptr<FactorGraphType> > eliminate(
-      const Eliminate& function) const;
+      const Eliminate& function, int problemSizeThreshold = 10) const;
 
   /// @}
 
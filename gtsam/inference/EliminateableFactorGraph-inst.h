@@ -18,9 +18,13 @@
 
 #pragma once
 
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/inference/EliminateableFactorGraph.h>
 #include <gtsam/inference/inferenceExceptions.h>
+#include <boost/make_shared.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <stdexcept>
 
 namespace gtsam {
 
@@ -82,7 +86,7 @@ namespace gtsam {
   boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesTreeType>
     EliminateableFactorGraph<FACTORGRAPH>::eliminateMultifrontal(
     OptionalOrderingType orderingType, const Eliminate& function,
-    OptionalVariableIndex variableIndex) const
+    OptionalVariableIndex variableIndex, int problemSizeThreshold) const
   {
     if(!variableIndex) {
       // If no VariableIndex provided, compute one and call this function again IMPORTANT: we check
@@ -90,17 +94,20 @@ namespace gtsam {
       // no Ordering is provided.  When removing optional from VariableIndex, create VariableIndex
       // before creating ordering.
       VariableIndex computedVariableIndex(asDerived());
-      return eliminateMultifrontal(function, computedVariableIndex, orderingType);
+      return eliminateMultifrontal(orderingType, function, computedVariableIndex,
+          problemSizeThreshold);
     }
     else {
       // Compute an ordering and call this function again.  We are guaranteed to have a
       // VariableIndex already here because we computed one if needed in the previous 'if' block.
       if (orderingType == Ordering::METIS) {
         Ordering computedOrdering = Ordering::Metis(asDerived());
-        return eliminateMultifrontal(computedOrdering, function, variableIndex, orderingType);
+        return eliminateMultifrontal(computedOrdering, function, variableIndex,
+            problemSizeThreshold);
       } else {
         Ordering computedOrdering = Ordering::Colamd(*variableIndex);
-        return eliminateMultifrontal(computedOrdering, function, variableIndex, orderingType);
+        return eliminateMultifrontal(computedOrdering, function, variableIndex,
+            problemSizeThreshold);
       }
     }
   }
@@ -110,12 +117,13 @@ namespace gtsam {
   boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesTreeType>
     EliminateableFactorGraph<FACTORGRAPH>::eliminateMultifrontal(
     const Ordering& ordering, const Eliminate& function,
-    OptionalVariableIndex variableIndex) const
+    OptionalVariableIndex variableIndex, int problemSizeThreshold) const
   {
     if(!variableIndex) {
       // If no VariableIndex provided, compute one and call this function again
       VariableIndex computedVariableIndex(asDerived());
-      return eliminateMultifrontal(ordering, function, computedVariableIndex);
+      return eliminateMultifrontal(ordering, function, computedVariableIndex,
+          problemSizeThreshold);
     } else {
       gttic(eliminateMultifrontal);
       // Do elimination with given ordering
@@ -123,7 +131,7 @@ namespace gtsam {
       JunctionTreeType junctionTree(etree);
       boost::shared_ptr<BayesTreeType> bayesTree;
       boost::shared_ptr<FactorGraphType> factorGraph;
-      boost::tie(bayesTree,factorGraph) = junctionTree.eliminate(function);
+      boost::tie(bayesTree,factorGraph) = junctionTree.eliminate(function, problemSizeThreshold);
       // If any factors are remaining, the ordering was incomplete
       if(!factorGraph->empty())
         throw InconsistentEliminationRequested();
@@ -132,6 +140,142 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  namespace {
+  // Collect the clusters of a cluster tree in deterministic pre-order.  Cloning a cluster tree
+  // preserves the order of children, so this pairs up the clusters of a cloned tree with those
+  // recorded when the original was analyzed.
+  template<class CLUSTERTREE>
+  FastVector<typename CLUSTERTREE::sharedNode> clustersInPreOrder(const CLUSTERTREE& tree) {
+    typedef typename CLUSTERTREE::sharedNode sharedNode;
+    FastVector<sharedNode> clusters;
+    int rootData = 0;
+    auto visitorPre = [&clusters](const sharedNode& node, int&) -> int {
+      clusters.push_back(node);
+      return 0;
+    };
+    treeTraversal::DepthFirstForest(tree, rootData, visitorPre);
+    return clusters;
+  }
+  }
+
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  typename EliminateableFactorGraph<FACTORGRAPH>::SymbolicSolveHandle
+    EliminateableFactorGraph<FACTORGRAPH>::analyzeMultifrontal(
+    OptionalOrderingType orderingType, OptionalVariableIndex variableIndex) const
+  {
+    if(!variableIndex) {
+      // If no VariableIndex provided, compute one and call this function again IMPORTANT: we check
+      // for no variable index first so that it's always computed if we need to call COLAMD because
+      // no Ordering is provided.
+      VariableIndex computedVariableIndex(asDerived());
+      return analyzeMultifrontal(orderingType, computedVariableIndex);
+    }
+    else {
+      // Compute an ordering and call this function again, as in eliminateMultifrontal.
+      if (orderingType == Ordering::METIS) {
+        Ordering computedOrdering = Ordering::Metis(asDerived());
+        return analyzeMultifrontal(computedOrdering, variableIndex);
+      } else {
+        Ordering computedOrdering = Ordering::Colamd(*variableIndex);
+        return analyzeMultifrontal(computedOrdering, variableIndex);
+      }
+    }
+  }
+
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  typename EliminateableFactorGraph<FACTORGRAPH>::SymbolicSolveHandle
+    EliminateableFactorGraph<FACTORGRAPH>::analyzeMultifrontal(
+    const Ordering& ordering, OptionalVariableIndex variableIndex) const
+  {
+    if(!variableIndex) {
+      // If no VariableIndex provided, compute one and call this function again
+      VariableIndex computedVariableIndex(asDerived());
+      return analyzeMultifrontal(ordering, computedVariableIndex);
+    } else {
+      gttic(analyzeMultifrontal);
+      SymbolicSolveHandle handle;
+      handle.ordering = ordering;
+      handle.variableIndex = *variableIndex;
+      handle.nrGraphFactors = asDerived().size();
+
+      // Build the trees exactly as eliminateMultifrontal would, but stop before eliminating
+      EliminationTreeType etree(asDerived(), *variableIndex, ordering);
+      handle.junctionTree = boost::make_shared<JunctionTreeType>(etree);
+
+      // Record the graph slot of every factor gathered by every cluster, so that the numeric
+      // phase can re-point a clone of this structure at updated factors in the same slots.
+      FastMap<const _FactorType*, size_t> slotOfFactor;
+      for(size_t slot = 0; slot < asDerived().size(); ++slot) {
+        if(asDerived()[slot])
+          slotOfFactor.insert(std::make_pair(asDerived()[slot].get(), slot));
+      }
+      typedef typename JunctionTreeType::sharedNode sharedNode;
+      const FastVector<sharedNode> clusters = clustersInPreOrder(*handle.junctionTree);
+      handle.clusterFactorSlots.reserve(clusters.size());
+      for(const sharedNode& cluster: clusters) {
+        FastVector<size_t> slots;
+        slots.reserve(cluster->factors.size());
+        for(const typename JunctionTreeType::sharedFactor& factor: cluster->factors) {
+          typename FastMap<const _FactorType*, size_t>::const_iterator item =
+            slotOfFactor.find(factor.get());
+          if(item == slotOfFactor.end())
+            throw std::runtime_error(
+              "analyzeMultifrontal: internal error, cluster factor not found in the graph");
+          slots.push_back(item->second);
+        }
+        handle.clusterFactorSlots.push_back(slots);
+      }
+      return handle;
+    }
+  }
+
+  /* ************************************************************************* */
+  template<class FACTORGRAPH>
+  boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesTreeType>
+    EliminateableFactorGraph<FACTORGRAPH>::numericFactorizeMultifrontal(
+    const SymbolicSolveHandle& handle, const Eliminate& function, int problemSizeThreshold) const
+  {
+    gttic(numericFactorizeMultifrontal);
+    if(!handle.junctionTree)
+      throw std::invalid_argument(
+        "numericFactorizeMultifrontal: the handle was not produced by analyzeMultifrontal");
+    if(asDerived().size() != handle.nrGraphFactors)
+      throw std::invalid_argument(
+        "numericFactorizeMultifrontal: the graph does not have the same number of factors as the "
+        "graph that was analyzed");
+
+    // Clone the analyzed clique structure (cluster nodes are duplicated, factor pointers are
+    // shared) and re-point every cluster at this graph's factors in the recorded slots.
+    JunctionTreeType junctionTree(*handle.junctionTree);
+    typedef typename JunctionTreeType::sharedNode sharedNode;
+    const FastVector<sharedNode> clusters = clustersInPreOrder(junctionTree);
+    assert(clusters.size() == handle.clusterFactorSlots.size());
+    for(size_t i = 0; i < clusters.size(); ++i) {
+      const FastVector<size_t>& slots = handle.clusterFactorSlots[i];
+      for(size_t j = 0; j < slots.size(); ++j) {
+        const boost::shared_ptr<_FactorType> factor = asDerived()[slots[j]];
+        if(!factor)
+          throw std::invalid_argument(
+            "numericFactorizeMultifrontal: the graph is missing a factor that was present in the "
+            "graph that was analyzed");
+        clusters[i]->factors[j] = factor;
+      }
+    }
+
+    // Do the numeric elimination, as in eliminateMultifrontal
+    boost::shared_ptr<BayesTreeType> bayesTree;
+    boost::shared_ptr<FactorGraphType> factorGraph;
+    boost::tie(bayesTree,factorGraph) = junctionTree.eliminate(function, problemSizeThreshold);
+    // If any factors are remaining, the ordering was incomplete
+    if(!factorGraph->empty())
+      throw InconsistentEliminationRequested();
+    // Return the Bayes tree
+    return bayesTree;
+  }
+
   /* ************************************************************************* */
   template<class FACTORGRAPH>
   std::pair<boost::shared_ptr<typename EliminateableFactorGraph<FACTORGRAPH>::BayesNetType>, boost::shared_ptr<FACTORGRAPH> >
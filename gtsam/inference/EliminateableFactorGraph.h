@@ -23,6 +23,7 @@
 #include <boost/variant.hpp>
 #include <boost/optional.hpp>
 
+#include <gtsam/base/FastVector.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/VariableIndex.h>
 
@@ -157,7 +158,8 @@ namespace gtsam {
     boost::shared_ptr<BayesTreeType> eliminateMultifrontal(
       OptionalOrderingType orderingType = boost::none,
       const Eliminate& function = EliminationTraitsType::DefaultEliminate,
-      OptionalVariableIndex variableIndex = boost::none) const;
+      OptionalVariableIndex variableIndex = boost::none,
+      int problemSizeThreshold = 10) const;
 
     /** Do multifrontal elimination of all variables to produce a Bayes tree.  If an ordering is not
      *  provided, the ordering will be computed using either COLAMD or METIS, dependeing on
@@ -167,12 +169,65 @@ namespace gtsam {
      *  \code
      *  boost::shared_ptr<GaussianBayesTree> result = graph.eliminateMultifrontal(EliminateQR, myOrdering);
      *  \endcode
+     *
+     *  In TBB builds, \c problemSizeThreshold controls how eagerly independent
+     *  subtrees of the elimination tree are spawned as concurrent tasks; see
+     *  EliminatableClusterTree::eliminate.  Setting it to 1 guarantees a task
+     *  per clique, keeping all cores busy on large batch solves.
      *  */
     boost::shared_ptr<BayesTreeType> eliminateMultifrontal(
       const Ordering& ordering,
       const Eliminate& function = EliminationTraitsType::DefaultEliminate,
+      OptionalVariableIndex variableIndex = boost::none,
+      int problemSizeThreshold = 10) const;
+
+    /** The reusable symbolic half of multifrontal elimination: the ordering, variable index, and
+     *  amalgamated clique structure computed by analyzeMultifrontal, together with the graph slot
+     *  of every factor gathered by each clique.  Produce it once for a given factor-graph
+     *  topology, then call numericFactorizeMultifrontal with updated factor values (e.g. after
+     *  relinearization at a new point) to repeat only the numeric work. */
+    struct SymbolicSolveHandle {
+      Ordering ordering;                                  ///< Elimination ordering used by the analysis
+      VariableIndex variableIndex;                        ///< Variable index of the analyzed graph
+      boost::shared_ptr<JunctionTreeType> junctionTree;   ///< Analyzed clique structure
+      FastVector<FastVector<size_t> > clusterFactorSlots; ///< Graph slots gathered by each clique, in pre-order
+      size_t nrGraphFactors;                              ///< Number of factors in the analyzed graph
+
+      SymbolicSolveHandle() : nrGraphFactors(0) {}
+    };
+
+    /** Perform only the symbolic phase of multifrontal elimination - computing the ordering (via
+     *  COLAMD or METIS, as in eliminateMultifrontal), the elimination tree, and the amalgamated
+     *  clique structure - and return it as a handle for repeated numeric factorization.
+     *
+     *  <b> Example - factoring the same topology at several linearization points: </b>
+     *  \code
+     *  auto handle = graph.analyzeMultifrontal();
+     *  boost::shared_ptr<GaussianBayesTree> result = graph.numericFactorizeMultifrontal(handle);
+     *  // ... update factor values without changing keys, then factor again:
+     *  result = updatedGraph.numericFactorizeMultifrontal(handle);
+     *  \endcode
+     *  */
+    SymbolicSolveHandle analyzeMultifrontal(
+      OptionalOrderingType orderingType = boost::none,
       OptionalVariableIndex variableIndex = boost::none) const;
 
+    /** Perform only the symbolic phase of multifrontal elimination with the given ordering, and
+     *  return it as a handle for repeated numeric factorization.  See the overload above. */
+    SymbolicSolveHandle analyzeMultifrontal(
+      const Ordering& ordering,
+      OptionalVariableIndex variableIndex = boost::none) const;
+
+    /** Do only the numeric phase of multifrontal elimination, reusing the ordering and clique
+     *  structure of a handle produced by analyzeMultifrontal on a graph with the same topology:
+     *  the same number of factors, in the same slots, involving the same keys.  Factor values may
+     *  differ - this is the analyze-once, factorize-many pattern of sparse direct solvers.
+     *  Throws std::invalid_argument if this graph does not match the analyzed topology. */
+    boost::shared_ptr<BayesTreeType> numericFactorizeMultifrontal(
+      const SymbolicSolveHandle& handle,
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate,
+      int problemSizeThreshold = 10) const;
+
     /** Do sequential elimination of some variables, in \c ordering provided, to produce a Bayes net
      *  and a remaining factor graph.  This computes the factorization \f$ p(X) = p(A|B) p(B) \f$,
      *  where \f$ A = \f$ \c variables, \f$ X \f$ is all the variables in the factor graph, and \f$
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <gtsam/base/Arena.h>
 #include <gtsam/base/FastVector.h>
 #include <gtsam/base/Testable.h>
 #include <gtsam/inference/Key.h>
@@ -171,6 +172,20 @@ class FactorGraph {
         std::forward<Args>(args)...));
   }
 
+  /**
+   * Emplace a factor of given type with its storage (object and shared_ptr
+   * control block) drawn from the arena, avoiding a heap allocation per
+   * factor during bulk graph construction.  The arena must outlive the
+   * graph and every copy of the factor's shared_ptr; see
+   * NonlinearFactorGraph::linearize(const Values&, Arena&) for the same
+   * lifetime contract.
+   */
+  template <class DERIVEDFACTOR, class... Args>
+  IsDerived<DERIVEDFACTOR> emplace_shared(Arena& arena, Args&&... args) {
+    factors_.push_back(boost::allocate_shared<DERIVEDFACTOR>(
+        ArenaAllocator<DERIVEDFACTOR>(arena), std::forward<Args>(args)...));
+  }
+
   /**
    * Add a factor by value, will be copy-constructed (use push_back with a
    * shared_ptr to avoid the copy).
@@ -181,6 +196,17 @@ class FactorGraph {
         Eigen::aligned_allocator<DERIVEDFACTOR>(), factor));
   }
 
+  /**
+   * Add a factor by rvalue, will be move-constructed into the graph.  Named
+   * temporaries and expiring factors avoid copying their measurements and
+   * noise model shared_ptrs this way; lvalues still take the overload above.
+   */
+  template <class DERIVEDFACTOR>
+  IsDerived<DERIVEDFACTOR> push_back(DERIVEDFACTOR&& factor) {
+    factors_.push_back(boost::allocate_shared<DERIVEDFACTOR>(
+        Eigen::aligned_allocator<DERIVEDFACTOR>(), std::move(factor)));
+  }
+
   /// `add` is a synonym for push_back.
   template <class DERIVEDFACTOR>
   IsDerived<DERIVEDFACTOR> add(boost::shared_ptr<DERIVEDFACTOR> factor) {
@@ -234,6 +260,7 @@ class FactorGraph {
   /// Push back non-pointer objects in a container (factors are copied).
   template <typename CONTAINER>
   HasDerivedValueType<CONTAINER> push_back(const CONTAINER& container) {
+    factors_.reserve(factors_.size() + container.size());
     push_back(container.begin(), container.end());
   }
 
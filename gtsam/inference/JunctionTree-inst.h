@@ -36,13 +36,15 @@ struct ConstructorTraversalData {
   sharedNode myJTNode;
   FastVector<SymbolicConditional::shared_ptr> childSymbolicConditionals;
   FastVector<SymbolicFactor::shared_ptr> childSymbolicFactors;
+  JunctionTreeShaping shaping; ///< Amalgamation controls, see JunctionTreeShaping
 
   // Small inner class to store symbolic factors
   class SymbolicFactors: public FactorGraph<Factor> {
   };
 
   ConstructorTraversalData(ConstructorTraversalData* _parentData) :
-      parentData(_parentData) {
+      parentData(_parentData),
+      shaping(_parentData ? _parentData->shaping : JunctionTreeShaping()) {
   }
 
   // Pre-order visitor function
@@ -106,10 +108,34 @@ struct ConstructorTraversalData {
     std::vector<size_t> nrFrontals = node->nrFrontalsOfChildren();
     std::vector<bool> merge(nrChildren, false);
     size_t myNrFrontals = 1;
+    const JunctionTreeShaping& shaping = myData.shaping;
     for (size_t i = 0;i<nrChildren;i++){
       // Check if we should merge the i^th child
-      if (myNrParents + myNrFrontals == childConditionals[i]->nrParents()) {
-        // Increment number of frontal variables
+      const size_t childNrParents = childConditionals[i]->nrParents();
+      if (myNrParents + myNrFrontals == childNrParents) {
+        // Exact structural match - merging introduces no fill, so it is never
+        // subject to the shaping caps below.  Increment number of frontals.
+        myNrFrontals += nrFrontals[i];
+        merge[i] = true;
+        continue;
+      }
+      // Relaxed amalgamation: the child's separator is always contained in
+      // our clique's columns, so merging is valid even when the structures
+      // do not match exactly - it just introduces explicit zeros.  Merge
+      // nearly-matching cliques whose fill stays within the budget, and tiny
+      // cliques below the minimum supernode size regardless of fill, so that
+      // they are eliminated as one larger dense panel.  A maximum supernode
+      // size caps this growth to keep the tree wide for parallel traversal.
+      if (shaping.maxSupernodeSize > 0
+          && myNrFrontals + nrFrontals[i] > shaping.maxSupernodeSize)
+        continue;
+      const size_t fill = nrFrontals[i]
+          * (myNrParents + myNrFrontals - childNrParents);
+      const bool withinFillBudget = shaping.mergeFillThreshold > 0
+          && fill <= size_t(shaping.mergeFillThreshold);
+      const bool tooSmallToKeep = shaping.minSupernodeSize > 0
+          && nrFrontals[i] < shaping.minSupernodeSize;
+      if (withinFillBudget || tooSmallToKeep) {
         myNrFrontals += nrFrontals[i];
         merge[i] = true;
       }
@@ -124,7 +150,17 @@ struct ConstructorTraversalData {
 template<class BAYESTREE, class GRAPH>
 template<class ETREE_BAYESNET, class ETREE_GRAPH>
 JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
-    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree) {
+    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+    int mergeFillThreshold) :
+    JunctionTree(eliminationTree, JunctionTreeShaping(mergeFillThreshold)) {
+}
+
+/* ************************************************************************* */
+template<class BAYESTREE, class GRAPH>
+template<class ETREE_BAYESNET, class ETREE_GRAPH>
+JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
+    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+    const JunctionTreeShaping& shaping) {
   gttic(JunctionTree_FromEliminationTree);
   // Here we rely on the BayesNet having been produced by this elimination tree,
   // such that the conditionals are arranged in DFS post-order.  We traverse the
@@ -138,6 +174,7 @@ JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
   typedef typename EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>::Node ETreeNode;
   typedef ConstructorTraversalData<BAYESTREE, GRAPH, ETreeNode> Data;
   Data rootData(0);
+  rootData.shaping = shaping;
   rootData.myJTNode = boost::make_shared<typename Base::Node>(); // Make a dummy node to gather
                                                                  // the junction tree roots
   treeTraversal::DepthFirstForest(eliminationTree, rootData,
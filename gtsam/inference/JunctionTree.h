@@ -27,6 +27,40 @@ namespace gtsam {
   // Forward declarations
   template<class BAYESNET, class GRAPH> class EliminationTree;
 
+  /**
+   * Tree-shaping controls for junction tree construction.  The default
+   * settings reproduce exact supernode amalgamation: a child clique is merged
+   * into its parent only when their column structures match exactly.  The
+   * knobs below trade a little explicit zero fill for larger dense elimination
+   * panels, or conversely cap panel growth to keep the tree wide enough for
+   * parallel traversal.
+   */
+  struct JunctionTreeShaping {
+    /** Fill budget for relaxed amalgamation: if positive, a nearly-matching
+     * child is also merged when the number of explicit zeros introduced does
+     * not exceed this threshold.  See the JunctionTree constructor. */
+    int mergeFillThreshold;
+
+    /** Minimum supernode size, in frontal variables.  If positive, a child
+     * clique with fewer frontals is merged into its parent regardless of the
+     * fill introduced, in the manner of CHOLMOD's amalgamation of tiny
+     * supernodes.  This removes the many one-variable cliques produced by
+     * sparse graphs and tall chains. */
+    size_t minSupernodeSize;
+
+    /** Maximum supernode size, in frontal variables.  If positive, relaxed
+     * merges stop once a clique would grow beyond this many frontals, keeping
+     * independent subtrees separate so that parallel elimination retains work
+     * to distribute.  Exact structural merges are never capped, as splitting
+     * those never helps. */
+    size_t maxSupernodeSize;
+
+    JunctionTreeShaping(int fillThreshold = 0) :
+        mergeFillThreshold(fillThreshold), minSupernodeSize(0),
+        maxSupernodeSize(0) {
+    }
+  };
+
   /**
    * A JunctionTree is a cluster tree, a set of variable clusters with factors, arranged in a tree,
    * with the additional property that it represents the clique tree associated with a Bayes Net.
@@ -64,9 +98,27 @@ namespace gtsam {
     template<class ETREE>
       static This FromEliminationTree(const ETREE& eliminationTree) { return This(eliminationTree); }
 
-    /** Build the junction tree from an elimination tree. */
+    /** Build the junction tree from an elimination tree.
+     * @param eliminationTree The elimination tree to amalgamate into cliques
+     * @param mergeFillThreshold Controls relaxed supernode amalgamation.  By
+     * default (0) a child clique is merged into its parent only when their
+     * column structures match exactly.  A positive threshold additionally
+     * merges nearly-matching cliques into one larger dense panel, as long as
+     * the number of explicit zeros introduced by the merge does not exceed the
+     * threshold.  Larger panels trade a little extra fill for fewer, bigger
+     * dense elimination steps, in the manner of supernodal sparse Cholesky
+     * codes. */
+    template<class ETREE_BAYESNET, class ETREE_GRAPH>
+    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+        int mergeFillThreshold = 0);
+
+    /** Build the junction tree from an elimination tree, with full control
+     * over clique amalgamation.
+     * @param eliminationTree The elimination tree to amalgamate into cliques
+     * @param shaping Tree-shaping controls, see JunctionTreeShaping */
     template<class ETREE_BAYESNET, class ETREE_GRAPH>
-    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree);
+    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+        const JunctionTreeShaping& shaping);
 
     /// @}
 
@@ -0,0 +1,64 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    KeyInternTable.cpp
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ */
+
+#include <gtsam/inference/KeyInternTable.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+const KeyInternTable::Id KeyInternTable::kNotInterned =
+    std::numeric_limits<KeyInternTable::Id>::max();
+
+/* ************************************************************************* */
+KeyInternTable::KeyInternTable(const KeyVector& keys) : keys_(keys) {
+  if (keys.size() >= size_t(kNotInterned))
+    throw std::invalid_argument(
+        "KeyInternTable: too many keys for 32-bit ids");
+  sorted_.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+    sorted_.push_back(std::make_pair(keys[i], Id(i)));
+  std::sort(sorted_.begin(), sorted_.end());
+  for (size_t i = 1; i < sorted_.size(); ++i)
+    if (sorted_[i].first == sorted_[i - 1].first)
+      throw std::invalid_argument("KeyInternTable: duplicate key");
+}
+
+/* ************************************************************************* */
+KeyInternTable::Id KeyInternTable::tryIntern(Key key) const {
+  std::vector<std::pair<Key, Id> >::const_iterator it = std::lower_bound(
+      sorted_.begin(), sorted_.end(), std::make_pair(key, Id(0)));
+  if (it == sorted_.end() || it->first != key)
+    return kNotInterned;
+  return it->second;
+}
+
+/* ************************************************************************* */
+KeyInternTable::Id KeyInternTable::intern(Key key) const {
+  const Id id = tryIntern(key);
+  if (id == kNotInterned)
+    throw std::invalid_argument(
+        "KeyInternTable: key " + std::to_string(key) + " was not interned");
+  return id;
+}
+
+/* ************************************************************************* */
+
+}  // \ namespace gtsam
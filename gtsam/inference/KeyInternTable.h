@@ -0,0 +1,72 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    KeyInternTable.h
+ * @brief   Dense 32-bit interning of arbitrary 64-bit keys
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ */
+
+#pragma once
+
+#include <gtsam/inference/Key.h>
+#include <gtsam/dllexport.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Keys are arbitrary 64-bit values, so key-indexed structures inside the
+ * solve pipelines (ordering positions, scatters, column layouts) need
+ * full-width maps.  A KeyInternTable renumbers a fixed set of keys into dense
+ * 32-bit ids so that such structures can be plain arrays indexed by id.  The
+ * table itself is a sorted flat array, so translating a key to its id is a
+ * cache-friendly binary search rather than a tree or hash probe.  The id of a
+ * key is its position in the sequence the table was built from, which makes
+ * the table of an Ordering map every key to its elimination position.
+ */
+class GTSAM_EXPORT KeyInternTable {
+ public:
+  /// Dense internal id type
+  typedef std::uint32_t Id;
+
+  /// Id returned by tryIntern for keys not in the table
+  static const Id kNotInterned;
+
+  /// Default constructor: empty table
+  KeyInternTable() {}
+
+  /// Build from a sequence of distinct keys, e.g. an Ordering; ids follow
+  /// the order of the sequence
+  explicit KeyInternTable(const KeyVector& keys);
+
+  /// Number of interned keys
+  size_t size() const { return keys_.size(); }
+
+  /// Dense id of the given key, or kNotInterned if absent
+  Id tryIntern(Key key) const;
+
+  /// Dense id of the given key; throws std::invalid_argument if absent
+  Id intern(Key key) const;
+
+  /// Translation table from dense id back to the original key
+  const KeyVector& keys() const { return keys_; }
+
+ private:
+  KeyVector keys_;                           ///< id -> key
+  std::vector<std::pair<Key, Id> > sorted_;  ///< key -> id, sorted by key
+};
+
+}  // \ namespace gtsam
@@ -25,24 +25,21 @@ namespace gtsam {
 /* ************************************************************************* */
 template<class FACTOR>
 void MetisIndex::augment(const FactorGraph<FACTOR>& factors) {
-  std::map<int32_t, std::set<int32_t> > iAdjMap; // Stores a set of keys that are adjacent to key x, with  adjMap.first
-  std::map<int32_t, std::set<int32_t> >::iterator iAdjMapIt;
-  std::set<Key> keySet;
-
   /* ********** Convert to CSR format ********** */
   // Assuming that vertex numbering starts from 0 (C style),
   // then the adjacency list of vertex i is stored in array adjncy
   // starting at index xadj[i] and ending at(but not including)
   // index xadj[i + 1](i.e., adjncy[xadj[i]] through
   // and including adjncy[xadj[i + 1] - 1]).
-  int32_t keyCounter = 0;
 
   // First: Record a copy of each key inside the factorgraph and create a
-  // key to integer mapping. This is referenced during the adjaceny step
+  // key to integer mapping. This is referenced during the adjaceny step.
+  // Numbering continues from the ids handed out by previous calls so the
+  // index can be augmented incrementally.
+  int32_t keyCounter = (int32_t) intKeyBMap_.size();
   for (size_t i = 0; i < factors.size(); i++) {
     if (factors[i]) {
       for(const Key& key: *factors[i]) {
-        keySet.insert(keySet.end(), key); // Keep a track of all unique keys
         if (intKeyBMap_.left.find(key) == intKeyBMap_.left.end()) {
           intKeyBMap_.insert(bm_type::value_type(key, keyCounter));
           keyCounter++;
@@ -50,33 +47,38 @@ void MetisIndex::augment(const FactorGraph<FACTOR>& factors) {
       }
     }
   }
+  nKeys_ = intKeyBMap_.size();
 
-  // Create an adjacency mapping that stores the set of all adjacent keys for every key
+  // Insert the new edges into the cached adjacency lists. Edges from earlier
+  // calls are retained, so only the new factors need to be scanned here.
+  adjacencyLists_.resize(nKeys_);
   for (size_t i = 0; i < factors.size(); i++) {
     if (factors[i]) {
       for(const Key& k1: *factors[i])
         for(const Key& k2: *factors[i])
           if (k1 != k2) {
             // Store both in Key and int32_t format
-            int i = intKeyBMap_.left.at(k1);
-            int j = intKeyBMap_.left.at(k2);
-            iAdjMap[i].insert(iAdjMap[i].end(), j);
+            const int32_t j = intKeyBMap_.left.at(k1);
+            const int32_t k = intKeyBMap_.left.at(k2);
+            adjacencyLists_[j].insert(k);
           }
     }
   }
 
-  // Number of keys referenced in this factor graph
-  nKeys_ = keySet.size();
-
+  // Flatten the cached adjacency lists into the CSR arrays. This pass is
+  // linear in the number of edges; the per-edge work above only touches the
+  // factors passed to this call.
+  size_t nEdges = 0;
+  for (const std::set<int32_t>& neighbors : adjacencyLists_)
+    nEdges += neighbors.size();
+  xadj_.clear();
+  xadj_.reserve(nKeys_ + 1);
+  adj_.clear();
+  adj_.reserve(nEdges);
   xadj_.push_back(0); // Always set the first index to zero
-  for (iAdjMapIt = iAdjMap.begin(); iAdjMapIt != iAdjMap.end(); ++iAdjMapIt) {
-    std::vector<int32_t> temp;
-    // Copy from the FastSet into a temporary vector
-    std::copy(iAdjMapIt->second.begin(), iAdjMapIt->second.end(),
-        std::back_inserter(temp));
+  for (const std::set<int32_t>& neighbors : adjacencyLists_) {
     // Insert each index's set in order by appending them to the end of adj_
-    adj_.insert(adj_.end(), temp.begin(), temp.end());
-    //adj_.push_back(temp);
+    adj_.insert(adj_.end(), neighbors.begin(), neighbors.end());
     xadj_.push_back((int32_t) adj_.size());
   }
 }
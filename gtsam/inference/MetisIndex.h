@@ -32,6 +32,7 @@
 #  pragma clang diagnostic pop
 #endif
 
+#include <set>
 #include <vector>
 
 namespace gtsam {
@@ -50,6 +51,7 @@ public:
 private:
   std::vector<int32_t> xadj_; // Index of node's adjacency list in adj
   std::vector<int32_t> adj_; // Stores ajacency lists of all nodes, appended into a single vector
+  std::vector<std::set<int32_t> > adjacencyLists_; // Cached adjacency sets, one per node, kept across augment() calls
   boost::bimap<Key, int32_t> intKeyBMap_; // Stores Key <-> integer value relationship
   size_t nKeys_;
 
@@ -40,6 +40,49 @@ FastMap<Key, size_t> Ordering::invert() const {
   return inverted;
 }
 
+/* ************************************************************************* */
+OrderingIndex::OrderingIndex(const Ordering& ordering) : size_(ordering.size()) {
+  // Cut the ordering into maximal runs of consecutive keys at consecutive
+  // positions, then sort the runs by first key for binary search
+  for (size_t pos = 0; pos < ordering.size(); ++pos) {
+    if (!runs_.empty()) {
+      Run& run = runs_.back();
+      if (ordering[pos] == run.firstKey + run.length) {
+        ++run.length;
+        continue;
+      }
+    }
+    runs_.push_back(Run{ordering[pos], pos, 1});
+  }
+  std::sort(runs_.begin(), runs_.end(),
+      [](const Run& a, const Run& b) { return a.firstKey < b.firstKey; });
+}
+
+/* ************************************************************************* */
+const OrderingIndex::Run* OrderingIndex::findRun(Key key) const {
+  // First run starting after the key; the one before is the only candidate
+  auto it = std::upper_bound(runs_.begin(), runs_.end(), key,
+      [](Key k, const Run& run) { return k < run.firstKey; });
+  if (it == runs_.begin())
+    return nullptr;
+  --it;
+  return (key < it->firstKey + it->length) ? &(*it) : nullptr;
+}
+
+/* ************************************************************************* */
+size_t OrderingIndex::at(Key key) const {
+  const Run* run = findRun(key);
+  if (!run)
+    throw std::out_of_range(
+        "OrderingIndex::at: requested key is not in the ordering");
+  return run->firstPosition + (key - run->firstKey);
+}
+
+/* ************************************************************************* */
+bool OrderingIndex::contains(Key key) const {
+  return findRun(key) != nullptr;
+}
+
 /* ************************************************************************* */
 Ordering Ordering::Colamd(const VariableIndex& variableIndex) {
   // Call constrained version with all groups set to zero
@@ -208,6 +251,114 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   return Ordering::ColamdConstrained(variableIndex, cmember);
 }
 
+/* ************************************************************************* */
+namespace {
+// Cheap per-variable summary of a factor column, see OrderingCache
+inline std::pair<size_t, size_t> columnFingerprint(
+    const FactorIndices& column) {
+  return std::make_pair(column.size(), column.empty() ? 0 : column.back());
+}
+}
+
+/* ************************************************************************* */
+Ordering Ordering::ColamdIncremental(const VariableIndex& variableIndex,
+    OrderingCache& cache) {
+  gttic(Ordering_COLAMDIncremental);
+
+  // When more than this fraction of the variables is affected, a local repair
+  // no longer pays off and degrades fill-in, so recompute from scratch.
+  static const double kRebuildFraction = 0.2;
+
+  const size_t nVars = variableIndex.size();
+
+  // Find the affected region: variables whose factor columns changed since
+  // the cached ordering was computed, including new variables.
+  KeySet affected, currentKeys;
+  for (auto key_factors: variableIndex) {
+    currentKeys.insert(currentKeys.end(), key_factors.first);
+    FastMap<Key, OrderingCache::Fingerprint>::const_iterator item =
+        cache.fingerprints_.find(key_factors.first);
+    if (item == cache.fingerprints_.end()
+        || item->second != columnFingerprint(key_factors.second))
+      affected.insert(key_factors.first);
+  }
+
+  Ordering result;
+  if (cache.empty() || affected.size() > kRebuildFraction * nVars) {
+    result = Ordering::Colamd(variableIndex);
+  } else if (affected.empty() && cache.fingerprints_.size() == nVars) {
+    // The graph is unchanged, reuse the cached ordering as is
+    return Ordering(cache.ordering_);
+  } else {
+    // Local repair: surviving unaffected variables keep their cached relative
+    // order, the affected region is reordered and appended at the end (where
+    // the most recently touched variables belong in incremental use).
+    gttic(Repair);
+    result.reserve(nVars);
+    for (Key key: cache.ordering_) {
+      if (affected.count(key) == 0 && currentKeys.count(key) > 0)
+        result.push_back(key);
+    }
+
+    if (affected.size() == 1) {
+      result.push_back(*affected.begin());
+    } else if (!affected.empty()) {
+      // Run COLAMD on the submatrix of factors involving the affected
+      // variables, remapping factor indices to compact row numbers
+      FastMap<size_t, int> factorRows;
+      size_t nEntries = 0;
+      for (Key key: affected) {
+        for(size_t factorIndex: variableIndex[key]) {
+          factorRows.insert(make_pair(factorIndex, 0));
+          ++nEntries;
+        }
+      }
+      int row = 0;
+      for (auto& factorRow: factorRows)
+        factorRow.second = row++;
+
+      const size_t nAffected = affected.size(), nRows = factorRows.size();
+      const size_t Alen = ccolamd_recommended((int) nEntries, (int) nRows,
+          (int) nAffected);
+      vector<int> A(Alen), p(nAffected + 1), cmember(nAffected, 0);
+      KeyVector keys;
+      keys.reserve(nAffected);
+      p[0] = 0;
+      int count = 0;
+      for (Key key: affected) {
+        for(size_t factorIndex: variableIndex[key])
+          A[count++] = factorRows.at(factorIndex);
+        p[keys.size() + 1] = count;
+        keys.push_back(key);
+      }
+
+      double knobs[CCOLAMD_KNOBS];
+      ccolamd_set_defaults(knobs);
+      knobs[CCOLAMD_DENSE_ROW] = -1;
+      knobs[CCOLAMD_DENSE_COL] = -1;
+      int stats[CCOLAMD_STATS];
+
+      int rv = ccolamd((int) nRows, (int) nAffected, (int) Alen, &A[0], &p[0],
+          knobs, stats, &cmember[0]);
+      if (rv != 1)
+        throw runtime_error(
+            (boost::format("ccolamd failed with return value %1%") % rv).str());
+
+      for (size_t j = 0; j < nAffected; ++j)
+        result.push_back(keys[p[j]]);
+    }
+  }
+
+  // Refresh the cache for the next call
+  cache.ordering_ = result;
+  cache.fingerprints_.clear();
+  for (auto key_factors: variableIndex)
+    cache.fingerprints_.insert(
+        make_pair(key_factors.first, columnFingerprint(key_factors.second)));
+
+  return result;
+}
+
 /* ************************************************************************* */
 Ordering Ordering::Metis(const MetisIndex& met) {
 #ifdef GTSAM_SUPPORT_NESTED_DISSECTION
@@ -31,6 +31,85 @@
 
 namespace gtsam {
 
+// Forward declaration
+class Ordering;
+
+/**
+ * Caches a previously computed COLAMD ordering together with a per-variable
+ * fingerprint of the VariableIndex it was computed from.  Passed to
+ * Ordering::ColamdIncremental, which repairs the cached ordering locally when
+ * the graph has only grown by a few factors, instead of recomputing the full
+ * ordering from scratch on every solve.
+ */
+class GTSAM_EXPORT OrderingCache {
+public:
+  /// Return true if no ordering has been cached yet
+  bool empty() const { return ordering_.empty() && fingerprints_.empty(); }
+
+  /// Invalidate the cache, forcing the next ColamdIncremental call to
+  /// recompute the full ordering
+  void clear() {
+    ordering_.clear();
+    fingerprints_.clear();
+  }
+
+private:
+  /// Cheap per-variable summary of its factor column: (number of factors,
+  /// highest factor index).  A changed fingerprint marks the variable as
+  /// affected since factors are only ever appended with increasing indices.
+  typedef std::pair<size_t, size_t> Fingerprint;
+
+  KeyVector ordering_; ///< The ordering computed by the last call
+  FastMap<Key, Fingerprint> fingerprints_; ///< Column fingerprints at that time
+
+  friend class Ordering;
+};
+
+/**
+ * Run-length-compressed version of the key-to-position map returned by
+ * Ordering::invert().  Symbol-generated keys come in long contiguous runs
+ * (x0..xN), and orderings visit long stretches of consecutive keys at
+ * consecutive positions; every such stretch compresses to a single
+ * (firstKey, firstPosition, length) triple, shrinking the map from one node
+ * per key to one entry per run.  Lookup is a binary search over the runs,
+ * so it stays cache-friendly even on million-variable orderings.
+ */
+class GTSAM_EXPORT OrderingIndex {
+public:
+  /// Create an empty index
+  OrderingIndex() : size_(0) {}
+
+  /// Compress the key-to-position map of the given ordering
+  explicit OrderingIndex(const Ordering& ordering);
+
+  /// Number of keys indexed
+  size_t size() const { return size_; }
+
+  /// Number of runs the ordering compressed to (size() in the worst case)
+  size_t nrRuns() const { return runs_.size(); }
+
+  /// Position of the key in the ordering; throws std::out_of_range if the
+  /// key does not appear
+  size_t at(Key key) const;
+
+  /// Whether the key appears in the ordering
+  bool contains(Key key) const;
+
+private:
+  /// A maximal stretch of consecutive keys at consecutive positions
+  struct Run {
+    Key firstKey;
+    size_t firstPosition;
+    size_t length;
+  };
+
+  std::vector<Run> runs_; ///< Sorted by firstKey for binary search
+  size_t size_; ///< Total number of keys indexed
+
+  /// The run that could contain the key, or nullptr
+  const Run* findRun(Key key) const;
+};
+
 class Ordering: public KeyVector {
 protected:
   typedef KeyVector Base;
@@ -70,7 +149,8 @@ public:
         boost::assign_detail::call_push_back<This>(*this))(key);
   }
 
-  /// Invert (not reverse) the ordering - returns a map from key to order position
+  /// Invert (not reverse) the ordering - returns a map from key to order
+  /// position.  See OrderingIndex for a run-length-compressed alternative.
   FastMap<Key, size_t> invert() const;
 
   /// @name Fill-reducing Orderings @{
@@ -172,6 +252,32 @@ public:
   static GTSAM_EXPORT Ordering ColamdConstrained(
       const VariableIndex& variableIndex, const FastMap<Key, int>& groups);
 
+  /// Compute a fill-reducing COLAMD ordering incrementally, reusing the
+  /// ordering stored in \c cache when possible.  On the first call (or after
+  /// OrderingCache::clear()) this is equivalent to Colamd and fills the cache.
+  /// On subsequent calls, variables whose factor columns are unchanged keep
+  /// their cached relative order, and only the affected region - variables
+  /// that gained factors, plus new variables - is reordered by COLAMD on its
+  /// factor submatrix and appended at the end.  When more than a fixed
+  /// fraction of the variables is affected, the full ordering is recomputed
+  /// instead, so fill-in quality cannot degrade indefinitely in streaming
+  /// use.  Prefer passing a maintained VariableIndex (e.g.
+  /// NonlinearFactorGraph::variableIndex()) to the overload below, since this
+  /// one rebuilds the index from the graph.
+  template<class FACTOR_GRAPH>
+  static Ordering ColamdIncremental(const FACTOR_GRAPH& graph,
+      OrderingCache& cache) {
+    if (graph.empty())
+      return Ordering();
+    else
+      return ColamdIncremental(VariableIndex(graph), cache);
+  }
+
+  /// Compute a fill-reducing COLAMD ordering incrementally from a
+  /// VariableIndex, see the factor graph overload above for details.
+  static GTSAM_EXPORT Ordering ColamdIncremental(
+      const VariableIndex& variableIndex, OrderingCache& cache);
+
   /// Return a natural Ordering. Typically used by iterative solvers
   template<class FACTOR_GRAPH>
   static Ordering Natural(const FACTOR_GRAPH &fg) {
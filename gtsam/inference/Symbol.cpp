@@ -56,8 +56,27 @@ bool Symbol::equals(const Symbol& expected, double tol) const {
   return (*this) == expected;
 }
 
+const std::size_t Symbol::kMaxChars;
+
+std::size_t Symbol::format(char* buffer) const {
+  char* p = buffer;
+  *p++ = static_cast<char>(c_);
+  // write the index digits backwards, then reverse them in place
+  char digits[20];
+  std::size_t n = 0;
+  std::uint64_t j = j_;
+  do {
+    digits[n++] = static_cast<char>('0' + j % 10);
+    j /= 10;
+  } while (j > 0);
+  while (n > 0)
+    *p++ = digits[--n];
+  return p - buffer;
+}
+
 Symbol::operator std::string() const {
-  return str(boost::format("%c%d") % c_ % j_);
+  char buffer[kMaxChars];
+  return std::string(buffer, format(buffer));
 }
 
 static Symbol make(gtsam::Key key) { return Symbol(key);}
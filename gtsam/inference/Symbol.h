@@ -21,6 +21,7 @@
 #include <gtsam/inference/Key.h>
 #include <gtsam/base/Testable.h>
 #include <boost/serialization/nvp.hpp>
+#include <cstddef>
 #include <cstdint>
 
 namespace gtsam {
@@ -80,6 +81,18 @@ public:
   /** Create a string from the key */
   operator std::string() const;
 
+  /** Maximum number of characters format() can write: the character plus up
+   * to 20 decimal digits for a 64-bit index (no terminating null) */
+  static const std::size_t kMaxChars = 21;
+
+  /**
+   * Write the "c<index>" representation into a caller-provided buffer of at
+   * least kMaxChars characters, without any heap allocation. Useful in
+   * logging hot paths where the std::string interfaces are too expensive.
+   * @return the number of characters written
+   */
+  std::size_t format(char* buffer) const;
+
   /** Comparison for use in maps */
   bool operator<(const Symbol& comp) const {
     return c_ < comp.c_ || (comp.c_ == c_ && j_ < comp.j_);
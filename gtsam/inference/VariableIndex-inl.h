@@ -80,6 +80,15 @@ void VariableIndex::remove(ITERATOR firstFactor, ITERATOR lastFactor,
   }
 }
 
+/* ************************************************************************* */
+template<class FG>
+void VariableIndex::applyDelta(const FG& addedFactors,
+    const FactorIndices& removedFactorSlots, const FG& removedFactors) {
+  gttic(VariableIndex_applyDelta);
+  remove(removedFactorSlots.begin(), removedFactorSlots.end(), removedFactors);
+  augment(addedFactors);
+}
+
 /* ************************************************************************* */
 template<typename ITERATOR>
 void VariableIndex::removeUnusedVariables(ITERATOR firstKey, ITERATOR lastKey) {
@@ -24,6 +24,8 @@
 #include <gtsam/dllexport.h>
 
 #include <boost/optional/optional.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 
 #include <cassert>
@@ -135,6 +137,18 @@ class GTSAM_EXPORT VariableIndex {
    */
   void augmentExistingFactor(const FactorIndex factorIndex, const KeySet & newKeys);
 
+  /**
+   * Apply a diff to the variable index: remove the entries of the factors in
+   * \c removedFactorSlots, whose symbolic contents must be supplied in
+   * \c removedFactors, then augment with \c addedFactors, which are assigned
+   * the next factor indices.  Equivalent to, but much cheaper than,
+   * rebuilding the index from scratch when only a few factors changed
+   * between solves.
+   */
+  template<class FG>
+  void applyDelta(const FG& addedFactors, const FactorIndices& removedFactorSlots,
+      const FG& removedFactors);
+
   /**
    * Remove entries corresponding to the specified factors. NOTE: We intentionally do not decrement
    * nFactors_ because the factor indices need to remain consistent.  Removing factors from a factor
@@ -183,6 +197,16 @@ protected:
   }
 
   /// @}
+
+private:
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(index_);
+    ar & BOOST_SERIALIZATION_NVP(nFactors_);
+    ar & BOOST_SERIALIZATION_NVP(nEntries_);
+  }
 };
 
 /// traits
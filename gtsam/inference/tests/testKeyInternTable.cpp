@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/*
+ * @file testKeyInternTable.cpp
+ * @author Frank Dellaert
+ * @date Aug 30, 2026
+ */
+
+#include <gtsam/inference/KeyInternTable.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+TEST(KeyInternTable, Intern) {
+  // Ids follow the sequence the table was built from, so an Ordering's table
+  // maps every key to its elimination position
+  Ordering ordering;
+  ordering.push_back(X(2));
+  ordering.push_back(L(1));
+  ordering.push_back(X(1));
+  const KeyInternTable table(ordering);
+  EXPECT_LONGS_EQUAL(3, table.size());
+  EXPECT_LONGS_EQUAL(0, table.intern(X(2)));
+  EXPECT_LONGS_EQUAL(1, table.intern(L(1)));
+  EXPECT_LONGS_EQUAL(2, table.intern(X(1)));
+
+  // The translation table goes back from dense id to the original key
+  EXPECT(table.keys()[1] == L(1));
+
+  // Unseen keys yield kNotInterned from tryIntern, and intern throws
+  EXPECT_LONGS_EQUAL(KeyInternTable::kNotInterned, table.tryIntern(X(3)));
+  CHECK_EXCEPTION(table.intern(X(3)), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(KeyInternTable, Empty) {
+  const KeyInternTable table;
+  EXPECT_LONGS_EQUAL(0, table.size());
+  EXPECT_LONGS_EQUAL(KeyInternTable::kNotInterned, table.tryIntern(X(1)));
+}
+
+/* ************************************************************************* */
+TEST(KeyInternTable, Duplicates) {
+  KeyVector keys;
+  keys.push_back(X(1));
+  keys.push_back(X(1));
+  CHECK_EXCEPTION(KeyInternTable table(keys), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
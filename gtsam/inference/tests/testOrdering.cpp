@@ -39,6 +39,40 @@ SymbolicFactorGraph symbolicChain() {
   return symbolicGraph;
 }
 }
+/* ************************************************************************* */
+TEST(Ordering, orderingIndex) {
+  using symbol_shorthand::L;
+  using symbol_shorthand::X;
+
+  // Two long symbol runs in natural order compress to two runs
+  Ordering ordering;
+  for (size_t i = 0; i < 100; ++i)
+    ordering.push_back(X(i));
+  for (size_t i = 0; i < 50; ++i)
+    ordering.push_back(L(i));
+  OrderingIndex index(ordering);
+  EXPECT_LONGS_EQUAL(150, index.size());
+  EXPECT_LONGS_EQUAL(2, index.nrRuns());
+
+  // Lookup agrees with the uncompressed map everywhere
+  const FastMap<Key, size_t> expected = ordering.invert();
+  for (const auto& key_pos : expected) {
+    CHECK(index.contains(key_pos.first));
+    EXPECT_LONGS_EQUAL(key_pos.second, index.at(key_pos.first));
+  }
+  EXPECT(!index.contains(X(100)));
+  CHECK_EXCEPTION(index.at(L(50)), std::out_of_range);
+
+  // An ordering without consecutive stretches still works, one run per key
+  Ordering scattered;
+  scattered += X(7), X(3), X(5), X(1);
+  OrderingIndex scatteredIndex(scattered);
+  EXPECT_LONGS_EQUAL(4, scatteredIndex.nrRuns());
+  for (const auto& key_pos : scattered.invert())
+    EXPECT_LONGS_EQUAL(key_pos.second, scatteredIndex.at(key_pos.first));
+  EXPECT(!scatteredIndex.contains(X(4)));
+}
+
 /* ************************************************************************* */
 TEST(Ordering, constrained_ordering) {
   // create graph with wanted variable set = 2, 4
@@ -90,6 +124,39 @@ TEST(Ordering, constrained_ordering) {
   }
 }
 
+/* ************************************************************************* */
+TEST(Ordering, colamd_incremental) {
+  // Use a long chain so that a one-factor change stays below the rebuild
+  // fraction and exercises the local repair path
+  SymbolicFactorGraph symbolicGraph;
+  for (size_t j = 0; j < 12; ++j)
+    symbolicGraph.push_factor(j, j + 1);
+  OrderingCache cache;
+
+  // The first call fills the cache and matches the batch ordering
+  Ordering initial = Ordering::ColamdIncremental(symbolicGraph, cache);
+  EXPECT(assert_equal(Ordering::Colamd(symbolicGraph), initial));
+
+  // An unchanged graph reuses the cached ordering as is
+  EXPECT(assert_equal(initial, Ordering::ColamdIncremental(symbolicGraph, cache)));
+
+  // Grow the chain by one factor and variable: only variables 12 and 13 are
+  // affected, so the untouched variables keep their cached relative order and
+  // the affected region is appended at the end
+  symbolicGraph.push_factor(12, 13);
+  Ordering repaired = Ordering::ColamdIncremental(symbolicGraph, cache);
+  LONGS_EQUAL(14, repaired.size());
+  for (size_t j = 0; j < 12; ++j)
+    EXPECT_LONGS_EQUAL(initial[j], repaired[j]);
+  EXPECT(repaired[12] + repaired[13] == 12 + 13);
+
+  // Clearing the cache forces a full recompute
+  cache.clear();
+  EXPECT(cache.empty());
+  EXPECT(assert_equal(Ordering::Colamd(symbolicGraph),
+                      Ordering::ColamdIncremental(symbolicGraph, cache)));
+}
+
 /* ************************************************************************* */
 TEST(Ordering, grouped_constrained_ordering) {
 
@@ -170,6 +237,33 @@ TEST(Ordering, csr_format_2) {
   EXPECT(adjExpected == mi.adj());
 }
 
+/* ************************************************************************* */
+TEST(Ordering, csr_format_incremental) {
+  // Augmenting an index with factors in two batches must produce the same
+  // CSR structure as building it from the full graph in one shot
+  SymbolicFactorGraph firstBatch, secondBatch, fullGraph;
+
+  firstBatch.push_factor(0);
+  firstBatch.push_factor(0, 1);
+  firstBatch.push_factor(1, 2);
+
+  secondBatch.push_factor(2, 3);
+  secondBatch.push_factor(3, 4);
+  secondBatch.push_factor(4, 1);
+
+  fullGraph.push_back(firstBatch);
+  fullGraph.push_back(secondBatch);
+
+  MetisIndex expected(fullGraph);
+
+  MetisIndex actual(firstBatch);
+  actual.augment(secondBatch);
+
+  EXPECT(expected.nValues() == actual.nValues());
+  EXPECT(expected.xadj() == actual.xadj());
+  EXPECT(expected.adj() == actual.adj());
+}
+
 /* ************************************************************************* */
 TEST(Ordering, csr_format_3) {
   SymbolicFactorGraph symbolicGraph;
@@ -41,6 +41,27 @@ TEST(Symbol, Formatting) {
   EXPECT("c3" == ss3.str());
 }
 
+/* ************************************************************************* */
+TEST(Symbol, FixedBufferFormat) {
+  char buffer[Symbol::kMaxChars];
+
+  Symbol symbol('c', 3);
+  EXPECT_LONGS_EQUAL(2, symbol.format(buffer));
+  EXPECT("c3" == string(buffer, 2));
+  EXPECT("c3" == (string)symbol);
+
+  // index 0 still prints a digit
+  Symbol zero('x', 0);
+  EXPECT_LONGS_EQUAL(2, zero.format(buffer));
+  EXPECT("x0" == string(buffer, 2));
+
+  // largest index that fits in a Key uses the full buffer
+  Symbol large('a', 72057594037927935ull); // 2^56 - 1
+  size_t n = large.format(buffer);
+  EXPECT("a72057594037927935" == string(buffer, n));
+  EXPECT((string)large == string(buffer, n));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -60,6 +60,7 @@ struct BinaryJacobianFactor: JacobianFactor {
                 "constrained noise model");
       BinaryJacobianFactor whitenedFactor(key1(), model->Whiten(getA(begin())),
           key2(), model->Whiten(getA(end())), model->whiten(getb()));
+      whitenedFactor.setActivationWeight(activationWeight());
       whitenedFactor.updateHessian(infoKeys, info);
     } else {
       // First build an array of slots
@@ -72,13 +73,16 @@ struct BinaryJacobianFactor: JacobianFactor {
       Eigen::Block<const Matrix, M, N2> A2(Ab, 0, N1);
       Eigen::Block<const Matrix, M, 1> b(Ab, 0, N1 + N2);
 
-      // We perform I += A'*A to the upper triangle
-      info->diagonalBlock(slot1).rankUpdate(A1.transpose());
-      info->updateOffDiagonalBlock(slot1, slot2, A1.transpose() * A2);
-      info->updateOffDiagonalBlock(slot1, slotB, A1.transpose() * b);
-      info->diagonalBlock(slot2).rankUpdate(A2.transpose());
-      info->updateOffDiagonalBlock(slot2, slotB, A2.transpose() * b);
-      info->updateDiagonalBlock(slotB, b.transpose() * b);
+      // We perform I += w * A'*A to the upper triangle
+      info->diagonalBlock(slot1).rankUpdate(A1.transpose(), activationWeight_);
+      info->updateOffDiagonalBlock(slot1, slot2,
+          activationWeight_ * (A1.transpose() * A2));
+      info->updateOffDiagonalBlock(slot1, slotB,
+          activationWeight_ * (A1.transpose() * b));
+      info->diagonalBlock(slot2).rankUpdate(A2.transpose(), activationWeight_);
+      info->updateOffDiagonalBlock(slot2, slotB,
+          activationWeight_ * (A2.transpose() * b));
+      info->updateDiagonalBlock(slotB, activationWeight_ * (b.transpose() * b));
     }
   }
 };
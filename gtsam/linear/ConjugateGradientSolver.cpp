@@ -33,7 +33,8 @@ void ConjugateGradientParameters::print(ostream &os) const {
         << "maxIter:       " << maxIterations_ << endl
         << "resetIter:     " << reset_ << endl
         << "eps_rel:       " << epsilon_rel_ << endl
-        << "eps_abs:       " << epsilon_abs_ << endl;
+        << "eps_abs:       " << epsilon_abs_ << endl
+        << "mixedPrec:     " << mixedPrecision_ << endl;
 }
 
 /*****************************************************************************/
@@ -21,6 +21,8 @@
 
 #include <gtsam/linear/IterativeSolver.h>
 
+#include <chrono>
+
 namespace gtsam {
 
 /**
@@ -37,6 +39,7 @@ public:
   size_t reset_;          ///< number of iterations before reset
   double epsilon_rel_;    ///< threshold for relative error decrease
   double epsilon_abs_;    ///< threshold for absolute error decrease
+  bool mixedPrecision_;   ///< float32 matvecs inside double iterative refinement
 
   /* Matrix Operation Kernel */
   enum BLASKernel {
@@ -45,16 +48,18 @@ public:
 
   ConjugateGradientParameters()
     : minIterations_(1), maxIterations_(500), reset_(501), epsilon_rel_(1e-3),
-      epsilon_abs_(1e-3), blas_kernel_(GTSAM) {}
+      epsilon_abs_(1e-3), mixedPrecision_(false), blas_kernel_(GTSAM) {}
 
   ConjugateGradientParameters(size_t minIterations, size_t maxIterations, size_t reset,
     double epsilon_rel, double epsilon_abs, BLASKernel blas)
     : minIterations_(minIterations), maxIterations_(maxIterations), reset_(reset),
-      epsilon_rel_(epsilon_rel), epsilon_abs_(epsilon_abs), blas_kernel_(blas) {}
+      epsilon_rel_(epsilon_rel), epsilon_abs_(epsilon_abs), mixedPrecision_(false),
+      blas_kernel_(blas) {}
 
   ConjugateGradientParameters(const ConjugateGradientParameters &p)
     : Base(p), minIterations_(p.minIterations_), maxIterations_(p.maxIterations_), reset_(p.reset_),
-               epsilon_rel_(p.epsilon_rel_), epsilon_abs_(p.epsilon_abs_), blas_kernel_(GTSAM) {}
+               epsilon_rel_(p.epsilon_rel_), epsilon_abs_(p.epsilon_abs_),
+               mixedPrecision_(p.mixedPrecision_), blas_kernel_(GTSAM) {}
 
   /* general interface */
   inline size_t minIterations() const { return minIterations_; }
@@ -63,6 +68,7 @@ public:
   inline double epsilon() const { return epsilon_rel_; }
   inline double epsilon_rel() const { return epsilon_rel_; }
   inline double epsilon_abs() const { return epsilon_abs_; }
+  inline bool mixedPrecision() const { return mixedPrecision_; }
 
   inline size_t getMinIterations() const { return minIterations_; }
   inline size_t getMaxIterations() const { return maxIterations_; }
@@ -70,6 +76,7 @@ public:
   inline double getEpsilon() const { return epsilon_rel_; }
   inline double getEpsilon_rel() const { return epsilon_rel_; }
   inline double getEpsilon_abs() const { return epsilon_abs_; }
+  inline bool getMixedPrecision() const { return mixedPrecision_; }
 
   inline void setMinIterations(size_t value) { minIterations_ = value; }
   inline void setMaxIterations(size_t value) { maxIterations_ = value; }
@@ -77,6 +84,7 @@ public:
   inline void setEpsilon(double value) { epsilon_rel_ = value; }
   inline void setEpsilon_rel(double value) { epsilon_rel_ = value; }
   inline void setEpsilon_abs(double value) { epsilon_abs_ = value; }
+  inline void setMixedPrecision(bool value) { mixedPrecision_ = value; }
 
 
   void print() const { Base::print(); }
@@ -122,27 +130,46 @@ V preconditionedConjugateGradient(const S &system, const V &initial,
              << ", ||r0||^2 = " << currentGamma
              << ", threshold = " << threshold << std::endl;
 
+  // Instrumentation: a few clock reads per iteration when a monitor is
+  // attached, nothing otherwise
+  IterativeSolverMonitor* monitor = parameters.monitor().get();
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point tic;
+
   size_t k;
   for ( k = 1 ; k <= iMaxIterations && (currentGamma > threshold || k <= iMinIterations) ; k++ ) {
 
+    double preconditionerTime = 0.0, matvecTime = 0.0;
     if ( k % iReset == 0 ) {
       system.residual(estimate, q1);                      /* q1 = b-Ax */
       system.leftPrecondition(q1, residual);              /* r = L^{-1} (b-Ax) */
       system.rightPrecondition(residual, direction);      /* p = L^{-T} r */
       currentGamma = system.dot(residual, residual);
     }
+    if (monitor) tic = Clock::now();
     system.multiply(direction, q1);                       /* q1 = A p */
+    if (monitor)
+      matvecTime += std::chrono::duration<double>(Clock::now() - tic).count();
     alpha = currentGamma / system.dot(direction, q1);     /* alpha = gamma / (p' A p) */
     system.axpy(alpha, direction, estimate);              /* estimate += alpha * p */
+    if (monitor) tic = Clock::now();
     system.leftPrecondition(q1, q2);                      /* q2 = L^{-1} * q1 */
+    if (monitor)
+      preconditionerTime += std::chrono::duration<double>(Clock::now() - tic).count();
     system.axpy(-alpha, q2, residual);                    /* r -= alpha * q2 */
     prevGamma = currentGamma;
     currentGamma = system.dot(residual, residual);        /* gamma = |r|^2 */
     beta = currentGamma / prevGamma;
+    if (monitor) tic = Clock::now();
     system.rightPrecondition(residual, q1);               /* q1 = L^{-T} r */
+    if (monitor)
+      preconditionerTime += std::chrono::duration<double>(Clock::now() - tic).count();
     system.scal(beta, direction);
     system.axpy(1.0, q1, direction);                      /* p = q1 + beta * p */
 
+    if (monitor)
+      monitor->record(k, currentGamma, preconditionerTime, matvecTime);
+
     if (parameters.verbosity() >= ConjugateGradientParameters::ERROR )
        std::cout << "[PCG] k = " << k
                  << ", alpha = " << alpha
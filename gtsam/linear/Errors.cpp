@@ -30,6 +30,7 @@ Errors::Errors(){}
 
 /* ************************************************************************* */
 Errors::Errors(const VectorValues& V) {
+  reserve(V.size());
   for(const Vector& e: V | boost::adaptors::map_values) {
     push_back(e);
   }
@@ -58,36 +59,37 @@ bool Errors::equals(const Errors& expected, double tol) const {
 
 /* ************************************************************************* */
 Errors Errors::operator+(const Errors& b) const {
+  const size_t m = size();
 #ifndef NDEBUG
-  size_t m = size();
   if (b.size()!=m)
     throw(std::invalid_argument("Errors::operator+: incompatible sizes"));
 #endif
   Errors result;
-  Errors::const_iterator it = b.begin();
-    for(const Vector& ai: *this)
-    result.push_back(ai + *(it++));
+  result.reserve(m);
+  for(size_t i = 0; i < m; i++)
+    result.push_back((*this)[i] + b[i]);
   return result;
 }
 
 
 /* ************************************************************************* */
 Errors Errors::operator-(const Errors& b) const {
+  const size_t m = size();
 #ifndef NDEBUG
-  size_t m = size();
   if (b.size()!=m)
     throw(std::invalid_argument("Errors::operator-: incompatible sizes"));
 #endif
   Errors result;
-  Errors::const_iterator it = b.begin();
-  for(const Vector& ai: *this)
-    result.push_back(ai - *(it++));
+  result.reserve(m);
+  for(size_t i = 0; i < m; i++)
+    result.push_back((*this)[i] - b[i]);
   return result;
 }
 
 /* ************************************************************************* */
 Errors Errors::operator-() const {
   Errors result;
+  result.reserve(size());
   for(const Vector& ai: *this)
     result.push_back(-ai);
   return result;
@@ -97,24 +99,23 @@ Errors Errors::operator-() const {
 
 /* ************************************************************************* */
 double dot(const Errors& a, const Errors& b) {
+  const size_t m = a.size();
 #ifndef NDEBUG
-  size_t m = a.size();
   if (b.size()!=m)
     throw(std::invalid_argument("Errors::dot: incompatible sizes"));
 #endif
   double result = 0.0;
-  Errors::const_iterator it = b.begin();
-  for(const Vector& ai: a)
-    result += gtsam::dot(ai, *(it++));
+  for(size_t i = 0; i < m; i++)
+    result += a[i].dot(b[i]);
   return result;
 }
 
 /* ************************************************************************* */
 template<>
 void axpy<Errors,Errors>(double alpha, const Errors& x, Errors& y) {
-  Errors::const_iterator it = x.begin();
-  for(Vector& yi: y)
-    axpy(alpha,*(it++),yi);
+  const size_t m = y.size();
+  for(size_t i = 0; i < m; i++)
+    y[i] += alpha * x[i];
 }
 
 /* ************************************************************************* */
@@ -19,7 +19,7 @@
 
 #pragma once
 
-#include <gtsam/base/FastList.h>
+#include <gtsam/base/FastVector.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/Testable.h>
 
@@ -30,8 +30,12 @@ namespace gtsam {
   // Forward declarations
   class VectorValues;
 
-  /** vector of errors */
-  class Errors : public FastList<Vector> {
+  /**
+   * Vector of errors. Stored contiguously so that the iterative solvers,
+   * which traverse all error vectors once per matrix-vector product, walk a
+   * flat array of per-factor vectors instead of chasing list nodes.
+   */
+  class Errors : public FastVector<Vector> {
 
   public:
 
@@ -0,0 +1,142 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FlatVectorValues.cpp
+ * @brief   A contiguous counterpart to VectorValues for bulk arithmetic
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/linear/FlatVectorValues.h>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+FlatVectorValues::FlatVectorValues(const VectorValues& values) {
+  // Lay the variables out in key order, which is deterministic regardless of
+  // the iteration order of the underlying (possibly unordered) map.
+  scatter_.reserve(values.size());
+  for (const VectorValues::value_type& key_value : values)
+    scatter_.add(key_value.first, key_value.second.size());
+  std::sort(scatter_.begin(), scatter_.end());
+  initialize(values);
+}
+
+/* ************************************************************************* */
+FlatVectorValues::FlatVectorValues(const VectorValues& values,
+                                   const Scatter& scatter)
+    : scatter_(scatter) {
+  if (values.size() != scatter.size())
+    throw invalid_argument(
+        "FlatVectorValues: Scatter does not cover exactly the variables in "
+        "the VectorValues");
+  initialize(values);
+}
+
+/* ************************************************************************* */
+void FlatVectorValues::initialize(const VectorValues& values) {
+  // Compute the offset of every slot and the key-to-slot table
+  offsets_.reserve(scatter_.size());
+  DenseIndex offset = 0;
+  for (size_t slot = 0; slot < scatter_.size(); ++slot) {
+    const SlotEntry& entry = scatter_[slot];
+    slots_[entry.key] = slot;
+    offsets_.push_back(offset);
+    offset += entry.dimension;
+  }
+  if (slots_.size() != scatter_.size())
+    throw invalid_argument("FlatVectorValues: duplicate key in Scatter");
+
+  // Gather the values into the contiguous storage
+  values_.resize(offset);
+  for (size_t slot = 0; slot < scatter_.size(); ++slot) {
+    const SlotEntry& entry = scatter_[slot];
+    const Vector& value = values.at(entry.key);
+    if (size_t(value.size()) != entry.dimension)
+      throw invalid_argument(
+          "FlatVectorValues: variable dimension does not match the Scatter");
+    values_.segment(offsets_[slot], entry.dimension) = value;
+  }
+}
+
+/* ************************************************************************* */
+VectorValues FlatVectorValues::vectorValues() const {
+  return VectorValues(values_, scatter_);
+}
+
+/* ************************************************************************* */
+bool FlatVectorValues::hasSameStructure(const FlatVectorValues& other) const {
+  if (scatter_.size() != other.scatter_.size()) return false;
+  for (size_t slot = 0; slot < scatter_.size(); ++slot) {
+    if (scatter_[slot].key != other.scatter_[slot].key ||
+        scatter_[slot].dimension != other.scatter_[slot].dimension)
+      return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+double FlatVectorValues::dot(const FlatVectorValues& other) const {
+  if (!hasSameStructure(other))
+    throw invalid_argument(
+        "FlatVectorValues::dot called with a different vector layout");
+  return values_.dot(other.values_);
+}
+
+/* ************************************************************************* */
+void FlatVectorValues::axpy(double alpha, const FlatVectorValues& x) {
+  if (!hasSameStructure(x))
+    throw invalid_argument(
+        "FlatVectorValues::axpy called with a different vector layout");
+  values_ += alpha * x.values_;
+}
+
+/* ************************************************************************* */
+FlatVectorValues& FlatVectorValues::operator+=(const FlatVectorValues& other) {
+  if (!hasSameStructure(other))
+    throw invalid_argument(
+        "FlatVectorValues::operator+= called with a different vector layout");
+  values_ += other.values_;
+  return *this;
+}
+
+/* ************************************************************************* */
+FlatVectorValues& FlatVectorValues::operator-=(const FlatVectorValues& other) {
+  if (!hasSameStructure(other))
+    throw invalid_argument(
+        "FlatVectorValues::operator-= called with a different vector layout");
+  values_ -= other.values_;
+  return *this;
+}
+
+/* ************************************************************************* */
+void FlatVectorValues::print(const string& str,
+                             const KeyFormatter& formatter) const {
+  cout << str << ": " << size() << " elements\n";
+  for (size_t slot = 0; slot < scatter_.size(); ++slot)
+    cout << "  " << formatter(scatter_[slot].key) << ": "
+         << atSlot(slot).transpose() << "\n";
+  cout.flush();
+}
+
+/* ************************************************************************* */
+bool FlatVectorValues::equals(const FlatVectorValues& other, double tol) const {
+  return hasSameStructure(other) &&
+         equal_with_abs_tol(values_, other.values_, tol);
+}
+
+}  // namespace gtsam
@@ -0,0 +1,149 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FlatVectorValues.h
+ * @brief   A contiguous counterpart to VectorValues for bulk arithmetic
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/Scatter.h>
+#include <gtsam/base/FastMap.h>
+
+namespace gtsam {
+
+/**
+ * A flat counterpart to VectorValues: the values of all variables live in one
+ * contiguous Vector, together with a key-to-offset table describing the
+ * layout (a Scatter).  Whole-vector operations such as axpy, dot and scaling
+ * run as single vectorized sweeps instead of walking a map of individually
+ * allocated vectors, and per-key access hands out zero-copy views into the
+ * flat storage.  Access by slot index is O(1); access by key goes through the
+ * offset table.
+ *
+ * This is intended for inner loops that repeatedly combine vectors of
+ * identical structure (e.g. blending trust-region points), with conversion to
+ * and from VectorValues at the boundary.  All binary operations require both
+ * operands to share the same layout.
+ *
+ * @addtogroup linear
+ */
+class GTSAM_EXPORT FlatVectorValues {
+ public:
+  /// Default constructor creates an empty FlatVectorValues
+  FlatVectorValues() {}
+
+  /// Flatten the given VectorValues, laying the variables out in key order
+  explicit FlatVectorValues(const VectorValues& values);
+
+  /// Flatten the given VectorValues using the layout of the given Scatter,
+  /// which must cover exactly the variables in \c values
+  FlatVectorValues(const VectorValues& values, const Scatter& scatter);
+
+  /// @name Access
+  /// @{
+
+  /// Number of variables
+  size_t size() const { return scatter_.size(); }
+
+  /// Total dimensionality of all variables
+  DenseIndex dim() const { return values_.size(); }
+
+  /// The contiguous storage for all variables
+  const Vector& flat() const { return values_; }
+
+  /// The contiguous storage for all variables (writeable)
+  Vector& flat() { return values_; }
+
+  /// The layout of the variables in the flat storage
+  const Scatter& scatter() const { return scatter_; }
+
+  /// Zero-copy view of the variable in the given slot, O(1)
+  SubVector atSlot(size_t slot) {
+    return values_.segment(offsets_[slot], scatter_[slot].dimension);
+  }
+
+  /// Zero-copy const view of the variable in the given slot, O(1)
+  ConstSubVector atSlot(size_t slot) const {
+    return values_.segment(offsets_[slot], scatter_[slot].dimension);
+  }
+
+  /// Zero-copy view of the variable with the given key
+  SubVector at(Key j) { return atSlot(slots_.at(j)); }
+
+  /// Zero-copy const view of the variable with the given key
+  ConstSubVector at(Key j) const { return atSlot(slots_.at(j)); }
+
+  /// Convert back to a VectorValues
+  VectorValues vectorValues() const;
+
+  /// Check whether the other FlatVectorValues has an identical layout
+  bool hasSameStructure(const FlatVectorValues& other) const;
+
+  /// @}
+  /// @name Vectorized arithmetic
+  /// @{
+
+  /// Dot product, requires identical layout
+  double dot(const FlatVectorValues& other) const;
+
+  /// Squared vector norm over all variables
+  double squaredNorm() const { return values_.squaredNorm(); }
+
+  /// Vector norm over all variables
+  double norm() const { return values_.norm(); }
+
+  /// this += alpha * x, requires identical layout
+  void axpy(double alpha, const FlatVectorValues& x);
+
+  /// Element-wise addition, requires identical layout
+  FlatVectorValues& operator+=(const FlatVectorValues& other);
+
+  /// Element-wise subtraction, requires identical layout
+  FlatVectorValues& operator-=(const FlatVectorValues& other);
+
+  /// Scale all variables in place
+  FlatVectorValues& operator*=(double alpha) {
+    values_ *= alpha;
+    return *this;
+  }
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /// print required by Testable
+  void print(const std::string& str = "FlatVectorValues",
+             const KeyFormatter& formatter = DefaultKeyFormatter) const;
+
+  /// equals required by Testable: same layout and values within tolerance
+  bool equals(const FlatVectorValues& other, double tol = 1e-9) const;
+
+  /// @}
+
+ private:
+  /// Shared part of the constructors: compute offsets and the key table
+  void initialize(const VectorValues& values);
+
+  Vector values_;                       ///< Contiguous storage
+  Scatter scatter_;                     ///< Key and dimension per slot
+  FastVector<DenseIndex> offsets_;      ///< Offset of each slot in values_
+  FastMap<Key, size_t> slots_;          ///< Key to slot index
+};
+
+/// traits
+template <>
+struct traits<FlatVectorValues> : public Testable<FlatVectorValues> {};
+
+}  // namespace gtsam
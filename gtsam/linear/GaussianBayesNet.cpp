@@ -22,6 +22,11 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 using namespace std;
 using namespace gtsam;
 
@@ -47,6 +52,50 @@ namespace gtsam {
   VectorValues GaussianBayesNet::optimize(
       const VectorValues& solutionForMissing) const {
     VectorValues soln(solutionForMissing); // possibly empty
+#ifdef GTSAM_USE_TBB
+    // Level-scheduled parallel backsubstitution: a conditional can be solved
+    // as soon as the conditionals producing its parents are solved, so we
+    // group the conditionals into dependency levels and solve each level in
+    // parallel.  Conditionals from independent subtrees of the elimination
+    // tree land in the same level and run concurrently; on a chain every
+    // level has one conditional and this degenerates to the serial sweep.
+    const size_t n = size();
+
+    // Which conditional produces each frontal variable
+    FastMap<Key, size_t> producer;
+    for (size_t i = 0; i < n; ++i) {
+      if (!at(i)) continue;
+      for (Key frontal: at(i)->frontals())
+        producer.emplace(frontal, i);
+    }
+
+    // Dependency level of each conditional, walking in solve order (parents
+    // first, i.e. from the back).  Parents without a producer are supplied by
+    // solutionForMissing and impose no ordering.
+    FastVector<size_t> level(n, 0);
+    FastVector<FastVector<size_t> > levels;
+    for (size_t i = n; i > 0; --i) {
+      const size_t index = i - 1;
+      if (!at(index)) continue;
+      for (Key parent: at(index)->parents()) {
+        const auto it = producer.find(parent);
+        if (it != producer.end())
+          level[index] = std::max(level[index], level[it->second] + 1);
+      }
+      if (level[index] >= levels.size()) levels.resize(level[index] + 1);
+      levels[level[index]].push_back(index);
+    }
+
+    // Solve level by level; inserts into the ConcurrentMap-backed soln are
+    // safe alongside the concurrent reads of already-solved parents.
+    for (const FastVector<size_t>& currentLevel: levels) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, currentLevel.size()),
+          [this, &currentLevel, &soln](const tbb::blocked_range<size_t>& range) {
+            for (size_t j = range.begin(); j != range.end(); ++j)
+              soln.insert(at(currentLevel[j])->solve(soln));
+          });
+    }
+#else
     // (R*x)./sigmas = y by solving x=inv(R)*(y.*sigmas)
     /** solve each node in turn in topological sort order (parents first)*/
     for (auto cg: boost::adaptors::reverse(*this)) {
@@ -54,6 +103,7 @@ namespace gtsam {
       // (Rii*xi + R_i*x(i+1:))./si = yi <-> xi = inv(Rii)*(yi.*si - R_i*x(i+1:))
       soln.insert(cg->solve(soln));
     }
+#endif
     return soln;
   }
 
@@ -91,6 +141,19 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  FastMap<Key, Matrix> GaussianBayesNet::backSubstitute(
+      const FastMap<Key, Matrix>& rhs) const
+  {
+    FastMap<Key, Matrix> result;
+    // As in the vector overload, result doubles as the parents argument
+    // while it is filled in from the last conditional backwards
+    for (auto cg: boost::adaptors::reverse(*this)) {
+      FastMap<Key, Matrix> frontals = cg->solveOtherRHS(result, rhs);
+      result.insert(frontals.begin(), frontals.end());
+    }
+    return result;
+  }
 
   /* ************************************************************************* */
   // gy=inv(L)*gx by solving L*gy=gx.
@@ -169,6 +169,16 @@ namespace gtsam {
      */
     VectorValues backSubstitute(const VectorValues& gx) const;
 
+    /**
+     * Multi-RHS backsubstitution: carries k right-hand sides through the one
+     * factorization held by this Bayes net.  Every entry of \c rhs is a
+     * (dimension x k) matrix whose columns are the k right-hand sides -
+     * covariance columns or sensitivity probes, say - and column j of the
+     * result equals backSubstitute() of column j, at the cost of a single
+     * sweep with matrix-valued triangular solves.
+     */
+    FastMap<Key, Matrix> backSubstitute(const FastMap<Key, Matrix>& rhs) const;
+
     /**
      * Transpose backsubstitute with a different RHS vector than the one stored in this BayesNet.
      * gy=inv(L)*gx by solving L*gy=gx.
@@ -58,6 +58,38 @@ namespace gtsam {
     return internal::linearAlgorithms::optimizeBayesTree(*this);
   }
 
+  /* ************************************************************************* */
+  VectorValues GaussianBayesTree::optimize(const KeyVector& keys) const
+  {
+    return internal::linearAlgorithms::optimizeBayesTreeSelective(*this, keys);
+  }
+
+  /* ************************************************************************* */
+  namespace {
+  size_t cliqueMemoryUsage(const GaussianBayesTreeClique::shared_ptr& clique) {
+    size_t result = sizeof(GaussianBayesTreeClique)
+        + clique->children.capacity() * sizeof(GaussianBayesTreeClique::shared_ptr);
+    if (clique->conditional())
+      result += clique->conditional()->memoryUsage();
+    if (clique->cachedSeparatorMarginal())
+      result += clique->cachedSeparatorMarginal()->memoryUsage();
+    for (const GaussianBayesTreeClique::shared_ptr& child: clique->children)
+      result += cliqueMemoryUsage(child);
+    return result;
+  }
+  }
+
+  /* ************************************************************************* */
+  size_t GaussianBayesTree::memoryUsage() const
+  {
+    // Each nodes_ entry maps one key to its clique through a tree node
+    size_t result = sizeof(GaussianBayesTree)
+        + nodes().size() * (sizeof(Key) + sizeof(sharedClique) + 4 * sizeof(void*));
+    for (const sharedClique& root: roots())
+      result += cliqueMemoryUsage(root);
+    return result;
+  }
+
   /* ************************************************************************* */
   VectorValues GaussianBayesTree::optimizeGradientSearch() const
   {
@@ -65,6 +65,18 @@ namespace gtsam {
     /** Recursively optimize the BayesTree to produce a vector solution. */
     VectorValues optimize() const;
 
+    /** Back-substitute only for the requested variables, walking just the path from each key's
+     * clique to the root instead of the whole tree.  Returns a partial VectorValues containing
+     * at least the requested keys (plus any other frontal variables of the visited cliques) -
+     * much cheaper than optimize() when a few variables are read out of a large tree.
+     * @throw std::out_of_range if a requested key is not in the tree */
+    VectorValues optimize(const KeyVector& keys) const;
+
+    /** The number of bytes of memory occupied by this tree: the clique
+     * objects, their conditionals' matrix storage, any cached separator
+     * marginals, and the key-to-clique index (\f$ O(n) \f$). */
+    size_t memoryUsage() const;
+
     /**
      * Optimize along the gradient direction, with a closed-form computation to perform the line
      * search.  The gradient is computed about \f$ \delta x=0 \f$.
@@ -169,6 +169,52 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  FastMap<Key, Matrix> GaussianConditional::solveOtherRHS(
+    const FastMap<Key, Matrix>& parents, const FastMap<Key, Matrix>& rhs) const {
+    // Number of simultaneous right-hand sides, from the first frontal block
+    const DenseIndex k = rhs.at(*beginFrontals()).cols();
+
+    // Concatenate the solved parent blocks, as the vector overload does
+    DenseIndex parentDim = 0;
+    for (const_iterator parent = beginParents(); parent != endParents(); ++parent)
+      parentDim += getDim(parent);
+    Matrix xS(parentDim, k);
+    DenseIndex rowS = 0;
+    for (const_iterator parent = beginParents(); parent != endParents(); ++parent) {
+      xS.middleRows(rowS, getDim(parent)) = parents.at(*parent);
+      rowS += getDim(parent);
+    }
+
+    // Stack the frontal right-hand side blocks and subtract S xS
+    DenseIndex frontalDim = 0;
+    for (const_iterator frontal = beginFrontals(); frontal != endFrontals(); ++frontal)
+      frontalDim += getDim(frontal);
+    Matrix rhsR(frontalDim, k);
+    DenseIndex rowR = 0;
+    for (const_iterator frontal = beginFrontals(); frontal != endFrontals(); ++frontal) {
+      rhsR.middleRows(rowR, getDim(frontal)) = rhs.at(*frontal);
+      rowR += getDim(frontal);
+    }
+    rhsR -= S() * xS;
+
+    // One triangular solve covers all k columns
+    Matrix soln = R().triangularView<Eigen::Upper>().solve(rhsR);
+
+    // Scale by sigmas
+    if (model_)
+      soln.array().colwise() *= model_->sigmas().array();
+
+    // Split the solution into per-variable blocks
+    FastMap<Key, Matrix> result;
+    DenseIndex rowX = 0;
+    for (const_iterator frontal = beginFrontals(); frontal != endFrontals(); ++frontal) {
+      result.emplace(*frontal, soln.middleRows(rowX, getDim(frontal)));
+      rowX += getDim(frontal);
+    }
+    return result;
+  }
+
   /* ************************************************************************* */
   void GaussianConditional::solveTransposeInPlace(VectorValues& gy) const {
     Vector frontalVec = gy.vector(KeyVector(beginFrontals(), endFrontals()));
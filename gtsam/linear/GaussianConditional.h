@@ -122,6 +122,17 @@ namespace gtsam {
 
     VectorValues solveOtherRHS(const VectorValues& parents, const VectorValues& rhs) const;
 
+    /**
+     * Multi-RHS variant of solveOtherRHS: solves the frontal variables for k
+     * right-hand sides simultaneously, with a single triangular solve against
+     * the factorization.  Every entry of \c parents and \c rhs is a
+     * (dimension x k) matrix whose columns are the k right-hand sides, and
+     * the returned map holds a (dimension x k) solution block per frontal
+     * variable.
+     */
+    FastMap<Key, Matrix> solveOtherRHS(const FastMap<Key, Matrix>& parents,
+        const FastMap<Key, Matrix>& rhs) const;
+
     /** Performs transpose backsubstition in place on values */
     void solveTransposeInPlace(VectorValues& gy) const;
 
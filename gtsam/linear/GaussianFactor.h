@@ -24,6 +24,8 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/Testable.h>
 
+#include <stdexcept>
+
 namespace gtsam {
 
   // Forward declarations
@@ -33,7 +35,8 @@ namespace gtsam {
 
   /**
    * An abstract virtual base class for JacobianFactor and HessianFactor. A GaussianFactor has a
-   * quadratic error function. GaussianFactor is non-mutable (all methods const!). The factor value
+   * quadratic error function. GaussianFactor is non-mutable (all methods const!), except for the
+   * scalar activation weight, which may be changed between iterations. The factor value
    * is exp(-0.5*||Ax-b||^2) */
   class GTSAM_EXPORT GaussianFactor : public Factor
   {
@@ -43,12 +46,12 @@ namespace gtsam {
     typedef Factor Base; ///< Our base class
 
     /** Default constructor creates empty factor */
-    GaussianFactor() {}
+    GaussianFactor() : activationWeight_(1.0) {}
 
     /** Construct from container of keys.  This constructor is used internally from derived factor
      *  constructors, either from a container of keys or from a boost::assign::list_of. */
     template<typename CONTAINER>
-    GaussianFactor(const CONTAINER& keys) : Base(keys) {}
+    GaussianFactor(const CONTAINER& keys) : Base(keys), activationWeight_(1.0) {}
 
     /** Destructor */
     virtual ~GaussianFactor() {}
@@ -114,6 +117,15 @@ namespace gtsam {
     /** Clone a factor (make a deep copy) */
     virtual GaussianFactor::shared_ptr clone() const = 0;
 
+    /** The number of bytes of memory occupied by this factor, including owned
+     * matrix storage.  Shared noise models are excluded, since they are
+     * typically interned across many factors.  The default reports only the
+     * key storage; JacobianFactor and HessianFactor override it to include
+     * their matrices. */
+    virtual size_t memoryUsage() const {
+      return sizeof(GaussianFactor) + keys_.capacity() * sizeof(Key);
+    }
+
     /** Test whether the factor is empty */
     virtual bool empty() const = 0;
 
@@ -144,12 +156,40 @@ namespace gtsam {
     /// Gradient wrt a key at any values
     virtual Vector gradient(Key key, const VectorValues& x) const = 0;
 
+    /// @name Activation weight
+    /// @{
+
+    /** The scalar activation weight of this factor, 1.0 by default.  The
+     * weight scales the factor's information contribution during elimination
+     * (updateHessian) as well as its error, so down-weighting a factor to w
+     * is equivalent to scaling its noise model sigmas by 1/sqrt(w), and a
+     * weight of zero deactivates the factor entirely.  Changing weights does
+     * not require rebuilding the graph, which makes graduated non-convexity
+     * sweeps cheap: mutate the weights between iterations and re-eliminate.
+     * The weight is transient tuning state and is not serialized. */
+    double activationWeight() const { return activationWeight_; }
+
+    /** Set the activation weight, see activationWeight().
+     * Throws std::invalid_argument for negative weights. */
+    void setActivationWeight(double weight) {
+      if (weight < 0.0)
+        throw std::invalid_argument(
+            "GaussianFactor::setActivationWeight: weight must be non-negative");
+      activationWeight_ = weight;
+    }
+
+    /// @}
+
     // Determine position of a given key
     template <typename CONTAINER>
     static DenseIndex Slot(const CONTAINER& keys, Key key) {
       return std::find(keys.begin(), keys.end(), key) - keys.begin();
     }
 
+  protected:
+    /// Scales this factor's contribution to elimination and error, default 1.0
+    double activationWeight_;
+
   private:
     /** Serialization function */
     friend class boost::serialization::access;
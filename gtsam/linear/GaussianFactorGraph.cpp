@@ -20,16 +20,32 @@
 
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianEliminationTree.h>
 #include <gtsam/linear/GaussianJunctionTree.h>
 #include <gtsam/linear/HessianFactor.h>
 #include <gtsam/inference/FactorGraph-inst.h>
 #include <gtsam/inference/EliminateableFactorGraph-inst.h>
+#include <gtsam/inference/KeyInternTable.h>
+#include <gtsam/inference/inferenceExceptions.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/cholesky.h>
 
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <typeinfo>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_reduce.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 using namespace std;
 using namespace gtsam;
 
@@ -54,6 +70,15 @@ namespace gtsam {
     return keys;
   }
 
+  /* ************************************************************************* */
+  size_t GaussianFactorGraph::memoryUsage() const {
+    size_t result = sizeof(GaussianFactorGraph) + factors_.capacity() * sizeof(sharedFactor);
+    for (const sharedFactor& factor: *this)
+      if (factor)
+        result += factor->memoryUsage();
+    return result;
+  }
+
   /* ************************************************************************* */
   std::map<Key, size_t> GaussianFactorGraph::getKeyDimMap() const {
     map<Key, size_t> spec;
@@ -68,6 +93,18 @@ namespace gtsam {
     return spec;
   }
 
+  /* ************************************************************************* */
+  void GaussianFactorGraph::setActivationWeights(
+      const std::vector<double>& weights) {
+    if (weights.size() != size())
+      throw std::invalid_argument(
+          "GaussianFactorGraph::setActivationWeights: one weight per factor "
+          "is required");
+    for (size_t i = 0; i < size(); ++i)
+      if (at(i))
+        at(i)->setActivationWeight(weights[i]);
+  }
+
   /* ************************************************************************* */
   GaussianFactorGraph::shared_ptr GaussianFactorGraph::cloneToPtr() const {
     gtsam::GaussianFactorGraph::shared_ptr result(new GaussianFactorGraph());
@@ -114,13 +151,19 @@ namespace gtsam {
       }
     }
 
-    // Compute first scalar column of each variable
+    // Compute first scalar column of each variable, indexed by interned id so
+    // the per-entry lookups below are array accesses after a flat search
     size_t currentColIndex = 0;
-    KeySizeMap columnIndices = dims;
+    KeyVector orderedKeys;
+    orderedKeys.reserve(dims.size());
+    std::vector<size_t> columnStart;
+    columnStart.reserve(dims.size());
     for (const KeySizeMap::value_type& col : dims) {
-      columnIndices[col.first] = currentColIndex;
-      currentColIndex += dims[col.first];
+      orderedKeys.push_back(col.first);
+      columnStart.push_back(currentColIndex);
+      currentColIndex += col.second;
     }
+    const KeyInternTable columnIndices(orderedKeys);
 
     // Iterate over all factors, adding sparse scalar entries
     typedef boost::tuple<size_t, size_t, double> triplet;
@@ -149,7 +192,7 @@ namespace gtsam {
           key < whitened.end(); ++key) {
         JacobianFactor::constABlock whitenedA = whitened.getA(key);
         // find first column index for this key
-        size_t column_start = columnIndices[*key];
+        size_t column_start = columnStart[columnIndices.intern(*key)];
         for (size_t i = 0; i < (size_t) whitenedA.rows(); i++)
           for (size_t j = 0; j < (size_t) whitenedA.cols(); j++) {
             double s = whitenedA(i, j);
@@ -169,6 +212,192 @@ namespace gtsam {
     return vector<triplet>(entries.begin(), entries.end());
   }
 
+  /* ************************************************************************* */
+  // Shared by the CSR exporters below: scalar column layout over sorted keys
+  static std::map<Key, size_t> columnLayout(const GaussianFactorGraph& gfg,
+      size_t* totalCols) {
+    std::map<Key, size_t> dims;
+    for (const GaussianFactor::shared_ptr& factor : gfg) {
+      if (!factor) continue;
+      for (GaussianFactor::const_iterator key = factor->begin();
+          key != factor->end(); ++key)
+        dims[*key] = factor->getDim(key);
+    }
+    size_t currentColIndex = 0;
+    std::map<Key, size_t> columnIndices = dims;
+    for (const std::map<Key, size_t>::value_type& col : dims) {
+      columnIndices[col.first] = currentColIndex;
+      currentColIndex += dims[col.first];
+    }
+    *totalCols = currentColIndex;
+    return columnIndices;
+  }
+
+  /* ************************************************************************* */
+  SparseCsrMatrix GaussianFactorGraph::sparseJacobianCsr() const {
+    size_t totalCols = 0;
+    const std::map<Key, size_t> columnIndices = columnLayout(*this, &totalCols);
+
+    SparseCsrMatrix csr;
+    csr.cols = totalCols;
+    csr.rowPointers.push_back(0);
+    std::vector<double> rhs;
+
+    for (const sharedFactor& factor : *this) {
+      if (!static_cast<bool>(factor)) continue;
+
+      // Convert to JacobianFactor if necessary, as in sparseJacobian()
+      JacobianFactor::shared_ptr jacobianFactor(
+          boost::dynamic_pointer_cast<JacobianFactor>(factor));
+      if (!jacobianFactor) {
+        HessianFactor::shared_ptr hessian(
+            boost::dynamic_pointer_cast<HessianFactor>(factor));
+        if (hessian)
+          jacobianFactor.reset(new JacobianFactor(*hessian));
+        else
+          throw invalid_argument(
+              "GaussianFactorGraph contains a factor that is neither a JacobianFactor nor a HessianFactor.");
+      }
+      const JacobianFactor whitened(jacobianFactor->whiten());
+
+      // Column indices must ascend within each row, so visit the variable
+      // blocks in column order rather than factor order
+      std::vector<std::pair<size_t, JacobianFactor::const_iterator> > blocks;
+      blocks.reserve(whitened.size());
+      for (JacobianFactor::const_iterator key = whitened.begin();
+          key != whitened.end(); ++key)
+        blocks.emplace_back(columnIndices.find(*key)->second, key);
+      std::sort(blocks.begin(), blocks.end());
+
+      // Append the dense blocks of every scalar row in one sweep
+      const size_t factorRows = whitened.rows();
+      for (size_t i = 0; i < factorRows; ++i) {
+        for (const auto& block : blocks) {
+          JacobianFactor::constABlock whitenedA = whitened.getA(block.second);
+          for (size_t j = 0; j < (size_t) whitenedA.cols(); ++j) {
+            csr.columnIndices.push_back(block.first + j);
+            csr.values.push_back(whitenedA(i, j));
+          }
+        }
+        csr.rowPointers.push_back(csr.columnIndices.size());
+      }
+
+      JacobianFactor::constBVector whitenedb(whitened.getb());
+      for (size_t i = 0; i < (size_t) whitenedb.size(); ++i)
+        rhs.push_back(whitenedb(i));
+    }
+
+    csr.rows = csr.rowPointers.size() - 1;
+    csr.rhs = Eigen::Map<const Vector>(rhs.data(), rhs.size());
+    return csr;
+  }
+
+  /* ************************************************************************* */
+  SparseCsrMatrix GaussianFactorGraph::sparseHessianCsr() const {
+    size_t totalCols = 0;
+    const std::map<Key, size_t> columnIndices = columnLayout(*this, &totalCols);
+
+    // Accumulate the Hessian block-wise in the upper triangle, keyed on
+    // (block row, block column) scalar column starts; this touches each
+    // factor's small dense information matrix once
+    std::map<std::pair<size_t, size_t>, Matrix> blocks;
+    Vector eta = Vector::Zero(totalCols);
+    for (const sharedFactor& factor : *this) {
+      if (!static_cast<bool>(factor)) continue;
+      const Matrix augmented = factor->augmentedInformation();
+      const size_t nrKeys = factor->size();
+
+      // scalar offsets of each variable inside the augmented matrix
+      std::vector<size_t> offsets(nrKeys + 1, 0);
+      std::vector<size_t> starts(nrKeys);
+      for (GaussianFactor::const_iterator key = factor->begin();
+          key != factor->end(); ++key) {
+        const size_t slot = key - factor->begin();
+        offsets[slot + 1] = offsets[slot] + factor->getDim(key);
+        starts[slot] = columnIndices.find(*key)->second;
+      }
+
+      for (size_t a = 0; a < nrKeys; ++a) {
+        const size_t da = offsets[a + 1] - offsets[a];
+        eta.segment(starts[a], da) +=
+            augmented.block(offsets[a], augmented.cols() - 1, da, 1);
+        for (size_t b = a; b < nrKeys; ++b) {
+          const size_t db = offsets[b + 1] - offsets[b];
+          const Matrix block = augmented.block(offsets[a], offsets[b], da, db);
+          // store in the global upper triangle, transposing if needed
+          const bool flip = starts[b] < starts[a];
+          const std::pair<size_t, size_t> slot =
+              flip ? std::make_pair(starts[b], starts[a])
+                   : std::make_pair(starts[a], starts[b]);
+          auto inserted = blocks.emplace(slot, Matrix());
+          Matrix& target = inserted.first->second;
+          if (inserted.second)
+            target = flip ? Matrix(block.transpose()) : block;
+          else
+            target += flip ? Matrix(block.transpose()) : block;
+        }
+      }
+    }
+
+    // Assemble scalar CSR rows; within a diagonal block only the upper
+    // scalar triangle is emitted
+    SparseCsrMatrix csr;
+    csr.rows = csr.cols = totalCols;
+    csr.rowPointers.reserve(totalCols + 1);
+    csr.rowPointers.push_back(0);
+    std::map<Key, size_t>::const_iterator colIt = columnIndices.begin();
+    for (; colIt != columnIndices.end(); ++colIt) {
+      const size_t start = colIt->second;
+      const auto first = blocks.lower_bound(std::make_pair(start, size_t(0)));
+      const auto last =
+          blocks.lower_bound(std::make_pair(start + 1, size_t(0)));
+      const size_t dim =
+          first != blocks.end() && first->first.first == start
+              ? (size_t) first->second.rows()
+              : 0;
+      for (size_t i = 0; i < dim; ++i) {
+        for (auto it = first; it != last; ++it) {
+          const Matrix& block = it->second;
+          const size_t colStart = it->first.second;
+          const size_t jBegin = colStart == start ? i : 0;
+          for (size_t j = jBegin; j < (size_t) block.cols(); ++j) {
+            csr.columnIndices.push_back(colStart + j);
+            csr.values.push_back(block(i, j));
+          }
+        }
+        csr.rowPointers.push_back(csr.columnIndices.size());
+      }
+    }
+    csr.rhs = eta;
+    return csr;
+  }
+
+  /* ************************************************************************* */
+  namespace {
+  // boost::hash_combine recipe, kept local to avoid a header dependency
+  inline void structuralHashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  } // namespace
+
+  /* ************************************************************************* */
+  size_t GaussianFactorGraph::structuralHash() const {
+    size_t seed = size();
+    for (const sharedFactor& factor : *this) {
+      if (!static_cast<bool>(factor)) {
+        structuralHashCombine(seed, 0);
+        continue;
+      }
+      structuralHashCombine(seed, typeid(*factor).hash_code());
+      for (GaussianFactor::const_iterator key = factor->begin();
+          key != factor->end(); ++key) {
+        structuralHashCombine(seed, std::hash<Key>()(*key));
+        structuralHashCombine(seed, factor->getDim(key));
+      }
+    }
+    return seed;
+  }
+
   /* ************************************************************************* */
   Matrix GaussianFactorGraph::sparseJacobian_() const {
 
@@ -292,6 +521,220 @@ namespace gtsam {
     return BaseEliminateable::eliminateMultifrontal(ordering, function)->optimize();
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // Compact binary record for a conditional spilled by optimizeOutOfCore.  Raw doubles and
+    // keys are fine here because the scratch file never outlives the process that wrote it.
+    void spillConditional(const GaussianConditional& conditional, std::ostream& stream) {
+      const uint64_t nrKeys = conditional.size();
+      const uint64_t nrFrontals = conditional.nrFrontals();
+      stream.write(reinterpret_cast<const char*>(&nrKeys), sizeof(nrKeys));
+      stream.write(reinterpret_cast<const char*>(&nrFrontals), sizeof(nrFrontals));
+      for (Key key : conditional.keys())
+        stream.write(reinterpret_cast<const char*>(&key), sizeof(key));
+      for (GaussianConditional::const_iterator it = conditional.begin(); it != conditional.end(); ++it) {
+        const uint64_t dim = conditional.getDim(it);
+        stream.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+      }
+      const Matrix augmented = conditional.augmentedJacobian();
+      const uint64_t rows = augmented.rows(), cols = augmented.cols();
+      stream.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+      stream.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+      stream.write(reinterpret_cast<const char*>(augmented.data()), rows * cols * sizeof(double));
+      const SharedDiagonal& model = conditional.get_model();
+      const uint64_t modelDim = model ? model->dim() : 0;
+      stream.write(reinterpret_cast<const char*>(&modelDim), sizeof(modelDim));
+      if (model) {
+        const Vector& sigmas = model->sigmas();
+        stream.write(reinterpret_cast<const char*>(sigmas.data()), modelDim * sizeof(double));
+      }
+    }
+
+    GaussianConditional::shared_ptr restoreConditional(std::istream& stream) {
+      uint64_t nrKeys, nrFrontals;
+      stream.read(reinterpret_cast<char*>(&nrKeys), sizeof(nrKeys));
+      stream.read(reinterpret_cast<char*>(&nrFrontals), sizeof(nrFrontals));
+      KeyVector keys(nrKeys);
+      stream.read(reinterpret_cast<char*>(keys.data()), nrKeys * sizeof(Key));
+      FastVector<DenseIndex> dims(nrKeys);
+      for (uint64_t i = 0; i < nrKeys; ++i) {
+        uint64_t dim;
+        stream.read(reinterpret_cast<char*>(&dim), sizeof(dim));
+        dims[i] = static_cast<DenseIndex>(dim);
+      }
+      uint64_t rows, cols;
+      stream.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+      stream.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+      Matrix augmented(rows, cols);
+      stream.read(reinterpret_cast<char*>(augmented.data()), rows * cols * sizeof(double));
+      uint64_t modelDim;
+      stream.read(reinterpret_cast<char*>(&modelDim), sizeof(modelDim));
+      SharedDiagonal model;
+      if (modelDim > 0) {
+        Vector sigmas(modelDim);
+        stream.read(reinterpret_cast<char*>(sigmas.data()), modelDim * sizeof(double));
+        model = noiseModel::Diagonal::Sigmas(sigmas);
+      }
+      if (!stream)
+        throw std::runtime_error("optimizeOutOfCore: failed to read conditional back from scratch file");
+      const VerticalBlockMatrix blockAugmented(dims, augmented, true);
+      return boost::make_shared<GaussianConditional>(keys, nrFrontals, blockAugmented, model);
+    }
+
+    // Approximate resident size of a conditional, for the working-set accounting
+    size_t conditionalBytes(const GaussianConditional& conditional) {
+      return conditional.matrixObject().full().size() * sizeof(double);
+    }
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianFactorGraph::optimizeOutOfCore(const Ordering& ordering,
+      size_t workingSetBytes, const std::string& scratchFile, const Eliminate& function) const {
+    gttic(GaussianFactorGraph_optimizeOutOfCore);
+
+    // The interned id of every variable is its elimination position
+    const KeyInternTable position(ordering);
+
+    // Every factor waits in the bucket of its first variable to be eliminated
+    auto bucketOf = [&position](const GaussianFactor& factor) -> size_t {
+      size_t first = std::numeric_limits<size_t>::max();
+      for (Key key : factor.keys()) {
+        const KeyInternTable::Id id = position.tryIntern(key);
+        if (id == KeyInternTable::kNotInterned)
+          throw InconsistentEliminationRequested();
+        first = std::min(first, size_t(id));
+      }
+      return first;
+    };
+    std::vector<GaussianFactorGraph> buckets(ordering.size());
+    for (const sharedFactor& factor : *this)
+      if (factor)
+        buckets[bucketOf(*factor)].push_back(factor);
+
+    // Eliminate one variable at a time.  Back-substitution consumes conditionals
+    // newest-first, so whenever the resident conditionals exceed the budget the
+    // oldest ones - needed last - are spilled to the scratch file and released.
+    std::ofstream spillStream(scratchFile.c_str(), std::ios::binary | std::ios::trunc);
+    if (!spillStream.is_open())
+      throw std::invalid_argument("optimizeOutOfCore: cannot open scratch file " + scratchFile);
+    std::vector<std::streampos> spillOffsets;
+    std::deque<GaussianConditional::shared_ptr> resident;
+    size_t residentBytes = 0;
+    for (size_t pos = 0; pos < ordering.size(); ++pos) {
+      Ordering frontal;
+      frontal.push_back(ordering[pos]);
+      EliminationResult eliminated = function(buckets[pos], frontal);
+      buckets[pos] = GaussianFactorGraph();  // the gathered factors are consumed
+      if (eliminated.second && !eliminated.second->empty())
+        buckets[bucketOf(*eliminated.second)].push_back(eliminated.second);
+      resident.push_back(eliminated.first);
+      residentBytes += conditionalBytes(*eliminated.first);
+      while (residentBytes > workingSetBytes && resident.size() > 1) {
+        spillOffsets.push_back(spillStream.tellp());
+        spillConditional(*resident.front(), spillStream);
+        residentBytes -= conditionalBytes(*resident.front());
+        resident.pop_front();
+      }
+    }
+    spillStream.close();
+
+    // Back-substitute: first the in-memory tail, then stream the spilled prefix
+    // back in reverse write order.
+    VectorValues solution;
+    for (std::deque<GaussianConditional::shared_ptr>::const_reverse_iterator it = resident.rbegin();
+         it != resident.rend(); ++it)
+      solution.insert((*it)->solve(solution));
+    if (!spillOffsets.empty()) {
+      std::ifstream readStream(scratchFile.c_str(), std::ios::binary);
+      if (!readStream.is_open())
+        throw std::runtime_error("optimizeOutOfCore: cannot reopen scratch file " + scratchFile);
+      for (std::vector<std::streampos>::const_reverse_iterator it = spillOffsets.rbegin();
+           it != spillOffsets.rend(); ++it) {
+        readStream.seekg(*it);
+        GaussianConditional::shared_ptr conditional = restoreConditional(readStream);
+        solution.insert(conditional->solve(solution));
+      }
+    }
+    return solution;
+  }
+
+  /* ************************************************************************* */
+  VectorValues GaussianFactorGraph::optimizePartitioned(
+      const std::vector<Ordering>& interiorOrderings, const Ordering& separatorOrdering,
+      const Eliminate& function) const {
+    gttic(GaussianFactorGraph_optimizePartitioned);
+    const int separatorId = -1;
+
+    // Map every variable to its partition, or to the separator
+    FastMap<Key, int> partitionOf;
+    for (size_t i = 0; i < interiorOrderings.size(); ++i)
+      for (Key key : interiorOrderings[i])
+        partitionOf.insert(std::make_pair(key, static_cast<int>(i)));
+    for (Key key : separatorOrdering)
+      partitionOf.insert(std::make_pair(key, separatorId));
+
+    // Route every factor to the single partition whose interior it touches, or to the
+    // separator system if it touches none.  A factor touching two interiors means the
+    // partition is not separated and the decomposition would be wrong.
+    std::vector<GaussianFactorGraph> interiorGraphs(interiorOrderings.size());
+    GaussianFactorGraph separatorGraph;
+    for (const sharedFactor& factor : *this) {
+      if (!factor) continue;
+      int partition = separatorId;
+      for (Key key : factor->keys()) {
+        FastMap<Key, int>::const_iterator item = partitionOf.find(key);
+        if (item == partitionOf.end())
+          throw std::invalid_argument(
+            "optimizePartitioned: the orderings do not cover all variables in the graph");
+        if (item->second == separatorId) continue;
+        if (partition != separatorId && partition != item->second)
+          throw std::invalid_argument(
+            "optimizePartitioned: a factor connects the interiors of two partitions");
+        partition = item->second;
+      }
+      if (partition == separatorId)
+        separatorGraph.push_back(factor);
+      else
+        interiorGraphs[partition].push_back(factor);
+    }
+
+    // Eliminate the interiors concurrently.  Each worker produces the Bayes net over its
+    // interior and the marginal factors its partition induces on the separator.
+    std::vector<GaussianBayesNet::shared_ptr> interiorBayesNets(interiorOrderings.size());
+    std::vector<boost::shared_ptr<GaussianFactorGraph> > separatorContributions(interiorOrderings.size());
+    std::vector<std::exception_ptr> workerErrors(interiorOrderings.size());
+    {
+      std::vector<std::thread> workers;
+      workers.reserve(interiorOrderings.size());
+      for (size_t i = 0; i < interiorOrderings.size(); ++i) {
+        workers.emplace_back([&, i]() {
+          try {
+            boost::tie(interiorBayesNets[i], separatorContributions[i]) =
+              interiorGraphs[i].eliminatePartialSequential(interiorOrderings[i], function);
+          } catch (...) {
+            workerErrors[i] = std::current_exception();
+          }
+        });
+      }
+      for (std::thread& worker : workers)
+        worker.join();
+    }
+    for (const std::exception_ptr& error : workerErrors)
+      if (error)
+        std::rethrow_exception(error);
+
+    // Finish the separator system centrally
+    GaussianFactorGraph centralGraph = separatorGraph;
+    for (const boost::shared_ptr<GaussianFactorGraph>& contribution : separatorContributions)
+      centralGraph.push_back(*contribution);
+    VectorValues solution = centralGraph.eliminateSequential(separatorOrdering, function)->optimize();
+
+    // Back-substitute each interior given the separator solution
+    for (const GaussianBayesNet::shared_ptr& bayesNet : interiorBayesNets)
+      solution = bayesNet->optimize(solution);
+    return solution;
+  }
+
   /* ************************************************************************* */
   // TODO(frank): can we cache memory across invocations
   VectorValues GaussianFactorGraph::optimizeDensely() const {
@@ -316,6 +759,29 @@ namespace gtsam {
     return VectorValues(solution, scatter);
   }
 
+  /* ************************************************************************* */
+  VectorValues GaussianFactorGraph::optimizeFast(size_t denseVariableThreshold) const {
+    gttic(GaussianFactorGraph_optimizeFast);
+
+    // Constrained noise models have infinite-precision rows that the dense
+    // Cholesky path cannot represent; those graphs always go through QR
+    bool constrained = false;
+    for (const sharedFactor& factor : *this) {
+      if (!factor) continue;
+      if (const JacobianFactor* jf = dynamic_cast<const JacobianFactor*>(factor.get())) {
+        if (jf->get_model() && jf->get_model()->isConstrained()) {
+          constrained = true;
+          break;
+        }
+      }
+    }
+
+    if (!constrained && keys().size() <= denseVariableThreshold)
+      return optimizeDensely();
+    else
+      return optimize();
+  }
+
   /* ************************************************************************* */
   namespace {
     JacobianFactor::shared_ptr convertToJacobianFactorPtr(const GaussianFactor::shared_ptr &gf) {
@@ -331,16 +797,58 @@ namespace gtsam {
   VectorValues GaussianFactorGraph::gradient(const VectorValues& x0) const
   {
     VectorValues g = VectorValues::Zero(x0);
+#ifdef GTSAM_USE_TBB
+    // Same deterministic reduction as multiplyHessianAdd below: accumulate
+    // A'*e per range and merge the partials in a fixed tree shape.
+    g.addInPlace_(tbb::parallel_deterministic_reduce(
+        tbb::blocked_range<size_t>(0, factors_.size(), 256), VectorValues(),
+        [this, &x0](const tbb::blocked_range<size_t>& range,
+            VectorValues partial) {
+          for (size_t i = range.begin(); i != range.end(); ++i) {
+            if (!factors_[i]) continue;
+            JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(factors_[i]);
+            Vector e = Ai->error_vector(x0);
+            Ai->transposeMultiplyAdd(1.0, e, partial);
+          }
+          return partial;
+        },
+        [](VectorValues a, const VectorValues& b) {
+          a.addInPlace_(b);
+          return a;
+        }));
+#else
     for (const sharedFactor& factor: *this) {
       JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(factor);
       Vector e = Ai->error_vector(x0);
       Ai->transposeMultiplyAdd(1.0, e, g);
     }
+#endif
     return g;
   }
 
   /* ************************************************************************* */
   VectorValues GaussianFactorGraph::gradientAtZero() const {
+#ifdef GTSAM_USE_TBB
+    // Sum the per-factor gradients with a deterministic tree reduction: each
+    // range accumulates into its own VectorValues and partials are merged with
+    // addInPlace_, which inserts missing keys and adds existing ones. The
+    // deterministic variant always reduces in the same tree shape, so the
+    // gradient is bitwise reproducible across runs and thread counts.
+    return tbb::parallel_deterministic_reduce(
+        tbb::blocked_range<size_t>(0, factors_.size(), 256), VectorValues(),
+        [this](const tbb::blocked_range<size_t>& range, VectorValues g) {
+          for (size_t i = range.begin(); i != range.end(); ++i) {
+            if (!factors_[i]) continue;
+            VectorValues gi = factors_[i]->gradientAtZero();
+            g.addInPlace_(gi);
+          }
+          return g;
+        },
+        [](VectorValues a, const VectorValues& b) {
+          a.addInPlace_(b);
+          return a;
+        });
+#else
     // Zero-out the gradient
     VectorValues g;
     for (const sharedFactor& factor: *this) {
@@ -349,6 +857,7 @@ namespace gtsam {
       g.addInPlace_(gi);
     }
     return g;
+#endif
   }
 
   /* ************************************************************************* */
@@ -393,8 +902,30 @@ namespace gtsam {
   /* ************************************************************************* */
   void GaussianFactorGraph::multiplyHessianAdd(double alpha,
       const VectorValues& x, VectorValues& y) const {
+#ifdef GTSAM_USE_TBB
+    // This matvec is the inner loop of every iterative solve, so parallelize
+    // over factors with per-range VectorValues accumulators. Both Jacobian and
+    // Hessian factors insert-or-add into their target, so the empty partials
+    // work as identities, and the deterministic reduction keeps CG iterates
+    // bitwise reproducible (floating-point addition is not associative).
+    VectorValues sum = tbb::parallel_deterministic_reduce(
+        tbb::blocked_range<size_t>(0, factors_.size(), 256), VectorValues(),
+        [this, alpha, &x](const tbb::blocked_range<size_t>& range,
+            VectorValues partial) {
+          for (size_t i = range.begin(); i != range.end(); ++i) {
+            if (factors_[i]) factors_[i]->multiplyHessianAdd(alpha, x, partial);
+          }
+          return partial;
+        },
+        [](VectorValues a, const VectorValues& b) {
+          a.addInPlace_(b);
+          return a;
+        });
+    y.addInPlace_(sum);
+#else
     for (const GaussianFactor::shared_ptr& f: *this)
      f->multiplyHessianAdd(alpha, x, y);
+#endif
   }
 
   /* ************************************************************************* */
@@ -27,6 +27,7 @@
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/HessianFactor.h>
 #include <gtsam/linear/Errors.h> // Included here instead of fw-declared so we can use Errors::iterator
+#include <gtsam/linear/SparseCsrMatrix.h>
 
 namespace gtsam {
 
@@ -141,6 +142,12 @@ namespace gtsam {
     /* return a map of (Key, dimension) */
     std::map<Key, size_t> getKeyDimMap() const;
 
+    /** The number of bytes of memory occupied by this graph: the
+     * factor-pointer array plus the footprint each factor reports through
+     * GaussianFactor::memoryUsage().  Factors shared with other graphs are
+     * counted here as well (\f$ O(n) \f$). */
+    size_t memoryUsage() const;
+
     /** unnormalized error */
     double error(const VectorValues& x) const {
       double total_error = 0.;
@@ -156,6 +163,17 @@ namespace gtsam {
       return exp(-0.5 * error(c));
     }
 
+    /**
+     * Set the activation weight of every factor, in factor order.  Weights
+     * scale each factor's information contribution during elimination and
+     * its error, see GaussianFactor::setActivationWeight - mutating them
+     * between iterations implements switchable constraints or graduated
+     * non-convexity sweeps without rebuilding the graph.  Entries for null
+     * factors are ignored.  Throws std::invalid_argument if the number of
+     * weights does not match the number of factors.
+     */
+    void setActivationWeights(const std::vector<double>& weights);
+
     /**
      * Clone() performs a deep-copy of the graph, including all of the factors.
      * Cloning preserves null factors so indices for the original graph are still
@@ -194,6 +212,38 @@ namespace gtsam {
      */
     Matrix sparseJacobian_() const;
 
+    /**
+     * Export the whitened Jacobian in compressed-sparse-row form, assembled
+     * block-row by block-row directly into contiguous arrays - no per-element
+     * triplet list is built.  Columns follow sorted keys, exactly as in
+     * sparseJacobian(); the whitened b goes into the rhs field instead of an
+     * extra column.  Entries inside factor blocks are stored even when zero,
+     * so the pattern is stable across relinearizations and an external
+     * solver's symbolic analysis can be reused.  Pass view() of the result
+     * across a C ABI to MKL PARDISO, CHOLMOD, cuDSS, etc.
+     */
+    SparseCsrMatrix sparseJacobianCsr() const;
+
+    /**
+     * Export the upper triangle of the Hessian \f$ A^T A \f$ in
+     * compressed-sparse-row form, accumulated block-wise from each factor's
+     * augmentedInformation().  Columns follow sorted keys; the rhs field
+     * holds \f$ \eta = A^T b \f$, so the full system \f$ A^T A x = \eta \f$
+     * can be handed to a symmetric external solver (upper CSR is lower CSC,
+     * as CHOLMOD expects).  See sparseJacobianCsr() for pattern stability.
+     */
+    SparseCsrMatrix sparseHessianCsr() const;
+
+    /**
+     * Structural fingerprint of the graph: a hash over the number of factors
+     * and, for each factor, its concrete type, keys, and variable dimensions.
+     * Numeric values do not participate, so per-frame graphs that relinearize
+     * the same topology hash identically, and a solve plan computed for one
+     * frame (ordering plus symbolic elimination, see SolvePlanCache) can be
+     * looked up for the next.
+     */
+    size_t structuralHash() const;
+
     /**
      * Return a dense \f$ [ \;A\;b\; ] \in \mathbb{R}^{m \times n+1} \f$
      * Jacobian matrix, augmented with b with the noise models baked
@@ -292,11 +342,47 @@ namespace gtsam {
     VectorValues optimize(const Ordering&,
       const Eliminate& function = EliminationTraitsType::DefaultEliminate) const;
 
+    /** Solve the factor graph with a bounded resident set, spilling eliminated conditionals to a
+     *  binary scratch file.  Variables are eliminated one at a time in the given \c ordering;
+     *  whenever the conditionals produced so far exceed \c workingSetBytes, the oldest ones are
+     *  written out to \c scratchFile and released.  Back-substitution consumes conditionals
+     *  newest-first, so the in-memory tail is solved first and the spilled prefix is then streamed
+     *  back from the file in reverse write order.  Produces the same solution as optimize(ordering)
+     *  on graphs that fit in memory, and keeps only the working set plus the still-uneliminated
+     *  factors resident on graphs that do not.  The scratch file is only valid within the process
+     *  that wrote it. */
+    VectorValues optimizeOutOfCore(const Ordering& ordering, size_t workingSetBytes,
+      const std::string& scratchFile,
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate) const;
+
+    /** Solve the factor graph by partitioned elimination: the interior of each partition is
+     *  eliminated on its own worker thread, the marginal factors each partition induces on the
+     *  separator are gathered centrally, the separator system is solved, and the interiors are
+     *  then back-substituted independently.  \c interiorOrderings gives the elimination ordering
+     *  of each partition's interior variables, and \c separatorOrdering covers all remaining
+     *  variables; together they must cover every variable in the graph.  A valid partition allows
+     *  no factor to connect the interiors of two different partitions - such factors belong on the
+     *  separator - and std::invalid_argument is thrown when one is found.  Produces the same
+     *  solution as optimize() with the concatenated ordering. */
+    VectorValues optimizePartitioned(const std::vector<Ordering>& interiorOrderings,
+      const Ordering& separatorOrdering,
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate) const;
+
     /**
      * Optimize using Eigen's dense Cholesky factorization
      */
     VectorValues optimizeDensely() const;
 
+    /** Solve the factor graph, automatically selecting between sparse elimination and the dense
+     *  path based on problem size.  For graphs with at most \c denseVariableThreshold variables
+     *  the symbolic machinery of sparse elimination (variable index, COLAMD ordering, elimination
+     *  tree) costs more than the flops it saves, so such graphs are assembled into a single dense
+     *  Hessian and solved with one Cholesky factorization, as in optimizeDensely().  Larger
+     *  graphs, and graphs containing constrained noise models (which the dense Cholesky path
+     *  cannot represent), fall back to optimize().  Produces the same solution as optimize() on
+     *  well-conditioned problems. */
+    VectorValues optimizeFast(size_t denseVariableThreshold = 100) const;
+
     /**
      * Compute the gradient of the energy function,
      * \f$ \nabla_{x=x_0} \left\Vert \Sigma^{-1} A x - b \right\Vert^2 \f$,
@@ -28,7 +28,13 @@ namespace gtsam {
 
   /* ************************************************************************* */
   GaussianJunctionTree::GaussianJunctionTree(
-    const GaussianEliminationTree& eliminationTree) :
-  Base(eliminationTree) {}
+    const GaussianEliminationTree& eliminationTree, int mergeFillThreshold) :
+  Base(eliminationTree, mergeFillThreshold) {}
+
+  /* ************************************************************************* */
+  GaussianJunctionTree::GaussianJunctionTree(
+    const GaussianEliminationTree& eliminationTree,
+    const JunctionTreeShaping& shaping) :
+  Base(eliminationTree, shaping) {}
 
 }
@@ -46,9 +46,24 @@ namespace gtsam {
     * @param structure The set of factors involving each variable.  If this is not
     * precomputed, you can call the Create(const FactorGraph<DERIVEDFACTOR>&)
     * named constructor instead.
+    * @param mergeFillThreshold If positive, relaxed supernode amalgamation
+    * also merges nearly-matching cliques into one larger dense panel when the
+    * explicit zero fill introduced stays below the threshold, reducing
+    * small-block overhead in the dense partial Cholesky steps.  See the
+    * JunctionTree constructor for details.
     * @return The elimination tree
     */
-    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree);
+    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree,
+        int mergeFillThreshold = 0);
+
+    /**
+    * Build the junction tree with full control over clique amalgamation:
+    * relaxed fill budget, minimum supernode size, and a maximum supernode
+    * size that preserves tree width for parallel elimination.  See
+    * JunctionTreeShaping for the individual knobs.
+    */
+    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree,
+        const JunctionTreeShaping& shaping);
   };
 
 }
@@ -24,6 +24,7 @@
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/base/cholesky.h>
 #include <gtsam/base/debug.h>
+#include <gtsam/base/FastDefaultAllocator.h>
 #include <gtsam/base/FastMap.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/ThreadsafeException.h>
@@ -345,7 +346,7 @@ double HessianFactor::error(const VectorValues& c) const {
   // error 0.5*(f - 2*x'*g + x'*G*x)
   const double f = constantTerm();
   if (empty()) {
-    return 0.5 * f;
+    return 0.5 * activationWeight_ * f;
   }
   double xtg = 0, xGx = 0;
   // extract the relevant subset of the VectorValues
@@ -354,7 +355,7 @@ double HessianFactor::error(const VectorValues& c) const {
   xtg = x.dot(linearTerm().col(0));
   auto AtA = informationView();
   xGx = x.transpose() * AtA * x;
-  return 0.5 * (f - 2.0 * xtg + xGx);
+  return 0.5 * activationWeight_ * (f - 2.0 * xtg + xGx);
 }
 
 /* ************************************************************************* */
@@ -376,11 +377,13 @@ void HessianFactor::updateHessian(const KeyVector& infoKeys,
 
       if (i == j) {
         assert(I == J);
-        info->updateDiagonalBlock(I, info_.diagonalBlock(i));
+        info->updateDiagonalBlock(I,
+            activationWeight_ * info_.diagonalBlock(i).nestedExpression());
       } else {
         assert(i < j);
         assert(I != J);
-        info->updateOffDiagonalBlock(I, J, info_.aboveDiagonalBlock(i, j));
+        info->updateOffDiagonalBlock(I, J,
+            activationWeight_ * info_.aboveDiagonalBlock(i, j));
       }
     }
   }
@@ -484,7 +487,11 @@ boost::shared_ptr<GaussianConditional> HessianFactor::eliminateCholesky(const Or
 
     // TODO(frank): pre-allocate GaussianConditional and write into it
     const VerticalBlockMatrix Ab = info_.split(nFrontals);
-    conditional = boost::make_shared<GaussianConditional>(keys_, nFrontals, Ab);
+    // Conditionals come out of the shared pooled allocator, like the cliques
+    // that hold them, to limit heap fragmentation across solver instances
+    conditional = boost::allocate_shared<GaussianConditional>(
+        internal::FastDefaultAllocator<GaussianConditional>::type(), keys_,
+        nFrontals, Ab);
 
     // Erase the eliminated keys in this factor
     keys_.erase(begin(), begin() + nFrontals);
@@ -550,6 +557,34 @@ EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys) {
   return make_pair(conditional, jointFactor);
 }
 
+/* ************************************************************************* */
+std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+CachedEliminateCholesky::operator()(const GaussianFactorGraph& factors,
+    const Ordering& keys) {
+  gttic(CachedEliminateCholesky);
+
+  // Look up the Scatter for this clique, building it on the first iteration
+  FastMap<KeyVector, Scatter>::iterator it = scatters_.find(keys);
+  if (it == scatters_.end())
+    it = scatters_.emplace(keys, Scatter(factors, keys)).first;
+
+  // Build joint factor on the cached Scatter
+  HessianFactor::shared_ptr jointFactor;
+  try {
+    jointFactor = boost::make_shared<HessianFactor>(factors, it->second);
+  } catch (std::invalid_argument&) {
+    throw InvalidDenseElimination(
+        "CachedEliminateCholesky was called with a request to eliminate variables that are not\n"
+        "involved in the provided factors.");
+  }
+
+  // Do dense elimination
+  auto conditional = jointFactor->eliminateCholesky(keys);
+
+  // Return result
+  return make_pair(conditional, jointFactor);
+}
+
 /* ************************************************************************* */
 std::pair<boost::shared_ptr<GaussianConditional>,
     boost::shared_ptr<GaussianFactor> > EliminatePreferCholesky(
@@ -566,4 +601,57 @@ std::pair<boost::shared_ptr<GaussianConditional>,
     return EliminateCholesky(factors, keys);
 }
 
+/* ************************************************************************* */
+namespace {
+// Spread of the information diagonal above which the adaptive dispatch
+// switches from Cholesky to the more stable QR.  The diagonal spread is a
+// lower bound on the squared condition number of the clique system, so this
+// corresponds to an estimated condition number of about 3e4.
+static const double kAdaptiveConditionThreshold = 1e9;
+}
+
+std::pair<boost::shared_ptr<GaussianConditional>,
+    boost::shared_ptr<GaussianFactor> > EliminateAdaptive(
+    const GaussianFactorGraph& factors, const Ordering& keys) {
+  gttic(EliminateAdaptive);
+
+  // Constrained noise models force QR, as in EliminatePreferCholesky
+  if (hasConstraints(factors))
+    return EliminateQR(factors, keys);
+
+  // Build the joint factor as EliminateCholesky would
+  HessianFactor::shared_ptr jointFactor;
+  try {
+    Scatter scatter(factors, keys);
+    jointFactor = boost::make_shared<HessianFactor>(factors, scatter);
+  } catch (std::invalid_argument&) {
+    throw InvalidDenseElimination(
+        "EliminateAdaptive was called with a request to eliminate variables that are not\n"
+        "involved in the provided factors.");
+  }
+
+  // Inspect the diagonal of the assembled information matrix before
+  // factorizing; its spread bounds the squared condition number from below.
+  const SymmetricBlockMatrix& info = jointFactor->info();
+  double dmin = std::numeric_limits<double>::infinity(), dmax = 0.0;
+  for (DenseIndex j = 0; j < info.nBlocks() - 1; ++j) {
+    const Vector d = info.diagonal(j);
+    dmin = std::min(dmin, d.minCoeff());
+    dmax = std::max(dmax, d.maxCoeff());
+  }
+  if (!(dmin > 0.0) || dmax > dmin * kAdaptiveConditionThreshold)
+    return EliminateQR(factors, keys);
+
+  // Well conditioned: use the blocked Cholesky kernel.  Large cliques go
+  // through the same call - Eigen blocks the factorization internally, which
+  // is our supernodal kernel in this dense-per-clique design.  Should
+  // Cholesky still fail numerically, redo the clique with QR.
+  try {
+    auto conditional = jointFactor->eliminateCholesky(keys);
+    return make_pair(conditional, jointFactor);
+  } catch (IndeterminantLinearSystemException&) {
+    return EliminateQR(factors, keys);
+  }
+}
+
 } // gtsam
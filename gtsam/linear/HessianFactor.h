@@ -224,6 +224,13 @@ namespace gtsam {
     /** Check if the factor is empty.  TODO: How should this be defined? */
     bool empty() const override { return size() == 0 /*|| rows() == 0*/; }
 
+    /** Bytes occupied by this factor: the object, the key vector, and the
+     * full storage of the augmented information matrix */
+    size_t memoryUsage() const override {
+      return sizeof(*this) + keys_.capacity() * sizeof(Key)
+          + info_.rows() * info_.rows() * sizeof(double);
+    }
+
     /** Return the constant term \f$ f \f$ as described above
      * @return The constant term \f$ f \f$
      */
@@ -401,6 +408,35 @@ namespace gtsam {
 GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
   EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+/**
+*   Stateful variant of EliminateCholesky for optimizers that repeatedly
+*   eliminate a graph whose structure does not change between iterations. The
+*   Scatter of each clique, identified by its elimination keys, is built once
+*   and reused on all subsequent calls, where only the numerical values are
+*   recombined and factorized.
+*
+*   Pass an instance by reference as the eliminate function, e.g. with
+*   boost::ref, so that all cliques and iterations share a single cache, and
+*   call clear() whenever the graph structure or the ordering changes.
+*
+*   \addtogroup LinearSolving */
+class GTSAM_EXPORT CachedEliminateCholesky {
+public:
+
+  /// Eliminate as EliminateCholesky does, reusing the clique Scatter if cached
+  std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+    operator()(const GaussianFactorGraph& factors, const Ordering& keys);
+
+  /// Invalidate all cached Scatters, required when the structure changes
+  void clear() { scatters_.clear(); }
+
+  /// Number of cliques cached so far
+  size_t size() const { return scatters_.size(); }
+
+private:
+  FastMap<KeyVector, Scatter> scatters_;
+};
+
 /**
 *   Densely partially eliminate with Cholesky factorization.  JacobianFactors are
 *   left-multiplied with their transpose to form the Hessian using the conversion constructor
@@ -419,6 +455,26 @@ GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr
 GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> >
   EliminatePreferCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+/**
+*   Densely partially eliminate, choosing the factorization per clique at
+*   runtime.  Cliques with constrained noise models use QR as in
+*   EliminatePreferCholesky.  For the rest, the diagonal of the assembled
+*   information matrix - a cheap lower bound on its squared condition number,
+*   available before factorizing - decides: well-conditioned cliques take the
+*   blocked Cholesky kernel, ill-conditioned ones the more stable QR, so a few
+*   poorly conditioned sensors no longer force an entire graph onto QR.  A
+*   Cholesky failure despite the heuristic also falls back to QR.
+*
+*   Variables are eliminated in the order specified in \c keys.
+*
+*   @param factors Factors to combine and eliminate
+*   @param keys The variables to eliminate and their elimination ordering
+*   @return The conditional and remaining factor
+*
+*   \addtogroup LinearSolving */
+GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<GaussianFactor> >
+  EliminateAdaptive(const GaussianFactorGraph& factors, const Ordering& keys);
+
 /// traits
 template<>
 struct traits<HessianFactor> : public Testable<HessianFactor> {};
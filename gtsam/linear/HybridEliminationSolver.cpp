@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   HybridEliminationSolver.cpp
+ * @brief  Hybrid direct/iterative linear solver
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/linear/HybridEliminationSolver.h>
+
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/iterative.h>
+
+#include <limits>
+
+using namespace std;
+
+namespace gtsam {
+
+/**************************************************************************************************/
+HybridEliminationSolver::HybridEliminationSolver(const GaussianFactorGraph& Ab,
+    const Parameters& parameters, const Ordering& directOrdering)
+    : parameters_(parameters) {
+  if (directOrdering.empty()) {
+    Rc1_ = boost::make_shared<GaussianBayesNet>();
+    reduced_ = boost::make_shared<GaussianFactorGraph>(Ab);
+  } else {
+    std::tie(Rc1_, reduced_) = Ab.eliminatePartialSequential(directOrdering);
+  }
+  if (parameters_.verbosity())
+    cout << "Eliminated " << Rc1_->size() << " variables directly, iterating on "
+         << reduced_->size() << " reduced factors" << endl;
+}
+
+/**************************************************************************************************/
+Ordering HybridEliminationSolver::DirectPrefix(const GaussianFactorGraph& Ab,
+    const Ordering& ordering, size_t maxFrontWidth) {
+
+  // The elimination position of every variable
+  FastMap<Key, size_t> position;
+  for (size_t pos = 0; pos < ordering.size(); ++pos)
+    position.insert(make_pair(ordering[pos], pos));
+
+  // Every factor's key set waits in the bucket of its first variable to be
+  // eliminated; variables outside the ordering never trigger a gather
+  const size_t outside = numeric_limits<size_t>::max();
+  auto bucketOf = [&position, outside](const KeySet& keys) -> size_t {
+    size_t first = outside;
+    for (Key key : keys) {
+      FastMap<Key, size_t>::const_iterator item = position.find(key);
+      if (item != position.end())
+        first = min(first, item->second);
+    }
+    return first;
+  };
+  vector<vector<KeySet> > buckets(ordering.size());
+  for (const GaussianFactor::shared_ptr& factor : Ab) {
+    if (!factor)
+      continue;
+    KeySet keys(factor->begin(), factor->end());
+    const size_t bucket = bucketOf(keys);
+    if (bucket != outside)
+      buckets[bucket].push_back(keys);
+  }
+
+  // Symbolically eliminate one variable at a time; the front of a variable is
+  // the union of the keys of all factors gathered at it.  Stop at the first
+  // front wider than the bound - everything from there on is left to the
+  // iterative root system.
+  Ordering prefix;
+  for (size_t pos = 0; pos < ordering.size(); ++pos) {
+    KeySet front;
+    for (const KeySet& keys : buckets[pos])
+      front.insert(keys.begin(), keys.end());
+    if (front.size() > maxFrontWidth)
+      break;
+    prefix.push_back(ordering[pos]);
+    front.erase(ordering[pos]);
+    if (!front.empty()) {
+      const size_t bucket = bucketOf(front);
+      if (bucket != outside && bucket > pos)
+        buckets[bucket].push_back(front);
+    }
+    buckets[pos].clear();
+  }
+  return prefix;
+}
+
+/**************************************************************************************************/
+VectorValues HybridEliminationSolver::optimize() const {
+  // All variables were eliminated directly: plain back-substitution
+  if (reduced_->empty())
+    return Rc1_->optimize();
+
+  // Conjugate gradients on the reduced root system, from zero
+  VectorValues zero;
+  for (const auto& key_dim : reduced_->getKeyDimMap())
+    zero.insert(key_dim.first, Vector::Zero(key_dim.second));
+  VectorValues frontier = conjugateGradientDescent(*reduced_, zero, parameters_);
+
+  // Recover the directly eliminated variables given the frontier solution
+  return Rc1_->optimize(frontier);
+}
+
+/**************************************************************************************************/
+VectorValues HybridEliminationSolver::optimize(const GaussianFactorGraph& gfg,
+    const KeyInfo& keyInfo, const map<Key, Vector>& lambda,
+    const VectorValues& initial) {
+  return VectorValues();
+}
+
+/**************************************************************************************************/
+}  // namespace gtsam
@@ -0,0 +1,103 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   HybridEliminationSolver.h
+ * @brief  Hybrid direct/iterative linear solver: direct elimination up to a
+ *         frontier, conjugate gradients on the reduced root system
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/linear/ConjugateGradientSolver.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+// Forward declarations
+class GaussianFactorGraph;
+class GaussianBayesNet;
+
+/**
+ * A hybrid linear solver for graphs where most of the structure eliminates
+ * cheaply (e.g. chain-like odometry) but a small portion produces fronts too
+ * dense for direct elimination.  The well-structured portion is eliminated
+ * directly up to a frontier, which marginalizes it exactly onto the frontier
+ * variables; conjugate gradients then iterate only on the reduced root
+ * system, and the direct part is recovered by back-substitution.  Exact
+ * marginalization is strictly stronger than using the eliminated part as a
+ * preconditioner: the direct portion contributes its full information to the
+ * reduced system and never needs to be iterated over.
+ *
+ * The frontier can be chosen automatically with DirectPrefix(), which keeps
+ * eliminating along a given ordering until the symbolic front grows wider
+ * than a bound.
+ */
+class GTSAM_EXPORT HybridEliminationSolver : public IterativeSolver {
+ public:
+  typedef ConjugateGradientParameters Parameters;
+
+ protected:
+  Parameters parameters_;
+  boost::shared_ptr<GaussianBayesNet> Rc1_;  ///< the directly eliminated part
+  boost::shared_ptr<GaussianFactorGraph> reduced_;  ///< the root system on the frontier
+
+ public:
+  /// @name Constructors
+  /// @{
+
+  /**
+   * Eliminate the variables of \c directOrdering from \c Ab directly, keeping
+   * the reduced system on the remaining variables for conjugate gradients.
+   * \c directOrdering may cover any subset of the variables, including none
+   * (pure iterative) or all of them (pure direct).
+   */
+  HybridEliminationSolver(const GaussianFactorGraph& Ab,
+                          const Parameters& parameters,
+                          const Ordering& directOrdering);
+
+  /// Destructor
+  virtual ~HybridEliminationSolver() {}
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /**
+   * The longest prefix of \c ordering that eliminates from \c Ab with every
+   * symbolic front at most \c maxFrontWidth variables wide.  Variables beyond
+   * the first too-wide front are left to the iterative root system, so
+   * chain-like portions are swept up directly and dense portions are not.
+   */
+  static Ordering DirectPrefix(const GaussianFactorGraph& Ab,
+                               const Ordering& ordering, size_t maxFrontWidth);
+
+  /// The directly eliminated part, as a Bayes net on the direct variables
+  const GaussianBayesNet& directPart() const { return *Rc1_; }
+
+  /// The reduced system on the frontier variables, iterated over by optimize()
+  const GaussianFactorGraph& reducedSystem() const { return *reduced_; }
+
+  /// Solve: conjugate gradients on the reduced system, then back-substitution
+  VectorValues optimize() const;
+
+  /// Interface that IterativeSolver subclasses have to implement
+  VectorValues optimize(const GaussianFactorGraph& gfg, const KeyInfo& keyInfo,
+                        const std::map<Key, Vector>& lambda,
+                        const VectorValues& initial) override;
+
+  /// @}
+};
+
+}  // namespace gtsam
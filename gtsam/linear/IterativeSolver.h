@@ -25,9 +25,11 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/optional.hpp>
 
+#include <functional>
 #include <iosfwd>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace gtsam {
 
@@ -38,6 +40,97 @@ class GaussianFactorGraph;
 class Values;
 class VectorValues;
 
+/**
+ * Lightweight instrumentation surface for the iterative solvers.  When
+ * attached to IterativeOptimizationParameters, the conjugate gradient loop
+ * records one sample per iteration - the squared residual norm and the time
+ * spent in the preconditioner and in matrix-vector products - into a
+ * fixed-size ring buffer, and invokes an optional user callback.  The cost
+ * per iteration is a few clock reads and stores, cheap enough to leave on in
+ * production; auto-tuning harnesses read the buffer afterwards to pick a
+ * preconditioner per deployment site.
+ */
+class GTSAM_EXPORT IterativeSolverMonitor {
+
+public:
+
+  typedef boost::shared_ptr<IterativeSolverMonitor> shared_ptr;
+
+  /// One sample per conjugate gradient iteration
+  struct Sample {
+    size_t iteration;          ///< iteration number within the solve, from 1
+    double residualNorm2;      ///< squared norm of the preconditioned residual
+    double preconditionerTime; ///< seconds spent applying the preconditioner
+    double matvecTime;         ///< seconds spent in matrix-vector products
+  };
+
+  /// Called after every recorded iteration, if set
+  typedef std::function<void(const Sample&)> Callback;
+
+  /// Create a monitor retaining the last \c capacity samples
+  explicit IterativeSolverMonitor(size_t capacity = 128) :
+      buffer_(capacity), next_(0), total_(0) {
+  }
+
+  /// Number of samples currently retained (at most capacity)
+  size_t size() const {
+    return std::min(total_, buffer_.size());
+  }
+
+  /// Ring buffer capacity
+  size_t capacity() const {
+    return buffer_.size();
+  }
+
+  /// Number of samples recorded since the last reset, including overwritten
+  size_t totalIterations() const {
+    return total_;
+  }
+
+  /// The i-th retained sample, oldest first; throws std::out_of_range
+  const Sample& sample(size_t i) const {
+    if (i >= size())
+      throw std::out_of_range("IterativeSolverMonitor::sample: index out of range");
+    return buffer_[(total_ <= buffer_.size()) ? i : (next_ + i) % buffer_.size()];
+  }
+
+  /// The most recent sample; throws std::out_of_range if none recorded
+  const Sample& last() const {
+    if (total_ == 0)
+      throw std::out_of_range("IterativeSolverMonitor::last: no samples recorded");
+    return buffer_[(next_ + buffer_.size() - 1) % buffer_.size()];
+  }
+
+  /// Forget all samples, keeping the capacity and callback
+  void reset() {
+    next_ = 0;
+    total_ = 0;
+  }
+
+  /// Set (or clear, by passing an empty function) the per-iteration callback
+  void setCallback(const Callback& callback) {
+    callback_ = callback;
+  }
+
+  /// Record one iteration; called by the solver loops
+  void record(size_t iteration, double residualNorm2, double preconditionerTime,
+      double matvecTime) {
+    const Sample sample = {iteration, residualNorm2, preconditionerTime, matvecTime};
+    buffer_[next_] = sample;
+    next_ = (next_ + 1) % buffer_.size();
+    ++total_;
+    if (callback_)
+      callback_(sample);
+  }
+
+private:
+
+  std::vector<Sample> buffer_; ///< Ring buffer of the most recent samples
+  size_t next_;                ///< Slot the next sample will be written to
+  size_t total_;               ///< Samples recorded since the last reset
+  Callback callback_;          ///< Optional per-iteration user callback
+};
+
 /**
  * parameters for iterative linear solvers
  */
@@ -50,6 +143,10 @@ public:
     SILENT = 0, COMPLEXITY, ERROR
   } verbosity_;
 
+  /// Optional per-iteration instrumentation, shared by all solves using
+  /// these parameters; null (the default) records nothing
+  IterativeSolverMonitor::shared_ptr monitor_;
+
 public:
 
   IterativeOptimizationParameters(Verbosity v = SILENT) :
@@ -63,6 +160,16 @@ public:
   inline Verbosity verbosity() const {
     return verbosity_;
   }
+
+  /// The attached monitor, or null if solves are not instrumented
+  const IterativeSolverMonitor::shared_ptr& monitor() const {
+    return monitor_;
+  }
+
+  /// Attach a monitor recording per-iteration samples of every solve
+  void setMonitor(const IterativeSolverMonitor::shared_ptr& monitor) {
+    monitor_ = monitor;
+  }
   GTSAM_EXPORT std::string getVerbosity() const;
   GTSAM_EXPORT void setVerbosity(const std::string &s);
 
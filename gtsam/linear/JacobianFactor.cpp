@@ -28,6 +28,7 @@
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/FastDefaultAllocator.h>
 #include <gtsam/base/FastMap.h>
 #include <gtsam/base/cholesky.h>
 
@@ -515,8 +516,8 @@ Vector JacobianFactor::error_vector(const VectorValues& c) const {
 double JacobianFactor::error(const VectorValues& c) const {
   Vector e = unweighted_error(c);
   // Use the noise model distance function to get the correct error if available.
-  if (model_) return 0.5 * model_->squaredMahalanobisDistance(e);
-  return 0.5 * e.dot(e);
+  if (model_) return 0.5 * activationWeight_ * model_->squaredMahalanobisDistance(e);
+  return 0.5 * activationWeight_ * e.dot(e);
 }
 
 /* ************************************************************************* */
@@ -588,6 +589,47 @@ map<Key, Matrix> JacobianFactor::hessianBlockDiagonal() const {
   return blocks;
 }
 
+/* ************************************************************************* */
+namespace {
+// Fixed-size version of the A'*A update in updateHessian below, instantiated
+// for the block widths of pose-only graphs. With the column count D known at
+// compile time, Eigen emits fixed-size kernels for the Ai'*Aj products and
+// rank updates instead of dispatching on dynamic dimensions.
+template <DenseIndex D>
+void updateHessianRegular(const VerticalBlockMatrix& Ab, const KeyVector& keys,
+                          const KeyVector& infoKeys, double weight,
+                          SymmetricBlockMatrix* info) {
+  typedef Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, D>, 0,
+      Eigen::OuterStride<> > ConstBlockD;
+  // Reinterpret block j as a matrix with D columns fixed at compile time
+  auto blockD = [&Ab](DenseIndex j) {
+    const Eigen::Block<const Matrix> Ab_j = Ab(j);
+    return ConstBlockD(Ab_j.data(), Ab_j.rows(), D,
+        Eigen::OuterStride<>(Ab_j.outerStride()));
+  };
+
+  const DenseIndex n = Ab.nBlocks() - 1, N = info->nBlocks() - 1;
+  vector<DenseIndex> slots(n);
+  for (DenseIndex j = 0; j < n; ++j) {
+    const ConstBlockD Aj = blockD(j);
+    const DenseIndex J = GaussianFactor::Slot(infoKeys, keys[j]);
+    slots[j] = J;
+    // Fill off-diagonal blocks with Ai'*Aj, and the diagonal with Aj'*Aj
+    for (DenseIndex i = 0; i < j; ++i)
+      info->updateOffDiagonalBlock(slots[i], J,
+          weight * (blockD(i).transpose() * Aj));
+    info->diagonalBlock(J).rankUpdate(Aj.transpose(), weight);
+  }
+
+  // The RHS column is a single vector, handled outside the fixed-size loop
+  const Eigen::Block<const Matrix> b = Ab(n);
+  for (DenseIndex i = 0; i < n; ++i)
+    info->updateOffDiagonalBlock(slots[i], N,
+        weight * (blockD(i).transpose() * b));
+  info->diagonalBlock(N).rankUpdate(b.transpose(), weight);
+}
+}  // namespace
+
 /* ************************************************************************* */
 void JacobianFactor::updateHessian(const KeyVector& infoKeys,
                                    SymmetricBlockMatrix* info) const {
@@ -608,6 +650,43 @@ void JacobianFactor::updateHessian(const KeyVector& infoKeys,
     // Ab_ is the augmented Jacobian matrix A, and we perform I += A'*A below
     DenseIndex n = Ab_.nBlocks() - 1, N = info->nBlocks() - 1;
 
+    // If this factor's variables occupy contiguous, in-order slots of info,
+    // the whole A'*A update collapses to one blocked rank-k kernel across all
+    // of its block columns, plus a single pass for the RHS column - the
+    // per-block-pair offset bookkeeping below is pure overhead in that case
+    if (n > 0) {
+      const DenseIndex J0 = Slot(infoKeys, keys_[0]);
+      bool contiguous = true;
+      for (DenseIndex j = 1; j < n && contiguous; ++j)
+        contiguous = (Slot(infoKeys, keys_[j]) == J0 + j);
+      if (contiguous) {
+        const constABlock A = Ab_.range(0, n);
+        const constABlock b = Ab_(n);
+        info->selfadjointView(J0, J0 + n).rankUpdate(A.transpose(),
+            activationWeight_);
+        info->aboveDiagonalRange(J0, J0 + n, N, N + 1).noalias() +=
+            activationWeight_ * (A.transpose() * b);
+        info->diagonalBlock(N).rankUpdate(b.transpose(), activationWeight_);
+        return;
+      }
+    }
+
+    // Homogeneous graphs (e.g. Pose2/Pose3-only) have uniform block widths;
+    // dispatch those to a fixed-size instantiation of the same update
+    DenseIndex commonDim = n > 0 ? Ab_(0).cols() : 0;
+    for (DenseIndex j = 1; j < n; ++j)
+      if (Ab_(j).cols() != commonDim) {
+        commonDim = 0;
+        break;
+      }
+    if (commonDim == 3) {
+      updateHessianRegular<3>(Ab_, keys_, infoKeys, activationWeight_, info);
+      return;
+    } else if (commonDim == 6) {
+      updateHessianRegular<6>(Ab_, keys_, infoKeys, activationWeight_, info);
+      return;
+    }
+
     // Apply updates to the upper triangle
     // Loop over blocks of A, including RHS with j==n
     vector<DenseIndex> slots(n+1);
@@ -618,10 +697,11 @@ void JacobianFactor::updateHessian(const KeyVector& infoKeys,
       // Fill off-diagonal blocks with Ai'*Aj
       for (DenseIndex i = 0; i < j; ++i) {
         const DenseIndex I = slots[i];  // because i<j, slots[i] is valid.
-        info->updateOffDiagonalBlock(I, J, Ab_(i).transpose() * Ab_j);
+        info->updateOffDiagonalBlock(I, J,
+            activationWeight_ * (Ab_(i).transpose() * Ab_j));
       }
       // Fill diagonal block with Aj'*Aj
-      info->diagonalBlock(J).rankUpdate(Ab_j.transpose());
+      info->diagonalBlock(J).rankUpdate(Ab_j.transpose(), activationWeight_);
     }
   }
 }
@@ -804,28 +884,20 @@ void JacobianFactor::setModel(bool anyConstrained, const Vector& sigmas) {
 }
 
 /* ************************************************************************* */
-std::pair<GaussianConditional::shared_ptr, JacobianFactor::shared_ptr> EliminateQR(
-    const GaussianFactorGraph& factors, const Ordering& keys) {
-  gttic(EliminateQR);
-  // Combine and sort variable blocks in elimination order
-  JacobianFactor::shared_ptr jointFactor;
-  try {
-    jointFactor = boost::make_shared<JacobianFactor>(factors, keys);
-  } catch (std::invalid_argument&) {
-    throw InvalidDenseElimination(
-        "EliminateQR was called with a request to eliminate variables that are not\n"
-        "involved in the provided factors.");
-  }
-
+namespace {
+// Shared tail of the QR elimination variants: factorize the assembled joint
+// factor in place and split off the conditional on the eliminated keys
+std::pair<GaussianConditional::shared_ptr, JacobianFactor::shared_ptr> qrAndSplit(
+    const JacobianFactor::shared_ptr& jointFactor, const Ordering& keys) {
   // Do dense elimination
   // The following QR variants eliminate to fully triangular or trapezoidal
   SharedDiagonal noiseModel;
-  VerticalBlockMatrix& Ab = jointFactor->Ab_;
-  if (jointFactor->model_) {
+  VerticalBlockMatrix& Ab = jointFactor->matrixObject();
+  if (jointFactor->get_model()) {
     // The noiseModel QR can, in the case of constraints, yield a "staggered" QR where
     // some rows have more leading zeros than in an upper triangular matrix.
     // In either case, QR will put zeros below the "diagonal".
-    jointFactor->model_ = jointFactor->model_->QR(Ab.matrix());
+    jointFactor->get_model() = jointFactor->get_model()->QR(Ab.matrix());
   } else {
     // The inplace variant will have no valid rows anymore below m==n
     // and only entries above the diagonal are valid.
@@ -834,7 +906,7 @@ std::pair<GaussianConditional::shared_ptr, JacobianFactor::shared_ptr> Eliminate
     Ab.matrix().triangularView<Eigen::StrictlyLower>().setZero();
     size_t m = Ab.rows(), n = Ab.cols() - 1;
     size_t maxRank = min(m, n);
-    jointFactor->model_ = noiseModel::Unit::Create(maxRank);
+    jointFactor->get_model() = noiseModel::Unit::Create(maxRank);
   }
 
   // Split elimination result into conditional and remaining factor
@@ -843,6 +915,66 @@ std::pair<GaussianConditional::shared_ptr, JacobianFactor::shared_ptr> Eliminate
 
   return make_pair(conditional, jointFactor);
 }
+}  // namespace
+
+/* ************************************************************************* */
+std::pair<GaussianConditional::shared_ptr, JacobianFactor::shared_ptr> EliminateQR(
+    const GaussianFactorGraph& factors, const Ordering& keys) {
+  gttic(EliminateQR);
+  // Combine and sort variable blocks in elimination order
+  JacobianFactor::shared_ptr jointFactor;
+  try {
+    jointFactor = boost::make_shared<JacobianFactor>(factors, keys);
+  } catch (std::invalid_argument&) {
+    throw InvalidDenseElimination(
+        "EliminateQR was called with a request to eliminate variables that are not\n"
+        "involved in the provided factors.");
+  }
+
+  return qrAndSplit(jointFactor, keys);
+}
+
+/* ************************************************************************* */
+std::pair<GaussianConditional::shared_ptr, JacobianFactor::shared_ptr>
+CachedEliminateQR::operator()(const GaussianFactorGraph& factors,
+    const Ordering& keys) {
+  gttic(CachedEliminateQR);
+
+  // Look up the column layout for this clique, rebuilding it on the first
+  // call and whenever the structural check below detects a changed clique
+  FastMap<KeyVector, CliqueSlots>::iterator it = slots_.find(keys);
+  if (it != slots_.end()) {
+    bool structureMatches = (it->second.nrFactors == factors.size());
+    for (const GaussianFactor::shared_ptr& factor : factors) {
+      if (!structureMatches)
+        break;
+      if (factor)
+        for (Key key : *factor)
+          if (it->second.slots.find(key) == it->second.slots.end()) {
+            structureMatches = false;
+            break;
+          }
+    }
+    if (!structureMatches)
+      slots_.erase(it), it = slots_.end();
+  }
+  if (it == slots_.end())
+    it = slots_.emplace(keys,
+        CliqueSlots{factors.size(), VariableSlots(factors)}).first;
+
+  // Combine on the cached layout and sort variable blocks in elimination order
+  JacobianFactor::shared_ptr jointFactor;
+  try {
+    jointFactor = boost::make_shared<JacobianFactor>(factors, keys,
+        it->second.slots);
+  } catch (std::invalid_argument&) {
+    throw InvalidDenseElimination(
+        "CachedEliminateQR was called with a request to eliminate variables that are not\n"
+        "involved in the provided factors.");
+  }
+
+  return qrAndSplit(jointFactor, keys);
+}
 
 /* ************************************************************************* */
 GaussianConditional::shared_ptr JacobianFactor::splitConditional(size_t nrFrontals) {
@@ -872,8 +1004,12 @@ GaussianConditional::shared_ptr JacobianFactor::splitConditional(size_t nrFronta
   SharedDiagonal conditionalNoiseModel;
   conditionalNoiseModel =
       noiseModel::Diagonal::Sigmas(model_->sigmas().segment(Ab_.rowStart(), Ab_.rows()));
+  // Conditionals come out of the shared pooled allocator, like the cliques
+  // that hold them, to limit heap fragmentation across solver instances
   GaussianConditional::shared_ptr conditional =
-      boost::make_shared<GaussianConditional>(Base::keys_, nrFrontals, Ab_, conditionalNoiseModel);
+      boost::allocate_shared<GaussianConditional>(
+          internal::FastDefaultAllocator<GaussianConditional>::type(),
+          Base::keys_, nrFrontals, Ab_, conditionalNoiseModel);
 
   const DenseIndex maxRemainingRows =
       std::min(Ab_.cols(), originalRowEnd) - Ab_.rowStart() - frontalDim;
@@ -263,6 +263,13 @@ namespace gtsam {
     /** Check if the factor is empty.  TODO: How should this be defined? */
     bool empty() const override { return size() == 0 /*|| rows() == 0*/; }
 
+    /** Bytes occupied by this factor: the object, the key vector, and the
+     * augmented matrix storage (the shared noise model is excluded) */
+    size_t memoryUsage() const override {
+      return sizeof(*this) + keys_.capacity() * sizeof(Key)
+          + Ab_.matrix().size() * sizeof(double);
+    }
+
     /** is noise model constrained ? */
     bool isConstrained() const {
       return model_ && model_->isConstrained();
@@ -450,6 +457,48 @@ namespace gtsam {
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
   }; // JacobianFactor
+
+  /**
+   * Stateful variant of EliminateQR for optimizers that repeatedly eliminate
+   * a graph whose structure does not change between iterations, the QR
+   * counterpart of CachedEliminateCholesky.  The VariableSlots of each
+   * clique - the column ordering of the joint factor, i.e. the elimination
+   * "pivot" decisions - are built once, keyed by the elimination keys, and
+   * reused on all subsequent calls, leaving only the numeric combine and
+   * Householder sweep.  A cheap structural check re-derives the slots when
+   * the factors hitting a clique have changed, so a cache left populated
+   * across a structure change degrades to a rebuild rather than corrupting
+   * the layout.
+   *
+   * Pass an instance by reference as the eliminate function, e.g. with
+   * boost::ref, so that all cliques and iterations share a single cache, and
+   * call clear() whenever the graph structure or the ordering changes.
+   *
+   * \addtogroup LinearSolving */
+  class GTSAM_EXPORT CachedEliminateQR {
+  public:
+
+    /// Eliminate as EliminateQR does, reusing the clique VariableSlots if cached
+    std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<JacobianFactor> >
+      operator()(const GaussianFactorGraph& factors, const Ordering& keys);
+
+    /// Invalidate all cached slots, required when the structure changes
+    void clear() { slots_.clear(); }
+
+    /// Number of cliques cached so far
+    size_t size() const { return slots_.size(); }
+
+  private:
+    /// Cached column layout of one clique, with the factor count it was
+    /// derived from for the structural reuse check
+    struct CliqueSlots {
+      size_t nrFactors;
+      VariableSlots slots;
+    };
+
+    FastMap<KeyVector, CliqueSlots> slots_;
+  };
+
 /// traits
 template<>
 struct traits<JacobianFactor> : public Testable<JacobianFactor> {
@@ -0,0 +1,74 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file MultiHypothesisSolver.cpp
+ * @brief Shared-factorization solve of several graph variants that differ in
+ * a few factors
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/linear/MultiHypothesisSolver.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+MultiHypothesisSolver::MultiHypothesisSolver(const GaussianFactorGraph& common,
+    const KeyVector& branchKeys, const Eliminate& function)
+    : branchKeys_(branchKeys.begin(), branchKeys.end()), function_(function) {
+
+  // Constrain the branch variables to the end, then eliminate everything
+  // before them once; the remaining factors involve only branch variables
+  const Ordering full = Ordering::ColamdConstrainedLast(common, branchKeys);
+  Ordering shared;
+  for (Key key : full)
+    if (branchKeys_.find(key) == branchKeys_.end())
+      shared.push_back(key);
+  if (shared.empty())
+    throw std::invalid_argument(
+        "MultiHypothesisSolver: branchKeys covers every variable of the "
+        "common graph, no factorization can be shared");
+
+  boost::tie(sharedBayesNet_, remainingGraph_) =
+      common.eliminatePartialSequential(shared, function_);
+}
+
+/* ************************************************************************* */
+VectorValues MultiHypothesisSolver::solve(
+    const GaussianFactorGraph& hypothesisFactors) const {
+
+  // The hypothesis may only touch the variables declared at construction,
+  // otherwise the shared conditionals would be invalid for this variant
+  for (const GaussianFactor::shared_ptr& factor : hypothesisFactors) {
+    if (!static_cast<bool>(factor)) continue;
+    for (Key key : *factor)
+      if (branchKeys_.find(key) == branchKeys_.end())
+        throw std::invalid_argument(
+            "MultiHypothesisSolver: hypothesis factor involves a variable "
+            "outside branchKeys");
+  }
+
+  // Finish this hypothesis on its own small top
+  GaussianFactorGraph top(*remainingGraph_);
+  top.push_back(hypothesisFactors);
+  const VectorValues topSolution =
+      top.eliminateMultifrontal(boost::none, function_)->optimize();
+
+  // Backsubstitute the shared conditionals given the branch solution
+  return sharedBayesNet_->optimize(topSolution);
+}
+
+/* ************************************************************************* */
+} // \ namespace gtsam
@@ -0,0 +1,81 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file MultiHypothesisSolver.h
+ * @brief Shared-factorization solve of several graph variants that differ in
+ * a few factors
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+
+namespace gtsam {
+
+/**
+ * Solves K variants of a common Gaussian factor graph that differ only in a
+ * few factors - the data-association branches of a tracker evaluating
+ * alternative loop closures, say - without factorizing the common part K
+ * times.  On construction the variables the hypotheses touch are constrained
+ * to the end of a COLAMD ordering and everything before them is eliminated
+ * once; solve() then adds one hypothesis' factors to the small remaining
+ * graph, eliminates just that top, and backsubstitutes through the shared
+ * conditionals.  The shared work is done once, and each hypothesis costs an
+ * elimination of only the branch variables plus one backsubstitution sweep.
+ */
+class GTSAM_EXPORT MultiHypothesisSolver {
+
+ public:
+
+  typedef GaussianFactorGraph::Eliminate Eliminate;
+
+  /**
+   * Eliminate the part of the common graph not involving branchKeys.
+   * @param common the factors shared by all hypotheses
+   * @param branchKeys union of the keys touched by any hypothesis' factors
+   * @param function elimination function, Cholesky by default
+   * @throw std::invalid_argument if branchKeys covers all of the graph's
+   * variables, in which case there is nothing to share
+   */
+  MultiHypothesisSolver(const GaussianFactorGraph& common,
+      const KeyVector& branchKeys,
+      const Eliminate& function =
+          GaussianFactorGraph::EliminationTraitsType::DefaultEliminate);
+
+  /**
+   * Complete the solve for one hypothesis.
+   * @param hypothesisFactors the factors this hypothesis adds; they may only
+   * involve branchKeys
+   * @return the full solution for this variant of the graph
+   * @throw std::invalid_argument if a hypothesis factor involves a variable
+   * outside branchKeys
+   */
+  VectorValues solve(const GaussianFactorGraph& hypothesisFactors) const;
+
+  /// The conditionals of the shared part, eliminated once at construction
+  const GaussianBayesNet& sharedBayesNet() const { return *sharedBayesNet_; }
+
+  /// The factors remaining on the branch variables after shared elimination
+  const GaussianFactorGraph& remainingGraph() const { return *remainingGraph_; }
+
+ private:
+
+  KeySet branchKeys_; ///< keys the hypotheses may touch
+  Eliminate function_; ///< elimination function used for both phases
+  boost::shared_ptr<GaussianBayesNet> sharedBayesNet_; ///< shared conditionals
+  boost::shared_ptr<GaussianFactorGraph> remainingGraph_; ///< top on branch keys
+};
+
+} // \ namespace gtsam
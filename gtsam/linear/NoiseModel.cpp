@@ -25,6 +25,8 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 #include <typeinfo>
 
@@ -81,6 +83,14 @@ double Base::squaredMahalanobisDistance(const Vector& v) const {
   return w.dot(w);
 }
 
+/* ************************************************************************* */
+void Base::WhitenSystems(vector<vector<Matrix> >& A, vector<Vector>& b) const {
+  if (A.size() != b.size())
+    throw invalid_argument("Base::WhitenSystems: A and b have different numbers of factors");
+  for (size_t i = 0; i < A.size(); ++i)
+    WhitenSystem(A[i], b[i]);
+}
+
 /* ************************************************************************* */
 Gaussian::shared_ptr Gaussian::SqrtInformation(const Matrix& R, bool smart) {
   size_t m = R.rows(), n = R.cols();
@@ -163,7 +173,9 @@ Vector Gaussian::sigmas() const {
 
 /* ************************************************************************* */
 Vector Gaussian::whiten(const Vector& v) const {
-  return thisR() * v;
+  // R is upper triangular (cf. unwhiten and covariance), so a triangular
+  // product does half the work of the general multiply
+  return thisR().triangularView<Eigen::Upper>() * v;
 }
 
 /* ************************************************************************* */
@@ -173,17 +185,17 @@ Vector Gaussian::unwhiten(const Vector& v) const {
 
 /* ************************************************************************* */
 Matrix Gaussian::Whiten(const Matrix& H) const {
-  return thisR() * H;
+  return thisR().triangularView<Eigen::Upper>() * H;
 }
 
 /* ************************************************************************* */
 void Gaussian::WhitenInPlace(Matrix& H) const {
-  H = thisR() * H;
+  H = (thisR().triangularView<Eigen::Upper>() * H).eval();
 }
 
 /* ************************************************************************* */
 void Gaussian::WhitenInPlace(Eigen::Block<Matrix> H) const {
-  H = thisR() * H;
+  H = (thisR().triangularView<Eigen::Upper>() * H).eval();
 }
 
 /* ************************************************************************* */
@@ -310,7 +322,7 @@ void Diagonal::WhitenInPlace(Matrix& H) const {
 
 /* ************************************************************************* */
 void Diagonal::WhitenInPlace(Eigen::Block<Matrix> H) const {
-  H = invsigmas().asDiagonal() * H;
+  H.array().colwise() *= invsigmas().array();
 }
 
 /* ************************************************************************* */
@@ -586,6 +598,18 @@ Isotropic::shared_ptr Isotropic::Variance(size_t dim, double variance, bool smar
   return shared_ptr(new Isotropic(dim, sqrt(variance)));
 }
 
+/* ************************************************************************* */
+Isotropic::shared_ptr Isotropic::Interned(size_t dim, double sigma) {
+  typedef std::map<std::pair<size_t, double>, shared_ptr> InternMap;
+  static InternMap interned;
+  static std::mutex internMutex;
+  std::lock_guard<std::mutex> lock(internMutex);
+  shared_ptr& model = interned[std::make_pair(dim, sigma)];
+  if (!model)
+    model = Sigma(dim, sigma);
+  return model;
+}
+
 /* ************************************************************************* */
 void Isotropic::print(const string& name) const {
   cout << boost::format("isotropic dim=%1% sigma=%2%") % dim() % sigma_ << endl;
@@ -678,6 +702,25 @@ const RobustModel::shared_ptr &robust, const NoiseModel::shared_ptr noise){
   return shared_ptr(new Robust(robust,noise));
 }
 
+/* ************************************************************************* */
+Base::shared_ptr intern(const Base::shared_ptr& model) {
+  if (!model)
+    return model;
+  // Process-wide table of canonical models.  Models are immutable once
+  // constructed, so handing out the same instance repeatedly is safe.
+  static std::mutex tableMutex;
+  static vector<Base::shared_ptr> table;
+  std::unique_lock<std::mutex> lock(tableMutex);
+  for (const Base::shared_ptr& canonical : table) {
+    // equals() is type-checked, so an Isotropic never matches a Diagonal
+    // with the same sigmas
+    if (canonical == model || canonical->equals(*model))
+      return canonical;
+  }
+  table.push_back(model);
+  return model;
+}
+
 /* ************************************************************************* */
 
 }
@@ -117,6 +117,12 @@ namespace gtsam {
       virtual void WhitenSystem(Matrix& A1, Matrix& A2, Vector& b) const = 0;
       virtual void WhitenSystem(Matrix& A1, Matrix& A2, Matrix& A3, Vector& b) const = 0;
 
+      /** Whiten the systems of many factors that share this noise model in one
+       * call, e.g. all measurements of one sensor.  A[i]/b[i] hold the Jacobian
+       * blocks and right-hand side of the i-th factor.  Equivalent to calling
+       * WhitenSystem on each factor. */
+      void WhitenSystems(std::vector<std::vector<Matrix> >& A, std::vector<Vector>& b) const;
+
       /** in-place whiten, override if can be done more efficiently */
       virtual void whitenInPlace(Vector& v) const {
         v = whiten(v);
@@ -591,6 +597,18 @@ namespace gtsam {
         return Variance(dim, 1.0/precision, smart);
       }
 
+      /**
+       * An interned (flyweight) isotropic noise model: repeated requests for
+       * the same (dim, sigma) pair return the same shared instance, so the
+       * many factors sharing a measurement model also share one object
+       * instead of carrying duplicates.  This is the keyed fast path of
+       * noiseModel::intern() for the common isotropic case - the lookup is
+       * by (dim, sigma) and avoids constructing a throwaway model.  The
+       * table keeps one entry per distinct model requested; use Sigma()
+       * for one-off models.
+       */
+      static shared_ptr Interned(size_t dim, double sigma);
+
       void print(const std::string& name) const override;
       double squaredMahalanobisDistance(const Vector& v) const override;
       Vector whiten(const Vector& v) const override;
@@ -634,9 +652,18 @@ namespace gtsam {
       ~Unit() {}
 
       /**
-       * Create a unit covariance noise model
+       * Create a unit covariance noise model.  Unit models are immutable
+       * and requested constantly during elimination, so the common small
+       * dimensions are shared flyweight instances.
        */
       static shared_ptr Create(size_t dim) {
+        if(dim >= 1 && dim <= 6) {
+          static const shared_ptr flyweights[6] = {
+              shared_ptr(new Unit(1)), shared_ptr(new Unit(2)),
+              shared_ptr(new Unit(3)), shared_ptr(new Unit(4)),
+              shared_ptr(new Unit(5)), shared_ptr(new Unit(6))};
+          return flyweights[dim - 1];
+        }
         return shared_ptr(new Unit(dim));
       }
 
@@ -765,6 +792,18 @@ namespace gtsam {
     // Helper function
     GTSAM_EXPORT boost::optional<Vector> checkIfDiagonal(const Matrix M);
 
+    /**
+     * Return a canonical shared instance equal to the given noise model.
+     * Construction code that creates one noise model per factor - parsers
+     * and sensor pipelines building graphs with hundreds of thousands of
+     * factors - can intern each model so equal models collapse to a single
+     * shared instance, saving memory and improving cache behavior during
+     * linearization.  The canonical table is process-wide and thread-safe;
+     * lookup is a linear scan over the distinct models seen so far, so
+     * intern at construction time, not in inner loops over factors.
+     */
+    GTSAM_EXPORT Base::shared_ptr intern(const Base::shared_ptr& model);
+
   } // namespace noiseModel
 
   /** Note, deliberately not in noiseModel namespace.
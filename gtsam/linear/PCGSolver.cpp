@@ -60,6 +60,9 @@ void PCGSolverParameters::print(const std::string &s) const {
 VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
     const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
     const VectorValues &initial) {
+  if (parameters_.mixedPrecision())
+    return optimizeMixedPrecision(gfg, keyInfo, initial);
+
   /* build preconditioner */
   preconditioner_->build(gfg, keyInfo, lambda);
 
@@ -71,6 +74,143 @@ VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
   return buildVectorValues(sol, keyInfo);
 }
 
+/*****************************************************************************/
+namespace {
+
+/* y = A*x where A is the stored upper triangle of a symmetric CSR matrix;
+ * entries below the diagonal are mirrored on the fly */
+template<typename SCALAR>
+void symmetricUpperMatVec(const SparseCsrMatrix &A, const SCALAR *values,
+    const SCALAR *x, SCALAR *y) {
+  std::fill(y, y + A.rows, SCALAR(0));
+  for (std::int64_t i = 0; i < A.rows; ++i) {
+    SCALAR yi = 0;
+    const SCALAR xi = x[i];
+    for (std::int64_t k = A.rowPointers[i]; k < A.rowPointers[i + 1]; ++k) {
+      const std::int64_t j = A.columnIndices[k];
+      const SCALAR v = values[k];
+      yi += v * x[j];
+      if (j != i)
+        y[j] += v * xi;
+    }
+    y[i] += yi;
+  }
+}
+
+/* dot product of float vectors, accumulated in double */
+double floatDot(const std::vector<float> &x, const std::vector<float> &y) {
+  double sum = 0.0;
+  for (size_t i = 0; i < x.size(); ++i)
+    sum += static_cast<double>(x[i]) * static_cast<double>(y[i]);
+  return sum;
+}
+
+} // namespace
+
+/*****************************************************************************/
+VectorValues PCGSolver::optimizeMixedPrecision(const GaussianFactorGraph &gfg,
+    const KeyInfo &keyInfo, const VectorValues &initial) const {
+
+  // Assemble the Hessian once; the float copy is what the inner iterations
+  // stream, halving the memory bandwidth of every matvec
+  const SparseCsrMatrix A = gfg.sparseHessianCsr();
+  const std::int64_t n = A.cols;
+  std::vector<float> floatValues(A.values.begin(), A.values.end());
+
+  // Jacobi preconditioner in float; with upper-triangle storage the diagonal
+  // is the first stored entry of each row
+  std::vector<float> invDiag(n, 1.0f);
+  for (std::int64_t i = 0; i < n; ++i) {
+    const std::int64_t k = A.rowPointers[i];
+    if (k < A.rowPointers[i + 1] && A.columnIndices[k] == i
+        && A.values[k] > 0.0)
+      invDiag[i] = static_cast<float>(1.0 / A.values[k]);
+  }
+
+  // Columns of the CSR system follow sorted keys, which is exactly the
+  // iteration order of the KeyInfo map
+  Vector x = Vector::Zero(n);
+  {
+    std::int64_t offset = 0;
+    for (const KeyInfo::value_type& key_entry : keyInfo) {
+      x.segment(offset, key_entry.second.dim) = initial.at(key_entry.first);
+      offset += key_entry.second.dim;
+    }
+  }
+
+  // Double-precision refinement loop: the residual of the full system is
+  // always computed in double, so the correction solved in float below never
+  // limits the final accuracy
+  Vector r(n), Ax(n);
+  symmetricUpperMatVec<double>(A, A.values.data(), x.data(), Ax.data());
+  r = A.rhs - Ax;
+
+  double currentGamma = r.squaredNorm();
+  const double threshold = std::max(parameters_.epsilon_abs(),
+      parameters_.epsilon() * parameters_.epsilon() * currentGamma);
+
+  if (parameters_.verbosity() >= ConjugateGradientParameters::COMPLEXITY)
+    std::cout << "[PCG] mixed precision, ||r0||^2 = " << currentGamma
+        << ", threshold = " << threshold << std::endl;
+
+  std::vector<float> rf(n), d(n), p(n), q(n), z(n);
+  const size_t maxRefinements = 10;
+  for (size_t refinement = 0;
+      refinement < maxRefinements && currentGamma > threshold; ++refinement) {
+
+    // inner float32 conjugate gradient on A d = r, started at d = 0
+    for (std::int64_t i = 0; i < n; ++i) {
+      rf[i] = static_cast<float>(r[i]);
+      d[i] = 0.0f;
+      z[i] = rf[i] * invDiag[i];
+      p[i] = z[i];
+    }
+    double innerGamma = floatDot(rf, z);
+    // single precision cannot resolve much more than a 1e-6 relative decrease
+    const double innerThreshold = std::max(1e-12 * innerGamma,
+        parameters_.epsilon() * parameters_.epsilon() * innerGamma);
+
+    for (size_t k = 1; k <= parameters_.maxIterations()
+        && innerGamma > innerThreshold; ++k) {
+      symmetricUpperMatVec<float>(A, floatValues.data(), p.data(), q.data());
+      const double pq = floatDot(p, q);
+      if (pq <= 0.0)
+        break; // float round-off broke positive definiteness, refine outside
+      const double alpha = innerGamma / pq;
+      for (std::int64_t i = 0; i < n; ++i) {
+        d[i] += static_cast<float>(alpha) * p[i];
+        rf[i] -= static_cast<float>(alpha) * q[i];
+        z[i] = rf[i] * invDiag[i];
+      }
+      const double prevGamma = innerGamma;
+      innerGamma = floatDot(rf, z);
+      const double beta = innerGamma / prevGamma;
+      for (std::int64_t i = 0; i < n; ++i)
+        p[i] = z[i] + static_cast<float>(beta) * p[i];
+    }
+
+    // apply the correction and recompute the true residual in double
+    for (std::int64_t i = 0; i < n; ++i)
+      x[i] += static_cast<double>(d[i]);
+    symmetricUpperMatVec<double>(A, A.values.data(), x.data(), Ax.data());
+    r = A.rhs - Ax;
+    currentGamma = r.squaredNorm();
+
+    if (parameters_.verbosity() >= ConjugateGradientParameters::ERROR)
+      std::cout << "[PCG] refinement = " << refinement
+          << ", ||r||^2 = " << currentGamma << std::endl;
+  }
+
+  // scatter the solution back into VectorValues, sorted keys again
+  VectorValues result;
+  std::int64_t offset = 0;
+  for (const KeyInfo::value_type& key_entry : keyInfo) {
+    result.insert(key_entry.first, x.segment(offset, key_entry.second.dim));
+    offset += key_entry.second.dim;
+  }
+  return result;
+}
+
 /*****************************************************************************/
 GaussianFactorGraphSystem::GaussianFactorGraphSystem(
     const GaussianFactorGraph &gfg, const Preconditioner &preconditioner,
@@ -81,6 +81,18 @@ public:
       const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
       const VectorValues &initial);
 
+protected:
+
+  /**
+   * Mixed-precision path, taken when ConjugateGradientParameters has
+   * mixedPrecision set: assemble the Hessian once in CSR form, run the
+   * inner conjugate gradient iterations on a float32 copy with a Jacobi
+   * preconditioner, and wrap them in double-precision iterative refinement
+   * so the final accuracy is not limited by single precision.
+   */
+  VectorValues optimizeMixedPrecision(const GaussianFactorGraph &gfg,
+      const KeyInfo &keyInfo, const VectorValues &initial) const;
+
 };
 
 /**
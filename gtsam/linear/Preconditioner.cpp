@@ -7,6 +7,7 @@
  */
 
 #include <gtsam/inference/FactorGraph-inst.h>
+#include <gtsam/inference/MetisIndex.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/linear/Preconditioner.h>
@@ -15,9 +16,19 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <Eigen/Sparse>
 #include <iostream>
+#include <numeric>
 #include <vector>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+#include <gtsam/3rdparty/metis/include/metis.h>
+#endif
+
 using namespace std;
 
 namespace gtsam {
@@ -85,41 +96,47 @@ BlockJacobiPreconditioner::~BlockJacobiPreconditioner() { clean(); }
 void BlockJacobiPreconditioner::solve(const Vector& y, Vector &x) const {
 
   const size_t n = dims_.size();
-  double *ptr = buffer_, *dst = x.data();
-
   std::copy(y.data(), y.data() + y.rows(), x.data());
 
-  for ( size_t i = 0 ; i < n ; ++i ) {
+  /* the blocks are independent, so the triangular solves can run in parallel */
+  auto solveBlock = [this, &x](size_t i) {
     const size_t d = dims_[i];
-    const size_t sz = d*d;
-
-    const Eigen::Map<const Eigen::MatrixXd> R(ptr, d, d);
-    Eigen::Map<Eigen::VectorXd> b(dst, d, 1);
+    const Eigen::Map<const Eigen::MatrixXd> R(buffer_ + blockStart_[i], d, d);
+    Eigen::Map<Eigen::VectorXd> b(x.data() + rowStart_[i], d, 1);
     R.triangularView<Eigen::Lower>().solveInPlace(b);
-
-    dst += d;
-    ptr += sz;
-  }
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+      [&solveBlock](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) solveBlock(i);
+      });
+#else
+  for ( size_t i = 0 ; i < n ; ++i ) solveBlock(i);
+#endif
 }
 
 /***************************************************************************************/
 void BlockJacobiPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
-  const size_t n = dims_.size();
-  double *ptr = buffer_, *dst = x.data();
 
+  const size_t n = dims_.size();
   std::copy(y.data(), y.data() + y.rows(), x.data());
 
-  for ( size_t i = 0 ; i < n ; ++i ) {
+  auto solveBlock = [this, &x](size_t i) {
     const size_t d = dims_[i];
-    const size_t sz = d*d;
-
-    const Eigen::Map<const Eigen::MatrixXd> R(ptr, d, d);
-    Eigen::Map<Eigen::VectorXd> b(dst, d, 1);
+    const Eigen::Map<const Eigen::MatrixXd> R(buffer_ + blockStart_[i], d, d);
+    Eigen::Map<Eigen::VectorXd> b(x.data() + rowStart_[i], d, 1);
     R.transpose().triangularView<Eigen::Upper>().solveInPlace(b);
-
-    dst += d;
-    ptr += sz;
-  }
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+      [&solveBlock](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) solveBlock(i);
+      });
+#else
+  for ( size_t i = 0 ; i < n ; ++i ) solveBlock(i);
+#endif
 }
 
 /***************************************************************************************/
@@ -134,19 +151,27 @@ void BlockJacobiPreconditioner::build(
   /* prepare the buffer of block diagonals */
   std::vector<Matrix> blocks; blocks.reserve(n);
 
-  /* allocate memory for the factorization of block diagonals */
-  size_t nnz = 0;
+  /* allocate memory for the factorization of block diagonals, and precompute
+   * each block's offset in the buffer and in the rhs vector so the blocks can
+   * be factorized and applied independently */
+  size_t nnz = 0, rows = 0;
+  blockStart_.resize(n);
+  rowStart_.resize(n);
   for ( size_t i = 0 ; i < n ; ++i ) {
     const size_t dim = dims_[i];
-    // blocks.push_back(Matrix::Zero(dim, dim));
+    blockStart_[i] = nnz;
+    rowStart_[i] = rows;
     // nnz += (((dim)*(dim+1)) >> 1); // d*(d+1) / 2  ;
     nnz += dim*dim;
+    rows += dim;
   }
 
-  /* getting the block diagonals over the factors */
-  std::map<Key, Matrix> hessianMap =gfg.hessianBlockDiagonal();
-  for ( const Matrix hessian: hessianMap | boost::adaptors::map_values)
-    blocks.push_back(hessian);
+  /* getting the block diagonals over the factors, in the order of keyInfo:
+   * solve() walks the buffer by ordering position, and a std::map iterates
+   * in key order, which only coincides with the "Natural" ordering */
+  std::map<Key, Matrix> hessianMap = gfg.hessianBlockDiagonal();
+  for ( const Key key: keyInfo.ordering() )
+    blocks.push_back(hessianMap.at(key));
 
   /* if necessary, allocating the memory for cacheing the factorization results */
   if ( nnz > bufferSize_ ) {
@@ -156,20 +181,26 @@ void BlockJacobiPreconditioner::build(
   }
   nnz_ = nnz;
 
-  /* factorizing the blocks respectively */
-  double *ptr = buffer_;
-  for ( size_t i = 0 ; i < n ; ++i ) {
+  /* factorizing the blocks respectively; embarrassingly parallel, as each
+   * block writes to its own precomputed slice of the buffer */
+  auto factorizeBlock = [this, &blocks](size_t i) {
     /* use eigen to decompose Di */
     /* It is same as L = chol(M,'lower') in MATLAB where M is full preconditioner */
     const Matrix L = blocks[i].llt().matrixL();
 
     /* store the data in the buffer */
-    size_t sz = dims_[i]*dims_[i] ;
-    std::copy(L.data(), L.data() + sz, ptr);
-
-    /* advance the pointer */
-    ptr += sz;
-  }
+    const size_t sz = dims_[i]*dims_[i] ;
+    std::copy(L.data(), L.data() + sz, buffer_ + blockStart_[i]);
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+      [&factorizeBlock](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) factorizeBlock(i);
+      });
+#else
+  for ( size_t i = 0 ; i < n ; ++i ) factorizeBlock(i);
+#endif
 }
 
 /*****************************************************************************/
@@ -182,6 +213,322 @@ void BlockJacobiPreconditioner::clean() {
   }
 }
 
+/***************************************************************************************/
+struct IncompleteCholeskyPreconditioner::Factorization {
+  typedef Eigen::IncompleteCholesky<double, Eigen::Lower,
+      Eigen::NaturalOrdering<int> > IncompleteCholesky;
+  IncompleteCholesky ichol;
+};
+
+/***************************************************************************************/
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner(
+    const IncompleteCholeskyPreconditionerParameters &p)
+  : Base(), factorization_(boost::make_shared<Factorization>()), parameters_(p) {}
+
+/***************************************************************************************/
+IncompleteCholeskyPreconditioner::~IncompleteCholeskyPreconditioner() {}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::solve(const Vector& y, Vector &x) const {
+  /* M = S^{-1} L L^T S^{-1}, so the "L" half of the preconditioner is
+   * S^{-1} L and its inverse is applied as L^{-1} S y */
+  const Factorization::IncompleteCholesky &ichol = factorization_->ichol;
+  x = ichol.scalingS().cwiseProduct(y);
+  x = ichol.matrixL().triangularView<Eigen::Lower>().solve(x);
+}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  const Factorization::IncompleteCholesky &ichol = factorization_->ichol;
+  x = ichol.matrixL().adjoint().triangularView<Eigen::Upper>().solve(y);
+  x = ichol.scalingS().cwiseProduct(x);
+}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  const size_t n = keyInfo.numCols();
+
+  /* assemble the lower triangle of the Hessian at the sparsity of the graph,
+   * laid out by the scalar column offsets in keyInfo */
+  typedef Eigen::Triplet<double> Triplet;
+  std::vector<Triplet> triplets;
+  for ( const GaussianFactor::shared_ptr &factor: gfg ) {
+    if ( !factor ) continue;
+    const Matrix augmented = factor->augmentedInformation();
+    const KeyVector &keys = factor->keys();
+    const size_t nrKeys = keys.size();
+
+    /* offset of each key's block within the factor and within the Hessian */
+    std::vector<size_t> localStart(nrKeys), globalStart(nrKeys), blockDim(nrKeys);
+    size_t local = 0;
+    for ( size_t k = 0 ; k < nrKeys ; ++k ) {
+      const KeyInfoEntry &entry = keyInfo.find(keys[k])->second;
+      localStart[k] = local;
+      globalStart[k] = entry.start;
+      blockDim[k] = entry.dim;
+      local += entry.dim;
+    }
+
+    for ( size_t k2 = 0 ; k2 < nrKeys ; ++k2 ) {
+      for ( size_t k1 = 0 ; k1 < nrKeys ; ++k1 ) {
+        for ( size_t c = 0 ; c < blockDim[k2] ; ++c ) {
+          for ( size_t r = 0 ; r < blockDim[k1] ; ++r ) {
+            const size_t row = globalStart[k1] + r, col = globalStart[k2] + c;
+            if ( row < col ) continue;
+            const double value = augmented(localStart[k1] + r, localStart[k2] + c);
+            if ( value != 0.0 ) triplets.push_back(Triplet(row, col, value));
+          }
+        }
+      }
+    }
+  }
+
+  Eigen::SparseMatrix<double> hessian(n, n);
+  hessian.setFromTriplets(triplets.begin(), triplets.end());
+
+  Factorization::IncompleteCholesky &ichol = factorization_->ichol;
+  ichol.setInitialShift(parameters_.shift_);
+  ichol.compute(hessian);
+  if ( ichol.info() != Eigen::Success )
+    throw std::runtime_error(
+        "IncompleteCholeskyPreconditioner::build: factorization failed");
+}
+
+/***************************************************************************************/
+struct AdditiveSchwarzPreconditioner::Subdomains {
+  struct Subdomain {
+    /* (global scalar offset, dimension) of each core variable, local order */
+    std::vector<std::pair<size_t, size_t> > segments;
+    Matrix L;    ///< Cholesky factor of the core Schur complement
+    size_t dim;  ///< total core dimension
+  };
+  std::vector<Subdomain> domains;
+};
+
+/***************************************************************************************/
+AdditiveSchwarzPreconditioner::AdditiveSchwarzPreconditioner(
+    const AdditiveSchwarzPreconditionerParameters &p)
+  : Base(), subdomains_(boost::make_shared<Subdomains>()), parameters_(p) {}
+
+/***************************************************************************************/
+AdditiveSchwarzPreconditioner::~AdditiveSchwarzPreconditioner() {}
+
+/***************************************************************************************/
+void AdditiveSchwarzPreconditioner::solve(const Vector& y, Vector &x) const {
+
+  const size_t n = subdomains_->domains.size();
+
+  /* the subdomains partition the variables, so the solves are independent */
+  auto solveDomain = [this, &y, &x](size_t i) {
+    const Subdomains::Subdomain &domain = subdomains_->domains[i];
+    Vector local(domain.dim);
+    size_t offset = 0;
+    for ( const std::pair<size_t, size_t> &segment: domain.segments ) {
+      local.segment(offset, segment.second) = y.segment(segment.first, segment.second);
+      offset += segment.second;
+    }
+    domain.L.triangularView<Eigen::Lower>().solveInPlace(local);
+    offset = 0;
+    for ( const std::pair<size_t, size_t> &segment: domain.segments ) {
+      x.segment(segment.first, segment.second) = local.segment(offset, segment.second);
+      offset += segment.second;
+    }
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+      [&solveDomain](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) solveDomain(i);
+      });
+#else
+  for ( size_t i = 0 ; i < n ; ++i ) solveDomain(i);
+#endif
+}
+
+/***************************************************************************************/
+void AdditiveSchwarzPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+
+  const size_t n = subdomains_->domains.size();
+
+  auto solveDomain = [this, &y, &x](size_t i) {
+    const Subdomains::Subdomain &domain = subdomains_->domains[i];
+    Vector local(domain.dim);
+    size_t offset = 0;
+    for ( const std::pair<size_t, size_t> &segment: domain.segments ) {
+      local.segment(offset, segment.second) = y.segment(segment.first, segment.second);
+      offset += segment.second;
+    }
+    domain.L.transpose().triangularView<Eigen::Upper>().solveInPlace(local);
+    offset = 0;
+    for ( const std::pair<size_t, size_t> &segment: domain.segments ) {
+      x.segment(segment.first, segment.second) = local.segment(offset, segment.second);
+      offset += segment.second;
+    }
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+      [&solveDomain](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) solveDomain(i);
+      });
+#else
+  for ( size_t i = 0 ; i < n ; ++i ) solveDomain(i);
+#endif
+}
+
+/***************************************************************************************/
+void AdditiveSchwarzPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  /* integer variable ids and CSR adjacency of the variable graph */
+  const MetisIndex met(gfg);
+  const size_t m = met.nValues();
+  const std::vector<int32_t> &xadj = met.xadj(), &adj = met.adj();
+
+  subdomains_->domains.clear();
+  if ( m == 0 ) return;
+
+  const size_t numDomains = std::min(std::max<size_t>(1, parameters_.numDomains_), m);
+
+  /* assign each variable to a core subdomain */
+  std::vector<int32_t> part(m, 0);
+  bool partitioned = (numDomains == 1);
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+  if ( !partitioned ) {
+    idx_t nvtxs = m, ncon = 1, nparts = numDomains, objval;
+    std::vector<idx_t> xadjCopy = met.xadj(), adjCopy = met.adj(), partition(m);
+    if ( METIS_PartGraphKway(&nvtxs, &ncon, &xadjCopy[0], &adjCopy[0], nullptr,
+        nullptr, nullptr, &nparts, nullptr, nullptr, nullptr, &objval,
+        &partition[0]) == METIS_OK ) {
+      std::copy(partition.begin(), partition.end(), part.begin());
+      partitioned = true;
+    }
+  }
+#endif
+  if ( !partitioned ) {
+    /* without METIS, fall back to contiguous slabs of the variable ids */
+    const size_t chunk = (m + numDomains - 1) / numDomains;
+    for ( size_t i = 0 ; i < m ; ++i ) part[i] = static_cast<int32_t>(i / chunk);
+  }
+
+  std::vector<std::vector<int32_t> > coreNodes(numDomains);
+  for ( size_t i = 0 ; i < m ; ++i ) coreNodes[part[i]].push_back(i);
+
+  /* per-domain local layout: core variables first, then the overlap halo */
+  std::vector<std::vector<std::pair<Key, size_t> > > localKeys(numDomains);
+  std::vector<size_t> coreDim(numDomains, 0), totalDim(numDomains, 0);
+  std::map<Key, std::vector<size_t> > keyDomains;
+  subdomains_->domains.resize(numDomains);
+  for ( size_t d = 0 ; d < numDomains ; ++d ) {
+
+    /* extend the core by overlap adjacency rings */
+    std::set<int32_t> local(coreNodes[d].begin(), coreNodes[d].end());
+    std::vector<int32_t> frontier = coreNodes[d], halo;
+    for ( size_t ring = 0 ; ring < parameters_.overlap_ ; ++ring ) {
+      std::vector<int32_t> next;
+      for ( int32_t u: frontier ) {
+        for ( int32_t k = xadj[u] ; k < xadj[u+1] ; ++k ) {
+          if ( local.insert(adj[k]).second ) {
+            next.push_back(adj[k]);
+            halo.push_back(adj[k]);
+          }
+        }
+      }
+      frontier.swap(next);
+    }
+
+    Subdomains::Subdomain &domain = subdomains_->domains[d];
+    for ( int32_t node: coreNodes[d] ) {
+      const Key key = met.intToKey(node);
+      const KeyInfoEntry &entry = keyInfo.find(key)->second;
+      localKeys[d].push_back(std::make_pair(key, totalDim[d]));
+      keyDomains[key].push_back(d);
+      domain.segments.push_back(std::make_pair(entry.start, entry.dim));
+      totalDim[d] += entry.dim;
+    }
+    coreDim[d] = totalDim[d];
+    domain.dim = coreDim[d];
+    for ( int32_t node: halo ) {
+      const Key key = met.intToKey(node);
+      const KeyInfoEntry &entry = keyInfo.find(key)->second;
+      localKeys[d].push_back(std::make_pair(key, totalDim[d]));
+      keyDomains[key].push_back(d);
+      totalDim[d] += entry.dim;
+    }
+  }
+
+  /* local key -> scalar offset maps, and the local sub-Hessians */
+  std::vector<std::map<Key, size_t> > localStart(numDomains);
+  std::vector<Matrix> localHessian(numDomains);
+  for ( size_t d = 0 ; d < numDomains ; ++d ) {
+    for ( const std::pair<Key, size_t> &key_offset: localKeys[d] )
+      localStart[d].insert(key_offset);
+    localHessian[d] = Matrix::Zero(totalDim[d], totalDim[d]);
+  }
+
+  /* scatter each factor's information into every subdomain it touches */
+  for ( const GaussianFactor::shared_ptr &factor: gfg ) {
+    if ( !factor ) continue;
+    const Matrix augmented = factor->augmentedInformation();
+    const KeyVector &keys = factor->keys();
+    const size_t nrKeys = keys.size();
+
+    std::vector<size_t> factorStart(nrKeys), blockDim(nrKeys);
+    std::set<size_t> touched;
+    size_t offset = 0;
+    for ( size_t k = 0 ; k < nrKeys ; ++k ) {
+      factorStart[k] = offset;
+      blockDim[k] = keyInfo.find(keys[k])->second.dim;
+      offset += blockDim[k];
+      const std::vector<size_t> &domains = keyDomains[keys[k]];
+      touched.insert(domains.begin(), domains.end());
+    }
+
+    for ( size_t d: touched ) {
+      const std::map<Key, size_t> &start = localStart[d];
+      for ( size_t k2 = 0 ; k2 < nrKeys ; ++k2 ) {
+        std::map<Key, size_t>::const_iterator it2 = start.find(keys[k2]);
+        if ( it2 == start.end() ) continue;
+        for ( size_t k1 = 0 ; k1 < nrKeys ; ++k1 ) {
+          std::map<Key, size_t>::const_iterator it1 = start.find(keys[k1]);
+          if ( it1 == start.end() ) continue;
+          localHessian[d].block(it1->second, it2->second, blockDim[k1], blockDim[k2])
+              += augmented.block(factorStart[k1], factorStart[k2], blockDim[k1], blockDim[k2]);
+        }
+      }
+    }
+  }
+
+  /* absorb the halo by a Schur complement onto the core, then factorize;
+   * embarrassingly parallel, as each subdomain is independent */
+  auto factorizeDomain = [this, &localHessian, &coreDim, &totalDim](size_t d) {
+    const size_t nc = coreDim[d], nh = totalDim[d] - nc;
+    Matrix S = localHessian[d].topLeftCorner(nc, nc);
+    if ( nh > 0 ) {
+      const Eigen::LLT<Matrix> lltHalo(localHessian[d].bottomRightCorner(nh, nh));
+      if ( lltHalo.info() == Eigen::Success )
+        S -= localHessian[d].topRightCorner(nc, nh)
+            * lltHalo.solve(localHessian[d].bottomLeftCorner(nh, nc));
+    }
+    const Eigen::LLT<Matrix> llt(S);
+    if ( llt.info() != Eigen::Success )
+      throw std::runtime_error(
+          "AdditiveSchwarzPreconditioner::build: subdomain factorization failed");
+    subdomains_->domains[d].L = llt.matrixL();
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numDomains),
+      [&factorizeDomain](const tbb::blocked_range<size_t>& range) {
+        for (size_t d = range.begin(); d != range.end(); ++d) factorizeDomain(d);
+      });
+#else
+  for ( size_t d = 0 ; d < numDomains ; ++d ) factorizeDomain(d);
+#endif
+}
+
 /***************************************************************************************/
 boost::shared_ptr<Preconditioner> createPreconditioner(
     const boost::shared_ptr<PreconditionerParameters> params) {
@@ -191,6 +538,14 @@ boost::shared_ptr<Preconditioner> createPreconditioner(
   } else if (dynamic_pointer_cast<BlockJacobiPreconditionerParameters>(
                  params)) {
     return boost::make_shared<BlockJacobiPreconditioner>();
+  } else if (auto ichol =
+                 dynamic_pointer_cast<IncompleteCholeskyPreconditionerParameters>(
+                     params)) {
+    return boost::make_shared<IncompleteCholeskyPreconditioner>(*ichol);
+  } else if (auto schwarz =
+                 dynamic_pointer_cast<AdditiveSchwarzPreconditionerParameters>(
+                     params)) {
+    return boost::make_shared<AdditiveSchwarzPreconditioner>(*schwarz);
   } else if (auto subgraph =
                  dynamic_pointer_cast<SubgraphPreconditionerParameters>(
                      params)) {
@@ -148,11 +148,101 @@ protected:
   void clean() ;
 
   std::vector<size_t> dims_;
+  std::vector<size_t> blockStart_;  ///< offset of each factorized block in buffer_
+  std::vector<size_t> rowStart_;    ///< offset of each block's rows in the rhs vector
   double *buffer_;
   size_t bufferSize_;
   size_t nnz_;
 };
 
+/*******************************************************************************************/
+struct GTSAM_EXPORT IncompleteCholeskyPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  IncompleteCholeskyPreconditionerParameters() : Base(), shift_(1e-3) {}
+  virtual ~IncompleteCholeskyPreconditionerParameters() {}
+
+  /// Initial diagonal shift, increased automatically if a pivot breaks down
+  double shift_;
+};
+
+/*******************************************************************************************/
+/**
+ * Zero fill-in incomplete Cholesky factorization of the Hessian, a stronger
+ * preconditioner than block-Jacobi: it retains the off-diagonal coupling
+ * between variables at the sparsity pattern of the graph. The factorization
+ * itself lives in the translation unit to keep sparse Eigen out of this header.
+ */
+class GTSAM_EXPORT IncompleteCholeskyPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+
+  IncompleteCholeskyPreconditioner(const IncompleteCholeskyPreconditionerParameters &p);
+  virtual ~IncompleteCholeskyPreconditioner() ;
+
+  /* Computation Interfaces for raw vector */
+  virtual void solve(const Vector& y, Vector &x) const;
+  virtual void transposeSolve(const Vector& y, Vector& x) const ;
+  virtual void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    ) ;
+
+protected:
+
+  struct Factorization;
+  boost::shared_ptr<Factorization> factorization_;
+  IncompleteCholeskyPreconditionerParameters parameters_;
+};
+
+/*******************************************************************************************/
+struct GTSAM_EXPORT AdditiveSchwarzPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  AdditiveSchwarzPreconditionerParameters() : Base(), numDomains_(8), overlap_(1) {}
+  virtual ~AdditiveSchwarzPreconditionerParameters() {}
+
+  /// Number of subdomains the variable graph is partitioned into
+  size_t numDomains_;
+
+  /// Number of adjacency rings each subdomain is extended past its core
+  size_t overlap_;
+};
+
+/*******************************************************************************************/
+/**
+ * Overlapping-domain additive Schwarz preconditioner. The variable graph is
+ * partitioned into numDomains subdomains with METIS (contiguous slabs of the
+ * variable ids when built without it), each subdomain is extended by overlap
+ * adjacency rings, and the dense sub-Hessian of each extended subdomain is
+ * factorized on its own. The overlapped variables are absorbed by taking the
+ * Schur complement onto the core variables, so the preconditioner stays
+ * symmetric positive definite and block-diagonal over the partition. Unlike
+ * the inherently sequential spanning-tree subgraph preconditioner, every
+ * subdomain factorization and every per-domain solve is independent.
+ */
+class GTSAM_EXPORT AdditiveSchwarzPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+
+  AdditiveSchwarzPreconditioner(const AdditiveSchwarzPreconditionerParameters &p);
+  virtual ~AdditiveSchwarzPreconditioner() ;
+
+  /* Computation Interfaces for raw vector */
+  virtual void solve(const Vector& y, Vector &x) const;
+  virtual void transposeSolve(const Vector& y, Vector& x) const ;
+  virtual void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    ) ;
+
+protected:
+
+  struct Subdomains;
+  boost::shared_ptr<Subdomains> subdomains_;
+  AdditiveSchwarzPreconditionerParameters parameters_;
+};
+
 /*********************************************************************************************/
 /* factory method to create preconditioners */
 boost::shared_ptr<Preconditioner> createPreconditioner(const boost::shared_ptr<PreconditionerParameters> parameters);
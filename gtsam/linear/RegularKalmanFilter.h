@@ -0,0 +1,211 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file RegularKalmanFilter.h
+ * @brief Kalman filter with compile-time fixed state dimension.
+ * Square-root information filter in preallocated stack matrices, no factor
+ * graph machinery.
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+
+#include <Eigen/QR>
+
+namespace gtsam {
+
+/**
+ * Fixed-dimension version of KalmanFilter, for high-rate loops where the
+ * state dimension is known at compile time.  Like KalmanFilter this is a
+ * square-root information filter: the state is an upper-triangular R and
+ * rhs d with d = R * mean, exactly what a GaussianDensity holds, but in
+ * fixed-size storage.  Each predict/update stacks the prior rows on top of
+ * the whitened model rows in a stack-allocated augmented matrix and
+ * re-triangularizes it with a dense QR, so no GaussianFactorGraph, shared
+ * pointers, or elimination ordering are involved and no heap allocation
+ * happens per step.
+ *
+ * The API mirrors KalmanFilter but is static and functional: states are
+ * plain value types.  Noise is given as a vector of sigmas (the diagonal
+ * models of KalmanFilter) or as a full covariance matrix (the *Q variants).
+ * Use KalmanFilter itself when the dimension is only known at runtime or
+ * when you need non-trivial elimination (e.g. smoothing).
+ */
+template<size_t N>
+class RegularKalmanFilter {
+
+public:
+
+  typedef Eigen::Matrix<double, N, N> MatrixN;
+  typedef Eigen::Matrix<double, N, 1> VectorN;
+
+  /**
+   * Square-root information state: the density on x is proportional to
+   * exp(-0.5 |R x - d|^2), with R upper-triangular.
+   */
+  struct State {
+    MatrixN R;
+    VectorN d;
+
+    VectorN mean() const {
+      return R.template triangularView<Eigen::Upper>().solve(d);
+    }
+
+    MatrixN information() const {
+      return R.transpose() * R;
+    }
+
+    MatrixN covariance() const {
+      const MatrixN Rinv = R.template triangularView<Eigen::Upper>().solve(
+          MatrixN::Identity());
+      return Rinv * Rinv.transpose();
+    }
+  };
+
+private:
+
+  /// Upper-triangular W with W' * W = Q^-1, i.e. rows whitened by W have
+  /// unit covariance under noise covariance Q
+  static MatrixN whitener(const MatrixN& Q) {
+    const MatrixN information = Q.inverse();
+    // LLT yields lower L with L * L' = Q^-1, so W = L' is what we want
+    return Eigen::LLT<MatrixN>(information).matrixL().transpose();
+  }
+
+  /// Re-triangularize stacked [prior; whitened model] rows and return the
+  /// posterior on the last N columns
+  template<int Rows, int Cols>
+  static State retriangularize(const Eigen::Matrix<double, Rows, Cols>& Ab) {
+    const Eigen::HouseholderQR<Eigen::Matrix<double, Rows, Cols> > qr(Ab);
+    const Eigen::Matrix<double, Rows, Cols>& T = qr.matrixQR();
+    State state;
+    // The posterior block starts where the state variable's columns start
+    const int first = Cols - 1 - static_cast<int>(N);
+    state.R = T.template block<N, N>(first, first)
+        .template triangularView<Eigen::Upper>();
+    state.d = T.template block<N, 1>(first, Cols - 1);
+    return state;
+  }
+
+public:
+
+  /**
+   * Create initial state, i.e., prior density at time k=0
+   * @param x0 estimate at time 0
+   * @param sigmas diagonal standard deviations of P0
+   */
+  static State init(const VectorN& x0, const VectorN& sigmas) {
+    State state;
+    state.R = sigmas.cwiseInverse().asDiagonal();
+    state.d = state.R * x0;
+    return state;
+  }
+
+  /// version of init with a full covariance matrix
+  static State init(const VectorN& x0, const MatrixN& P0) {
+    State state;
+    state.R = whitener(P0);
+    state.d = state.R * x0;
+    return state;
+  }
+
+  /**
+   * Predict the state P(x_{t+1}|Z^t) under the motion model
+   * x_{t+1} = F*x_{t} + B*u + w, with w zero-mean Gaussian with diagonal
+   * standard deviations sigmasQ.  See KalmanFilter::predict.
+   */
+  template<int M>
+  static State predict(const State& p, const MatrixN& F,
+      const Eigen::Matrix<double, N, M>& B,
+      const Eigen::Matrix<double, M, 1>& u, const VectorN& sigmasQ) {
+    const MatrixN W = sigmasQ.cwiseInverse().asDiagonal();
+    return predictWhitened(p, W * -F, W, W * (B * u));
+  }
+
+  /// version of predict with full covariance Q, see KalmanFilter::predictQ
+  template<int M>
+  static State predictQ(const State& p, const MatrixN& F,
+      const Eigen::Matrix<double, N, M>& B,
+      const Eigen::Matrix<double, M, 1>& u, const MatrixN& Q) {
+    const MatrixN W = whitener(Q);
+    return predictWhitened(p, W * -F, W, W * (B * u));
+  }
+
+  /**
+   * Version of predict with a general two-state motion constraint
+   * |A0*x_{t} + A1*x_{t+1} - b|^2, see KalmanFilter::predict2.
+   */
+  static State predict2(const State& p, const MatrixN& A0, const MatrixN& A1,
+      const VectorN& b, const VectorN& sigmas) {
+    const MatrixN W = sigmas.cwiseInverse().asDiagonal();
+    return predictWhitened(p, W * A0, W * A1, W * b);
+  }
+
+  /**
+   * Update with a measurement z = H*x_{t} + v, where v is zero-mean Gaussian
+   * with diagonal standard deviations sigmas.  The measurement dimension M
+   * is also fixed at compile time.  See KalmanFilter::update.
+   */
+  template<int M>
+  static State update(const State& p, const Eigen::Matrix<double, M, N>& H,
+      const Eigen::Matrix<double, M, 1>& z,
+      const Eigen::Matrix<double, M, 1>& sigmas) {
+    const Eigen::Matrix<double, M, M> W = sigmas.cwiseInverse().asDiagonal();
+    return updateWhitened<M>(p, W * H, W * z);
+  }
+
+  /// version of update with full covariance Q, see KalmanFilter::updateQ
+  template<int M>
+  static State updateQ(const State& p, const Eigen::Matrix<double, M, N>& H,
+      const Eigen::Matrix<double, M, 1>& z,
+      const Eigen::Matrix<double, M, M>& Q) {
+    const Eigen::Matrix<double, M, M> information = Q.inverse();
+    const Eigen::Matrix<double, M, M> W =
+        Eigen::LLT<Eigen::Matrix<double, M, M> >(information).matrixL()
+            .transpose();
+    return updateWhitened<M>(p, W * H, W * z);
+  }
+
+private:
+
+  /// Time update with already-whitened rows [A0 A1 b]: stack the prior on
+  /// x_{t} above them and eliminate x_{t} first, keeping P(x_{t+1})
+  static State predictWhitened(const State& p, const MatrixN& A0,
+      const MatrixN& A1, const VectorN& b) {
+    Eigen::Matrix<double, 2 * N, 2 * N + 1> Ab;
+    Ab.setZero();
+    Ab.template block<N, N>(0, 0) = p.R;
+    Ab.template block<N, 1>(0, 2 * N) = p.d;
+    Ab.template block<N, N>(N, 0) = A0;
+    Ab.template block<N, N>(N, N) = A1;
+    Ab.template block<N, 1>(N, 2 * N) = b;
+    return retriangularize<2 * N, 2 * N + 1>(Ab);
+  }
+
+  /// Measurement update with already-whitened rows [H z]
+  template<int M>
+  static State updateWhitened(const State& p,
+      const Eigen::Matrix<double, M, N>& H,
+      const Eigen::Matrix<double, M, 1>& z) {
+    Eigen::Matrix<double, N + M, N + 1> Ab;
+    Ab.template block<N, N>(0, 0) = p.R;
+    Ab.template block<N, 1>(0, N) = p.d;
+    Ab.template block<M, N>(N, 0) = H;
+    Ab.template block<M, 1>(N, N) = z;
+    return retriangularize<N + M, N + 1>(Ab);
+  }
+};
+
+} // \namespace gtsam
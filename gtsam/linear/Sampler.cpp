@@ -54,6 +54,45 @@ Vector Sampler::sample() const {
   return sampleDiagonal(sigmas);
 }
 
+/* ************************************************************************* */
+Matrix Sampler::sampleMatrix(size_t N) const {
+  assert(model_.get());
+  const Vector& sigmas = model_->sigmas();
+  Matrix result(sigmas.size(), N);
+  // Draw column by column so the generator stream matches repeated sample()
+  for (size_t j = 0; j < N; j++) result.col(j) = sampleDiagonal(sigmas);
+  return result;
+}
+
+/* ************************************************************************* */
+CovarianceSampler::CovarianceSampler(const Matrix& covariance,
+                                     uint_fast64_t seed)
+    : generator_(seed) {
+  if (covariance.rows() != covariance.cols())
+    throw std::invalid_argument(
+        "CovarianceSampler: covariance matrix is not square");
+  const Eigen::LLT<Matrix> llt(covariance);
+  if (llt.info() != Eigen::Success)
+    throw std::invalid_argument(
+        "CovarianceSampler: covariance matrix is not positive definite");
+  sqrtCovariance_ = llt.matrixL();
+}
+
+/* ************************************************************************* */
+Vector CovarianceSampler::sample() const { return sampleMatrix(1).col(0); }
+
+/* ************************************************************************* */
+Matrix CovarianceSampler::sampleMatrix(size_t N) const {
+  // Standard-normal draws, then one product against the cached square root
+  typedef std::normal_distribution<double> Normal;
+  Normal standard(0.0, 1.0);
+  Matrix draws(sqrtCovariance_.rows(), N);
+  for (size_t j = 0; j < N; j++)
+    for (DenseIndex i = 0; i < draws.rows(); i++)
+      draws(i, j) = standard(generator_);
+  return sqrtCovariance_ * draws;
+}
+
 /* ************************************************************************* */
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
 Sampler::Sampler(uint_fast64_t seed) : generator_(seed) {}
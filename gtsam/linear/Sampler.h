@@ -82,6 +82,13 @@ class GTSAM_EXPORT Sampler {
   /// sample from distribution
   Vector sample() const;
 
+  /**
+   * Draw N samples at once, one per column.  Columns reproduce exactly the
+   * sequence that N successive sample() calls would return, so a batch can
+   * replace a sampling loop without changing results.
+   */
+  Matrix sampleMatrix(size_t N) const;
+
   /// @}
 
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
@@ -97,4 +104,48 @@ class GTSAM_EXPORT Sampler {
   Vector sampleDiagonal(const Vector& sigmas) const;
 };
 
+/**
+ * Sampler for a full (possibly correlated) Gaussian given by a covariance
+ * matrix.  The Cholesky square root is computed once at construction and
+ * cached, so drawing never refactorizes: a single sample is one
+ * triangular-matrix product against a standard-normal draw, and a batch of N
+ * samples is one GEMM against a d x N matrix of standard-normal draws.
+ */
+class GTSAM_EXPORT CovarianceSampler {
+ protected:
+  /** cached lower-triangular Cholesky factor L, with covariance = L*L' */
+  Matrix sqrtCovariance_;
+
+  /** generator */
+  mutable std::mt19937_64 generator_;
+
+ public:
+  typedef boost::shared_ptr<CovarianceSampler> shared_ptr;
+
+  /**
+   * Create a sampler for a zero-mean Gaussian with the given covariance
+   * matrix, factorizing it once.  Throws std::invalid_argument if the
+   * covariance is not symmetric positive definite.
+   *
+   * NOTE: do not use zero as a seed, it will break the generator
+   */
+  explicit CovarianceSampler(const Matrix& covariance,
+                             uint_fast64_t seed = 42u);
+
+  size_t dim() const { return sqrtCovariance_.rows(); }
+
+  /// The cached square root, with covariance = L*L'
+  const Matrix& sqrtCovariance() const { return sqrtCovariance_; }
+
+  /// sample from distribution
+  Vector sample() const;
+
+  /**
+   * Draw N samples at once, one per column, in a single matrix product
+   * against the cached square root.  Columns reproduce exactly the sequence
+   * that N successive sample() calls would return.
+   */
+  Matrix sampleMatrix(size_t N) const;
+};
+
 }  // namespace gtsam
@@ -0,0 +1,64 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SolvePlanCache.cpp
+ * @brief Cache of symbolic solve plans keyed by graph structure
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/linear/SolvePlanCache.h>
+
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianBayesTree> SolvePlanCache::factorize(
+    const GaussianFactorGraph& graph,
+    const GaussianFactorGraph::Eliminate& function) {
+
+  const size_t hash = graph.structuralHash();
+
+  FastMap<size_t, Handle>::iterator item = plans_.find(hash);
+  if (item != plans_.end()) {
+    try {
+      boost::shared_ptr<GaussianBayesTree> bayesTree =
+          graph.numericFactorizeMultifrontal(item->second, function);
+      ++hits_;
+      return bayesTree;
+    } catch (std::invalid_argument&) {
+      // hash collision with a structurally different graph: drop the stale
+      // plan and re-analyze below
+      plans_.erase(item);
+    }
+  }
+
+  ++misses_;
+  if (plans_.size() >= maxPlans_)
+    plans_.erase(plans_.begin()); // plans are cheap to rebuild on demand
+
+  Handle handle = graph.analyzeMultifrontal();
+  boost::shared_ptr<GaussianBayesTree> bayesTree =
+      graph.numericFactorizeMultifrontal(handle, function);
+  plans_.insert(std::make_pair(hash, handle));
+  return bayesTree;
+}
+
+/* ************************************************************************* */
+VectorValues SolvePlanCache::optimize(const GaussianFactorGraph& graph,
+    const GaussianFactorGraph::Eliminate& function) {
+  return factorize(graph, function)->optimize();
+}
+
+/* ************************************************************************* */
+} // \ namespace gtsam
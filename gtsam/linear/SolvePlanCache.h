@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SolvePlanCache.h
+ * @brief Cache of symbolic solve plans keyed by graph structure
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/base/FastMap.h>
+
+namespace gtsam {
+
+/**
+ * Memoizes the symbolic half of multifrontal elimination across repeated
+ * solves of structurally identical graphs.  Per-frame graphs in tracking
+ * and odometry pipelines usually share factor types, keys, and dimensions
+ * from frame to frame - only the numbers change - so the ordering and
+ * amalgamated clique structure computed by analyzeMultifrontal are the same
+ * every frame.  The cache keys plans on
+ * GaussianFactorGraph::structuralHash() and replays the numeric phase only;
+ * should a hash collide with a structurally different graph, the stale plan
+ * is detected by numericFactorizeMultifrontal, dropped, and recomputed.
+ */
+class GTSAM_EXPORT SolvePlanCache {
+
+ public:
+
+  typedef GaussianFactorGraph::BaseEliminateable::SymbolicSolveHandle Handle;
+
+  /// Cache at most maxPlans plans; an arbitrary plan is evicted when full
+  explicit SolvePlanCache(size_t maxPlans = 16)
+      : maxPlans_(maxPlans), hits_(0), misses_(0) {}
+
+  /**
+   * Factorize the graph into a Bayes tree, reusing the symbolic plan cached
+   * under the graph's structural hash when one exists, and caching the plan
+   * computed on a miss.
+   */
+  boost::shared_ptr<GaussianBayesTree> factorize(
+      const GaussianFactorGraph& graph,
+      const GaussianFactorGraph::Eliminate& function =
+          GaussianFactorGraph::EliminationTraitsType::DefaultEliminate);
+
+  /// Factorize and back-substitute, see factorize
+  VectorValues optimize(const GaussianFactorGraph& graph,
+      const GaussianFactorGraph::Eliminate& function =
+          GaussianFactorGraph::EliminationTraitsType::DefaultEliminate);
+
+  /// Number of cached plans
+  size_t size() const { return plans_.size(); }
+
+  /// Number of solves that reused a cached plan
+  size_t hits() const { return hits_; }
+
+  /// Number of solves that had to run the symbolic phase
+  size_t misses() const { return misses_; }
+
+  /// Drop all cached plans and reset the counters
+  void clear() {
+    plans_.clear();
+    hits_ = misses_ = 0;
+  }
+
+ private:
+
+  FastMap<size_t, Handle> plans_; ///< plans keyed by structural hash
+  size_t maxPlans_; ///< capacity before eviction
+  size_t hits_; ///< solves served from the cache
+  size_t misses_; ///< solves that ran the symbolic phase
+};
+
+} // \ namespace gtsam
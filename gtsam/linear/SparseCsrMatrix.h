@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SparseCsrMatrix.h
+ * @brief Compressed-sparse-row storage with a plain C-compatible view,
+ * for handing linear systems to external sparse solvers.
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/base/Vector.h>
+#include <gtsam/dllexport.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Non-owning compressed-sparse-row view of a sparse matrix, as consumed by
+ * external solvers (MKL PARDISO, CHOLMOD, cuDSS).  This is a standard-layout
+ * struct of fixed-width integers and raw pointers, so it can be passed
+ * across a C ABI unchanged; the field order is part of that ABI and must not
+ * change.  The pointers borrow storage from the SparseCsrMatrix that
+ * produced the view, which must stay alive while the view is in use.
+ */
+struct SparseCsrView {
+  std::int64_t rows;                  ///< number of rows
+  std::int64_t cols;                  ///< number of columns
+  std::int64_t nnz;                   ///< number of stored entries
+  const std::int64_t* rowPointers;    ///< rows + 1 entries, rowPointers[0] == 0
+  const std::int64_t* columnIndices;  ///< nnz entries, ascending within each row
+  const double* values;               ///< nnz entries
+  const double* rhs;                  ///< right-hand side, null if not supplied
+  std::int64_t rhsSize;               ///< number of rhs entries, 0 if null
+};
+
+/**
+ * Owning zero-based CSR storage.  Produced by
+ * GaussianFactorGraph::sparseJacobianCsr and sparseHessianCsr, which fill
+ * the three arrays in one pass without a triplet intermediate.  Entries
+ * inside factor blocks are stored even when numerically zero, so the
+ * sparsity pattern is stable across relinearizations of the same graph and
+ * a solver's symbolic analysis can be reused.
+ */
+class GTSAM_EXPORT SparseCsrMatrix {
+ public:
+  std::int64_t rows;                       ///< number of rows
+  std::int64_t cols;                       ///< number of columns
+  std::vector<std::int64_t> rowPointers;   ///< rows + 1 entries
+  std::vector<std::int64_t> columnIndices; ///< nnz entries
+  std::vector<double> values;              ///< nnz entries
+  Vector rhs;                              ///< right-hand side, empty if none
+
+  SparseCsrMatrix() : rows(0), cols(0) {}
+
+  /// number of stored entries
+  std::int64_t nnz() const { return static_cast<std::int64_t>(values.size()); }
+
+  /// C-compatible view borrowing this object's storage
+  SparseCsrView view() const {
+    SparseCsrView v;
+    v.rows = rows;
+    v.cols = cols;
+    v.nnz = nnz();
+    v.rowPointers = rowPointers.data();
+    v.columnIndices = columnIndices.data();
+    v.values = values.data();
+    v.rhs = rhs.size() > 0 ? rhs.data() : nullptr;
+    v.rhsSize = rhs.size();
+    return v;
+  }
+};
+
+}  // namespace gtsam
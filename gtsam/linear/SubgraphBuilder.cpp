@@ -27,8 +27,15 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/serialization/vector.hpp>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/parallel_sort.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 #include <algorithm>
 #include <cmath>
 #include <fstream>
@@ -51,23 +58,30 @@ using std::vector;
 namespace gtsam {
 
 /*****************************************************************************/
-/* sort the container and return permutation index with default comparator */
+/* sort the container ascendingly and return the permutation index */
 template <typename Container>
 static vector<size_t> sort_idx(const Container &src) {
   typedef typename Container::value_type T;
   const size_t n = src.size();
-  vector<std::pair<size_t, T> > tmp;
+  vector<std::pair<T, size_t> > tmp;
   tmp.reserve(n);
-  for (size_t i = 0; i < n; i++) tmp.emplace_back(i, src[i]);
-
-  /* sort */
-  std::stable_sort(tmp.begin(), tmp.end());
+  for (size_t i = 0; i < n; i++) tmp.emplace_back(src[i], i);
+
+  // Sort by value with the index as tiebreak.  That makes the order a
+  // strict total order, so the (unstable) parallel sort below returns the
+  // same permutation as a stable serial sort: the result is deterministic
+  // across runs and thread counts.
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_sort(tmp.begin(), tmp.end());
+#else
+  std::sort(tmp.begin(), tmp.end());
+#endif
 
   /* copy back */
   vector<size_t> idx;
   idx.reserve(n);
   for (size_t i = 0; i < n; i++) {
-    idx.push_back(tmp[i].first);
+    idx.push_back(tmp[i].second);
   }
   return idx;
 }
@@ -137,7 +151,8 @@ void SubgraphBuilderParameters::print(ostream &os) const {
      << "skeleton weight:     " << skeletonWeightTranslator(skeletonWeight)
      << endl
      << "augmentation weight: "
-     << augmentationWeightTranslator(augmentationWeight) << endl;
+     << augmentationWeightTranslator(augmentationWeight) << endl
+     << "seed:                " << seed << endl;
 }
 
 /*****************************************************************************/
@@ -333,7 +348,8 @@ vector<size_t> SubgraphBuilder::kruskal(const GaussianFactorGraph &gfg,
   vector<size_t> treeIndices;
   treeIndices.reserve(n - 1);
 
-  // container for acsendingly sorted edges
+  // The greedy merge loop below must scan the edges in sorted order, so it
+  // stays sequential; with path-halving find() the scan is near-linear.
   DSFVector dsf(n);
 
   size_t count = 0;
@@ -357,14 +373,39 @@ vector<size_t> SubgraphBuilder::kruskal(const GaussianFactorGraph &gfg,
 /****************************************************************/
 vector<size_t> SubgraphBuilder::sample(const vector<double> &weights,
                                        const size_t t) const {
-  std::mt19937 rng(42);  // TODO(frank): allow us to use a different seed
+  std::mt19937 rng(
+      static_cast<std::mt19937::result_type>(parameters_.seed));
   WeightedSampler<std::mt19937> sampler(&rng);
   return sampler.sampleWithoutReplacement(t, weights);
 }
 
+/*****************************************************************************/
+/* hash the structure of the graph - factor count and the keys of every
+ * factor - ignoring all numerical values */
+static size_t topologyHash(const GaussianFactorGraph &gfg) {
+  size_t seed = gfg.size();
+  for (const GaussianFactor::shared_ptr &gf : gfg) {
+    if (gf) {
+      boost::hash_combine(seed, gf->size());
+      for (const Key key : gf->keys()) boost::hash_combine(seed, key);
+    } else {
+      boost::hash_combine(seed, size_t(0));
+    }
+  }
+  return seed;
+}
+
 /****************************************************************/
 Subgraph SubgraphBuilder::operator()(const GaussianFactorGraph &gfg) const {
   const auto &p = parameters_;
+
+  // Reuse the cached subgraph if the graph topology is unchanged since the
+  // last call, e.g. between outer iterations of a nonlinear solve where only
+  // the linearization point moved.  The caller refactorizes the selected
+  // factors with their current values, so only the edge selection is reused.
+  const size_t topology = topologyHash(gfg);
+  if (topology == cachedTopology_ && cachedSubgraph_.size() > 0)
+    return cachedSubgraph_;
   const auto inverse_ordering = Ordering::Natural(gfg);
   const FastMap<Key, size_t> forward_ordering = inverse_ordering.invert();
   const size_t n = inverse_ordering.size(), m = gfg.size();
@@ -398,16 +439,59 @@ Subgraph SubgraphBuilder::operator()(const GaussianFactorGraph &gfg) const {
   subgraph.insert(subgraph.end(), tree.begin(), tree.end());
   subgraph.insert(subgraph.end(), offTree.begin(), offTree.end());
 
-  return Subgraph(subgraph);
+  cachedTopology_ = topology;
+  cachedSubgraph_ = Subgraph(subgraph);
+  return cachedSubgraph_;
 }
 
+#ifdef GTSAM_USE_TBB
+/****************************************************************/
+/* norm-based weight of a single factor, used by the parallel path below */
+static double factorWeight(const GaussianFactor::shared_ptr &gf,
+                           SubgraphBuilderParameters::SkeletonWeight type) {
+  if (JacobianFactor::shared_ptr jf =
+          boost::dynamic_pointer_cast<JacobianFactor>(gf)) {
+    return type == SubgraphBuilderParameters::RHS_2NORM
+               ? jf->getb().norm()
+               : std::sqrt(jf->getA().squaredNorm());
+  } else if (HessianFactor::shared_ptr hf =
+                 boost::dynamic_pointer_cast<HessianFactor>(gf)) {
+    return type == SubgraphBuilderParameters::RHS_2NORM
+               ? hf->linearTerm().norm()
+               : std::sqrt(hf->information().squaredNorm());
+  }
+  return 0.0;
+}
+#endif
+
 /****************************************************************/
 SubgraphBuilder::Weights SubgraphBuilder::weights(
     const GaussianFactorGraph &gfg) const {
   const size_t m = gfg.size();
   Weights weight;
-  weight.reserve(m);
 
+#ifdef GTSAM_USE_TBB
+  // The norm-based schemes do real per-factor work, so compute them in
+  // parallel.  EQUAL is trivial and RANDOM draws from a sequential RNG, so
+  // those fall through to the serial loop below.
+  if (parameters_.skeletonWeight == SubgraphBuilderParameters::RHS_2NORM ||
+      parameters_.skeletonWeight == SubgraphBuilderParameters::LHS_FNORM) {
+    weight.resize(m);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m),
+        [this, &gfg, &weight](const tbb::blocked_range<size_t> &range) {
+          for (size_t i = range.begin(); i != range.end(); ++i)
+            weight[i] = factorWeight(gfg[i], parameters_.skeletonWeight);
+        });
+    return weight;
+  }
+#endif
+
+  // Seeded generator for RANDOM weights, so the same seed on the same graph
+  // selects the same skeleton (std::rand would depend on global state)
+  std::mt19937 rng(static_cast<std::mt19937::result_type>(parameters_.seed));
+  std::uniform_int_distribution<int> randomWeight(1, 100);
+
+  weight.reserve(m);
   for (const GaussianFactor::shared_ptr &gf : gfg) {
     switch (parameters_.skeletonWeight) {
       case SubgraphBuilderParameters::EQUAL:
@@ -433,7 +517,7 @@ SubgraphBuilder::Weights SubgraphBuilder::weights(
       } break;
 
       case SubgraphBuilderParameters::RANDOM:
-        weight.push_back(std::rand() % 100 + 1.0);
+        weight.push_back(static_cast<double>(randomWeight(rng)));
         break;
 
       default:
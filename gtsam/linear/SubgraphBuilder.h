@@ -119,13 +119,18 @@ struct GTSAM_EXPORT SubgraphBuilderParameters {
   } augmentationWeight;
 
   /// factor multiplied with n, yields number of extra edges.
-  double augmentationFactor; 
+  double augmentationFactor;
+
+  /// seed for the RNG behind RANDOM skeleton weights and augmentation
+  /// sampling; the same seed on the same graph yields the same subgraph.
+  size_t seed;
 
   SubgraphBuilderParameters()
       : skeletonType(KRUSKAL),
         skeletonWeight(RANDOM),
         augmentationWeight(SKELETON),
-        augmentationFactor(1.0) {}
+        augmentationFactor(1.0),
+        seed(42) {}
   virtual ~SubgraphBuilderParameters() {}
 
   /* for serialization */
@@ -150,8 +155,16 @@ class GTSAM_EXPORT SubgraphBuilder {
 
   SubgraphBuilder(
       const SubgraphBuilderParameters &p = SubgraphBuilderParameters())
-      : parameters_(p) {}
+      : parameters_(p), cachedTopology_(0) {}
   virtual ~SubgraphBuilder() {}
+
+  /** Build a subgraph of the given factor graph to precondition with.  The
+   * result is cached keyed on the structural hash of the graph: when the same
+   * builder is called again on a graph with identical topology - as happens
+   * on every outer iteration of a nonlinear solve, where only the numerical
+   * values change - the cached subgraph is returned and the weight
+   * computation, spanning tree and augmentation sampling are all skipped.
+   * Not thread-safe: concurrent solves should use separate builders. */
   virtual Subgraph operator()(const GaussianFactorGraph &jfg) const;
 
  private:
@@ -168,6 +181,8 @@ class GTSAM_EXPORT SubgraphBuilder {
                              const size_t t) const;
   Weights weights(const GaussianFactorGraph &gfg) const;
   SubgraphBuilderParameters parameters_;
+  mutable size_t cachedTopology_;  ///< structural hash of the last graph seen
+  mutable Subgraph cachedSubgraph_;  ///< subgraph built for that topology
 };
 
 /** Select the factors in a factor graph according to the subgraph. */
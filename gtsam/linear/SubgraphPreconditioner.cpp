@@ -132,7 +132,8 @@ Errors SubgraphPreconditioner::operator*(const VectorValues& y) const {
   Errors e(y);
   VectorValues x = Rc1()->backSubstitute(y);   /* x=inv(R1)*y */
   Errors e2 = *Ab2() * x;                      /* A2*x */
-  e.splice(e.end(), e2);
+  e.insert(e.end(), std::make_move_iterator(e2.begin()),
+      std::make_move_iterator(e2.end()));
   return e;
 }
 
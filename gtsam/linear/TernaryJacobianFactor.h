@@ -0,0 +1,112 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file TernaryJacobianFactor.h
+ *
+ * @brief A ternary JacobianFactor specialization that uses fixed matrix math for speed
+ *
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/**
+ * A ternary JacobianFactor specialization that uses fixed matrix math for
+ * speed, e.g. for projection factors with a separate calibration variable.
+ * The block structure is fixed at compile time, so no per-factor block layout
+ * needs to be computed.
+ */
+template<int M, int N1, int N2, int N3>
+struct TernaryJacobianFactor: JacobianFactor {
+
+  /// Constructor
+  TernaryJacobianFactor(Key key1, const Eigen::Matrix<double, M, N1>& A1,
+      Key key2, const Eigen::Matrix<double, M, N2>& A2, //
+      Key key3, const Eigen::Matrix<double, M, N3>& A3,
+      const Eigen::Matrix<double, M, 1>& b, //
+      const SharedDiagonal& model = SharedDiagonal()) :
+      JacobianFactor(key1, A1, key2, A2, key3, A3, b, model) {
+  }
+
+  inline Key key1() const {
+    return keys_[0];
+  }
+  inline Key key2() const {
+    return keys_[1];
+  }
+  inline Key key3() const {
+    return keys_[2];
+  }
+
+  // Fixed-size matrix update
+  void updateHessian(const KeyVector& infoKeys,
+      SymmetricBlockMatrix* info) const {
+    gttic(updateHessian_TernaryJacobianFactor);
+    // Whiten the factor if it has a noise model
+    const SharedDiagonal& model = get_model();
+    if (model && !model->isUnit()) {
+      if (model->isConstrained())
+        throw std::invalid_argument(
+            "TernaryJacobianFactor::updateHessian: cannot update information with "
+                "constrained noise model");
+      TernaryJacobianFactor whitenedFactor(key1(),
+          model->Whiten(getA(begin())), key2(), model->Whiten(getA(begin() + 1)),
+          key3(), model->Whiten(getA(begin() + 2)), model->whiten(getb()));
+      whitenedFactor.setActivationWeight(activationWeight());
+      whitenedFactor.updateHessian(infoKeys, info);
+    } else {
+      // First build an array of slots
+      DenseIndex slot1 = Slot(infoKeys, key1());
+      DenseIndex slot2 = Slot(infoKeys, key2());
+      DenseIndex slot3 = Slot(infoKeys, key3());
+      DenseIndex slotB = info->nBlocks() - 1;
+
+      const Matrix& Ab = Ab_.matrix();
+      Eigen::Block<const Matrix, M, N1> A1(Ab, 0, 0);
+      Eigen::Block<const Matrix, M, N2> A2(Ab, 0, N1);
+      Eigen::Block<const Matrix, M, N3> A3(Ab, 0, N1 + N2);
+      Eigen::Block<const Matrix, M, 1> b(Ab, 0, N1 + N2 + N3);
+
+      // We perform I += w * A'*A to the upper triangle
+      info->diagonalBlock(slot1).rankUpdate(A1.transpose(), activationWeight_);
+      info->updateOffDiagonalBlock(slot1, slot2,
+          activationWeight_ * (A1.transpose() * A2));
+      info->updateOffDiagonalBlock(slot1, slot3,
+          activationWeight_ * (A1.transpose() * A3));
+      info->updateOffDiagonalBlock(slot1, slotB,
+          activationWeight_ * (A1.transpose() * b));
+      info->diagonalBlock(slot2).rankUpdate(A2.transpose(), activationWeight_);
+      info->updateOffDiagonalBlock(slot2, slot3,
+          activationWeight_ * (A2.transpose() * A3));
+      info->updateOffDiagonalBlock(slot2, slotB,
+          activationWeight_ * (A2.transpose() * b));
+      info->diagonalBlock(slot3).rankUpdate(A3.transpose(), activationWeight_);
+      info->updateOffDiagonalBlock(slot3, slotB,
+          activationWeight_ * (A3.transpose() * b));
+      info->updateDiagonalBlock(slotB, activationWeight_ * (b.transpose() * b));
+    }
+  }
+};
+
+template<int M, int N1, int N2, int N3>
+struct traits<TernaryJacobianFactor<M, N1, N2, N3> > : Testable<
+    TernaryJacobianFactor<M, N1, N2, N3> > {
+};
+
+} //namespace gtsam
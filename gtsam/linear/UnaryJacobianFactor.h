@@ -0,0 +1,84 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file UnaryJacobianFactor.h
+ *
+ * @brief A unary JacobianFactor specialization that uses fixed matrix math for speed
+ *
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/**
+ * A unary JacobianFactor specialization that uses fixed matrix math for speed,
+ * the single-variable sibling of BinaryJacobianFactor
+ */
+template<int M, int N>
+struct UnaryJacobianFactor: JacobianFactor {
+
+  /// Constructor
+  UnaryJacobianFactor(Key key, const Eigen::Matrix<double, M, N>& A,
+      const Eigen::Matrix<double, M, 1>& b, //
+      const SharedDiagonal& model = SharedDiagonal()) :
+      JacobianFactor(key, A, b, model) {
+  }
+
+  inline Key key() const {
+    return keys_[0];
+  }
+
+  // Fixed-size matrix update
+  void updateHessian(const KeyVector& infoKeys,
+      SymmetricBlockMatrix* info) const {
+    gttic(updateHessian_UnaryJacobianFactor);
+    // Whiten the factor if it has a noise model
+    const SharedDiagonal& model = get_model();
+    if (model && !model->isUnit()) {
+      if (model->isConstrained())
+        throw std::invalid_argument(
+            "UnaryJacobianFactor::updateHessian: cannot update information with "
+                "constrained noise model");
+      UnaryJacobianFactor whitenedFactor(key(), model->Whiten(getA(begin())),
+          model->whiten(getb()));
+      whitenedFactor.setActivationWeight(activationWeight());
+      whitenedFactor.updateHessian(infoKeys, info);
+    } else {
+      // First build an array of slots
+      DenseIndex slot = Slot(infoKeys, key());
+      DenseIndex slotB = info->nBlocks() - 1;
+
+      const Matrix& Ab = Ab_.matrix();
+      Eigen::Block<const Matrix, M, N> A(Ab, 0, 0);
+      Eigen::Block<const Matrix, M, 1> b(Ab, 0, N);
+
+      // We perform I += w * A'*A to the upper triangle
+      info->diagonalBlock(slot).rankUpdate(A.transpose(), activationWeight_);
+      info->updateOffDiagonalBlock(slot, slotB,
+          activationWeight_ * (A.transpose() * b));
+      info->updateDiagonalBlock(slotB, activationWeight_ * (b.transpose() * b));
+    }
+  }
+};
+
+template<int M, int N>
+struct traits<UnaryJacobianFactor<M, N> > : Testable<UnaryJacobianFactor<M, N> > {
+};
+
+} //namespace gtsam
@@ -202,6 +202,18 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  size_t VectorValues::memoryUsage() const {
+    size_t result = sizeof(VectorValues);
+    for(const value_type& key_value: *this) {
+      // Map node overhead (key, in-node vector, tree links) plus the heap
+      // storage owned by the dynamically-sized vector
+      result += sizeof(value_type) + 4 * sizeof(void*)
+          + key_value.second.size() * sizeof(double);
+    }
+    return result;
+  }
+
   /* ************************************************************************* */
   void VectorValues::swap(VectorValues& other) {
     this->values_.swap(other.values_);
@@ -228,8 +240,8 @@ namespace gtsam {
   /* ************************************************************************* */
   double VectorValues::dot(const VectorValues& v) const
   {
-    if(this->size() != v.size())
-      throw invalid_argument("VectorValues::dot called with a VectorValues of different structure");
+    check_hot(this->size() == v.size(),
+      invalid_argument("VectorValues::dot called with a VectorValues of different structure"));
     double result = 0.0;
     typedef boost::tuple<value_type, value_type> ValuePair;
     using boost::adaptors::map_values;
@@ -260,8 +272,8 @@ namespace gtsam {
   /* ************************************************************************* */
   VectorValues VectorValues::operator+(const VectorValues& c) const
   {
-    if(this->size() != c.size())
-      throw invalid_argument("VectorValues::operator+ called with different vector sizes");
+    check_hot(this->size() == c.size(),
+      invalid_argument("VectorValues::operator+ called with different vector sizes"));
     assert_throw(hasSameStructure(c),
       invalid_argument("VectorValues::operator+ called with different vector sizes"));
 
@@ -286,8 +298,8 @@ namespace gtsam {
   /* ************************************************************************* */
   VectorValues& VectorValues::operator+=(const VectorValues& c)
   {
-    if(this->size() != c.size())
-      throw invalid_argument("VectorValues::operator+= called with different vector sizes");
+    check_hot(this->size() == c.size(),
+      invalid_argument("VectorValues::operator+= called with different vector sizes"));
     assert_throw(hasSameStructure(c),
       invalid_argument("VectorValues::operator+= called with different vector sizes"));
 
@@ -322,8 +334,8 @@ namespace gtsam {
   /* ************************************************************************* */
   VectorValues VectorValues::operator-(const VectorValues& c) const
   {
-    if(this->size() != c.size())
-      throw invalid_argument("VectorValues::operator- called with different vector sizes");
+    check_hot(this->size() == c.size(),
+      invalid_argument("VectorValues::operator- called with different vector sizes"));
     assert_throw(hasSameStructure(c),
       invalid_argument("VectorValues::operator- called with different vector sizes"));
 
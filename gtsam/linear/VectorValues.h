@@ -130,17 +130,19 @@ namespace gtsam {
     /** Check whether a variable with key \c j exists. */
     bool exists(Key j) const { return find(j) != end(); }
 
+    /** The number of bytes of memory occupied by this container: per-entry
+     * map overhead plus the heap storage of each vector (\f$ O(n) \f$). */
+    size_t memoryUsage() const;
+
     /**
      * Read/write access to the vector value with key \c j, throws
      * std::out_of_range if \c j does not exist, identical to operator[](Key).
      */
     Vector& at(Key j) {
       iterator item = find(j);
-      if (item == end())
-        throw std::out_of_range(
-        "Requested variable '" + DefaultKeyFormatter(j) + "' is not in this VectorValues.");
-      else
-        return item->second;
+      check_hot(item != end(), std::out_of_range(
+        "Requested variable '" + DefaultKeyFormatter(j) + "' is not in this VectorValues."));
+      return item->second;
     }
 
     /**
@@ -149,11 +151,9 @@ namespace gtsam {
      */
     const Vector& at(Key j) const {
       const_iterator item = find(j);
-      if (item == end())
-        throw std::out_of_range(
-        "Requested variable '" + DefaultKeyFormatter(j) + "' is not in this VectorValues.");
-      else
-        return item->second;
+      check_hot(item != end(), std::out_of_range(
+        "Requested variable '" + DefaultKeyFormatter(j) + "' is not in this VectorValues."));
+      return item->second;
     }
 
     /** Read/write access to the vector value with key \c j, throws std::out_of_range if \c j does
@@ -285,7 +285,11 @@ namespace gtsam {
     /** Swap the data in this VectorValues with another. */
     void swap(VectorValues& other);
 
-    /** Check if this VectorValues has the same structure (keys and dimensions) as another */
+    /** Check if this VectorValues has the same structure (keys and dimensions)
+     *  as another.  This is the graph-assembly boundary check backing the
+     *  arithmetic operators: validate once here, and with
+     *  GTSAM_UNCHECKED_HOT_PATHS configured the per-call checks inside
+     *  operator+, operator-, dot etc. compile out of release builds. */
     bool hasSameStructure(const VectorValues other) const;
 
     /// @}
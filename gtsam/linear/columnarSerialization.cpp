@@ -0,0 +1,275 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    columnarSerialization.cpp
+ * @brief   Compact binary columnar file format for linear objects
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ */
+
+#include <gtsam/linear/columnarSerialization.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/HessianFactor.h>
+
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace columnar {
+
+/* ************************************************************************* */
+namespace {
+
+const char kMagic[8] = { 'G', 'T', 'S', 'A', 'M', 'C', 'O', 'L' };
+const uint32_t kFormatVersion = 1;
+const uint32_t kCompressionNone = 0;
+const size_t kAlignment = 64;
+
+// Per-factor type tags in a GaussianFactorGraph payload
+const uint32_t kFactorNull = 0;
+const uint32_t kFactorJacobian = 1;
+const uint32_t kFactorHessian = 2;
+
+} // \ anonymous namespace
+
+/* ************************************************************************* */
+void writeHeader(ostream& os, PayloadKind kind) {
+  writeRaw(os, kMagic, sizeof(kMagic));
+  writeScalar<uint32_t>(os, kFormatVersion);
+  writeScalar<uint32_t>(os, uint32_t(kind));
+  writeScalar<uint32_t>(os, kCompressionNone);
+  writeScalar<uint32_t>(os, 0); // reserved
+}
+
+/* ************************************************************************* */
+PayloadKind readHeader(istream& is) {
+  char magic[8];
+  readRaw(is, magic, sizeof(magic));
+  if (!std::equal(magic, magic + sizeof(magic), kMagic))
+    throw invalid_argument("loadColumnar: not a columnar file");
+  const uint32_t version = readScalar<uint32_t>(is);
+  if (version != kFormatVersion)
+    throw invalid_argument("loadColumnar: unsupported format version");
+  const uint32_t kind = readScalar<uint32_t>(is);
+  const uint32_t compression = readScalar<uint32_t>(is);
+  if (compression != kCompressionNone)
+    throw invalid_argument("loadColumnar: unsupported compression");
+  readScalar<uint32_t>(is); // reserved
+  return PayloadKind(kind);
+}
+
+/* ************************************************************************* */
+void writeAlignmentPadding(ostream& os) {
+  static const char zeros[kAlignment] = { 0 };
+  const size_t remainder = size_t(os.tellp()) % kAlignment;
+  if (remainder > 0)
+    os.write(zeros, kAlignment - remainder);
+}
+
+/* ************************************************************************* */
+void skipAlignmentPadding(istream& is) {
+  const size_t remainder = size_t(is.tellg()) % kAlignment;
+  if (remainder > 0)
+    is.ignore(kAlignment - remainder);
+}
+
+} // \ namespace columnar
+
+using namespace columnar;
+
+/* ************************************************************************* */
+namespace {
+
+// Columns common to both linear payloads: keys and per-variable dimensions
+void writeKeysAndDims(ostream& os, const KeyVector& keys,
+    const FastVector<DenseIndex>& dims) {
+  writeScalar<uint64_t>(os, keys.size());
+  for (Key key : keys)
+    writeScalar<uint64_t>(os, key);
+  for (DenseIndex dim : dims)
+    writeScalar<uint64_t>(os, uint64_t(dim));
+}
+
+void readKeysAndDims(istream& is, KeyVector& keys,
+    FastVector<DenseIndex>& dims) {
+  const uint64_t n = readScalar<uint64_t>(is);
+  keys.resize(n);
+  dims.resize(n);
+  for (uint64_t i = 0; i < n; ++i)
+    keys[i] = readScalar<uint64_t>(is);
+  for (uint64_t i = 0; i < n; ++i)
+    dims[i] = DenseIndex(readScalar<uint64_t>(is));
+}
+
+// An aligned column-major double buffer
+void writeMatrix(ostream& os, const Matrix& matrix) {
+  writeAlignmentPadding(os);
+  writeRaw(os, matrix.data(), size_t(matrix.size()) * sizeof(double));
+}
+
+Matrix readMatrix(istream& is, DenseIndex rows, DenseIndex cols) {
+  skipAlignmentPadding(is);
+  Matrix matrix(rows, cols);
+  readRaw(is, matrix.data(), size_t(matrix.size()) * sizeof(double));
+  return matrix;
+}
+
+} // \ anonymous namespace
+
+/* ************************************************************************* */
+void saveColumnar(const VectorValues& values, const string& filename) {
+  ofstream os(filename.c_str(), ios::binary);
+  if (!os.is_open())
+    throw invalid_argument("saveColumnar: cannot open file " + filename);
+  writeHeader(os, VECTOR_VALUES);
+
+  // Keys column and dims column
+  writeScalar<uint64_t>(os, values.size());
+  for (const VectorValues::KeyValuePair& keyValue : values)
+    writeScalar<uint64_t>(os, keyValue.first);
+  for (const VectorValues::KeyValuePair& keyValue : values)
+    writeScalar<uint64_t>(os, uint64_t(keyValue.second.size()));
+
+  // One aligned packed buffer with all coefficients
+  writeAlignmentPadding(os);
+  for (const VectorValues::KeyValuePair& keyValue : values)
+    writeRaw(os, keyValue.second.data(),
+        size_t(keyValue.second.size()) * sizeof(double));
+}
+
+/* ************************************************************************* */
+VectorValues loadColumnarVectorValues(const string& filename) {
+  ifstream is(filename.c_str(), ios::binary);
+  if (!is.is_open())
+    throw invalid_argument("loadColumnar: cannot open file " + filename);
+  if (readHeader(is) != VECTOR_VALUES)
+    throw invalid_argument(
+        "loadColumnar: file does not contain a VectorValues: " + filename);
+
+  const uint64_t n = readScalar<uint64_t>(is);
+  KeyVector keys(n);
+  FastVector<DenseIndex> dims(n);
+  for (uint64_t i = 0; i < n; ++i)
+    keys[i] = readScalar<uint64_t>(is);
+  for (uint64_t i = 0; i < n; ++i)
+    dims[i] = DenseIndex(readScalar<uint64_t>(is));
+
+  skipAlignmentPadding(is);
+  VectorValues values;
+  for (uint64_t i = 0; i < n; ++i) {
+    Vector x(dims[i]);
+    readRaw(is, x.data(), size_t(dims[i]) * sizeof(double));
+    values.emplace(keys[i], x);
+  }
+  return values;
+}
+
+/* ************************************************************************* */
+void saveColumnar(const GaussianFactorGraph& graph, const string& filename) {
+  ofstream os(filename.c_str(), ios::binary);
+  if (!os.is_open())
+    throw invalid_argument("saveColumnar: cannot open file " + filename);
+  writeHeader(os, GAUSSIAN_FACTOR_GRAPH);
+
+  writeScalar<uint64_t>(os, graph.size());
+  for (const GaussianFactor::shared_ptr& factor : graph) {
+    if (!factor) {
+      writeScalar<uint32_t>(os, kFactorNull);
+      continue;
+    }
+
+    // Keys and dims columns, common to both typed tables
+    KeyVector keys = factor->keys();
+    FastVector<DenseIndex> dims;
+    dims.reserve(keys.size());
+    for (GaussianFactor::const_iterator it = factor->begin();
+        it != factor->end(); ++it)
+      dims.push_back(factor->getDim(it));
+
+    if (const JacobianFactor* jacobian =
+        dynamic_cast<const JacobianFactor*>(factor.get())) {
+      writeScalar<uint32_t>(os, kFactorJacobian);
+      writeKeysAndDims(os, keys, dims);
+      writeScalar<uint64_t>(os, jacobian->rows());
+      const SharedDiagonal& model = jacobian->get_model();
+      writeScalar<uint8_t>(os, model ? 1 : 0);
+      if (model)
+        writeRaw(os, model->sigmas().data(),
+            size_t(jacobian->rows()) * sizeof(double));
+      // Raw (unwhitened) augmented [A b] block
+      writeMatrix(os, jacobian->matrixObject().full());
+    } else if (const HessianFactor* hessian =
+        dynamic_cast<const HessianFactor*>(factor.get())) {
+      writeScalar<uint32_t>(os, kFactorHessian);
+      writeKeysAndDims(os, keys, dims);
+      writeMatrix(os, hessian->augmentedInformation());
+    } else {
+      throw invalid_argument(
+          "saveColumnar: only JacobianFactor and HessianFactor are supported");
+    }
+  }
+}
+
+/* ************************************************************************* */
+GaussianFactorGraph loadColumnarGaussianFactorGraph(const string& filename) {
+  ifstream is(filename.c_str(), ios::binary);
+  if (!is.is_open())
+    throw invalid_argument("loadColumnar: cannot open file " + filename);
+  if (readHeader(is) != GAUSSIAN_FACTOR_GRAPH)
+    throw invalid_argument(
+        "loadColumnar: file does not contain a GaussianFactorGraph: "
+            + filename);
+
+  GaussianFactorGraph graph;
+  const uint64_t nrFactors = readScalar<uint64_t>(is);
+  graph.reserve(nrFactors);
+  for (uint64_t i = 0; i < nrFactors; ++i) {
+    const uint32_t tag = readScalar<uint32_t>(is);
+    if (tag == kFactorNull) {
+      graph.push_back(GaussianFactor::shared_ptr());
+      continue;
+    }
+
+    KeyVector keys;
+    FastVector<DenseIndex> dims;
+    readKeysAndDims(is, keys, dims);
+    DenseIndex totalDim = 0;
+    for (DenseIndex dim : dims)
+      totalDim += dim;
+
+    if (tag == kFactorJacobian) {
+      const DenseIndex rows = DenseIndex(readScalar<uint64_t>(is));
+      SharedDiagonal model;
+      if (readScalar<uint8_t>(is)) {
+        Vector sigmas(rows);
+        readRaw(is, sigmas.data(), size_t(rows) * sizeof(double));
+        model = noiseModel::Diagonal::Sigmas(sigmas, true);
+      }
+      const Matrix Ab = readMatrix(is, rows, totalDim + 1);
+      graph.push_back(boost::make_shared<JacobianFactor>(keys,
+          VerticalBlockMatrix(dims, Ab, true), model));
+    } else if (tag == kFactorHessian) {
+      const Matrix augmentedInformation = readMatrix(is, totalDim + 1,
+          totalDim + 1);
+      graph.push_back(boost::make_shared<HessianFactor>(keys,
+          SymmetricBlockMatrix(dims, augmentedInformation, true)));
+    } else {
+      throw invalid_argument("loadColumnar: unknown factor type tag");
+    }
+  }
+  return graph;
+}
+
+} // \ namespace gtsam
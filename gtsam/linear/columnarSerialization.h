@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    columnarSerialization.h
+ * @brief   Compact binary columnar file format for linear objects
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ *
+ * The boost archives in base/serialization.h are convenient but slow and
+ * verbose for checkpointing large solver state: every key and coefficient
+ * goes through the archive machinery one element at a time.  The columnar
+ * format here instead writes a small versioned header followed by flat
+ * arrays - a keys column, a dimensions column, and one packed double buffer -
+ * so that saving and loading is a handful of bulk reads and writes.  Double
+ * buffers are aligned to 64-byte file offsets, so a memory-mapped file can
+ * hand out aligned pointers directly.  Block compression is deliberately
+ * left to the storage layer (a compressed filesystem or an external codec);
+ * the header reserves a compression field so the format can grow one without
+ * breaking readers.
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace gtsam {
+
+/// Low-level pieces of the columnar container, shared with the nonlinear
+/// entry points in gtsam/nonlinear/columnarSerialization.h
+namespace columnar {
+
+/// What a columnar file contains, stored in the file header
+enum PayloadKind {
+  VECTOR_VALUES = 1,
+  GAUSSIAN_FACTOR_GRAPH = 2,
+  VALUES = 3,
+  NONLINEAR_FACTOR_GRAPH = 4
+};
+
+/// Write the magic, format version, and payload kind
+GTSAM_EXPORT void writeHeader(std::ostream& os, PayloadKind kind);
+
+/// Check magic and version, returning the payload kind.
+/// Throws std::invalid_argument on a foreign or incompatible file.
+GTSAM_EXPORT PayloadKind readHeader(std::istream& is);
+
+/// Pad the stream with zeros up to the next 64-byte file offset
+GTSAM_EXPORT void writeAlignmentPadding(std::ostream& os);
+
+/// Skip the padding written by writeAlignmentPadding
+GTSAM_EXPORT void skipAlignmentPadding(std::istream& is);
+
+/// Write a raw buffer
+inline void writeRaw(std::ostream& os, const void* data, size_t bytes) {
+  os.write(static_cast<const char*>(data), bytes);
+}
+
+/// Read a raw buffer, throwing std::invalid_argument on a truncated file
+inline void readRaw(std::istream& is, void* data, size_t bytes) {
+  is.read(static_cast<char*>(data), bytes);
+  if (!is)
+    throw std::invalid_argument("loadColumnar: unexpected end of file");
+}
+
+/// Write a single scalar column entry
+template<typename T>
+void writeScalar(std::ostream& os, T value) {
+  writeRaw(os, &value, sizeof(T));
+}
+
+/// Read a single scalar column entry
+template<typename T>
+T readScalar(std::istream& is) {
+  T value;
+  readRaw(is, &value, sizeof(T));
+  return value;
+}
+
+} // \ namespace columnar
+
+/**
+ * Save a VectorValues as a columnar file: a keys column, a dims column, and
+ * one aligned packed buffer with all coefficients.
+ * Throws std::invalid_argument if the file cannot be opened.
+ */
+GTSAM_EXPORT void saveColumnar(const VectorValues& values,
+    const std::string& filename);
+
+/**
+ * Load a VectorValues written by saveColumnar.
+ * Throws std::invalid_argument on a missing, foreign, or incompatible file.
+ */
+GTSAM_EXPORT VectorValues loadColumnarVectorValues(const std::string& filename);
+
+/**
+ * Save a GaussianFactorGraph as a columnar file.  Factors are stored as typed
+ * tables: a JacobianFactor as its keys, dims, sigmas, and raw augmented
+ * [A b] block, a HessianFactor as its keys, dims, and augmented information
+ * matrix.  Throws std::invalid_argument for factor types beyond these two,
+ * and if the file cannot be opened.
+ */
+GTSAM_EXPORT void saveColumnar(const GaussianFactorGraph& graph,
+    const std::string& filename);
+
+/**
+ * Load a GaussianFactorGraph written by saveColumnar.
+ * Throws std::invalid_argument on a missing, foreign, or incompatible file.
+ */
+GTSAM_EXPORT GaussianFactorGraph loadColumnarGaussianFactorGraph(
+    const std::string& filename);
+
+} // \ namespace gtsam
@@ -47,6 +47,66 @@ namespace gtsam {
     return conjugateGradients<System, Vector, Vector>(Ab, x, parameters);
   }
 
+  /* ************************************************************************* */
+  Vector fusedConjugateGradientDescent(const System& Ab, const Vector& x0,
+      const ConjugateGradientParameters & parameters) {
+
+    const Matrix& A = Ab.A();
+    const Vector& b = Ab.b();
+    Vector x = x0;
+
+    // All loop state lives in buffers allocated once, before the loop
+    // Start with g0 = A'*(A*x0-b), d0 = g0 (alpha is negated, as in CGState)
+    Vector g = A.transpose() * (A * x - b);
+    Vector d = g;
+    Vector Ad(b.size()), AtAd(g.size());
+
+    double gamma = g.squaredNorm();
+    double threshold = std::max(parameters.epsilon_abs(),
+        parameters.epsilon() * parameters.epsilon() * gamma);
+    if (gamma < threshold) return x;
+
+    Ad.noalias() = A * d;
+
+    const DenseIndex n = g.size();
+    for (int k = 1; k < (int) parameters.maxIterations(); k++) {
+
+      double alpha = -d.dot(g) / Ad.squaredNorm();
+      x += alpha * d;
+
+      // Update the gradient, fusing the convergence dot product into the
+      // same pass so g is only swept once per iteration
+      double new_gamma = 0.0;
+      if (k % parameters.reset() == 0) {
+        g.noalias() = A.transpose() * (A * x - b);
+        new_gamma = g.squaredNorm();
+      } else {
+        AtAd.noalias() = A.transpose() * Ad;
+        for (DenseIndex i = 0; i < n; i++) {
+          g[i] += alpha * AtAd[i];
+          new_gamma += g[i] * g[i];
+        }
+      }
+
+      if (parameters.verbosity() != ConjugateGradientParameters::SILENT)
+        std::cout << "iteration " << k << ": alpha = " << alpha
+                  << ", dotg = " << new_gamma
+                  << std::endl;
+
+      if (new_gamma < threshold) break;
+
+      // New search direction d = g + beta*d, again in a single sweep
+      double beta = new_gamma / gamma;
+      for (DenseIndex i = 0; i < n; i++)
+        d[i] = g[i] + beta * d[i];
+      gamma = new_gamma;
+
+      // In-place recalculation Ad <- A*d to avoid re-allocating Ad
+      Ad.noalias() = A * d;
+    }
+    return x;
+  }
+
   /* ************************************************************************* */
   Vector steepestDescent(const Matrix& A, const Vector& b, const Vector& x,
       const ConjugateGradientParameters & parameters) {
@@ -106,6 +106,20 @@ namespace gtsam {
       const Vector& x,
       const ConjugateGradientParameters & parameters);
 
+  /**
+   * Method of conjugate gradients (CG), fused System version.
+   * Produces the same iterates as conjugateGradientDescent, but keeps the
+   * gradient, search direction, and the two matrix-vector products in
+   * buffers allocated once before the loop, and fuses the gradient update
+   * with the convergence dot product (and the direction update with the
+   * beta scaling) into single sweeps over memory. Preferred for large,
+   * bandwidth-bound dense systems.
+   */
+  GTSAM_EXPORT Vector fusedConjugateGradientDescent(
+      const System& Ab,
+      const Vector& x,
+      const ConjugateGradientParameters & parameters);
+
   /** convenience calls using matrices, will create System class internally: */
 
   /**
@@ -150,6 +150,43 @@ namespace gtsam
         treeTraversal::DepthFirstForestParallel(bayesTree, rootData, preVisitor, postVisitor);
         return preVisitor.collectedResult;
       }
+
+      /* ************************************************************************* */
+      /** Back-substitute only the cliques on the path from each requested key to its root.  The
+      *  conditional of a clique depends only on its ancestors, so the solution for a handful of
+      *  variables needs just their root paths - a few cliques out of possibly millions - and the
+      *  result is a partial VectorValues holding the frontal variables of the visited cliques.
+      *  Throws std::out_of_range if a requested key is not in the tree. */
+      template<class BAYESTREE>
+      VectorValues optimizeBayesTreeSelective(const BAYESTREE& bayesTree, const KeyVector& keys)
+      {
+        gttic(linear_optimizeBayesTreeSelective);
+        typedef typename BAYESTREE::sharedClique sharedClique;
+
+        VectorValues result;
+        std::set<const typename BAYESTREE::Clique*> solved;
+        for(Key key: keys) {
+          // Walk up to the root, stopping where an earlier path already solved
+          FastVector<sharedClique> path;
+          sharedClique clique = bayesTree[key];
+          while(clique && solved.find(clique.get()) == solved.end()) {
+            path.push_back(clique);
+            clique = clique->parent();
+          }
+
+          // Solve root-most first, so each conditional finds its parents solved
+          for(typename FastVector<sharedClique>::const_reverse_iterator it = path.rbegin();
+              it != path.rend(); ++it) {
+            const GaussianConditional& c = *(*it)->conditional();
+            VectorValues solution = c.solve(result);
+            for(const VectorValues::KeyValuePair& values: solution)
+              if(values.second.hasNaN()) throw IndeterminantLinearSystemException(c.keys().front());
+            result.insert(solution);
+            solved.insert(it->get());
+          }
+        }
+        return result;
+      }
     }
   }
 }
@@ -0,0 +1,81 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testColumnarSerialization.cpp
+ * @brief   Unit tests for the binary columnar file format
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ */
+
+#include <gtsam/linear/columnarSerialization.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <cstdio>
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(ColumnarSerialization, vectorValues) {
+  VectorValues expected;
+  expected.insert(0, Vector2(1.0, 2.0));
+  expected.insert(1, Vector1(3.0));
+  expected.insert(5, Vector3(4.0, 5.0, 6.0));
+
+  const string filename = "testColumnarVectorValues.bin";
+  saveColumnar(expected, filename);
+  VectorValues actual = loadColumnarVectorValues(filename);
+  EXPECT(assert_equal(expected, actual));
+  remove(filename.c_str());
+
+  // A missing file throws
+  CHECK_EXCEPTION(loadColumnarVectorValues("/nonexistent/file.bin"),
+      invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(ColumnarSerialization, gaussianFactorGraph) {
+  GaussianFactorGraph expected;
+  // Unary Jacobian with a diagonal model
+  expected.add(0, (Matrix(2, 2) << 1.0, 2.0, 3.0, 4.0).finished(),
+      Vector2(1.0, 2.0), noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.2)));
+  // Binary Jacobian with a constrained model
+  expected.add(0, -I_2x2, 1, I_2x2, Vector2(0.5, -0.5),
+      noiseModel::Constrained::MixedSigmas(Vector2(0.0, 1.0)));
+  // Jacobian without a noise model
+  expected.add(1, 2.0 * I_2x2, Vector2(1.0, 1.0), SharedDiagonal());
+  // A Hessian factor and a null factor
+  expected.push_back(boost::make_shared<HessianFactor>(
+      JacobianFactor(1, I_2x2, Vector2(3.0, 4.0))));
+  expected.push_back(GaussianFactor::shared_ptr());
+
+  const string filename = "testColumnarFactorGraph.bin";
+  saveColumnar(expected, filename);
+  GaussianFactorGraph actual = loadColumnarGaussianFactorGraph(filename);
+  EXPECT(assert_equal(expected, actual));
+
+  // Loading a graph file as a VectorValues is rejected by the header
+  CHECK_EXCEPTION(loadColumnarVectorValues(filename), invalid_argument);
+  remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -15,7 +15,7 @@
  * @author Frank Dellaert
  */
 
-#include <boost/assign/std/list.hpp> // for +=
+#include <boost/assign/std/vector.hpp> // for +=
 using namespace boost::assign;
 
 #include <CppUnitLite/TestHarness.h>
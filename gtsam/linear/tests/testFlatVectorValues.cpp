@@ -0,0 +1,103 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testFlatVectorValues.cpp
+ * @brief   Unit tests for FlatVectorValues
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/linear/FlatVectorValues.h>
+#include <gtsam/base/Testable.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static VectorValues exampleValues() {
+  VectorValues values;
+  values.insert(0, Vector2(1.0, 2.0));
+  values.insert(1, Vector2(3.0, 4.0));
+  values.insert(5, Vector3(5.0, 6.0, 7.0));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, roundtrip) {
+  VectorValues values = exampleValues();
+  FlatVectorValues flat(values);
+
+  // Variables are laid out contiguously in key order
+  LONGS_EQUAL(3, flat.size());
+  LONGS_EQUAL(7, flat.dim());
+  EXPECT(assert_equal((Vector(7) << 1., 2., 3., 4., 5., 6., 7.).finished(),
+      flat.flat()));
+
+  // Per-key and per-slot access are views into the same storage
+  EXPECT(assert_equal(Vector2(3.0, 4.0), Vector(flat.at(1))));
+  EXPECT(assert_equal(Vector3(5.0, 6.0, 7.0), Vector(flat.atSlot(2))));
+  flat.at(1) = Vector2(-3.0, -4.0);
+  EXPECT_DOUBLES_EQUAL(-3.0, flat.flat()[2], 1e-15);
+
+  // Conversion back reproduces the (modified) VectorValues
+  values[1] = Vector2(-3.0, -4.0);
+  EXPECT(assert_equal(values, flat.vectorValues()));
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, arithmetic) {
+  VectorValues x = exampleValues();
+  VectorValues y = exampleValues();
+  y.at(0) = Vector2(2.0, -1.0);
+  y.at(5) = Vector3(0.5, 0.0, -0.5);
+
+  FlatVectorValues fx(x), fy(y, fx.scatter());
+  EXPECT(fx.hasSameStructure(fy));
+
+  // dot, norms and axpy must match the VectorValues versions
+  EXPECT_DOUBLES_EQUAL(x.dot(y), fx.dot(fy), 1e-12);
+  EXPECT_DOUBLES_EQUAL(x.squaredNorm(), fx.squaredNorm(), 1e-12);
+  VectorValues expected = x;
+  expected += y.scale(0.25);
+  fx.axpy(0.25, fy);
+  EXPECT(assert_equal(expected, fx.vectorValues(), 1e-12));
+
+  FlatVectorValues sum = fx;
+  sum += fy;
+  sum -= fy;
+  EXPECT(assert_equal(fx, sum, 1e-12));
+  sum *= 2.0;
+  EXPECT(assert_equal(fx.vectorValues().scale(2.0), sum.vectorValues(), 1e-12));
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, structureChecks) {
+  VectorValues x = exampleValues();
+  VectorValues other;
+  other.insert(0, Vector2(1.0, 2.0));
+  other.insert(2, Vector2(3.0, 4.0));
+  other.insert(5, Vector3(5.0, 6.0, 7.0));
+
+  FlatVectorValues fx(x), fo(other);
+  EXPECT(!fx.hasSameStructure(fo));
+  CHECK_EXCEPTION(fx.dot(fo), invalid_argument);
+  CHECK_EXCEPTION(fx.axpy(1.0, fo), invalid_argument);
+
+  // A Scatter that does not cover the values exactly is rejected
+  Scatter partial;
+  partial.add(0, 2);
+  partial.add(1, 2);
+  CHECK_EXCEPTION(FlatVectorValues(x, partial), invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
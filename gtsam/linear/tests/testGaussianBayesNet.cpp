@@ -137,7 +137,39 @@ TEST( GaussianBayesNet, optimize3 )
 }
 
 /* ************************************************************************* */
-TEST(GaussianBayesNet, ordering) 
+TEST( GaussianBayesNet, backSubstituteMultipleRHS )
+{
+  // A 3-variable net with multi-dimensional blocks and noise models
+  GaussianBayesNet bn;
+  using GC = GaussianConditional;
+  bn.emplace_shared<GC>(_x_, Vector2(1, 2), 1 * I_2x2, _y_, 2 * I_2x2, _z_,
+      3 * I_2x2, noiseModel::Isotropic::Sigma(2, 0.5));
+  bn.emplace_shared<GC>(_y_, Vector2(3, 4), 4 * I_2x2, _z_, 5 * I_2x2);
+  bn.emplace_shared<GC>(_z_, Vector2(5, 6), 6 * I_2x2,
+      noiseModel::Isotropic::Sigma(2, 2.0));
+
+  // Three right-hand sides carried through the one factorization at once
+  const size_t k = 3;
+  FastMap<Key, Matrix> rhs;
+  rhs[_x_] = (Matrix(2, k) << 1, 0, 2, 0, 1, -1).finished();
+  rhs[_y_] = (Matrix(2, k) << 0, 1, 3, 1, 0, 0.5).finished();
+  rhs[_z_] = (Matrix(2, k) << 0, 0, -2, 0, 1, 4).finished();
+
+  FastMap<Key, Matrix> actual = bn.backSubstitute(rhs);
+
+  // Every column matches a single-RHS backsubstitution
+  for (size_t j = 0; j < k; ++j) {
+    VectorValues gx;
+    for (Key key : {_x_, _y_, _z_})
+      gx.insert(key, rhs.at(key).col(j));
+    VectorValues expected = bn.backSubstitute(gx);
+    for (Key key : {_x_, _y_, _z_})
+      EXPECT(assert_equal(expected[key], Vector(actual.at(key).col(j)), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(GaussianBayesNet, ordering)
 {
   Ordering expected;
   expected += _x_, _y_;
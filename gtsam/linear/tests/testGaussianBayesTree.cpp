@@ -123,6 +123,27 @@ TEST( GaussianBayesTree, optimizeMultiFrontal )
   EXPECT(assert_equal(expected,actual));
 }
 
+/* ************************************************************************* */
+TEST( GaussianBayesTree, optimizeSelective )
+{
+  GaussianBayesTree bt = *chain.eliminateMultifrontal(chainOrdering);
+  VectorValues full = bt.optimize();
+
+  // Asking for the root frontals solves only the root clique
+  VectorValues root = bt.optimize(KeyVector{x4});
+  EXPECT_LONGS_EQUAL(2, root.size());
+  EXPECT(assert_equal(full[x3], root[x3]));
+  EXPECT(assert_equal(full[x4], root[x4]));
+
+  // Asking for a leaf variable walks its whole root path
+  VectorValues leaf = bt.optimize(KeyVector{x1});
+  EXPECT_LONGS_EQUAL(4, leaf.size());
+  EXPECT(assert_equal(full, leaf));
+
+  // A key that is not in the tree is an error
+  CHECK_EXCEPTION(bt.optimize(KeyVector{99}), std::out_of_range);
+}
+
 /* ************************************************************************* */
 TEST(GaussianBayesTree, complicatedMarginal) {
 
@@ -21,13 +21,14 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/inference/VariableSlots.h>
 #include <gtsam/inference/VariableIndex.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/VerticalBlockMatrix.h>
 
 #include <boost/assign/list_of.hpp>
-#include <boost/assign/std/list.hpp>  // for operator +=
+#include <boost/assign/std/vector.hpp>  // for operator +=
 using namespace boost::assign;
 
 #include <gtsam/base/TestableAssertions.h>
@@ -179,6 +180,150 @@ static GaussianFactorGraph createSimpleGaussianFactorGraph() {
   return fg;
 }
 
+/* ************************************************************************* */
+// Rebuild a dense matrix from CSR arrays, mirroring if symmetric upper
+static Matrix csrToDense(const SparseCsrMatrix& csr, bool mirror) {
+  Matrix dense = Matrix::Zero(csr.rows, csr.cols);
+  for (std::int64_t i = 0; i < csr.rows; ++i) {
+    for (std::int64_t k = csr.rowPointers[i]; k < csr.rowPointers[i + 1]; ++k) {
+      const std::int64_t j = csr.columnIndices[k];
+      dense(i, j) = csr.values[k];
+      if (mirror && j != i) dense(j, i) = csr.values[k];
+    }
+  }
+  return dense;
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, sparseCsr) {
+  // Same fixture as the sparseJacobian test above
+  GaussianFactorGraph gfg;
+  SharedDiagonal model = noiseModel::Isotropic::Sigma(2, 0.5);
+  gfg.add(0, (Matrix(2, 3) << 1., 2., 3., 5., 6., 7.).finished(), Vector2(4., 8.), model);
+  gfg.add(0, (Matrix(2, 3) << 9., 10., 0., 0., 0., 0.).finished(), 1,
+          (Matrix(2, 2) << 11., 12., 14., 15.).finished(), Vector2(13., 16.), model);
+
+  // Jacobian export must match the dense whitened system
+  Matrix expectedA;
+  Vector expectedb;
+  boost::tie(expectedA, expectedb) = gfg.jacobian();
+  const SparseCsrMatrix csr = gfg.sparseJacobianCsr();
+  EXPECT(assert_equal(expectedA, csrToDense(csr, false)));
+  EXPECT(assert_equal(expectedb, Vector(csr.rhs)));
+
+  // Column indices ascend within each row
+  for (std::int64_t i = 0; i < csr.rows; ++i)
+    for (std::int64_t k = csr.rowPointers[i] + 1; k < csr.rowPointers[i + 1]; ++k)
+      CHECK(csr.columnIndices[k - 1] < csr.columnIndices[k]);
+
+  // The view borrows the same storage
+  const SparseCsrView view = csr.view();
+  EXPECT_LONGS_EQUAL(csr.nnz(), (long)view.nnz);
+  CHECK(view.values == csr.values.data());
+  CHECK(view.rowPointers == csr.rowPointers.data());
+  CHECK(view.rhs == csr.rhs.data());
+
+  // Hessian export: mirror the upper triangle and compare to dense
+  Matrix expectedL;
+  Vector expectedEta;
+  boost::tie(expectedL, expectedEta) = gfg.hessian();
+  const SparseCsrMatrix hessianCsr = gfg.sparseHessianCsr();
+  EXPECT(assert_equal(expectedL, csrToDense(hessianCsr, true)));
+  EXPECT(assert_equal(expectedEta, Vector(hessianCsr.rhs)));
+
+  // Also on a graph whose factors list keys out of sorted order
+  GaussianFactorGraph fg = createSimpleGaussianFactorGraph();
+  boost::tie(expectedA, expectedb) = fg.jacobian();
+  EXPECT(assert_equal(expectedA, csrToDense(fg.sparseJacobianCsr(), false)));
+  boost::tie(expectedL, expectedEta) = fg.hessian();
+  const SparseCsrMatrix fgHessian = fg.sparseHessianCsr();
+  EXPECT(assert_equal(expectedL, csrToDense(fgHessian, true)));
+  EXPECT(assert_equal(expectedEta, Vector(fgHessian.rhs)));
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, analyzeFactorize) {
+  GaussianFactorGraph fg = createSimpleGaussianFactorGraph();
+
+  // Factorizing through a handle must match ordinary multifrontal elimination
+  GaussianFactorGraph::SymbolicSolveHandle handle = fg.analyzeMultifrontal();
+  GaussianBayesTree::shared_ptr expected = fg.eliminateMultifrontal(handle.ordering);
+  GaussianBayesTree::shared_ptr actual = fg.numericFactorizeMultifrontal(handle);
+  EXPECT(assert_equal(expected->optimize(), actual->optimize()));
+
+  // Reusing the handle on the same topology with different values must match
+  // eliminating the new graph from scratch with the same ordering
+  GaussianFactorGraph fg2;
+  Key x1 = 2, x2 = 0, l1 = 1;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  fg2 += JacobianFactor(x1, 8 * I_2x2, Vector2(1.0, -2.0), unit2);
+  fg2 += JacobianFactor(x2, 10 * I_2x2, x1, -10 * I_2x2, Vector2(3.0, 1.0), unit2);
+  fg2 += JacobianFactor(l1, 4 * I_2x2, x1, -4 * I_2x2, Vector2(0.5, 1.0), unit2);
+  fg2 += JacobianFactor(x2, -5 * I_2x2, l1, 5 * I_2x2, Vector2(-1.0, 0.5), unit2);
+  GaussianBayesTree::shared_ptr expected2 = fg2.eliminateMultifrontal(handle.ordering);
+  GaussianBayesTree::shared_ptr actual2 = fg2.numericFactorizeMultifrontal(handle);
+  EXPECT(assert_equal(expected2->optimize(), actual2->optimize()));
+
+  // A graph with a different number of factors does not match the analyzed topology
+  GaussianFactorGraph fg3 = createSimpleGaussianFactorGraph();
+  fg3 += JacobianFactor(x1, I_2x2, Vector2(0.0, 0.0), unit2);
+  CHECK_EXCEPTION(fg3.numericFactorizeMultifrontal(handle), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, optimizeOutOfCore) {
+  GaussianFactorGraph fg = createSimpleGaussianFactorGraph();
+  const Ordering ordering = Ordering::Colamd(fg);
+  const VectorValues expected = fg.optimize(ordering);
+  const std::string scratchFile = "testGaussianFactorGraph.spill.tmp";
+
+  // A budget large enough that nothing spills
+  VectorValues actual = fg.optimizeOutOfCore(ordering, 1024 * 1024, scratchFile);
+  EXPECT(assert_equal(expected, actual));
+
+  // A zero budget forces every conditional but the newest through the scratch file
+  actual = fg.optimizeOutOfCore(ordering, 0, scratchFile);
+  EXPECT(assert_equal(expected, actual));
+
+  std::remove(scratchFile.c_str());
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, optimizePartitioned) {
+  // x1 and x2 only interact through l1, so l1 separates the two interiors
+  GaussianFactorGraph fg;
+  Key x1 = 2, x2 = 0, l1 = 1;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  fg += JacobianFactor(x1, 10 * I_2x2, -1.0 * Vector::Ones(2), unit2);
+  fg += JacobianFactor(l1, 5 * I_2x2, x1, -5 * I_2x2, Vector2(0.0, 1.0), unit2);
+  fg += JacobianFactor(x2, -5 * I_2x2, l1, 5 * I_2x2, Vector2(-1.0, 1.5), unit2);
+  fg += JacobianFactor(x2, 10 * I_2x2, Vector2(2.0, -1.0), unit2);
+  std::vector<Ordering> interiors(2);
+  interiors[0].push_back(x1);
+  interiors[1].push_back(x2);
+  Ordering separator;
+  separator.push_back(l1);
+
+  // Must match solving the whole graph with the concatenated ordering
+  Ordering full;
+  full.push_back(x1);
+  full.push_back(x2);
+  full.push_back(l1);
+  const VectorValues expected = fg.optimize(full);
+  const VectorValues actual = fg.optimizePartitioned(interiors, separator);
+  EXPECT(assert_equal(expected, actual));
+
+  // A factor between x1 and x2 connects two interiors: not a valid partition
+  GaussianFactorGraph fg2 = fg;
+  fg2 += JacobianFactor(x1, I_2x2, x2, -I_2x2, Vector2(0.0, 0.0), unit2);
+  CHECK_EXCEPTION(fg2.optimizePartitioned(interiors, separator), std::invalid_argument);
+
+  // Orderings must cover every variable
+  std::vector<Ordering> incomplete(1);
+  incomplete[0].push_back(x1);
+  CHECK_EXCEPTION(fg.optimizePartitioned(incomplete, separator), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST(GaussianFactorGraph, gradient) {
   GaussianFactorGraph fg = createSimpleGaussianFactorGraph();
@@ -408,6 +553,45 @@ TEST(GaussianFactorGraph, DenseSolve) {
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, optimizeFast) {
+  GaussianFactorGraph fg = createSimpleGaussianFactorGraph();
+  VectorValues expected = fg.optimize();
+
+  // A small graph takes the dense path and must match sparse elimination
+  EXPECT(assert_equal(expected, fg.optimizeFast()));
+
+  // A threshold below the variable count forces the sparse fallback
+  EXPECT(assert_equal(expected, fg.optimizeFast(2)));
+
+  // A constrained noise model routes through the sparse path regardless of size
+  GaussianFactorGraph constrainedGraph = fg;
+  constrainedGraph += JacobianFactor(0, I_2x2, Vector2(0.2, -0.1),
+      noiseModel::Constrained::All(2));
+  EXPECT(assert_equal(constrainedGraph.optimize(), constrainedGraph.optimizeFast()));
+}
+
+/* ************************************************************************* */
+TEST(GaussianFactorGraph, memoryUsage) {
+  // A Jacobian factor accounts for at least its augmented matrix storage
+  JacobianFactor jacobian(0, I_2x2, Vector2(1.0, 2.0), noiseModel::Unit::Create(2));
+  EXPECT(jacobian.memoryUsage() >= jacobian.matrixObject().matrix().size() * sizeof(double));
+
+  // A Hessian factor accounts for the full augmented information storage
+  HessianFactor hessian(jacobian);
+  EXPECT(hessian.memoryUsage() >= hessian.rows() * hessian.rows() * sizeof(double));
+
+  // The graph reports at least the sum over its factors, and grows with them
+  GaussianFactorGraph fg = createSimpleGaussianFactorGraph();
+  size_t factorTotal = 0;
+  for (const GaussianFactor::shared_ptr& factor : fg)
+    factorTotal += factor->memoryUsage();
+  EXPECT(fg.memoryUsage() >= factorTotal);
+  const size_t before = fg.memoryUsage();
+  fg += jacobian;
+  EXPECT(fg.memoryUsage() >= before + jacobian.memoryUsage());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -398,6 +398,42 @@ TEST(HessianFactor, CombineAndEliminate2) {
 #endif
 }
 
+/* ************************************************************************* */
+TEST(HessianFactor, CachedEliminateCholesky) {
+  Matrix A01 = I_3x3;
+  Vector3 b0(1.5, 1.5, 1.5);
+
+  Matrix A10 = 2.0 * I_3x3;
+  Matrix A11 = -2.0 * I_3x3;
+  Vector3 b1(2.5, 2.5, 2.5);
+
+  GaussianFactorGraph gfg;
+  gfg.add(1, A01, b0);
+  gfg.add(0, A10, 1, A11, b1);
+
+  // expected result comes from the stateless version
+  Ordering ordering = list_of(0);
+  GaussianConditional::shared_ptr expectedConditional;
+  HessianFactor::shared_ptr expectedFactor;
+  boost::tie(expectedConditional, expectedFactor) = //
+      EliminateCholesky(gfg, ordering);
+
+  // first call builds the Scatter, second call reuses it
+  CachedEliminateCholesky eliminate;
+  GaussianConditional::shared_ptr actualConditional;
+  HessianFactor::shared_ptr actualFactor;
+  for (size_t iteration = 0; iteration < 2; ++iteration) {
+    boost::tie(actualConditional, actualFactor) = eliminate(gfg, ordering);
+    EXPECT(assert_equal(*expectedConditional, *actualConditional, 1e-9));
+    EXPECT(assert_equal(*expectedFactor, *actualFactor, 1e-9));
+    EXPECT_LONGS_EQUAL(1, eliminate.size());
+  }
+
+  // clear invalidates the cache
+  eliminate.clear();
+  EXPECT_LONGS_EQUAL(0, eliminate.size());
+}
+
 /* ************************************************************************* */
 TEST(HessianFactor, eliminate2 )
 {
@@ -590,6 +626,99 @@ TEST(HessianFactor, Solve)
   EXPECT(assert_equal(expected, factor.solve()));
 }
 
+/* ************************************************************************* */
+TEST(HessianFactor, activationWeights)
+{
+  // Down-weighting a factor to w is equivalent to scaling its sigmas by
+  // 1/sqrt(w), without touching the factor itself
+  const double w = 0.25;
+  GaussianFactorGraph weighted;
+  weighted.add(0, I_3x3, Vector3(1.0, 2.0, 3.0),
+      noiseModel::Isotropic::Sigma(3, 0.5));
+  weighted.add(0, 2.0 * I_3x3, Vector3(3.0, 4.0, 5.0),
+      noiseModel::Isotropic::Sigma(3, 1.0));
+  weighted[1]->setActivationWeight(w);
+
+  GaussianFactorGraph expected;
+  expected.add(0, I_3x3, Vector3(1.0, 2.0, 3.0),
+      noiseModel::Isotropic::Sigma(3, 0.5));
+  expected.add(0, 2.0 * I_3x3, Vector3(3.0, 4.0, 5.0),
+      noiseModel::Isotropic::Sigma(3, 1.0 / std::sqrt(w)));
+
+  // The error is weighted consistently with the information contribution
+  VectorValues x;
+  x.insert(0, Vector3(0.5, -0.5, 1.0));
+  DOUBLES_EQUAL(expected.error(x), weighted.error(x), 1e-9);
+
+  // Cholesky elimination sees the weighted factor
+  GaussianConditional::shared_ptr actualConditional =
+      EliminateCholesky(weighted, Ordering(list_of(0))).first;
+  GaussianConditional::shared_ptr expectedConditional =
+      EliminateCholesky(expected, Ordering(list_of(0))).first;
+  EXPECT(assert_equal(*expectedConditional, *actualConditional, 1e-9));
+
+  // A weight of zero deactivates the factor entirely
+  weighted[1]->setActivationWeight(0.0);
+  GaussianFactorGraph firstOnly;
+  firstOnly.add(0, I_3x3, Vector3(1.0, 2.0, 3.0),
+      noiseModel::Isotropic::Sigma(3, 0.5));
+  EXPECT(assert_equal(*EliminateCholesky(firstOnly, Ordering(list_of(0))).first,
+      *EliminateCholesky(weighted, Ordering(list_of(0))).first, 1e-9));
+
+  // HessianFactors are weighted the same way
+  GaussianFactorGraph withHessian;
+  withHessian.add(0, I_3x3, Vector3(1.0, 2.0, 3.0),
+      noiseModel::Isotropic::Sigma(3, 0.5));
+  withHessian.push_back(boost::make_shared<HessianFactor>(
+      JacobianFactor(0, 2.0 * I_3x3, Vector3(3.0, 4.0, 5.0))));
+  withHessian[1]->setActivationWeight(w);
+  EXPECT(assert_equal(*expectedConditional,
+      *EliminateCholesky(withHessian, Ordering(list_of(0))).first, 1e-9));
+
+  // Negative weights are rejected
+  CHECK_EXCEPTION(withHessian[1]->setActivationWeight(-1.0),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(HessianFactor, EliminateAdaptive)
+{
+  // Well-conditioned clique: the adaptive dispatch runs Cholesky and leaves
+  // a HessianFactor behind, with the same conditional as EliminateCholesky
+  GaussianFactorGraph gfg;
+  gfg.add(0, 2.0 * I_2x2, Vector2(1.0, 2.0), noiseModel::Unit::Create(2));
+  gfg.add(0, I_2x2, 1, I_2x2, Vector2(0.5, -0.5), noiseModel::Unit::Create(2));
+  Ordering ordering = list_of(0);
+  std::pair<GaussianConditional::shared_ptr, GaussianFactor::shared_ptr>
+      expected = EliminateCholesky(gfg, ordering);
+  std::pair<GaussianConditional::shared_ptr, GaussianFactor::shared_ptr>
+      actual = EliminateAdaptive(gfg, ordering);
+  EXPECT(assert_equal(*expected.first, *actual.first));
+  CHECK(boost::dynamic_pointer_cast<HessianFactor>(actual.second));
+
+  // A sigma spread of 1e8 across the dimensions of variable 0 makes the
+  // information diagonal spread exceed the threshold, so the same clique
+  // shape now goes through QR instead
+  GaussianFactorGraph ill;
+  ill.add(0, I_2x2, Vector2(1.0, 2.0),
+      noiseModel::Diagonal::Sigmas(Vector2(1e-8, 1.0)));
+  ill.add(0, I_2x2, 1, -I_2x2, Vector2(0.5, -0.5),
+      noiseModel::Isotropic::Sigma(2, 1.0));
+  actual = EliminateAdaptive(ill, ordering);
+  CHECK(boost::dynamic_pointer_cast<JacobianFactor>(actual.second));
+  EXPECT(assert_equal(*EliminateQR(ill, ordering).first, *actual.first));
+
+  // Constrained noise models force QR, as in EliminatePreferCholesky
+  GaussianFactorGraph constrained;
+  constrained.add(0, I_2x2, Vector2(1.0, 2.0),
+      noiseModel::Constrained::MixedSigmas(Vector2(1.0, 0.0)));
+  constrained.add(0, I_2x2, 1, I_2x2, Vector2(0.5, -0.5),
+      noiseModel::Unit::Create(2));
+  actual = EliminateAdaptive(constrained, ordering);
+  CHECK(boost::dynamic_pointer_cast<JacobianFactor>(actual.second));
+  EXPECT(assert_equal(*EliminateQR(constrained, ordering).first, *actual.first));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
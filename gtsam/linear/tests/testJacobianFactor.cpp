@@ -183,6 +183,42 @@ TEST(JabobianFactor, Hessian_conversion3) {
   EXPECT(assert_equal(jf, JacobianFactor(hessian), 1e-9));
 }
 
+/* ************************************************************************* */
+TEST(JabobianFactor, Hessian_conversion4) {
+  // Uniform 3-wide blocks, as in a Pose2 graph, take the fixed-size
+  // updateHessian path; check it against the dense augmented information
+  JacobianFactor jf(0, (Matrix(3, 3) <<
+      1, 2, 3,
+      0, 2, 3,
+      0, 0, 3).finished(),
+    1, (Matrix(3, 3) <<
+      4, 1, 0,
+      2, 2, 1,
+      1, 0, 5).finished(),
+    Vector3(1, 2, 2));
+  HessianFactor hessian(jf);
+  EXPECT(assert_equal(jf.augmentedInformation(),
+      hessian.augmentedInformation(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(JabobianFactor, Hessian_conversion5) {
+  // Mixed 2- and 3-wide blocks in contiguous slots take the blocked
+  // rank-k updateHessian path; check it against the dense information
+  JacobianFactor jf(0, (Matrix(3, 2) <<
+      1, 2,
+      0, 2,
+      1, 3).finished(),
+    1, (Matrix(3, 3) <<
+      4, 1, 0,
+      2, 2, 1,
+      1, 0, 5).finished(),
+    Vector3(1, 2, 2));
+  HessianFactor hessian(jf);
+  EXPECT(assert_equal(jf.augmentedInformation(),
+      hessian.augmentedInformation(), 1e-9));
+}
+
 /* ************************************************************************* */
 namespace simple_graph {
 
@@ -580,6 +616,50 @@ TEST(JacobianFactor, EliminateQR)
   EXPECT(assert_equal(*noiseModel::Diagonal::Sigmas(Vector4::Ones()), *actualJF.get_model(), 0.001));
 }
 
+/* ************************************************************************* */
+TEST(JacobianFactor, CachedEliminateQR)
+{
+  Matrix A01 = I_3x3;
+  Vector3 b0(1.5, 1.5, 1.5);
+
+  Matrix A10 = 2.0 * I_3x3;
+  Matrix A11 = -2.0 * I_3x3;
+  Vector3 b1(2.5, 2.5, 2.5);
+
+  GaussianFactorGraph gfg;
+  gfg.add(1, A01, b0, noiseModel::Isotropic::Sigma(3, 0.5));
+  gfg.add(0, A10, 1, A11, b1, noiseModel::Isotropic::Sigma(3, 0.5));
+
+  // expected result comes from the stateless version
+  Ordering ordering = list_of(0);
+  GaussianConditional::shared_ptr expectedConditional;
+  JacobianFactor::shared_ptr expectedFactor;
+  boost::tie(expectedConditional, expectedFactor) = EliminateQR(gfg, ordering);
+
+  // first call builds the column layout, second call reuses it
+  CachedEliminateQR eliminate;
+  GaussianConditional::shared_ptr actualConditional;
+  JacobianFactor::shared_ptr actualFactor;
+  for (size_t iteration = 0; iteration < 2; ++iteration) {
+    boost::tie(actualConditional, actualFactor) = eliminate(gfg, ordering);
+    EXPECT(assert_equal(*expectedConditional, *actualConditional, 1e-9));
+    EXPECT(assert_equal(*expectedFactor, *actualFactor, 1e-9));
+    EXPECT_LONGS_EQUAL(1, eliminate.size());
+  }
+
+  // A structure change under the same elimination keys is detected and the
+  // layout rebuilt instead of reused
+  gfg.add(0, A10, 2, A11, b1, noiseModel::Isotropic::Sigma(3, 0.5));
+  boost::tie(expectedConditional, expectedFactor) = EliminateQR(gfg, ordering);
+  boost::tie(actualConditional, actualFactor) = eliminate(gfg, ordering);
+  EXPECT(assert_equal(*expectedConditional, *actualConditional, 1e-9));
+  EXPECT(assert_equal(*expectedFactor, *actualFactor, 1e-9));
+
+  // clear invalidates the cache
+  eliminate.clear();
+  EXPECT_LONGS_EQUAL(0, eliminate.size());
+}
+
 /* ************************************************************************* */
 TEST ( JacobianFactor, constraint_eliminate1 )
 {
@@ -18,6 +18,7 @@
  */
 
 #include <gtsam/linear/KalmanFilter.h>
+#include <gtsam/linear/RegularKalmanFilter.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/base/Testable.h>
 #include <CppUnitLite/TestHarness.h>
@@ -286,6 +287,64 @@ TEST( KalmanFilter, QRvsCholesky ) {
   EXPECT(assert_equal(expected2, pb3->covariance(), 1e-7));
 }
 
+/* ************************************************************************* */
+// The fixed-dimension filter must agree with the graph-based one
+TEST( KalmanFilter, Regular ) {
+
+  typedef RegularKalmanFilter<2> KF2;
+
+  // Non-trivial dynamics and measurement models
+  Matrix2 F = (Matrix2() << 1.0, 0.1, 0.2, 1.1).finished();
+  Eigen::Matrix<double, 2, 3> B =
+      (Eigen::Matrix<double, 2, 3>() << 1.0, 0.1, 0.2, 1.1, 1.2, 0.8).finished();
+  Vector3 u(1.0, 0.0, 2.0);
+  Vector2 sigmasQ(0.1, 0.2);
+  Matrix2 H = (Matrix2() << 1.0, 0.0, 0.5, 1.0).finished();
+  Vector2 z(1.0, 0.1);
+  Vector2 sigmasR(0.3, 0.4);
+
+  // Reference: the dynamic, factor-graph based filter
+  KalmanFilter kf(2);
+  KalmanFilter::State q0 = kf.init(Vector2(0.2, -0.1),
+      noiseModel::Diagonal::Sigmas(Vector2(0.5, 0.7)));
+  KalmanFilter::State q1 = kf.predict(q0, F, B, u,
+      noiseModel::Diagonal::Sigmas(sigmasQ));
+  KalmanFilter::State q2 = kf.update(q1, H, z,
+      noiseModel::Diagonal::Sigmas(sigmasR));
+
+  // Fixed-size path, diagonal models
+  KF2::State p0 = KF2::init(Vector2(0.2, -0.1), Vector2(0.5, 0.7));
+  EXPECT(assert_equal(q0->mean(), Vector(p0.mean())));
+  EXPECT(assert_equal(q0->covariance(), Matrix(p0.covariance())));
+
+  KF2::State p1 = KF2::predict(p0, F, B, u, sigmasQ);
+  EXPECT(assert_equal(q1->mean(), Vector(p1.mean())));
+  EXPECT(assert_equal(q1->covariance(), Matrix(p1.covariance())));
+
+  KF2::State p2 = KF2::update(p1, H, z, sigmasR);
+  EXPECT(assert_equal(q2->mean(), Vector(p2.mean())));
+  EXPECT(assert_equal(q2->information(), Matrix(p2.information())));
+
+  // Full-covariance versions
+  Matrix2 Q = (Matrix2() << 0.01, 0.002, 0.002, 0.04).finished();
+  Matrix2 R = (Matrix2() << 0.09, 0.01, 0.01, 0.16).finished();
+  KalmanFilter::State q3 = kf.predictQ(q2, F, B, u, Q);
+  KalmanFilter::State q4 = kf.updateQ(q3, H, z, R);
+  KF2::State p3 = KF2::predictQ(p2, F, B, u, Q);
+  KF2::State p4 = KF2::updateQ<2>(p3, H, z, R);
+  EXPECT(assert_equal(q3->covariance(), Matrix(p3.covariance())));
+  EXPECT(assert_equal(q4->mean(), Vector(p4.mean())));
+  EXPECT(assert_equal(q4->covariance(), Matrix(p4.covariance())));
+
+  // predict2 with pre-whitened rows matches predictQ, as in TEST(predict)
+  Matrix2 M = Q.inverse();
+  Matrix2 W = Eigen::LLT<Matrix2>(M).matrixL().transpose();
+  KF2::State p3b = KF2::predict2(p2, Matrix2(-W * F), W,
+      Vector2(W * B * u), Vector2(1.0, 1.0));
+  EXPECT(assert_equal(Vector(p3.mean()), Vector(p3b.mean())));
+  EXPECT(assert_equal(Matrix(p3.covariance()), Matrix(p3b.covariance())));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,92 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testMultiHypothesisSolver.cpp
+ * @brief Unit tests for the shared-factorization hypothesis solver
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/linear/MultiHypothesisSolver.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// The shared graph: a chain 0-1-2-3-4 with a prior on 0; the hypotheses
+// below disagree about a loop-closure measurement touching 3 and 4
+static GaussianFactorGraph createCommonGraph() {
+  GaussianFactorGraph graph;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  graph.add(0, I_2x2, Vector2(0.1, 0.0), unit2);
+  for (size_t i = 1; i < 5; ++i)
+    graph.add(i - 1, -I_2x2, i, I_2x2, Vector2(1.0, 0.5 * i), unit2);
+  return graph;
+}
+
+static GaussianFactorGraph createHypothesis(double measured) {
+  GaussianFactorGraph hypothesis;
+  hypothesis.add(3, -I_2x2, 4, I_2x2, Vector2(measured, measured),
+      noiseModel::Unit::Create(2));
+  return hypothesis;
+}
+
+/* ************************************************************************* */
+TEST(MultiHypothesisSolver, matchesFullSolve) {
+  GaussianFactorGraph common = createCommonGraph();
+  KeyVector branchKeys{3, 4};
+  MultiHypothesisSolver solver(common, branchKeys);
+
+  // Each hypothesis completion matches solving the full variant from scratch
+  for (double measured : {0.0, 1.0, 2.5}) {
+    GaussianFactorGraph hypothesis = createHypothesis(measured);
+
+    GaussianFactorGraph full(common);
+    full.push_back(hypothesis);
+    VectorValues expected = full.optimize();
+
+    VectorValues actual = solver.solve(hypothesis);
+    EXPECT(assert_equal(expected, actual, 1e-9));
+  }
+
+  // The shared part was eliminated once: only the branch variables remain
+  for (const GaussianFactor::shared_ptr& factor : solver.remainingGraph())
+    for (Key key : *factor)
+      EXPECT(key == 3 || key == 4);
+}
+
+/* ************************************************************************* */
+TEST(MultiHypothesisSolver, validation) {
+  GaussianFactorGraph common = createCommonGraph();
+  KeyVector branchKeys{3, 4};
+  MultiHypothesisSolver solver(common, branchKeys);
+
+  // A hypothesis touching a shared variable is rejected
+  GaussianFactorGraph bad;
+  bad.add(1, I_2x2, Vector2(0.0, 0.0), noiseModel::Unit::Create(2));
+  CHECK_EXCEPTION(solver.solve(bad), std::invalid_argument);
+
+  // Branching on every variable leaves nothing to share
+  KeyVector allKeys{0, 1, 2, 3, 4};
+  CHECK_EXCEPTION(MultiHypothesisSolver(common, allKeys),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -127,6 +127,76 @@ TEST(NoiseModel, equals)
   EXPECT(assert_inequal(*i1,*i2));
 }
 
+/* ************************************************************************* */
+TEST(NoiseModel, Intern)
+{
+  // Equal models collapse to one canonical instance
+  SharedNoiseModel i1 = intern(Isotropic::Sigma(3, kSigma));
+  SharedNoiseModel i2 = intern(Isotropic::Sigma(3, kSigma));
+  EXPECT(i1.get() == i2.get());
+
+  // An already-canonical instance is returned as-is
+  EXPECT(i1.get() == intern(i1).get());
+
+  // Different parameters or types stay distinct
+  SharedNoiseModel i3 = intern(Isotropic::Sigma(3, 0.7));
+  EXPECT(i1.get() != i3.get());
+  SharedNoiseModel d1 = intern(Diagonal::Sigmas(Vector3(0.1, 0.2, 0.3)));
+  EXPECT(i1.get() != d1.get());
+
+  // The smart Diagonal constructor yields an Isotropic for equal sigmas,
+  // which then interns to the same canonical instance
+  SharedNoiseModel d2 =
+      intern(Diagonal::Sigmas(Vector3(kSigma, kSigma, kSigma)));
+  EXPECT(i1.get() == d2.get());
+
+  // Null models pass through
+  EXPECT(!intern(SharedNoiseModel()));
+}
+
+/* ************************************************************************* */
+TEST(NoiseModel, InternedIsotropic)
+{
+  // The keyed fast path hands out one shared instance per (dim, sigma)
+  Isotropic::shared_ptr i1 = Isotropic::Interned(3, kSigma);
+  Isotropic::shared_ptr i2 = Isotropic::Interned(3, kSigma);
+  EXPECT(i1.get() == i2.get());
+  EXPECT(assert_equal(*Isotropic::Sigma(3, kSigma), *i1));
+
+  // Different parameters stay distinct
+  EXPECT(i1.get() != Isotropic::Interned(3, 0.7).get());
+  EXPECT(i1.get() != Isotropic::Interned(2, kSigma).get());
+
+  // Unit models of common dimensions are flyweights as well
+  EXPECT(Unit::Create(3).get() == Unit::Create(3).get());
+  EXPECT(Unit::Create(3).get() != Unit::Create(2).get());
+}
+
+/* ************************************************************************* */
+TEST(NoiseModel, TriangularWhiten)
+{
+  // A full (non-diagonal) square root information matrix
+  Matrix3 Rfull;
+  Rfull << 2.0, 0.5, -0.3, 0.0, 1.5, 0.8, 0.0, 0.0, 3.0;
+  Gaussian::shared_ptr model = Gaussian::SqrtInformation(Rfull, false);
+
+  Vector v = Vector3(1.0, -2.0, 3.0);
+  EXPECT(assert_equal(Vector(Rfull * v), model->whiten(v)));
+  EXPECT(assert_equal(v, model->unwhiten(model->whiten(v))));
+
+  Matrix H = (Matrix(3, 2) << 1., 2., 3., 4., 5., 6.).finished();
+  Matrix expected = Rfull * H;
+  EXPECT(assert_equal(expected, model->Whiten(H)));
+
+  Matrix H2 = H;
+  model->WhitenInPlace(H2);
+  EXPECT(assert_equal(expected, H2));
+
+  Matrix H3 = H;
+  model->WhitenInPlace(H3.block(0, 0, 3, 2));
+  EXPECT(assert_equal(expected, H3));
+}
+
 // TODO enable test once a mechanism for smart constraints exists
 ///* ************************************************************************* */
 //TEST(NoiseModel, ConstrainedSmart )
@@ -607,6 +677,37 @@ TEST(NoiseModel, robustNoiseHuber)
   DOUBLES_EQUAL(sqrt(k/100.0)*1000.0, A(1,1), 1e-8);
 }
 
+TEST(NoiseModel, WhitenSystems)
+{
+  // Two factors sharing one diagonal model, whitened in a single batch call
+  const SharedDiagonal model = Diagonal::Sigmas(Vector2(0.5, 2.0));
+
+  Matrix A1 = (Matrix(2, 2) << 1.0, 2.0, 3.0, 4.0).finished();
+  Matrix A2 = (Matrix(2, 2) << 5.0, 6.0, 7.0, 8.0).finished();
+  Vector b1 = Vector2(1.0, 2.0), b2 = Vector2(3.0, 4.0);
+
+  // expected: whiten each factor individually
+  Matrix expectedA1 = A1, expectedA2 = A2;
+  Vector expectedB1 = b1, expectedB2 = b2;
+  model->WhitenSystem(expectedA1, expectedB1);
+  model->WhitenSystem(expectedA2, expectedB2);
+
+  vector<Matrix> factor1, factor2;
+  factor1 += A1;
+  factor2 += A2;
+  vector<vector<Matrix> > A;
+  A += factor1, factor2;
+  vector<Vector> b;
+  b += b1, b2;
+  model->WhitenSystems(A, b);
+
+  EXPECT(assert_equal(expectedA1, A[0][0]));
+  EXPECT(assert_equal(expectedA2, A[1][0]));
+  EXPECT(assert_equal(expectedB1, b[0]));
+  EXPECT(assert_equal(expectedB2, b[1]));
+}
+
+/* ************************************************************************* */
 TEST(NoiseModel, robustNoiseGemanMcClure)
 {
   const double k = 1.0, error1 = 1.0, error2 = 100.0;
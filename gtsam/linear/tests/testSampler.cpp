@@ -40,6 +40,48 @@ TEST(testSampler, basic) {
   EXPECT(assert_equal(sampler2.sample(), sampler3.sample(), tol));
 }
 
+/* ************************************************************************* */
+TEST(testSampler, sampleMatrix) {
+  auto model = noiseModel::Diagonal::Sigmas(kSigmas);
+  Sampler batch(model, 7), loop(model, 7);
+  const Matrix samples = batch.sampleMatrix(4);
+  EXPECT_LONGS_EQUAL(3, samples.rows());
+  EXPECT_LONGS_EQUAL(4, samples.cols());
+  // columns reproduce the stream of repeated sample() calls
+  for (size_t j = 0; j < 4; j++)
+    EXPECT(assert_equal(loop.sample(), Vector(samples.col(j)), tol));
+}
+
+/* ************************************************************************* */
+TEST(testSampler, covarianceSampler) {
+  Matrix22 covariance;
+  covariance << 4.0, 1.0, 1.0, 2.0;
+  CovarianceSampler sampler(covariance, 7), loopSampler(covariance, 7);
+  EXPECT_LONGS_EQUAL(2, sampler.dim());
+
+  // the cached square root reproduces the covariance
+  EXPECT(assert_equal(covariance,
+      Matrix(sampler.sqrtCovariance() * sampler.sqrtCovariance().transpose()),
+      tol));
+
+  // batch drawing matches repeated single draws
+  const Matrix samples = sampler.sampleMatrix(3);
+  for (size_t j = 0; j < 3; j++)
+    EXPECT(assert_equal(loopSampler.sample(), Vector(samples.col(j)), tol));
+
+  // the sample covariance approaches the requested covariance
+  const size_t N = 100000;
+  CovarianceSampler big(covariance, 42);
+  const Matrix draws = big.sampleMatrix(N);
+  const Matrix sampleCovariance = draws * draws.transpose() / double(N);
+  EXPECT(assert_equal(covariance, sampleCovariance, 0.1));
+
+  // an indefinite covariance is rejected
+  Matrix22 indefinite;
+  indefinite << 1.0, 2.0, 2.0, 1.0;
+  CHECK_EXCEPTION(CovarianceSampler(indefinite, 1), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,94 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testSolvePlanCache.cpp
+ * @brief Unit tests for structural hashing and the solve plan cache
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/linear/SolvePlanCache.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// A small chain graph; the scale parameter changes the numbers but not the
+// structure, mimicking relinearization of the same topology every frame
+static GaussianFactorGraph createChain(double scale) {
+  GaussianFactorGraph graph;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  graph.add(0, scale * I_2x2, Vector2(scale, 0.0), unit2);
+  graph.add(0, -scale * I_2x2, 1, scale * I_2x2, Vector2(1.0, scale), unit2);
+  graph.add(1, -scale * I_2x2, 2, scale * I_2x2, Vector2(scale, 1.0), unit2);
+  return graph;
+}
+
+/* ************************************************************************* */
+TEST(SolvePlanCache, structuralHash) {
+  GaussianFactorGraph graph1 = createChain(1.0);
+  GaussianFactorGraph graph2 = createChain(2.5);
+
+  // Same structure, different numbers: same fingerprint
+  EXPECT_LONGS_EQUAL(graph1.structuralHash(), graph2.structuralHash());
+
+  // An extra factor changes the fingerprint
+  GaussianFactorGraph graph3 = createChain(1.0);
+  graph3.add(2, I_2x2, Vector2(0.0, 0.0), noiseModel::Unit::Create(2));
+  EXPECT(graph1.structuralHash() != graph3.structuralHash());
+
+  // Different keys change the fingerprint too
+  GaussianFactorGraph graph4;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  graph4.add(0, I_2x2, Vector2(1.0, 0.0), unit2);
+  graph4.add(0, -I_2x2, 1, I_2x2, Vector2(1.0, 1.0), unit2);
+  graph4.add(1, -I_2x2, 3, I_2x2, Vector2(1.0, 1.0), unit2);
+  EXPECT(graph1.structuralHash() != graph4.structuralHash());
+}
+
+/* ************************************************************************* */
+TEST(SolvePlanCache, reuse) {
+  SolvePlanCache cache;
+
+  // First frame runs the symbolic phase
+  GaussianFactorGraph graph1 = createChain(1.0);
+  VectorValues actual1 = cache.optimize(graph1);
+  EXPECT(assert_equal(graph1.optimize(), actual1));
+  EXPECT_LONGS_EQUAL(1, cache.misses());
+  EXPECT_LONGS_EQUAL(0, cache.hits());
+  EXPECT_LONGS_EQUAL(1, cache.size());
+
+  // Same structure with new numbers replays the numeric phase only
+  GaussianFactorGraph graph2 = createChain(3.0);
+  VectorValues actual2 = cache.optimize(graph2);
+  EXPECT(assert_equal(graph2.optimize(), actual2));
+  EXPECT_LONGS_EQUAL(1, cache.misses());
+  EXPECT_LONGS_EQUAL(1, cache.hits());
+
+  // A structurally different graph misses and is cached separately
+  GaussianFactorGraph graph3 = createChain(1.0);
+  graph3.add(2, I_2x2, Vector2(0.5, 0.5), noiseModel::Unit::Create(2));
+  VectorValues actual3 = cache.optimize(graph3);
+  EXPECT(assert_equal(graph3.optimize(), actual3));
+  EXPECT_LONGS_EQUAL(2, cache.misses());
+  EXPECT_LONGS_EQUAL(2, cache.size());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
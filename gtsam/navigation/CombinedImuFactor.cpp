@@ -109,13 +109,12 @@ void PreintegratedCombinedMeasurements::integrateMeasurement(
   Matrix3 theta_H_biasOmega = -C.topRows<3>();
   Matrix3 vel_H_biasAcc = -B.bottomRows<3>();
 
-  // overall Jacobian wrt preintegrated measurements (df/dx)
-  Eigen::Matrix<double, 15, 15> F;
-  F.setZero();
-  F.block<9, 9>(0, 0) = A;
-  F.block<3, 3>(0, 12) = theta_H_biasOmega;
-  F.block<3, 3>(6, 9) = vel_H_biasAcc;
-  F.block<6, 6>(9, 9) = I_6x6;
+  // The overall Jacobian wrt preintegrated measurements (df/dx) is
+  //   F = [ A  F_ab ]
+  //       [ 0  I_6  ]
+  // where the 9x6 block F_ab is zero except for theta wrt biasOmega and
+  // velocity wrt biasAcc, so we propagate the partitioned covariance with
+  // these few non-zero blocks below instead of forming the dense 15x15 F.
 
   // propagate uncertainty
   // TODO(frank): use noiseModel routine so we can have arbitrary noise models.
@@ -145,7 +144,34 @@ void PreintegratedCombinedMeasurements::integrateMeasurement(
       * theta_H_biasOmega.transpose();
   D_v_R(&G_measCov_Gt) = temp;
   D_R_v(&G_measCov_Gt) = temp.transpose();
-  preintMeasCov_ = F * preintMeasCov_ * F.transpose() + G_measCov_Gt;
+
+  // Structure-exploiting F * preintMeasCov_ * F.transpose(): partition the
+  // covariance as P = [P11 P12; P12' P22] with P22 the 6x6 bias block, which
+  // the bottom rows [0 I_6] of F leave untouched
+  const Matrix9 P11 = preintMeasCov_.block<9, 9>(0, 0);
+  const Eigen::Matrix<double, 9, 6> P12 = preintMeasCov_.block<9, 6>(0, 9);
+  const Matrix6 P22 = preintMeasCov_.block<6, 6>(9, 9);
+
+  // M = A * P11 + F_ab * P12'
+  Matrix9 M = A * P11;
+  M.topRows<3>() += theta_H_biasOmega * P12.rightCols<3>().transpose();
+  M.bottomRows<3>() += vel_H_biasAcc * P12.leftCols<3>().transpose();
+
+  // X = A * P12 + F_ab * P22, the new state-bias cross covariance
+  Eigen::Matrix<double, 9, 6> X = A * P12;
+  X.topRows<3>() += theta_H_biasOmega * P22.bottomRows<3>();
+  X.bottomRows<3>() += vel_H_biasAcc * P22.topRows<3>();
+
+  // New state block M * A' + X * F_ab', where F_ab' only hits the
+  // theta and velocity columns
+  Matrix9 newP11 = M * A.transpose();
+  newP11.leftCols<3>() += X.rightCols<3>() * theta_H_biasOmega.transpose();
+  newP11.rightCols<3>() += X.leftCols<3>() * vel_H_biasAcc.transpose();
+
+  preintMeasCov_.block<9, 9>(0, 0) = newP11;
+  preintMeasCov_.block<9, 6>(0, 9) = X;
+  preintMeasCov_.block<6, 9>(9, 0) = X.transpose();
+  preintMeasCov_ += G_measCov_Gt;
 }
 
 //------------------------------------------------------------------------------
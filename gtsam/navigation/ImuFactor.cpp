@@ -49,6 +49,20 @@ void PreintegratedImuMeasurements::resetIntegration() {
   preintMeasCov_.setZero();
 }
 
+//------------------------------------------------------------------------------
+PreintegratedImuMeasurements::Snapshot PreintegratedImuMeasurements::snapshot() const {
+  Snapshot saved;
+  saved.base = PreintegrationType::snapshot();
+  saved.preintMeasCov = preintMeasCov_;
+  return saved;
+}
+
+//------------------------------------------------------------------------------
+void PreintegratedImuMeasurements::resetIntegrationTo(const Snapshot& snapshot) {
+  PreintegrationType::resetIntegrationTo(snapshot.base);
+  preintMeasCov_ = snapshot.preintMeasCov;
+}
+
 //------------------------------------------------------------------------------
 void PreintegratedImuMeasurements::integrateMeasurement(
     const Vector3& measuredAcc, const Vector3& measuredOmega, double dt) {
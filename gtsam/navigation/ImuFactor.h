@@ -119,6 +119,20 @@ public:
   /// Re-initialize PreintegratedIMUMeasurements
   void resetIntegration() override;
 
+  /// Integration state snapshot, extending the base snapshot with the
+  /// propagated measurement covariance
+  struct Snapshot {
+    PreintegrationType::Snapshot base;
+    Matrix9 preintMeasCov;
+  };
+
+  /// Capture the current integration state in O(1); see
+  /// PreintegrationType::snapshot
+  Snapshot snapshot() const;
+
+  /// Roll the integration state back to a previously captured snapshot
+  void resetIntegrationTo(const Snapshot& snapshot);
+
   /**
    * Add a single IMU measurement to the preintegration.
    * @param measuredAcc Measured acceleration (in body frame, as given by the sensor)
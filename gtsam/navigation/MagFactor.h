@@ -17,6 +17,8 @@
  */
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/HessianFactor.h>
 #include <gtsam/geometry/Rot2.h>
 #include <gtsam/geometry/Rot3.h>
 
@@ -210,5 +212,131 @@ public:
   }
 };
 
+/**
+ * Batched version of MagFactor2 for calibration sweeps: a single factor
+ * holding all magnetometer samples of a batch, using the same model
+ * measured bM = bRn * nM + bias with known per-sample rotations.  The
+ * measurement model is linear in both unknowns, so linearize() accumulates
+ * the normal equations over all samples in one vectorized pass and emits a
+ * single 6x6 HessianFactor, instead of materializing one 3x6 JacobianFactor
+ * per sample.  With tens of thousands of samples against two unknowns this
+ * removes virtually all of the per-factor allocation and elimination cost.
+ */
+class MagFactor2Batch: public NonlinearFactor {
+
+  typedef NonlinearFactor Base;
+
+  Matrix bRnStacked_; ///< the known rotations bRn, stacked vertically (3m x 3)
+  Vector measuredStacked_; ///< the measured magnetometer values, stacked (3m)
+  Matrix3 sumRt_; ///< running sum of bRn' over all samples
+  SharedIsotropic noiseModel_; ///< the per-sample noise, required isotropic
+
+public:
+
+  /**
+   * Constructor of an empty batch
+   * @param key1 of the unknown local earth magnetic field nM, in nav frame
+   * @param key2 of the unknown 3D bias
+   * @param model of the per-sample additive Gaussian noise, must be isotropic
+   */
+  MagFactor2Batch(Key key1, Key key2, const SharedNoiseModel& model) :
+      sumRt_(Z_3x3) {
+    keys_.push_back(key1);
+    keys_.push_back(key2);
+    noiseModel_ = boost::dynamic_pointer_cast<noiseModel::Isotropic>(model);
+    if (!noiseModel_ || noiseModel_->dim() != 3)
+      throw std::invalid_argument(
+          "MagFactor2Batch: requires an isotropic noise model of dimension 3");
+  }
+
+  /// @return a deep copy of this factor
+  virtual NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<NonlinearFactor>(
+        NonlinearFactor::shared_ptr(new MagFactor2Batch(*this)));
+  }
+
+  /// Add a sample: a measured magnetometer value and the known rotation nRb
+  void add(const Point3& measured, const Rot3& nRb) {
+    const size_t m = nrMeasurements();
+    bRnStacked_.conservativeResize(3 * m + 3, 3);
+    measuredStacked_.conservativeResize(3 * m + 3);
+    const Matrix3 bRn = nRb.inverse().matrix();
+    bRnStacked_.block<3, 3>(3 * m, 0) = bRn;
+    measuredStacked_.segment<3>(3 * m) = Vector3(measured);
+    sumRt_ += bRn.transpose();
+  }
+
+  /// The number of samples in the batch
+  size_t nrMeasurements() const {
+    return measuredStacked_.size() / 3;
+  }
+
+  /// Stacked prediction errors h(nM, bias) - z over all samples (3m-vector)
+  Vector unwhitenedError(const Values& x) const {
+    const Point3 nM = x.at<Point3>(keys_[0]);
+    const Point3 bias = x.at<Point3>(keys_[1]);
+    Vector e = bRnStacked_ * Vector3(nM) - measuredStacked_;
+    const Vector3 b(bias);
+    for (size_t i = 0; i < nrMeasurements(); ++i)
+      e.segment<3>(3 * i) += b;
+    return e;
+  }
+
+  /// 0.5 * sum of whitened squared errors over all samples
+  virtual double error(const Values& x) const {
+    const Vector e = unwhitenedError(x);
+    return 0.5 * e.squaredNorm() / noiseModel_->sigma() / noiseModel_->sigma();
+  }
+
+  /// The total error dimension: three rows per sample
+  virtual size_t dim() const {
+    return measuredStacked_.size();
+  }
+
+  /**
+   * Accumulate the normal equations over all samples and return them as a
+   * single HessianFactor on (nM, bias).  The model is linear, so the Hessian
+   * blocks depend only on the stored rotations: G11 = sum bRn'bRn = m*I,
+   * G12 = sum bRn', G22 = m*I, all scaled by the measurement precision.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    const double precision = 1.0 / (noiseModel_->sigma() * noiseModel_->sigma());
+    const double m = static_cast<double>(nrMeasurements());
+    const Vector e = unwhitenedError(x);
+
+    // Vectorized accumulation: g1 = -sum bRn'e_i, g2 = -sum e_i
+    const Vector3 g1 = -precision * (bRnStacked_.transpose() * e);
+    Vector3 sumE = Z_3x1;
+    for (size_t i = 0; i < nrMeasurements(); ++i)
+      sumE += e.segment<3>(3 * i);
+    const Vector3 g2 = -precision * sumE;
+
+    const Matrix3 G11 = precision * m * I_3x3;
+    const Matrix3 G12 = precision * sumRt_;
+    const Matrix3 G22 = precision * m * I_3x3;
+    const double f = precision * e.squaredNorm();
+    return boost::make_shared<HessianFactor>(keys_[0], keys_[1], G11, G12, g1,
+        G22, g2, f);
+  }
+
+  /// print
+  virtual void print(const std::string& s = "",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+    std::cout << s << "MagFactor2Batch(" << keyFormatter(keys_[0]) << ","
+        << keyFormatter(keys_[1]) << "): " << nrMeasurements() << " samples"
+        << std::endl;
+    noiseModel_->print("  noise model: ");
+  }
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& expected, double tol = 1e-9) const {
+    const MagFactor2Batch* e = dynamic_cast<const MagFactor2Batch*>(&expected);
+    return e != nullptr && Base::equals(*e, tol)
+        && equal_with_abs_tol(bRnStacked_, e->bRnStacked_, tol)
+        && equal_with_abs_tol(measuredStacked_, e->measuredStacked_, tol)
+        && noiseModel_->equals(*e->noiseModel_, tol);
+  }
+};
+
 }
 
@@ -43,6 +43,30 @@ void ManifoldPreintegration::resetIntegration() {
   delVdelBiasOmega_.setZero();
 }
 
+//------------------------------------------------------------------------------
+ManifoldPreintegration::Snapshot ManifoldPreintegration::snapshot() const {
+  Snapshot saved;
+  saved.deltaTij = deltaTij_;
+  saved.deltaXij = deltaXij_;
+  saved.delRdelBiasOmega = delRdelBiasOmega_;
+  saved.delPdelBiasAcc = delPdelBiasAcc_;
+  saved.delPdelBiasOmega = delPdelBiasOmega_;
+  saved.delVdelBiasAcc = delVdelBiasAcc_;
+  saved.delVdelBiasOmega = delVdelBiasOmega_;
+  return saved;
+}
+
+//------------------------------------------------------------------------------
+void ManifoldPreintegration::resetIntegrationTo(const Snapshot& snapshot) {
+  deltaTij_ = snapshot.deltaTij;
+  deltaXij_ = snapshot.deltaXij;
+  delRdelBiasOmega_ = snapshot.delRdelBiasOmega;
+  delPdelBiasAcc_ = snapshot.delPdelBiasAcc;
+  delPdelBiasOmega_ = snapshot.delPdelBiasOmega;
+  delVdelBiasAcc_ = snapshot.delVdelBiasAcc;
+  delVdelBiasOmega_ = snapshot.delVdelBiasOmega;
+}
+
 //------------------------------------------------------------------------------
 bool ManifoldPreintegration::equals(const ManifoldPreintegration& other,
     double tol) const {
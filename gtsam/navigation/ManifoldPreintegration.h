@@ -69,6 +69,28 @@ public:
   /// Re-initialize PreintegratedMeasurements
   void resetIntegration() override;
 
+  /**
+   * Copyable fixed-size block capturing the complete integration state.
+   * Taking and restoring a snapshot is a plain memberwise copy, so callers
+   * that branch preintegration at candidate keyframe times can roll back in
+   * O(1) instead of re-integrating raw measurements from a buffer.
+   */
+  struct Snapshot {
+    double deltaTij;
+    NavState deltaXij;
+    Matrix3 delRdelBiasOmega;
+    Matrix3 delPdelBiasAcc;
+    Matrix3 delPdelBiasOmega;
+    Matrix3 delVdelBiasAcc;
+    Matrix3 delVdelBiasOmega;
+  };
+
+  /// Capture the current integration state; params and bias are not copied
+  Snapshot snapshot() const;
+
+  /// Roll the integration state back to a previously captured snapshot
+  void resetIntegrationTo(const Snapshot& snapshot);
+
   /// @}
 
   /// @name Instance variables access
@@ -172,45 +172,52 @@ NavState NavState::update(const Vector3& b_acceleration, const Vector3& b_omega,
     const double dt, OptionalJacobian<9, 9> F, OptionalJacobian<9, 3> G1,
     OptionalJacobian<9, 3> G2) const {
 
-  Vector9 xi;
-  Matrix39 D_xiP_state;
-  Vector3 b_v = bodyVelocity(F ? &D_xiP_state : 0);
-  double dt22 = 0.5 * dt * dt;
-
-  // Integrate on tangent space. TODO(frank): coriolis?
-  dR(xi) << dt * b_omega;
-  dP(xi) << dt * b_v + dt22 * b_acceleration;
-  dV(xi) << dt * b_acceleration;
-
-  // Bring back to manifold
-  Matrix9 D_newState_xi;
-  NavState newState = retract(xi, F, G1 || G2 ? &D_newState_xi : 0);
-
-  // Derivative wrt state is computed by retract directly
-  // However, as dP(xi) also depends on state, we need to add that contribution
-  if (F) {
-    F->middleRows<3>(3) += dt * D_t_t(F) * D_xiP_state;
-  }
-  // derivative wrt acceleration
-  if (G1) {
-    // D_newState_dPxi = D_newState_xi.middleCols<3>(3)
-    // D_dPxi_acc = dt22 * I_3x3
-    // D_newState_dVxi = D_newState_xi.rightCols<3>()
-    // D_dVxi_acc = dt * I_3x3
-    // *G2 = D_newState_acc = D_newState_dPxi * D_dPxi_acc + D_newState_dVxi * D_dVxi_acc
-    *G1 = D_newState_xi.middleCols<3>(3) * dt22
-        + D_newState_xi.rightCols<3>() * dt;
+  // Fused version of integrating on the tangent space and retracting: the
+  // rotation matrix is formed once and the velocity round-trip through the
+  // body frame cancels, so neither bodyVelocity nor retract Jacobians need
+  // to be materialized. TODO(frank): coriolis?
+  const double dt22 = 0.5 * dt * dt;
+  Matrix3 D_bRc_xi;
+  const Rot3 bRc = Rot3::Expmap(dt * b_omega, G2 ? &D_bRc_xi : 0);
+  const Matrix3 R = R_.matrix();
+  const Vector3 n_a = R * b_acceleration; // acceleration in nav frame
+  NavState newState(R_ * bRc, t_ + dt * v_ + dt22 * n_a, v_ + dt * n_a);
+
+  // Closed-form derivatives, in the new state's frame. The chain through
+  // retract contributes -skew(dP(xi)) to the position-attitude block, and the
+  // body velocity's own dependence on attitude contributes dt * skew(b_v);
+  // the velocity terms cancel, leaving only the acceleration ones.
+  if (F || G1) {
+    const Matrix3 Rct = bRc.transpose();
+    if (F) {
+      const Matrix3 A = skewSymmetric(b_acceleration);
+      F->setZero();
+      D_R_R(F) = Rct;
+      D_t_R(F) = (-dt22) * (Rct * A);
+      D_t_t(F) = Rct;
+      D_t_v(F) = dt * Rct;
+      D_v_R(F) = (-dt) * (Rct * A);
+      D_v_v(F) = Rct;
+    }
+    // derivative wrt acceleration
+    if (G1)
+      *G1 << Z_3x3, dt22 * Rct, dt * Rct;
   }
   // derivative wrt omega
-  if (G2) {
-    // D_newState_dRxi = D_newState_xi.leftCols<3>()
-    // D_dRxi_omega = dt * I_3x3
-    // *G1 = D_newState_omega = D_newState_dRxi * D_dRxi_omega
-    *G2 = D_newState_xi.leftCols<3>() * dt;
-  }
+  if (G2)
+    *G2 << dt * D_bRc_xi, Z_3x3, Z_3x3;
   return newState;
 }
 
+//------------------------------------------------------------------------------
+NavState NavState::update(const Vector3& b_acceleration, const Vector3& b_omega,
+    const double dt) const {
+  const double dt22 = 0.5 * dt * dt;
+  const Vector3 n_a = R_ * b_acceleration; // acceleration in nav frame
+  return NavState(R_ * Rot3::Expmap(dt * b_omega), //
+      t_ + dt * v_ + dt22 * n_a, v_ + dt * n_a);
+}
+
 //------------------------------------------------------------------------------
 Vector9 NavState::coriolis(double dt, const Vector3& omega, bool secondOrder,
     OptionalJacobian<9, 9> H) const {
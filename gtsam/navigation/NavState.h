@@ -174,6 +174,12 @@ public:
       const double dt, OptionalJacobian<9, 9> F, OptionalJacobian<9, 3> G1,
       OptionalJacobian<9, 3> G2) const;
 
+  /// Jacobian-free version of update, for prediction-only dead reckoning:
+  /// same integration, fused so the rotation matrix is formed only once and
+  /// no Jacobian branches are evaluated.
+  NavState update(const Vector3& b_acceleration, const Vector3& b_omega,
+      const double dt) const;
+
   /// Compute tangent space contribution due to Coriolis forces
   Vector9 coriolis(double dt, const Vector3& omega, bool secondOrder = false,
       OptionalJacobian<9, 9> H = boost::none) const;
@@ -19,8 +19,14 @@
 #include <gtsam/base/timing.h>
 
 #include <boost/assign.hpp>
+#include <algorithm>
 #include <cmath>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 using namespace std;
 using namespace boost::assign;
 
@@ -84,6 +90,66 @@ Matrix9 ScenarioRunner::estimateCovariance(double T, size_t N,
   return Q / (N - 1);
 }
 
+PreintegratedImuMeasurements ScenarioRunner::integrateCorrupted(
+    double T, const Bias& estimatedBias, Sampler& gyroSampler,
+    Sampler& accSampler) const {
+  PreintegratedImuMeasurements pim(p_, estimatedBias);
+
+  const double dt = imuSampleTime();
+  const size_t nrSteps = T / dt;
+  double t = 0;
+  for (size_t k = 0; k < nrSteps; k++, t += dt) {
+    Vector3 measuredOmega = actualAngularVelocity(t) +
+                            estimatedBias_.gyroscope() +
+                            gyroSampler.sample() / sqrt_dt_;
+    Vector3 measuredAcc = actualSpecificForce(t) +
+                          estimatedBias_.accelerometer() +
+                          accSampler.sample() / sqrt_dt_;
+    pim.integrateMeasurement(measuredAcc, measuredOmega, dt);
+  }
+
+  return pim;
+}
+
+Matrix9 ScenarioRunner::estimateCovarianceParallel(
+    double T, size_t N, const Bias& estimatedBias) const {
+  gttic_(estimateCovarianceParallel);
+
+  // Get predict prediction from ground truth measurements
+  NavState prediction = predict(integrate(T));
+
+  // Sample in fixed-size chunks, each with its own deterministically seeded
+  // streams, so the estimate does not depend on the number of threads
+  const size_t chunkSize = 16;
+  const size_t nrChunks = (N + chunkSize - 1) / chunkSize;
+  Matrix samples(9, N);
+
+  auto sampleChunk = [&](size_t c) {
+    Sampler gyroSampler(Diagonal(p_->gyroscopeCovariance), 10 + c);
+    Sampler accSampler(Diagonal(p_->accelerometerCovariance), 29284 + c);
+    const size_t end = min(N, (c + 1) * chunkSize);
+    for (size_t i = c * chunkSize; i < end; i++) {
+      auto pim = integrateCorrupted(T, estimatedBias, gyroSampler, accSampler);
+      NavState sampled = predict(pim);
+      samples.col(i) = sampled.localCoordinates(prediction);
+    }
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrChunks),
+      [&sampleChunk](const tbb::blocked_range<size_t>& range) {
+        for (size_t c = range.begin(); c != range.end(); ++c) sampleChunk(c);
+      });
+#else
+  for (size_t c = 0; c < nrChunks; c++) sampleChunk(c);
+#endif
+
+  // Compute MC covariance with batched matrix products
+  Vector9 sampleMean = samples.rowwise().mean();
+  Matrix centered = samples.colwise() - sampleMean;
+  return centered * centered.transpose() / (N - 1);
+}
+
 Matrix6 ScenarioRunner::estimateNoiseCovariance(size_t N) const {
   Matrix samples(6, N);
   Vector6 sum = Vector6::Zero();
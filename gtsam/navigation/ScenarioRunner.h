@@ -50,6 +50,13 @@ class GTSAM_EXPORT ScenarioRunner {
   // Create two samplers for acceleration and omega noise
   Sampler gyroSampler_, accSampler_;
 
+  /// As integrate with corrupted = true, but drawing from the given samplers
+  /// so parallel callers can use private per-thread streams
+  PreintegratedImuMeasurements integrateCorrupted(double T,
+                                                  const Bias& estimatedBias,
+                                                  Sampler& gyroSampler,
+                                                  Sampler& accSampler) const;
+
  public:
   ScenarioRunner(const Scenario& scenario, const SharedParams& p,
                  double imuSampleTime = 1.0 / 100.0, const Bias& bias = Bias())
@@ -102,6 +109,18 @@ class GTSAM_EXPORT ScenarioRunner {
   Matrix9 estimateCovariance(double T, size_t N = 1000,
                              const Bias& estimatedBias = Bias()) const;
 
+  /**
+   * Parallel Monte Carlo estimate of the predict covariance using N samples.
+   * Samples are drawn in fixed-size chunks, each from its own
+   * deterministically seeded gyro/accelerometer streams, so the estimate is
+   * reproducible and independent of the number of threads; chunks are
+   * preintegrated in parallel when TBB is enabled. Note the streams differ
+   * from those of the serial estimateCovariance, so the two estimates agree
+   * only statistically.
+   */
+  Matrix9 estimateCovarianceParallel(double T, size_t N = 1000,
+                                     const Bias& estimatedBias = Bias()) const;
+
   /// Estimate covariance of sampled noise for sanity-check
   Matrix6 estimateNoiseCovariance(size_t N = 1000) const;
 
@@ -38,6 +38,24 @@ void TangentPreintegration::resetIntegration() {
   preintegrated_H_biasOmega_.setZero();
 }
 
+//------------------------------------------------------------------------------
+TangentPreintegration::Snapshot TangentPreintegration::snapshot() const {
+  Snapshot saved;
+  saved.deltaTij = deltaTij_;
+  saved.preintegrated = preintegrated_;
+  saved.preintegrated_H_biasAcc = preintegrated_H_biasAcc_;
+  saved.preintegrated_H_biasOmega = preintegrated_H_biasOmega_;
+  return saved;
+}
+
+//------------------------------------------------------------------------------
+void TangentPreintegration::resetIntegrationTo(const Snapshot& snapshot) {
+  deltaTij_ = snapshot.deltaTij;
+  preintegrated_ = snapshot.preintegrated;
+  preintegrated_H_biasAcc_ = snapshot.preintegrated_H_biasAcc;
+  preintegrated_H_biasOmega_ = snapshot.preintegrated_H_biasOmega;
+}
+
 //------------------------------------------------------------------------------
 bool TangentPreintegration::equals(const TangentPreintegration& other,
     double tol) const {
@@ -139,6 +157,93 @@ void TangentPreintegration::update(const Vector3& measuredAcc,
   preintegrated_H_biasOmega_ = (*A) * preintegrated_H_biasOmega_ - (*C);
 }
 
+//------------------------------------------------------------------------------
+void TangentPreintegration::updateBatch(const Matrix& measuredAccs,
+    const Matrix& measuredOmegas, const Matrix& dts) {
+  assert(
+      measuredAccs.rows() == 3 && measuredOmegas.rows() == 3 && dts.rows() == 1);
+  assert(measuredAccs.cols() == dts.cols());
+  assert(measuredOmegas.cols() == dts.cols());
+
+  const size_t n = static_cast<size_t>(dts.cols());
+  for (size_t j = 0; j < n; j++) {
+    const double dt = dts(0, j);
+
+    // Correct for bias in the sensor frame
+    Vector3 acc = biasHat_.correctAccelerometer(measuredAccs.col(j));
+    Vector3 omega = biasHat_.correctGyroscope(measuredOmegas.col(j));
+
+    // Possibly correct for sensor pose by converting to body frame
+    Matrix3 D_correctedAcc_acc, D_correctedAcc_omega, D_correctedOmega_omega;
+    if (p().body_P_sensor)
+      boost::tie(acc, omega) = correctMeasurementsBySensorPose(acc, omega,
+          D_correctedAcc_acc, D_correctedAcc_omega, D_correctedOmega_omega);
+
+    const auto theta = preintegrated_.segment<3>(0);
+    so3::DexpFunctor local(theta);
+
+    // Mean propagation, as in UpdatePreintegrated
+    Matrix3 w_tangent_H_theta, invH;
+    const Vector3 w_tangent = local.applyInvDexp(omega, &w_tangent_H_theta,
+        &invH);
+    const Rot3 R(local.expmap());
+    const Vector3 a_nav = R * acc;
+    const double dt22 = 0.5 * dt * dt;
+
+    // The 9x9 state transition Jacobian A has the block structure
+    //   [ A00   0    0  ]
+    //   [ A10   I  dt*I ]           with only four non-trivial 3x3 blocks,
+    //   [ A20   0    I  ]
+    // and B and C are block-sparse as well, so the bias derivative recursions
+    //   H_biasAcc   <- A * H_biasAcc   - B
+    //   H_biasOmega <- A * H_biasOmega - C
+    // reduce to a handful of 3x3 products instead of full 9x9 ones.
+    const Matrix3 a_nav_H_theta = R.matrix() * skewSymmetric(-acc)
+        * local.dexp();
+    const Matrix3 A00 = I_3x3 + w_tangent_H_theta * dt;
+    const Matrix3 A10 = a_nav_H_theta * dt22;
+    const Matrix3 A20 = a_nav_H_theta * dt;
+
+    Matrix3 B1 = R.matrix() * dt22;  // position and velocity rows of B,
+    Matrix3 B2 = R.matrix() * dt;    // the theta row is zero
+    Matrix3 C0 = invH * dt;          // theta row of C
+    Matrix3 C1 = Z_3x3, C2 = Z_3x3;
+
+    if (p().body_P_sensor) {
+      // More complicated derivatives in case of non-trivial sensor pose,
+      // same corrections as in update() applied block-wise
+      C0 = C0 * D_correctedOmega_omega;
+      if (!p().body_P_sensor->translation().isZero()) {
+        C1 = B1 * D_correctedAcc_omega;
+        C2 = B2 * D_correctedAcc_omega;
+      }
+      B1 *= D_correctedAcc_acc;  // NOTE(frank): needs to be last
+      B2 *= D_correctedAcc_acc;
+    }
+
+    // Advance the preintegrated state; position uses the old velocity
+    deltaTij_ += dt;
+    preintegrated_.segment<3>(3) += preintegrated_.tail<3>() * dt
+        + a_nav * dt22;
+    preintegrated_.tail<3>() += a_nav * dt;
+    preintegrated_.segment<3>(0) += w_tangent * dt;
+
+    // Propagate the bias Jacobians; the position rows use the old velocity
+    // rows, and every row uses the old theta rows, so update in that order
+    const Matrix3 accTheta = preintegrated_H_biasAcc_.topRows<3>();
+    preintegrated_H_biasAcc_.middleRows<3>(3) += A10 * accTheta
+        + dt * preintegrated_H_biasAcc_.bottomRows<3>() - B1;
+    preintegrated_H_biasAcc_.bottomRows<3>() += A20 * accTheta - B2;
+    preintegrated_H_biasAcc_.topRows<3>() = A00 * accTheta;
+
+    const Matrix3 omegaTheta = preintegrated_H_biasOmega_.topRows<3>();
+    preintegrated_H_biasOmega_.middleRows<3>(3) += A10 * omegaTheta
+        + dt * preintegrated_H_biasOmega_.bottomRows<3>() - C1;
+    preintegrated_H_biasOmega_.bottomRows<3>() += A20 * omegaTheta - C2;
+    preintegrated_H_biasOmega_.topRows<3>() = A00 * omegaTheta - C0;
+  }
+}
+
 //------------------------------------------------------------------------------
 Vector9 TangentPreintegration::biasCorrectedDelta(
     const imuBias::ConstantBias& bias_i, OptionalJacobian<9, 6> H) const {
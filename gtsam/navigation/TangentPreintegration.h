@@ -64,6 +64,25 @@ public:
   /// Re-initialize PreintegratedMeasurements
   void resetIntegration() override;
 
+  /**
+   * Copyable fixed-size block capturing the complete integration state.
+   * Taking and restoring a snapshot is a plain memberwise copy, so callers
+   * that branch preintegration at candidate keyframe times can roll back in
+   * O(1) instead of re-integrating raw measurements from a buffer.
+   */
+  struct Snapshot {
+    double deltaTij;
+    Vector9 preintegrated;
+    Matrix93 preintegrated_H_biasAcc;
+    Matrix93 preintegrated_H_biasOmega;
+  };
+
+  /// Capture the current integration state; params and bias are not copied
+  Snapshot snapshot() const;
+
+  /// Roll the integration state back to a previously captured snapshot
+  void resetIntegrationTo(const Snapshot& snapshot);
+
   /// @}
 
   /// @name Instance variables access
@@ -102,6 +121,16 @@ public:
   void update(const Vector3& measuredAcc, const Vector3& measuredOmega,
       const double dt, Matrix9* A, Matrix93* B, Matrix93* C) override;
 
+  /// Integrate a whole window of measurements, given in matrix columns as in
+  /// PreintegratedImuMeasurements::integrateMeasurements, in a single call.
+  /// Produces the same preintegrated state and bias derivatives as calling
+  /// update() once per column, but propagates the bias Jacobians with 3x3
+  /// block operations that exploit the sparsity of the 9x9 state transition
+  /// Jacobian. Does not expose the per-sample A/B/C Jacobians, so callers
+  /// that also propagate a covariance must keep using update().
+  void updateBatch(const Matrix& measuredAccs, const Matrix& measuredOmegas,
+      const Matrix& dts);
+
   /// Given the estimate of the bias, return a NavState tangent vector
   /// summarizing the preintegrated IMU measurements so far
   /// NOTE(frank): implementation is different in two versions
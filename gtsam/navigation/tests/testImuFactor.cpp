@@ -239,6 +239,30 @@ TEST(ImuFactor, MultipleMeasurements) {
   EXPECT(assert_equal(expected,actual));
 }
 
+/* ************************************************************************* */
+TEST(ImuFactor, SnapshotRollback) {
+  using namespace common;
+
+  PreintegratedImuMeasurements pim(testing::Params(), kZeroBiasHat);
+  pim.integrateMeasurement(measuredAcc, measuredOmega, deltaT);
+  pim.integrateMeasurement(measuredAcc, measuredOmega, deltaT);
+
+  // Branch: snapshot, speculatively integrate more, then roll back
+  const PreintegratedImuMeasurements::Snapshot saved = pim.snapshot();
+  const PreintegratedImuMeasurements expected = pim;
+  pim.integrateMeasurement(measuredAcc, measuredOmega, deltaT);
+  pim.integrateMeasurement(measuredAcc, measuredOmega, deltaT);
+  pim.resetIntegrationTo(saved);
+  EXPECT(assert_equal(expected, pim));
+
+  // Integrating after a rollback gives the same result as never branching
+  PreintegratedImuMeasurements continuous(testing::Params(), kZeroBiasHat);
+  for (size_t i = 0; i < 3; i++)
+    continuous.integrateMeasurement(measuredAcc, measuredOmega, deltaT);
+  pim.integrateMeasurement(measuredAcc, measuredOmega, deltaT);
+  EXPECT(assert_equal(continuous, pim));
+}
+
 /* ************************************************************************* */
 TEST(ImuFactor, ErrorAndJacobians) {
   using namespace common;
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/navigation/MagFactor.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/numericalDerivative.h>
 
@@ -105,6 +106,46 @@ TEST( MagFactor, Factors ) {
       H3, 1e-7));
 }
 
+// *************************************************************************
+TEST( MagFactor, Batch ) {
+
+  // Samples from three different orientations, evaluated away from the truth
+  Values values;
+  values.insert(1, Point3(scaled + Point3(100, -50, 20)));
+  values.insert(2, Point3(bias + Point3(3, -2, 1)));
+
+  MagFactor2Batch batch(1, 2, model);
+  GaussianFactorGraph expectedGraph;
+  double expectedError = 0;
+  std::vector<Rot3> rotations;
+  rotations.push_back(nRb);
+  rotations.push_back(Rot3::Yaw(0.3));
+  rotations.push_back(Rot3::Ypr(0.1, -0.2, 0.25));
+  for(const Rot3& R: rotations) {
+    Point3 sample = R.inverse() * scaled + bias;
+    batch.add(sample, R);
+    MagFactor2 f(1, 2, sample, R, model);
+    expectedGraph.push_back(f.linearize(values));
+    expectedError += f.error(values);
+  }
+  EXPECT_LONGS_EQUAL(3, batch.nrMeasurements());
+  EXPECT_LONGS_EQUAL(9, batch.dim());
+
+  // The batch error matches the sum over the individual factors
+  DOUBLES_EQUAL(expectedError, batch.error(values), 1e-8);
+
+  // The accumulated normal equations match the per-sample linearizations
+  HessianFactor expectedHessian(expectedGraph);
+  GaussianFactor::shared_ptr actual = batch.linearize(values);
+  EXPECT(assert_equal(expectedHessian.augmentedInformation(),
+      actual->augmentedInformation(), 1e-8));
+
+  // A non-isotropic model is rejected
+  CHECK_EXCEPTION(
+      MagFactor2Batch(1, 2, noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.2, 0.3))),
+      std::invalid_argument);
+}
+
 // *************************************************************************
 int main() {
   TestResult tr;
@@ -172,8 +172,9 @@ TEST(NavState, Update) {
   Matrix9 aF;
   Matrix93 aG1, aG2;
   boost::function<NavState(const NavState&, const Vector3&, const Vector3&)> update =
-  boost::bind(&NavState::update, _1, _2, _3, dt, boost::none,
-      boost::none, boost::none);
+      [dt](const NavState& state, const Vector3& a, const Vector3& w) {
+        return state.update(a, w, dt, boost::none, boost::none, boost::none);
+      };
   Vector3 b_acc = kAttitude * acc;
   NavState expected(kAttitude.expmap(dt * omega),
       kPosition + Point3((kVelocity + b_acc * dt / 2) * dt),
@@ -194,6 +195,17 @@ TEST(NavState, Update) {
 }
 #endif
 
+/* ************************************************************************* */
+TEST(NavState, UpdateJacobianFree) {
+  // The Jacobian-free overload agrees with the full version
+  const Vector3 omega(0.1, 0.2, 0.3), acc(0.4, 0.5, 0.6);
+  const double dt = 0.01;
+  Matrix9 aF;
+  Matrix93 aG1, aG2;
+  const NavState expected = kState1.update(acc, omega, dt, aF, aG1, aG2);
+  EXPECT(assert_equal(expected, kState1.update(acc, omega, dt)));
+}
+
 /* ************************************************************************* */
 static const double dt = 2.0;
 boost::function<Vector9(const NavState&, const bool&)> coriolis = boost::bind(
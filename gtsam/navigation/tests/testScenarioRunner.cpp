@@ -95,6 +95,22 @@ TEST(ScenarioRunner, Forward) {
   EXPECT(assert_equal(estimatedCov, pim.preintMeasCov(), 1e-5));
 }
 
+/* ************************************************************************* */
+TEST(ScenarioRunner, ForwardParallel) {
+  gttic(ForwardParallel);
+  using namespace forward;
+  ScenarioRunner runner(scenario, defaultParams(), kDt);
+  const double T = 0.1;  // seconds
+
+  auto pim = runner.integrate(T);
+
+  // The parallel engine uses different streams than estimateCovariance, so
+  // only compare against the calculated covariance
+  Matrix9 estimatedCov = runner.estimateCovarianceParallel(T, 100);
+  EXPECT_NEAR(estimatedCov.diagonal(), pim.preintMeasCov().diagonal(), 0.1);
+  EXPECT(assert_equal(estimatedCov, pim.preintMeasCov(), 1e-5));
+}
+
 /* ************************************************************************* */
 TEST(ScenarioRunner, ForwardWithBias) {
   gttic(ForwardWithBias);
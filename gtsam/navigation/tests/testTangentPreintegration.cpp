@@ -72,6 +72,50 @@ TEST(TangentPreintegration, UpdateEstimate2) {
   EXPECT(assert_equal(numericalDerivative33(f, zeta, acc, omega), aH3, 1e-9));
 }
 
+/* ************************************************************************* */
+TEST(TangentPreintegration, UpdateBatch) {
+  // A window of samples with some variation, as matrix columns
+  const size_t n = 10;
+  Matrix accs(3, n), omegas(3, n), dts(1, n);
+  for (size_t j = 0; j < n; j++) {
+    accs.col(j) = Vector3(0.1, 0.2 + 0.01 * j, 10 - 0.05 * j);
+    omegas.col(j) = Vector3(0.1 - 0.02 * j, 0.2, 0.3 + 0.01 * j);
+    dts(0, j) = kDt;
+  }
+
+  // Batch integration must match sample-by-sample integration
+  TangentPreintegration expected(testing::Params(), Bias(kZero, kZero));
+  Matrix9 A;
+  Matrix93 B, C;
+  for (size_t j = 0; j < n; j++)
+    expected.update(accs.col(j), omegas.col(j), dts(0, j), &A, &B, &C);
+
+  TangentPreintegration actual(testing::Params(), Bias(kZero, kZero));
+  actual.updateBatch(accs, omegas, dts);
+  DOUBLES_EQUAL(expected.deltaTij(), actual.deltaTij(), 1e-9);
+  EXPECT(assert_equal(expected.preintegrated(), actual.preintegrated(), 1e-9));
+  EXPECT(assert_equal(expected.preintegrated_H_biasAcc(),
+      actual.preintegrated_H_biasAcc(), 1e-9));
+  EXPECT(assert_equal(expected.preintegrated_H_biasOmega(),
+      actual.preintegrated_H_biasOmega(), 1e-9));
+
+  // Also with a non-trivial sensor pose
+  auto p = testing::Params();
+  p->body_P_sensor = Pose3(Rot3::Expmap(Vector3(0, 0.1, 0.1)),
+      Point3(0.1, 0.05, 0.01));
+  TangentPreintegration expected2(p, Bias(kZero, kZero));
+  for (size_t j = 0; j < n; j++)
+    expected2.update(accs.col(j), omegas.col(j), dts(0, j), &A, &B, &C);
+
+  TangentPreintegration actual2(p, Bias(kZero, kZero));
+  actual2.updateBatch(accs, omegas, dts);
+  EXPECT(assert_equal(expected2.preintegrated(), actual2.preintegrated(), 1e-9));
+  EXPECT(assert_equal(expected2.preintegrated_H_biasAcc(),
+      actual2.preintegrated_H_biasAcc(), 1e-9));
+  EXPECT(assert_equal(expected2.preintegrated_H_biasOmega(),
+      actual2.preintegrated_H_biasOmega(), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(ImuFactor, BiasCorrectionJacobians) {
   testing::SomeMeasurements measurements;
@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file AdaptiveNonlinearISAM.cpp
+ * @brief Hybrid incremental/batch controller on top of ISAM2
+ * @author Frank Dellaert
+ * @date Aug 30, 2026
+ */
+
+#include <gtsam/nonlinear/AdaptiveNonlinearISAM.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/LinearContainerFactor.h>
+
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+Values AdaptiveNonlinearISAM::estimate() const {
+  Values result = isam_.calculateEstimate();
+  for (const auto& key_value : refined_) {
+    if (result.exists(key_value.key))
+      result.update(key_value.key, key_value.value);
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+ISAM2Result AdaptiveNonlinearISAM::update(const NonlinearFactorGraph& newFactors,
+    const Values& initialValues) {
+
+  // Any earlier refinement has either been absorbed by relinearization or
+  // will re-trigger below, so the overlay never goes stale
+  refined_.clear();
+
+  ISAM2Result result = isam_.update(newFactors, initialValues);
+
+  // A growing residual is a second drift signal: halve the threshold so
+  // smaller deltas already trigger refinement
+  double threshold = driftThreshold_;
+  if (result.errorAfter && !std::isnan(previousError_) &&
+      *result.errorAfter > previousError_)
+    threshold *= 0.5;
+  previousError_ = result.errorAfter ? *result.errorAfter
+                                     : std::numeric_limits<double>::quiet_NaN();
+
+  const KeySet driftKeys = gatherDriftingKeys(threshold);
+  if (!driftKeys.empty())
+    refine(driftKeys);
+
+  return result;
+}
+
+/* ************************************************************************* */
+KeySet AdaptiveNonlinearISAM::gatherDriftingKeys(double threshold) const {
+  KeySet driftKeys;
+  for (const auto& key_delta : isam_.getDelta()) {
+    if (key_delta.second.lpNorm<Eigen::Infinity>() > threshold)
+      driftKeys.insert(key_delta.first);
+  }
+  return driftKeys;
+}
+
+/* ************************************************************************* */
+void AdaptiveNonlinearISAM::refine(const KeySet& driftKeys) {
+  if (driftKeys.empty())
+    return;
+
+  const NonlinearFactorGraph& factors = isam_.getFactorsUnsafe();
+  const VariableIndex& variableIndex = isam_.getVariableIndex();
+  const Values currentEstimate = isam_.calculateEstimate();
+
+  // Gather the factors adjacent to the drifting variables, and all of the
+  // variables those factors involve
+  NonlinearFactorGraph subgraph;
+  KeySet involved;
+  FastSet<FactorIndex> seen;
+  for (Key key : driftKeys) {
+    for (FactorIndex index : variableIndex[key]) {
+      const NonlinearFactor::shared_ptr& factor = factors[index];
+      if (!factor || !seen.insert(index).second)
+        continue;
+      subgraph.push_back(factor);
+      involved.insert(factor->begin(), factor->end());
+    }
+  }
+
+  // Anchor the boundary variables with their current Bayes tree marginals,
+  // wrapped as LinearContainerFactors at the iSAM2 linearization point
+  for (Key key : involved) {
+    if (driftKeys.count(key))
+      continue;
+    GaussianFactor::shared_ptr marginal =
+        isam_.marginalFactor(key, isam_.params().getEliminationFunction());
+    if (marginal)
+      subgraph.emplace_shared<LinearContainerFactor>(
+          marginal, isam_.getLinearizationPoint());
+  }
+
+  // Refine the subproblem with LM, starting from the current estimate
+  Values initial;
+  for (Key key : involved)
+    initial.insert(key, currentEstimate.at(key));
+  refined_ = LevenbergMarquardtOptimizer(subgraph, initial, lmParams_).optimize();
+  ++refinementCount_;
+}
+
+/* ************************************************************************* */
+void AdaptiveNonlinearISAM::print(const string& s,
+    const KeyFormatter& keyFormatter) const {
+  cout << s << "driftThreshold: " << driftThreshold_
+       << ", refinements: " << refinementCount_ << endl;
+  isam_.print("isam: ", keyFormatter);
+  refined_.print("refined: ", keyFormatter);
+}
+
+/* ************************************************************************* */
+}  // \namespace gtsam
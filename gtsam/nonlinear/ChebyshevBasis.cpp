@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ChebyshevBasis.cpp
+ * @brief Chebyshev polynomial basis with precomputed evaluation matrices
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/ChebyshevBasis.h>
+
+#include <stdexcept>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ChebyshevBasis::ChebyshevBasis(size_t N, double a, double b)
+    : N_(N), a_(a), b_(b) {
+  if (N < 1)
+    throw std::invalid_argument("ChebyshevBasis: order must be at least 1");
+  if (b <= a)
+    throw std::invalid_argument("ChebyshevBasis: interval [a,b] is empty");
+}
+
+/* ************************************************************************* */
+Vector ChebyshevBasis::canonical(const Vector& timestamps) const {
+  return (2.0 * timestamps.array() - a_ - b_) / (b_ - a_);
+}
+
+/* ************************************************************************* */
+Vector ChebyshevBasis::weights(double t) const {
+  return evaluationMatrix((Vector(1) << t).finished()).row(0);
+}
+
+/* ************************************************************************* */
+Vector ChebyshevBasis::derivativeWeights(double t) const {
+  return differentiationMatrix((Vector(1) << t).finished()).row(0);
+}
+
+/* ************************************************************************* */
+Matrix ChebyshevBasis::evaluationMatrix(const Vector& timestamps) const {
+  const Vector x = canonical(timestamps);
+  const DenseIndex m = x.size();
+
+  // Three-term recurrence T_j = 2 x T_{j-1} - T_{j-2}, one column at a time
+  Matrix W(m, N_);
+  W.col(0).setOnes();
+  if (N_ > 1)
+    W.col(1) = x;
+  for (size_t j = 2; j < N_; ++j)
+    W.col(j) = 2.0 * x.cwiseProduct(W.col(j - 1)) - W.col(j - 2);
+  return W;
+}
+
+/* ************************************************************************* */
+Matrix ChebyshevBasis::differentiationMatrix(const Vector& timestamps) const {
+  const Vector x = canonical(timestamps);
+  const DenseIndex m = x.size();
+
+  // dT_j/dx = j U_{j-1}, with the second-kind recurrence for U, and the
+  // chain rule factor from mapping [a,b] onto [-1,1]
+  const double dxdt = 2.0 / (b_ - a_);
+  Matrix D(m, N_);
+  D.col(0).setZero();
+  Vector Uprev = Vector::Ones(m); // U_0
+  if (N_ > 1)
+    D.col(1) = dxdt * Uprev;
+  Vector U = 2.0 * x; // U_1
+  for (size_t j = 2; j < N_; ++j) {
+    D.col(j) = (j * dxdt) * U;
+    const Vector Unext = 2.0 * x.cwiseProduct(U) - Uprev;
+    Uprev = U;
+    U = Unext;
+  }
+  return D;
+}
+
+/* ************************************************************************* */
+BasisEvaluation::BasisEvaluation(const ChebyshevBasis& basis,
+    const Vector& timestamps)
+    : basis_(basis),
+      weights_(basis.evaluationMatrix(timestamps)),
+      derivativeWeights_(basis.differentiationMatrix(timestamps)) {
+}
+
+/* ************************************************************************* */
+Vector BasisEvaluation::evaluate(const Vector& coefficients) const {
+  return weights_ * coefficients;
+}
+
+/* ************************************************************************* */
+Vector BasisEvaluation::evaluateDerivative(const Vector& coefficients) const {
+  return derivativeWeights_ * coefficients;
+}
+
+/* ************************************************************************* */
+boost::function<double(const Vector&, boost::optional<Matrix&>)>
+BasisEvaluation::predictFunctor(size_t i) const {
+  if (i >= (size_t) weights_.rows())
+    throw std::invalid_argument(
+        "BasisEvaluation::predictFunctor: measurement index out of range");
+  const Matrix row = weights_.row(i);
+  return [row](const Vector& coefficients, boost::optional<Matrix&> H) {
+    if (H)
+      *H = row;
+    return (row * coefficients)(0);
+  };
+}
+
+/* ************************************************************************* */
+} // \ namespace gtsam
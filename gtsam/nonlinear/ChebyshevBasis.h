@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ChebyshevBasis.h
+ * @brief Chebyshev polynomial basis with precomputed evaluation matrices
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/Vector.h>
+
+#include <boost/function.hpp>
+#include <boost/optional.hpp>
+
+namespace gtsam {
+
+/**
+ * Chebyshev polynomial basis of the first kind, of order N on an interval
+ * [a,b].  A function is represented by its N coefficients c, with
+ * f(t) = sum_j c_j T_j(x(t)) where x maps [a,b] to [-1,1].  The weight rows
+ * and the batched evaluation matrices are computed with the three-term
+ * recurrence, column by column, so evaluating at m timestamps costs O(m N)
+ * vectorized operations rather than m independent weight computations.
+ */
+class GTSAM_EXPORT ChebyshevBasis {
+
+ public:
+
+  /// Basis of order N (polynomial degree N-1) on the interval [a,b]
+  ChebyshevBasis(size_t N, double a = -1.0, double b = 1.0);
+
+  /// Number of basis functions
+  size_t order() const { return N_; }
+
+  /// Row of basis function values T_j(x(t)), j = 0...N-1
+  Vector weights(double t) const;
+
+  /// Row of basis function derivatives dT_j/dt at t
+  Vector derivativeWeights(double t) const;
+
+  /**
+   * The m x N evaluation matrix W for a set of timestamps, with
+   * W(i,j) = T_j(x(t_i)): predictions for all m measurements of a segment
+   * are then the single product W * c.
+   */
+  Matrix evaluationMatrix(const Vector& timestamps) const;
+
+  /// The m x N differentiation matrix D, with D(i,j) = dT_j/dt at t_i
+  Matrix differentiationMatrix(const Vector& timestamps) const;
+
+ private:
+
+  /// Map timestamps into the canonical interval [-1,1]
+  Vector canonical(const Vector& timestamps) const;
+
+  size_t N_; ///< number of basis functions
+  double a_, b_; ///< interval
+};
+
+/**
+ * Precomputed basis evaluation engine for one segment: the evaluation and
+ * differentiation matrices for the segment's timestamps are computed once at
+ * construction and reused by every query, so fitting against 10k
+ * measurements applies cached weights instead of recomputing them per
+ * factor evaluation.  predictFunctor() adapts a single row to the functor
+ * signature of FunctorizedFactor, with the (constant) row as the Jacobian.
+ */
+class GTSAM_EXPORT BasisEvaluation {
+
+ public:
+
+  /// Precompute the evaluation and differentiation matrices
+  BasisEvaluation(const ChebyshevBasis& basis, const Vector& timestamps);
+
+  /// The cached m x N evaluation matrix
+  const Matrix& evaluationMatrix() const { return weights_; }
+
+  /// The cached m x N differentiation matrix
+  const Matrix& differentiationMatrix() const { return derivativeWeights_; }
+
+  /// Values at every timestamp of the function with the given coefficients
+  Vector evaluate(const Vector& coefficients) const;
+
+  /// Derivatives at every timestamp of the function with the coefficients
+  Vector evaluateDerivative(const Vector& coefficients) const;
+
+  /**
+   * Functor predicting measurement i from a coefficient vector, for use
+   * with FunctorizedFactor<double, Vector>.  The prediction is linear in
+   * the coefficients, so the Jacobian is the cached weight row itself.
+   */
+  boost::function<double(const Vector&, boost::optional<Matrix&>)>
+      predictFunctor(size_t i) const;
+
+ private:
+
+  ChebyshevBasis basis_; ///< the underlying basis
+  Matrix weights_; ///< cached evaluation matrix
+  Matrix derivativeWeights_; ///< cached differentiation matrix
+};
+
+} // \ namespace gtsam
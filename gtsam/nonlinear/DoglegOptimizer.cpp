@@ -67,12 +67,13 @@ DoglegOptimizer::DoglegOptimizer(const NonlinearFactorGraph& graph, const Values
     : NonlinearOptimizer(
           graph, std::unique_ptr<State>(
                      new State(initialValues, graph.error(initialValues), params.deltaInitial))),
-      params_(ensureHasOrdering(params, graph)) {}
+      params_(ensureHasOrdering(params, graph)), reuseCachedLinearization_(false) {}
 
 DoglegOptimizer::DoglegOptimizer(const NonlinearFactorGraph& graph, const Values& initialValues,
                                  const Ordering& ordering)
     : NonlinearOptimizer(graph, std::unique_ptr<State>(
-                                    new State(initialValues, graph.error(initialValues), 1.0))) {
+                                    new State(initialValues, graph.error(initialValues), 1.0))),
+      reuseCachedLinearization_(false) {
   params_.ordering = ordering;
 }
 
@@ -83,8 +84,14 @@ double DoglegOptimizer::getDelta() const {
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
 
+  // A fully rejected step (zero update at minimum trust region radius) leaves
+  // the linearization point unchanged, so the factorization from the previous
+  // iteration is still exact and can be reused with the new radius.
+  const bool reuse = reuseCachedLinearization_ && cachedLinear_;
+
   // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  GaussianFactorGraph::shared_ptr linear =
+      reuse ? cachedLinear_ : graph_.linearize(state_->values);
 
   // Pull out parameters we'll use
   const bool dlVerbose = (params_.verbosityDL > DoglegParams::SILENT);
@@ -93,18 +100,22 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
   DoglegOptimizerImpl::IterationResult result;
 
   if ( params_.isMultifrontal() ) {
-    GaussianBayesTree bt = *linear->eliminateMultifrontal(*params_.ordering, params_.getEliminationFunction());
-    VectorValues dx_u = bt.optimizeGradientSearch();
-    VectorValues dx_n = bt.optimize();
+    if (!reuse) {
+      cachedBayesTree_ = linear->eliminateMultifrontal(*params_.ordering, params_.getEliminationFunction());
+      cachedDxU_ = cachedBayesTree_->optimizeGradientSearch();
+      cachedDxN_ = cachedBayesTree_->optimize();
+    }
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
-      dx_u, dx_n, bt, graph_, state_->values, state_->error, dlVerbose);
+      cachedDxU_, cachedDxN_, *cachedBayesTree_, graph_, state_->values, state_->error, dlVerbose);
   }
   else if ( params_.isSequential() ) {
-    GaussianBayesNet bn = *linear->eliminateSequential(*params_.ordering, params_.getEliminationFunction());
-    VectorValues dx_u = bn.optimizeGradientSearch();
-    VectorValues dx_n = bn.optimize();
+    if (!reuse) {
+      cachedBayesNet_ = linear->eliminateSequential(*params_.ordering, params_.getEliminationFunction());
+      cachedDxU_ = cachedBayesNet_->optimizeGradientSearch();
+      cachedDxN_ = cachedBayesNet_->optimize();
+    }
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
-      dx_u, dx_n, bn, graph_, state_->values, state_->error, dlVerbose);
+      cachedDxU_, cachedDxN_, *cachedBayesNet_, graph_, state_->values, state_->error, dlVerbose);
   }
   else if ( params_.isIterative() ) {
     throw std::runtime_error("Dogleg is not currently compatible with the linear conjugate gradient solver");
@@ -116,6 +127,11 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
   // Maybe show output
   if(params_.verbosity >= NonlinearOptimizerParams::DELTA) result.dx_d.print("delta");
 
+  // Remember whether the linearization point moved; if not, the cached
+  // factorization stays valid for the next iteration
+  cachedLinear_ = linear;
+  reuseCachedLinearization_ = (result.dx_d.norm() == 0.0);
+
   // Create new state with new values and new error
   state_.reset(new State(state_->values.retract(result.dx_d), result.f_error, result.delta,
                          state_->iterations + 1));
@@ -19,10 +19,13 @@
 #pragma once
 
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
+#include <gtsam/linear/VectorValues.h>
 
 namespace gtsam {
 
 class DoglegOptimizer;
+class GaussianBayesTree;
+class GaussianBayesNet;
 
 /** Parameters for Levenberg-Marquardt optimization.  Note that this parameters
  * class inherits from NonlinearOptimizerParams, which specifies the parameters
@@ -125,6 +128,16 @@ protected:
 
   /** Internal function for computing a COLAMD ordering if no ordering is specified */
   DoglegParams ensureHasOrdering(DoglegParams params, const NonlinearFactorGraph& graph) const;
+
+private:
+  /** Cache of the last linearization and its factorization.  A fully rejected
+   * step leaves the linearization point unchanged, so the next iteration
+   * reuses these instead of re-eliminating the identical system. */
+  GaussianFactorGraph::shared_ptr cachedLinear_;
+  boost::shared_ptr<GaussianBayesTree> cachedBayesTree_;
+  boost::shared_ptr<GaussianBayesNet> cachedBayesNet_;
+  VectorValues cachedDxU_, cachedDxN_;
+  bool reuseCachedLinearization_;
 };
 
 }
@@ -82,4 +82,70 @@ VectorValues DoglegOptimizerImpl::ComputeBlend(double delta, const VectorValues&
   return blend;
 }
 
+/* ************************************************************************* */
+FlatVectorValues DoglegOptimizerImpl::ComputeDoglegPoint(
+    double delta, const FlatVectorValues& dx_u, const FlatVectorValues& dx_n, const bool verbose) {
+
+  // Same logic as the VectorValues overload above, but every norm, dot
+  // product and blend is one sweep over contiguous storage
+  assert(delta >= 0.0);
+  double deltaSq = delta*delta;
+  double x_u_norm_sq = dx_u.squaredNorm();
+  double x_n_norm_sq = dx_n.squaredNorm();
+  if(verbose) cout << "Steepest descent magnitude " << std::sqrt(x_u_norm_sq) << ", Newton's method magnitude " << std::sqrt(x_n_norm_sq) << endl;
+  if(deltaSq < x_u_norm_sq) {
+    // Trust region is smaller than steepest descent update
+    FlatVectorValues x_d = dx_u;
+    x_d *= std::sqrt(deltaSq / x_u_norm_sq);
+    if(verbose) cout << "In steepest descent region with fraction " << std::sqrt(deltaSq / x_u_norm_sq) << " of steepest descent magnitude" << endl;
+    return x_d;
+  } else if(deltaSq < x_n_norm_sq) {
+    // Trust region boundary is between steepest descent point and Newton's method point
+    return ComputeBlend(delta, dx_u, dx_n, verbose);
+  } else {
+    assert(deltaSq >= x_n_norm_sq);
+    if(verbose) cout << "In pure Newton's method region" << endl;
+    // Trust region is larger than Newton's method point
+    return dx_n;
+  }
+}
+
+/* ************************************************************************* */
+FlatVectorValues DoglegOptimizerImpl::ComputeBlend(
+    double delta, const FlatVectorValues& x_u, const FlatVectorValues& x_n, const bool verbose) {
+
+  // See doc/trustregion.lyx or doc/trustregion.pdf
+
+  // Compute inner products
+  const double un = x_u.dot(x_n);
+  const double uu = x_u.squaredNorm();
+  const double nn = x_n.squaredNorm();
+
+  // Compute quadratic formula terms
+  const double a = uu - 2.*un + nn;
+  const double b = 2. * (un - uu);
+  const double c = uu - delta*delta;
+  double sqrt_b_m4ac = std::sqrt(b*b - 4*a*c);
+
+  // Compute blending parameter
+  double tau1 = (-b + sqrt_b_m4ac) / (2.*a);
+  double tau2 = (-b - sqrt_b_m4ac) / (2.*a);
+
+  double tau;
+  if(0.0 <= tau1 && tau1 <= 1.0) {
+    assert(!(0.0 <= tau2 && tau2 <= 1.0));
+    tau = tau1;
+  } else {
+    assert(0.0 <= tau2 && tau2 <= 1.0);
+    tau = tau2;
+  }
+
+  // Compute blended point
+  if(verbose) cout << "In blend region with fraction " << tau << " of Newton's method point" << endl;
+  FlatVectorValues blend = x_u;
+  blend *= 1. - tau;
+  blend.axpy(tau, x_n);
+  return blend;
+}
+
 }
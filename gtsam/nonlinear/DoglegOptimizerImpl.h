@@ -19,6 +19,7 @@
 #include <iomanip>
 
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/FlatVectorValues.h>
 #include <gtsam/inference/Ordering.h>
 
 namespace gtsam {
@@ -120,6 +121,14 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    */
   static VectorValues ComputeDoglegPoint(double delta, const VectorValues& dx_u, const VectorValues& dx_n, const bool verbose=false);
 
+  /** Overload of ComputeDoglegPoint on the contiguous representation.  The
+   * trust-region search in Iterate computes dogleg points for several radii
+   * from the same pair of endpoints, so the endpoints are flattened once and
+   * the repeated norms, dot products and blends run as whole-vector
+   * arithmetic.  Both arguments must share the same layout.
+   */
+  static FlatVectorValues ComputeDoglegPoint(double delta, const FlatVectorValues& dx_u, const FlatVectorValues& dx_n, const bool verbose=false);
+
   /** Compute the point on the line between the steepest descent point and the
    * Newton's method point intersecting the trust region boundary.
    * Mathematically, computes \f$ \tau \f$ such that \f$ 0<\tau<1 \f$ and
@@ -130,6 +139,10 @@ struct GTSAM_EXPORT DoglegOptimizerImpl {
    * @param x_n Newton's method minimizer
    */
   static VectorValues ComputeBlend(double delta, const VectorValues& x_u, const VectorValues& x_n, const bool verbose=false);
+
+  /** Overload of ComputeBlend on the contiguous representation, see the
+   * FlatVectorValues overload of ComputeDoglegPoint. */
+  static FlatVectorValues ComputeBlend(double delta, const FlatVectorValues& x_u, const FlatVectorValues& x_n, const bool verbose=false);
 };
 
 
@@ -143,6 +156,12 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
   const double M_error = Rd.error(VectorValues::Zero(dx_u));
   gttoc(M_error);
 
+  // Flatten the two endpoints once: the trust-region search below may blend
+  // them repeatedly, which runs as contiguous whole-vector arithmetic in this
+  // form instead of walking the maps on every retry.
+  const FlatVectorValues flat_dx_u(dx_u);
+  const FlatVectorValues flat_dx_n(dx_n, flat_dx_u.scatter());
+
   // Result to return
   IterationResult result;
 
@@ -151,7 +170,7 @@ typename DoglegOptimizerImpl::IterationResult DoglegOptimizerImpl::Iterate(
   while(stay) {
     gttic(Dog_leg_point);
     // Compute dog leg point
-    result.dx_d = ComputeDoglegPoint(delta, dx_u, dx_n, verbose);
+    result.dx_d = ComputeDoglegPoint(delta, flat_dx_u, flat_dx_n, verbose).vectorValues();
     gttoc(Dog_leg_point);
 
     if(verbose) std::cout << "delta = " << delta << ", dx_d_norm = " << result.dx_d.norm() << std::endl;
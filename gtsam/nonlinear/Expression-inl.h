@@ -205,9 +205,7 @@ T Expression<T>::valueAndJacobianMap(const Values& values,
   internal::ExecutionTraceStorage traceStorage[size];
 #endif
 
-  internal::ExecutionTrace<T> trace;
-  T value(this->traceExecution(values, trace, traceStorage));
-  trace.startReverseAD1(jacobians);
+  T value(valueAndJacobianMap(values, jacobians, traceStorage));
 
 #ifdef _MSC_VER
   _aligned_free(traceStorage);
@@ -216,6 +214,15 @@ T Expression<T>::valueAndJacobianMap(const Values& values,
   return value;
 }
 
+template<typename T>
+T Expression<T>::valueAndJacobianMap(const Values& values,
+    internal::JacobianMap& jacobians, void* traceStorage) const {
+  internal::ExecutionTrace<T> trace;
+  T value(this->traceExecution(values, trace, traceStorage));
+  trace.startReverseAD1(jacobians);
+  return value;
+}
+
 template<typename T>
 typename Expression<T>::KeysAndDims Expression<T>::keysAndDims() const {
   std::map<Key, int> map;
@@ -198,6 +198,12 @@ protected:
   T valueAndJacobianMap(const Values& values,
       internal::JacobianMap& jacobians) const;
 
+  /// brief Reverse AD version executing the trace in an externally owned
+  /// buffer of at least traceSize() ExecutionTraceStorage elements, so
+  /// callers can preallocate it
+  T valueAndJacobianMap(const Values& values, internal::JacobianMap& jacobians,
+      void* traceStorage) const;
+
   // be very selective on who can access these private methods:
   friend class ExpressionFactor<T> ;
   friend class internal::ExpressionNode<T>;
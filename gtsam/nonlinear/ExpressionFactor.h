@@ -22,6 +22,7 @@
 #include <gtsam/nonlinear/Expression.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/base/Testable.h>
+#include <cstring>
 #include <numeric>
 
 namespace gtsam {
@@ -43,6 +44,10 @@ protected:
   Expression<T> expression_;  ///< the expression that is AD enabled
   FastVector<int> dims_;      ///< dimensions of the Jacobian matrices
 
+  /// Size in bytes of the execution trace, fixed once the expression is set;
+  /// the trace itself replays in a per-thread buffer, see linearize
+  size_t traceSize_ = 0;
+
 
  public:
   typedef boost::shared_ptr<ExpressionFactor<T> > shared_ptr;
@@ -122,8 +127,20 @@ protected:
     // Zero out Jacobian so we can simply add to it
     Ab.matrix().setZero();
 
-    // Get value and Jacobians, writing directly into JacobianFactor
-    T value = expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
+    // Get value and Jacobians, writing directly into JacobianFactor.
+    // Reverse AD happens here, replaying the trace in a per-thread buffer
+    // sized to the largest trace this thread has seen, so even graphs with
+    // millions of expression factors allocate only once per thread.
+    internal::ExecutionTraceStorage* traceBuffer =
+        internal::threadLocalTraceBuffer(traceSize_);
+#ifndef NDEBUG
+    // In debug builds, touch the whole region the replay may use, so an
+    // undersized buffer fails loudly (e.g. under AddressSanitizer) instead
+    // of silently corrupting the heap
+    std::memset(traceBuffer, 0xab,
+        traceSize_ * sizeof(internal::ExecutionTraceStorage));
+#endif
+    T value = expression_.valueAndJacobianMap(x, jacobianMap, traceBuffer);
 
     // Evaluate error and set RHS vector b
     Ab(size()).col(0) = traits<T>::Local(value, measured_);
@@ -176,6 +193,10 @@ protected:
      expression_.dims(keyedDims);
      for (Key key : keys_) dims_.push_back(keyedDims[key]);
    }
+
+   // An Expression's trace has a fixed size, so compute it once here instead
+   // of walking the expression tree on every linearize call
+   traceSize_ = expression_.traceSize();
  }
 
  /// Recreate expression from keys_ and measured_, used in load below.
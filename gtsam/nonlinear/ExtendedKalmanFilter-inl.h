@@ -60,6 +60,51 @@ namespace gtsam {
     return x;
   }
 
+  /* ************************************************************************* */
+  template<class VALUE>
+  GaussianFactor::shared_ptr ExtendedKalmanFilter<VALUE>::relinearize_(
+      const NoiseModelFactor& factor, JacobianFactor::shared_ptr* workspace) {
+    // Relinearize into the preallocated JacobianFactor when its structure
+    // still matches; the keys change every step, so retarget them first
+    if (*workspace) {
+      (*workspace)->keys() = factor.keys();
+      if (factor.linearizeInPlace(linearizationPoint_, **workspace))
+        return *workspace;
+    }
+    GaussianFactor::shared_ptr linearized = factor.linearize(linearizationPoint_);
+    *workspace = boost::dynamic_pointer_cast<JacobianFactor>(linearized);
+    return linearized;
+  }
+
+  /* ************************************************************************* */
+  template<class VALUE>
+  bool ExtendedKalmanFilter<VALUE>::canFuseDensely_(
+      const JacobianFactor& jacobian) {
+    // NoiseModelFactor::linearize returns whitened rows without a model (or
+    // with a constrained model, which dense QR cannot marginalize correctly)
+    const SharedDiagonal& model = jacobian.get_model();
+    return !model || model->isUnit();
+  }
+
+  /* ************************************************************************* */
+  template<class VALUE>
+  typename ExtendedKalmanFilter<VALUE>::T ExtendedKalmanFilter<VALUE>::moveAndCreatePrior_(
+      Key lastKey, DenseIndex offset, DenseIndex n) {
+    const Matrix R = augmented_.block(offset, offset, n, n)
+        .triangularView<Eigen::Upper>();
+    const Vector d = augmented_.block(offset, augmented_.cols() - 1, n, 1);
+
+    // Back-substitute for the update and move the linearization point
+    const Vector delta = R.triangularView<Eigen::Upper>().solve(d);
+    x_ = traits<T>::Retract(x_, delta);
+
+    // The new prior is expressed at the new linearization point, so its rhs
+    // shifts by R*delta, exactly as in solve_ above
+    priorFactor_ = boost::make_shared<JacobianFactor>(lastKey, R, d - R * delta,
+        noiseModel::Unit::Create(n));
+    return x_;
+  }
+
   /* ************************************************************************* */
   template <class VALUE>
   ExtendedKalmanFilter<VALUE>::ExtendedKalmanFilter(
@@ -81,21 +126,44 @@ namespace gtsam {
       const NoiseModelFactor& motionFactor) {
     const auto keys = motionFactor.keys();
 
-    // Create a Gaussian Factor Graph
+    // Reuse the workspace Values as the linearization point
+    linearizationPoint_.clear();
+    linearizationPoint_.insert(keys[0], x_);
+    linearizationPoint_.insert(keys[1], x_); // TODO should this really be x_ ?
+
+    // Linearize the motion model, reusing the workspace JacobianFactor
+    GaussianFactor::shared_ptr linearized = relinearize_(motionFactor, &motionJacobian_);
+
+    // Fast path: stack the prior rows on top of the whitened motion rows and
+    // re-triangularize with one dense QR; the rows below the x0 columns are
+    // then exactly the marginal P(x1)
+    if (motionJacobian_ && linearized == motionJacobian_ &&
+        canFuseDensely_(*motionJacobian_) && motionJacobian_->keys() == keys &&
+        priorFactor_->keys().front() == keys[0]) {
+      const DenseIndex m0 = priorFactor_->rows();
+      const DenseIndex m1 = motionJacobian_->rows();
+      const DenseIndex n0 = priorFactor_->getA(priorFactor_->begin()).cols();
+      const DenseIndex n1 = motionJacobian_->getDim(motionJacobian_->begin() + 1);
+      if (motionJacobian_->getDim(motionJacobian_->begin()) == n0 &&
+          m0 + m1 >= n0 + n1) {
+        augmented_.resize(m0 + m1, n0 + n1 + 1);
+        augmented_.setZero();
+        augmented_.topLeftCorner(m0, n0) = priorFactor_->getA(priorFactor_->begin());
+        augmented_.block(0, n0 + n1, m0, 1) = priorFactor_->getb();
+        augmented_.block(m0, 0, m1, n0) = motionJacobian_->getA(motionJacobian_->begin());
+        augmented_.block(m0, n0, m1, n1) = motionJacobian_->getA(motionJacobian_->begin() + 1);
+        augmented_.block(m0, n0 + n1, m1, 1) = motionJacobian_->getb();
+        inplace_QR(augmented_);
+        return moveAndCreatePrior_(keys[1], n0, n1);
+      }
+    }
+
+    // General path, e.g. for constrained models or non-Jacobian
+    // linearizations: build the two-factor graph and eliminate it
     GaussianFactorGraph linearFactorGraph;
-
-    // Add in previous posterior as prior on the first state
     linearFactorGraph.push_back(priorFactor_);
-
-    // Linearize motion model and add it to the Kalman Filter graph
-    Values linearizationPoint;
-    linearizationPoint.insert(keys[0], x_);
-    linearizationPoint.insert(keys[1], x_); // TODO should this really be x_ ?
-    linearFactorGraph.push_back(motionFactor.linearize(linearizationPoint));
-
-    // Solve the factor graph and update the current state estimate
-    // and the posterior for the next iteration.
-    x_ = solve_(linearFactorGraph, linearizationPoint, keys[1], &priorFactor_);
+    linearFactorGraph.push_back(linearized);
+    x_ = solve_(linearFactorGraph, linearizationPoint_, keys[1], &priorFactor_);
 
     return x_;
   }
@@ -106,20 +174,40 @@ namespace gtsam {
       const NoiseModelFactor& measurementFactor) {
     const auto keys = measurementFactor.keys();
 
-    // Create a Gaussian Factor Graph
+    // Reuse the workspace Values as the linearization point
+    linearizationPoint_.clear();
+    linearizationPoint_.insert(keys[0], x_);
+
+    // Linearize the measurement model, reusing the workspace JacobianFactor
+    GaussianFactor::shared_ptr linearized =
+        relinearize_(measurementFactor, &measurementJacobian_);
+
+    // Fast path: the posterior on x is simply the QR of the prior rows
+    // stacked on the whitened measurement rows, no marginalization needed
+    if (measurementJacobian_ && linearized == measurementJacobian_ &&
+        canFuseDensely_(*measurementJacobian_) &&
+        measurementJacobian_->keys() == keys &&
+        priorFactor_->keys().front() == keys[0]) {
+      const DenseIndex m0 = priorFactor_->rows();
+      const DenseIndex m1 = measurementJacobian_->rows();
+      const DenseIndex n0 = priorFactor_->getA(priorFactor_->begin()).cols();
+      if (measurementJacobian_->getDim(measurementJacobian_->begin()) == n0) {
+        augmented_.resize(m0 + m1, n0 + 1);
+        augmented_.topLeftCorner(m0, n0) = priorFactor_->getA(priorFactor_->begin());
+        augmented_.block(0, n0, m0, 1) = priorFactor_->getb();
+        augmented_.block(m0, 0, m1, n0) =
+            measurementJacobian_->getA(measurementJacobian_->begin());
+        augmented_.block(m0, n0, m1, 1) = measurementJacobian_->getb();
+        inplace_QR(augmented_);
+        return moveAndCreatePrior_(keys[0], 0, n0);
+      }
+    }
+
+    // General path, e.g. for constrained models or non-Jacobian linearizations
     GaussianFactorGraph linearFactorGraph;
-
-    // Add in the prior on the first state
     linearFactorGraph.push_back(priorFactor_);
-
-    // Linearize measurement factor and add it to the Kalman Filter graph
-    Values linearizationPoint;
-    linearizationPoint.insert(keys[0], x_);
-    linearFactorGraph.push_back(measurementFactor.linearize(linearizationPoint));
-
-    // Solve the factor graph and update the current state estimate
-    // and the prior factor for the next iteration
-    x_ = solve_(linearFactorGraph, linearizationPoint, keys[0], &priorFactor_);
+    linearFactorGraph.push_back(linearized);
+    x_ = solve_(linearFactorGraph, linearizationPoint_, keys[0], &priorFactor_);
 
     return x_;
   }
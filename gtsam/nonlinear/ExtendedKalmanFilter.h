@@ -59,9 +59,31 @@ class ExtendedKalmanFilter {
   T x_;                                     // linearization point
   JacobianFactor::shared_ptr priorFactor_;  // Gaussian density on x_
 
+  // Workspace reused across steps, so that the common case runs as two small
+  // dense operations (relinearize + QR) without building a factor graph,
+  // ordering, or junction tree per predict/update pair
+  Values linearizationPoint_;               // reused linearization point
+  JacobianFactor::shared_ptr motionJacobian_;       // reused motion linearization
+  JacobianFactor::shared_ptr measurementJacobian_;  // reused measurement linearization
+  Matrix augmented_;                        // stacked [prior; model] rows, QR'd in place
+
   static T solve_(const GaussianFactorGraph& linearFactorGraph, const Values& linearizationPoints,
                   Key x, JacobianFactor::shared_ptr* newPrior);
 
+  /// Linearize the factor at the current estimate, reusing the given
+  /// workspace JacobianFactor when its structure still matches
+  GaussianFactor::shared_ptr relinearize_(const NoiseModelFactor& factor,
+                                          JacobianFactor::shared_ptr* workspace);
+
+  /// True if the linearized factor can be fused with the prior by a plain
+  /// dense QR, i.e. its rows are already whitened
+  static bool canFuseDensely_(const JacobianFactor& jacobian);
+
+  /// After inplace_QR of the workspace, extract the n-dimensional marginal
+  /// on lastKey starting at (offset, offset), move the estimate, and rebuild
+  /// the prior factor at the new linearization point
+  T moveAndCreatePrior_(Key lastKey, DenseIndex offset, DenseIndex n);
+
  public:
   /// @name Standard Constructors
   /// @{
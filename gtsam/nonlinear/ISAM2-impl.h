@@ -82,12 +82,15 @@ struct GTSAM_EXPORT DeltaImpl {
   };
 
   /**
-   * Update the Newton's method step point, using wildfire
+   * Update the Newton's method step point, using wildfire.  The optional
+   * \c adaptiveThresholds map tightens the threshold for individual cliques,
+   * keyed by each clique's first frontal key, see
+   * ISAM2::registerDeltaConsumer.
    */
-  static size_t UpdateGaussNewtonDelta(const ISAM2::Roots& roots,
-                                       const KeySet& replacedKeys,
-                                       double wildfireThreshold,
-                                       VectorValues* delta);
+  static size_t UpdateGaussNewtonDelta(
+      const ISAM2::Roots& roots, const KeySet& replacedKeys,
+      double wildfireThreshold, VectorValues* delta,
+      const FastMap<Key, double>& adaptiveThresholds = FastMap<Key, double>());
 
   /**
    * Update the RgProd (R*g) incrementally taking into account which variables
@@ -375,7 +378,9 @@ struct GTSAM_EXPORT UpdateImpl {
   KeySet gatherRelinearizeKeys(const ISAM2::Roots& roots,
                                const VectorValues& delta,
                                const KeySet& fixedVariables,
-                               KeySet* markedKeys) const {
+                               const VariableIndex& variableIndex,
+                               KeySet* markedKeys,
+                               bool* relinearizationDeferred) const {
     gttic(gatherRelinearizeKeys);
     // J=\{\Delta_{j}\in\Delta|\Delta_{j}\geq\beta\}.
     KeySet relinKeys =
@@ -396,11 +401,51 @@ struct GTSAM_EXPORT UpdateImpl {
       }
     }
 
+    // Amortize relinearization bursts: cap the estimated re-elimination work
+    // in this update and defer the remaining keys to the next update.
+    *relinearizationDeferred = false;
+    if (params_.relinearizationBudget > 0 && !updateParams_.forceFullSolve)
+      relinKeys = limitRelinearizationBudget(relinKeys, delta, variableIndex,
+                                             relinearizationDeferred);
+
     // Add the variables being relinearized to the marked keys
     markedKeys->insert(relinKeys.begin(), relinKeys.end());
     return relinKeys;
   }
 
+  // Keep only the keys with the largest deltas whose total estimated
+  // re-elimination cost (counted as the number of involved factors) fits in
+  // ISAM2Params::relinearizationBudget.  Deferred keys remain above threshold
+  // and are picked up by subsequent updates.
+  KeySet limitRelinearizationBudget(const KeySet& relinKeys,
+                                    const VectorValues& delta,
+                                    const VariableIndex& variableIndex,
+                                    bool* relinearizationDeferred) const {
+    *relinearizationDeferred = false;
+    // Sort candidates by decreasing delta magnitude so the most out-of-date
+    // linearization points are refreshed first
+    std::vector<std::pair<double, Key> > candidates;
+    candidates.reserve(relinKeys.size());
+    for (Key key : relinKeys)
+      candidates.push_back(
+          std::make_pair(delta.at(key).lpNorm<Eigen::Infinity>(), key));
+    std::sort(candidates.begin(), candidates.end(),
+              std::greater<std::pair<double, Key> >());
+
+    KeySet limited;
+    size_t cost = 0;
+    for (const auto& candidate : candidates) {
+      cost += variableIndex[candidate.second].size();
+      // Always take at least one key so that progress is guaranteed
+      if (!limited.empty() && cost > size_t(params_.relinearizationBudget)) {
+        *relinearizationDeferred = true;
+        break;
+      }
+      limited.insert(candidate.second);
+    }
+    return limited;
+  }
+
   // Record relinerization threshold keys in detailed results
   void recordRelinearizeDetail(const KeySet& relinKeys,
                                ISAM2Result::DetailedResults* detail) const {
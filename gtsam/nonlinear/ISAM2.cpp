@@ -20,13 +20,18 @@
 #include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/nonlinear/ISAM2Result.h>
 
+#include <gtsam/base/cholesky.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/inference/BayesTree-inst.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
+#include <gtsam/nonlinear/Marginals.h>
 
 #include <algorithm>
+#include <stack>
 #include <map>
+#include <set>
+#include <stdexcept>
 #include <utility>
 
 using namespace std;
@@ -37,14 +42,22 @@ namespace gtsam {
 template class BayesTree<ISAM2Clique>;
 
 /* ************************************************************************* */
-ISAM2::ISAM2(const ISAM2Params& params) : params_(params), update_count_(0) {
+ISAM2::ISAM2(const ISAM2Params& params)
+    : params_(params), update_count_(0), relinearizationDeferred_(false),
+      eventLog_(params_.eventLogCapacity) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
+  // Reserve the vector-backed factor storage up front so updates within the
+  // declared capacity never grow it; see ISAM2CapacityHints
+  if (params_.capacityHints.maxFactors > 0) {
+    nonlinearFactors_.reserve(params_.capacityHints.maxFactors);
+    linearFactors_.reserve(params_.capacityHints.maxFactors);
+  }
 }
 
 /* ************************************************************************* */
-ISAM2::ISAM2() : update_count_(0) {
+ISAM2::ISAM2() : update_count_(0), relinearizationDeferred_(false) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
@@ -92,6 +105,13 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
         assert(linearFactors_[idx]->keys() == nonlinearFactors_[idx]->keys());
 #endif
         linearized.push_back(linearFactors_[idx]);
+      } else if (params_.cacheLinearizedFactors && linearizationCurrent(idx)) {
+        // A key was marked for relinearization, but every linearization
+        // point this factor involves is still at the revision the cached
+        // linearization was computed at (e.g. a factor added this very
+        // update, already linearized in step 7), so the cached factor is
+        // bit-identical to what linearize would produce.
+        linearized.push_back(linearFactors_[idx]);
       } else {
         auto linearFactor = nonlinearFactors_[idx]->linearize(theta_);
         linearized.push_back(linearFactor);
@@ -100,6 +120,7 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
           assert(linearFactors_[idx]->keys() == linearFactor->keys());
 #endif
           linearFactors_[idx] = linearFactor;
+          recordLinearizationRevisions(idx);
         }
       }
     }
@@ -109,6 +130,79 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
   return linearized;
 }
 
+/* ************************************************************************* */
+void ISAM2::addHotVariableConstraints(
+    const VariableIndex& affectedFactorsVarIndex, int hotGroup,
+    FastMap<Key, int>* constraintGroups) const {
+  if (params_.hotVariableOrderingCount <= 0 || keyAccessCounts_.empty())
+    return;
+  // Gather the access counts of the variables being reordered
+  std::vector<std::pair<size_t, Key> > counted;
+  counted.reserve(affectedFactorsVarIndex.size());
+  for (const auto& key_factors : affectedFactorsVarIndex) {
+    const auto count = keyAccessCounts_.find(key_factors.first);
+    if (count != keyAccessCounts_.end() && count->second > 0)
+      counted.push_back(std::make_pair(count->second, key_factors.first));
+  }
+  const size_t hotCount =
+      std::min(counted.size(),
+               static_cast<size_t>(params_.hotVariableOrderingCount));
+  if (hotCount == 0) return;
+  std::partial_sort(counted.begin(), counted.begin() + hotCount, counted.end(),
+                    std::greater<std::pair<size_t, Key> >());
+  for (size_t i = 0; i < hotCount; i++)
+    (*constraintGroups)[counted[i].second] = hotGroup;
+}
+
+/* ************************************************************************* */
+void ISAM2::recordLinearizationRevisions(FactorIndex factorIndex) const {
+  FastVector<size_t>& revisions = linearFactorRevisions_[factorIndex];
+  revisions.clear();
+  for (Key key : nonlinearFactors_[factorIndex]->keys()) {
+    auto revision = linPointRevision_.find(key);
+    revisions.push_back(revision == linPointRevision_.end() ? 0
+                                                            : revision->second);
+  }
+}
+
+/* ************************************************************************* */
+bool ISAM2::linearizationCurrent(FactorIndex factorIndex) const {
+  if (factorIndex >= linearFactors_.size() || !linearFactors_[factorIndex])
+    return false;
+  const auto stored = linearFactorRevisions_.find(factorIndex);
+  if (stored == linearFactorRevisions_.end()) return false;
+  const KeyVector& keys = nonlinearFactors_[factorIndex]->keys();
+  if (stored->second.size() != keys.size()) return false;
+  for (size_t i = 0; i < keys.size(); i++) {
+    const auto revision = linPointRevision_.find(keys[i]);
+    const size_t current =
+        (revision == linPointRevision_.end()) ? 0 : revision->second;
+    if (stored->second[i] != current) return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+void ISAM2::checkUpdateCapacity(const NonlinearFactorGraph& newFactors,
+                                const Values& newTheta) const {
+  const ISAM2CapacityHints& hints = params_.capacityHints;
+  if (hints.maxFactorsPerUpdate > 0 &&
+      newFactors.size() > hints.maxFactorsPerUpdate)
+    throw std::runtime_error(
+        "ISAM2::update: number of new factors exceeds "
+        "capacityHints.maxFactorsPerUpdate");
+  if (hints.maxFactors > 0 &&
+      nonlinearFactors_.size() + newFactors.size() > hints.maxFactors)
+    throw std::runtime_error(
+        "ISAM2::update: total number of factors would exceed "
+        "capacityHints.maxFactors");
+  if (hints.maxVariables > 0 &&
+      theta_.size() + newTheta.size() > hints.maxVariables)
+    throw std::runtime_error(
+        "ISAM2::update: total number of variables would exceed "
+        "capacityHints.maxVariables");
+}
+
 /* ************************************************************************* */
 void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
                         const KeySet& relinKeys, ISAM2Result* result) {
@@ -116,6 +210,15 @@ void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
   UpdateImpl::LogRecalculateKeys(*result);
 
   if (!result->markedKeys.empty() || !result->observedKeys.empty()) {
+    // Fail fast while the tree is still intact if the re-elimination frontier
+    // exceeds the declared per-update bound, see ISAM2CapacityHints
+    if (params_.capacityHints.maxMarkedKeysPerUpdate > 0 &&
+        result->markedKeys.size() >
+            params_.capacityHints.maxMarkedKeysPerUpdate)
+      throw std::runtime_error(
+          "ISAM2::update: number of variables marked for re-elimination "
+          "exceeds capacityHints.maxMarkedKeysPerUpdate");
+
     // Remove top of Bayes tree and convert to a factor graph:
     // (a) For each affected variable, remove the corresponding clique and all
     // parents up to the root. (b) Store orphaned sub-trees \BayesTree_{O} of
@@ -158,6 +261,10 @@ void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
                              &affectedKeysSet, &orphans, result);
     }
 
+    eventLog_.record(ISAM2Event::Reeliminate, update_count_,
+                     result->variablesReeliminated,
+                     static_cast<double>(result->factorsRecalculated));
+
     // Root clique variables for detailed results
     if (result->detail && params_.enableDetailedResults) {
       for (const auto& root : roots_)
@@ -167,6 +274,13 @@ void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
 
     // Update replaced keys mask (accumulates until back-substitution happens)
     deltaReplacedMask_.insert(affectedKeysSet.begin(), affectedKeysSet.end());
+
+    // Stamp the re-eliminated cliques for the cold-clique compression tier
+    for (Key key : affectedKeysSet) {
+      auto clique = nodes_.find(key);
+      if (clique != nodes_.end())
+        clique->second->lastAccessed_ = static_cast<size_t>(update_count_);
+    }
   }
 }
 
@@ -200,6 +314,7 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
       // Only if some variables are unconstrained
       FastMap<Key, int> constraintGroups;
       for (Key var : result->observedKeys) constraintGroups[var] = 1;
+      addHotVariableConstraints(affectedFactorsVarIndex, 2, &constraintGroups);
       order = Ordering::ColamdConstrained(affectedFactorsVarIndex,
                                           constraintGroups);
     } else {
@@ -210,7 +325,11 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
 
   gttic(linearize);
   auto linearized = nonlinearFactors_.linearize(theta_);
-  if (params_.cacheLinearizedFactors) linearFactors_ = *linearized;
+  if (params_.cacheLinearizedFactors) {
+    linearFactors_ = *linearized;
+    for (FactorIndex index = 0; index < nonlinearFactors_.size(); index++)
+      if (nonlinearFactors_[index]) recordLinearizationRevisions(index);
+  }
   gttoc(linearize);
 
   gttic(eliminate);
@@ -307,6 +426,11 @@ void ISAM2::recalculateIncremental(const ISAM2UpdateParams& updateParams,
   affectedKeysSet->insert(affectedKeys.begin(), affectedKeys.end());
   gttoc(list_to_set);
 
+  // Continuously learn which variables get re-eliminated most, so the
+  // ordering below can keep the hot ones near the root
+  if (params_.hotVariableOrderingCount > 0)
+    for (Key key : *affectedKeysSet) ++keyAccessCounts_[key];
+
   VariableIndex affectedFactorsVarIndex(factors);
 
   gttic(ordering_constraints);
@@ -320,6 +444,8 @@ void ISAM2::recalculateIncremental(const ISAM2UpdateParams& updateParams,
         result->observedKeys.size() < affectedFactorsVarIndex.size() ? 1 : 0;
     for (Key var : result->observedKeys)
       constraintGroups.insert(std::make_pair(var, group));
+    addHotVariableConstraints(affectedFactorsVarIndex, group + 1,
+                              &constraintGroups);
   }
 
   // Remove unaffected keys from the constraints
@@ -389,9 +515,101 @@ void ISAM2::removeVariables(const KeySet& unusedKeys) {
     Base::nodes_.unsafe_erase(key);
     theta_.erase(key);
     fixedVariables_.erase(key);
+    linPointRevision_.erase(key);
+    keyAccessCounts_.erase(key);
   }
 }
 
+/* ************************************************************************* */
+bool ISAM2::attemptDowndate(const FactorIndices& removeFactorIndices) {
+  gttic(attemptDowndate);
+  // Without the cache we do not know the linearizations that were combined
+  // into the factorization, so there is nothing to downdate with.
+  if (!params_.cacheLinearizedFactors) return false;
+
+  // Gather the cached linearizations of the removed factors, and count the
+  // removals per variable so we can detect variables losing all their factors.
+  FastVector<JacobianFactor::shared_ptr> removedJacobians;
+  removedJacobians.reserve(removeFactorIndices.size());
+  FastMap<Key, size_t> removalCounts;
+  for (const auto index : removeFactorIndices) {
+    if (index >= linearFactors_.size()) return false;
+    const auto jacobian =
+        boost::dynamic_pointer_cast<JacobianFactor>(linearFactors_[index]);
+    if (!jacobian) return false;
+    removedJacobians.push_back(jacobian);
+    for (Key key : *jacobian) ++removalCounts[key];
+  }
+  if (removedJacobians.empty()) return false;
+
+  // Every involved variable must be frontal in one and the same root clique,
+  // so the factors' entire contribution sits in that root's R'R and no
+  // correction needs to propagate to other cliques.  Variables that would be
+  // left without any factor have to be re-eliminated away instead.
+  sharedClique root;
+  for (const auto& key_count : removalCounts) {
+    const Key key = key_count.first;
+    const auto node = nodes_.find(key);
+    if (node == nodes_.end()) return false;
+    const sharedClique& clique = node->second;
+    if (!clique->isRoot()) return false;
+    if (root && clique != root) return false;
+    root = clique;
+    if (variableIndex_[key].size() <= key_count.second) return false;
+  }
+
+  const auto conditional = root->conditional();
+  if (conditional->get_model()) return false;  // R must be whitened
+
+  // Map each frontal variable to its column range in the root conditional
+  FastMap<Key, pair<DenseIndex, DenseIndex> > columnRanges;  // start, dim
+  DenseIndex dim = 0;
+  for (auto it = conditional->begin(); it != conditional->end(); ++it) {
+    const DenseIndex keyDim = conditional->getDim(it);
+    columnRanges[*it] = make_pair(dim, keyDim);
+    dim += keyDim;
+  }
+  const VerticalBlockMatrix& Ab = conditional->matrixObject();
+  if (dim != Ab.rows()) return false;  // Underconstrained root factorization
+
+  // Assemble the removed rows, whitened, in the conditional's column layout
+  DenseIndex rows = 0;
+  for (const auto& jacobian : removedJacobians) rows += jacobian->rows();
+  Matrix A = Matrix::Zero(rows, dim);
+  Vector b(rows);
+  DenseIndex row = 0;
+  for (const auto& jacobian : removedJacobians) {
+    const auto whitened = jacobian->jacobian();
+    DenseIndex column = 0;
+    for (auto it = jacobian->begin(); it != jacobian->end(); ++it) {
+      const auto& range = columnRanges.at(*it);
+      A.block(row, range.first, jacobian->rows(), range.second) =
+          whitened.first.middleCols(column, range.second);
+      column += range.second;
+    }
+    b.segment(row, jacobian->rows()) = whitened.second;
+    row += jacobian->rows();
+  }
+
+  // Downdate R'R -= A'A; the right-hand side follows through the information
+  // vector: R'd -= A'b, then back to d with the downdated factor.
+  Matrix R = conditional->R();
+  const Vector eta =
+      R.triangularView<Eigen::Upper>().transpose() * Vector(conditional->d()) -
+      A.transpose() * b;
+  if (!choleskyDowndate(R, A)) return false;  // Would go indefinite
+  const Vector d =
+      R.triangularView<Eigen::Upper>().transpose().solve(eta);
+
+  VerticalBlockMatrix& AbWrite = root->conditional()->matrixObject();
+  AbWrite.range(0, conditional->size()) = R.triangularView<Eigen::Upper>();
+  AbWrite(conditional->size()).col(0) = d;
+
+  // The root's solution changed; invalidate the affected part of delta
+  for (Key key : *conditional) deltaReplacedMask_.insert(key);
+  return true;
+}
+
 /* ************************************************************************* */
 ISAM2Result ISAM2::update(
     const NonlinearFactorGraph& newFactors, const Values& newTheta,
@@ -415,16 +633,34 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
                           const Values& newTheta,
                           const ISAM2UpdateParams& updateParams) {
   gttic(ISAM2_update);
+  if (params_.capacityHints.enabled())
+    checkUpdateCapacity(newFactors, newTheta);
   this->update_count_ += 1;
   UpdateImpl::LogStartingUpdate(newFactors, *this);
   ISAM2Result result(params_.enableDetailedResults);
   UpdateImpl update(params_, updateParams);
 
+  // Keys deferred by the relinearization budget force a relinearization step
+  // regardless of relinearizeSkip, so the backlog is worked off promptly
+  const bool relinearizeThisUpdate =
+      update.relinarizationNeeded(update_count_) || relinearizationDeferred_;
+
   // Update delta if we need it to check relinearization later
-  if (update.relinarizationNeeded(update_count_))
+  if (relinearizeThisUpdate)
     updateDelta(updateParams.forceFullSolve);
 
   // 1. Add any new factors \Factors:=\Factors\cup\Factors'.
+  // When enabled, first try to absorb the removals by downdating the root
+  // factorization so they do not force re-elimination.  This must happen
+  // before pushBackFactors drops the removed factors' cached linearizations.
+  const bool removalsDowndated =
+      params_.enableFactorDowndate &&
+      !updateParams.removeFactorIndices.empty() &&
+      attemptDowndate(updateParams.removeFactorIndices);
+  // Removed slots may be reused by pushBackFactors, so their cached
+  // linearization signatures must not survive.
+  for (FactorIndex index : updateParams.removeFactorIndices)
+    linearFactorRevisions_.erase(index);
   update.pushBackFactors(newFactors, &nonlinearFactors_, &linearFactors_,
                          &variableIndex_, &result.newFactorsIndices,
                          &result.keysWithRemovedFactors);
@@ -437,17 +673,22 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   if (params_.evaluateNonlinearError)
     update.error(nonlinearFactors_, calculateEstimate(), &result.errorBefore);
 
-  // 3. Mark linear update
-  update.gatherInvolvedKeys(newFactors, nonlinearFactors_,
-                            result.keysWithRemovedFactors, &result.markedKeys);
+  // 3. Mark linear update.  Keys whose removed factors were fully absorbed by
+  // the downdate need no re-elimination on the removal's account.
+  const KeySet noRemovedKeys;
+  update.gatherInvolvedKeys(
+      newFactors, nonlinearFactors_,
+      removalsDowndated ? noRemovedKeys : result.keysWithRemovedFactors,
+      &result.markedKeys);
   update.updateKeys(result.markedKeys, &result);
 
   KeySet relinKeys;
   result.variablesRelinearized = 0;
-  if (update.relinarizationNeeded(update_count_)) {
+  if (relinearizeThisUpdate) {
     // 4. Mark keys in \Delta above threshold \beta:
     relinKeys = update.gatherRelinearizeKeys(roots_, delta_, fixedVariables_,
-                                             &result.markedKeys);
+                                             variableIndex_, &result.markedKeys,
+                                             &relinearizationDeferred_);
     update.recordRelinearizeDetail(relinKeys, result.details());
     if (!relinKeys.empty()) {
       // 5. Mark cliques that involve marked variables \Theta_{J} and ancestors.
@@ -455,13 +696,32 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
       // 6. Update linearization point for marked variables:
       // \Theta_{J}:=\Theta_{J}+\Delta_{J}.
       UpdateImpl::ExpmapMasked(delta_, relinKeys, &theta_);
+      // Bump the revision of every point that actually moved; marked keys
+      // with an exactly-zero delta keep their revision, so factors touching
+      // only those can still reuse their cached linearization.
+      for (Key key : relinKeys)
+        if (delta_[key].lpNorm<Eigen::Infinity>() > 0.0)
+          ++linPointRevision_[key];
     }
     result.variablesRelinearized = result.markedKeys.size();
+    if (eventLog_.enabled() && !relinKeys.empty()) {
+      double maxDelta = 0.0;
+      for (Key key : relinKeys)
+        maxDelta = std::max(maxDelta, delta_[key].lpNorm<Eigen::Infinity>());
+      eventLog_.record(ISAM2Event::Relinearize, update_count_,
+                       result.variablesRelinearized, maxDelta);
+    }
+    if (relinearizationDeferred_)
+      eventLog_.record(ISAM2Event::RelinearizeDeferred, update_count_,
+                       relinKeys.size(), 0.0);
   }
 
   // 7. Linearize new factors
   update.linearizeNewFactors(newFactors, theta_, nonlinearFactors_.size(),
                              result.newFactorsIndices, &linearFactors_);
+  if (params_.cacheLinearizedFactors)
+    for (FactorIndex index : result.newFactorsIndices)
+      recordLinearizationRevisions(index);
   update.augmentVariableIndex(newFactors, result.newFactorsIndices,
                               &variableIndex_);
 
@@ -472,9 +732,72 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
 
   if (params_.evaluateNonlinearError)
     update.error(nonlinearFactors_, calculateEstimate(), &result.errorAfter);
+
+  // Periodically pack the Bayes tree to restore traversal locality
+  if (params_.packInterval > 0 && update_count_ % params_.packInterval == 0)
+    this->pack();
+
+  // 9. Publish a snapshot for lock-free concurrent readers, if requested
+  if (params_.publishEstimateSnapshot) publishEstimate();
+
+  return result;
+}
+
+/* ************************************************************************* */
+boost::optional<ISAM2Result> ISAM2::enqueueUpdate(
+    const NonlinearFactorGraph& newFactors, const Values& newTheta,
+    const FactorIndices& removeFactorIndices) {
+  gttic(ISAM2_enqueueUpdate);
+
+  pendingFactors_.push_back(newFactors);
+
+  // Deduplicate initial values across the queue: several packets in one
+  // coalescing window may each carry an initializer for the same new
+  // variable, e.g. a landmark observed by two sensors
+  for (const auto& key_value : newTheta) {
+    if (!pendingTheta_.exists(key_value.key) && !theta_.exists(key_value.key))
+      pendingTheta_.insert(key_value.key, key_value.value);
+  }
+
+  pendingRemoveIndices_.insert(pendingRemoveIndices_.end(),
+                               removeFactorIndices.begin(),
+                               removeFactorIndices.end());
+
+  ++pendingBatches_;
+  if (maxPendingBatches_ > 0 && pendingBatches_ >= maxPendingBatches_)
+    return flushUpdates();
+  return boost::none;
+}
+
+/* ************************************************************************* */
+ISAM2Result ISAM2::flushUpdates(const ISAM2UpdateParams& updateParams) {
+  gttic(ISAM2_flushUpdates);
+
+  // One update over the union of affected keys covers the whole cycle
+  ISAM2UpdateParams params = updateParams;
+  params.removeFactorIndices.insert(params.removeFactorIndices.end(),
+                                    pendingRemoveIndices_.begin(),
+                                    pendingRemoveIndices_.end());
+  ISAM2Result result = update(pendingFactors_, pendingTheta_, params);
+
+  pendingFactors_ = NonlinearFactorGraph();
+  pendingTheta_.clear();
+  pendingRemoveIndices_.clear();
+  pendingBatches_ = 0;
   return result;
 }
 
+/* ************************************************************************* */
+void ISAM2::publishEstimate() {
+  gttic(ISAM2_publishEstimate);
+  auto snapshot = boost::make_shared<PublishedEstimate>();
+  snapshot->values = calculateEstimate();
+  snapshot->version = update_count_;
+  // Swap in atomically; readers holding the previous snapshot keep it alive
+  boost::atomic_store(&publishedEstimate_,
+                      boost::shared_ptr<const PublishedEstimate>(snapshot));
+}
+
 /* ************************************************************************* */
 void ISAM2::marginalizeLeaves(
     const FastList<Key>& leafKeysList,
@@ -684,6 +1007,7 @@ void ISAM2::marginalizeLeaves(
     removedFactors.push_back(nonlinearFactors_[index]);
     nonlinearFactors_.remove(index);
     if (params_.cacheLinearizedFactors) linearFactors_.remove(index);
+    linearFactorRevisions_.erase(index);
   }
   variableIndex_.remove(factorIndicesToRemove.begin(),
                         factorIndicesToRemove.end(), removedFactors);
@@ -696,6 +1020,28 @@ void ISAM2::marginalizeLeaves(
   removeVariables(KeySet(leafKeys.begin(), leafKeys.end()));
 }
 
+/* ************************************************************************* */
+FastMap<Key, double> ISAM2::computeAdaptiveWildfireThresholds() const {
+  FastMap<Key, double> thresholds;
+  for (const auto& keyThreshold : deltaConsumerThresholds_) {
+    const auto node = nodes_.find(keyThreshold.first);
+    if (node == nodes_.end()) continue;
+    // Tighten the clique containing the key and all cliques on its path to
+    // the root, so backsubstitution propagates accurately down to the key
+    for (sharedClique clique = node->second; clique;
+         clique = clique->parent()) {
+      const auto inserted = thresholds.insert(
+          std::make_pair(clique->conditional()->front(), keyThreshold.second));
+      if (!inserted.second) {
+        // The rest of this path carries a threshold at least this tight
+        if (inserted.first->second <= keyThreshold.second) break;
+        inserted.first->second = keyThreshold.second;
+      }
+    }
+  }
+  return thresholds;
+}
+
 /* ************************************************************************* */
 // Marked const but actually changes mutable delta
 void ISAM2::updateDelta(bool forceFullSolve) const {
@@ -708,7 +1054,10 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
         forceFullSolve ? 0.0 : gaussNewtonParams.wildfireThreshold;
     gttic(Wildfire_update);
     DeltaImpl::UpdateGaussNewtonDelta(roots_, deltaReplacedMask_,
-                                      effectiveWildfireThreshold, &delta_);
+                                      effectiveWildfireThreshold, &delta_,
+                                      computeAdaptiveWildfireThresholds());
+    eventLog_.record(ISAM2Event::Wildfire, update_count_,
+                     deltaReplacedMask_.size(), effectiveWildfireThreshold);
     deltaReplacedMask_.clear();
     gttoc(Wildfire_update);
 
@@ -725,7 +1074,10 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
     // Compute Newton's method step
     gttic(Wildfire_update);
     DeltaImpl::UpdateGaussNewtonDelta(
-        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &deltaNewton_);
+        roots_, deltaReplacedMask_, effectiveWildfireThreshold, &deltaNewton_,
+        computeAdaptiveWildfireThresholds());
+    eventLog_.record(ISAM2Event::Wildfire, update_count_,
+                     deltaReplacedMask_.size(), effectiveWildfireThreshold);
     gttoc(Wildfire_update);
 
     // Compute steepest descent step
@@ -780,13 +1132,98 @@ Values ISAM2::calculateBestEstimate() const {
   return theta_.retract(delta_);
 }
 
+/* ************************************************************************* */
+size_t ISAM2::compressColdCliques(size_t minUpdatesCold) {
+  gttic(ISAM2_compressColdCliques);
+  const size_t now = static_cast<size_t>(update_count_);
+  size_t saved = 0;
+  std::stack<sharedClique> travStack;
+  for (const sharedClique& root : roots_) travStack.push(root);
+  while (!travStack.empty()) {
+    sharedClique clique = travStack.top();
+    travStack.pop();
+    if (now - clique->lastAccessed_ >= minUpdatesCold)
+      saved += clique->compressConditional();
+    for (const sharedClique& child : clique->children) travStack.push(child);
+  }
+  return saved;
+}
+
+/* ************************************************************************* */
+void ISAM2::decompressAllCliques() {
+  std::stack<sharedClique> travStack;
+  for (const sharedClique& root : roots_) travStack.push(root);
+  while (!travStack.empty()) {
+    sharedClique clique = travStack.top();
+    travStack.pop();
+    clique->decompressConditional();
+    for (const sharedClique& child : clique->children) travStack.push(child);
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2::decompressPathToRoot(Key key) const {
+  auto item = nodes_.find(key);
+  if (item == nodes_.end()) return;
+  for (sharedClique clique = item->second; clique; clique = clique->parent())
+    clique->decompressConditional();
+}
+
 /* ************************************************************************* */
 Matrix ISAM2::marginalCovariance(Key key) const {
+  decompressPathToRoot(key);
   return marginalFactor(key, params_.getEliminationFunction())
       ->information()
       .inverse();
 }
 
+/* ************************************************************************* */
+JointMarginal ISAM2::jointMarginalCovariance(const KeyVector& variables) const {
+  gttic(ISAM2_jointMarginalCovariance);
+  if (variables.empty())
+    throw std::invalid_argument(
+        "ISAM2::jointMarginalCovariance requires at least one variable");
+
+  const GaussianFactorGraph::Eliminate function =
+      params_.getEliminationFunction();
+
+  // Collect the conditionals of the cliques containing the requested
+  // variables and of all their ancestors.  An ancestor-closed set of cliques
+  // is leaf-removable from the rest of the tree, so the product of its
+  // conditionals is the exact marginal on its variables; this reuses the
+  // existing factorization and touches only the paths to the root.
+  GaussianFactorGraph ancestorGraph;
+  std::set<sharedClique> collected;
+  for (Key key : variables) {
+    decompressPathToRoot(key);
+    sharedClique current = clique(key);
+    while (current && collected.insert(current).second) {
+      ancestorGraph += boost::shared_ptr<GaussianFactor>(current->conditional());
+      current = current->parent();
+    }
+  }
+
+  // Marginalize the ancestor graph down to the requested variables
+  const GaussianFactorGraph marginalGraph(
+      *ancestorGraph.marginalMultifrontalBayesTree(variables, function));
+
+  // Assemble the joint information matrix, in sorted key order as in
+  // Marginals::jointMarginalInformation, and invert to a covariance
+  const Matrix augmentedInfo = marginalGraph.augmentedHessian();
+  const Matrix info = augmentedInfo.topLeftCorner(augmentedInfo.rows() - 1,
+                                                  augmentedInfo.cols() - 1);
+
+  KeyVector variablesSorted = variables;
+  std::sort(variablesSorted.begin(), variablesSorted.end());
+  std::vector<size_t> dims;
+  dims.reserve(variablesSorted.size());
+  for (Key key : variablesSorted) dims.push_back(theta_.at(key).dim());
+
+  JointMarginal joint(info, dims, variablesSorted);
+  joint.blockMatrix_.invertInPlace();
+  return joint;
+}
+
 /* ************************************************************************* */
 const VectorValues& ISAM2::getDelta() const {
   if (!deltaReplacedMask_.empty()) updateDelta();
@@ -798,6 +1235,31 @@ double ISAM2::error(const VectorValues& x) const {
   return GaussianFactorGraph(*this).error(x);
 }
 
+/* ************************************************************************* */
+namespace {
+size_t accumulateCliqueMemory(const ISAM2::sharedClique& clique) {
+  size_t result = clique->memoryUsage();
+  for (const ISAM2::sharedClique& child : clique->children)
+    result += accumulateCliqueMemory(child);
+  return result;
+}
+}  // namespace
+
+/* ************************************************************************* */
+size_t ISAM2::memoryUsage() const {
+  // Each nodes_ entry maps one key to its clique through a tree node
+  size_t result = sizeof(ISAM2) +
+                  nodes().size() * (sizeof(Key) + sizeof(sharedClique) + 4 * sizeof(void*));
+  for (const sharedClique& root : roots()) result += accumulateCliqueMemory(root);
+  result += theta_.memoryUsage();
+  result += delta_.memoryUsage();
+  result += deltaNewton_.memoryUsage();
+  result += RgProd_.memoryUsage();
+  result += nonlinearFactors_.memoryUsage();
+  result += linearFactors_.memoryUsage();
+  return result;
+}
+
 /* ************************************************************************* */
 VectorValues ISAM2::gradientAtZero() const {
   // Create result
@@ -22,15 +22,20 @@
 
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/nonlinear/ISAM2Clique.h>
+#include <gtsam/nonlinear/ISAM2EventLog.h>
 #include <gtsam/nonlinear/ISAM2Params.h>
 #include <gtsam/nonlinear/ISAM2Result.h>
 #include <gtsam/nonlinear/ISAM2UpdateParams.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
+#include <boost/serialization/optional.hpp>
+
 #include <vector>
 
 namespace gtsam {
 
+class JointMarginal;
+
 /**
  * @addtogroup ISAM2
  * Implementation of the full ISAM2 algorithm for incremental nonlinear
@@ -43,6 +48,14 @@ namespace gtsam {
  *
  */
 class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
+ public:
+  /** An immutable estimate snapshot published by update() for lock-free
+   * concurrent readers, see publishedEstimate(). */
+  struct PublishedEstimate {
+    Values values;   ///< The full estimate at the time of publication
+    int version;     ///< The update count at the time of publication
+  };
+
  protected:
   /** The current linearization point */
   Values theta_;
@@ -96,6 +109,60 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   int update_count_;  ///< Counter incremented every update(), used to determine
                       ///< periodic relinearization
 
+  /** Whether the last relinearization step hit
+   * ISAM2Params::relinearizationBudget and deferred keys to later updates.
+   * While set, every update runs a relinearization step regardless of
+   * relinearizeSkip, so the backlog is worked off promptly. */
+  bool relinearizationDeferred_;
+
+  /** The estimate snapshot most recently published by update() when
+   * ISAM2Params::publishEstimateSnapshot is enabled.  Written only through
+   * atomic_store and read only through atomic_load, so that readers in other
+   * threads never block behind update(). */
+  boost::shared_ptr<const PublishedEstimate> publishedEstimate_;
+
+  /** Ring-buffer event log populated by update() when
+   * ISAM2Params::eventLogCapacity is positive, see ISAM2EventLog.  Mutable
+   * because updateDelta(), which is const, records wildfire events. */
+  mutable ISAM2EventLog eventLog_;
+
+  /** Tight wildfire thresholds requested by downstream delta consumers,
+   * mapping a variable key to the tolerance that consumer needs, see
+   * registerDeltaConsumer. */
+  FastMap<Key, double> deltaConsumerThresholds_;
+
+  /// @name Linearization revision cache, see relinearizeAffectedFactors
+  /// @{
+  /** Monotonic per-key revision counter, bumped whenever a variable's
+   * linearization point actually changes (a nonzero retraction in step 6 of
+   * update).  Keys never touched by relinearization are simply absent,
+   * which counts as revision 0. */
+  FastMap<Key, size_t> linPointRevision_;
+
+  /** For each factor cached in linearFactors_, the revisions of its keys at
+   * the time it was linearized.  A factor whose signature still matches was
+   * linearized at bit-identical points and need not be linearized again,
+   * even if some of its keys were marked for relinearization.  Transient
+   * companion of linearFactors_, not serialized; an absent entry just
+   * disables reuse for that slot. */
+  mutable FastMap<FactorIndex, FastVector<size_t> > linearFactorRevisions_;
+  /// @}
+
+  /** Access-frequency counters used for profile-guided ordering when
+   * ISAM2Params::hotVariableOrderingCount is positive: update() bumps the
+   * counter of every re-eliminated variable, and recordKeyAccess folds in
+   * external telemetry.  Transient profile data, not serialized. */
+  FastMap<Key, size_t> keyAccessCounts_;
+
+  /// @name Update-coalescing queue, see enqueueUpdate
+  /// @{
+  NonlinearFactorGraph pendingFactors_;   ///< Queued factor batches, merged
+  Values pendingTheta_;                   ///< Deduplicated queued initial values
+  FactorIndices pendingRemoveIndices_;    ///< Queued factor removals
+  size_t pendingBatches_ = 0;             ///< Number of batches queued so far
+  size_t maxPendingBatches_ = 0;          ///< Auto-flush bound, 0 = manual flush
+  /// @}
+
  public:
   using This = ISAM2;                       ///< This class
   using Base = BayesTree<ISAM2Clique>;      ///< The BayesTree base class
@@ -179,6 +246,44 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
                              const Values& newTheta,
                              const ISAM2UpdateParams& updateParams);
 
+  /**
+   * Queue a factor batch instead of updating immediately.  Front-ends that
+   * call update() once per sensor packet pay full tree-maintenance overhead
+   * for each micro-update; queued batches are merged - factors concatenated,
+   * initial values deduplicated against both the queue and the current
+   * system - and applied by flushUpdates() as a single update() over the
+   * union of affected keys, so one re-elimination covers the whole cycle.
+   *
+   * The estimate does not reflect queued batches until they are flushed.
+   * With setMaxPendingBatches(n), enqueueUpdate flushes automatically once n
+   * batches are queued and returns the result of that update, bounding the
+   * staleness of the estimate to at most n-1 queued batches; otherwise it
+   * returns boost::none and the caller flushes once per cycle.
+   *
+   * @param newFactors Factors to queue, as for update()
+   * @param newTheta Initial values for new variables; values for variables
+   * already queued or already in the system are ignored
+   * @param removeFactorIndices Indices of existing factors to remove at
+   * flush time; indices of factors still in the queue are not valid here
+   * @return The result of the automatic flush if it ran, otherwise none
+   */
+  boost::optional<ISAM2Result> enqueueUpdate(
+      const NonlinearFactorGraph& newFactors, const Values& newTheta = Values(),
+      const FactorIndices& removeFactorIndices = FactorIndices());
+
+  /** Apply all queued batches as one update() and empty the queue, see
+   * enqueueUpdate.  Safe to call with an empty queue, which degenerates to an
+   * empty update. */
+  ISAM2Result flushUpdates(
+      const ISAM2UpdateParams& updateParams = ISAM2UpdateParams());
+
+  /** Number of batches queued by enqueueUpdate and not yet flushed */
+  size_t pendingBatches() const { return pendingBatches_; }
+
+  /** Bound the coalescing queue: once \c n batches are queued, enqueueUpdate
+   * flushes automatically.  0 (the default) disables automatic flushing. */
+  void setMaxPendingBatches(size_t n) { maxPendingBatches_ = n; }
+
   /** Marginalize out variables listed in leafKeys.  These keys must be leaves
    * in the BayesTree.  Throws MarginalizeNonleafException if non-leaves are
    * requested to be marginalized.  Marginalization leaves a linear
@@ -239,6 +344,13 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   /** Return marginal on any variable as a covariance matrix */
   Matrix marginalCovariance(Key key) const;
 
+  /** Return the joint marginal covariance on an arbitrary set of variables,
+   * reusing the existing clique factorizations.  Only the conditionals of the
+   * cliques on the paths from the involved cliques to the root are collected
+   * and re-eliminated, so this is much cheaper than constructing a Marginals
+   * object, which refactorizes the whole graph. */
+  JointMarginal jointMarginalCovariance(const KeyVector& variables) const;
+
   /// @name Public members for non-typical usage
   /// @{
 
@@ -247,6 +359,77 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    */
   Values calculateBestEstimate() const;
 
+  /** Return the estimate snapshot most recently published by update(), or an
+   * empty pointer if ISAM2Params::publishEstimateSnapshot is disabled or
+   * update() has not yet been called.  Unlike calculateEstimate(), this is
+   * safe to call from other threads while update() is running and never
+   * blocks: the snapshot is immutable and swapped in atomically, so a reader
+   * always sees a complete, consistent estimate, at most one update old.
+   */
+  boost::shared_ptr<const PublishedEstimate> publishedEstimate() const {
+    return boost::atomic_load(&publishedEstimate_);
+  }
+
+  /** Access the instrumentation event log, populated by update() when
+   * ISAM2Params::eventLogCapacity is positive.  A telemetry consumer
+   * typically drains it with ISAM2EventLog::forEach() and then clears it
+   * through the non-const overload. */
+  const ISAM2EventLog& eventLog() const { return eventLog_; }
+
+  /** Non-const access to the event log, so a consumer can clear() it after
+   * draining */
+  ISAM2EventLog& eventLog() { return eventLog_; }
+
+  /** Move the conditionals of cliques that have not been re-eliminated for at
+   * least \c minUpdatesCold calls to update() into a float32 compressed tier,
+   * releasing their double-precision matrices, and return the bytes saved.
+   * Cold map regions dominate clique memory in long sessions, and their
+   * conditionals are rarely consulted: back-substitution and the marginal
+   * functions restore a compressed clique transparently when they touch it
+   * (with float32 rounding), and a clique whose variables are marked in a
+   * later update() is re-eliminated exactly as usual.  Call
+   * decompressAllCliques() before serializing this object or before handing
+   * the tree to code that reads clique conditionals directly. */
+  size_t compressColdCliques(size_t minUpdatesCold);
+
+  /** Restore every clique compressed by compressColdCliques */
+  void decompressAllCliques();
+
+  /** Register a downstream consumer that needs the delta of \c key accurate
+   * to within \c wildfireThreshold.  Wildfire backsubstitution then applies
+   * the tighter of this and the global wildfire threshold to the clique
+   * containing \c key and to all cliques on its path to the root, so delta
+   * propagation work concentrates where accuracy matters: register a tight
+   * tolerance near the active robot pose and leave distant map regions under
+   * the loose global threshold.  Registering an already-registered key
+   * replaces its threshold. */
+  void registerDeltaConsumer(Key key, double wildfireThreshold) {
+    deltaConsumerThresholds_[key] = wildfireThreshold;
+  }
+
+  /** Remove the registration made by registerDeltaConsumer for \c key */
+  void unregisterDeltaConsumer(Key key) { deltaConsumerThresholds_.erase(key); }
+
+  /** The thresholds registered through registerDeltaConsumer */
+  const FastMap<Key, double>& deltaConsumerThresholds() const {
+    return deltaConsumerThresholds_;
+  }
+
+  /** Feed an access-frequency hint for a variable, e.g. replayed from
+   * production telemetry about which cliques get re-eliminated most.  The
+   * hint accumulates on top of the re-elimination counts update() gathers by
+   * itself and is consulted by the ordering when
+   * ISAM2Params::hotVariableOrderingCount is positive, pulling hot variables
+   * toward the root clique. */
+  void recordKeyAccess(Key key, size_t count = 1) {
+    keyAccessCounts_[key] += count;
+  }
+
+  /** The access-frequency counters gathered so far, see recordKeyAccess */
+  const FastMap<Key, size_t>& keyAccessCounts() const {
+    return keyAccessCounts_;
+  }
+
   /** Access the current delta, computed during the last call to update */
   const VectorValues& getDelta() const;
 
@@ -269,6 +452,14 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   /** prints out clique statistics */
   void printStats() const { getCliqueData().getStats().print(); }
 
+  /** The number of bytes of memory occupied by this solver: the Bayes tree
+   * cliques (conditionals, cached factors, compressed tiers), the
+   * linearization point, the linear deltas, and the stored factor graphs.
+   * Per-component numbers are available by calling memoryUsage() on the
+   * individual accessors, e.g. getLinearizationPoint().memoryUsage() or
+   * getFactorsUnsafe().memoryUsage() (\f$ O(n) \f$). */
+  size_t memoryUsage() const;
+
   /** Compute the gradient of the energy function, \f$ \nabla_{x=0} \left\Vert
    * \Sigma^{-1} R x - d \right\Vert^2 \f$, centered around zero. The gradient
    * about zero is \f$ -R^T d \f$.  See also gradient(const GaussianBayesNet&,
@@ -281,6 +472,24 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   /// @}
 
  protected:
+  /**
+   * Try to apply the given factor removals as a rank-k Cholesky downdate of
+   * the root clique factorization, see ISAM2Params::enableFactorDowndate.
+   * Must be called before the factors are removed from the graph and variable
+   * index.  Returns true if all removals were absorbed by the downdate, in
+   * which case no variables need to be marked for re-elimination on their
+   * account; returns false without modifying anything otherwise.
+   */
+  bool attemptDowndate(const FactorIndices& removeFactorIndices);
+
+  /**
+   * Fail fast, before any state is modified, if this update would exceed the
+   * capacity hints declared in ISAM2Params::capacityHints.
+   * @throw std::runtime_error naming the violated bound
+   */
+  void checkUpdateCapacity(const NonlinearFactorGraph& newFactors,
+                           const Values& newTheta) const;
+
   /// Remove marked top and either recalculate in batch or incrementally.
   void recalculate(const ISAM2UpdateParams& updateParams,
                    const KeySet& relinKeys, ISAM2Result* result);
@@ -295,6 +504,22 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
       const ISAM2UpdateParams& updateParams, const FastList<Key>& affectedKeys,
       const KeySet& relinKeys);
 
+  /** Overlay constraint groups pinning the hottest variables of the
+   * submatrix being reordered to \c hotGroup, so CCOLAMD eliminates them
+   * last (nearest the root).  No-op unless
+   * ISAM2Params::hotVariableOrderingCount is positive. */
+  void addHotVariableConstraints(const VariableIndex& affectedFactorsVarIndex,
+                                 int hotGroup,
+                                 FastMap<Key, int>* constraintGroups) const;
+
+  /// Record the current key revisions for the linearization cached in
+  /// linearFactors_[factorIndex], see linearFactorRevisions_
+  void recordLinearizationRevisions(FactorIndex factorIndex) const;
+
+  /// Whether linearFactors_[factorIndex] was linearized at the current
+  /// (bit-identical) linearization points of all its keys
+  bool linearizationCurrent(FactorIndex factorIndex) const;
+
   void recalculateIncremental(const ISAM2UpdateParams& updateParams,
                               const KeySet& relinKeys,
                               const FastList<Key>& affectedKeys,
@@ -315,6 +540,50 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   void removeVariables(const KeySet& unusedKeys);
 
   void updateDelta(bool forceFullSolve = false) const;
+
+  /** Restore any compressed cliques on the path from \c key's clique to the
+   * root, so the marginal functions can read their conditionals.  See
+   * compressColdCliques. */
+  void decompressPathToRoot(Key key) const;
+
+  /** Expand the registered consumer thresholds into per-clique thresholds for
+   * wildfire backsubstitution: each registered key's clique and all cliques
+   * on its path to the root get the consumer's threshold (the tightest one,
+   * if several apply), keyed by first frontal key.  Returns an empty map when
+   * no consumers are registered. */
+  FastMap<Key, double> computeAdaptiveWildfireThresholds() const;
+
+  /** Retract the current estimate into an immutable snapshot and publish it
+   * atomically for concurrent readers, see publishedEstimate(). */
+  void publishEstimate();
+
+ private:
+  /** Serialization function.  Together with the binary archive helpers in
+   * base/serialization.h this provides a compact snapshot of the full solver
+   * state (tree, linearization point, delta and cached factors), so a
+   * restarted process can resume incremental updates without replaying them.
+   * The publishedEstimate_ snapshot is a derived cache and is not saved; it is
+   * repopulated by the first update() after loading.  The event log is
+   * likewise transient and starts out empty. */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
+    ar & BOOST_SERIALIZATION_NVP(theta_);
+    ar & BOOST_SERIALIZATION_NVP(variableIndex_);
+    ar & BOOST_SERIALIZATION_NVP(delta_);
+    ar & BOOST_SERIALIZATION_NVP(deltaNewton_);
+    ar & BOOST_SERIALIZATION_NVP(RgProd_);
+    ar & BOOST_SERIALIZATION_NVP(deltaReplacedMask_);
+    ar & BOOST_SERIALIZATION_NVP(nonlinearFactors_);
+    ar & BOOST_SERIALIZATION_NVP(linearFactors_);
+    ar & BOOST_SERIALIZATION_NVP(params_);
+    ar & BOOST_SERIALIZATION_NVP(doglegDelta_);
+    ar & BOOST_SERIALIZATION_NVP(fixedVariables_);
+    ar & BOOST_SERIALIZATION_NVP(update_count_);
+    ar & BOOST_SERIALIZATION_NVP(relinearizationDeferred_);
+    ar & BOOST_SERIALIZATION_NVP(deltaConsumerThresholds_);
+  }
 };  // ISAM2
 
 /// traits
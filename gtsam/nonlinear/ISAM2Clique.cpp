@@ -20,6 +20,15 @@
 #include <gtsam/linear/linearAlgorithms-inst.h>
 #include <gtsam/nonlinear/ISAM2Clique.h>
 
+#include <boost/make_shared.hpp>
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/task_group.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <stack>
 #include <utility>
 
@@ -35,6 +44,7 @@ void ISAM2Clique::setEliminationResult(
     const FactorGraphType::EliminationResult& eliminationResult) {
   conditional_ = eliminationResult.first;
   cachedFactor_ = eliminationResult.second;
+  compressed_.reset();  // a re-eliminated clique is exact again
   // Compute gradient contribution
   gradientContribution_.resize(conditional_->cols() - 1);
   // Rewrite -(R * P')'*d   as   -(d' * R * P')'   for computational speed
@@ -63,6 +73,67 @@ void ISAM2Clique::print(const string& s, const KeyFormatter& formatter) const {
     gtsam::print(gradientContribution_, "Gradient contribution: ");
 }
 
+/* ************************************************************************* */
+size_t ISAM2Clique::memoryUsage() const {
+  size_t result = sizeof(*this) + children.capacity() * sizeof(shared_ptr);
+  if (conditional_)
+    result += conditional_->memoryUsage();
+  if (cachedFactor_)
+    result += cachedFactor_->memoryUsage();
+  result += gradientContribution_.size() * sizeof(double);
+  if (compressed_)
+    result += sizeof(CompressedConditional)
+        + compressed_->dims.capacity() * sizeof(DenseIndex)
+        + compressed_->values.capacity() * sizeof(float)
+        + compressed_->sigmas.size() * sizeof(double);
+  if (cachedSeparatorMarginal_)
+    result += cachedSeparatorMarginal_->memoryUsage();
+  return result;
+}
+
+/* ************************************************************************* */
+size_t ISAM2Clique::compressConditional() {
+  if (compressed_ || !conditional_) return 0;
+  auto compressed = boost::make_shared<CompressedConditional>();
+  const Matrix full = conditional_->matrixObject().full();  // [R S d]
+  compressed->rows = full.rows();
+  compressed->values.resize(full.size());
+  Eigen::Map<Eigen::MatrixXf>(compressed->values.data(), full.rows(),
+                              full.cols()) = full.cast<float>();
+  for (auto it = conditional_->begin(); it != conditional_->end(); ++it)
+    compressed->dims.push_back(conditional_->getDim(it));
+  if (conditional_->get_model())
+    compressed->sigmas = conditional_->get_model()->sigmas();
+
+  // Replace the conditional by a zero-row husk: keys and block layout survive
+  // for structural queries, the matrix payload does not.
+  VerticalBlockMatrix husk(compressed->dims, Matrix(0, full.cols()), true);
+  conditional_ = boost::make_shared<GaussianConditional>(
+      conditional_->keys(), conditional_->nrFrontals(), husk);
+  compressed_ = compressed;
+  return full.size() * (sizeof(double) - sizeof(float));
+}
+
+/* ************************************************************************* */
+void ISAM2Clique::decompressConditional() const {
+  if (!compressed_) return;
+  ISAM2Clique* self = const_cast<ISAM2Clique*>(this);
+  const CompressedConditional& compressed = *compressed_;
+  DenseIndex cols = 1;
+  for (DenseIndex dim : compressed.dims) cols += dim;
+  const Matrix full =
+      Eigen::Map<const Eigen::MatrixXf>(compressed.values.data(),
+                                        compressed.rows, cols)
+          .cast<double>();
+  SharedDiagonal model;
+  if (compressed.sigmas.size() > 0)
+    model = noiseModel::Diagonal::Sigmas(compressed.sigmas);
+  VerticalBlockMatrix augmented(compressed.dims, full, true);
+  self->conditional_ = boost::make_shared<GaussianConditional>(
+      conditional_->keys(), conditional_->nrFrontals(), augmented, model);
+  self->compressed_.reset();
+}
+
 /* ************************************************************************* */
 bool ISAM2Clique::isDirty(const KeySet& replaced, const KeySet& changed) const {
   // if none of the variables in this clique (frontal and separator!) changed
@@ -203,6 +274,8 @@ void ISAM2Clique::optimizeWildfire(const KeySet& replaced, double threshold,
                                    KeySet* changed, VectorValues* delta,
                                    size_t* count) const {
   if (isDirty(replaced, *changed)) {
+    decompressConditional();  // touched: restore a compressed clique
+
     // Temporary copy of the original values, to check how much they change
     auto originalValues = delta->vector(conditional_->frontals());
 
@@ -233,13 +306,24 @@ size_t optimizeWildfire(const ISAM2Clique::shared_ptr& root, double threshold,
 }
 
 /* ************************************************************************* */
-bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
-                                       KeySet* changed, VectorValues* delta,
-                                       size_t* count) const {
+bool ISAM2Clique::optimizeWildfireNode(
+    const KeySet& replaced, double threshold, KeySet* changed,
+    VectorValues* delta, size_t* count,
+    const FastMap<Key, double>& adaptiveThresholds) const {
   // TODO(gareth): This code shares a lot of logic w/ linearAlgorithms-inst,
   // potentially refactor
   bool dirty = isDirty(replaced, *changed);
   if (dirty) {
+    decompressConditional();  // touched: restore a compressed clique
+
+    // Apply a tighter registered threshold for this clique, if any
+    double effectiveThreshold = threshold;
+    if (!adaptiveThresholds.empty()) {
+      auto it = adaptiveThresholds.find(conditional_->front());
+      if (it != adaptiveThresholds.end())
+        effectiveThreshold = std::min(threshold, it->second);
+    }
+
     // Temporary copy of the original values, to check how much they change
     auto originalValues = delta->vector(conditional_->frontals());
 
@@ -247,7 +331,7 @@ bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
     fastBackSubstitute(delta);
     count += conditional_->nrFrontals();
 
-    if (valuesChanged(replaced, originalValues, *delta, threshold)) {
+    if (valuesChanged(replaced, originalValues, *delta, effectiveThreshold)) {
       markFrontalsAsChanged(changed);
     } else {
       restoreFromOriginals(originalValues, delta);
@@ -257,12 +341,80 @@ bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
   return dirty;
 }
 
-size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
-                                    double threshold, const KeySet& keys,
-                                    VectorValues* delta) {
+/* ************************************************************************* */
+bool ISAM2Clique::optimizeWildfireNodeParallel(
+    const KeySet& replaced, double threshold, KeySet* changed,
+    std::mutex* changedMutex, VectorValues* delta, size_t* count,
+    const FastMap<Key, double>& adaptiveThresholds) const {
+  bool dirty;
+  {
+    std::lock_guard<std::mutex> lock(*changedMutex);
+    dirty = isDirty(replaced, *changed);
+  }
+  if (dirty) {
+    decompressConditional();  // touched: restore a compressed clique
+
+    // Apply a tighter registered threshold for this clique, if any
+    double effectiveThreshold = threshold;
+    if (!adaptiveThresholds.empty()) {
+      auto it = adaptiveThresholds.find(conditional_->front());
+      if (it != adaptiveThresholds.end())
+        effectiveThreshold = std::min(threshold, it->second);
+    }
+
+    // Temporary copy of the original values, to check how much they change
+    auto originalValues = delta->vector(conditional_->frontals());
+
+    // Back-substitute, unlocked: only this clique's frontals are written
+    fastBackSubstitute(delta);
+    *count += conditional_->nrFrontals();
+
+    if (valuesChanged(replaced, originalValues, *delta, effectiveThreshold)) {
+      std::lock_guard<std::mutex> lock(*changedMutex);
+      markFrontalsAsChanged(changed);
+    } else {
+      restoreFromOriginals(originalValues, delta);
+    }
+  }
+
+  return dirty;
+}
+
+size_t optimizeWildfireNonRecursive(
+    const ISAM2Clique::shared_ptr& root, double threshold, const KeySet& keys,
+    VectorValues* delta, const FastMap<Key, double>& adaptiveThresholds) {
   KeySet changed;
   size_t count = 0;
 
+#ifdef GTSAM_USE_TBB
+  if (root) {
+    // Parallel wildfire: sibling subtrees are independent once their
+    // parent's frontals are final, because every clique writes only its own
+    // frontal entries of delta and its separator refers only to ancestor
+    // frontals.  A clique's task is spawned by its unique parent after the
+    // parent finished, so each clique is claimed exactly once by
+    // construction; the shared changed set and the solve counter are the
+    // only contended state.
+    std::atomic<size_t> atomicCount(0);
+    std::mutex changedMutex;
+    tbb::task_group tasks;
+    std::function<void(const ISAM2Clique::shared_ptr&)> processSubtree =
+        [&](const ISAM2Clique::shared_ptr& clique) {
+          size_t cliqueCount = 0;
+          const bool dirty = clique->optimizeWildfireNodeParallel(
+              keys, threshold, &changed, &changedMutex, delta, &cliqueCount,
+              adaptiveThresholds);
+          atomicCount += cliqueCount;
+          if (dirty) {
+            for (const auto& child : clique->children)
+              tasks.run([&processSubtree, child] { processSubtree(child); });
+          }
+        };
+    processSubtree(root);
+    tasks.wait();
+    count = atomicCount;
+  }
+#else
   if (root) {
     std::stack<ISAM2Clique::shared_ptr> travStack;
     travStack.push(root);
@@ -270,8 +422,8 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
     while (!travStack.empty()) {
       currentNode = travStack.top();
       travStack.pop();
-      bool dirty = currentNode->optimizeWildfireNode(keys, threshold, &changed,
-                                                     delta, &count);
+      bool dirty = currentNode->optimizeWildfireNode(
+          keys, threshold, &changed, delta, &count, adaptiveThresholds);
       if (dirty) {
         for (const auto& child : currentNode->children) {
           travStack.push(child);
@@ -279,13 +431,16 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
       }
     }
   }
+#endif
 
   return count;
 }
 
 /* ************************************************************************* */
 void ISAM2Clique::nnz_internal(size_t* result) const {
-  size_t dimR = conditional_->rows();
+  // The husk of a compressed clique has zero rows; use the recorded count
+  size_t dimR = compressed_ ? static_cast<size_t>(compressed_->rows)
+                            : static_cast<size_t>(conditional_->rows());
   size_t dimSep = conditional_->S().cols();
   *result += ((dimR + 1) * dimR) / 2 + dimSep * dimR;
   // traverse the children
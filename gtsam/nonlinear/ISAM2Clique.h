@@ -19,11 +19,13 @@
 
 #pragma once
 
+#include <gtsam/base/FastMap.h>
 #include <gtsam/inference/BayesTreeCliqueBase.h>
 #include <gtsam/inference/Key.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <mutex>
 #include <string>
 
 namespace gtsam {
@@ -43,21 +45,36 @@ class GTSAM_EXPORT ISAM2Clique
   typedef GaussianConditional ConditionalType;
   typedef ConditionalType::shared_ptr sharedConditional;
 
+  /** Float32 snapshot of a conditional's matrix, kept while the full
+   * double-precision matrix of a cold clique is released.  See
+   * compressConditional. */
+  struct CompressedConditional {
+    FastVector<DenseIndex> dims;  ///< variable block widths, excluding the rhs column
+    DenseIndex rows;              ///< number of matrix rows
+    std::vector<float> values;    ///< column-major augmented matrix [R S d]
+    Vector sigmas;                ///< noise model sigmas, empty if the model was absent
+  };
+
   Base::FactorType::shared_ptr cachedFactor_;
   Vector gradientContribution_;
+  boost::shared_ptr<CompressedConditional> compressed_;
+  size_t lastAccessed_;  ///< update count when this clique was last (re-)eliminated,
+                         ///< maintained by ISAM2 for cold-clique compression
 #ifdef USE_BROKEN_FAST_BACKSUBSTITUTE
   mutable FastMap<Key, VectorValues::iterator> solnPointers_;
 #endif
 
   /// Default constructor
-  ISAM2Clique() : Base() {}
+  ISAM2Clique() : Base(), lastAccessed_(0) {}
 
   /// Copy constructor, does *not* copy solution pointers as these are invalid
   /// in different trees.
   ISAM2Clique(const ISAM2Clique& other)
       : Base(other),
         cachedFactor_(other.cachedFactor_),
-        gradientContribution_(other.gradientContribution_) {}
+        gradientContribution_(other.gradientContribution_),
+        compressed_(other.compressed_),
+        lastAccessed_(other.lastAccessed_) {}
 
   /// Assignment operator, does *not* copy solution pointers as these are
   /// invalid in different trees.
@@ -65,6 +82,8 @@ class GTSAM_EXPORT ISAM2Clique
     Base::operator=(other);
     cachedFactor_ = other.cachedFactor_;
     gradientContribution_ = other.gradientContribution_;
+    compressed_ = other.compressed_;
+    lastAccessed_ = other.lastAccessed_;
     return *this;
   }
 
@@ -75,6 +94,29 @@ class GTSAM_EXPORT ISAM2Clique
   /** Access the cached factor */
   Base::FactorType::shared_ptr& cachedFactor() { return cachedFactor_; }
 
+  /** Demote the conditional to a float32 snapshot, releasing its
+   * double-precision matrix, and return the bytes saved.  The conditional is
+   * replaced by a zero-row husk that keeps the keys and block layout alive for
+   * structural queries; the matrix payload is rebuilt by
+   * decompressConditional, which back-substitution and the ISAM2 marginal
+   * functions call on touch.  Restored values carry float32 rounding - a
+   * clique whose variables are marked in a later update() is re-eliminated
+   * exactly as usual, discarding the snapshot. */
+  size_t compressConditional();
+
+  /** Rebuild the double-precision conditional from the float32 snapshot, if
+   * this clique is compressed.  Logically const: it only re-materializes
+   * released data. */
+  void decompressConditional() const;
+
+  /** Whether the conditional currently lives in the compressed tier */
+  bool isCompressed() const { return compressed_.get() != nullptr; }
+
+  /** The number of bytes of memory occupied by this clique and its owned
+   * storage: the conditional, the cached factor, the gradient contribution,
+   * the compressed tier if present, and any cached separator marginal */
+  size_t memoryUsage() const;
+
   /// Access the gradient contribution
   const Vector& gradientContribution() const { return gradientContribution_; }
 
@@ -91,9 +133,27 @@ class GTSAM_EXPORT ISAM2Clique
                         KeySet* changed, VectorValues* delta,
                         size_t* count) const;
 
-  bool optimizeWildfireNode(const KeySet& replaced, double threshold,
-                            KeySet* changed, VectorValues* delta,
-                            size_t* count) const;
+  /** Back-substitute this node if dirty, applying an adaptive per-clique
+   * threshold where one is registered.  \c adaptiveThresholds maps a clique's
+   * first frontal key to a threshold that overrides \c threshold (the
+   * tighter of the two is applied), see ISAM2::registerDeltaConsumer. */
+  bool optimizeWildfireNode(
+      const KeySet& replaced, double threshold, KeySet* changed,
+      VectorValues* delta, size_t* count,
+      const FastMap<Key, double>& adaptiveThresholds = FastMap<Key, double>())
+      const;
+
+  /** Thread-safe variant of optimizeWildfireNode, used by the parallel
+   * traversal in optimizeWildfireNonRecursive.  Accesses to the shared
+   * \c changed set are guarded by \c changedMutex; the back-substitution
+   * itself runs unlocked, since each clique writes only its own frontal
+   * entries of \c delta and reads only ancestor entries that were final
+   * before this clique's task was spawned. */
+  bool optimizeWildfireNodeParallel(
+      const KeySet& replaced, double threshold, KeySet* changed,
+      std::mutex* changedMutex, VectorValues* delta, size_t* count,
+      const FastMap<Key, double>& adaptiveThresholds = FastMap<Key, double>())
+      const;
 
   /**
    * Starting from the root, add up entries of frontal and conditional matrices
@@ -170,8 +230,18 @@ class GTSAM_EXPORT ISAM2Clique
 size_t optimizeWildfire(const ISAM2Clique::shared_ptr& root, double threshold,
                         const KeySet& replaced, VectorValues* delta);
 
-size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
-                                    double threshold, const KeySet& replaced,
-                                    VectorValues* delta);
+/** Non-recursive version of optimizeWildfire.  The optional
+ * \c adaptiveThresholds map assigns tighter per-clique thresholds, keyed by
+ * each clique's first frontal key; cliques without an entry use the global
+ * \c threshold.  See ISAM2::registerDeltaConsumer.
+ *
+ * When TBB is enabled the dirty subtrees are processed in parallel: once a
+ * clique's frontals are final its child subtrees are independent, so each
+ * child is spawned as its own task.  Without TBB the traversal is the
+ * original serial stack walk. */
+size_t optimizeWildfireNonRecursive(
+    const ISAM2Clique::shared_ptr& root, double threshold,
+    const KeySet& replaced, VectorValues* delta,
+    const FastMap<Key, double>& adaptiveThresholds = FastMap<Key, double>());
 
 }  // namespace gtsam
@@ -0,0 +1,150 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2EventLog.h
+ * @brief   Low-overhead ring-buffer event log for ISAM2::update()
+ * @author  Michael Kaess, Richard Roberts, Frank Dellaert
+ */
+
+// \callgraph
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * @addtogroup ISAM2
+ * A single instrumentation event recorded during ISAM2::update().  Events are
+ * plain structs of fixed size so recording them is a few stores into a
+ * preallocated buffer, cheap enough to leave enabled in production.  The
+ * meaning of the count and value fields depends on the event type, see Type.
+ */
+struct ISAM2Event {
+  /// What happened; determines the interpretation of count and value
+  enum Type {
+    /** Variables crossed the relinearization threshold and were relinearized.
+     * count is the number of marked variables, value is the largest delta
+     * magnitude among the variables above the threshold. */
+    Relinearize,
+    /** The relinearization budget was hit and keys were deferred to later
+     * updates, see ISAM2Params::relinearizationBudget.  count is the number
+     * of variables that were relinearized within the budget, value is 0. */
+    RelinearizeDeferred,
+    /** Part of the Bayes tree was re-eliminated.  count is the number of
+     * re-eliminated variables, value is the number of factors involved. */
+    Reeliminate,
+    /** Wildfire partial backsubstitution updated the linear delta.  count is
+     * the number of variables whose deltas were invalidated since the last
+     * backsubstitution, value is the wildfire threshold that was applied. */
+    Wildfire
+  };
+
+  int update;    ///< Value of the ISAM2 update counter when recorded
+  Type type;     ///< The kind of event, see Type
+  size_t count;  ///< Event-specific count, see Type
+  double value;  ///< Event-specific magnitude or threshold, see Type
+};
+
+/**
+ * A fixed-capacity ring buffer of ISAM2Event entries, enabled with
+ * ISAM2Params::eventLogCapacity and accessed through ISAM2::eventLog().  Once
+ * full, new events overwrite the oldest ones, so memory use is bounded and
+ * recording never allocates after construction.  This is the cheap
+ * alternative to ISAM2Params::enableDetailedResults for diagnosing why
+ * specific updates spike: a telemetry consumer drains the buffer with
+ * forEach() between updates (or less often, accepting that dropped() events
+ * were overwritten) and clears it with clear().
+ */
+class ISAM2EventLog {
+  size_t capacity_;                 ///< Maximum number of retained events
+  size_t totalRecorded_;            ///< Events recorded since construction/clear
+  std::vector<ISAM2Event> buffer_;  ///< The ring buffer, oldest-first until full
+
+ public:
+  /** Default constructor creates a disabled log that drops all events */
+  ISAM2EventLog() : capacity_(0), totalRecorded_(0) {}
+
+  /** Create a log retaining up to \c capacity events; non-positive capacity
+   * disables the log */
+  explicit ISAM2EventLog(int capacity)
+      : capacity_(capacity > 0 ? static_cast<size_t>(capacity) : 0),
+        totalRecorded_(0) {
+    buffer_.reserve(capacity_);
+  }
+
+  /** Whether events are being retained */
+  bool enabled() const { return capacity_ > 0; }
+
+  /** Maximum number of retained events */
+  size_t capacity() const { return capacity_; }
+
+  /** Number of events currently in the buffer */
+  size_t size() const { return buffer_.size(); }
+
+  /** Number of events recorded since construction or the last clear() */
+  size_t totalRecorded() const { return totalRecorded_; }
+
+  /** Number of recorded events that have been overwritten */
+  size_t dropped() const { return totalRecorded_ - buffer_.size(); }
+
+  /** Record an event, overwriting the oldest one if the buffer is full.
+   * A no-op when the log is disabled. */
+  void record(ISAM2Event::Type type, int update, size_t count, double value) {
+    if (capacity_ == 0) return;
+    ISAM2Event event;
+    event.update = update;
+    event.type = type;
+    event.count = count;
+    event.value = value;
+    if (buffer_.size() < capacity_)
+      buffer_.push_back(event);
+    else
+      buffer_[totalRecorded_ % capacity_] = event;
+    ++totalRecorded_;
+  }
+
+  /** Apply \c function to the retained events, oldest first */
+  template <typename CALLBACK>
+  void forEach(CALLBACK function) const {
+    const size_t start =
+        buffer_.size() < capacity_ ? 0 : totalRecorded_ % capacity_;
+    for (size_t i = 0; i < buffer_.size(); ++i)
+      function(buffer_[(start + i) % buffer_.size()]);
+  }
+
+  /** Discard all retained events and reset the counters */
+  void clear() {
+    buffer_.clear();
+    totalRecorded_ = 0;
+  }
+
+  /// Print the retained events, oldest first
+  void print(const std::string& str = "") const {
+    std::cout << str << "ISAM2EventLog: " << buffer_.size() << " of "
+              << totalRecorded_ << " events retained\n";
+    forEach([](const ISAM2Event& event) {
+      static const char* names[] = {"Relinearize", "RelinearizeDeferred",
+                                    "Reeliminate", "Wildfire"};
+      std::cout << "  update " << event.update << ": " << names[event.type]
+                << " count " << event.count << " value " << event.value
+                << "\n";
+    });
+    std::cout.flush();
+  }
+};
+
+}  // namespace gtsam
@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ISAM2MarginalService.cpp
+ * @brief Background marginal covariance service attached to an ISAM2 instance
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/ISAM2MarginalService.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ISAM2MarginalService::ISAM2MarginalService(const ISAM2& isam)
+    : isam_(isam), hits_(0), misses_(0) {
+}
+
+/* ************************************************************************* */
+ISAM2MarginalService::~ISAM2MarginalService() {
+  wait();
+}
+
+/* ************************************************************************* */
+void ISAM2MarginalService::refresh(const KeyVector& keys) {
+  wait();
+  worker_ = std::thread(&ISAM2MarginalService::computeKeys, this, keys);
+}
+
+/* ************************************************************************* */
+void ISAM2MarginalService::wait() {
+  if (worker_.joinable())
+    worker_.join();
+}
+
+/* ************************************************************************* */
+boost::optional<Matrix> ISAM2MarginalService::cachedMarginalCovariance(
+    Key key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FastMap<Key, Entry>::const_iterator item = cache_.find(key);
+  if (item == cache_.end() || !entryValid(key, item->second))
+    return boost::none;
+  ++hits_;
+  return item->second.covariance;
+}
+
+/* ************************************************************************* */
+Matrix ISAM2MarginalService::marginalCovariance(Key key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FastMap<Key, Entry>::const_iterator item = cache_.find(key);
+  if (item != cache_.end() && entryValid(key, item->second)) {
+    ++hits_;
+    return item->second.covariance;
+  }
+  ++misses_;
+  return compute(key);
+}
+
+/* ************************************************************************* */
+void ISAM2MarginalService::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+}
+
+/* ************************************************************************* */
+bool ISAM2MarginalService::entryValid(Key key, const Entry& entry) const {
+  ISAM2::Nodes::const_iterator node = isam_.nodes().find(key);
+  if (node == isam_.nodes().end() || node->second.get() != entry.clique)
+    return false;
+  // Computing the marginal populated the separator marginals of the whole
+  // root path; ISAM2 deletes them along any path an update touches, so a
+  // surviving cache means everything the marginal depends on is unchanged
+  return static_cast<bool>(node->second->cachedSeparatorMarginal());
+}
+
+/* ************************************************************************* */
+const Matrix& ISAM2MarginalService::compute(Key key) {
+  Entry& entry = cache_[key];
+  entry.covariance = isam_.marginalCovariance(key);
+  entry.clique = isam_.nodes().at(key).get();
+  return entry.covariance;
+}
+
+/* ************************************************************************* */
+void ISAM2MarginalService::computeKeys(const KeyVector& keys) {
+  for (Key key : keys) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isam_.nodes().find(key) == isam_.nodes().end())
+      continue;
+    FastMap<Key, Entry>::const_iterator item = cache_.find(key);
+    if (item != cache_.end() && entryValid(key, item->second))
+      continue;
+    compute(key);
+  }
+}
+
+/* ************************************************************************* */
+} // \ namespace gtsam
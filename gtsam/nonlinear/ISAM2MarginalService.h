@@ -0,0 +1,118 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ISAM2MarginalService.h
+ * @brief Background marginal covariance service attached to an ISAM2 instance
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <mutex>
+#include <thread>
+
+namespace gtsam {
+
+/**
+ * Precomputes and caches marginal covariances of an ISAM2 instance so that a
+ * consumer - a data-association thread, say - can read them at microsecond
+ * latency instead of paying for a synchronous marginalCovariance() inside its
+ * own loop.  After each ISAM2::update() the owner calls refresh() with the
+ * keys of interest; the covariances are then computed on a background thread
+ * while the caller goes on with other work.
+ *
+ * Cache entries are invalidated per clique, not wholesale: an entry stays
+ * valid as long as its key's clique is the same object and that clique's
+ * cachedSeparatorMarginal() is still populated.  ISAM2 deletes the cached
+ * separator marginals along every path its update touches, so a surviving
+ * cache means the whole root path of the clique - everything the marginal
+ * depends on - is unchanged.
+ *
+ * Threading contract: cachedMarginalCovariance() may be called from any
+ * thread at any time.  The computing entry points - refresh(),
+ * marginalCovariance(), and the background worker - read the ISAM2 instance
+ * and must therefore not overlap with ISAM2::update(); call refresh() or
+ * wait() after an update returns, and wait() again before the next one.
+ */
+class GTSAM_EXPORT ISAM2MarginalService {
+
+ public:
+
+  /// Attach to an ISAM2 instance, which must outlive this service
+  explicit ISAM2MarginalService(const ISAM2& isam);
+
+  /// Joins any in-flight background refresh
+  ~ISAM2MarginalService();
+
+  /**
+   * Recompute the covariances of the given keys on a background thread,
+   * skipping entries whose cliques are untouched since they were computed.
+   * Joins any previous refresh first.  Keys not present in the tree are
+   * ignored.
+   */
+  void refresh(const KeyVector& keys);
+
+  /// Block until the current background refresh, if any, has finished
+  void wait();
+
+  /**
+   * Return the cached covariance for a key, or boost::none if it is not
+   * cached or its clique changed since it was computed.  Never computes
+   * anything, so this is safe to call from other threads while a refresh is
+   * running.
+   */
+  boost::optional<Matrix> cachedMarginalCovariance(Key key) const;
+
+  /**
+   * Return the covariance for a key, computing and caching it synchronously
+   * on a miss.  Subject to the computing side of the threading contract.
+   */
+  Matrix marginalCovariance(Key key);
+
+  /// Number of queries answered from cache
+  size_t hits() const { return hits_; }
+
+  /// Number of queries that had to compute
+  size_t misses() const { return misses_; }
+
+  /// Drop all cached covariances
+  void clear();
+
+ private:
+
+  /// A cached covariance, tagged with the clique it was computed from
+  struct Entry {
+    const ISAM2Clique* clique; ///< identity of the key's clique at compute time
+    Matrix covariance;
+  };
+
+  /// True if a cached entry is still valid for this key, caller holds mutex_
+  bool entryValid(Key key, const Entry& entry) const;
+
+  /// Compute and store the covariance for one key, caller holds mutex_
+  const Matrix& compute(Key key);
+
+  /// Background worker body for refresh()
+  void computeKeys(const KeyVector& keys);
+
+  const ISAM2& isam_; ///< the attached instance
+  mutable std::mutex mutex_; ///< guards cache_ and the counters
+  FastMap<Key, Entry> cache_; ///< covariances by key
+  std::thread worker_; ///< background refresh thread
+  mutable size_t hits_; ///< mutable so const cache reads can count
+  size_t misses_;
+};
+
+} // \ namespace gtsam
@@ -21,6 +21,8 @@
 
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/variant.hpp>
 #include <boost/variant.hpp>
 #include <string>
 
@@ -56,6 +58,14 @@ struct GTSAM_EXPORT ISAM2GaussNewtonParams {
   void setWildfireThreshold(double wildfireThreshold) {
     this->wildfireThreshold = wildfireThreshold;
   }
+
+ private:
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(wildfireThreshold);
+  }
 };
 
 /**
@@ -123,6 +133,61 @@ struct GTSAM_EXPORT ISAM2DoglegParams {
       const;
   DoglegOptimizerImpl::TrustRegionAdaptationMode adaptationModeTranslator(
       const std::string& adaptationMode) const;
+
+ private:
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(initialDelta);
+    ar & BOOST_SERIALIZATION_NVP(wildfireThreshold);
+    ar & BOOST_SERIALIZATION_NVP(adaptationMode);
+    ar & BOOST_SERIALIZATION_NVP(verbose);
+  }
+};
+
+/**
+ * @addtogroup ISAM2
+ * Capacity hints for bounded-latency operation of ISAM2, set through
+ * ISAM2Params::capacityHints.  When a hint is positive, the storage it covers
+ * is reserved up front where the container supports it, and update() fails
+ * fast with std::runtime_error - before any state is modified - the moment an
+ * update would exceed the declared bound.  This bounds the amount of work a
+ * single update() can trigger, which is what dominates its worst-case
+ * latency; it does not make update() allocation-free, since the Bayes tree
+ * and the per-variable maps allocate per node.  A zero hint (the default)
+ * disables that check.
+ */
+struct GTSAM_EXPORT ISAM2CapacityHints {
+  size_t maxVariables;            ///< total variables in the system
+  size_t maxFactors;              ///< total factor slots, also reserved up front
+  size_t maxFactorsPerUpdate;     ///< new factors in a single update()
+  size_t maxMarkedKeysPerUpdate;  ///< variables marked for re-elimination in a
+                                  ///< single update(), checked before the tree
+                                  ///< is modified
+
+  ISAM2CapacityHints()
+      : maxVariables(0),
+        maxFactors(0),
+        maxFactorsPerUpdate(0),
+        maxMarkedKeysPerUpdate(0) {}
+
+  /// Whether any hint is active
+  bool enabled() const {
+    return maxVariables > 0 || maxFactors > 0 || maxFactorsPerUpdate > 0 ||
+           maxMarkedKeysPerUpdate > 0;
+  }
+
+ private:
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(maxVariables);
+    ar & BOOST_SERIALIZATION_NVP(maxFactors);
+    ar & BOOST_SERIALIZATION_NVP(maxFactorsPerUpdate);
+    ar & BOOST_SERIALIZATION_NVP(maxMarkedKeysPerUpdate);
+  }
 };
 
 /**
@@ -223,6 +288,62 @@ struct GTSAM_EXPORT ISAM2Params {
   /// cost of having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /// Whether update() publishes an immutable snapshot of the current estimate
+  /// that concurrent readers can obtain lock-free through
+  /// ISAM2::publishedEstimate(), without blocking behind update() (default:
+  /// false).  Publishing costs one full retract of all variables per update.
+  bool publishEstimateSnapshot;
+
+  /** If positive, caps the relinearization work performed by a single
+   * update(), measured as the total number of factors involving the
+   * relinearized variables (a proxy for re-elimination cost).  The variables
+   * with the largest deltas are relinearized first and the remainder is
+   * carried forward to subsequent updates, which run a relinearization step
+   * regardless of relinearizeSkip until the backlog is worked off.  This
+   * bounds the latency spike when many variables cross the threshold at once,
+   * at the cost of spreading the relinearization over several updates
+   * (default: 0, unlimited). */
+  int relinearizationBudget;
+
+  /** Attempt to apply removeFactorIndices as a low-rank Cholesky downdate of
+   * the root clique factorization instead of re-eliminating the affected part
+   * of the tree (default: false).  The downdate applies when the removed
+   * factors' cached linearizations exist and all their variables are frontal
+   * in a root clique and remain constrained by other factors; otherwise the
+   * usual re-elimination path is taken.  Useful for sliding-window operation
+   * where recently added factors, which typically involve variables near the
+   * root, are frequently retracted. */
+  bool enableFactorDowndate;
+
+  /** If positive, update() records instrumentation events (relinearizations,
+   * clique re-eliminations, wildfire backsubstitutions) into a ring buffer of
+   * this capacity, accessible through ISAM2::eventLog().  Recording is a few
+   * stores into preallocated memory per update, so unlike
+   * enableDetailedResults this can stay enabled in production; a telemetry
+   * consumer drains the buffer between updates (default: 0, disabled). */
+  int eventLogCapacity;
+
+  /** If positive, the Bayes tree is packed (cliques reallocated into
+   * depth-first order, see BayesTree::pack) after every packInterval-th
+   * update.  Incremental updates scatter cliques through the heap, hurting
+   * the memory locality of backsubstitution and shortcut computation;
+   * periodic packing restores it at the cost of copying every clique
+   * (default: 0, disabled). */
+  int packInterval;
+
+  /** If positive, up to this many of the most frequently re-eliminated
+   * variables are pinned to the end of every computed ordering, placing them
+   * in or near the root clique so that future updates touching them
+   * re-eliminate a shorter path.  Frequencies are gathered continuously from
+   * update() itself and can be seeded from production telemetry through
+   * ISAM2::recordKeyAccess.  Only applies when no explicit constrainedKeys
+   * are given, which always take precedence (default: 0, disabled). */
+  int hotVariableOrderingCount;
+
+  /** Capacity hints for bounded-latency operation; see ISAM2CapacityHints.
+   * All hints are zero (disabled) by default. */
+  ISAM2CapacityHints capacityHints;
+
   /**
    * Specify parameters as constructor arguments
    * See the documentation of member variables above.
@@ -246,7 +367,13 @@ struct GTSAM_EXPORT ISAM2Params {
         keyFormatter(_keyFormatter),
         enableDetailedResults(_enableDetailedResults),
         enablePartialRelinearizationCheck(false),
-        findUnusedFactorSlots(false) {}
+        findUnusedFactorSlots(false),
+        publishEstimateSnapshot(false),
+        relinearizationBudget(0),
+        enableFactorDowndate(false),
+        eventLogCapacity(0),
+        packInterval(0),
+        hotVariableOrderingCount(0) {}
 
   /// print iSAM2 parameters
   void print(const std::string& str = "") const {
@@ -288,6 +415,16 @@ struct GTSAM_EXPORT ISAM2Params {
          << enablePartialRelinearizationCheck << "\n";
     cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots
          << "\n";
+    cout << "publishEstimateSnapshot:           " << publishEstimateSnapshot
+         << "\n";
+    cout << "relinearizationBudget:             " << relinearizationBudget
+         << "\n";
+    cout << "enableFactorDowndate:              " << enableFactorDowndate
+         << "\n";
+    cout << "eventLogCapacity:                  " << eventLogCapacity << "\n";
+    cout << "packInterval:                      " << packInterval << "\n";
+    cout << "capacityHints:                     "
+         << (capacityHints.enabled() ? "enabled" : "disabled") << "\n";
     cout.flush();
   }
 
@@ -312,6 +449,11 @@ struct GTSAM_EXPORT ISAM2Params {
   bool isEnablePartialRelinearizationCheck() const {
     return enablePartialRelinearizationCheck;
   }
+  bool isPublishEstimateSnapshot() const { return publishEstimateSnapshot; }
+  int getRelinearizationBudget() const { return relinearizationBudget; }
+  bool isEnableFactorDowndate() const { return enableFactorDowndate; }
+  int getEventLogCapacity() const { return eventLogCapacity; }
+  int getPackInterval() const { return packInterval; }
 
   void setOptimizationParams(OptimizationParams optimizationParams) {
     this->optimizationParams = optimizationParams;
@@ -344,6 +486,23 @@ struct GTSAM_EXPORT ISAM2Params {
       bool enablePartialRelinearizationCheck) {
     this->enablePartialRelinearizationCheck = enablePartialRelinearizationCheck;
   }
+  void setPublishEstimateSnapshot(bool publishEstimateSnapshot) {
+    this->publishEstimateSnapshot = publishEstimateSnapshot;
+  }
+  void setRelinearizationBudget(int relinearizationBudget) {
+    this->relinearizationBudget = relinearizationBudget;
+  }
+  void setEnableFactorDowndate(bool enableFactorDowndate) {
+    this->enableFactorDowndate = enableFactorDowndate;
+  }
+  void setEventLogCapacity(int eventLogCapacity) {
+    this->eventLogCapacity = eventLogCapacity;
+  }
+  void setPackInterval(int packInterval) { this->packInterval = packInterval; }
+  const ISAM2CapacityHints& getCapacityHints() const { return capacityHints; }
+  void setCapacityHints(const ISAM2CapacityHints& capacityHints) {
+    this->capacityHints = capacityHints;
+  }
 
   GaussianFactorGraph::Eliminate getEliminationFunction() const {
     return factorization == CHOLESKY
@@ -360,6 +519,31 @@ struct GTSAM_EXPORT ISAM2Params {
   static std::string factorizationTranslator(const Factorization& value);
 
   /// @}
+
+ private:
+  /** Serialization function.  The keyFormatter is a std::function and cannot
+   * be serialized; a loaded instance keeps whatever formatter it was
+   * constructed with (the default one after default construction). */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_NVP(optimizationParams);
+    ar & BOOST_SERIALIZATION_NVP(relinearizeThreshold);
+    ar & BOOST_SERIALIZATION_NVP(relinearizeSkip);
+    ar & BOOST_SERIALIZATION_NVP(enableRelinearization);
+    ar & BOOST_SERIALIZATION_NVP(evaluateNonlinearError);
+    ar & BOOST_SERIALIZATION_NVP(factorization);
+    ar & BOOST_SERIALIZATION_NVP(cacheLinearizedFactors);
+    ar & BOOST_SERIALIZATION_NVP(enableDetailedResults);
+    ar & BOOST_SERIALIZATION_NVP(enablePartialRelinearizationCheck);
+    ar & BOOST_SERIALIZATION_NVP(findUnusedFactorSlots);
+    ar & BOOST_SERIALIZATION_NVP(publishEstimateSnapshot);
+    ar & BOOST_SERIALIZATION_NVP(relinearizationBudget);
+    ar & BOOST_SERIALIZATION_NVP(enableFactorDowndate);
+    ar & BOOST_SERIALIZATION_NVP(eventLogCapacity);
+    ar & BOOST_SERIALIZATION_NVP(packInterval);
+    ar & BOOST_SERIALIZATION_NVP(capacityHints);
+  }
 };
 
 }  // namespace gtsam
@@ -157,7 +157,11 @@ struct ISAM2Result {
    * Detail for information about the results data stored here. */
   boost::optional<DetailedResults> detail;
 
-  explicit ISAM2Result(bool enableDetailedResults = false) {
+  explicit ISAM2Result(bool enableDetailedResults = false)
+      : variablesRelinearized(0),
+        variablesReeliminated(0),
+        factorsRecalculated(0),
+        cliques(0) {
     if (enableDetailedResults) detail.reset(DetailedResults());
   }
 
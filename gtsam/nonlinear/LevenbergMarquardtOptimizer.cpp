@@ -20,9 +20,11 @@
 
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/nonlinear/internal/LevenbergMarquardtState.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/base/Vector.h>
@@ -52,7 +54,9 @@ LevenbergMarquardtOptimizer::LevenbergMarquardtOptimizer(const NonlinearFactorGr
     : NonlinearOptimizer(
           graph, std::unique_ptr<State>(new State(initialValues, graph.error(initialValues),
                                                   params.lambdaInitial, params.lambdaFactor))),
-      params_(LevenbergMarquardtParams::EnsureHasOrdering(params, graph)) {}
+      params_(LevenbergMarquardtParams::EnsureHasOrdering(params, graph)),
+      cachedDampedSystemValid_(false),
+      irlsAge_(-1) {}
 
 LevenbergMarquardtOptimizer::LevenbergMarquardtOptimizer(const NonlinearFactorGraph& graph,
                                                          const Values& initialValues,
@@ -61,7 +65,9 @@ LevenbergMarquardtOptimizer::LevenbergMarquardtOptimizer(const NonlinearFactorGr
     : NonlinearOptimizer(
           graph, std::unique_ptr<State>(new State(initialValues, graph.error(initialValues),
                                                   params.lambdaInitial, params.lambdaFactor))),
-      params_(LevenbergMarquardtParams::ReplaceOrdering(params, ordering)) {}
+      params_(LevenbergMarquardtParams::ReplaceOrdering(params, ordering)),
+      cachedDampedSystemValid_(false),
+      irlsAge_(-1) {}
 
 /* ************************************************************************* */
 void LevenbergMarquardtOptimizer::initTime() {
@@ -82,9 +88,77 @@ int LevenbergMarquardtOptimizer::getInnerIterations() const {
 
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::linearize() const {
+  if (params_.irlsIterations > 0)
+    return linearizeIRLS();
+  if (params_.linearizeInPlace) {
+    // First call allocates the layout, subsequent calls overwrite in place
+    if (!reusedLinearGraph_)
+      reusedLinearGraph_ = boost::make_shared<GaussianFactorGraph>();
+    graph_.linearizeInPlace(state_->values, *reusedLinearGraph_);
+    return reusedLinearGraph_;
+  }
   return graph_.linearize(state_->values);
 }
 
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::linearizeIRLS() const {
+  using noiseModel::Robust;
+  const Values& x = state_->values;
+
+  // Every (irlsIterations + 1)-th call is a full linearization that refills
+  // the cache; the calls in between only re-evaluate residuals and robust
+  // weights, reusing the cached base-whitened Jacobians of the robust factors
+  const bool reweightOnly = (irlsAge_ >= 0 && irlsAge_ < params_.irlsIterations);
+  if (!reweightOnly)
+    irlsBaseJacobians_.assign(graph_.size(), std::vector<Matrix>());
+
+  auto linear = boost::make_shared<GaussianFactorGraph>();
+  linear->reserve(graph_.size());
+
+  for (size_t i = 0; i < graph_.size(); ++i) {
+    const NonlinearFactor::shared_ptr& factor = graph_[i];
+    auto noiseFactor = boost::dynamic_pointer_cast<NoiseModelFactor>(factor);
+    Robust::shared_ptr robust;
+    if (noiseFactor)
+      robust = boost::dynamic_pointer_cast<Robust>(noiseFactor->noiseModel());
+    if (!robust || !noiseFactor->active(x)) {
+      // Not a robust factor: linearize as usual
+      linear->push_back(factor ? factor->linearize(x) : GaussianFactor::shared_ptr());
+      continue;
+    }
+
+    std::vector<Matrix> A;
+    Vector b;
+    if (reweightOnly && !irlsBaseJacobians_[i].empty()) {
+      // Cheap pass: fresh residual, cached Jacobians
+      A = irlsBaseJacobians_[i];  // copied, as reweight scales in place
+      b = -noiseFactor->unwhitenedError(x);
+      robust->noise()->whitenInPlace(b);
+    } else {
+      // Full pass: evaluate Jacobians, whiten by the base model, and cache
+      // the result before the robust weight is applied
+      A.resize(noiseFactor->size());
+      b = -noiseFactor->unwhitenedError(x, A);
+      robust->noise()->WhitenSystem(A, b);
+      irlsBaseJacobians_[i] = A;
+    }
+    robust->robust()->reweight(A, b);
+
+    std::vector<std::pair<Key, Matrix> > terms(noiseFactor->size());
+    for (size_t j = 0; j < noiseFactor->size(); ++j) {
+      terms[j].first = noiseFactor->keys()[j];
+      terms[j].second.swap(A[j]);
+    }
+    linear->push_back(boost::make_shared<JacobianFactor>(terms, b));
+  }
+
+  if (reweightOnly)
+    ++irlsAge_;
+  else
+    irlsAge_ = 0;
+  return linear;
+}
+
 /* ************************************************************************* */
 GaussianFactorGraph LevenbergMarquardtOptimizer::buildDampedSystem(
     const GaussianFactorGraph& linear, const VectorValues& sqrtHessianDiagonal) const {
@@ -133,14 +207,31 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
     cout << "trying lambda = " << currentState->lambda << endl;
 
   // Build damped system for this lambda (adds prior factors that make it like gradient descent)
-  auto dampedSystem = buildDampedSystem(linear, sqrtHessianDiagonal);
+  if (!cachedDampedSystemValid_) {
+    cachedDampedSystem_ = buildDampedSystem(linear, sqrtHessianDiagonal);
+    cachedDampedSystemValid_ = true;
+  } else {
+    // A retry within the same outer iteration: the undamped factors and, with
+    // diagonal damping, the Hessian diagonal are unchanged, so only the
+    // damping sigmas need updating for the new lambda.  Rescale them in place
+    // instead of rebuilding the graph and reallocating one prior per variable.
+    if (params_.verbosityLM >= LevenbergMarquardtParams::DAMPED)
+      cout << "reusing damped system, rescaling sigmas for lambda " << currentState->lambda << endl;
+    const double sigma = 1.0 / std::sqrt(currentState->lambda);
+    for (size_t i = linear.size(); i < cachedDampedSystem_.size(); ++i) {
+      JacobianFactor& damping = static_cast<JacobianFactor&>(*cachedDampedSystem_[i]);
+      damping.setModel(false, Vector::Constant(damping.rows(), sigma));
+    }
+  }
+  const GaussianFactorGraph& dampedSystem = cachedDampedSystem_;
 
   // Try solving
   double modelFidelity = 0.0;
   bool step_is_successful = false;
   bool stopSearchingLambda = false;
   double newError = numeric_limits<double>::infinity(), costChange;
-  Values newValues;
+  Values backup;
+  bool trialApplied = false;
   VectorValues delta;
 
   bool systemSolvedSuccessfully;
@@ -173,7 +264,12 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
       // update values
       gttic(retract);
       // ============ This is where the solution is updated ====================
-      newValues = currentState->values.retract(delta);
+      // The trial point is applied in place: the backup receives the original
+      // entries of only the changed variables, so a rejected step is undone
+      // by moving them back instead of discarding a full deep copy.
+      State* mutableState = static_cast<State*>(state_.get());
+      backup = mutableState->values.retractInPlace(delta);
+      trialApplied = true;
       // =======================================================================
       gttoc(retract);
 
@@ -181,7 +277,7 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
       gttic(compute_error);
       if (verbose)
         cout << "calculating error:" << endl;
-      newError = graph_.error(newValues);
+      newError = graph_.error(mutableState->values);
       gttoc(compute_error);
 
       if (verbose)
@@ -230,12 +326,23 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
   }
 
   if (step_is_successful) {
-    // we have successfully decreased the cost and we have good modelFidelity
-    // NOTE(frank): As we return immediately after this, we move the newValues
-    // TODO(frank): make Values actually support move. Does not seem to happen now.
-    state_ = currentState->decreaseLambda(params_, modelFidelity, std::move(newValues), newError);
+    // we have successfully decreased the cost and we have good modelFidelity.
+    // The state's values already hold the trial point, so move them into the
+    // new state as we return immediately after this.
+    State* mutableState = static_cast<State*>(state_.get());
+    state_ = currentState->decreaseLambda(params_, modelFidelity,
+        std::move(mutableState->values), newError);
     return true;
-  } else if (!stopSearchingLambda) {  // we failed to solved the system or had no decrease in cost
+  }
+
+  // The step was rejected (or we are stopping): move the original entries
+  // back so the state again holds the pre-trial values
+  if (trialApplied) {
+    State* mutableState = static_cast<State*>(state_.get());
+    mutableState->values.reinstate(backup);
+  }
+
+  if (!stopSearchingLambda) {  // we failed to solved the system or had no decrease in cost
     if (verbose)
       cout << "increasing lambda" << endl;
     State* modifiedState = static_cast<State*>(state_.get());
@@ -287,6 +394,10 @@ GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::iterate() {
     }
   }
 
+  // The damped system will be rebuilt on the first lambda attempt and then
+  // reused, with rescaled damping sigmas, by any retries
+  cachedDampedSystemValid_ = false;
+
   // Keep increasing lambda until we make make progress
   while (!tryLambda(*linear, sqrtHessianDiagonal)) {
     auto newState = static_cast<const State*>(state_.get());
@@ -38,6 +38,25 @@ protected:
   const LevenbergMarquardtParams params_; ///< LM parameters
   boost::posix_time::ptime startTime_;
 
+  /// Linear graph reused across iterations when params_.linearizeInPlace is set
+  mutable boost::shared_ptr<GaussianFactorGraph> reusedLinearGraph_;
+
+  /// Damped system reused across lambda retries within one outer iteration.
+  /// Only the damping sigmas depend on lambda, so retries rescale them in
+  /// place instead of rebuilding the graph; see tryLambda
+  GaussianFactorGraph cachedDampedSystem_;
+  bool cachedDampedSystemValid_;
+
+  /// Base-whitened Jacobian blocks of the robust factors, cached when
+  /// params_.irlsIterations > 0: reweighting-only iterations reuse them with
+  /// fresh residuals and robust weights instead of relinearizing.  Empty
+  /// entries mark factors that must always be fully relinearized
+  mutable std::vector<std::vector<Matrix> > irlsBaseJacobians_;
+
+  /// Reweighting-only iterations since the last full linearization, or -1
+  /// before the first one
+  mutable int irlsAge_;
+
   void initTime();
 
 public:
@@ -125,6 +144,10 @@ protected:
   const NonlinearOptimizerParams& _params() const override {
     return params_;
   }
+
+  /** IRLS-mode linearization: either a full relinearization that refills the
+   * robust Jacobian cache, or a cheap reweighting pass that reuses it */
+  GaussianFactorGraph::shared_ptr linearizeIRLS() const;
 };
 
 }
@@ -54,12 +54,16 @@ public:
   bool useFixedLambdaFactor; ///< if true applies constant increase (or decrease) to lambda according to lambdaFactor
   double minDiagonal; ///< when using diagonal damping saturates the minimum diagonal entries (default: 1e-6)
   double maxDiagonal; ///< when using diagonal damping saturates the maximum diagonal entries (default: 1e32)
+  bool linearizeInPlace; ///< if true, relinearize into the same GaussianFactorGraph each iteration, avoiding per-iteration allocation (default: false)
+  int irlsIterations; ///< number of cheap reweighting-only iterations between full relinearizations: robust factors keep their cached Jacobians and only refresh residuals and robust weights (default: 0, i.e. relinearize every iteration)
 
   LevenbergMarquardtParams()
       : verbosityLM(SILENT),
         diagonalDamping(false),
         minDiagonal(1e-6),
-        maxDiagonal(1e32) {
+        maxDiagonal(1e32),
+        linearizeInPlace(false),
+        irlsIterations(0) {
     SetLegacyDefaults(this);
   }
 
@@ -130,6 +134,8 @@ public:
   double getlambdaLowerBound() const { return lambdaLowerBound; }
   double getlambdaUpperBound() const { return lambdaUpperBound; }
   bool getUseFixedLambdaFactor() { return useFixedLambdaFactor; }
+  bool getLinearizeInPlace() const { return linearizeInPlace; }
+  int getIrlsIterations() const { return irlsIterations; }
   std::string getLogFile() const { return logFile; }
   std::string getVerbosityLM() const { return verbosityLMTranslator(verbosityLM);}
   
@@ -139,6 +145,8 @@ public:
   void setlambdaLowerBound(double value) { lambdaLowerBound = value; }
   void setlambdaUpperBound(double value) { lambdaUpperBound = value; }
   void setUseFixedLambdaFactor(bool flag) { useFixedLambdaFactor = flag;}
+  void setLinearizeInPlace(bool flag) { linearizeInPlace = flag; }
+  void setIrlsIterations(int value) { irlsIterations = value; }
   void setLogFile(const std::string& s) { logFile = s; }
   void setVerbosityLM(const std::string& s) { verbosityLM = verbosityLMTranslator(s);}
   // @}
@@ -130,6 +130,51 @@ Matrix Marginals::marginalCovariance(Key variable) const {
   return marginalInformation(variable).inverse();
 }
 
+/* ************************************************************************* */
+FastMap<Key, Matrix> Marginals::marginalCovariances(const KeyVector& variables) const {
+  gttic(marginalCovariances);
+  const GaussianFactorGraph::Eliminate function =
+      factorization_ == CHOLESKY ? GaussianFactorGraph::Eliminate(EliminatePreferCholesky)
+                                 : GaussianFactorGraph::Eliminate(EliminateQR);
+
+  // Group the requested keys by the clique that contains them, so each clique
+  // marginal is computed only once and shared by all its requested keys
+  FastMap<GaussianBayesTree::sharedClique, KeyVector> groupedByClique;
+  for(Key key: variables)
+    groupedByClique[bayesTree_.clique(key)].push_back(key);
+
+  FastMap<Key, Matrix> covariances;
+  for(const auto& group: groupedByClique) {
+    // Calculate or retrieve the clique marginal P(C) = P(F|S) P(S); the
+    // separator marginal P(S) is cached in the cliques, so cliques sharing an
+    // ancestor path share that shortcut work across the batch
+    GaussianFactorGraph cliqueMarginal = group.first->marginal2(function);
+
+    // Invert the joint information of the clique once; the marginal
+    // covariance of each requested key is its diagonal block
+    const Matrix augmentedInfo = cliqueMarginal.augmentedHessian();
+    const Matrix covariance = augmentedInfo
+        .topLeftCorner(augmentedInfo.rows() - 1, augmentedInfo.cols() - 1)
+        .inverse();
+
+    // The augmented Hessian is laid out in sorted key order, per Scatter
+    const Scatter scatter(cliqueMarginal);
+    DenseIndex offset = 0;
+    FastMap<Key, pair<DenseIndex, DenseIndex> > blocks;
+    for(const SlotEntry& entry: scatter) {
+      blocks[entry.key] = make_pair(offset, DenseIndex(entry.dimension));
+      offset += entry.dimension;
+    }
+
+    for(Key key: group.second) {
+      const pair<DenseIndex, DenseIndex>& block = blocks.at(key);
+      covariances[key] = covariance.block(block.first, block.first,
+                                          block.second, block.second);
+    }
+  }
+  return covariances;
+}
+
 /* ************************************************************************* */
 JointMarginal Marginals::jointMarginalCovariance(const KeyVector& variables) const {
   JointMarginal info = jointMarginalInformation(variables);
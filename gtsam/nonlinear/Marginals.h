@@ -113,6 +113,15 @@ public:
   /** Compute the marginal covariance of a single variable */
   Matrix marginalCovariance(Key variable) const;
 
+  /** Compute the marginal covariances of a batch of variables in one tree
+   * sweep.  The requested keys are grouped by the clique that contains them,
+   * each clique's joint covariance is computed once and shared by all its
+   * requested keys, and the separator marginal shortcuts cached in the
+   * cliques are shared across the whole batch.  Much faster than calling
+   * marginalCovariance() per key when querying many variables, e.g. all
+   * landmarks for data association. */
+  FastMap<Key, Matrix> marginalCovariances(const KeyVector& variables) const;
+
   /** Compute the joint marginal covariance of several variables */
   JointMarginal jointMarginalCovariance(const KeyVector& variables) const;
 
@@ -196,6 +205,7 @@ protected:
     blockMatrix_(dims, fullMatrix), keys_(keys), indices_(Ordering(keys).invert()) {}
 
   friend class Marginals;
+  friend class ISAM2;
 
 };
 
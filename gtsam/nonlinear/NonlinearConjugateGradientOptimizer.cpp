@@ -32,13 +32,11 @@ typedef internal::NonlinearOptimizerState State;
  * @brief Return the gradient vector of a nonlinear factor graph
  * @param nfg the graph
  * @param values a linearization point
- * Can be moved to NonlinearFactorGraph.h if desired
  */
 static VectorValues gradientInPlace(const NonlinearFactorGraph &nfg,
     const Values &values) {
-  // Linearize graph
-  GaussianFactorGraph::shared_ptr linear = nfg.linearize(values);
-  return linear->gradientAtZero();
+  // Evaluate the gradient directly; no linear factors are materialized
+  return nfg.gradientAt(values);
 }
 
 NonlinearConjugateGradientOptimizer::NonlinearConjugateGradientOptimizer(
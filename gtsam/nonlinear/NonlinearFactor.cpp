@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/linear/VectorValues.h>
 #include <boost/make_shared.hpp>
 #include <boost/format.hpp>
 
@@ -37,6 +38,14 @@ bool NonlinearFactor::equals(const NonlinearFactor& f, double tol) const {
   return Base::equals(f);
 }
 
+/* ************************************************************************* */
+void NonlinearFactor::addGradientAt(const Values& c, VectorValues& g) const {
+  GaussianFactor::shared_ptr linearized = linearize(c);
+  if (!linearized)
+    return;
+  g.addInPlace_(linearized->gradientAtZero());
+}
+
 /* ************************************************************************* */
 NonlinearFactor::shared_ptr NonlinearFactor::rekey(
     const std::map<Key, Key>& rekey_mapping) const {
@@ -163,6 +172,112 @@ boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
     return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
 }
 
+/* ************************************************************************* */
+boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
+    const Values& x, Arena& arena) const {
+
+  // Only linearize if the factor is active
+  if (!active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  // Call evaluate error to get Jacobians and RHS vector b
+  std::vector<Matrix> A(size());
+  Vector b = -unwhitenedError(x, A);
+  check(noiseModel_, b.size());
+
+  // Whiten the corresponding system now
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, b);
+
+  // Fill in terms, needed to create JacobianFactor below
+  std::vector<std::pair<Key, Matrix> > terms(size());
+  for (size_t j = 0; j < size(); ++j) {
+    terms[j].first = keys()[j];
+    terms[j].second.swap(A[j]);
+  }
+
+  // As in linearize(x) above, but the factor object and control block live in
+  // the arena.  Note the dense matrix payloads are still owned by Eigen.
+  ArenaAllocator<JacobianFactor> allocator(arena);
+  using noiseModel::Constrained;
+  if (noiseModel_ && noiseModel_->isConstrained())
+    return boost::allocate_shared<JacobianFactor>(allocator, terms, b,
+        boost::static_pointer_cast<Constrained>(noiseModel_)->unit());
+  else
+    return boost::allocate_shared<JacobianFactor>(allocator, terms, b);
+}
+
+/* ************************************************************************* */
+bool NoiseModelFactor::linearizeInPlace(const Values& x,
+    JacobianFactor& jacobian) const {
+
+  // An inactive factor cannot overwrite a previously active linearization
+  if (!active(x))
+    return false;
+
+  // The existing factor must involve exactly the same variables
+  if (jacobian.keys() != keys())
+    return false;
+
+  // Call evaluate error to get Jacobians and RHS vector b
+  std::vector<Matrix> A(size());
+  Vector b = -unwhitenedError(x, A);
+  check(noiseModel_, b.size());
+
+  // The block layout is fixed at the first linearization and must match
+  if ((DenseIndex)jacobian.rows() != b.size())
+    return false;
+  for (size_t j = 0; j < size(); ++j) {
+    if (jacobian.getDim(jacobian.begin() + j) != (DenseIndex)A[j].cols())
+      return false;
+  }
+
+  // Whiten the corresponding system now
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, b);
+
+  // Overwrite the existing matrices; no allocation happens here
+  for (size_t j = 0; j < size(); ++j)
+    jacobian.getA(jacobian.begin() + j) = A[j];
+  jacobian.getb() = b;
+
+  // Note the noise model stored in the factor (for a constrained model, its
+  // unit version) only depends on noiseModel_ and therefore stays valid.
+  return true;
+}
+
+/* ************************************************************************* */
+void NoiseModelFactor::addGradientAt(const Values& x, VectorValues& g) const {
+
+  // An inactive factor contributes nothing
+  if (!active(x))
+    return;
+
+  // Call evaluate error to get Jacobians and the error vector
+  std::vector<Matrix> A(size());
+  Vector e = unwhitenedError(x, A);
+  check(noiseModel_, e.size());
+
+  // Whiten the corresponding system now.  This matches what a linearized
+  // JacobianFactor would produce: for a plain Gaussian model the whitened b
+  // absorbs the full weighting, for a robust model WhitenSystem applies the
+  // sqrt loss weights, and for a constrained model the residual unit-sigma
+  // whitening done by JacobianFactor::gradientAtZero is the identity.
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, e);
+
+  // Accumulate g += A_j' * e per variable, avoiding a malloc if the key
+  // already exists in g
+  for (size_t j = 0; j < size(); ++j) {
+    const Key key = keys()[j];
+    auto it = g.find(key);
+    if (it != g.end())
+      it->second.noalias() += A[j].transpose() * e;
+    else
+      g.emplace(key, A[j].transpose() * e);
+  }
+}
+
 /* ************************************************************************* */
 
 } // \namespace gtsam
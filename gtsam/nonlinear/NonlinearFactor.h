@@ -23,12 +23,17 @@
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/UnaryJacobianFactor.h>
+#include <gtsam/linear/BinaryJacobianFactor.h>
 #include <gtsam/inference/Factor.h>
+#include <gtsam/base/Arena.h>
 #include <gtsam/base/OptionalJacobian.h>
 
 #include <boost/serialization/base_object.hpp>
 #include <boost/assign/list_of.hpp>
 
+#include <type_traits>
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
 #define ADD_CLONE_NONLINEAR_FACTOR(Derived) \
   virtual gtsam::NonlinearFactor::shared_ptr clone() const { \
@@ -40,6 +45,22 @@ namespace gtsam {
 
 using boost::assign::cref_list_of;
 
+namespace internal {
+
+/// The compile-time tangent dimension from traits, or Eigen::Dynamic for
+/// types whose traits only provide a run-time GetDimension.  Used to select
+/// the fixed-size linearize fast paths below without requiring every manifold
+/// type to declare a static dimension.
+template <typename T, typename = void>
+struct TraitsDimension : std::integral_constant<int, Eigen::Dynamic> {};
+
+template <typename T>
+struct TraitsDimension<T,
+    typename std::conditional<true, void, decltype(traits<T>::dimension)>::type>
+    : std::integral_constant<int, traits<T>::dimension> {};
+
+}  // namespace internal
+
 /* ************************************************************************* */
 
 /**
@@ -112,10 +133,51 @@ public:
    */
   virtual bool active(const Values& /*c*/) const { return true; }
 
+  /** The number of bytes of memory occupied by this factor.  The default
+   * reports only the base object and key storage, a lower bound for factors
+   * with owned measurement payloads; factors storing large measurements may
+   * override it.  The shared noise model of NoiseModelFactor is excluded,
+   * since noise models are typically interned across many factors. */
+  virtual size_t memoryUsage() const {
+    return sizeof(NonlinearFactor) + keys_.capacity() * sizeof(Key);
+  }
+
   /** linearize to a GaussianFactor */
   virtual boost::shared_ptr<GaussianFactor>
   linearize(const Values& c) const = 0;
 
+  /**
+   * Linearize, allocating the resulting factor from the given arena rather
+   * than from the heap.  The arena must outlive the returned factor, and is
+   * typically reset wholesale between optimizer iterations.  The default
+   * implementation falls back to the heap-allocating linearize() above.
+   */
+  virtual boost::shared_ptr<GaussianFactor>
+  linearize(const Values& c, Arena& /*arena*/) const {
+    return linearize(c);
+  }
+
+  /**
+   * Relinearize into an existing JacobianFactor, overwriting its matrices in
+   * place without any allocation.  Returns false if this factor cannot reuse
+   * the given factor (different structure, inactive, or not implemented), in
+   * which case the caller should fall back to linearize().  The default
+   * implementation always returns false.
+   */
+  virtual bool linearizeInPlace(const Values& /*c*/, JacobianFactor& /*jacobian*/) const {
+    return false;
+  }
+
+  /**
+   * Accumulate the gradient of this factor's error at the given values into
+   * g, inserting keys that are not yet present.  Gradient-only methods (e.g.
+   * nonlinear conjugate gradient) use this instead of building a full linear
+   * factor.  The default implementation linearizes and calls gradientAtZero;
+   * NoiseModelFactor overrides it with a direct evaluation that skips the
+   * JacobianFactor entirely.
+   */
+  virtual void addGradientAt(const Values& c, VectorValues& g) const;
+
   /**
    * Creates a shared_ptr clone of the factor - needs to be specialized to allow
    * for subclasses
@@ -251,6 +313,25 @@ public:
    */
   boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
 
+  /**
+   * Linearize, but place the JacobianFactor and its shared_ptr control block
+   * in the given arena instead of on the heap.  See NonlinearFactor::linearize.
+   */
+  boost::shared_ptr<GaussianFactor> linearize(const Values& x, Arena& arena) const;
+
+  /**
+   * Relinearize into an existing JacobianFactor with matching structure,
+   * overwriting its matrices in place.  See NonlinearFactor::linearizeInPlace.
+   */
+  bool linearizeInPlace(const Values& x, JacobianFactor& jacobian) const;
+
+  /**
+   * Accumulate the gradient \f$ A^T \Sigma^{-1} (h(x)-z) \f$ into g directly
+   * from the unwhitened Jacobians, without materializing a JacobianFactor.
+   * See NonlinearFactor::addGradientAt.
+   */
+  virtual void addGradientAt(const Values& x, VectorValues& g) const;
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
   /// @name Deprecated
   /// @{
@@ -336,8 +417,54 @@ public:
   virtual Vector evaluateError(const X& x, boost::optional<Matrix&> H =
       boost::none) const = 0;
 
+  // Bring in the arena overload hidden by the override below
+  using Base::linearize;
+
+  /** Linearize with a static-dimension fast path.  When the tangent dimension
+   *  of X is known at compile time (from traits) and the factor has a plain
+   *  whitening noise model of matching dimension - the PriorFactor-style case
+   *  - the whitened system is packed into a fixed-size UnaryJacobianFactor,
+   *  whose Hessian update during elimination is fully unrolled.  All other
+   *  cases take the generic NoiseModelFactor::linearize. */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    return linearizeImpl(x,
+        std::integral_constant<bool,
+            internal::TraitsDimension<X>::value != Eigen::Dynamic>());
+  }
+
 private:
 
+  /// Generic path, chosen at compile time when the dimension of X is dynamic
+  boost::shared_ptr<GaussianFactor> linearizeImpl(const Values& x,
+      std::false_type) const {
+    return Base::linearize(x);
+  }
+
+  /// Fixed-dimension path, only instantiated when the dimension of X is fixed
+  boost::shared_ptr<GaussianFactor> linearizeImpl(const Values& x,
+      std::true_type) const {
+    static const int N = traits<X>::dimension;
+    // The fast path needs a whitening-only noise model with as many rows as X
+    // has tangent dimensions; constrained and mismatching models (e.g. a
+    // lower-dimensional measurement) take the generic path.
+    if (!noiseModel_ || noiseModel_->isConstrained() ||
+        noiseModel_->dim() != size_t(N))
+      return Base::linearize(x);
+    if (!this->active(x))
+      return boost::shared_ptr<GaussianFactor>();
+    // Evaluate through unwhitenedError so subclasses that customize it (e.g.
+    // NonlinearEquality) keep their behavior, then whiten as in the generic
+    // path and pack the result into fixed-size storage.
+    std::vector<Matrix> A(1);
+    Vector b = -unwhitenedError(x, A);
+    if (b.size() != N)
+      throw std::invalid_argument(
+          "NoiseModelFactor1: NoiseModel length mismatches error vector.");
+    noiseModel_->WhitenSystem(A[0], b);
+    return boost::make_shared<UnaryJacobianFactor<N, N> >(keys_[0],
+        Eigen::Matrix<double, N, N>(A[0]), Eigen::Matrix<double, N, 1>(b));
+  }
+
   /** Serialization function */
   friend class boost::serialization::access;
   template<class ARCHIVE>
@@ -412,8 +539,57 @@ public:
   evaluateError(const X1&, const X2&, boost::optional<Matrix&> H1 =
       boost::none, boost::optional<Matrix&> H2 = boost::none) const = 0;
 
+  // Bring in the arena overload hidden by the override below
+  using Base::linearize;
+
+  /** Linearize with a static-dimension fast path.  When the tangent
+   *  dimensions of X1 and X2 are known at compile time (from traits) and the
+   *  factor has a plain whitening noise model with as many rows as X1 has
+   *  tangent dimensions - the BetweenFactor-style case - the whitened system
+   *  is packed into a fixed-size BinaryJacobianFactor, whose Hessian update
+   *  during elimination is fully unrolled.  All other cases take the generic
+   *  NoiseModelFactor::linearize. */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    return linearizeImpl(x,
+        std::integral_constant<bool,
+            internal::TraitsDimension<X1>::value != Eigen::Dynamic &&
+            internal::TraitsDimension<X2>::value != Eigen::Dynamic>());
+  }
+
 private:
 
+  /// Generic path, chosen at compile time when either dimension is dynamic
+  boost::shared_ptr<GaussianFactor> linearizeImpl(const Values& x,
+      std::false_type) const {
+    return Base::linearize(x);
+  }
+
+  /// Fixed-dimension path, only instantiated when both dimensions are fixed
+  boost::shared_ptr<GaussianFactor> linearizeImpl(const Values& x,
+      std::true_type) const {
+    static const int M = traits<X1>::dimension;
+    static const int N2 = traits<X2>::dimension;
+    // Constrained models and models whose dimension differs from that of X1
+    // (e.g. a scalar range measurement) take the generic path.
+    if (!noiseModel_ || noiseModel_->isConstrained() ||
+        noiseModel_->dim() != size_t(M))
+      return Base::linearize(x);
+    if (!this->active(x))
+      return boost::shared_ptr<GaussianFactor>();
+    // Evaluate through unwhitenedError so subclasses that customize it keep
+    // their behavior, then whiten as in the generic path and pack the result
+    // into fixed-size storage.
+    std::vector<Matrix> A(2);
+    Vector b = -unwhitenedError(x, A);
+    if (b.size() != M)
+      throw std::invalid_argument(
+          "NoiseModelFactor2: NoiseModel length mismatches error vector.");
+    noiseModel_->WhitenSystem(A[0], A[1], b);
+    return boost::make_shared<BinaryJacobianFactor<M, M, N2> >(keys_[0],
+        Eigen::Matrix<double, M, M>(A[0]), keys_[1],
+        Eigen::Matrix<double, M, N2>(A[1]), Eigen::Matrix<double, M, 1>(b));
+  }
+
   /** Serialization function */
   friend class boost::serialization::access;
   template<class ARCHIVE>
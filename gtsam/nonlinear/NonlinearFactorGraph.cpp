@@ -23,18 +23,29 @@
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/VariableIndex.h>
 #include <gtsam/inference/FactorGraph-inst.h>
 #include <gtsam/config.h> // for GTSAM_USE_TBB
 
 #ifdef GTSAM_USE_TBB
 #  include <tbb/parallel_for.h>
+#  include <tbb/parallel_reduce.h>
+#  include <tbb/partitioner.h>
+#  include <tbb/task_scheduler_init.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <limits>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 
@@ -48,6 +59,15 @@ double NonlinearFactorGraph::probPrime(const Values& values) const {
   return exp(-0.5 * error(values));
 }
 
+/* ************************************************************************* */
+size_t NonlinearFactorGraph::memoryUsage() const {
+  size_t result = sizeof(NonlinearFactorGraph) + factors_.capacity() * sizeof(sharedFactor);
+  for (const sharedFactor& factor: *this)
+    if (factor)
+      result += factor->memoryUsage();
+  return result;
+}
+
 /* ************************************************************************* */
 void NonlinearFactorGraph::print(const std::string& str, const KeyFormatter& keyFormatter) const {
   cout << str << "size: " << size() << endl << endl;
@@ -252,6 +272,22 @@ void NonlinearFactorGraph::saveGraph(std::ostream &stm, const Values& values,
 /* ************************************************************************* */
 double NonlinearFactorGraph::error(const Values& values) const {
   gttic(NonlinearFactorGraph_error);
+#ifdef GTSAM_USE_TBB
+  // Parallel reduction with a per-range accumulator. The deterministic
+  // variant always splits at the same grain size and joins the partial sums
+  // in the same order, so the result is reproducible run to run - plain
+  // parallel_reduce would make LM step acceptance depend on scheduling.
+  return tbb::parallel_deterministic_reduce(
+      tbb::blocked_range<size_t>(0, factors_.size(), 256), 0.0,
+      [this, &values](const tbb::blocked_range<size_t>& range, double sum) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+          if (factors_[i])
+            sum += factors_[i]->error(values);
+        }
+        return sum;
+      },
+      std::plus<double>());
+#else
   double total_error = 0.;
   // iterate over all the factors_ to accumulate the log probabilities
   for(const sharedFactor& factor: factors_) {
@@ -259,6 +295,192 @@ double NonlinearFactorGraph::error(const Values& values) const {
       total_error += factor->error(values);
   }
   return total_error;
+#endif
+}
+
+/* ************************************************************************* */
+const VariableIndex& NonlinearFactorGraph::variableIndex() const {
+  if (!cachedVariableIndex_)
+    cachedVariableIndex_ = boost::make_shared<VariableIndex>(*this);
+  return *cachedVariableIndex_;
+}
+
+/* ************************************************************************* */
+FactorIndices NonlinearFactorGraph::applyDelta(
+    const NonlinearFactorGraph& addedFactors,
+    const FactorIndices& removedFactorSlots) {
+  gttic(NonlinearFactorGraph_applyDelta);
+
+  // Collect the removed factors before nulling out their slots, as the
+  // variable index needs their keys to erase the right entries
+  NonlinearFactorGraph removedFactors;
+  removedFactors.reserve(removedFactorSlots.size());
+  for (const FactorIndex slot : removedFactorSlots)
+    removedFactors.push_back(at(slot));
+
+  // Update the cached index first, while it still matches the graph.  The
+  // cache pointer is shared by graph copies, so clone before mutating if
+  // someone else holds a reference.
+  if (cachedVariableIndex_) {
+    if (!cachedVariableIndex_.unique())
+      cachedVariableIndex_ = boost::make_shared<VariableIndex>(*cachedVariableIndex_);
+    cachedVariableIndex_->applyDelta(addedFactors, removedFactorSlots, removedFactors);
+  }
+
+  // Now apply the same edits to the graph itself
+  for (const FactorIndex slot : removedFactorSlots)
+    remove(slot);
+  FactorIndices newFactorIndices;
+  newFactorIndices.reserve(addedFactors.size());
+  for (const sharedFactor& factor : addedFactors) {
+    newFactorIndices.push_back(size());
+    push_back(factor); // null factors keep slots consistent with the index
+  }
+  return newFactorIndices;
+}
+
+/* ************************************************************************* */
+VariableIndex* NonlinearFactorGraph::mutableCachedVariableIndex() {
+  if (!cachedVariableIndex_)
+    return nullptr;
+  // The cache pointer is shared by graph copies, so clone before mutating if
+  // someone else holds a reference
+  if (!cachedVariableIndex_.unique())
+    cachedVariableIndex_ = boost::make_shared<VariableIndex>(*cachedVariableIndex_);
+  return cachedVariableIndex_.get();
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::checkpoint() {
+  journal_ = GraphEditJournal();
+  journal_->checkpointSize = size();
+}
+
+/* ************************************************************************* */
+const GraphEditJournal& NonlinearFactorGraph::editsSinceCheckpoint() const {
+  if (!journal_)
+    throw std::runtime_error(
+        "NonlinearFactorGraph::editsSinceCheckpoint: no checkpoint has been taken");
+  return *journal_;
+}
+
+/* ************************************************************************* */
+FactorIndex NonlinearFactorGraph::addJournaled(const sharedFactor& factor) {
+  if (!journal_)
+    throw std::runtime_error(
+        "NonlinearFactorGraph::addJournaled: no checkpoint has been taken");
+  const FactorIndex slot = size();
+  if (VariableIndex* index = mutableCachedVariableIndex()) {
+    NonlinearFactorGraph added;
+    added.push_back(factor);
+    index->augment(added);
+  }
+  push_back(factor);
+  journal_->addedSlots.push_back(slot);
+  return slot;
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::removeJournaled(FactorIndex slot) {
+  replaceJournaled(slot, sharedFactor());
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::replaceJournaled(FactorIndex slot, const sharedFactor& factor) {
+  if (!journal_)
+    throw std::runtime_error(
+        "NonlinearFactorGraph::replaceJournaled: no checkpoint has been taken");
+  const sharedFactor old = at(slot);
+
+  // Maintain the cached index first, while it still matches the graph
+  if (VariableIndex* index = mutableCachedVariableIndex()) {
+    const FactorIndices slots{slot};
+    NonlinearFactorGraph removed;
+    removed.push_back(old);
+    index->remove(slots.begin(), slots.end(), removed);
+    if (factor) {
+      NonlinearFactorGraph added;
+      added.push_back(factor);
+      index->augment(added, slots);
+    }
+  }
+  at(slot) = factor;
+
+  // A slot appended after the checkpoint is already journaled as added.  For
+  // pre-checkpoint slots the journal keeps the factor that occupied the slot
+  // at checkpoint time, so only the first edit of a slot records it.
+  if (slot < journal_->checkpointSize)
+    journal_->editedSlots.emplace(slot, old);
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::applyEditsTo(VariableIndex& variableIndex) const {
+  gttic(NonlinearFactorGraph_applyEditsTo);
+  const GraphEditJournal& journal = editsSinceCheckpoint();
+
+  // Erase the entries of the factors that occupied the edited slots at
+  // checkpoint time, and collect their replacements
+  FactorIndices editedSlots;
+  NonlinearFactorGraph removedFactors, replacements;
+  for (const auto& slot_factor : journal.editedSlots) {
+    editedSlots.push_back(slot_factor.first);
+    removedFactors.push_back(slot_factor.second);
+    replacements.push_back(at(slot_factor.first));
+  }
+  variableIndex.remove(editedSlots.begin(), editedSlots.end(), removedFactors);
+
+  // Index the replacement factors under their original slots, then the added
+  // factors under theirs
+  variableIndex.augment(replacements, editedSlots);
+  NonlinearFactorGraph added;
+  for (const FactorIndex slot : journal.addedSlots)
+    added.push_back(at(slot));
+  variableIndex.augment(added, journal.addedSlots);
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::linearizeEdits(const Values& linearizationPoint,
+    GaussianFactorGraph& linearFG) const {
+  gttic(NonlinearFactorGraph_linearizeEdits);
+  const GraphEditJournal& journal = editsSinceCheckpoint();
+
+  if (linearFG.size() != journal.checkpointSize && linearFG.size() != size())
+    throw std::invalid_argument(
+        "NonlinearFactorGraph::linearizeEdits: the linear graph does not match the checkpoint");
+
+  // Grow the linear graph to cover the slots added since the checkpoint
+  linearFG.resize(size());
+
+  // Relinearize only the slots the journal marks dirty; the remaining slots
+  // are assumed to be linearized at the same point already
+  for (const auto& slot_factor : journal.editedSlots) {
+    const sharedFactor& factor = at(slot_factor.first);
+    linearFG[slot_factor.first] =
+        factor ? factor->linearize(linearizationPoint) : GaussianFactor::shared_ptr();
+  }
+  for (const FactorIndex slot : journal.addedSlots) {
+    const sharedFactor& factor = at(slot);
+    linearFG[slot] =
+        factor ? factor->linearize(linearizationPoint) : GaussianFactor::shared_ptr();
+  }
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::editsAsUpdate(NonlinearFactorGraph& newFactors,
+    FactorIndices& removeFactorIndices) const {
+  const GraphEditJournal& journal = editsSinceCheckpoint();
+  for (const auto& slot_factor : journal.editedSlots) {
+    if (slot_factor.second)
+      removeFactorIndices.push_back(slot_factor.first);
+    const sharedFactor& replacement = at(slot_factor.first);
+    if (replacement)
+      newFactors.push_back(replacement);
+  }
+  for (const FactorIndex slot : journal.addedSlots) {
+    const sharedFactor& factor = at(slot);
+    if (factor)
+      newFactors.push_back(factor);
+  }
 }
 
 /* ************************************************************************* */
@@ -314,6 +536,27 @@ public:
     }
   }
 };
+
+// Linearizes chunks of factors cut at roughly equal estimated cost.  A smart
+// factor over dozens of cameras is orders of magnitude more expensive to
+// linearize than a binary odometry factor, so equal-count chunks leave most
+// threads idle while one of them grinds through the expensive factors.  The
+// chunk boundaries are precomputed from a cumulative cost estimate; TBB's
+// work-stealing scheduler balances whatever imbalance remains.
+class _LinearizeCostChunks {
+  const _LinearizeOneFactor& linearizeOne_;
+  const std::vector<size_t>& chunkStarts_;
+public:
+  _LinearizeCostChunks(const _LinearizeOneFactor& linearizeOne,
+      const std::vector<size_t>& chunkStarts) :
+      linearizeOne_(linearizeOne), chunkStarts_(chunkStarts) {
+  }
+  // Operator that linearizes a given range of the chunks
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    for (size_t c = blocked_range.begin(); c != blocked_range.end(); ++c)
+      linearizeOne_(tbb::blocked_range<size_t>(chunkStarts_[c], chunkStarts_[c + 1]));
+  }
+};
 #endif
 
 }
@@ -330,8 +573,38 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
 
   linearFG->resize(size());
   TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
-  tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
-    _LinearizeOneFactor(*this, linearizationPoint, *linearFG));
+  _LinearizeOneFactor linearizeOne(*this, linearizationPoint, *linearFG);
+
+  // Cut the factor range into chunks of roughly equal estimated cost, using
+  // the Jacobian area (error dimension x total variable dimension) as a cheap
+  // proxy for linearization cost.  See _LinearizeCostChunks above.
+  const size_t n = size();
+  std::vector<size_t> cumulativeCost(n);
+  size_t totalCost = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (factors_[i])
+      totalCost += 1 + factors_[i]->dim() * factors_[i]->size();
+    cumulativeCost[i] = totalCost;
+  }
+  const size_t numChunks = std::min<size_t>(n,
+      8 * static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()));
+  if (numChunks <= 1) {
+    linearizeOne(tbb::blocked_range<size_t>(0, n));
+  } else {
+    std::vector<size_t> chunkStarts;
+    chunkStarts.reserve(numChunks + 1);
+    chunkStarts.push_back(0);
+    for (size_t c = 1; c < numChunks; ++c) {
+      const size_t costBoundary = (totalCost * c) / numChunks;
+      const size_t boundary = std::upper_bound(cumulativeCost.begin(),
+          cumulativeCost.end(), costBoundary) - cumulativeCost.begin();
+      if (boundary > chunkStarts.back() && boundary < n)
+        chunkStarts.push_back(boundary);
+    }
+    chunkStarts.push_back(n);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, chunkStarts.size() - 1, 1),
+        _LinearizeCostChunks(linearizeOne, chunkStarts), tbb::simple_partitioner());
+  }
 
 #else
 
@@ -350,6 +623,196 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
   return linearFG;
 }
 
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(
+    const Values& linearizationPoint, Arena& arena) const
+{
+  gttic(NonlinearFactorGraph_linearize_arena);
+
+  // create an empty linear FG
+  GaussianFactorGraph::shared_ptr linearFG = boost::make_shared<GaussianFactorGraph>();
+  linearFG->reserve(size());
+
+  // linearize all factors, allocating from the arena (serial by design)
+  for(const sharedFactor& factor: factors_) {
+    if(factor) {
+      (*linearFG) += factor->linearize(linearizationPoint, arena);
+    } else
+    (*linearFG) += GaussianFactor::shared_ptr();
+  }
+
+  return linearFG;
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::linearizeInPlace(const Values& linearizationPoint,
+    GaussianFactorGraph& linearFG) const
+{
+  gttic(NonlinearFactorGraph_linearizeInPlace);
+
+  // First call, or the nonlinear graph changed size: allocate the layout
+  if (linearFG.size() != size()) {
+    linearFG = *linearize(linearizationPoint);
+    return;
+  }
+
+  for (size_t i = 0; i < size(); ++i) {
+    const sharedFactor& factor = factors_[i];
+    if (factor) {
+      GaussianFactor::shared_ptr& slot = linearFG[i];
+      JacobianFactor* jacobian = dynamic_cast<JacobianFactor*>(slot.get());
+      if (jacobian && factor->linearizeInPlace(linearizationPoint, *jacobian))
+        continue; // overwrote the existing matrices, no allocation
+      // Fall back for factors that do not produce a reusable JacobianFactor
+      slot = factor->linearize(linearizationPoint);
+    } else {
+      linearFG[i] = GaussianFactor::shared_ptr();
+    }
+  }
+}
+
+/* ************************************************************************* */
+GaussianBayesNet::shared_ptr NonlinearFactorGraph::linearizeAndEliminatePipelined(
+    const Values& linearizationPoint, const Ordering& ordering,
+    GaussianFactorGraph::shared_ptr* linearizedOutput) const
+{
+  gttic(NonlinearFactorGraph_linearizeAndEliminatePipelined);
+
+  // The elimination position of every variable
+  FastMap<Key, size_t> position;
+  for (size_t pos = 0; pos < ordering.size(); ++pos)
+    position.insert(std::make_pair(ordering[pos], pos));
+
+  // A factor is due when its first variable is eliminated; the producer
+  // linearizes factors in due order so early variables become ready first
+  const size_t notDue = std::numeric_limits<size_t>::max();
+  std::vector<size_t> due(size(), notDue);
+  for (size_t i = 0; i < size(); ++i) {
+    if (!factors_[i])
+      continue;
+    for (Key key : factors_[i]->keys()) {
+      FastMap<Key, size_t>::const_iterator item = position.find(key);
+      if (item == position.end())
+        throw std::invalid_argument(
+            "linearizeAndEliminatePipelined: ordering is missing variable " +
+            DefaultKeyFormatter(key));
+      due[i] = std::min(due[i], item->second);
+    }
+  }
+  std::vector<size_t> schedule;
+  schedule.reserve(size());
+  for (size_t i = 0; i < size(); ++i)
+    if (due[i] != notDue)
+      schedule.push_back(i);
+  std::stable_sort(schedule.begin(), schedule.end(),
+      [&due](size_t a, size_t b) { return due[a] < due[b]; });
+
+  // neededBy[pos]: how many scheduled factors must be produced before the
+  // variable at pos can be eliminated
+  std::vector<size_t> neededBy(ordering.size(), 0);
+  for (size_t s = 0; s < schedule.size(); ++s)
+    neededBy[due[schedule[s]]] = s + 1;
+  for (size_t pos = 1; pos < neededBy.size(); ++pos)
+    neededBy[pos] = std::max(neededBy[pos], neededBy[pos - 1]);
+
+  // The producer publishes linearized factors in schedule order
+  std::vector<GaussianFactor::shared_ptr> linearized(size());
+  std::mutex mutex;
+  std::condition_variable produced;
+  size_t producedCount = 0;
+  std::exception_ptr producerError;
+  std::thread producer([&]() {
+    try {
+      for (size_t idx : schedule) {
+        GaussianFactor::shared_ptr linearFactor =
+            factors_[idx]->linearize(linearizationPoint);
+        std::lock_guard<std::mutex> lock(mutex);
+        linearized[idx] = linearFactor;
+        ++producedCount;
+        produced.notify_one();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      producerError = std::current_exception();
+      produced.notify_one();
+    }
+  });
+
+  // The consumer eliminates one variable at a time, gathering each factor
+  // from the bucket of its first variable to be eliminated
+  GaussianBayesNet::shared_ptr bayesNet = boost::make_shared<GaussianBayesNet>();
+  std::vector<GaussianFactorGraph> buckets(ordering.size());
+  size_t nextScheduled = 0;
+  try {
+    for (size_t pos = 0; pos < ordering.size(); ++pos) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        produced.wait(lock, [&]() {
+          return producerError || producedCount >= neededBy[pos];
+        });
+        if (producerError)
+          std::rethrow_exception(producerError);
+      }
+      for (; nextScheduled < neededBy[pos]; ++nextScheduled)
+        buckets[pos].push_back(linearized[schedule[nextScheduled]]);
+      Ordering frontal;
+      frontal.push_back(ordering[pos]);
+      GaussianFactorGraph::EliminationResult eliminated =
+          GaussianFactorGraph::EliminationTraitsType::DefaultEliminate(buckets[pos], frontal);
+      buckets[pos] = GaussianFactorGraph();  // the gathered factors are consumed
+      bayesNet->push_back(eliminated.first);
+      if (eliminated.second && !eliminated.second->empty()) {
+        size_t joint = notDue;
+        for (Key key : eliminated.second->keys())
+          joint = std::min(joint, position.at(key));
+        buckets[joint].push_back(eliminated.second);
+      }
+    }
+  } catch (...) {
+    producer.join();
+    throw;
+  }
+  producer.join();
+
+  if (linearizedOutput) {
+    *linearizedOutput = boost::make_shared<GaussianFactorGraph>();
+    (*linearizedOutput)->push_back(linearized.begin(), linearized.end());
+  }
+
+  return bayesNet;
+}
+
+/* ************************************************************************* */
+VectorValues NonlinearFactorGraph::gradientAt(const Values& values) const {
+  gttic(NonlinearFactorGraph_gradientAt);
+#ifdef GTSAM_USE_TBB
+  // Sum the per-factor gradient contributions with a deterministic tree
+  // reduction, as in GaussianFactorGraph::gradientAtZero: each range
+  // accumulates into its own VectorValues and the partials are merged with
+  // addInPlace_, so the result is reproducible across runs and thread counts.
+  return tbb::parallel_deterministic_reduce(
+      tbb::blocked_range<size_t>(0, size(), 16), VectorValues(),
+      [this, &values](const tbb::blocked_range<size_t>& range, VectorValues g) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+          if (factors_[i])
+            factors_[i]->addGradientAt(values, g);
+        }
+        return g;
+      },
+      [](VectorValues a, const VectorValues& b) {
+        a.addInPlace_(b);
+        return a;
+      });
+#else
+  VectorValues g;
+  for (const sharedFactor& factor : factors_) {
+    if (factor)
+      factor->addGradientAt(values, g);
+  }
+  return g;
+#endif
+}
+
 /* ************************************************************************* */
 static Scatter scatterFromValues(const Values& values) {
   gttic(scatterFromValues);
@@ -465,6 +928,70 @@ NonlinearFactorGraph NonlinearFactorGraph::rekey(const std::map<Key,Key>& rekey_
   return result;
 }
 
+/* ************************************************************************* */
+FastVector<size_t> NonlinearFactorGraph::localityOrder() const {
+  gttic(NonlinearFactorGraph_localityOrder);
+  const size_t n = size();
+  const VariableIndex variableIndex(*this);
+
+  // Key count serves as the degree proxy Cuthill-McKee orders neighbors by
+  std::vector<bool> visited(n, false);
+  auto keyCount = [this](size_t i) { return factors_[i]->keys().size(); };
+
+  FastVector<size_t> order;
+  order.reserve(n);
+  std::deque<size_t> queue;
+  for (size_t start = 0; start < n; ++start) {
+    // Null factors go last; every other factor seeds its own component,
+    // lowest key count first within the insertion-order sweep
+    if (visited[start] || !factors_[start])
+      continue;
+    size_t seed = start;
+    for (size_t i = start + 1; i < n; ++i)
+      if (!visited[i] && factors_[i] && keyCount(i) < keyCount(seed))
+        seed = i;
+    visited[seed] = true;
+    queue.push_back(seed);
+    while (!queue.empty()) {
+      const size_t current = queue.front();
+      queue.pop_front();
+      order.push_back(current);
+      // Gather the unvisited factors sharing a variable with this one
+      FastVector<size_t> neighbors;
+      for (Key key : *factors_[current]) {
+        for (size_t neighbor : variableIndex[key]) {
+          if (!visited[neighbor] && factors_[neighbor]) {
+            visited[neighbor] = true;
+            neighbors.push_back(neighbor);
+          }
+        }
+      }
+      std::sort(neighbors.begin(), neighbors.end(),
+          [&keyCount](size_t a, size_t b) {
+            return keyCount(a) != keyCount(b) ? keyCount(a) < keyCount(b) : a < b;
+          });
+      queue.insert(queue.end(), neighbors.begin(), neighbors.end());
+    }
+  }
+  std::reverse(order.begin(), order.end());
+
+  // Append the null factors, preserving their relative order
+  for (size_t i = 0; i < n; ++i)
+    if (!factors_[i])
+      order.push_back(i);
+  return order;
+}
+
+/* ************************************************************************* */
+void NonlinearFactorGraph::reorderForLocality() {
+  const FastVector<size_t> order = localityOrder();
+  FastVector<sharedFactor> reordered;
+  reordered.reserve(order.size());
+  for (size_t i : order)
+    reordered.push_back(factors_[i]);
+  factors_.swap(reordered);
+}
+
 /* ************************************************************************* */
 
 } // namespace gtsam
@@ -27,6 +27,7 @@
 #include <gtsam/nonlinear/PriorFactor.h>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/optional.hpp>
 #include <functional>
 
 namespace gtsam {
@@ -35,7 +36,9 @@ namespace gtsam {
   class Values;
   class Ordering;
   class GaussianFactorGraph;
+  class GaussianBayesNet;
   class SymbolicFactorGraph;
+  class VariableIndex;
   template<typename T>
   class Expression;
   template<typename T>
@@ -67,6 +70,31 @@ namespace gtsam {
   };
 
 
+  /**
+   * Record of the edits made to a NonlinearFactorGraph since a checkpoint,
+   * maintained by NonlinearFactorGraph::checkpoint() and the journaled
+   * mutators.  Downstream consumers read it to touch only the factor slots
+   * that actually changed, instead of re-deriving the change set (or assuming
+   * everything changed) at every stage of the pipeline.
+   */
+  struct GTSAM_EXPORT GraphEditJournal {
+    /// Graph size when the checkpoint was taken; slots at or beyond this
+    /// were appended since and are listed in addedSlots
+    size_t checkpointSize;
+    /// Slots appended since the checkpoint, in order (a slot stays listed
+    /// here even if the added factor is removed again, so consumers still
+    /// grow their layouts to cover it)
+    FactorIndices addedSlots;
+    /// Pre-checkpoint slots that were removed or replaced, mapped to the
+    /// factor that occupied the slot at checkpoint time (needed to erase
+    /// its keys from a VariableIndex built at the checkpoint)
+    FastMap<FactorIndex, boost::shared_ptr<NonlinearFactor> > editedSlots;
+
+    GraphEditJournal() : checkpointSize(0) {}
+    bool empty() const { return addedSlots.empty() && editedSlots.empty(); }
+    void clear() { addedSlots.clear(); editedSlots.clear(); }
+  };
+
   /**
    * A non-linear factor graph is a graph of non-Gaussian, i.e. non-linear factors,
    * which derive from NonlinearFactor. The values structures are typically (in SAM) more general
@@ -122,11 +150,106 @@ namespace gtsam {
     /** Unnormalized probability. O(n) */
     double probPrime(const Values& values) const;
 
+    /** The number of bytes of memory occupied by this graph: the
+     * factor-pointer array plus the footprint each factor reports through
+     * NonlinearFactor::memoryUsage(), which is a lower bound for factors
+     * that do not override it (\f$ O(n) \f$). */
+    size_t memoryUsage() const;
+
     /**
      * Create a symbolic factor graph
      */
     boost::shared_ptr<SymbolicFactorGraph> symbolic() const;
 
+    /**
+     * Return a VariableIndex for this graph, built lazily and cached.  The
+     * cache stays valid as long as the graph is only edited through
+     * applyDelta(); after any other mutation call invalidateVariableIndex()
+     * to force a rebuild on the next access.
+     */
+    const VariableIndex& variableIndex() const;
+
+    /// Discard the cached VariableIndex, forcing a rebuild on next access
+    void invalidateVariableIndex() const { cachedVariableIndex_.reset(); }
+
+    /**
+     * Edit the graph in place, appending \c addedFactors and nulling out the
+     * slots in \c removedFactorSlots, while incrementally maintaining the
+     * cached VariableIndex (if one has been built) instead of rebuilding it
+     * from scratch.  Intended for streaming front-ends that change a handful
+     * of factors between solves.
+     * @return the factor indices assigned to the added factors
+     */
+    FactorIndices applyDelta(const NonlinearFactorGraph& addedFactors,
+        const FactorIndices& removedFactorSlots = FactorIndices());
+
+    /**
+     * @name Edit journal
+     * Dirty-region tracking for graphs edited in place between solves.  After
+     * checkpoint(), edit the graph only through the journaled mutators below;
+     * the journal then records exactly which slots were added, removed or
+     * replaced, and the consumers applyEditsTo() and linearizeEdits() update
+     * a VariableIndex or GaussianFactorGraph built at the checkpoint by
+     * touching only those slots.  The journal is transient state, like the
+     * cached VariableIndex, and is not serialized.
+     */
+    /// @{
+
+    /// Start (or restart) journaling edits, with the current graph as baseline
+    void checkpoint();
+
+    /// Whether a checkpoint has been taken
+    bool journaling() const { return bool(journal_); }
+
+    /// The edits made since checkpoint() was last called.  Throws
+    /// std::runtime_error if no checkpoint has been taken.
+    const GraphEditJournal& editsSinceCheckpoint() const;
+
+    /**
+     * Append a factor, recording the new slot in the journal.  Like
+     * applyDelta(), incrementally maintains the cached VariableIndex.
+     * @return the slot assigned to the factor
+     */
+    FactorIndex addJournaled(const sharedFactor& factor);
+
+    /// Null out a slot, recording the removal in the journal
+    void removeJournaled(FactorIndex slot);
+
+    /// Replace the factor in a slot, recording the edit in the journal
+    void replaceJournaled(FactorIndex slot, const sharedFactor& factor);
+
+    /**
+     * Apply the journaled edits to a VariableIndex built when checkpoint()
+     * was called, erasing the entries of removed and replaced factors and
+     * indexing their replacements and the added factors under their slots.
+     * Cost is proportional to the number of edits, not the graph size.
+     */
+    void applyEditsTo(VariableIndex& variableIndex) const;
+
+    /**
+     * Relinearize only the journaled slots of a GaussianFactorGraph produced
+     * by linearize() or linearizeInPlace() when checkpoint() was called,
+     * growing it to cover slots added since.  The remaining slots are left
+     * untouched, so this is only valid while the linearization point of the
+     * unedited factors is unchanged.  Throws std::invalid_argument if the
+     * linear graph does not match the checkpoint.
+     */
+    void linearizeEdits(const Values& linearizationPoint,
+        GaussianFactorGraph& linearFG) const;
+
+    /**
+     * Express the journaled edits as an ISAM2-style update, appending the
+     * replacement and added factors to \c newFactors and the slots of removed
+     * and replaced factors to \c removeFactorIndices.  Valid when the
+     * front-end keeps this graph in step with ISAM2::getFactorsUnsafe() so
+     * that slots coincide with ISAM2 factor indices; the pair then feeds
+     * straight into ISAM2::update().
+     */
+    void editsAsUpdate(NonlinearFactorGraph& newFactors,
+        FactorIndices& removeFactorIndices) const;
+
+    /// @}
+
     /**
      * Compute a fill-reducing ordering using COLAMD.
      */
@@ -145,6 +268,60 @@ namespace gtsam {
     /// Linearize a nonlinear factor graph
     boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint) const;
 
+    /**
+     * Linearize a nonlinear factor graph, allocating the linear factors from
+     * the given arena.  Intended for optimizer loops that linearize the same
+     * graph every iteration: reset the arena between iterations to reclaim
+     * all factor memory at once instead of freeing factors one by one.  The
+     * arena must outlive the returned graph.  This path is serial, since a
+     * single arena cannot be bumped from multiple threads.
+     */
+    boost::shared_ptr<GaussianFactorGraph> linearize(
+        const Values& linearizationPoint, Arena& arena) const;
+
+    /**
+     * Relinearize into an existing GaussianFactorGraph, overwriting the
+     * matrices of factors that keep the same structure in place.  On the
+     * first call (or whenever the graph size changes) this allocates the
+     * layout exactly like linearize(); on subsequent calls no per-factor
+     * allocation happens for factors supporting linearizeInPlace().  The
+     * caller must own linearFG exclusively: any factor pointers shared from
+     * a previous iteration will see their matrices change.
+     */
+    void linearizeInPlace(const Values& linearizationPoint,
+        GaussianFactorGraph& linearFG) const;
+
+    /**
+     * Linearize and eliminate in one overlapped pass: a producer thread
+     * linearizes the factors while the calling thread eliminates variables
+     * whose factors are already available, so elimination of early-ordered
+     * variables does not wait for the whole graph to be linearized.  Factors
+     * are linearized in the order their first variable is eliminated, and
+     * elimination of each variable in \c ordering begins as soon as every
+     * factor due at that variable has been produced.  Uses the default dense
+     * elimination function; produces the same Bayes net as
+     * linearize(values)->eliminateSequential(ordering).
+     *
+     * @param linearizationPoint The values to linearize around
+     * @param ordering The elimination ordering, which must cover every
+     * variable in the graph (std::invalid_argument otherwise)
+     * @param linearizedOutput If given, receives the linearized factors in
+     * graph order, e.g. for error evaluation or damped retries
+     */
+    boost::shared_ptr<GaussianBayesNet> linearizeAndEliminatePipelined(
+        const Values& linearizationPoint, const Ordering& ordering,
+        boost::shared_ptr<GaussianFactorGraph>* linearizedOutput = nullptr) const;
+
+    /**
+     * Compute the gradient of the total error at the given values, i.e.
+     * \f$ \sum_i A_i^T \Sigma_i^{-1} (h_i(x)-z_i) \f$, without building a
+     * GaussianFactorGraph.  Equivalent to
+     * linearize(values)->gradientAtZero() but with roughly a third of the
+     * memory traffic, since no JacobianFactors are materialized.  Intended
+     * for gradient-only methods such as nonlinear conjugate gradient.
+     */
+    VectorValues gradientAt(const Values& values) const;
+
     /// typdef for dampen functions used below
     typedef std::function<void(const boost::shared_ptr<HessianFactor>& hessianFactor)> Dampen;
 
@@ -193,6 +370,26 @@ namespace gtsam {
      */
     NonlinearFactorGraph rekey(const std::map<Key,Key>& rekey_mapping) const;
 
+    /**
+     * Compute a permutation of the factor indices that clusters factors
+     * sharing variables, by reverse Cuthill-McKee over the factor adjacency
+     * induced by the VariableIndex.  Iterating factors in this order makes
+     * consecutive factors touch overlapping sets of variables, improving
+     * Values access locality in iteration-heavy passes such as error() and
+     * linearize(); insertion order often interleaves unrelated factors.
+     * Null factors are placed last.
+     */
+    FastVector<size_t> localityOrder() const;
+
+    /**
+     * Permute the factors in place into localityOrder().  The graph holds
+     * the same factors afterwards, only their iteration order changes; call
+     * once before repeated error() or linearize() passes.  Note that factor
+     * indices change, so apply before anything that records them (e.g. a
+     * VariableIndex or ISAM2).
+     */
+    void reorderForLocality();
+
     /**
      * Directly add ExpressionFactor that implements |h(x)-z|^2_R
      * @param h expression that implements measurement function
@@ -234,6 +431,17 @@ namespace gtsam {
 
   private:
 
+    /// Cached VariableIndex, built lazily by variableIndex() and maintained
+    /// incrementally by applyDelta().  Not serialized.
+    mutable boost::shared_ptr<VariableIndex> cachedVariableIndex_;
+
+    /// Edits recorded since checkpoint(), if journaling.  Not serialized.
+    boost::optional<GraphEditJournal> journal_;
+
+    /// Clone-if-shared access to the cached VariableIndex, or nullptr if none
+    /// has been built yet
+    VariableIndex* mutableCachedVariableIndex();
+
     /**
      * Linearize from Scatter rather than from Ordering.  Made private because
      *  it doesn't include gttic.
@@ -26,10 +26,16 @@
 #include <gtsam/linear/VectorValues.h>
 
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/task_arena.h>
+#endif
 
 #include <boost/algorithm/string.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <chrono>
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
@@ -88,20 +94,35 @@ void NonlinearOptimizer::defaultOptimize() {
   }
 
   // Iterative loop
-  do {
-    // Do next iteration
-    currentError = error();
-    iterate();
-    tictoc_finishedIteration();
-
-    // Maybe show output
-    if (params.verbosity >= NonlinearOptimizerParams::VALUES)
-      values().print("newValues");
-    if (params.verbosity >= NonlinearOptimizerParams::ERROR)
-      cout << "newError: " << error() << endl;
-  } while (iterations() < params.maxIterations &&
-           !checkConvergence(params.relativeErrorTol, params.absoluteErrorTol, params.errorTol,
-                             currentError, error(), params.verbosity) && std::isfinite(currentError));
+  auto iterativeLoop = [&]() {
+    do {
+      // Do next iteration
+      currentError = error();
+      iterate();
+      tictoc_finishedIteration();
+
+      // Maybe show output
+      if (params.verbosity >= NonlinearOptimizerParams::VALUES)
+        values().print("newValues");
+      if (params.verbosity >= NonlinearOptimizerParams::ERROR)
+        cout << "newError: " << error() << endl;
+    } while (iterations() < params.maxIterations &&
+             !checkConvergence(params.relativeErrorTol, params.absoluteErrorTol, params.errorTol,
+                               currentError, error(), params.verbosity) && std::isfinite(currentError));
+  };
+
+#ifdef GTSAM_USE_TBB
+  if (params.numThreads > 0) {
+    // Limit all TBB parallelism inside the loop (linearization, elimination)
+    // to the requested number of worker threads
+    tbb::task_arena arena(params.numThreads);
+    arena.execute(iterativeLoop);
+  } else {
+    iterativeLoop();
+  }
+#else
+  iterativeLoop();
+#endif
 
   // Printing if verbose
   if (params.verbosity >= NonlinearOptimizerParams::TERMINATION) {
@@ -123,6 +144,63 @@ const Values& NonlinearOptimizer::optimizeSafely() {
   }
 }
 
+/* ************************************************************************* */
+Values NonlinearOptimizer::optimizeForDeadline(double deadlineSeconds,
+                                               const KeyVector& priorityKeys) {
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point start = Clock::now();
+  auto secondsLeft = [&]() {
+    return deadlineSeconds
+        - std::chrono::duration<double>(Clock::now() - start).count();
+  };
+
+  const NonlinearOptimizerParams& params = _params();
+  if (error() <= params.errorTol)
+    return values();
+
+  // Run whole iterations while the next one is expected to fit in the
+  // remaining budget, using the duration of the last one as the estimate.
+  double lastIterationTime = 0.0;
+  while (iterations() < params.maxIterations
+      && secondsLeft() > lastIterationTime) {
+    const double currentError = error();
+    const Clock::time_point iterationStart = Clock::now();
+    iterate();
+    tictoc_finishedIteration();
+    lastIterationTime =
+        std::chrono::duration<double>(Clock::now() - iterationStart).count();
+    if (checkConvergence(params.relativeErrorTol, params.absoluteErrorTol,
+        params.errorTol, currentError, error(), params.verbosity)
+        || !std::isfinite(currentError))
+      return values();
+  }
+
+  // Out of budget before convergence. If about half an iteration remains we
+  // can still improve the estimate: the linear solve is the bulk of an
+  // iteration, and applying its delta to only the highest-priority variables
+  // is cheap, in the spirit of iSAM2's partial wildfire updates.
+  if (secondsLeft() < 0.5 * lastIterationTime)
+    return values();
+  const GaussianFactorGraph::shared_ptr linear = graph_.linearize(values());
+  const VectorValues delta = solve(*linear, params);
+
+  // Apply the delta in priority order until the deadline; variables not
+  // reached keep their current values (retract ignores missing entries).
+  VectorValues partial;
+  for (Key key : priorityKeys) {
+    if (secondsLeft() <= 0.0) break;
+    if (delta.exists(key) && !partial.exists(key))
+      partial.insert(key, delta.at(key));
+  }
+  for (const VectorValues::KeyValuePair& v : delta) {
+    if (secondsLeft() <= 0.0) break;
+    if (!partial.exists(v.first))
+      partial.insert(v.first, v.second);
+  }
+  const Values candidate = values().retract(partial);
+  return graph_.error(candidate) < error() ? candidate : values();
+}
+
 /* ************************************************************************* */
 VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
                                        const NonlinearOptimizerParams& params) const {
@@ -105,6 +105,19 @@ public:
    */
   const Values& optimizeSafely();
 
+  /**
+   * Anytime variant of optimize(): iterate only while the wall-clock budget
+   * (in seconds) allows, and return the best estimate available at the
+   * deadline instead of running to convergence.  Whole iterations are run as
+   * long as one is expected to fit in the remaining budget; any remainder is
+   * spent on a final linear solve whose delta is applied partially, in the
+   * order given by priorityKeys (remaining variables follow, and keep their
+   * current values if the deadline cuts the update short).  The returned
+   * estimate never has higher error than the optimizer state it started from.
+   */
+  Values optimizeForDeadline(double deadlineSeconds,
+                             const KeyVector& priorityKeys = KeyVector());
+
   /// return error
   double error() const;
 
@@ -44,11 +44,12 @@ public:
   double errorTol; ///< The maximum total error to stop iterating (default 0.0)
   Verbosity verbosity; ///< The printing verbosity during optimization (default SILENT)
   Ordering::OrderingType orderingType; ///< The method of ordering use during variable elimination (default COLAMD)
+  int numThreads; ///< Maximum number of worker threads used during optimization, 0 = automatic (default 0, only effective when GTSAM is built with TBB)
 
   NonlinearOptimizerParams() :
       maxIterations(100), relativeErrorTol(1e-5), absoluteErrorTol(1e-5), errorTol(
           0.0), verbosity(SILENT), orderingType(Ordering::COLAMD),
-          linearSolverType(MULTIFRONTAL_CHOLESKY) {}
+          numThreads(0), linearSolverType(MULTIFRONTAL_CHOLESKY) {}
 
   virtual ~NonlinearOptimizerParams() {
   }
@@ -59,6 +60,7 @@ public:
   double getAbsoluteErrorTol() const { return absoluteErrorTol; }
   double getErrorTol() const { return errorTol; }
   std::string getVerbosity() const { return verbosityTranslator(verbosity); }
+  int getNumThreads() const { return numThreads; }
 
   void setMaxIterations(int value) { maxIterations = value; }
   void setRelativeErrorTol(double value) { relativeErrorTol = value; }
@@ -67,6 +69,7 @@ public:
   void setVerbosity(const std::string& src) {
     verbosity = verbosityTranslator(src);
   }
+  void setNumThreads(int value) { numThreads = value; }
 
   static Verbosity verbosityTranslator(const std::string &s) ;
   static std::string verbosityTranslator(Verbosity value) ;
@@ -0,0 +1,141 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TypedFactorGraphView.h
+ * @brief   Statically typed view over the homogeneous part of a factor graph
+ * @author  Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+
+#include <boost/make_shared.hpp>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A contiguous array of factors of one concrete type. Unlike a
+ * NonlinearFactorGraph, which stores shared pointers to the abstract base
+ * and pays an indirect call per factor, the factors here are stored by
+ * value and error/linearize are resolved at compile time: the qualified
+ * calls below bypass the vtable, so the compiler can inline the factor
+ * math and the iteration touches memory sequentially.
+ */
+template<class FACTOR>
+class TypedFactorArray {
+
+ public:
+
+  typedef std::vector<FACTOR, Eigen::aligned_allocator<FACTOR> > Factors;
+
+ private:
+
+  Factors factors_;
+
+ public:
+
+  /// Append a factor, copied into contiguous storage
+  void push_back(const FACTOR& factor) {
+    factors_.push_back(factor);
+  }
+
+  /// Number of factors in the array
+  size_t size() const {
+    return factors_.size();
+  }
+
+  /// Read access to the underlying contiguous storage
+  const Factors& factors() const {
+    return factors_;
+  }
+
+  /// Unnormalized error, summed over all factors with static dispatch
+  double error(const Values& values) const {
+    double total = 0.0;
+    for (const FACTOR& factor : factors_)
+      total += factor.FACTOR::error(values);
+    return total;
+  }
+
+  /// Linearize all factors, appending to the given linear graph
+  void linearize(const Values& values, GaussianFactorGraph& linearGraph) const {
+    for (const FACTOR& factor : factors_)
+      linearGraph.push_back(factor.FACTOR::linearize(values));
+  }
+};
+
+/**
+ * A view of a NonlinearFactorGraph that peels the factors of one concrete
+ * type off into a TypedFactorArray and keeps the remaining factors in a
+ * regular, virtually dispatched graph. In pose-graph workloads nearly all
+ * factors share one or two types, so iterating the homogeneous section
+ * with static dispatch removes the indirect call and pointer chase per
+ * factor from error and linearize. Views for several types can be nested
+ * by constructing a second view from rest().
+ *
+ * The view copies the factors at construction: it reflects the graph as it
+ * was, and factors added to the graph later are not seen. In the linearized
+ * graph the typed factors come first, followed by the remainder.
+ */
+template<class FACTOR>
+class TypedFactorGraphView {
+
+ private:
+
+  TypedFactorArray<FACTOR> typed_; ///< factors of type FACTOR, stored contiguously
+  NonlinearFactorGraph rest_; ///< all other factors, virtually dispatched
+
+ public:
+
+  /// Partition the given graph into typed factors and the remainder
+  explicit TypedFactorGraphView(const NonlinearFactorGraph& graph) {
+    for (const boost::shared_ptr<NonlinearFactor>& factor : graph) {
+      if (!factor)
+        continue;
+      if (const FACTOR* typed = dynamic_cast<const FACTOR*>(factor.get()))
+        typed_.push_back(*typed);
+      else
+        rest_.push_back(factor);
+    }
+  }
+
+  /// The homogeneous section
+  const TypedFactorArray<FACTOR>& typed() const {
+    return typed_;
+  }
+
+  /// The factors not of type FACTOR
+  const NonlinearFactorGraph& rest() const {
+    return rest_;
+  }
+
+  /// Unnormalized error of all factors, matching NonlinearFactorGraph::error
+  double error(const Values& values) const {
+    return typed_.error(values) + rest_.error(values);
+  }
+
+  /// Linearize all factors, typed section first
+  boost::shared_ptr<GaussianFactorGraph> linearize(const Values& values) const {
+    boost::shared_ptr<GaussianFactorGraph> linearGraph = //
+        boost::make_shared<GaussianFactorGraph>();
+    linearGraph->reserve(typed_.size() + rest_.size());
+    typed_.linearize(values, *linearGraph);
+    for (const boost::shared_ptr<NonlinearFactor>& factor : rest_)
+      linearGraph->push_back(factor->linearize(values));
+    return linearGraph;
+  }
+};
+
+} // \ namespace gtsam
@@ -24,9 +24,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <utility>
 
 #include <gtsam/nonlinear/Values.h> // Only so Eclipse finds class definition
+#include <gtsam/linear/VectorValues.h> // For the typed retract below
 
 namespace gtsam {
 
@@ -353,6 +355,48 @@ namespace gtsam {
     return h(j,item->second);
   }
 
+  /* ************************************************************************* */
+  template<typename ValueType>
+  void Values::extract(const KeyVector& keys, std::vector<ValueType>& output) const {
+    output.clear();
+    output.reserve(keys.size());
+    auto h = internal::handle<ValueType>();
+    if (std::is_sorted(keys.begin(), keys.end())) {
+      // Locate all requested keys in one merge pass over the sorted container
+      KeyValueMap::const_iterator item = values_.begin();
+      for (Key key : keys) {
+        while (item != values_.end() && item->first < key)
+          ++item;
+        if (item == values_.end() || item->first != key)
+          throw ValuesKeyDoesNotExist("extract", key);
+        output.push_back(h(key, item->second));
+      }
+    } else {
+      // Unsorted keys fall back to one lookup per key
+      for (Key key : keys) {
+        KeyValueMap::const_iterator item = values_.find(key);
+        if (item == values_.end())
+          throw ValuesKeyDoesNotExist("extract", key);
+        output.push_back(h(key, item->second));
+      }
+    }
+  }
+
+  /* ************************************************************************* */
+  template<typename ValueType>
+  Values::Handle<ValueType> Values::handle(Key j) const {
+    KeyValueMap::const_iterator item = values_.find(j);
+    if (item == values_.end())
+      throw ValuesKeyDoesNotExist("handle", j);
+    const GenericValue<ValueType>* generic =
+        dynamic_cast<const GenericValue<ValueType>*>(item->second);
+    if (!generic) {
+      const Value* value = item->second;
+      throw ValuesIncorrectType(j, typeid(*value), typeid(ValueType));
+    }
+    return Handle<ValueType>(&generic->value());
+  }
+
   /* ************************************************************************* */
   template<typename ValueType>
   boost::optional<const ValueType&> Values::exists(Key j) const {
@@ -388,4 +432,57 @@ namespace gtsam {
     update(j, static_cast<const Value&>(GenericValue<ValueType>(val)));
   }
 
+  /* ************************************************************************* */
+  template<typename T>
+  size_t Values::retractGroup(const VectorValues& delta,
+      std::vector<bool>& done, Values& result) const {
+    size_t processed = 0, slot = 0;
+    for (KeyValueMap::const_iterator it = values_.begin(); it != values_.end();
+        ++it, ++slot) {
+      if (done[slot])
+        continue;
+      const GenericValue<T>* gv = dynamic_cast<const GenericValue<T>*>(it->second);
+      if (!gv)
+        continue;
+      Key key = it->first; // Non-const duplicate to deal with non-const insert argument
+      VectorValues::const_iterator d = delta.find(key);
+      if (d != delta.end())
+        result.insert(key, traits<T>::Retract(gv->value(), d->second));
+      else
+        result.insert(key, gv->value());
+      done[slot] = true;
+      ++processed;
+    }
+    return processed;
+  }
+
+  /* ************************************************************************* */
+  template<typename... ValueTypes>
+  Values Values::retractTyped(const VectorValues& delta) const {
+    Values result;
+    std::vector<bool> done(size(), false);
+    size_t processed = 0;
+    // Expand into one tight, devirtualized loop per listed type
+    int expander[] = { 0,
+        (processed += retractGroup<ValueTypes>(delta, done, result), 0)... };
+    (void) expander;
+
+    // Generic virtual dispatch for any values of types not listed
+    if (processed < size()) {
+      size_t slot = 0;
+      for (KeyValueMap::const_iterator it = values_.begin();
+          it != values_.end(); ++it, ++slot) {
+        if (done[slot])
+          continue;
+        Key key = it->first; // Non-const duplicate to deal with non-const insert argument
+        VectorValues::const_iterator d = delta.find(key);
+        if (d != delta.end())
+          result.values_.insert(key, it->second->retract_(d->second));
+        else
+          result.values_.insert(key, it->second->clone_());
+      }
+    }
+    return result;
+  }
+
 }
@@ -103,6 +103,35 @@ namespace gtsam {
     return Values(*this, delta);
   }
 
+  /* ************************************************************************* */
+  Values Values::retractInPlace(const VectorValues& delta) {
+    Values backup;
+    for(const VectorValues::KeyValuePair& d: delta) {
+      KeyValueMap::iterator item = values_.find(d.first);
+      if (item == values_.end())
+        continue; // a delta entry without a variable is ignored, as in retract()
+      Value* retractedValue(item->second->retract_(d.second)); // Retract
+      Key key = d.first; // Non-const duplicate to deal with non-const insert argument
+      // replace() hands back ownership of the original, which moves into the backup
+      backup.values_.insert(key, values_.replace(item, retractedValue).release());
+    }
+    return backup;
+  }
+
+  /* ************************************************************************* */
+  void Values::reinstate(Values& backup) {
+    while (!backup.values_.empty()) {
+      KeyValueMap::iterator item = backup.values_.begin();
+      Key key = item->first;
+      Value* original = backup.values_.release(item).release();
+      KeyValueMap::iterator mine = values_.find(key);
+      if (mine != values_.end())
+        values_.replace(mine, original);
+      else
+        values_.insert(key, original);
+    }
+  }
+
   /* ************************************************************************* */
   VectorValues Values::localCoordinates(const Values& cp) const {
     if(this->size() != cp.size())
@@ -205,6 +234,18 @@ namespace gtsam {
     return result;
   }
 
+  /* ************************************************************************* */
+  size_t Values::memoryUsage() const {
+    // Each entry occupies a red-black tree node: the key, the pointer to the
+    // owned value, three tree links and the node color
+    static const size_t nodeOverhead = sizeof(Key) + 4 * sizeof(void*);
+    size_t result = sizeof(Values) + values_.size() * nodeOverhead;
+    for(const ConstKeyValuePair& key_value: *this) {
+      result += key_value.value.memoryUsage();
+    }
+    return result;
+  }
+
   /* ************************************************************************* */
   VectorValues Values::zeroVectors() const {
     VectorValues result;
@@ -43,6 +43,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace gtsam {
 
@@ -186,6 +187,48 @@ namespace gtsam {
     /// version for double
     double atDouble(size_t key) const { return at<double>(key);}
 
+    /**
+     * Gather the values of several keys into a contiguous output vector.
+     * When the requested keys are sorted, all values are located in a single
+     * merge pass over the container instead of one map lookup per key, so
+     * consumers extracting many variables per cycle (map publishing,
+     * collision checking) avoid the repeated lookup cost of at().
+     * The output is in the same order as the requested keys.
+     * Throws ValuesKeyDoesNotExist if a key is missing, and
+     * ValuesIncorrectType if a stored type does not match.
+     */
+    template<typename ValueType>
+    void extract(const KeyVector& keys, std::vector<ValueType>& output) const;
+
+    /**
+     * A stable typed handle to one variable, for consumers that read the
+     * same variable repeatedly.  Dereferencing is a plain pointer access -
+     * no map lookup and no type check - so the lookup cost of at() is paid
+     * once at handle(). The handle remains valid until the variable is
+     * erased or replaced (update/insert of the same key), like an iterator.
+     */
+    template<typename ValueType>
+    class Handle {
+    public:
+      Handle() : value_(nullptr) {}
+      const ValueType& operator*() const { return *value_; }
+      const ValueType* operator->() const { return value_; }
+      bool valid() const { return value_ != nullptr; }
+    private:
+      friend class Values;
+      explicit Handle(const ValueType* value) : value_(value) {}
+      const ValueType* value_;
+    };
+
+    /**
+     * Obtain a stable typed handle for repeated access to the variable with
+     * key \c j.  Unlike at(), the stored type must match \c ValueType
+     * exactly. Throws ValuesKeyDoesNotExist and ValuesIncorrectType like
+     * at().
+     */
+    template<typename ValueType>
+    Handle<ValueType> handle(Key j) const;
+
     /** Retrieve a variable by key \c j.  This version returns a reference
      * to the base Value class, and needs to be casted before use.
      * @param j Retrieve the value associated with this key
@@ -246,6 +289,33 @@ namespace gtsam {
     /** Add a delta config to current config and returns a new config */
     Values retract(const VectorValues& delta) const;
 
+    /**
+     * Retract with non-virtual fast paths for the listed value types.  The
+     * values are processed in groups - first every value of the first listed
+     * type, then the second, and so on - in tight loops calling
+     * traits<T>::Retract directly instead of GenericValue's virtual
+     * retract_.  Values of types not listed fall back to the generic
+     * per-value dispatch, so the result is always identical to retract().
+     */
+    template<typename... ValueTypes>
+    Values retractTyped(const VectorValues& delta) const;
+
+    /**
+     * Retract in place: every variable with an entry in delta is replaced by
+     * its retraction, and the replaced originals are moved - not cloned -
+     * into the returned backup.  Together with reinstate() this lets an
+     * optimizer apply a trial point and undo a rejected one at a cost
+     * proportional to the changed entries, instead of deep-copying all
+     * variables for every candidate step.
+     */
+    Values retractInPlace(const VectorValues& delta);
+
+    /**
+     * Undo a retractInPlace: move the original values held in backup back
+     * into this container, emptying the backup.
+     */
+    void reinstate(Values& backup);
+
     /** Get a delta config about a linearization point c0 (*this) */
     VectorValues localCoordinates(const Values& cp) const;
 
@@ -306,6 +376,12 @@ namespace gtsam {
     /** Compute the total dimensionality of all values (\f$ O(n) \f$) */
     size_t dim() const;
 
+    /** The number of bytes of memory occupied by this container: per-entry
+     * map overhead plus the footprint each stored value reports through
+     * Value::memoryUsage() (\f$ O(n) \f$).  Custom value types that do not
+     * implement memoryUsage() contribute only their map overhead. */
+    size_t memoryUsage() const;
+
     /** Return a VectorValues of zero vectors for each variable in this Values */
     VectorValues zeroVectors() const;
 
@@ -414,6 +490,11 @@ namespace gtsam {
       ar & BOOST_SERIALIZATION_NVP(values_);
     }
 
+    // One group of retractTyped: retract every not-yet-done value of type T
+    template<typename T>
+    size_t retractGroup(const VectorValues& delta, std::vector<bool>& done,
+        Values& result) const;
+
     static ConstKeyValuePair make_const_deref_pair(const KeyValueMap::const_iterator::value_type& key_value) {
       return ConstKeyValuePair(key_value.first, *key_value.second); }
 
@@ -0,0 +1,288 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    columnarSerialization.cpp
+ * @brief   Columnar save/load entry points for Values and NonlinearFactorGraph
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ */
+
+#include <gtsam/nonlinear/columnarSerialization.h>
+#include <gtsam/linear/columnarSerialization.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/base/GenericValue.h>
+#include <gtsam/base/serialization.h>
+
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+using namespace columnar;
+
+/* ************************************************************************* */
+namespace {
+
+// How each supported type maps to a fixed-stride packed double column.  The
+// group tags double as the fixed order in which groups appear in the file.
+template<typename T> struct ColumnarValue;
+
+template<> struct ColumnarValue<Pose2> {
+  static const uint32_t kTag = 1;
+  static const size_t kStride = 3;
+  static void pack(const Pose2& pose, double* out) {
+    out[0] = pose.x(); out[1] = pose.y(); out[2] = pose.theta();
+  }
+  static Pose2 unpack(const double* in) { return Pose2(in[0], in[1], in[2]); }
+};
+
+template<> struct ColumnarValue<Pose3> {
+  static const uint32_t kTag = 2;
+  static const size_t kStride = 12;
+  static void pack(const Pose3& pose, double* out) {
+    Eigen::Map<Matrix3> R(out);
+    R = pose.rotation().matrix();
+    const Point3& t = pose.translation();
+    out[9] = t.x(); out[10] = t.y(); out[11] = t.z();
+  }
+  static Pose3 unpack(const double* in) {
+    return Pose3(Rot3(Eigen::Map<const Matrix3>(in)),
+        Point3(in[9], in[10], in[11]));
+  }
+};
+
+template<> struct ColumnarValue<Rot2> {
+  static const uint32_t kTag = 3;
+  static const size_t kStride = 2;
+  static void pack(const Rot2& rot, double* out) {
+    out[0] = rot.c(); out[1] = rot.s();
+  }
+  static Rot2 unpack(const double* in) {
+    return Rot2::fromCosSin(in[0], in[1]);
+  }
+};
+
+template<> struct ColumnarValue<Rot3> {
+  static const uint32_t kTag = 4;
+  static const size_t kStride = 9;
+  static void pack(const Rot3& rot, double* out) {
+    Eigen::Map<Matrix3> R(out);
+    R = rot.matrix();
+  }
+  static Rot3 unpack(const double* in) {
+    return Rot3(Eigen::Map<const Matrix3>(in));
+  }
+};
+
+template<> struct ColumnarValue<Point2> {
+  static const uint32_t kTag = 5;
+  static const size_t kStride = 2;
+  static void pack(const Point2& point, double* out) {
+    out[0] = point.x(); out[1] = point.y();
+  }
+  static Point2 unpack(const double* in) { return Point2(in[0], in[1]); }
+};
+
+template<> struct ColumnarValue<Point3> {
+  static const uint32_t kTag = 6;
+  static const size_t kStride = 3;
+  static void pack(const Point3& point, double* out) {
+    out[0] = point.x(); out[1] = point.y(); out[2] = point.z();
+  }
+  static Point3 unpack(const double* in) {
+    return Point3(in[0], in[1], in[2]);
+  }
+};
+
+template<> struct ColumnarValue<Cal3_S2> {
+  static const uint32_t kTag = 7;
+  static const size_t kStride = 5;
+  static void pack(const Cal3_S2& cal, double* out) {
+    out[0] = cal.fx(); out[1] = cal.fy(); out[2] = cal.skew();
+    out[3] = cal.px(); out[4] = cal.py();
+  }
+  static Cal3_S2 unpack(const double* in) {
+    return Cal3_S2(in[0], in[1], in[2], in[3], in[4]);
+  }
+};
+
+template<> struct ColumnarValue<double> {
+  static const uint32_t kTag = 8;
+  static const size_t kStride = 1;
+  static void pack(double value, double* out) { out[0] = value; }
+  static double unpack(const double* in) { return in[0]; }
+};
+
+// Dynamic Vectors get their own group with an extra dims column
+const uint32_t kVectorTag = 9;
+
+// Write the column group for one fixed-stride type: tag, count, keys column,
+// then one aligned packed buffer.  Groups are written even when empty so that
+// the reader can rely on a fixed group sequence.
+template<typename T>
+void writeGroup(ostream& os, const Values& values, set<Key>& saved) {
+  vector<pair<Key, const T*> > entries;
+  for (const Values::ConstKeyValuePair& keyValue : values) {
+    const GenericValue<T>* generic =
+        dynamic_cast<const GenericValue<T>*>(&keyValue.value);
+    if (generic)
+      entries.push_back(make_pair(keyValue.key, &generic->value()));
+  }
+  writeScalar<uint32_t>(os, ColumnarValue<T>::kTag);
+  writeScalar<uint64_t>(os, entries.size());
+  for (const pair<Key, const T*>& entry : entries)
+    writeScalar<uint64_t>(os, entry.first);
+  writeAlignmentPadding(os);
+  double buffer[ColumnarValue<T>::kStride];
+  for (const pair<Key, const T*>& entry : entries) {
+    ColumnarValue<T>::pack(*entry.second, buffer);
+    writeRaw(os, buffer, sizeof(buffer));
+    saved.insert(entry.first);
+  }
+}
+
+// Read the column group written by writeGroup
+template<typename T>
+void readGroup(istream& is, Values& values) {
+  if (readScalar<uint32_t>(is) != ColumnarValue<T>::kTag)
+    throw invalid_argument("loadColumnar: unexpected column group tag");
+  const uint64_t count = readScalar<uint64_t>(is);
+  KeyVector keys(count);
+  for (uint64_t i = 0; i < count; ++i)
+    keys[i] = readScalar<uint64_t>(is);
+  skipAlignmentPadding(is);
+  double buffer[ColumnarValue<T>::kStride];
+  for (uint64_t i = 0; i < count; ++i) {
+    readRaw(is, buffer, sizeof(buffer));
+    values.insert(keys[i], ColumnarValue<T>::unpack(buffer));
+  }
+}
+
+} // \ anonymous namespace
+
+/* ************************************************************************* */
+void saveColumnar(const Values& values, const string& filename) {
+  ofstream os(filename.c_str(), ios::binary);
+  if (!os.is_open())
+    throw invalid_argument("saveColumnar: cannot open file " + filename);
+  writeHeader(os, VALUES);
+
+  set<Key> saved;
+  writeGroup<Pose2>(os, values, saved);
+  writeGroup<Pose3>(os, values, saved);
+  writeGroup<Rot2>(os, values, saved);
+  writeGroup<Rot3>(os, values, saved);
+  writeGroup<Point2>(os, values, saved);
+  writeGroup<Point3>(os, values, saved);
+  writeGroup<Cal3_S2>(os, values, saved);
+  writeGroup<double>(os, values, saved);
+
+  // Dynamic Vectors: keys column, dims column, aligned packed buffer
+  vector<pair<Key, const Vector*> > vectors;
+  for (const Values::ConstKeyValuePair& keyValue : values) {
+    const GenericValue<Vector>* generic =
+        dynamic_cast<const GenericValue<Vector>*>(&keyValue.value);
+    if (generic)
+      vectors.push_back(make_pair(keyValue.key, &generic->value()));
+  }
+  writeScalar<uint32_t>(os, kVectorTag);
+  writeScalar<uint64_t>(os, vectors.size());
+  for (const pair<Key, const Vector*>& entry : vectors)
+    writeScalar<uint64_t>(os, entry.first);
+  for (const pair<Key, const Vector*>& entry : vectors)
+    writeScalar<uint64_t>(os, uint64_t(entry.second->size()));
+  writeAlignmentPadding(os);
+  for (const pair<Key, const Vector*>& entry : vectors) {
+    writeRaw(os, entry.second->data(),
+        size_t(entry.second->size()) * sizeof(double));
+    saved.insert(entry.first);
+  }
+
+  // Anything not covered by a typed column cannot be reconstructed
+  if (saved.size() != values.size()) {
+    for (const Values::ConstKeyValuePair& keyValue : values)
+      if (!saved.count(keyValue.key))
+        throw invalid_argument(
+            string("saveColumnar: unsupported value type ")
+                + typeid(keyValue.value).name());
+  }
+}
+
+/* ************************************************************************* */
+Values loadColumnarValues(const string& filename) {
+  ifstream is(filename.c_str(), ios::binary);
+  if (!is.is_open())
+    throw invalid_argument("loadColumnar: cannot open file " + filename);
+  if (readHeader(is) != VALUES)
+    throw invalid_argument(
+        "loadColumnar: file does not contain a Values: " + filename);
+
+  Values values;
+  readGroup<Pose2>(is, values);
+  readGroup<Pose3>(is, values);
+  readGroup<Rot2>(is, values);
+  readGroup<Rot3>(is, values);
+  readGroup<Point2>(is, values);
+  readGroup<Point3>(is, values);
+  readGroup<Cal3_S2>(is, values);
+  readGroup<double>(is, values);
+
+  if (readScalar<uint32_t>(is) != kVectorTag)
+    throw invalid_argument("loadColumnar: unexpected column group tag");
+  const uint64_t count = readScalar<uint64_t>(is);
+  KeyVector keys(count);
+  FastVector<DenseIndex> dims(count);
+  for (uint64_t i = 0; i < count; ++i)
+    keys[i] = readScalar<uint64_t>(is);
+  for (uint64_t i = 0; i < count; ++i)
+    dims[i] = DenseIndex(readScalar<uint64_t>(is));
+  skipAlignmentPadding(is);
+  for (uint64_t i = 0; i < count; ++i) {
+    Vector x(dims[i]);
+    readRaw(is, x.data(), size_t(dims[i]) * sizeof(double));
+    values.insert(keys[i], x);
+  }
+  return values;
+}
+
+/* ************************************************************************* */
+void saveColumnar(const NonlinearFactorGraph& graph, const string& filename) {
+  ofstream os(filename.c_str(), ios::binary);
+  if (!os.is_open())
+    throw invalid_argument("saveColumnar: cannot open file " + filename);
+  writeHeader(os, NONLINEAR_FACTOR_GRAPH);
+  serializeToBinaryStream(graph, os);
+}
+
+/* ************************************************************************* */
+NonlinearFactorGraph loadColumnarNonlinearFactorGraph(const string& filename) {
+  ifstream is(filename.c_str(), ios::binary);
+  if (!is.is_open())
+    throw invalid_argument("loadColumnar: cannot open file " + filename);
+  if (readHeader(is) != NONLINEAR_FACTOR_GRAPH)
+    throw invalid_argument(
+        "loadColumnar: file does not contain a NonlinearFactorGraph: "
+            + filename);
+  NonlinearFactorGraph graph;
+  deserializeFromBinaryStream(is, graph);
+  return graph;
+}
+
+} // \ namespace gtsam
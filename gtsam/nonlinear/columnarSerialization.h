@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    columnarSerialization.h
+ * @brief   Columnar save/load entry points for Values and NonlinearFactorGraph
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ *
+ * Extends the columnar container of gtsam/linear/columnarSerialization.h to
+ * the nonlinear layer.  A Values is written as typed columns: entries are
+ * grouped by value type, and each group stores a keys column followed by one
+ * aligned packed double buffer, so that checkpointing a million-pose Values
+ * is a handful of bulk writes instead of a million archive calls.  The
+ * supported types are the geometric types commonly used as variables (Pose2,
+ * Pose3, Rot2, Rot3, Point2, Point3, Cal3_S2, double, and dynamic Vector);
+ * saveColumnar throws std::invalid_argument for anything else, since
+ * reconstructing an arbitrary type requires a registry the format does not
+ * have.  A NonlinearFactorGraph holds type-erased, pointer-rich factors that
+ * do not decompose into columns, so it is stored as a boost binary archive
+ * payload inside the same versioned container; as with
+ * serializeToBinaryFile, the caller is responsible for registering the
+ * factor types involved with BOOST_CLASS_EXPORT.
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <string>
+
+namespace gtsam {
+
+/**
+ * Save a Values as a columnar file with one typed column group per value
+ * type.  Throws std::invalid_argument if the file cannot be opened, or if
+ * the Values contains a type outside the supported set listed above.
+ */
+GTSAM_EXPORT void saveColumnar(const Values& values,
+    const std::string& filename);
+
+/**
+ * Load a Values written by saveColumnar.
+ * Throws std::invalid_argument on a missing, foreign, or incompatible file.
+ */
+GTSAM_EXPORT Values loadColumnarValues(const std::string& filename);
+
+/**
+ * Save a NonlinearFactorGraph, as a binary archive payload inside the
+ * columnar container.  The factor types involved must have been registered
+ * with BOOST_CLASS_EXPORT.  Throws std::invalid_argument if the file cannot
+ * be opened.
+ */
+GTSAM_EXPORT void saveColumnar(const NonlinearFactorGraph& graph,
+    const std::string& filename);
+
+/**
+ * Load a NonlinearFactorGraph written by saveColumnar.
+ * Throws std::invalid_argument on a missing, foreign, or incompatible file.
+ */
+GTSAM_EXPORT NonlinearFactorGraph loadColumnarNonlinearFactorGraph(
+    const std::string& filename);
+
+} // \ namespace gtsam
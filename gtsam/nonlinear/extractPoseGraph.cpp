@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    extractPoseGraph.cpp
+ * @brief   Extract the pose-only graph implied by a landmark-full graph
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ */
+
+#include <gtsam/nonlinear/extractPoseGraph.h>
+#include <gtsam/nonlinear/LinearContainerFactor.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/timing.h>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
+namespace gtsam {
+
+/* ************************************************************************* */
+NonlinearFactorGraph extractPoseGraph(const GaussianFactorGraph& graph,
+    const KeySet& landmarkKeys, const Values& linearizationPoint,
+    const GaussianFactorGraph::Eliminate& function) {
+  gttic(extractPoseGraph);
+
+  // Group the factor slots by the landmark they observe.  Eliminating the
+  // landmarks one at a time is only equivalent to eliminating them jointly
+  // if the groups do not interact, so a factor connecting two landmarks
+  // cannot be marginalized this way.
+  FastMap<Key, FactorIndices> landmarkFactors;
+  std::vector<bool> involvesLandmark(graph.size(), false);
+  for (size_t i = 0; i < graph.size(); ++i) {
+    const GaussianFactor::shared_ptr& factor = graph[i];
+    if (!factor)
+      continue;
+    Key landmark = 0;
+    size_t count = 0;
+    for (const Key key : *factor) {
+      if (landmarkKeys.count(key)) {
+        landmark = key;
+        ++count;
+      }
+    }
+    if (count > 1)
+      throw std::invalid_argument(
+          "extractPoseGraph: a factor connects multiple landmarks, so the "
+          "landmarks cannot be marginalized independently");
+    if (count == 1) {
+      landmarkFactors[landmark].push_back(i);
+      involvesLandmark[i] = true;
+    }
+  }
+
+  // The per-landmark Schur complements are independent: each one only reads
+  // the factors of its landmark and writes its own slot
+  KeyVector landmarks;
+  landmarks.reserve(landmarkFactors.size());
+  for (const auto& landmark_slots : landmarkFactors)
+    landmarks.push_back(landmark_slots.first);
+  std::vector<GaussianFactor::shared_ptr> complements(landmarks.size());
+  auto eliminateOne = [&](size_t i) {
+    GaussianFactorGraph landmarkGraph;
+    const FactorIndices& slots = landmarkFactors.at(landmarks[i]);
+    landmarkGraph.reserve(slots.size());
+    for (const FactorIndex slot : slots)
+      landmarkGraph.push_back(graph[slot]);
+    Ordering ordering;
+    ordering.push_back(landmarks[i]);
+    complements[i] = function(landmarkGraph, ordering).second;
+  };
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, landmarks.size()),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i)
+          eliminateOne(i);
+      });
+#else
+  for (size_t i = 0; i < landmarks.size(); ++i)
+    eliminateOne(i);
+#endif
+
+  // Assemble the pose graph: factors not involving a landmark pass through,
+  // each landmark contributes its complement onto the poses observing it.
+  // A landmark observed by nothing but a prior leaves an empty complement.
+  NonlinearFactorGraph poseGraph;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    if (graph[i] && !involvesLandmark[i])
+      poseGraph.emplace_shared<LinearContainerFactor>(graph[i], linearizationPoint);
+  }
+  for (const GaussianFactor::shared_ptr& complement : complements) {
+    if (complement && complement->size() > 0)
+      poseGraph.emplace_shared<LinearContainerFactor>(complement, linearizationPoint);
+  }
+  return poseGraph;
+}
+
+}  // \namespace gtsam
@@ -0,0 +1,50 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    extractPoseGraph.h
+ * @brief   Extract the pose-only graph implied by a landmark-full graph
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+
+namespace gtsam {
+
+/**
+ * Marginalize the given landmark variables out of a linear(ized) factor
+ * graph, producing the pose-only graph it implies as a NonlinearFactorGraph
+ * of LinearContainerFactors suitable for, e.g., loop-closure verification.
+ *
+ * Factors that do not involve a landmark pass through unchanged; each
+ * landmark contributes the Schur complement of its factors onto the poses
+ * observing it.  Because every factor may observe at most one landmark, the
+ * per-landmark Schur complements are independent and are computed in
+ * parallel, unlike a joint elimination which serializes and over-computes.
+ * Throws std::invalid_argument if a factor connects two landmarks.
+ *
+ * @param graph               the linearized graph, poses and landmarks
+ * @param landmarkKeys        the variables to marginalize out
+ * @param linearizationPoint  values the resulting factors anchor to
+ * @param function            dense elimination routine for the complements
+ */
+GTSAM_EXPORT NonlinearFactorGraph extractPoseGraph(
+    const GaussianFactorGraph& graph, const KeySet& landmarkKeys,
+    const Values& linearizationPoint,
+    const GaussianFactorGraph::Eliminate& function = EliminatePreferCholesky);
+
+}  // \namespace gtsam
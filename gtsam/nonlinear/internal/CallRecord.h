@@ -55,6 +55,15 @@ struct ConvertToDynamicIf<false> {
   }
 };
 
+/**
+ * CallRecordMaxVirtualStaticRows tells which separate virtual reverseAD with specific
+ * static rows (1..CallRecordMaxVirtualStaticRows) methods are part of the CallRecord
+ * interface. It is used to keep the testCallRecord unit test in sync.
+ * Up to this many rows the dispatch below stays fixed-size, i.e. on the stack;
+ * larger row counts fall back to a heap-allocated dynamic matrix.
+ */
+const int CallRecordMaxVirtualStaticRows = 12;
+
 /**
  * The CallRecord is an abstract base class for any class that stores
  * the Jacobians of applying a function with respect to each of its arguments,
@@ -83,12 +92,15 @@ struct CallRecord {
   }
 
   // Dispatch the reverseAD2 calls issued by ExecutionTrace::reverseAD1
-  // Here we convert dFdT to a dynamic Matrix if the # rows>5, because _reverseAD3 is only
-  // specialized for fixed-size matrices up to 5 rows.
-  // The appropriate _reverseAD3 method is selected by method overloading.
+  // Here we convert dFdT to a dynamic Matrix if the # rows exceeds
+  // CallRecordMaxVirtualStaticRows, because _reverseAD3 is only specialized
+  // for fixed-size matrices up to that many rows; below it the dispatch is
+  // allocation-free. The appropriate _reverseAD3 method is selected by
+  // method overloading.
   template <typename Derived>
   inline void reverseAD2(const Eigen::MatrixBase<Derived>& dFdT, JacobianMap& jacobians) const {
-    _reverseAD3(ConvertToDynamicIf<(Derived::RowsAtCompileTime > 5)>::convert(dFdT), jacobians);
+    _reverseAD3(ConvertToDynamicIf<
+        (Derived::RowsAtCompileTime > CallRecordMaxVirtualStaticRows)>::convert(dFdT), jacobians);
   }
 
   // This overload supports matrices with both rows and columns dynamically sized.
@@ -123,15 +135,22 @@ private:
       JacobianMap& jacobians) const = 0;
   virtual void _reverseAD3(const Eigen::Matrix<double, 5, Cols> & dFdT,
       JacobianMap& jacobians) const = 0;
+  virtual void _reverseAD3(const Eigen::Matrix<double, 6, Cols> & dFdT,
+      JacobianMap& jacobians) const = 0;
+  virtual void _reverseAD3(const Eigen::Matrix<double, 7, Cols> & dFdT,
+      JacobianMap& jacobians) const = 0;
+  virtual void _reverseAD3(const Eigen::Matrix<double, 8, Cols> & dFdT,
+      JacobianMap& jacobians) const = 0;
+  virtual void _reverseAD3(const Eigen::Matrix<double, 9, Cols> & dFdT,
+      JacobianMap& jacobians) const = 0;
+  virtual void _reverseAD3(const Eigen::Matrix<double, 10, Cols> & dFdT,
+      JacobianMap& jacobians) const = 0;
+  virtual void _reverseAD3(const Eigen::Matrix<double, 11, Cols> & dFdT,
+      JacobianMap& jacobians) const = 0;
+  virtual void _reverseAD3(const Eigen::Matrix<double, 12, Cols> & dFdT,
+      JacobianMap& jacobians) const = 0;
 };
 
-/**
- * CallRecordMaxVirtualStaticRows tells which separate virtual reverseAD with specific
- * static rows (1..CallRecordMaxVirtualStaticRows) methods are part of the CallRecord
- * interface. It is used to keep the testCallRecord unit test in sync.
- */
-const int CallRecordMaxVirtualStaticRows = 5;
-
 /**
  * The CallRecordImplementor implements the CallRecord interface for a Derived class by
  * delegating to its corresponding (templated) non-virtual methods.
@@ -183,6 +202,34 @@ private:
       JacobianMap& jacobians) const {
     derived().reverseAD4(dFdT, jacobians);
   }
+  virtual void _reverseAD3(const Eigen::Matrix<double, 6, Cols> & dFdT,
+      JacobianMap& jacobians) const {
+    derived().reverseAD4(dFdT, jacobians);
+  }
+  virtual void _reverseAD3(const Eigen::Matrix<double, 7, Cols> & dFdT,
+      JacobianMap& jacobians) const {
+    derived().reverseAD4(dFdT, jacobians);
+  }
+  virtual void _reverseAD3(const Eigen::Matrix<double, 8, Cols> & dFdT,
+      JacobianMap& jacobians) const {
+    derived().reverseAD4(dFdT, jacobians);
+  }
+  virtual void _reverseAD3(const Eigen::Matrix<double, 9, Cols> & dFdT,
+      JacobianMap& jacobians) const {
+    derived().reverseAD4(dFdT, jacobians);
+  }
+  virtual void _reverseAD3(const Eigen::Matrix<double, 10, Cols> & dFdT,
+      JacobianMap& jacobians) const {
+    derived().reverseAD4(dFdT, jacobians);
+  }
+  virtual void _reverseAD3(const Eigen::Matrix<double, 11, Cols> & dFdT,
+      JacobianMap& jacobians) const {
+    derived().reverseAD4(dFdT, jacobians);
+  }
+  virtual void _reverseAD3(const Eigen::Matrix<double, 12, Cols> & dFdT,
+      JacobianMap& jacobians) const {
+    derived().reverseAD4(dFdT, jacobians);
+  }
 };
 
 } // namespace internal
@@ -23,9 +23,11 @@
 #include <gtsam/base/Manifold.h>
 
 #include <boost/type_traits/aligned_storage.hpp>
+#include <boost/align/aligned_alloc.hpp>
 
 #include <Eigen/Core>
 #include <iostream>
+#include <new>
 
 namespace gtsam {
 namespace internal {
@@ -38,6 +40,63 @@ template<int T> struct CallRecord;
 static const unsigned TraceAlignment = 32;
 typedef boost::aligned_storage<1, TraceAlignment>::type ExecutionTraceStorage;
 
+/**
+ * Owns an aligned, reusable buffer for an expression's execution trace, so
+ * that factors can allocate it once at construction and replay the trace on
+ * every linearize call. Copies allocate a buffer of their own rather than
+ * aliasing, so cloned factors never share (and never race on) a trace.
+ */
+class TraceStorage {
+public:
+  TraceStorage() : data_(nullptr), size_(0) {}
+  explicit TraceStorage(size_t size) : data_(allocate(size)), size_(size) {}
+  TraceStorage(const TraceStorage& other)
+      : data_(allocate(other.size_)), size_(other.size_) {}
+  TraceStorage& operator=(const TraceStorage& other) {
+    if (this != &other && size_ != other.size_) {
+      boost::alignment::aligned_free(data_);
+      data_ = allocate(other.size_);
+      size_ = other.size_;
+    }
+    return *this;
+  }
+  ~TraceStorage() { boost::alignment::aligned_free(data_); }
+
+  ExecutionTraceStorage* data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  /// size counts ExecutionTraceStorage elements, as returned by
+  /// Expression::traceSize() - the trace layout advances pointers of that
+  /// type element-wise, so the buffer needs size * sizeof(element) bytes
+  static ExecutionTraceStorage* allocate(size_t size) {
+    if (size == 0) return nullptr;
+    void* data = boost::alignment::aligned_alloc(TraceAlignment,
+        size * sizeof(ExecutionTraceStorage));
+    if (!data) throw std::bad_alloc();
+    return static_cast<ExecutionTraceStorage*>(data);
+  }
+
+  ExecutionTraceStorage* data_;
+  size_t size_;
+};
+
+/**
+ * Returns a per-thread trace buffer of at least the given size. The buffer
+ * grows monotonically to the high-water mark of all requests on its thread -
+ * under a parallel linearize that is the largest traceSize() in the graph -
+ * and is reused by every expression factor the thread linearizes, so
+ * expression-heavy graphs perform a handful of allocations per thread
+ * instead of holding one buffer per factor. Being thread-local, the buffer
+ * needs no locking and composes with the TBB linearize loop, where each
+ * worker replays traces strictly sequentially.
+ */
+inline ExecutionTraceStorage* threadLocalTraceBuffer(size_t size) {
+  static thread_local TraceStorage buffer;
+  if (buffer.size() < size) buffer = TraceStorage(size);
+  return buffer.data();
+}
+
 template<bool UseBlock, typename Derived>
 struct UseBlockIf {
   static void addToJacobian(const Eigen::MatrixBase<Derived>& dTdA,
@@ -33,8 +33,10 @@ namespace internal {
  */
 struct NonlinearOptimizerState {
  public:
-  /** The current estimate of the variable values. */
-  const Values values;
+  /** The current estimate of the variable values.  Not const: the
+   * Levenberg-Marquardt trial-point evaluation retracts it in place and
+   * reinstates it if the step is rejected, see Values::retractInPlace. */
+  Values values;
 
   /** The factor graph error on the current values. */
   const double error;
@@ -159,6 +159,24 @@ TEST(CallRecord, virtualReverseAdDispatching) {
     record.CallRecord::reverseAD2(Eigen::MatrixXd(Rows, Cols), NJM);
     EXPECT((assert_equal(record.cc, CallConfig(Eigen::Dynamic, Eigen::Dynamic, Rows, Cols))));
   }
+  { // last row count dispatched to a fixed-size virtual method
+    const int Rows = internal::CallRecordMaxVirtualStaticRows;
+    record.CallRecord::reverseAD2(Eigen::Matrix<double, Rows, Cols>(), NJM);
+    EXPECT((assert_equal(record.cc, CallConfig(Rows, Cols))));
+    record.CallRecord::reverseAD2(DynRowMat(Rows, Cols), NJM);
+    EXPECT((assert_equal(record.cc, CallConfig(Eigen::Dynamic, Cols, Rows, Cols))));
+    record.CallRecord::reverseAD2(Eigen::MatrixXd(Rows, Cols), NJM);
+    EXPECT((assert_equal(record.cc, CallConfig(Eigen::Dynamic, Eigen::Dynamic, Rows, Cols))));
+  }
+  { // first row count converted to dynamic rows
+    const int Rows = internal::CallRecordMaxVirtualStaticRows + 1;
+    record.CallRecord::reverseAD2(Eigen::Matrix<double, Rows, Cols>(), NJM);
+    EXPECT((assert_equal(record.cc, CallConfig(Eigen::Dynamic, Cols, Rows, Cols))));
+    record.CallRecord::reverseAD2(DynRowMat(Rows, Cols), NJM);
+    EXPECT((assert_equal(record.cc, CallConfig(Eigen::Dynamic, Cols, Rows, Cols))));
+    record.CallRecord::reverseAD2(Eigen::MatrixXd(Rows, Cols), NJM);
+    EXPECT((assert_equal(record.cc, CallConfig(Eigen::Dynamic, Eigen::Dynamic, Rows, Cols))));
+  }
 }
 
 /* ************************************************************************* */
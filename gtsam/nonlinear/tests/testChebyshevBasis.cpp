@@ -0,0 +1,100 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testChebyshevBasis.cpp
+ * @brief Unit tests for the Chebyshev basis evaluation engine
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/ChebyshevBasis.h>
+#include <gtsam/nonlinear/FunctorizedFactor.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <cmath>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(ChebyshevBasis, weights) {
+  // On the canonical interval the weights are cos(j acos(x))
+  ChebyshevBasis basis(5);
+  const double x = 0.3;
+  Vector actual = basis.weights(x);
+  Vector expected(5);
+  for (size_t j = 0; j < 5; ++j)
+    expected(j) = cos(j * acos(x));
+  EXPECT(assert_equal(expected, actual, 1e-12));
+}
+
+/* ************************************************************************* */
+TEST(ChebyshevBasis, evaluationMatrix) {
+  // The batched matrix stacks the per-timestamp weight rows
+  ChebyshevBasis basis(4, 0.0, 2.0);
+  Vector timestamps = (Vector(3) << 0.2, 1.0, 1.7).finished();
+  Matrix W = basis.evaluationMatrix(timestamps);
+  EXPECT_LONGS_EQUAL(3, W.rows());
+  EXPECT_LONGS_EQUAL(4, W.cols());
+  for (DenseIndex i = 0; i < 3; ++i)
+    EXPECT(assert_equal(Vector(basis.weights(timestamps(i))),
+        Vector(W.row(i)), 1e-12));
+}
+
+/* ************************************************************************* */
+TEST(ChebyshevBasis, evaluateAndDifferentiate) {
+  // t^2 on [0,2] is 1.5 T_0 + 2 T_1 + 0.5 T_2 in the shifted basis
+  ChebyshevBasis basis(3, 0.0, 2.0);
+  Vector coefficients = (Vector(3) << 1.5, 2.0, 0.5).finished();
+  Vector timestamps = (Vector(4) << 0.0, 0.5, 1.3, 2.0).finished();
+
+  BasisEvaluation engine(basis, timestamps);
+  Vector values = engine.evaluate(coefficients);
+  Vector derivatives = engine.evaluateDerivative(coefficients);
+  for (DenseIndex i = 0; i < 4; ++i) {
+    DOUBLES_EQUAL(timestamps(i) * timestamps(i), values(i), 1e-12);
+    DOUBLES_EQUAL(2.0 * timestamps(i), derivatives(i), 1e-12);
+  }
+}
+
+/* ************************************************************************* */
+TEST(ChebyshevBasis, fitWithFunctorizedFactor) {
+  // Fit coefficients to noise-free samples of t^2 through FunctorizedFactor;
+  // the cached weight rows serve as both prediction and Jacobian
+  ChebyshevBasis basis(3, 0.0, 2.0);
+  Vector timestamps = (Vector(5) << 0.0, 0.4, 1.0, 1.5, 2.0).finished();
+  BasisEvaluation engine(basis, timestamps);
+
+  const Key key = Symbol('c', 0);
+  auto model = noiseModel::Isotropic::Sigma(1, 0.1);
+  NonlinearFactorGraph graph;
+  for (size_t i = 0; i < 5; ++i)
+    graph.emplace_shared<FunctorizedFactor<double, Vector> >(key,
+        timestamps(i) * timestamps(i), model, engine.predictFunctor(i));
+
+  Values initial;
+  initial.insert(key, Vector(Vector::Zero(3)));
+  Values result = LevenbergMarquardtOptimizer(graph, initial).optimize();
+
+  Vector expected = (Vector(3) << 1.5, 2.0, 0.5).finished();
+  EXPECT(assert_equal(expected, result.at<Vector>(key), 1e-6));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,104 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testExtractPoseGraph.cpp
+ * @brief   Unit tests for landmark marginalization into a pose-only graph
+ * @author  Frank Dellaert
+ * @date    Aug 30, 2026
+ */
+
+#include <gtsam/nonlinear/extractPoseGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/geometry/Point2.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+using symbol_shorthand::X;
+using symbol_shorthand::L;
+
+/* ************************************************************************* */
+namespace {
+
+// Two poses observing two landmarks, every factor observing at most one
+GaussianFactorGraph createLandmarkGraph() {
+  GaussianFactorGraph graph;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  const Matrix I = (Matrix(2, 2) << 1, 0, 0, 1).finished();
+  const Matrix A = (Matrix(2, 2) << 2, 0.3, -0.3, 2).finished();
+  graph += JacobianFactor(X(0), I, (Vector(2) << 0.1, 0.2).finished(), unit2);
+  graph += JacobianFactor(X(0), -I, X(1), I, (Vector(2) << 1.0, 0.5).finished(), unit2);
+  graph += JacobianFactor(X(0), A, L(0), I, (Vector(2) << 0.3, -0.1).finished(), unit2);
+  graph += JacobianFactor(X(1), A, L(0), I, (Vector(2) << -0.2, 0.4).finished(), unit2);
+  graph += JacobianFactor(X(0), A, L(1), I, (Vector(2) << 0.6, 0.1).finished(), unit2);
+  graph += JacobianFactor(X(1), A, L(1), I, (Vector(2) << 0.0, -0.5).finished(), unit2);
+  return graph;
+}
+
+Values createPoseValues() {
+  Values values;
+  values.insert(X(0), Point2(0, 0));
+  values.insert(X(1), Point2(1, 0.5));
+  return values;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+TEST(ExtractPoseGraph, matchesJointElimination) {
+  GaussianFactorGraph graph = createLandmarkGraph();
+  Values values = createPoseValues();
+  KeySet landmarkKeys;
+  landmarkKeys.insert(L(0));
+  landmarkKeys.insert(L(1));
+
+  // Two pass-through pose factors plus one complement per landmark
+  NonlinearFactorGraph poseGraph = extractPoseGraph(graph, landmarkKeys, values);
+  EXPECT_LONGS_EQUAL(4, poseGraph.size());
+
+  // The pose-only system must match a joint elimination of the landmarks
+  Ordering landmarkOrdering;
+  landmarkOrdering.push_back(L(0));
+  landmarkOrdering.push_back(L(1));
+  GaussianFactorGraph::shared_ptr expectedMarginal =
+      graph.eliminatePartialMultifrontal(landmarkOrdering).second;
+
+  Ordering poseOrdering;
+  poseOrdering.push_back(X(0));
+  poseOrdering.push_back(X(1));
+  Matrix expected = expectedMarginal->augmentedHessian(poseOrdering);
+  Matrix actual = poseGraph.linearize(values)->augmentedHessian(poseOrdering);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(ExtractPoseGraph, rejectsCoupledLandmarks) {
+  GaussianFactorGraph graph = createLandmarkGraph();
+  Values values = createPoseValues();
+  KeySet landmarkKeys;
+  landmarkKeys.insert(L(0));
+  landmarkKeys.insert(L(1));
+
+  // A factor connecting two landmarks breaks the per-landmark independence
+  const Matrix I = (Matrix(2, 2) << 1, 0, 0, 1).finished();
+  graph += JacobianFactor(L(0), -I, L(1), I, (Vector(2) << 0, 0).finished(),
+      noiseModel::Unit::Create(2));
+  CHECK_EXCEPTION(extractPoseGraph(graph, landmarkKeys, values),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/nonlinear/Values.h>
+#include <gtsam/nonlinear/columnarSerialization.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/PinholeCamera.h>
 #include <gtsam/geometry/Pose2.h>
@@ -82,6 +83,29 @@ TEST (Serialization, TemplatedValues) {
   EXPECT(equalsBinary(values));
 }
 
+/* ************************************************************************* */
+TEST (Serialization, ColumnarValues) {
+  Values expected;
+  expected.insert(0, Pose2(1.0, 2.0, 0.3));
+  expected.insert(1, pose3);
+  expected.insert(2, rt3);
+  expected.insert(3, pt3);
+  expected.insert(Symbol('c', 0), cal1);
+  expected.insert(Symbol('b', 1), 0.5);
+  expected.insert(Symbol('v', 2), Vector((Vector(4) << 1., 2., 3., 4.).finished()));
+
+  const string filename = "testColumnarValues.bin";
+  saveColumnar(expected, filename);
+  Values actual = loadColumnarValues(filename);
+  EXPECT(assert_equal(expected, actual));
+  remove(filename.c_str());
+
+  // Types outside the columnar registry cannot be reconstructed and throw
+  expected.insert(Symbol('x', 9), PinholeCal3S2(pose3, cal1));
+  CHECK_EXCEPTION(saveColumnar(expected, filename), std::invalid_argument);
+  remove(filename.c_str());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -198,6 +198,21 @@ TEST(Values, basic_functions)
 
 }
 
+/* ************************************************************************* */
+TEST(Values, memoryUsage)
+{
+  // An empty container reports only its own footprint; each inserted value
+  // adds at least the wrapped object's size
+  Values values;
+  const size_t emptySize = values.memoryUsage();
+  EXPECT(emptySize >= sizeof(Values));
+  values.insert(key1, Pose3());
+  EXPECT(values.memoryUsage() >= emptySize + sizeof(GenericValue<Pose3>));
+  const size_t oneValue = values.memoryUsage();
+  values.insert(key2, Pose3());
+  EXPECT(values.memoryUsage() >= oneValue + sizeof(GenericValue<Pose3>));
+}
+
 /* ************************************************************************* */
 TEST(Values, retract_full)
 {
@@ -235,6 +250,53 @@ TEST(Values, retract_partial)
   CHECK(assert_equal(expected, Values(config0, delta)));
 }
 
+/* ************************************************************************* */
+TEST(Values, retract_typed)
+{
+  // Mixed content: two poses, a point, and a vector not in the typed list
+  Values config0;
+  config0.insert(key1, Pose3(Rot3::Rodrigues(0.1, 0.2, 0.3), Point3(1, 2, 3)));
+  config0.insert(key2, Pose3(Rot3::Rodrigues(-0.2, 0.1, 0.0), Point3(4, 5, 6)));
+  config0.insert(key3, Point3(7.0, 8.0, 9.0));
+  config0.insert(key4, Vector3(1.0, 2.0, 3.0));
+
+  VectorValues delta;
+  delta.insert(key1, (Vector(6) << 0.1, -0.1, 0.2, 0.3, -0.2, 0.1).finished());
+  delta.insert(key3, Vector3(0.5, -0.5, 0.25));
+  delta.insert(key4, Vector3(1.0, 1.1, 1.2));
+
+  // Grouped processing gives exactly the same result as generic retract,
+  // including the untouched pose and the fallback-dispatched Vector3
+  Values expected = config0.retract(delta);
+  Values actual = config0.retractTyped<Pose3, Point3>(delta);
+  CHECK(assert_equal(expected, actual));
+}
+
+/* ************************************************************************* */
+TEST(Values, retractInPlace)
+{
+  Values config0;
+  config0.insert(key1, Vector3(1.0, 2.0, 3.0));
+  config0.insert(key2, Vector3(5.0, 6.0, 7.0));
+  config0.insert(key3, Pose2(0.1, 0.2, 0.3));
+  Values original = config0;
+
+  // Partial delta: key2 is untouched and never cloned into the backup
+  VectorValues delta = pair_list_of<Key, Vector>
+    (key1, Vector3(1.0, 1.1, 1.2))
+    (key3, Vector3(0.5, -0.5, 0.1));
+
+  Values expected = config0.retract(delta);
+  Values backup = config0.retractInPlace(delta);
+  CHECK(assert_equal(expected, config0));
+  EXPECT_LONGS_EQUAL(2, backup.size());
+
+  // Reinstating moves the originals back and empties the backup
+  config0.reinstate(backup);
+  CHECK(assert_equal(original, config0));
+  EXPECT_LONGS_EQUAL(0, backup.size());
+}
+
 /* ************************************************************************* */
 TEST(Values, equals)
 {
@@ -289,6 +351,57 @@ TEST(Values, extract_keys)
   }
 }
 
+/* ************************************************************************* */
+TEST(Values, extract)
+{
+  Values config;
+  config.insert(key1, Pose2(1.0, 2.0, 0.3));
+  config.insert(key2, Pose2(4.0, 5.0, 0.6));
+  config.insert(key3, Pose2(7.0, 8.0, 0.9));
+
+  // Sorted keys use the single merge pass
+  KeyVector sorted {key1, key2, key3};
+  std::vector<Pose2> poses;
+  config.extract(sorted, poses);
+  LONGS_EQUAL(3, poses.size());
+  EXPECT(assert_equal(config.at<Pose2>(key2), poses[1]));
+
+  // Unsorted keys are returned in request order
+  KeyVector unsorted {key3, key1};
+  config.extract(unsorted, poses);
+  LONGS_EQUAL(2, poses.size());
+  EXPECT(assert_equal(config.at<Pose2>(key3), poses[0]));
+  EXPECT(assert_equal(config.at<Pose2>(key1), poses[1]));
+
+  // Missing keys and wrong types throw, as with at()
+  KeyVector missing {key1, key4};
+  CHECK_EXCEPTION(config.extract(missing, poses), ValuesKeyDoesNotExist);
+  std::vector<Vector3> vectors;
+  CHECK_EXCEPTION(config.extract(sorted, vectors), ValuesIncorrectType);
+}
+
+/* ************************************************************************* */
+TEST(Values, handle)
+{
+  Values config;
+  config.insert(key1, Pose2(1.0, 2.0, 0.3));
+  config.insert(key2, 2.0);
+
+  // The handle reads the stored variable without further lookups
+  Values::Handle<Pose2> h = config.handle<Pose2>(key1);
+  CHECK(h.valid());
+  EXPECT(assert_equal(config.at<Pose2>(key1), *h));
+  DOUBLES_EQUAL(1.0, h->x(), 1e-9);
+
+  // A default-constructed handle is invalid
+  Values::Handle<Pose2> empty;
+  CHECK(!empty.valid());
+
+  // Missing keys and wrong types throw, as with at()
+  CHECK_EXCEPTION(config.handle<Pose2>(key4), ValuesKeyDoesNotExist);
+  CHECK_EXCEPTION(config.handle<Pose2>(key2), ValuesIncorrectType);
+}
+
 /* ************************************************************************* */
 TEST(Values, exists_)
 {
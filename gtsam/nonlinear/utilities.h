@@ -137,6 +137,27 @@ Matrix extractPose3(const Values& values) {
   return result;
 }
 
+/// Extract all Vector values with a given symbol character into a single
+/// matrix, one row per variable. All vectors must have the same dimension.
+/// This crosses the wrapper boundary once instead of once per key.
+Matrix extractVectors(const Values& values, char c) {
+  Values::ConstFiltered<Vector> vectors =
+      values.filter<Vector>(Symbol::ChrTest(c));
+  if (vectors.size() == 0) {
+    return Matrix();
+  }
+  DenseIndex n = vectors.begin()->value.size();
+  Matrix result(vectors.size(), n);
+  size_t j = 0;
+  for (const auto& key_value : vectors) {
+    if (key_value.value.size() != n)
+      throw std::runtime_error(
+          "extractVectors: All values must have the same dimension");
+    result.row(j++) = key_value.value;
+  }
+  return result;
+}
+
 /// Perturb all Point2 values using normally distributed noise
 void perturbPoint2(Values& values, double sigma, int32_t seed = 42u) {
   noiseModel::Isotropic::shared_ptr model = noiseModel::Isotropic::Sigma(2,
@@ -0,0 +1,187 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file MultiBearingRangeFactor.h
+ * @date Aug 2020
+ * @brief A factor evaluating all bearing/range measurements of one scan at once
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/geometry/BearingRange.h>
+#include <boost/serialization/vector.hpp>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * N-ary factor for a batch of bearing/range measurements taken from a single
+ * pose, e.g. one 2D LIDAR scan observing many landmarks.  Where a graph of
+ * individual BearingRangeFactors performs one small linearize call per
+ * measurement, this factor evaluates the whole scan in a single pass against
+ * the shared pose, producing one stacked Jacobian and one linear factor.
+ *
+ * The first key is the shared pose, followed by one key per landmark.  The
+ * noise model must have dimension nrMeasurements * BearingRange::dimension.
+ * @addtogroup SLAM
+ */
+template <typename A1, typename A2,
+          typename B = typename Bearing<A1, A2>::result_type,
+          typename R = typename Range<A1, A2>::result_type>
+class MultiBearingRangeFactor : public NoiseModelFactor {
+ public:
+  typedef BearingRange<A1, A2> T;
+
+ private:
+  typedef NoiseModelFactor Base;
+  typedef MultiBearingRangeFactor<A1, A2> This;
+
+  std::vector<T> measured_;  ///< bearing/range measurements, one per landmark
+
+  /// Assemble the key list: shared pose first, then one key per landmark
+  static KeyVector Keys(Key poseKey, const KeyVector& pointKeys) {
+    KeyVector keys;
+    keys.reserve(pointKeys.size() + 1);
+    keys.push_back(poseKey);
+    keys.insert(keys.end(), pointKeys.begin(), pointKeys.end());
+    return keys;
+  }
+
+ public:
+  typedef boost::shared_ptr<This> shared_ptr;
+
+  /// default constructor
+  MultiBearingRangeFactor() {}
+
+  /// primary constructor, from pre-paired bearing/range measurements
+  MultiBearingRangeFactor(Key poseKey, const KeyVector& pointKeys,
+                          const std::vector<T>& measurements,
+                          const SharedNoiseModel& model)
+      : Base(model, Keys(poseKey, pointKeys)), measured_(measurements) {
+    if (pointKeys.size() != measurements.size())
+      throw std::invalid_argument(
+          "MultiBearingRangeFactor: number of landmark keys and measurements "
+          "do not match");
+    if (model && model->dim() != measurements.size() * T::dimension)
+      throw std::invalid_argument(
+          "MultiBearingRangeFactor: noise model dimension does not match "
+          "number of measurements");
+  }
+
+  /// convenience constructor from separate bearing and range containers
+  MultiBearingRangeFactor(Key poseKey, const KeyVector& pointKeys,
+                          const std::vector<B>& bearings,
+                          const std::vector<R>& ranges,
+                          const SharedNoiseModel& model)
+      : MultiBearingRangeFactor(poseKey, pointKeys,
+                                Pair(bearings, ranges), model) {}
+
+  virtual ~MultiBearingRangeFactor() {}
+
+  /// @return a deep copy of this factor
+  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// number of measurements in the scan
+  size_t nrMeasurements() const { return measured_.size(); }
+
+  /// the stacked measurements
+  const std::vector<T>& measured() const { return measured_; }
+
+  /**
+   * Error for the whole scan, stacked measurement by measurement.  The shared
+   * pose is read once; its Jacobian blocks are assembled into a single tall
+   * matrix so linearization produces one factor instead of one per beam.
+   */
+  virtual Vector unwhitenedError(
+      const Values& x,
+      boost::optional<std::vector<Matrix>&> H = boost::none) const {
+    const A1& pose = x.at<A1>(keys_.front());
+    const size_t n = measured_.size();
+    Vector error(n * T::dimension);
+    if (H)
+      (*H)[0] = Matrix::Zero(n * T::dimension, traits<A1>::dimension);
+    for (size_t i = 0; i < n; ++i) {
+      const A2& point = x.at<A2>(keys_[i + 1]);
+      if (H) {
+        typename MakeJacobian<T, A1>::type H1;
+        typename MakeJacobian<T, A2>::type H2;
+        const T predicted = T::Measure(pose, point, H1, H2);
+        (*H)[0].middleRows(i * T::dimension, T::dimension) = H1;
+        Matrix Hpoint = Matrix::Zero(n * T::dimension, traits<A2>::dimension);
+        Hpoint.middleRows(i * T::dimension, T::dimension) = H2;
+        (*H)[i + 1] = Hpoint;
+        error.segment(i * T::dimension, T::dimension) =
+            traits<T>::Local(measured_[i], predicted);
+      } else {
+        error.segment(i * T::dimension, T::dimension) =
+            traits<T>::Local(measured_[i], T::Measure(pose, point));
+      }
+    }
+    return error;
+  }
+
+  /// print
+  virtual void print(const std::string& s = "",
+                     const KeyFormatter& kf = DefaultKeyFormatter) const {
+    std::cout << s << "MultiBearingRangeFactor(" << measured_.size()
+              << " measurements)" << std::endl;
+    Base::print(s, kf);
+    for (size_t i = 0; i < measured_.size(); ++i)
+      measured_[i].print("measurement " + std::to_string(i) + ": ");
+  }
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& expected, double tol = 1e-9) const {
+    const This* e = dynamic_cast<const This*>(&expected);
+    if (!e || !Base::equals(expected, tol) ||
+        measured_.size() != e->measured_.size())
+      return false;
+    for (size_t i = 0; i < measured_.size(); ++i)
+      if (!measured_[i].equals(e->measured_[i], tol)) return false;
+    return true;
+  }
+
+ private:
+  /// Pair up separate bearing and range containers
+  static std::vector<T> Pair(const std::vector<B>& bearings,
+                             const std::vector<R>& ranges) {
+    if (bearings.size() != ranges.size())
+      throw std::invalid_argument(
+          "MultiBearingRangeFactor: number of bearings and ranges do not "
+          "match");
+    std::vector<T> measurements;
+    measurements.reserve(bearings.size());
+    for (size_t i = 0; i < bearings.size(); ++i)
+      measurements.push_back(T(bearings[i], ranges[i]));
+    return measurements;
+  }
+
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& boost::serialization::make_nvp(
+        "NoiseModelFactor", boost::serialization::base_object<Base>(*this));
+    ar& BOOST_SERIALIZATION_NVP(measured_);
+  }
+};  // MultiBearingRangeFactor
+
+/// traits
+template <typename A1, typename A2, typename B, typename R>
+struct traits<MultiBearingRangeFactor<A1, A2, B, R> >
+    : public Testable<MultiBearingRangeFactor<A1, A2, B, R> > {};
+
+}  // namespace gtsam
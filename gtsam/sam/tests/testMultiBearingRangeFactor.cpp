@@ -0,0 +1,104 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  testMultiBearingRangeFactor.cpp
+ *  @brief Unit tests for MultiBearingRangeFactor Class
+ *  @date Aug 2020
+ */
+
+#include <gtsam/sam/MultiBearingRangeFactor.h>
+#include <gtsam/sam/BearingRangeFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/nonlinear/factorTesting.h>
+#include <gtsam/base/serializationTestHelpers.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+Key poseKey(1);
+
+typedef MultiBearingRangeFactor<Pose2, Point2> MultiBearingRangeFactor2D;
+typedef BearingRangeFactor<Pose2, Point2> BearingRangeFactor2D;
+
+static const KeyVector kPointKeys{2, 3, 4};
+static const vector<Rot2> kBearings{Rot2(0.2), Rot2(-0.8), Rot2(1.5)};
+static const vector<double> kRanges{5.0, 11.0, 3.5};
+static SharedNoiseModel model2D(noiseModel::Isotropic::Sigma(6, 0.5));
+MultiBearingRangeFactor2D factor2D(poseKey, kPointKeys, kBearings, kRanges,
+                                   model2D);
+
+static Values exampleValues() {
+  Values values;
+  values.insert(poseKey, Pose2(1.0, 2.0, 0.57));
+  values.insert(kPointKeys[0], Point2(-4.0, 11.0));
+  values.insert(kPointKeys[1], Point2(6.0, -2.0));
+  values.insert(kPointKeys[2], Point2(2.5, 4.0));
+  return values;
+}
+
+/* ************************************************************************* */
+// Export Noisemodels
+// See http://www.boost.org/doc/libs/1_32_0/libs/serialization/doc/special.html
+BOOST_CLASS_EXPORT(gtsam::noiseModel::Isotropic);
+
+/* ************************************************************************* */
+TEST(MultiBearingRangeFactor, Constructor) {
+  EXPECT_LONGS_EQUAL(3, factor2D.nrMeasurements());
+  EXPECT_LONGS_EQUAL(4, factor2D.size());
+  EXPECT_LONGS_EQUAL(6, factor2D.dim());
+
+  // Mismatched key/measurement counts are rejected
+  CHECK_EXCEPTION(MultiBearingRangeFactor2D(poseKey, KeyVector{2, 3}, kBearings,
+                                            kRanges, model2D),
+                  std::invalid_argument);
+  CHECK_EXCEPTION(
+      MultiBearingRangeFactor2D(poseKey, kPointKeys, kBearings, kRanges,
+                                noiseModel::Isotropic::Sigma(4, 0.5)),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(MultiBearingRangeFactor, ErrorMatchesIndividualFactors) {
+  Values values = exampleValues();
+
+  // The batched factor must agree with a graph of per-measurement factors
+  static SharedNoiseModel single(noiseModel::Isotropic::Sigma(2, 0.5));
+  double expectedError = 0.0;
+  for (size_t i = 0; i < kBearings.size(); ++i) {
+    BearingRangeFactor2D factor(poseKey, kPointKeys[i], kBearings[i],
+                                kRanges[i], single);
+    expectedError += factor.error(values);
+  }
+  DOUBLES_EQUAL(expectedError, factor2D.error(values), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(MultiBearingRangeFactor, Jacobians) {
+  Values values = exampleValues();
+  EXPECT_CORRECT_FACTOR_JACOBIANS(factor2D, values, 1e-7, 1e-5);
+}
+
+/* ************************************************************************* */
+TEST(MultiBearingRangeFactor, Serialization2D) {
+  EXPECT(serializationTestHelpers::equalsObj(factor2D));
+  EXPECT(serializationTestHelpers::equalsXML(factor2D));
+  EXPECT(serializationTestHelpers::equalsBinary(factor2D));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
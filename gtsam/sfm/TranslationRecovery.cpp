@@ -88,6 +88,82 @@ Values TranslationRecovery::run(const double scale) const {
   return result;
 }
 
+Values TranslationRecovery::initializeIncremental(const double scale,
+                                                  size_t batchRefreshInterval) {
+  scale_ = scale;
+  batchRefreshInterval_ = batchRefreshInterval;
+  updatesSinceRefresh_ = 0;
+
+  // Solve the current edges in batch, then hand the solved system to ISAM2 so
+  // that update() only re-eliminates the part of the Bayes tree touched by
+  // new edges.
+  auto graph = buildGraph();
+  addPrior(scale, &graph);
+  LevenbergMarquardtOptimizer lm(graph, initalizeRandomly(), params_);
+  currentEstimate_ = lm.optimize();
+  isam_ = boost::make_shared<ISAM2>();
+  isam_->update(graph, currentEstimate_);
+  return currentEstimate_;
+}
+
+Values TranslationRecovery::update(const TranslationEdges& newEdges) {
+  if (!isam_)
+    throw std::runtime_error(
+        "TranslationRecovery::update: call initializeIncremental first.");
+
+  auto noiseModel = noiseModel::Isotropic::Sigma(3, 0.01);
+  NonlinearFactorGraph newFactors;
+  Values newValues;
+
+  // Look up a translation among both old and new estimates.
+  auto known = [this, &newValues](Key j) {
+    return currentEstimate_.exists(j) || newValues.exists(j);
+  };
+  auto estimate = [this, &newValues](Key j) {
+    return currentEstimate_.exists(j) ? currentEstimate_.at<Point3>(j)
+                                      : newValues.at<Point3>(j);
+  };
+
+  for (auto edge : newEdges) {
+    // Ignore edges whose KeyPair we already have a measurement for.
+    if (!relativeTranslations_.emplace(edge).second) continue;
+    Key a, b;
+    tie(a, b) = edge.first;
+    const Unit3 w_aZb = edge.second;
+    newFactors.emplace_shared<TranslationFactor>(a, b, w_aZb, noiseModel);
+
+    // Initialize unseen translations by stepping along the measured direction
+    // from a known endpoint, so we linearize close to the solution. If both
+    // endpoints are new we fall back to random initialization, as in batch.
+    if (!known(a)) {
+      newValues.insert<Point3>(a, known(b) ? estimate(b) - w_aZb.point3()
+                                           : Point3(Vector3::Random()));
+    }
+    if (!known(b)) {
+      newValues.insert<Point3>(b, estimate(a) + w_aZb.point3());
+    }
+  }
+
+  ++updatesSinceRefresh_;
+  if (updatesSinceRefresh_ >= batchRefreshInterval_) {
+    // Periodic batch refresh: re-solve the full problem with LM, warm started
+    // from the current estimate, to undo accumulated linearization error.
+    auto graph = buildGraph();
+    addPrior(scale_, &graph);
+    Values initial = currentEstimate_;
+    initial.insert(newValues);
+    LevenbergMarquardtOptimizer lm(graph, initial, params_);
+    currentEstimate_ = lm.optimize();
+    isam_ = boost::make_shared<ISAM2>();
+    isam_->update(graph, currentEstimate_);
+    updatesSinceRefresh_ = 0;
+  } else {
+    isam_->update(newFactors, newValues);
+    currentEstimate_ = isam_->calculateEstimate();
+  }
+  return currentEstimate_;
+}
+
 TranslationRecovery::TranslationEdges TranslationRecovery::SimulateMeasurements(
     const Values& poses, const vector<KeyPair>& edges) {
   TranslationEdges relativeTranslations;
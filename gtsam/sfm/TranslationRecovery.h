@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/geometry/Unit3.h>
+#include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/nonlinear/Values.h>
 
@@ -54,6 +55,13 @@ class TranslationRecovery {
   TranslationEdges relativeTranslations_;
   LevenbergMarquardtParams params_;
 
+  // Incremental mode state, see initializeIncremental/update below.
+  boost::shared_ptr<ISAM2> isam_;
+  Values currentEstimate_;
+  double scale_ = 1.0;
+  size_t batchRefreshInterval_ = 10;
+  size_t updatesSinceRefresh_ = 0;
+
  public:
   /**
    * @brief Construct a new Translation Recovery object
@@ -100,6 +108,35 @@ class TranslationRecovery {
    */
   Values run(const double scale = 1.0) const;
 
+  /**
+   * @brief Switch to incremental mode: solve the current edges in batch and
+   * keep the solved system around as an ISAM2 instance, so that subsequent
+   * calls to update() can fold in new edges without re-solving from scratch.
+   *
+   * @param scale scale for first relative translation which fixes gauge.
+   * @param batchRefreshInterval number of update() calls between full batch
+   * re-solves; in between, updates only re-eliminate the affected part of the
+   * maintained Bayes tree.
+   * @return Values the batch solution the incremental system starts from.
+   */
+  Values initializeIncremental(const double scale = 1.0,
+                               size_t batchRefreshInterval = 10);
+
+  /**
+   * @brief Fold new translation direction edges into the maintained system.
+   *
+   * New translations are initialized by stepping along the measured direction
+   * from an endpoint that already has an estimate, so ISAM2 linearizes close
+   * to the solution. Edges whose KeyPair was already given are ignored. Every
+   * batchRefreshInterval calls the full problem is re-solved with LM, warm
+   * started from the current estimate, to undo accumulated linearization
+   * error.
+   *
+   * @param newEdges new relative translation edges, as in the constructor.
+   * @return Values the updated estimate for all translations.
+   */
+  Values update(const TranslationEdges& newEdges);
+
   /**
    * @brief Simulate translation direction measurements
    *
@@ -84,6 +84,123 @@ public:
   GTSAM_MAKE_ALIGNED_OPERATOR_NEW
 };
 
+/**
+ * Factor that evaluates all epipolar errors p'Ep of a two-view pair at once.
+ * A pair easily yields 1000+ correspondences against the same essential
+ * matrix variable; one EssentialMatrixFactor each means as many virtual
+ * linearize calls and tiny 1*5 Jacobians.  This factor keeps the
+ * correspondences in a column-per-point layout and evaluates the residual
+ * and Jacobian with matrix-matrix kernels in a single fused pass, which is
+ * what two-view RANSAC refinement wants.
+ */
+class EssentialMatrixBatchFactor: public NoiseModelFactor1<EssentialMatrix> {
+
+  Matrix vAs_, vBs_; ///< Homogeneous versions, in ideal coordinates, one column per correspondence
+
+  typedef NoiseModelFactor1<EssentialMatrix> Base;
+  typedef EssentialMatrixBatchFactor This;
+
+public:
+
+  /**
+   *  Constructor
+   *  @param key Essential Matrix variable key
+   *  @param pAs points in first camera, in calibrated coordinates
+   *  @param pBs corresponding points in second camera, in calibrated coordinates
+   *  @param model noise model is about the dot products in ideal, homogeneous
+   *         coordinates, with dimension the number of correspondences
+   */
+  EssentialMatrixBatchFactor(Key key, const std::vector<Point2>& pAs,
+      const std::vector<Point2>& pBs, const SharedNoiseModel& model) :
+      Base(model, key) {
+    if (pAs.size() != pBs.size())
+      throw std::invalid_argument(
+          "EssentialMatrixBatchFactor: different number of points in the two cameras");
+    vAs_.resize(3, pAs.size());
+    vBs_.resize(3, pBs.size());
+    for (size_t i = 0; i < pAs.size(); i++) {
+      vAs_.col(i) = EssentialMatrix::Homogeneous(pAs[i]);
+      vBs_.col(i) = EssentialMatrix::Homogeneous(pBs[i]);
+    }
+  }
+
+  /**
+   *  Constructor
+   *  @param key Essential Matrix variable key
+   *  @param pAs points in first camera, in pixel coordinates
+   *  @param pBs corresponding points in second camera, in pixel coordinates
+   *  @param model noise model is about the dot products in ideal, homogeneous
+   *         coordinates, with dimension the number of correspondences
+   *  @param K calibration object, will be used only in constructor
+   */
+  template<class CALIBRATION>
+  EssentialMatrixBatchFactor(Key key, const std::vector<Point2>& pAs,
+      const std::vector<Point2>& pBs, const SharedNoiseModel& model,
+      boost::shared_ptr<CALIBRATION> K) :
+      Base(model, key) {
+    assert(K);
+    if (pAs.size() != pBs.size())
+      throw std::invalid_argument(
+          "EssentialMatrixBatchFactor: different number of points in the two cameras");
+    vAs_.resize(3, pAs.size());
+    vBs_.resize(3, pBs.size());
+    for (size_t i = 0; i < pAs.size(); i++) {
+      vAs_.col(i) = EssentialMatrix::Homogeneous(K->calibrate(pAs[i]));
+      vBs_.col(i) = EssentialMatrix::Homogeneous(K->calibrate(pBs[i]));
+    }
+  }
+
+  /// @return a deep copy of this factor
+  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// number of correspondences
+  size_t nrMeasurements() const {
+    return vAs_.cols();
+  }
+
+  /// print
+  virtual void print(const std::string& s = "",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+    Base::print(s);
+    std::cout << "  EssentialMatrixBatchFactor with " << nrMeasurements()
+        << " correspondences" << std::endl;
+  }
+
+  /// vector of errors returns one epipolar dot product per correspondence
+  Vector evaluateError(const EssentialMatrix& E, boost::optional<Matrix&> H =
+      boost::none) const {
+    const Matrix3 EMat = E.matrix();
+    if (H) {
+      // Row i is [vA' E skew(-vB), vA' skew(-R vB) basis], exactly as in
+      // EssentialMatrix::error, rewritten via x' skew(y) == (x x y)' so all
+      // rows come out of three matrix products and two columnwise crosses
+      H->resize(vAs_.cols(), 5);
+      H->leftCols<3>() = -cross(EMat.transpose() * vAs_, vBs_).transpose();
+      H->rightCols<2>() = -cross(vAs_, E.rotation().matrix() * vBs_).transpose()
+          * E.direction().basis();
+    }
+    return vAs_.cwiseProduct(EMat * vBs_).colwise().sum().transpose();
+  }
+
+private:
+
+  /// columnwise cross product of two 3*n matrices
+  static Matrix cross(const Matrix& a, const Matrix& b) {
+    Matrix c(3, a.cols());
+    c.row(0) = a.row(1).cwiseProduct(b.row(2)) - a.row(2).cwiseProduct(b.row(1));
+    c.row(1) = a.row(2).cwiseProduct(b.row(0)) - a.row(0).cwiseProduct(b.row(2));
+    c.row(2) = a.row(0).cwiseProduct(b.row(1)) - a.row(1).cwiseProduct(b.row(0));
+    return c;
+  }
+
+public:
+  GTSAM_MAKE_ALIGNED_OPERATOR_NEW
+};
+// EssentialMatrixBatchFactor
+
 /**
  * Binary factor that optimizes for E and inverse depth d: assumes measurement
  * in image 2 is perfect, and returns re-projection error in image 1
@@ -26,6 +26,7 @@
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/linear/BinaryJacobianFactor.h>
+#include <gtsam/linear/TernaryJacobianFactor.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/base/concepts.h>
 #include <gtsam/base/Manifold.h>
@@ -201,6 +202,9 @@ class GeneralSFMFactor2: public NoiseModelFactor3<Pose3, Point3, CALIBRATION> {
 
   GTSAM_CONCEPT_MANIFOLD_TYPE(CALIBRATION);
   static const int DimK = FixedDimension<CALIBRATION>::value;
+  typedef Eigen::Matrix<double, 2, 6> JacobianP;
+  typedef Eigen::Matrix<double, 2, 3> JacobianL;
+  typedef Eigen::Matrix<double, 2, DimK> JacobianK;
 
 protected:
 
@@ -272,6 +276,51 @@ public:
     return Z_2x1;
   }
 
+  /// Linearize using fixed-size matrices
+  boost::shared_ptr<GaussianFactor> linearize(const Values& values) const {
+    // Only linearize if the factor is active
+    if (!this->active(values)) return boost::shared_ptr<JacobianFactor>();
+
+    const Key key1 = this->key1(), key2 = this->key2(), key3 = this->key3();
+    JacobianP H1;
+    JacobianL H2;
+    JacobianK H3;
+    Vector2 b;
+    try {
+      const Pose3& pose = values.at<Pose3>(key1);
+      const Point3& point = values.at<Point3>(key2);
+      const CALIBRATION& calib = values.at<CALIBRATION>(key3);
+      Camera camera(pose, calib);
+      b = measured() - camera.project(point, H1, H2, H3);
+    } catch (CheiralityException& e) {
+      H1.setZero();
+      H2.setZero();
+      H3.setZero();
+      b.setZero();
+      // TODO warn if verbose output asked for
+    }
+
+    // Whiten the system if needed
+    const SharedNoiseModel& noiseModel = this->noiseModel();
+    if (noiseModel && !noiseModel->isUnit()) {
+      // TODO: implement WhitenSystem for fixed size matrices and include
+      // above
+      H1 = noiseModel->Whiten(H1);
+      H2 = noiseModel->Whiten(H2);
+      H3 = noiseModel->Whiten(H3);
+      b = noiseModel->Whiten(b);
+    }
+
+    // Create new (unit) noiseModel, preserving constraints if applicable
+    SharedDiagonal model;
+    if (noiseModel && noiseModel->isConstrained()) {
+      model = boost::static_pointer_cast<noiseModel::Constrained>(noiseModel)->unit();
+    }
+
+    return boost::make_shared<TernaryJacobianFactor<2, 6, 3, DimK> >(
+        key1, H1, key2, H2, key3, H3, b, model);
+  }
+
   /** return the measured */
   inline const Point2 measured() const {
     return measured_;
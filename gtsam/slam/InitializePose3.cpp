@@ -26,6 +26,11 @@
 
 #include <boost/math/special_functions.hpp>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 using namespace std;
 
 namespace gtsam {
@@ -35,33 +40,51 @@ static const Key kAnchorKey = symbol('Z', 9999999);
 /* ************************************************************************* */
 GaussianFactorGraph InitializePose3::buildLinearOrientationGraph(const NonlinearFactorGraph& g) {
 
+  // one relaxed factor per measurement, plus the anchor prior in the last
+  // slot, so each measurement can be processed independently
   GaussianFactorGraph linearGraph;
+  linearGraph.resize(g.size() + 1);
+
+  auto buildRange = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i != end; ++i) {
+      const auto& factor = g[i];
+      Matrix3 Rij;
+      double rotationPrecision = 1.0;
+
+      auto pose3Between = boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(factor);
+      if (pose3Between){
+        Rij = pose3Between->measured().rotation().matrix();
+        Vector precisions = Vector::Zero(6);
+        precisions[0] = 1.0; // vector of all zeros except first entry equal to 1
+        pose3Between->noiseModel()->whitenInPlace(precisions); // gets marginal precision of first variable
+        rotationPrecision = precisions[0]; // rotations first
+      }else{
+        cout << "Error in buildLinearOrientationGraph" << endl;
+      }
 
-  for(const auto& factor: g) {
-    Matrix3 Rij;
-    double rotationPrecision = 1.0;
-
-    auto pose3Between = boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(factor);
-    if (pose3Between){
-      Rij = pose3Between->measured().rotation().matrix();
-      Vector precisions = Vector::Zero(6);
-      precisions[0] = 1.0; // vector of all zeros except first entry equal to 1
-      pose3Between->noiseModel()->whitenInPlace(precisions); // gets marginal precision of first variable
-      rotationPrecision = precisions[0]; // rotations first
-    }else{
-      cout << "Error in buildLinearOrientationGraph" << endl;
+      const auto& keys = factor->keys();
+      Key key1 = keys[0], key2 = keys[1];
+      Matrix M9 = Z_9x9;
+      M9.block(0,0,3,3) = Rij;
+      M9.block(3,3,3,3) = Rij;
+      M9.block(6,6,3,3) = Rij;
+      linearGraph[i] = boost::make_shared<JacobianFactor>(
+          key1, -I_9x9, key2, M9, Z_9x1,
+          noiseModel::Isotropic::Precision(9, rotationPrecision));
     }
+  };
+
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, g.size()),
+      [&buildRange](const tbb::blocked_range<size_t>& range) {
+        buildRange(range.begin(), range.end());
+      });
+#else
+  buildRange(0, g.size());
+#endif
 
-    const auto& keys = factor->keys();
-    Key key1 = keys[0], key2 = keys[1];
-    Matrix M9 = Z_9x9;
-    M9.block(0,0,3,3) = Rij;
-    M9.block(3,3,3,3) = Rij;
-    M9.block(6,6,3,3) = Rij;
-    linearGraph.add(key1, -I_9x9, key2, M9, Z_9x1, noiseModel::Isotropic::Precision(9, rotationPrecision));
-  }
   // prior on the anchor orientation
-  linearGraph.add(
+  linearGraph[g.size()] = boost::make_shared<JacobianFactor>(
       kAnchorKey, I_9x9,
       (Vector(9) << 1.0, 0.0, 0.0, /*  */ 0.0, 1.0, 0.0, /*  */ 0.0, 0.0, 1.0)
           .finished(),
@@ -94,13 +117,16 @@ Values InitializePose3::normalizeRelaxedRotations(
 NonlinearFactorGraph InitializePose3::buildPose3graph(const NonlinearFactorGraph& graph) {
   gttic(InitializePose3_buildPose3graph);
   NonlinearFactorGraph pose3Graph;
+  pose3Graph.reserve(graph.size());
 
   for(const auto& factor: graph) {
 
     // recast to a between on Pose3
     const auto pose3Between = boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(factor);
-    if (pose3Between)
+    if (pose3Between) {
       pose3Graph.add(pose3Between);
+      continue;
+    }
 
     // recast PriorFactor<Pose3> to BetweenFactor<Pose3>
     const auto pose3Prior = boost::dynamic_pointer_cast<PriorFactor<Pose3> >(factor);
@@ -56,6 +56,27 @@ T FindKarcherMean(std::initializer_list<T>&& rotations) {
   return FindKarcherMeanImpl(std::vector<T, Eigen::aligned_allocator<T> >(rotations));
 }
 
+template <class T, class ALLOC>
+Matrix KarcherTangents(const T& mean, const std::vector<T, ALLOC>& rotations) {
+  const size_t n = rotations.size();
+  Matrix tangents(traits<T>::GetDimension(mean), n);
+  for (size_t i = 0; i < n; i++)
+    tangents.col(i) = traits<T>::Local(mean, rotations[i]);
+  return tangents;
+}
+
+template <class T>
+template <class ALLOC>
+double IncrementalKarcherMean<T>::update(
+    const std::vector<T, ALLOC>& rotations) {
+  if (rotations.empty())
+    throw std::invalid_argument(
+        "IncrementalKarcherMean::update needs at least one rotation.");
+  const Vector correction = KarcherTangents(mean_, rotations).rowwise().mean();
+  mean_ = traits<T>::Retract(mean_, correction);
+  return correction.norm();
+}
+
 template <class T>
 template <typename CONTAINER>
 KarcherMeanFactor<T>::KarcherMeanFactor(const CONTAINER& keys, int d)
@@ -35,6 +35,46 @@ T FindKarcherMean(const std::vector<T, Eigen::aligned_allocator<T>>& rotations);
 template <class T>
 T FindKarcherMean(std::initializer_list<T>&& rotations);
 
+/**
+ * Project all rotations into the tangent space about the given mean in one
+ * batched pass, returning a d*n matrix with one tangent vector per column.
+ */
+template <class T, class ALLOC>
+Matrix KarcherTangents(const T& mean, const std::vector<T, ALLOC>& rotations);
+
+/**
+ * Maintains the Karcher mean of a rotation set incrementally across optimizer
+ * iterations.  FindKarcherMean restarts a full Gauss-Newton optimization from
+ * the identity on every call, which dominates iteration time for gauge
+ * constraints over many thousands of rotations.  Since the rotations move
+ * only slightly between optimizer iterations, warm-starting from the previous
+ * mean and applying a single fixed-point correction step
+ *   mean <- retract(mean, average of tangents about mean)
+ * tracks the mean to the same accuracy at a fraction of the cost.
+ */
+template <class T>
+class IncrementalKarcherMean {
+  T mean_;
+
+ public:
+  /// Construct with an initial guess for the mean (defaults to identity)
+  explicit IncrementalKarcherMean(const T& initial = T()) : mean_(initial) {}
+
+  /// The current mean estimate
+  const T& mean() const { return mean_; }
+
+  /**
+   * One correction step towards the Karcher mean of the given rotations,
+   * warm-started from the current estimate, using the batched tangent-space
+   * projection KarcherTangents.
+   * @return the norm of the applied tangent-space correction, which vanishes
+   * at the exact mean; iterate update() to convergence for a cold start.
+   */
+  template <class ALLOC>
+  double update(const std::vector<T, ALLOC>& rotations);
+};
+// \IncrementalKarcherMean
+
 /**
  * The KarcherMeanFactor creates a constraint on all SO(n) variables with
  * given keys that the Karcher mean (see above) will stay the same. Note the
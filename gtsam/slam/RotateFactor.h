@@ -115,5 +115,85 @@ public:
 
   GTSAM_MAKE_ALIGNED_OPERATOR_NEW
 };
+
+/**
+ * Factor on unknown rotation iRc constrained by many direction pairs at once.
+ * Functionally equivalent to one RotateDirectionsFactor per pair, but the
+ * directions are stored as 3*N matrices and the tangent bases of the
+ * predicted directions are precomputed and stacked at construction, so every
+ * linearization is a single 3*3 by 3*N product plus small fixed-size
+ * per-pair products - no per-measurement basis computation or locking.
+ * Useful for direction-rich calibration problems with hundreds of pairs.
+ */
+class RotateDirectionsBatchFactor: public NoiseModelFactor1<Rot3> {
+
+  Matrix ps_, zs_; ///< Predicted and measured directions, one column per pair
+  Matrix Bts_;     ///< Stacked transposed bases of the predicted directions, 2N x 3
+
+  typedef NoiseModelFactor1<Rot3> Base;
+  typedef RotateDirectionsBatchFactor This;
+
+public:
+
+  /// Construct from parallel lists of predicted and measured directions,
+  /// i_ps[i] = iRc * c_zs[i].  The noise model dimension must be 2N.
+  RotateDirectionsBatchFactor(Key key, const std::vector<Unit3>& i_ps,
+      const std::vector<Unit3>& c_zs, const SharedNoiseModel& model) :
+      Base(model, key) {
+    if (i_ps.size() != c_zs.size())
+      throw std::invalid_argument(
+          "RotateDirectionsBatchFactor: different number of predicted "
+          "and measured directions");
+    const size_t n = i_ps.size();
+    ps_.resize(3, n);
+    zs_.resize(3, n);
+    Bts_.resize(2 * n, 3);
+    for (size_t i = 0; i < n; i++) {
+      ps_.col(i) = i_ps[i].unitVector();
+      zs_.col(i) = c_zs[i].unitVector();
+      i_ps[i].precomputeBasis();
+      Bts_.middleRows<2>(2 * i) = i_ps[i].basis().transpose();
+    }
+  }
+
+  /// Number of direction pairs
+  size_t nrMeasurements() const {
+    return zs_.cols();
+  }
+
+  /// @return a deep copy of this factor
+  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this))); }
+
+  /// print
+  virtual void print(const std::string& s = "",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+    Base::print(s);
+    std::cout << "RotateDirectionsBatchFactor with " << nrMeasurements()
+        << " direction pairs" << std::endl;
+  }
+
+  /// vector of errors returns 2N vector, rows 2i,2i+1 match the error of
+  /// RotateDirectionsFactor(key, i_ps[i], c_zs[i], ...)
+  Vector evaluateError(const Rot3& iRc, boost::optional<Matrix&> H =
+      boost::none) const {
+    const Matrix3 R = iRc.matrix();
+    const Matrix Q = R * zs_; // all rotated directions in one product
+    const DenseIndex n = zs_.cols();
+    Vector error(2 * n);
+    if (H)
+      H->resize(2 * n, 3);
+    for (DenseIndex i = 0; i < n; i++) {
+      const Matrix23 Bt = Bts_.middleRows<2>(2 * i);
+      error.segment<2>(2 * i) = Bt * Q.col(i);
+      if (H)
+        H->middleRows<2>(2 * i) = -Bt * R * skewSymmetric(zs_.col(i));
+    }
+    return error;
+  }
+
+  GTSAM_MAKE_ALIGNED_OPERATOR_NEW
+};
 }  // namespace gtsam
 
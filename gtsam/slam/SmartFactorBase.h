@@ -80,6 +80,12 @@ protected:
   // Cache for Fblocks, to avoid a malloc ever time we re-linearize
   mutable FBlocks Fs;
 
+  // Workspace for E and b, reused across re-linearizations for the same
+  // reason. Like Fs this is safe under TBB, which parallelizes over factors,
+  // so a factor is only ever linearized by one thread at a time.
+  mutable Matrix E_;
+  mutable Vector b_;
+
  public:
   GTSAM_MAKE_ALIGNED_OPERATOR_NEW
 
@@ -284,13 +290,12 @@ protected:
   void computeJacobiansSVD(FBlocks& Fs, Matrix& Enull,
       Vector& b, const Cameras& cameras, const POINT& point) const {
 
-    Matrix E;
-    computeJacobians(Fs, E, b, cameras, point);
+    computeJacobians(Fs, E_, b, cameras, point);
 
     static const int N = FixedDimension<POINT>::value; // 2 (Unit3) or 3 (Point3)
 
     // Do SVD on A
-    Eigen::JacobiSVD<Matrix> svd(E, Eigen::ComputeFullU);
+    Eigen::JacobiSVD<Matrix> svd(E_, Eigen::ComputeFullU);
     Vector s = svd.singularValues();
     size_t m = this->keys_.size();
     Enull = svd.matrixU().block(0, N, ZDim * m, ZDim * m - N); // last ZDim*m-N columns
@@ -301,12 +306,10 @@ protected:
       const Cameras& cameras, const Point3& point, const double lambda = 0.0,
       bool diagonalDamping = false) const {
 
-    Matrix E;
-    Vector b;
-    computeJacobians(Fs, E, b, cameras, point);
+    computeJacobians(Fs, E_, b_, cameras, point);
 
     // build augmented hessian
-    SymmetricBlockMatrix augmentedHessian = Cameras::SchurComplement(Fs, E, b);
+    SymmetricBlockMatrix augmentedHessian = Cameras::SchurComplement(Fs, E_, b_);
 
     return boost::make_shared<RegularHessianFactor<Dim> >(keys_,
         augmentedHessian);
@@ -321,10 +324,8 @@ protected:
       const double lambda, bool diagonalDamping,
       SymmetricBlockMatrix& augmentedHessian,
       const KeyVector allKeys) const {
-    Matrix E;
-    Vector b;
-    computeJacobians(Fs, E, b, cameras, point);
-    Cameras::UpdateSchurComplement(Fs, E, b, allKeys, keys_, augmentedHessian);
+    computeJacobians(Fs, E_, b_, cameras, point);
+    Cameras::UpdateSchurComplement(Fs, E_, b_, allKeys, keys_, augmentedHessian);
   }
 
   /// Whiten the Jacobians computed by computeJacobians using noiseModel_
@@ -339,14 +340,11 @@ protected:
   boost::shared_ptr<RegularImplicitSchurFactor<CAMERA> > //
   createRegularImplicitSchurFactor(const Cameras& cameras, const Point3& point,
       double lambda = 0.0, bool diagonalDamping = false) const {
-    Matrix E;
-    Vector b;
-    FBlocks F;
-    computeJacobians(F, E, b, cameras, point);
-    whitenJacobians(F, E, b);
-    Matrix P = Cameras::PointCov(E, lambda, diagonalDamping);
-    return boost::make_shared<RegularImplicitSchurFactor<CAMERA> >(keys_, F, E,
-        P, b);
+    computeJacobians(Fs, E_, b_, cameras, point);
+    whitenJacobians(Fs, E_, b_);
+    Matrix P = Cameras::PointCov(E_, lambda, diagonalDamping);
+    return boost::make_shared<RegularImplicitSchurFactor<CAMERA> >(keys_, Fs,
+        E_, P, b_);
   }
 
   /**
@@ -355,14 +353,12 @@ protected:
   boost::shared_ptr<JacobianFactorQ<Dim, ZDim> > createJacobianQFactor(
       const Cameras& cameras, const Point3& point, double lambda = 0.0,
       bool diagonalDamping = false) const {
-    Matrix E;
-    Vector b;
-    FBlocks F;
-    computeJacobians(F, E, b, cameras, point);
-    const size_t M = b.size();
-    Matrix P = Cameras::PointCov(E, lambda, diagonalDamping);
+    computeJacobians(Fs, E_, b_, cameras, point);
+    const size_t M = b_.size();
+    Matrix P = Cameras::PointCov(E_, lambda, diagonalDamping);
     SharedIsotropic n = noiseModel::Isotropic::Sigma(M, noiseModel_->sigma());
-    return boost::make_shared<JacobianFactorQ<Dim, ZDim> >(keys_, F, E, P, b, n);
+    return boost::make_shared<JacobianFactorQ<Dim, ZDim> >(keys_, Fs, E_, P, b_,
+        n);
   }
 
   /**
@@ -372,14 +368,13 @@ protected:
   boost::shared_ptr<JacobianFactor> createJacobianSVDFactor(
       const Cameras& cameras, const Point3& point, double lambda = 0.0) const {
     size_t m = this->keys_.size();
-    FBlocks F;
-    Vector b;
     const size_t M = ZDim * m;
     Matrix E0(M, M - 3);
-    computeJacobiansSVD(F, E0, b, cameras, point);
+    computeJacobiansSVD(Fs, E0, b_, cameras, point);
     SharedIsotropic n = noiseModel::Isotropic::Sigma(M - 3,
         noiseModel_->sigma());
-    return boost::make_shared<JacobianFactorSVD<Dim, ZDim> >(keys_, F, E0, b, n);
+    return boost::make_shared<JacobianFactorSVD<Dim, ZDim> >(keys_, Fs, E0, b_,
+        n);
   }
 
   /// Create BIG block-diagonal matrix F from Fblocks
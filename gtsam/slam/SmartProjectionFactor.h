@@ -28,6 +28,7 @@
 
 #include <boost/optional.hpp>
 #include <boost/make_shared.hpp>
+#include <limits>
 #include <vector>
 
 namespace gtsam {
@@ -62,6 +63,8 @@ protected:
   /// @{
   mutable TriangulationResult result_; ///< result from triangulateSafe
   mutable std::vector<Pose3, Eigen::aligned_allocator<Pose3> > cameraPosesTriangulation_; ///< current triangulation poses
+  mutable Matrix4 triangulationATA_; ///< cached DLT normal equations A'A for the poses above
+  mutable bool triangulationATAValid_; ///< whether triangulationATA_ matches cameraPosesTriangulation_
   /// @}
 
 public:
@@ -75,7 +78,7 @@ public:
   /**
    * Default constructor, only for serialization
    */
-  SmartProjectionFactor() {}
+  SmartProjectionFactor() : triangulationATAValid_(false) {}
 
   /**
    * Constructor
@@ -87,7 +90,8 @@ public:
       const SmartProjectionParams& params = SmartProjectionParams())
       : Base(sharedNoiseModel),
         params_(params),
-        result_(TriangulationResult::Degenerate()) {}
+        result_(TriangulationResult::Degenerate()),
+        triangulationATAValid_(false) {}
 
   /** Virtual destructor */
   virtual ~SmartProjectionFactor() {
@@ -152,6 +156,20 @@ public:
     return retriangulate; // if we arrive to this point all poses are the same and we don't need re-triangulation
   }
 
+  /// Check if the new cameras only append measurements to the ones we last
+  /// triangulated with, i.e. the old poses are unchanged (up to tolerance)
+  bool decideIfAppend(const Cameras& cameras) const {
+    if (!triangulationATAValid_ || !result_.valid()
+        || cameraPosesTriangulation_.size() < 2
+        || cameras.size() <= cameraPosesTriangulation_.size())
+      return false;
+    for (size_t i = 0; i < cameraPosesTriangulation_.size(); i++)
+      if (!cameras[i].pose().equals(cameraPosesTriangulation_[i],
+          params_.retriangulationThreshold))
+        return false;
+    return true;
+  }
+
   /// triangulateSafe
   TriangulationResult triangulateSafe(const Cameras& cameras) const {
 
@@ -159,13 +177,98 @@ public:
     if (m < 2) // if we have a single pose the corresponding factor is uninformative
       return TriangulationResult::Degenerate();
 
+    if (decideIfAppend(cameras)) {
+      // Measurements were only appended since the last triangulation: fold the
+      // new DLT rows into the cached normal equations and re-solve the 4x4
+      // eigenproblem instead of re-triangulating from scratch
+      for (size_t i = cameraPosesTriangulation_.size(); i < m; i++) {
+        triangulationNormalEquationsAppend(triangulationATA_,
+            CameraProjectionMatrix<typename CAMERA::CalibrationType>(
+                cameras[i].calibration())(cameras[i].pose()),
+            this->measured_.at(i));
+        cameraPosesTriangulation_.push_back(cameras[i].pose());
+      }
+      try {
+        Vector4 v = triangulateHomogeneousFromNormalEquations(
+            triangulationATA_, params_.triangulation.rankTolerance);
+        Point3 point(v.head<3>() / v[3]);
+        result_ = checkTriangulatedPoint(cameras, this->measured_,
+            params_.triangulation, point);
+      } catch (TriangulationUnderconstrainedException&) {
+        result_ = TriangulationResult::Degenerate();
+      }
+      return result_;
+    }
+
+    // Warm start is possible if we triangulated the same cameras before,
+    // e.g. in the previous LM iteration; decideIfTriangulate overwrites the
+    // stored poses, so check before calling it
+    const bool canWarmStart = result_.valid()
+        && m == cameraPosesTriangulation_.size();
+
     bool retriangulate = decideIfTriangulate(cameras);
-    if (retriangulate)
-      result_ = gtsam::triangulateSafe(cameras, this->measured_,
-          params_.triangulation);
+    if (retriangulate) {
+      // The poses moved: refine the previous point with a few Gauss-Newton
+      // steps first, which in late iterations that barely move is much
+      // cheaper than the full DLT pipeline; fall back to it if refinement
+      // does not converge or the point fails the quality checks
+      if (!canWarmStart || !refineCachedPoint(cameras)) {
+        result_ = gtsam::triangulateSafe(cameras, this->measured_,
+            params_.triangulation);
+      }
+      // Refresh the cached normal equations so later appends start from here
+      triangulationATA_.setZero();
+      for (size_t i = 0; i < m; i++)
+        triangulationNormalEquationsAppend(triangulationATA_,
+            CameraProjectionMatrix<typename CAMERA::CalibrationType>(
+                cameras[i].calibration())(cameras[i].pose()),
+            this->measured_.at(i));
+      triangulationATAValid_ = true;
+    }
     return result_;
   }
 
+  /// Refine the previously triangulated point for slightly moved cameras by
+  /// Gauss-Newton on the reprojection error, instead of re-triangulating
+  /// from scratch.  Returns false - leaving result_ untouched - if the
+  /// refinement does not converge or the refined point fails the usual
+  /// quality checks, in which case the caller runs the full pipeline.
+  bool refineCachedPoint(const Cameras& cameras) const {
+    static const size_t kMaxSteps = 3;
+    static const double kConvergedNorm = 1e-6;
+    Point3 point = *result_;
+    try {
+      double deltaNorm = std::numeric_limits<double>::infinity();
+      for (size_t step = 0; step < kMaxSteps && deltaNorm > kConvergedNorm;
+          ++step) {
+        Matrix3 H = Matrix3::Zero();
+        Vector3 g = Vector3::Zero();
+        for (size_t i = 0; i < cameras.size(); i++) {
+          Eigen::Matrix<double, Base::ZDim, 3> E;
+          const Vector residual = cameras[i].project2(point, boost::none, E)
+              - this->measured_.at(i);
+          H.noalias() += E.transpose() * E;
+          g.noalias() -= E.transpose() * residual;
+        }
+        const Vector3 delta = H.ldlt().solve(g);
+        if (!delta.allFinite())
+          return false;
+        point = point + Point3(delta);
+        deltaNorm = delta.norm();
+      }
+      if (deltaNorm > kConvergedNorm)
+        return false; // the cameras moved too much for a warm start
+      TriangulationResult refined = checkTriangulatedPoint(cameras,
+          this->measured_, params_.triangulation, point);
+      if (!refined.valid())
+        return false;
+      result_ = refined;
+      return true;
+    } catch (CheiralityException&) {
+      return false; // the previous point fell behind a moved camera
+    }
+  }
+
   /// triangulate
   bool triangulateForLinearize(const Cameras& cameras) const {
     triangulateSafe(cameras); // imperative, might reset result_
@@ -458,7 +561,8 @@ public:
       const SmartProjectionParams& params = SmartProjectionParams())
       : Base(sharedNoiseModel, body_P_sensor),
         params_(params),
-        result_(TriangulationResult::Degenerate()) {}
+        result_(TriangulationResult::Degenerate()),
+        triangulationATAValid_(false) {}
   /// @}
 #endif
 
@@ -472,6 +576,8 @@ public:
     ar & BOOST_SERIALIZATION_NVP(params_);
     ar & BOOST_SERIALIZATION_NVP(result_);
     ar & BOOST_SERIALIZATION_NVP(cameraPosesTriangulation_);
+    ar & BOOST_SERIALIZATION_NVP(triangulationATA_);
+    ar & BOOST_SERIALIZATION_NVP(triangulationATAValid_);
   }
 }
 ;
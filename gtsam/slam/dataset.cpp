@@ -37,9 +37,18 @@
 #include <boost/assign/list_inserter.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/optional.hpp>
 
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -227,31 +236,12 @@ GraphAndValues load2D(const string& filename, SharedNoiseModel model, Key maxID,
   if (!is)
     throw invalid_argument("load2D: can not find file " + filename);
 
-  Values::shared_ptr initial(new Values);
+  // load the poses; vertex lines go through the two-phase parallel parser
+  Values::shared_ptr initial = parseVerticesParallel(filename, false, maxID);
   NonlinearFactorGraph::shared_ptr graph(new NonlinearFactorGraph);
 
   string tag;
 
-  // load the poses
-  while (!is.eof()) {
-    if (!(is >> tag))
-      break;
-
-    const auto indexed_pose = parseVertex(is, tag);
-    if (indexed_pose) {
-      Key id = indexed_pose->first;
-
-      // optional filter
-      if (maxID && id >= maxID)
-        continue;
-
-      initial->insert(id, indexed_pose->second);
-    }
-    is.ignore(LINESIZE, '\n');
-  }
-  is.clear(); /* clears the end-of-file and error flags */
-  is.seekg(0, ios::beg);
-
   // If asked, create a sampler with random number generator
   std::unique_ptr<Sampler> sampler;
   if (addNoise) {
@@ -510,6 +500,213 @@ void writeG2o(const NonlinearFactorGraph& graph, const Values& estimate,
   stream.close();
 }
 
+/* ************************************************************************* */
+// Fixed-size records for the binary g2o companion format.  All fields are
+// 8 bytes wide, so the on-disk layout has no padding and whole arrays of
+// records can be read and written in single I/O calls.
+namespace {
+
+struct BinaryVertex2 {
+  uint64_t key;
+  double x, y, theta;
+};
+
+struct BinaryVertex3 {
+  uint64_t key;
+  double t[3];
+  double q[4]; // x, y, z, w
+};
+
+struct BinaryEdge2 {
+  uint64_t key1, key2;
+  double x, y, theta;
+  double info[6]; // upper triangle of the 3x3 information matrix
+};
+
+struct BinaryEdge3 {
+  uint64_t key1, key2;
+  double t[3];
+  double q[4]; // x, y, z, w
+  double info[21]; // upper triangle of the 6x6 information matrix
+};
+
+const char binaryG2oMagic[8] = { 'G', 'T', 'S', 'A', 'M', 'G', '2', 'O' };
+const uint64_t binaryG2oVersion = 1;
+
+template <typename RECORD>
+void writeRecords(ostream& stream, const std::vector<RECORD>& records) {
+  const uint64_t n = records.size();
+  stream.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  if (n > 0)
+    stream.write(reinterpret_cast<const char*>(records.data()),
+        n * sizeof(RECORD));
+}
+
+template <typename RECORD>
+void readRecords(istream& stream, std::vector<RECORD>& records) {
+  uint64_t n = 0;
+  stream.read(reinterpret_cast<char*>(&n), sizeof(n));
+  records.resize(n);
+  if (n > 0)
+    stream.read(reinterpret_cast<char*>(records.data()), n * sizeof(RECORD));
+}
+
+// Extract the information matrix as writeG2o does, throwing on non-Gaussian models
+Matrix infoFromNoiseModel(const SharedNoiseModel& model) {
+  auto gaussianModel = boost::dynamic_pointer_cast<noiseModel::Gaussian>(model);
+  if (!gaussianModel) {
+    model->print("model\n");
+    throw invalid_argument("saveG2oBinary: invalid noise model!");
+  }
+  return gaussianModel->R().transpose() * gaussianModel->R();
+}
+
+} // namespace
+
+static Rot3 NormalizedRot3(double w, double x, double y, double z); // defined below
+
+/* ************************************************************************* */
+void saveG2oBinary(const NonlinearFactorGraph& graph, const Values& estimate,
+    const string& filename) {
+
+  // Gather the same content writeG2o emits, as fixed-size records
+  std::vector<BinaryVertex2> vertices2;
+  std::vector<BinaryVertex3> vertices3;
+  for (const auto& key_value : estimate) {
+    if (auto p = dynamic_cast<const GenericValue<Pose2>*>(&key_value.value)) {
+      const Pose2& pose = p->value();
+      vertices2.push_back(BinaryVertex2{key_value.key, pose.x(), pose.y(), pose.theta()});
+    } else if (auto p = dynamic_cast<const GenericValue<Pose3>*>(&key_value.value)) {
+      const Pose3& pose = p->value();
+      const Point3 t = pose.translation();
+      const auto q = pose.rotation().toQuaternion();
+      BinaryVertex3 vertex;
+      vertex.key = key_value.key;
+      vertex.t[0] = t.x(); vertex.t[1] = t.y(); vertex.t[2] = t.z();
+      vertex.q[0] = q.x(); vertex.q[1] = q.y(); vertex.q[2] = q.z(); vertex.q[3] = q.w();
+      vertices3.push_back(vertex);
+    }
+  }
+
+  std::vector<BinaryEdge2> edges2;
+  std::vector<BinaryEdge3> edges3;
+  for (const auto& factor_ : graph) {
+    if (auto factor = boost::dynamic_pointer_cast<BetweenFactor<Pose2> >(factor_)) {
+      const Matrix Info = infoFromNoiseModel(factor->noiseModel());
+      const Pose2& pose = factor->measured();
+      BinaryEdge2 edge;
+      edge.key1 = factor->key1(); edge.key2 = factor->key2();
+      edge.x = pose.x(); edge.y = pose.y(); edge.theta = pose.theta();
+      size_t k = 0;
+      for (int i = 0; i < 3; i++)
+        for (int j = i; j < 3; j++)
+          edge.info[k++] = Info(i, j);
+      edges2.push_back(edge);
+    } else if (auto factor3D = boost::dynamic_pointer_cast<BetweenFactor<Pose3> >(factor_)) {
+      const Matrix Info = infoFromNoiseModel(factor3D->noiseModel());
+      const Pose3& pose3D = factor3D->measured();
+      const Point3 p = pose3D.translation();
+      const auto q = pose3D.rotation().toQuaternion();
+      BinaryEdge3 edge;
+      edge.key1 = factor3D->key1(); edge.key2 = factor3D->key2();
+      edge.t[0] = p.x(); edge.t[1] = p.y(); edge.t[2] = p.z();
+      edge.q[0] = q.x(); edge.q[1] = q.y(); edge.q[2] = q.z(); edge.q[3] = q.w();
+      size_t k = 0;
+      for (int i = 0; i < 6; i++)
+        for (int j = i; j < 6; j++)
+          edge.info[k++] = Info(i, j); // gtsam block order, no g2o reshuffle
+      edges3.push_back(edge);
+    }
+  }
+
+  ofstream stream(filename.c_str(), ios::binary);
+  if (!stream.is_open())
+    throw invalid_argument("saveG2oBinary: can not open file " + filename);
+  stream.write(binaryG2oMagic, sizeof(binaryG2oMagic));
+  stream.write(reinterpret_cast<const char*>(&binaryG2oVersion), sizeof(binaryG2oVersion));
+  writeRecords(stream, vertices2);
+  writeRecords(stream, vertices3);
+  writeRecords(stream, edges2);
+  writeRecords(stream, edges3);
+}
+
+/* ************************************************************************* */
+GraphAndValues loadG2oBinary(const string& filename) {
+  ifstream stream(filename.c_str(), ios::binary);
+  if (!stream.is_open())
+    throw invalid_argument("loadG2oBinary: can not find file " + filename);
+
+  char magic[8];
+  uint64_t version = 0;
+  stream.read(magic, sizeof(magic));
+  stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!stream || memcmp(magic, binaryG2oMagic, sizeof(magic)) != 0)
+    throw invalid_argument("loadG2oBinary: " + filename + " is not a gtsam binary g2o file");
+  if (version != binaryG2oVersion)
+    throw invalid_argument("loadG2oBinary: unsupported file version in " + filename);
+
+  std::vector<BinaryVertex2> vertices2;
+  std::vector<BinaryVertex3> vertices3;
+  std::vector<BinaryEdge2> edges2;
+  std::vector<BinaryEdge3> edges3;
+  readRecords(stream, vertices2);
+  readRecords(stream, vertices3);
+  readRecords(stream, edges2);
+  readRecords(stream, edges3);
+  if (!stream)
+    throw invalid_argument("loadG2oBinary: " + filename + " is truncated");
+
+  Values::shared_ptr initial(new Values);
+  for (const BinaryVertex2& vertex : vertices2)
+    initial->insert(vertex.key, Pose2(vertex.x, vertex.y, vertex.theta));
+  for (const BinaryVertex3& vertex : vertices3)
+    initial->insert(vertex.key,
+        Pose3(NormalizedRot3(vertex.q[3], vertex.q[0], vertex.q[1], vertex.q[2]),
+            Point3(vertex.t[0], vertex.t[1], vertex.t[2])));
+
+  NonlinearFactorGraph::shared_ptr graph(new NonlinearFactorGraph);
+  graph->reserve(edges2.size() + edges3.size());
+  for (const BinaryEdge2& edge : edges2) {
+    Matrix3 Info;
+    size_t k = 0;
+    for (int i = 0; i < 3; i++)
+      for (int j = i; j < 3; j++)
+        Info(i, j) = Info(j, i) = edge.info[k++];
+    graph->emplace_shared<BetweenFactor<Pose2> >(edge.key1, edge.key2,
+        Pose2(edge.x, edge.y, edge.theta), noiseModel::Gaussian::Information(Info));
+  }
+  for (const BinaryEdge3& edge : edges3) {
+    Matrix6 Info;
+    size_t k = 0;
+    for (int i = 0; i < 6; i++)
+      for (int j = i; j < 6; j++)
+        Info(i, j) = Info(j, i) = edge.info[k++];
+    graph->emplace_shared<BetweenFactor<Pose3> >(edge.key1, edge.key2,
+        Pose3(NormalizedRot3(edge.q[3], edge.q[0], edge.q[1], edge.q[2]),
+            Point3(edge.t[0], edge.t[1], edge.t[2])),
+        noiseModel::Gaussian::Information(Info));
+  }
+
+  return make_pair(graph, initial);
+}
+
+/* ************************************************************************* */
+std::future<void> writeG2oAsync(const NonlinearFactorGraph& graph,
+    const Values& estimate, const string& filename, bool binary) {
+  // Snapshot on the calling thread: the graph copy shares the immutable
+  // factors and the Values copy clones the estimate, so the caller is free to
+  // keep updating both while the checkpoint is formatted and written.
+  auto graphSnapshot = boost::make_shared<NonlinearFactorGraph>(graph);
+  auto estimateSnapshot = boost::make_shared<Values>(estimate);
+  return std::async(std::launch::async,
+      [graphSnapshot, estimateSnapshot, filename, binary]() {
+        if (binary)
+          saveG2oBinary(*graphSnapshot, *estimateSnapshot, filename);
+        else
+          writeG2o(*graphSnapshot, *estimateSnapshot, filename);
+      });
+}
+
 /* ************************************************************************* */
 static Rot3 NormalizedRot3(double w, double x, double y, double z) {
   const double norm = sqrt(w * w + x * x + y * y + z * z), f = 1.0 / norm;
@@ -545,6 +742,145 @@ std::map<Key, Pose3> parse3DPoses(const string& filename) {
   return poses;
 }
 
+/* ************************************************************************* */
+namespace {
+
+// One vertex line decoded by a worker: plain data only, so the parallel
+// phase never touches Values
+struct ParsedVertex {
+  Key id;
+  double p[7];  ///< x y theta | x y z (roll pitch yaw | qx qy qz qw)
+  bool quaternion;
+};
+
+// Locale-independent field scanners over the in-memory file buffer.  The
+// buffer is a null-terminated string, so strtod/strtoull stop at the
+// newline by themselves; only tag and whitespace handling need the line end.
+const char* skipSpace(const char* p, const char* end) {
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    ++p;
+  return p;
+}
+
+bool scanKey(const char*& p, Key* key) {
+  char* q;
+  *key = strtoull(p, &q, 10);
+  if (q == p)
+    return false;
+  p = q;
+  return true;
+}
+
+bool scanDouble(const char*& p, double* value) {
+  char* q;
+  *value = strtod(p, &q);
+  if (q == p)
+    return false;
+  p = q;
+  return true;
+}
+
+// Decode one line if it is a vertex of the requested dimension
+bool parseVertexLine(const char* p, const char* end, bool is3D,
+    ParsedVertex* v) {
+  p = skipSpace(p, end);
+  const char* tag = p;
+  while (p != end && *p != ' ' && *p != '\t')
+    ++p;
+  const size_t tagLength = p - tag;
+  size_t nrFields;
+  if (!is3D) {
+    if (!((tagLength == 7 && !memcmp(tag, "VERTEX2", 7))
+        || (tagLength == 10 && !memcmp(tag, "VERTEX_SE2", 10))
+        || (tagLength == 6 && !memcmp(tag, "VERTEX", 6))))
+      return false;
+    v->quaternion = false;
+    nrFields = 3;
+  } else {
+    if (tagLength == 7 && !memcmp(tag, "VERTEX3", 7))
+      v->quaternion = false;
+    else if (tagLength == 15 && !memcmp(tag, "VERTEX_SE3:QUAT", 15))
+      v->quaternion = true;
+    else
+      return false;
+    nrFields = v->quaternion ? 7 : 6;
+  }
+  if (!scanKey(p, &v->id))
+    return false;
+  for (size_t i = 0; i < nrFields; i++)
+    if (!scanDouble(p, &v->p[i]))
+      return false;
+  return true;
+}
+
+}  // \namespace
+
+/* ************************************************************************* */
+Values::shared_ptr parseVerticesParallel(const string& filename, bool is3D,
+    Key maxID) {
+  // Phase 1: read the whole file and index the start of every line
+  ifstream is(filename.c_str(), ios::binary);
+  if (!is)
+    throw invalid_argument(
+        "parseVerticesParallel: can not find file " + filename);
+  const string buffer((istreambuf_iterator<char>(is)),
+      istreambuf_iterator<char>());
+  vector<size_t> lineStarts(1, 0);
+  for (size_t i = 0; i < buffer.size(); i++)
+    if (buffer[i] == '\n')
+      lineStarts.push_back(i + 1);
+  lineStarts.push_back(buffer.size());
+  const size_t nrLines = lineStarts.size() - 1;
+
+  // Phase 2: decode the vertex lines in chunks, in parallel when TBB is
+  // enabled.  Each chunk appends to its own vector, so the workers share
+  // nothing; chunks are large enough that scheduling overhead is noise.
+  const size_t chunkSize = 4096;
+  const size_t nrChunks = (nrLines + chunkSize - 1) / chunkSize;
+  vector<vector<ParsedVertex> > chunks(nrChunks);
+  const char* data = buffer.c_str();
+  auto parseChunk = [&](size_t c) {
+    vector<ParsedVertex>& out = chunks[c];
+    const size_t iEnd = std::min(nrLines, (c + 1) * chunkSize);
+    for (size_t i = c * chunkSize; i < iEnd; i++) {
+      ParsedVertex v;
+      if (parseVertexLine(data + lineStarts[i], data + lineStarts[i + 1],
+          is3D, &v))
+        out.push_back(v);
+    }
+  };
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrChunks),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t c = range.begin(); c != range.end(); c++)
+          parseChunk(c);
+      });
+#else
+  for (size_t c = 0; c < nrChunks; c++)
+    parseChunk(c);
+#endif
+
+  // Only the insertion into Values runs sequentially, in file order
+  Values::shared_ptr initial(new Values);
+  for (const vector<ParsedVertex>& chunk : chunks) {
+    for (const ParsedVertex& v : chunk) {
+      if (maxID && v.id >= maxID)
+        continue;
+      if (!is3D)
+        initial->insert(v.id, Pose2(v.p[0], v.p[1], v.p[2]));
+      else if (v.quaternion)
+        initial->insert(v.id,
+            Pose3(NormalizedRot3(v.p[6], v.p[3], v.p[4], v.p[5]),
+                {v.p[0], v.p[1], v.p[2]}));
+      else
+        initial->insert(v.id,
+            Pose3(Rot3::Ypr(v.p[5], v.p[4], v.p[3]),
+                {v.p[0], v.p[1], v.p[2]}));
+    }
+  }
+  return initial;
+}
+
 /* ************************************************************************* */
 BetweenFactorPose3s parse3DFactors(
     const string& filename,
@@ -617,11 +953,8 @@ GraphAndValues load3D(const string& filename) {
     graph->push_back(factor);
   }
 
-  const auto poses = parse3DPoses(filename);
-  Values::shared_ptr initial(new Values);
-  for (const auto& key_pose : poses) {
-    initial->insert(key_pose.first, key_pose.second);
-  }
+  // vertex lines go through the two-phase parallel parser
+  Values::shared_ptr initial = parseVerticesParallel(filename, true);
 
   return make_pair(graph, initial);
 }
@@ -809,6 +1142,127 @@ bool readBAL(const string& filename, SfmData &data) {
   return true;
 }
 
+/* ************************************************************************* */
+// Keep at most this many parsed chunks ahead of the consumer
+static const size_t kMaxPrefetchedChunks = 4;
+
+BalTrackStream::BalTrackStream(const string& filename, size_t chunkSize) :
+    chunkSize_(chunkSize > 0 ? chunkSize : 1), good_(false), nrCameras_(0),
+    nrTracks_(0), nrObservations_(0), camerasReady_(false), done_(false),
+    abandoned_(false) {
+  // Open the file and parse the header on the calling thread, so good() and
+  // the counts are available immediately; the heavy parsing happens behind
+  auto is = boost::make_shared<ifstream>(filename.c_str(), ifstream::in);
+  if (!*is) {
+    cout << "Error in BalTrackStream: can not find the file!!" << endl;
+    done_ = true;
+    return;
+  }
+  *is >> nrCameras_ >> nrTracks_ >> nrObservations_;
+  good_ = true;
+  thread_ = std::thread(&BalTrackStream::parse, this, is);
+}
+
+/* ************************************************************************* */
+BalTrackStream::~BalTrackStream() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    abandoned_ = true;
+  }
+  changed_.notify_all();
+  if (thread_.joinable())
+    thread_.join();
+}
+
+/* ************************************************************************* */
+const std::vector<SfmCamera>& BalTrackStream::cameras() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [this] { return camerasReady_ || done_; });
+  return cameras_;
+}
+
+/* ************************************************************************* */
+bool BalTrackStream::nextChunk(std::vector<SfmTrack>& tracks) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [this] { return !chunks_.empty() || done_; });
+  if (chunks_.empty())
+    return false;
+  tracks = std::move(chunks_.front());
+  chunks_.pop_front();
+  // Wake the producer, which may be waiting for prefetch space
+  changed_.notify_all();
+  return true;
+}
+
+/* ************************************************************************* */
+void BalTrackStream::parse(const boost::shared_ptr<ifstream>& is) {
+  // The observation section comes first in a BAL file and dominates its size;
+  // parsing it here is what readBAL callers currently block 30+ seconds on
+  std::vector<SfmTrack> tracks(nrTracks_);
+  for (size_t k = 0; k < nrObservations_; k++) {
+    size_t i = 0, j = 0;
+    float u, v;
+    *is >> i >> j >> u >> v;
+    tracks[j].measurements.emplace_back(i, Point2(u, -v));
+  }
+
+  // Camera section: parse exactly as readBAL, then publish
+  std::vector<SfmCamera> cameras;
+  cameras.reserve(nrCameras_);
+  for (size_t i = 0; i < nrCameras_; i++) {
+    float wx, wy, wz;
+    *is >> wx >> wy >> wz;
+    Rot3 R = Rot3::Rodrigues(wx, wy, wz); // BAL-OpenGL rotation matrix
+    float tx, ty, tz;
+    *is >> tx >> ty >> tz;
+    Pose3 pose = openGL2gtsam(R, tx, ty, tz);
+    float f, k1, k2;
+    *is >> f >> k1 >> k2;
+    Cal3Bundler K(f, k1, k2);
+    cameras.emplace_back(pose, K);
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cameras_.swap(cameras);
+    camerasReady_ = true;
+  }
+  changed_.notify_all();
+
+  // Point section: each point completes its track, so tracks can be handed
+  // out in chunks while the rest of the file is still being read
+  std::vector<SfmTrack> chunk;
+  chunk.reserve(std::min(chunkSize_, nrTracks_));
+  for (size_t j = 0; j < nrTracks_; j++) {
+    float x, y, z;
+    *is >> x >> y >> z;
+    SfmTrack& track = tracks[j];
+    track.p = Point3(x, y, z);
+    track.r = 0.4f;
+    track.g = 0.4f;
+    track.b = 0.4f;
+    chunk.push_back(std::move(track));
+    if (chunk.size() == chunkSize_) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      changed_.wait(lock, [this] {
+        return chunks_.size() < kMaxPrefetchedChunks || abandoned_;
+      });
+      if (abandoned_)
+        return;
+      chunks_.push_back(std::move(chunk));
+      chunk.clear();
+      chunk.reserve(chunkSize_);
+      changed_.notify_all();
+    }
+  }
+
+  // Hand over the final partial chunk and signal completion
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!chunk.empty() && !abandoned_)
+    chunks_.push_back(std::move(chunk));
+  done_ = true;
+  changed_.notify_all();
+}
+
 /* ************************************************************************* */
 bool writeBAL(const string& filename, SfmData &data) {
   // Open the output file
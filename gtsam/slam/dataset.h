@@ -33,7 +33,12 @@
 #include <gtsam/base/types.h>
 
 #include <boost/smart_ptr/shared_ptr.hpp>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility> // for pair
 #include <vector>
 #include <iosfwd>
@@ -157,6 +162,46 @@ GTSAM_EXPORT GraphAndValues readG2o(const std::string& g2oFile, const bool is3D
 GTSAM_EXPORT void writeG2o(const NonlinearFactorGraph& graph,
     const Values& estimate, const std::string& filename);
 
+/**
+ * @brief This function writes a binary companion of the g2o format.  The same
+ * content writeG2o would emit (Pose2/Pose3 values, 2D/3D between factors) is
+ * stored as fixed-size records that are read back wholesale, so loading a
+ * city-scale graph is I/O bound instead of parse bound.  Write a dataset once
+ * with this, then load it with loadG2oBinary on every subsequent run.
+ * @param graph NonlinearFactor graph storing the measurements
+ * @param estimate Values
+ * @param filename The name of the binary file to write
+ */
+GTSAM_EXPORT void saveG2oBinary(const NonlinearFactorGraph& graph,
+    const Values& estimate, const std::string& filename);
+
+/**
+ * @brief This function reads a file written by saveG2oBinary and restores the
+ * measurements into a NonlinearFactorGraph and the initial guess into a
+ * Values structure.  The 2D/3D distinction is stored in the file, so no is3D
+ * flag is needed.
+ * @param filename The name of the binary file to read
+ * @return graph and initial values
+ */
+GTSAM_EXPORT GraphAndValues loadG2oBinary(const std::string& filename);
+
+/**
+ * @brief This function checkpoints a graph and estimate to disk without
+ * blocking the calling thread.  The graph and estimate are snapshotted on the
+ * calling thread - a copy that is cheap relative to formatting - and the
+ * formatting and file I/O then run on a background thread, so an optimizer
+ * can keep iterating while the checkpoint is written.  The returned future
+ * becomes ready once the file is on disk; hold on to it and wait() on it
+ * before reading the file or exiting the program.
+ * @param graph NonlinearFactor graph storing the measurements
+ * @param estimate Values
+ * @param filename The name of the file to write
+ * @param binary write the saveG2oBinary format instead of text g2o
+ * @return future that completes when the checkpoint is on disk
+ */
+GTSAM_EXPORT std::future<void> writeG2oAsync(const NonlinearFactorGraph& graph,
+    const Values& estimate, const std::string& filename, bool binary = false);
+
 /// Parse edges in 3D TORO graph file into a set of BetweenFactors.
 using BetweenFactorPose3s = std::vector<gtsam::BetweenFactor<Pose3>::shared_ptr>;
 GTSAM_EXPORT BetweenFactorPose3s parse3DFactors(const std::string& filename, 
@@ -165,6 +210,23 @@ GTSAM_EXPORT BetweenFactorPose3s parse3DFactors(const std::string& filename,
 /// Parse vertices in 3D TORO graph file into a map of Pose3s.
 GTSAM_EXPORT std::map<Key, Pose3> parse3DPoses(const std::string& filename);
 
+/**
+ * @brief This function parses the VERTEX lines of a g2o/TORO text file into
+ * initial values, in two phases.  The file is first read into memory and cut
+ * into lines; the lines are then decoded in chunks - in parallel when TBB is
+ * enabled - with locale-independent strtod parsing instead of per-line
+ * stream extraction, and only the final insertion into Values runs
+ * sequentially.  Recognizes VERTEX2/VERTEX_SE2/VERTEX (Pose2) when is3D is
+ * false and VERTEX3/VERTEX_SE3:QUAT (Pose3) when it is true.  Called by
+ * load2D and load3D, so readG2o benefits automatically.
+ * @param filename The name of the g2o file
+ * @param is3D indicates if the file describes a 2D or 3D problem
+ * @param maxID if nonzero, vertices with id >= maxID are skipped
+ * @return initial values
+ */
+GTSAM_EXPORT Values::shared_ptr parseVerticesParallel(
+    const std::string& filename, bool is3D = false, Key maxID = 0);
+
 /// Load TORO 3D Graph
 GTSAM_EXPORT GraphAndValues load3D(const std::string& filename);
 
@@ -237,6 +299,78 @@ GTSAM_EXPORT bool readBundler(const std::string& filename, SfmData &data);
  */
 GTSAM_EXPORT bool readBAL(const std::string& filename, SfmData &data);
 
+/**
+ * @brief Streaming reader for "Bundle Adjustment in the Large" (BAL) files.
+ *
+ * Where readBAL blocks until the whole file is parsed into an SfmData,
+ * this class parses the file on a background thread and yields completed
+ * tracks in chunks, so a pipeline can overlap file I/O with track filtering
+ * and factor construction.  The producer stays a bounded number of chunks
+ * ahead of the consumer, which caps memory use on venice-scale files.
+ *
+ * Cameras become available once the camera section of the file has been
+ * parsed; cameras() blocks until then.  Tracks are yielded in file order.
+ * Typical use:
+ *
+ *   BalTrackStream stream(filename);
+ *   if (!stream.good()) throw std::runtime_error("Could not access file!");
+ *   std::vector<SfmTrack> tracks;
+ *   while (stream.nextChunk(tracks)) {
+ *     for (const SfmTrack& track : tracks)
+ *       ...  // filter, build factors
+ *   }
+ */
+class GTSAM_EXPORT BalTrackStream {
+public:
+  /**
+   * Open a BAL file and start parsing it in the background
+   * @param filename The name of the BAL file
+   * @param chunkSize number of tracks handed out per nextChunk call
+   */
+  explicit BalTrackStream(const std::string& filename, size_t chunkSize = 1024);
+
+  /// Destructor stops the background parse and joins the thread
+  ~BalTrackStream();
+
+  /// True if the file could be opened and its header parsed
+  bool good() const { return good_; }
+
+  /// Number of cameras declared in the file header
+  size_t nrCameras() const { return nrCameras_; }
+
+  /// Number of tracks declared in the file header
+  size_t nrTracks() const { return nrTracks_; }
+
+  /// The cameras; blocks until the camera section has been parsed
+  const std::vector<SfmCamera>& cameras() const;
+
+  /**
+   * Get the next chunk of completed tracks, blocking until one is ready.
+   * @param tracks overwritten with at most chunkSize tracks, in file order
+   * @return true if tracks were produced, false once the file is exhausted
+   */
+  bool nextChunk(std::vector<SfmTrack>& tracks);
+
+private:
+  /// Background thread body: parses observations, cameras, then points
+  void parse(const boost::shared_ptr<std::ifstream>& is);
+
+  size_t chunkSize_;
+  bool good_;
+  size_t nrCameras_, nrTracks_, nrObservations_;
+
+  // All members below are guarded by mutex_
+  mutable std::mutex mutex_;
+  mutable std::condition_variable changed_;
+  std::vector<SfmCamera> cameras_;
+  bool camerasReady_;
+  std::deque<std::vector<SfmTrack> > chunks_;
+  bool done_;      ///< producer finished (or failed); no more chunks coming
+  bool abandoned_; ///< consumer destroyed the stream; producer should stop
+
+  std::thread thread_;
+};
+
 /**
  * @brief This function writes a "Bundle Adjustment in the Large" (BAL) file from a
  * SfmData structure
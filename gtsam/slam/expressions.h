@@ -132,13 +132,20 @@ Point2_ project2(const Expression<CAMERA>& camera_, const Expression<POINT>& p_)
 namespace internal {
 // Helper template for project3 expression below
 template <class CALIBRATION, class POINT>
-inline Point2 project6(const Pose3& x, const Point3& p, const Cal3_S2& K,
-                       OptionalJacobian<2, 6> Dpose, OptionalJacobian<2, 3> Dpoint,
-                       OptionalJacobian<2, 5> Dcal) {
-  return PinholeCamera<Cal3_S2>(x, K).project(p, Dpose, Dpoint, Dcal);
+inline Point2 project6(const Pose3& x, const POINT& p, const CALIBRATION& K,
+                       OptionalJacobian<2, 6> Dpose,
+                       OptionalJacobian<2, FixedDimension<POINT>::value> Dpoint,
+                       OptionalJacobian<2, CALIBRATION::dimension> Dcal) {
+  return PinholeCamera<CALIBRATION>(x, K).project(p, Dpose, Dpoint, Dcal);
 }
 }
 
+/**
+ * Fused version of uncalibrate(K, project(transformTo(x, p))): a single
+ * expression node whose Jacobians are the analytically chained camera
+ * derivatives, so tracing materializes one set of Jacobians instead of one
+ * per intermediate node.  Prefer this form in expression-based BA.
+ */
 template <class CALIBRATION, class POINT>
 inline Point2_ project3(const Pose3_& x, const Expression<POINT>& p,
                         const Expression<CALIBRATION>& K) {
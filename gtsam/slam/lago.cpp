@@ -374,6 +374,88 @@ Values initialize(const NonlinearFactorGraph& graph, bool useOdometricPath) {
   return computePoses(pose2Graph, orientationsLago);
 }
 
+/* ************************************************************************* */
+IncrementalLago::IncrementalLago() {
+  tree_.insert(keyAnchor, keyAnchor); // root
+  orientationsToRoot_.insert(pair<Key, double>(keyAnchor, 0.0));
+  // prior on the anchor orientation
+  lagoGraph_.add(keyAnchor, I, (Vector(1) << 0.0).finished(),
+      priorOrientationNoise);
+}
+
+/* ************************************************************************* */
+bool IncrementalLago::tryAdd(const NonlinearFactor::shared_ptr& factor) {
+
+  const KeyVector& keys = factor->keys();
+  Key key1 = keys[0], key2 = keys[1];
+  const bool known1 = orientationsToRoot_.count(key1) > 0;
+  const bool known2 = orientationsToRoot_.count(key2) > 0;
+  if (!known1 && !known2)
+    return false; // not connected to the tree (yet)
+
+  Vector deltaTheta;
+  noiseModel::Diagonal::shared_ptr model_deltaTheta;
+  getDeltaThetaAndNoise(factor, deltaTheta, model_deltaTheta);
+  pose2Graph_.add(factor);
+
+  if (known1 && known2) {
+    // it's a chord! Regularize it against the cumulative orientations of its
+    // endpoints, which are final since tree paths never change once inserted
+    double k2pi_noise = deltaTheta(0) + orientationsToRoot_.at(key1)
+        - orientationsToRoot_.at(key2);
+    double k = boost::math::round(k2pi_noise / (2 * M_PI));
+    Vector deltaThetaRegularized = (Vector(1)
+        << deltaTheta(0) - 2 * k * M_PI).finished();
+    lagoGraph_.add(key1, -I, key2, I, deltaThetaRegularized, model_deltaTheta);
+  } else {
+    // spanning tree edge: attach the new node below the known one
+    Key parent = known1 ? key1 : key2;
+    Key child = known1 ? key2 : key1;
+    tree_.insert(child, parent);
+    orientationsToRoot_.insert(pair<Key, double>(child,
+        orientationsToRoot_.at(parent) + (known1 ? deltaTheta(0) : -deltaTheta(0))));
+    lagoGraph_.add(key1, -I, key2, I, deltaTheta, model_deltaTheta);
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+void IncrementalLago::add(const NonlinearFactorGraph& newFactors) {
+  gttic(lago_incremental_add);
+
+  // Extract the Pose2 subgraph, converting priors to edges wrt the anchor
+  NonlinearFactorGraph pose2Factors = buildPose2graph(newFactors);
+
+  // Within a batch, edges can arrive in any order: defer edges whose
+  // endpoints are both unknown and retry them until no progress is made
+  vector<NonlinearFactor::shared_ptr> pending(pose2Factors.begin(),
+      pose2Factors.end());
+  while (!pending.empty()) {
+    vector<NonlinearFactor::shared_ptr> deferred;
+    for(const NonlinearFactor::shared_ptr& factor: pending) {
+      if (!tryAdd(factor))
+        deferred.push_back(factor);
+    }
+    if (deferred.size() == pending.size())
+      throw invalid_argument("IncrementalLago::add: new factors are not "
+          "connected to the spanning tree (is there a prior?)");
+    pending.swap(deferred);
+  }
+}
+
+/* ************************************************************************* */
+VectorValues IncrementalLago::estimateOrientations() const {
+  gttic(lago_incremental_estimateOrientations);
+  return lagoGraph_.optimize();
+}
+
+/* ************************************************************************* */
+Values IncrementalLago::estimate() const {
+  gttic(lago_incremental_estimate);
+  VectorValues orientationsLago = lagoGraph_.optimize();
+  return computePoses(pose2Graph_, orientationsLago);
+}
+
 /* ************************************************************************* */
 Values initialize(const NonlinearFactorGraph& graph,
     const Values& initialGuess) {
@@ -82,5 +82,57 @@ GTSAM_EXPORT Values initialize(const NonlinearFactorGraph& graph,
 GTSAM_EXPORT Values initialize(const NonlinearFactorGraph& graph,
     const Values& initialGuess);
 
+/**
+ * Incremental LAGO for streaming 2D problems. Instead of recomputing the
+ * spanning tree and the regularized orientation linear system from scratch on
+ * every call, this class maintains them under edge insertions: a new edge
+ * touching a new node extends the spanning tree and its cumulative
+ * orientation in O(1), while an edge closing a loop becomes a chord and is
+ * regularized against the cumulative orientations of its (already known)
+ * endpoints. Adding a batch of factors therefore costs O(new edges),
+ * independent of the size of the graph accumulated so far; only the solves in
+ * estimateOrientations/estimate visit the full system.
+ *
+ * As in the batch interface, priors on Pose2 are converted to edges wrt a
+ * fictitious anchor node, and the first factors added must connect to such a
+ * prior (or, transitively, to previously added factors).
+ */
+class GTSAM_EXPORT IncrementalLago {
+public:
+
+  /** Create an empty estimator, containing only the anchor */
+  IncrementalLago();
+
+  /**
+   * Add new factors. Factors of types other than BetweenFactor<Pose2> and
+   * PriorFactor<Pose2> are ignored, as in the batch interface.
+   * @throw std::invalid_argument if some new factors cannot be connected to
+   * the spanning tree built so far
+   */
+  void add(const NonlinearFactorGraph& newFactors);
+
+  /** Solve the maintained linear system for all orientations */
+  VectorValues estimateOrientations() const;
+
+  /** Return the full LAGO initial guess for all poses added so far */
+  Values estimate() const;
+
+  /** The spanning tree maintained so far, as a child -> parent map */
+  const PredecessorMap<Key>& spanningTree() const { return tree_; }
+
+  /** The regularized orientation linear system maintained so far */
+  const GaussianFactorGraph& linearOrientationGraph() const { return lagoGraph_; }
+
+private:
+
+  /** Try to place a single factor, returning false if both keys are unknown */
+  bool tryAdd(const NonlinearFactor::shared_ptr& factor);
+
+  NonlinearFactorGraph pose2Graph_;    ///< accumulated Pose2 subgraph
+  PredecessorMap<Key> tree_;           ///< spanning tree rooted at the anchor
+  key2doubleMap orientationsToRoot_;   ///< cumulative orientations wrt the root
+  GaussianFactorGraph lagoGraph_;      ///< regularized orientation linear system
+};
+
 } // end of namespace lago
 } // end of namespace gtsam
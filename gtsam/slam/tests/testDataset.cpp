@@ -299,6 +299,30 @@ TEST(dataSet, readG2o) {
   EXPECT(assert_equal(expectedValues, *actualValues, 1e-5));
 }
 
+/* ************************************************************************* */
+TEST(dataSet, parseVerticesParallel) {
+  // 2D: must agree with the per-line stream parser used by parseVertex
+  const string g2oFile = findExampleDataFile("pose2example");
+  const auto actual2D = parseVerticesParallel(g2oFile);
+  EXPECT_LONGS_EQUAL(11, actual2D->size());
+  EXPECT(assert_equal(Pose2(1.030390, 0.011350, -0.081596),
+      actual2D->at<Pose2>(1), 1e-5));
+
+  // maxID filters exactly like load2D
+  const auto filtered = parseVerticesParallel(g2oFile, false, 5);
+  EXPECT_LONGS_EQUAL(5, filtered->size());
+  EXPECT(!filtered->exists(5));
+
+  // 3D: must agree with parse3DPoses, quaternion vertices included
+  const string g2oFile3D = findExampleDataFile("pose3example");
+  const auto actual3D = parseVerticesParallel(g2oFile3D, true);
+  const auto expected3D = parse3DPoses(g2oFile3D);
+  EXPECT_LONGS_EQUAL(expected3D.size(), actual3D->size());
+  for (const auto& key_pose : expected3D)
+    EXPECT(assert_equal(key_pose.second,
+        actual3D->at<Pose3>(key_pose.first), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(dataSet, readG2oHuber) {
   const string g2oFile = findExampleDataFile("pose2example");
@@ -389,6 +413,69 @@ TEST( dataSet, writeG2o3DNonDiagonalNoise)
   EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-4));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, writeG2oAsync)
+{
+  const string g2oFile = findExampleDataFile("pose2example");
+  NonlinearFactorGraph::shared_ptr expectedGraph;
+  Values::shared_ptr expectedValues;
+  boost::tie(expectedGraph, expectedValues) = readG2o(g2oFile);
+
+  const string filenameToWrite = createRewrittenFileName(g2oFile);
+  std::future<void> done = writeG2oAsync(*expectedGraph, *expectedValues, filenameToWrite);
+  done.wait();
+
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = readG2o(filenameToWrite);
+  EXPECT(assert_equal(*expectedValues,*actualValues,1e-5));
+  EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-5));
+
+  // Binary mode goes through saveG2oBinary
+  const string binaryFilename = filenameToWrite + ".async.bin";
+  writeG2oAsync(*expectedGraph, *expectedValues, binaryFilename, true).wait();
+  boost::tie(actualGraph, actualValues) = loadG2oBinary(binaryFilename);
+  EXPECT(assert_equal(*expectedValues,*actualValues,1e-9));
+  EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-9));
+}
+
+/* ************************************************************************* */
+TEST( dataSet, saveG2oBinary)
+{
+  const string g2oFile = findExampleDataFile("pose2example");
+  NonlinearFactorGraph::shared_ptr expectedGraph;
+  Values::shared_ptr expectedValues;
+  boost::tie(expectedGraph, expectedValues) = readG2o(g2oFile);
+
+  const string filenameToWrite = createRewrittenFileName(g2oFile) + ".bin";
+  saveG2oBinary(*expectedGraph, *expectedValues, filenameToWrite);
+
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = loadG2oBinary(filenameToWrite);
+  EXPECT(assert_equal(*expectedValues,*actualValues,1e-9));
+  EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-9));
+}
+
+/* ************************************************************************* */
+TEST( dataSet, saveG2oBinary3D)
+{
+  const string g2oFile = findExampleDataFile("pose3example");
+  NonlinearFactorGraph::shared_ptr expectedGraph;
+  Values::shared_ptr expectedValues;
+  bool is3D = true;
+  boost::tie(expectedGraph, expectedValues) = readG2o(g2oFile, is3D);
+
+  const string filenameToWrite = createRewrittenFileName(g2oFile) + ".bin";
+  saveG2oBinary(*expectedGraph, *expectedValues, filenameToWrite);
+
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = loadG2oBinary(filenameToWrite);
+  EXPECT(assert_equal(*expectedValues,*actualValues,1e-9));
+  EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-9));
+}
+
 /* ************************************************************************* */
 TEST( dataSet, readBAL_Dubrovnik)
 {
@@ -410,6 +497,57 @@ TEST( dataSet, readBAL_Dubrovnik)
   EXPECT(assert_equal(expected,actual,12));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, BalTrackStream_Dubrovnik)
+{
+  const string filename = findExampleDataFile("dubrovnik-3-7-pre");
+
+  ///< The eagerly loaded data is the reference
+  SfmData expected;
+  CHECK(readBAL(filename, expected));
+
+  // Stream the same file in chunks of 3 tracks (7 tracks -> 3 + 3 + 1)
+  BalTrackStream stream(filename, 3);
+  CHECK(stream.good());
+  EXPECT_LONGS_EQUAL(3, stream.nrCameras());
+  EXPECT_LONGS_EQUAL(7, stream.nrTracks());
+
+  // Cameras match the eager reader
+  const std::vector<SfmCamera>& cameras = stream.cameras();
+  EXPECT_LONGS_EQUAL(3, cameras.size());
+  for (size_t i = 0; i < cameras.size(); i++)
+    EXPECT(assert_equal(expected.cameras[i], cameras[i], 1e-9));
+
+  // Tracks arrive in file order, identical to the eager reader
+  size_t j = 0;
+  std::vector<SfmTrack> chunk;
+  while (stream.nextChunk(chunk)) {
+    CHECK(chunk.size() <= 3);
+    for (const SfmTrack& track : chunk) {
+      const SfmTrack& expectedTrack = expected.tracks[j++];
+      EXPECT(assert_equal(expectedTrack.p, track.p, 1e-9));
+      EXPECT_LONGS_EQUAL(expectedTrack.number_measurements(),
+          track.number_measurements());
+      for (size_t k = 0; k < track.number_measurements(); k++) {
+        EXPECT_LONGS_EQUAL(expectedTrack.measurements[k].first,
+            track.measurements[k].first);
+        EXPECT(assert_equal(expectedTrack.measurements[k].second,
+            track.measurements[k].second, 1e-9));
+      }
+    }
+  }
+  EXPECT_LONGS_EQUAL(7, j);
+
+  // A stream on a missing file reports failure instead of blocking
+  BalTrackStream bad("nosuchfile.txt");
+  CHECK(!bad.good());
+  CHECK(!bad.nextChunk(chunk));
+
+  // Destroying a stream mid-read must not deadlock
+  BalTrackStream abandoned(filename, 1);
+  CHECK(abandoned.good());
+}
+
 /* ************************************************************************* */
 TEST( dataSet, openGL2gtsam)
 {
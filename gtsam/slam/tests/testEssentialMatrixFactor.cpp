@@ -112,6 +112,45 @@ TEST (EssentialMatrixFactor, factor) {
   }
 }
 
+//*************************************************************************
+TEST (EssentialMatrixBatchFactor, factor) {
+  Key key(1);
+  vector<Point2> pAs, pBs;
+  for (size_t i = 0; i < 5; i++) {
+    pAs.push_back(pA(i));
+    pBs.push_back(pB(i));
+  }
+  EssentialMatrixBatchFactor factor(key, pAs, pBs,
+      noiseModel::Isotropic::Sigma(5, 0.01));
+  EXPECT_LONGS_EQUAL(5, factor.nrMeasurements());
+
+  // Check evaluation: all five epipolar constraints hold at the true E
+  Matrix Hactual;
+  Vector actual = factor.evaluateError(trueE, Hactual);
+  EXPECT(assert_equal(Vector::Zero(5), actual, 1e-7));
+
+  // Each row must match the corresponding one-correspondence factor
+  for (size_t i = 0; i < 5; i++) {
+    EssentialMatrixFactor single(key, pA(i), pB(i), model1);
+    Matrix Hsingle;
+    Vector esingle = single.evaluateError(trueE, Hsingle);
+    EXPECT_DOUBLES_EQUAL(esingle(0), actual(i), 1e-9);
+    EXPECT(assert_equal(Hsingle, Matrix(Hactual.row(i)), 1e-9));
+  }
+
+  // Use numerical derivatives to verify the fused Jacobian
+  typedef Eigen::Matrix<double, 5, 1> Vector5;
+  Matrix Hexpected = numericalDerivative11<Vector5, EssentialMatrix>(
+      boost::bind(&EssentialMatrixBatchFactor::evaluateError, &factor, _1,
+          boost::none), trueE);
+  EXPECT(assert_equal(Hexpected, Hactual, 1e-8));
+
+  // Mismatched correspondence counts are rejected
+  pBs.pop_back();
+  CHECK_EXCEPTION(EssentialMatrixBatchFactor(key, pAs, pBs,
+      noiseModel::Isotropic::Sigma(5, 0.01)), std::invalid_argument);
+}
+
 //*************************************************************************
 TEST(EssentialMatrixFactor, ExpressionFactor) {
   Key key(1);
@@ -148,6 +148,26 @@ TEST(FrobeniusBetweenFactorSO3, evaluateError) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-7, 1e-5);
 }
 
+/* ************************************************************************* */
+TEST(FrobeniusBetweenFactorSO3, LinearizeFrobeniusBetween) {
+  using namespace ::so3;
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<FrobeniusBetweenFactor<SO3>>(1, 2, R12);
+  graph.emplace_shared<FrobeniusBetweenFactor<SO3>>(
+      2, 3, R12, noiseModel::Isotropic::Sigma(6, 1.2));
+  // A non-between factor exercises the fallback to the virtual linearize
+  graph.emplace_shared<FrobeniusPrior<SO3>>(3, R2.matrix());
+
+  Values values;
+  values.insert(1, R1);
+  values.insert(2, R2);
+  values.insert(3, R2.compose(R12));
+
+  auto expected = graph.linearize(values);
+  auto actual = LinearizeFrobeniusBetween<SO3>(graph, values);
+  EXPECT(assert_equal(*expected, *actual, 1e-9));
+}
+
 //******************************************************************************
 namespace so4 {
 SO4 id;
@@ -188,6 +208,21 @@ TEST(FrobeniusBetweenFactorSO4, evaluateError) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-7, 1e-5);
 }
 
+/* ************************************************************************* */
+TEST(FrobeniusBetweenFactorSO4, LinearizeFrobeniusBetween) {
+  using namespace ::so4;
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<FrobeniusBetweenFactor<SO4>>(1, 2, Q1.between(Q2));
+
+  Values values;
+  values.insert(1, Q1);
+  values.insert(2, Q2);
+
+  auto expected = graph.linearize(values);
+  auto actual = LinearizeFrobeniusBetween<SO4>(graph, values);
+  EXPECT(assert_equal(*expected, *actual, 1e-9));
+}
+
 //******************************************************************************
 namespace submanifold {
 SO4 id;
@@ -495,6 +495,47 @@ TEST(GeneralSFMFactor, BinaryJacobianFactor) {
   }
 }
 
+/* ************************************************************************* */
+// Same check for the ternary version with a separate calibration variable
+TEST(GeneralSFMFactor, TernaryJacobianFactor) {
+  using symbol_shorthand::K;
+  typedef GeneralSFMFactor2<Cal3_S2> Projection2;
+  Point2 measurement(3., -1.);
+
+  // Create Values, with the calibration as its own variable
+  Values values;
+  values.insert(X(1), Pose3(Rot3(), Point3(0, 0, -6)));
+  values.insert(L(1), Point3(0, 0, 0));
+  values.insert(K(1), Cal3_S2());
+
+  vector<SharedNoiseModel> models;
+  {
+    // Create various noise-models to test all cases
+    using namespace noiseModel;
+    Rot2 R = Rot2::fromAngle(0.3);
+    Matrix2 cov = R.matrix() * R.matrix().transpose();
+    models += SharedNoiseModel(), Unit::Create(2), //
+    Isotropic::Sigma(2, 0.5), Constrained::All(2), Gaussian::Covariance(cov);
+  }
+
+  // Now loop over all these noise models
+  for(SharedNoiseModel model: models) {
+    Projection2 factor(measurement, model, X(1), L(1), K(1));
+
+    // Test linearize
+    GaussianFactor::shared_ptr expected = //
+        factor.NoiseModelFactor::linearize(values);
+    GaussianFactor::shared_ptr actual = factor.linearize(values);
+    EXPECT(assert_equal(*expected, *actual, 1e-9));
+
+    // Test methods that rely on updateHessian
+    if (model && !model->isConstrained()) {
+      HessianFactor expectedHessian(*expected), actualHessian(*actual);
+      EXPECT(assert_equal(expectedHessian, actualHessian, 1e-9));
+    }
+  }
+}
+
 /* ************************************************************************* */
 // Do a thorough test of BinaryJacobianFactor
 TEST( GeneralSFMFactor, BinaryJacobianFactor2 ) {
@@ -42,6 +42,32 @@ TEST(KarcherMean, FindRot3) {
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+// Check incremental maintenance of the mean across "optimizer iterations".
+TEST(KarcherMean, IncrementalRot3) {
+  // Cold start: iterating single correction steps converges to the mean
+  std::vector<Rot3> rotations = {R, R.inverse()};
+  IncrementalKarcherMean<Rot3> incremental(R);
+  for (size_t i = 0; i < 20 && incremental.update(rotations) > 1e-12; i++) {
+  }
+  EXPECT(assert_equal(Rot3(), incremental.mean(), 1e-9));
+
+  // Warm start: after the rotations move slightly, as between optimizer
+  // iterations, a single correction step re-tracks the mean
+  const Rot3 delta = Rot3::Expmap(Vector3(0, 0.01, 0));
+  rotations = {R * delta, R.inverse() * delta};
+  incremental.update(rotations);
+  const auto expected = FindKarcherMean(rotations);
+  EXPECT(assert_equal(expected, incremental.mean(), 1e-4));
+
+  // The batched projection yields one tangent column per rotation, and the
+  // average tangent vanishes at the mean
+  Matrix tangents = KarcherTangents(incremental.mean(), rotations);
+  LONGS_EQUAL(3, tangents.rows());
+  LONGS_EQUAL(2, tangents.cols());
+  EXPECT(assert_equal(Vector3(0, 0, 0), Vector3(tangents.rowwise().mean()), 1e-4));
+}
+
 /* ************************************************************************* */
 // Check that the InnerConstraint factor leaves the mean unchanged.
 TEST(KarcherMean, FactorRot3) {
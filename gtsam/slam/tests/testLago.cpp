@@ -162,6 +162,52 @@ TEST( Lago, smallGraphVectorValuesSP ) {
   EXPECT(assert_equal((Vector(1) << 1.5 * M_PI ).finished(), initial.at(x3), 1e-6));
 }
 
+/* *************************************************************************** */
+TEST( Lago, incrementalMatchesBatch ) {
+  NonlinearFactorGraph g = simpleLago::graph();
+
+  lago::IncrementalLago incremental;
+  incremental.add(g);
+
+  // the maintained linear system yields the same orientations as batch LAGO
+  VectorValues expected = lago::initializeOrientations(g);
+  VectorValues actual = incremental.estimateOrientations();
+  EXPECT(assert_equal(expected, actual, 1e-6));
+
+  // and the same full initial guess
+  EXPECT(assert_equal(lago::initialize(g), incremental.estimate(), 1e-6));
+}
+
+/* *************************************************************************** */
+TEST( Lago, incrementalLoopClosures ) {
+  using namespace simpleLago;
+
+  // stream the odometric path first, then the loop closures
+  lago::IncrementalLago incremental;
+  NonlinearFactorGraph odometry;
+  odometry.addPrior(x0, pose0, model);
+  odometry.add(BetweenFactor<Pose2>(x0, x1, pose0.between(pose1), model));
+  odometry.add(BetweenFactor<Pose2>(x1, x2, pose1.between(pose2), model));
+  odometry.add(BetweenFactor<Pose2>(x2, x3, pose2.between(pose3), model));
+  incremental.add(odometry);
+
+  NonlinearFactorGraph closures;
+  closures.add(BetweenFactor<Pose2>(x2, x0, pose2.between(pose0), model));
+  closures.add(BetweenFactor<Pose2>(x0, x3, pose0.between(pose3), model));
+  incremental.add(closures);
+
+  // same solution as batch LAGO over the union of the two batches
+  VectorValues expected = lago::initializeOrientations(simpleLago::graph());
+  VectorValues actual = incremental.estimateOrientations();
+  EXPECT(assert_equal(expected, actual, 1e-6));
+
+  // a disconnected batch is rejected
+  NonlinearFactorGraph disconnected;
+  disconnected.add(BetweenFactor<Pose2>(Symbol('x', 10), Symbol('x', 11),
+      pose0.between(pose1), model));
+  CHECK_EXCEPTION(incremental.add(disconnected), std::invalid_argument);
+}
+
 /* *************************************************************************** */
 TEST( Lago, multiplePosePriors ) {
   bool useOdometricPath = false;
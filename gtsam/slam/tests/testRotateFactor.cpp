@@ -195,6 +195,40 @@ TEST (RotateDirectionsFactor, minimization) {
   EXPECT_DOUBLES_EQUAL(0, graph.error(result), 1e-4);
 }
 
+//*************************************************************************
+TEST (RotateDirectionsBatchFactor, batch) {
+  Model model = noiseModel::Isotropic::Sigma(6, 0.01);
+  std::vector<Unit3> ps = {p1, p2, p3}, zs = {z1, z2, z3};
+  RotateDirectionsBatchFactor f(1, ps, zs, model);
+  EXPECT_LONGS_EQUAL(3, f.nrMeasurements());
+
+  // Zero error at the true rotation
+  EXPECT(assert_equal(Vector(Vector6::Zero()), f.evaluateError(iRc), 1e-8));
+
+  // Row pairs match the individual factors
+  Rot3 R = iRc.retract(Vector3(0.1, 0.2, 0.1));
+  Model model2 = noiseModel::Isotropic::Sigma(2, 0.01);
+  Vector actual = f.evaluateError(R);
+  for (size_t i = 0; i < 3; i++) {
+    RotateDirectionsFactor fi(1, ps[i], zs[i], model2);
+    EXPECT(assert_equal(Vector(fi.evaluateError(R)),
+        Vector(actual.segment<2>(2 * i)), 1e-9));
+  }
+
+  // Check the batched Jacobian against numerical derivatives
+  Matrix actualH;
+  f.evaluateError(R, actualH);
+  Matrix expectedH = numericalDerivative11<Vector, Rot3>(
+      boost::bind(&RotateDirectionsBatchFactor::evaluateError, &f, _1,
+          boost::none), R);
+  EXPECT(assert_equal(expectedH, actualH, 1e-8));
+
+  // Mismatched measurement lists are rejected
+  std::vector<Unit3> tooFew = {p1};
+  CHECK_EXCEPTION(RotateDirectionsBatchFactor(1, tooFew, zs, model),
+      std::invalid_argument);
+}
+
 //*************************************************************************
 TEST(RotateDirectionsFactor, Initialization) {
   // Create a gravity vector in a nav frame that has Z up
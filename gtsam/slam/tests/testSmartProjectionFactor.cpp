@@ -22,6 +22,8 @@
 #include "smartFactorScenarios.h"
 #include <gtsam/slam/SmartProjectionFactor.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/Preconditioner.h>
 #include <gtsam/base/serializationTestHelpers.h>
 #include <CppUnitLite/TestHarness.h>
 #include <boost/assign/std/map.hpp>
@@ -810,6 +812,80 @@ TEST(SmartProjectionFactor, implicitJacobianFactor ) {
   EXPECT(assert_equal(yActual, yExpected, 1e-7));
 }
 
+/* *************************************************************************/
+// LM with an iterative linear solver over IMPLICIT_SCHUR factors: the
+// landmarks are eliminated inside the smart factors and preconditioned CG
+// with a block-Jacobi preconditioner solves the reduced camera system
+// matrix-free, without ever assembling the Hessian.
+TEST(SmartProjectionFactor, implicitSchurPCG ) {
+
+  using namespace vanilla;
+
+  Point2Vector measurements_cam1, measurements_cam2, measurements_cam3,
+      measurements_cam4, measurements_cam5;
+
+  // Project five landmarks into three cameras
+  projectToMultipleCameras(cam1, cam2, cam3, landmark1, measurements_cam1);
+  projectToMultipleCameras(cam1, cam2, cam3, landmark2, measurements_cam2);
+  projectToMultipleCameras(cam1, cam2, cam3, landmark3, measurements_cam3);
+  projectToMultipleCameras(cam1, cam2, cam3, landmark4, measurements_cam4);
+  projectToMultipleCameras(cam1, cam2, cam3, landmark5, measurements_cam5);
+
+  KeyVector views {c1, c2, c3};
+
+  SmartProjectionParams params(gtsam::IMPLICIT_SCHUR, gtsam::IGNORE_DEGENERACY);
+
+  SmartFactor::shared_ptr smartFactor1(new SmartFactor(unit2, params));
+  smartFactor1->add(measurements_cam1, views);
+
+  SmartFactor::shared_ptr smartFactor2(new SmartFactor(unit2, params));
+  smartFactor2->add(measurements_cam2, views);
+
+  SmartFactor::shared_ptr smartFactor3(new SmartFactor(unit2, params));
+  smartFactor3->add(measurements_cam3, views);
+
+  SmartFactor::shared_ptr smartFactor4(new SmartFactor(unit2, params));
+  smartFactor4->add(measurements_cam4, views);
+
+  SmartFactor::shared_ptr smartFactor5(new SmartFactor(unit2, params));
+  smartFactor5->add(measurements_cam5, views);
+
+  const SharedDiagonal noisePrior = noiseModel::Isotropic::Sigma(6 + 5, 1e-5);
+
+  NonlinearFactorGraph graph;
+  graph.push_back(smartFactor1);
+  graph.push_back(smartFactor2);
+  graph.push_back(smartFactor3);
+  graph.push_back(smartFactor4);
+  graph.push_back(smartFactor5);
+  graph.addPrior(c1, cam1, noisePrior);
+  graph.addPrior(c2, cam2, noisePrior);
+
+  Values values;
+  values.insert(c1, cam1);
+  values.insert(c2, cam2);
+  values.insert(c3, perturbCameraPose(cam3));
+
+  LevenbergMarquardtParams lmParams;
+  lmParams.relativeErrorTol = 1e-8;
+  lmParams.absoluteErrorTol = 0;
+  lmParams.maxIterations = 20;
+  lmParams.linearSolverType = NonlinearOptimizerParams::Iterative;
+  auto pcg = boost::make_shared<PCGSolverParameters>();
+  pcg->preconditioner_ =
+      boost::make_shared<BlockJacobiPreconditionerParameters>();
+  pcg->setEpsilon_abs(1e-10);
+  pcg->setEpsilon_rel(1e-10);
+  lmParams.iterativeParams = pcg;
+
+  LevenbergMarquardtOptimizer optimizer(graph, values, lmParams);
+  Values result = optimizer.optimize();
+
+  EXPECT(assert_equal(cam1, result.at<Camera>(c1)));
+  EXPECT(assert_equal(cam2, result.at<Camera>(c2)));
+  EXPECT(assert_equal(cam3.pose(), result.at<Camera>(c3).pose(), 1e-4));
+}
+
 /* ************************************************************************* */
 BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Constrained, "gtsam_noiseModel_Constrained");
 BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
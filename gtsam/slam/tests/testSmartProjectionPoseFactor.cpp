@@ -92,6 +92,44 @@ TEST( SmartProjectionPoseFactor, params) {
   EXPECT_DOUBLES_EQUAL(1e-3, rt, 1e-7);
 }
 
+/* ************************************************************************* */
+TEST( SmartProjectionPoseFactor, appendMeasurement ) {
+  using namespace vanillaPose;
+
+  // Project one landmark into three cameras
+  Point2 z1 = cam1.project(landmark1);
+  Point2 z2 = cam2.project(landmark1);
+  Point2 z3 = cam3.project(landmark1);
+
+  Values values;
+  values.insert(x1, cam1.pose());
+  values.insert(x2, cam2.pose());
+  values.insert(x3, cam3.pose());
+
+  // Triangulate with the first two measurements...
+  SmartFactor factor(model, sharedK);
+  factor.add(z1, x1);
+  factor.add(z2, x2);
+  TriangulationResult result2 = factor.point(values);
+  CHECK(result2.valid());
+
+  // ...then append a third measurement: this re-solves the cached normal
+  // equations instead of re-triangulating from scratch
+  factor.add(z3, x3);
+  TriangulationResult result3 = factor.point(values);
+  CHECK(result3.valid());
+
+  // The result agrees with triangulating all three measurements at once
+  SmartFactor batch(model, sharedK);
+  batch.add(z1, x1);
+  batch.add(z2, x2);
+  batch.add(z3, x3);
+  TriangulationResult expected = batch.point(values);
+  CHECK(expected.valid());
+  EXPECT(assert_equal(*expected, *result3, 1e-6));
+  EXPECT(assert_equal(landmark1, *result3, 1e-6));
+}
+
 /* ************************************************************************* */
 TEST( SmartProjectionPoseFactor, Equals ) {
   using namespace vanillaPose;
@@ -332,6 +370,64 @@ TEST( SmartProjectionPoseFactor, 3poses_smart_projection_factor ) {
   EXPECT(assert_equal(pose_above, result.at<Pose3>(x3), 1e-6));
 }
 
+/* *************************************************************************/
+TEST( SmartProjectionPoseFactor, warmStartTriangulation ) {
+
+  using namespace vanillaPose;
+
+  KeyVector views {x1, x2, x3};
+
+  Point2Vector measurements_cam1;
+  projectToMultipleCameras(cam1, cam2, cam3, landmark1, measurements_cam1);
+
+  SmartFactor::shared_ptr smartFactor(new SmartFactor(model, sharedK));
+  smartFactor->add(measurements_cam1, views);
+
+  SmartFactor::Cameras cameras;
+  cameras.push_back(cam1);
+  cameras.push_back(cam2);
+  cameras.push_back(cam3);
+
+  // First call triangulates from scratch
+  CHECK(smartFactor->triangulateSafe(cameras));
+  EXPECT(assert_equal(landmark1, *smartFactor->point(), 1e-7));
+
+  // Perturb the poses just beyond the retriangulation threshold, as a late
+  // optimizer iteration would: the next call warm starts from the cached
+  // point and must land on the same result a fresh factor computes with the
+  // full pipeline
+  Vector6 xi;
+  xi << 1e-4, -1e-4, 1e-4, 1e-4, 1e-4, -1e-4;
+  SmartFactor::Cameras moved;
+  moved.push_back(Camera(cam1.pose().retract(xi), sharedK));
+  moved.push_back(Camera(cam2.pose().retract(-xi), sharedK));
+  moved.push_back(Camera(cam3.pose().retract(xi), sharedK));
+  CHECK(smartFactor->triangulateSafe(moved));
+
+  SmartFactor::shared_ptr freshFactor(new SmartFactor(model, sharedK));
+  freshFactor->add(measurements_cam1, views);
+  CHECK(freshFactor->triangulateSafe(moved));
+  EXPECT(assert_equal(*freshFactor->point(), *smartFactor->point(), 1e-6));
+
+  // Adding a measurement and moving the poses disables the warm start (the
+  // camera count changed); the fallback full triangulation must still agree
+  // with a fresh factor
+  Pose3 pose_fourth = level_pose * Pose3(Rot3(), Point3(2, 0, 0));
+  Camera cam4(pose_fourth, sharedK);
+  Symbol x4('X', 4);
+  smartFactor->add(cam4.project(landmark1), x4);
+  SmartFactor::Cameras four = cameras;
+  four.push_back(cam4);
+  CHECK(smartFactor->triangulateSafe(four));
+
+  measurements_cam1.push_back(cam4.project(landmark1));
+  KeyVector fourViews {x1, x2, x3, x4};
+  SmartFactor::shared_ptr freshFactor4(new SmartFactor(model, sharedK));
+  freshFactor4->add(measurements_cam1, fourViews);
+  CHECK(freshFactor4->triangulateSafe(four));
+  EXPECT(assert_equal(*freshFactor4->point(), *smartFactor->point(), 1e-7));
+}
+
 /* *************************************************************************/
 TEST( SmartProjectionPoseFactor, Factors ) {
 
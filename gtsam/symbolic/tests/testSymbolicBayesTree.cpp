@@ -763,6 +763,30 @@ TEST(SymbolicBayesTree, COLAMDvsMETIS) {
 #endif
 }
 
+/* ************************************************************************* */
+TEST(SymbolicBayesTree, wideCopy) {
+  // A wide tree exercises the subtree-parallel deep clone in operator=
+  SymbolicFactorGraph graph;
+  Ordering ordering;
+  for (Key j = 1; j <= 32; ++j) {
+    graph.push_factor(0, j);
+    ordering.push_back(j);
+  }
+  ordering.push_back(0);
+  SymbolicBayesTree bayesTree = *graph.eliminateMultifrontal(ordering);
+  const size_t width = bayesTree.roots().front()->children.size();
+  EXPECT(width >= 16);
+
+  SymbolicBayesTree copied;
+  copied = bayesTree;
+  EXPECT(assert_equal(bayesTree, copied));
+  EXPECT_LONGS_EQUAL(long(width), long(copied.roots().front()->children.size()));
+  // The copy is deep: distinct clique objects with their own parent pointers
+  CHECK(bayesTree.roots().front() != copied.roots().front());
+  CHECK(copied.roots().front()->children.front()->parent() ==
+      copied.roots().front());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -177,12 +177,30 @@ Template GaussianFactorGraph::shared_ptr This::buildDualGraph(
   return dualGraph;
 }
 
+//******************************************************************************
+Template GaussianFactorGraph::EliminationResult This::eliminateWithCache(
+    const GaussianFactorGraph& factors, const Ordering& keys) const {
+  // Constrained noise models need the special QR path, as in
+  // EliminatePreferCholesky; everything else goes through the Scatter cache
+  if (hasConstraints(factors))
+    return EliminateQR(factors, keys);
+  return cachedCholesky_(factors, keys);
+}
+
 //******************************************************************************
 Template GaussianFactorGraph
 This::buildWorkingGraph(const InequalityFactorGraph& workingSet,
                         const VectorValues& xk) const {
   GaussianFactorGraph workingGraph;
-  workingGraph.push_back(POLICY::buildCostFunction(problem_, xk));
+  if (POLICY::constantCostFunction) {
+    // The cost does not depend on xk: build it (e.g. converting the QP cost
+    // to Hessian form) only once and reuse it in every iteration
+    if (cachedCostFunction_.empty())
+      cachedCostFunction_ = POLICY::buildCostFunction(problem_, xk);
+    workingGraph.push_back(cachedCostFunction_);
+  } else {
+    workingGraph.push_back(POLICY::buildCostFunction(problem_, xk));
+  }
   workingGraph.push_back(problem_.equalities);
   for (const LinearInequality::shared_ptr& factor : workingSet)
     if (factor->active()) workingGraph.push_back(factor);
@@ -197,7 +215,10 @@ Template typename This::State This::iterate(
   // solve for x
   GaussianFactorGraph workingGraph =
       buildWorkingGraph(state.workingSet, state.values);
-  VectorValues newValues = workingGraph.optimize();
+  VectorValues newValues = workingGraph.optimize(
+      [this](const GaussianFactorGraph& factors, const Ordering& keys) {
+        return eliminateWithCache(factors, keys);
+      });
   // If we CAN'T move further
   // if p_k = 0 is the original condition, modified by Duy to say that the state
   // update is zero.
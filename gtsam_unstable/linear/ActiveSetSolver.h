@@ -19,6 +19,7 @@
 #pragma once
 
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
 #include <gtsam_unstable/linear/InequalityFactorGraph.h>
 #include <boost/range/adaptor/map.hpp>
 
@@ -72,6 +73,16 @@ protected:
   /// Vector of key matrix pairs. Matrices are usually the A term for a factor.
   typedef std::vector<std::pair<Key, Matrix> > TermsContainer;
 
+  /** Cost function built once and reused in every iteration, for policies
+   * whose cost does not depend on the current solution (QP, but not LP). */
+  mutable GaussianFactorGraph cachedCostFunction_;
+
+  /** Scatter cache for the per-iteration factorizations. Consecutive working
+   * sets differ by a single constraint, so most elimination subproblems recur
+   * unchanged from one iteration to the next, and across repeated solves of
+   * closely related problems on the same solver instance. */
+  mutable CachedEliminateCholesky cachedCholesky_;
+
 public:
   /// Constructor
   ActiveSetSolver(const PROBLEM& problem) :  problem_(problem) {
@@ -85,6 +96,10 @@ public:
    * Optimize with provided initial values
    * For this version, it is the responsibility of the caller to provide
    * a feasible initial value, otherwise, an exception will be thrown.
+   * With useWarmStart, the initial working set is seeded from the provided
+   * duals (typically those returned by a previous solve) instead of being
+   * identified from the initial values, which saves most working-set
+   * iterations when solving a sequence of closely related problems.
    * @return a pair of <primal, dual> solutions
    */
   std::pair<VectorValues, VectorValues> optimize(
@@ -151,6 +166,14 @@ protected:
     Key key, const InequalityFactorGraph& workingSet,
     const VectorValues& delta) const;
 
+  /**
+   * Elimination function for the per-iteration working graphs. Behaves like
+   * EliminatePreferCholesky, but reuses the Scatter structures cached in
+   * cachedCholesky_ for the unconstrained subproblems.
+   */
+  GaussianFactorGraph::EliminationResult eliminateWithCache(
+      const GaussianFactorGraph& factors, const Ordering& keys) const;
+
 public: /// Just for testing...
 
   /// Builds a dual graph from the current working set.
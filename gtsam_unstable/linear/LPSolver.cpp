@@ -21,5 +21,6 @@
 
 namespace gtsam {
 constexpr double LPPolicy::maxAlpha;
+constexpr bool LPPolicy::constantCostFunction;
 }
 
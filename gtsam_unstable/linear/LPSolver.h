@@ -32,6 +32,9 @@ struct LPPolicy {
   /// For LP, maxAlpha = Infinity
   static constexpr double maxAlpha = std::numeric_limits<double>::infinity();
 
+  /// The LP gradient-projection cost below depends on xk: rebuild per iteration
+  static constexpr bool constantCostFunction = false;
+
   /**
    * Create the factor ||x-xk - (-g)||^2 where xk is the current feasible solution
    * on the constraint surface and g is the gradient of the linear cost,
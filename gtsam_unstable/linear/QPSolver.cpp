@@ -20,4 +20,5 @@
 
 namespace gtsam {
 constexpr double QPPolicy::maxAlpha;
+constexpr bool QPPolicy::constantCostFunction;
 }
\ No newline at end of file
@@ -31,6 +31,9 @@ struct QPPolicy {
   /// For QP, maxAlpha = 1 is the minimum point of the quadratic cost
   static constexpr double maxAlpha = 1.0;
 
+  /// The QP cost below ignores xk, so it can be built once and reused
+  static constexpr bool constantCostFunction = true;
+
   /// Simply the cost of the QP problem
   static const GaussianFactorGraph buildCostFunction(const QP& qp,
       const VectorValues& xk = VectorValues()) {
@@ -418,6 +418,27 @@ TEST(QPSolver, optimizeNocedal06bookEx16_4) {
   CHECK(assert_equal(expectedSolution, solution, 1e-7));
 }
 
+/* ************************************************************************* */
+TEST(QPSolver, warmStart) {
+  QP qp = createTestNocedal06bookEx16_4();
+  QPSolver solver(qp);
+  VectorValues initialValues;
+  initialValues.insert(X(1), (Vector(1) << 2.0).finished());
+  initialValues.insert(X(2), Z_1x1);
+
+  // Cold solve, keeping the duals of the active constraints
+  VectorValues solution, duals;
+  boost::tie(solution, duals) = solver.optimize(initialValues);
+
+  // Re-solve seeding the working set from the previous duals, as an MPC loop
+  // would between consecutive near-identical problems. Starting from the
+  // previous solution with the correct active set, this converges immediately.
+  VectorValues warmSolution, warmDuals;
+  boost::tie(warmSolution, warmDuals) = solver.optimize(solution, duals, true);
+  CHECK(assert_equal(solution, warmSolution, 1e-7));
+  CHECK(assert_equal(duals, warmDuals, 1e-7));
+}
+
 /* ************************************************************************* */
 TEST(QPSolver, failedSubproblem) {
   QP qp;
@@ -177,8 +177,19 @@ void BatchFixedLagSmoother::eraseKeys(const KeyVector& keys) {
 
 /* ************************************************************************* */
 void BatchFixedLagSmoother::reorder(const KeyVector& marginalizeKeys) {
-  // COLAMD groups will be used to place marginalize keys in Group 0, and everything else in Group 1
-  ordering_ = Ordering::ColamdConstrainedFirst(factors_, marginalizeKeys);
+  if (parameters_.orderingType == Ordering::METIS) {
+    // Nested dissection splits the window into weakly coupled blocks joined by
+    // small separators.  Under TBB the multifrontal solve in optimize() then
+    // eliminates those blocks concurrently, with the separator cliques
+    // combining their results, so this ordering turns the window solve into a
+    // partitioned parallel solve.  The ordering is only used by optimize();
+    // marginalize() eliminates the marginalizable keys explicitly, so they do
+    // not need to be placed first here.
+    ordering_ = Ordering::Metis(factors_);
+  } else {
+    // COLAMD groups will be used to place marginalize keys in Group 0, and everything else in Group 1
+    ordering_ = Ordering::ColamdConstrainedFirst(factors_, marginalizeKeys);
+  }
 }
 
 /* ************************************************************************* */
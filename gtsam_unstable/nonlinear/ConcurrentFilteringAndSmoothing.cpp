@@ -48,6 +48,63 @@ void synchronize(ConcurrentFilter& filter, ConcurrentSmoother& smoother) {
   smoother.postsync();
 }
 
+/* ************************************************************************* */
+bool ConcurrentSynchronizer::trySynchronizeFilter() {
+
+  // The smoother side still owns the buffers: skip, never wait
+  if(turn_.load(std::memory_order_acquire) != FILTER)
+    return false;
+
+  filter_.presync();
+
+  // Apply the summarization the smoother published at the end of its last
+  // turn (empty before the first exchange, as with 'synchronize')
+  filter_.synchronize(smootherSummarization_, smootherSeparatorValues_);
+
+  // Stage the filter hand-off for the smoother
+  smootherFactors_ = NonlinearFactorGraph();
+  smootherValues_ = Values();
+  filterSummarization_ = NonlinearFactorGraph();
+  filterSeparatorValues_ = Values();
+  filter_.getSmootherFactors(smootherFactors_, smootherValues_);
+  filter_.getSummarizedFactors(filterSummarization_, filterSeparatorValues_);
+
+  filter_.postsync();
+
+  // Hand the buffers to the smoother side
+  turn_.store(SMOOTHER, std::memory_order_release);
+  return true;
+}
+
+/* ************************************************************************* */
+bool ConcurrentSynchronizer::trySynchronizeSmoother(const boost::function<void()>& runSmootherUpdate) {
+
+  // Nothing staged by the filter yet
+  if(turn_.load(std::memory_order_acquire) != SMOOTHER)
+    return false;
+
+  smoother_.presync();
+
+  // Consume the staged filter hand-off
+  smoother_.synchronize(smootherFactors_, smootherValues_, filterSummarization_, filterSeparatorValues_);
+
+  // Run the (long) smoother iterations before publishing, so the
+  // summarization reflects the hand-off just consumed
+  if(runSmootherUpdate)
+    runSmootherUpdate();
+
+  // Publish the fresh summarization for the filter's next turn
+  smootherSummarization_ = NonlinearFactorGraph();
+  smootherSeparatorValues_ = Values();
+  smoother_.getSummarizedFactors(smootherSummarization_, smootherSeparatorValues_);
+
+  smoother_.postsync();
+
+  // Hand the buffers back to the filter side
+  turn_.store(FILTER, std::memory_order_release);
+  return true;
+}
+
 namespace internal {
 
 /* ************************************************************************* */
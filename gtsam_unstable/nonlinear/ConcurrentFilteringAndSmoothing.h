@@ -24,6 +24,8 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <boost/function.hpp>
+#include <atomic>
 
 namespace gtsam {
 
@@ -147,6 +149,79 @@ public:
 
 }; // ConcurrentSmoother
 
+/**
+ * A split-phase, double-buffered alternative to the 'synchronize' function for
+ * running the smoother on a worker thread. The exchange is broken into a filter
+ * half and a smoother half that communicate through buffers owned by this
+ * class; a single atomic turn flag hands the buffers back and forth, so neither
+ * side ever takes a lock, and the filter half never waits on the smoother: if
+ * the smoother is still busy with the previous exchange, trySynchronizeFilter
+ * returns false immediately and the filter simply tries again after its next
+ * update.
+ *
+ * Intended usage, with the smoother owned by a worker thread:
+ *
+ *   // filter (real-time) thread, after each filter.update(...)
+ *   synchronizer.trySynchronizeFilter();
+ *
+ *   // smoother (worker) thread, in a loop
+ *   synchronizer.trySynchronizeSmoother([&](){ smoother.update(); });
+ *
+ * The protocol is the same strict alternation performed by 'synchronize': the
+ * smoother half consumes the staged filter hand-off, runs the (long) smoother
+ * update, and only then publishes the resulting summarization, so the filter
+ * always receives a summarization consistent with its previous hand-off.
+ */
+class GTSAM_UNSTABLE_EXPORT ConcurrentSynchronizer {
+public:
+
+  /** Create a synchronizer exchanging data between the given filter and smoother */
+  ConcurrentSynchronizer(ConcurrentFilter& filter, ConcurrentSmoother& smoother)
+    : filter_(filter), smoother_(smoother), turn_(FILTER) {}
+
+  /**
+   * Filter half of the exchange: apply the last published smoother
+   * summarization and stage the filter hand-off for the smoother. Call from
+   * the filter thread; never blocks.
+   *
+   * @return true if the exchange was performed, false if the smoother half
+   *         of the previous exchange has not completed yet
+   */
+  bool trySynchronizeFilter();
+
+  /**
+   * Smoother half of the exchange: consume the staged filter hand-off, run
+   * the provided smoother update, and publish the fresh summarization. Call
+   * from the smoother thread.
+   *
+   * @param runSmootherUpdate Functor performing the smoother iterations,
+   *        typically wrapping smoother.update()
+   * @return true if the exchange was performed, false if the filter has not
+   *         staged a new hand-off yet
+   */
+  bool trySynchronizeSmoother(const boost::function<void()>& runSmootherUpdate);
+
+private:
+
+  /** Which side currently owns the buffers */
+  enum Turn { FILTER, SMOOTHER };
+
+  ConcurrentFilter& filter_;
+  ConcurrentSmoother& smoother_;
+  std::atomic<int> turn_;
+
+  /** Filter-to-smoother buffers, staged by trySynchronizeFilter */
+  NonlinearFactorGraph smootherFactors_;
+  Values smootherValues_;
+  NonlinearFactorGraph filterSummarization_;
+  Values filterSeparatorValues_;
+
+  /** Smoother-to-filter buffers, published by trySynchronizeSmoother */
+  NonlinearFactorGraph smootherSummarization_;
+  Values smootherSeparatorValues_;
+
+}; // ConcurrentSynchronizer
+
 namespace internal {
 
   /** Calculate the marginal on the specified keys, returning a set of LinearContainerFactors.
@@ -20,6 +20,8 @@
 #include <gtsam/base/timing.h>
 #include <gtsam/base/debug.h>
 
+#include <chrono>
+
 namespace gtsam {
 
 /* ************************************************************************* */
@@ -180,6 +182,10 @@ void ConcurrentIncrementalFilter::synchronize(const NonlinearFactorGraph& smooth
 
   if(debug) std::cout << "ConcurrentIncrementalFilter::synchronize  Begin" << std::endl;
 
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point syncStart = Clock::now();
+  synchronizationStats_ = SynchronizationStats();
+
   // Update the smoother summarization on the old separator
   previousSmootherSummarization_ = smootherSummarization;
 
@@ -211,13 +217,47 @@ void ConcurrentIncrementalFilter::synchronize(const NonlinearFactorGraph& smooth
 
   // Remove the old factors on the separator and insert the new ones
   FactorIndices removeFactors(currentSmootherSummarizationSlots_.begin(), currentSmootherSummarizationSlots_.end());
-  ISAM2Result result = isam2_.update(currentSmootherSummarization, Values(), removeFactors, boost::none, noRelinKeys, boost::none, false);
-  currentSmootherSummarizationSlots_ = result.newFactorsIndices;
+
+  // Estimate the clique set the exchange will touch: every clique containing
+  // a key of a removed or inserted summarization factor
+  std::set<const ISAM2Clique*> affectedCliques;
+  KeySet exchangeKeys = currentSmootherSummarization.keys();
+  for(size_t slot: removeFactors) {
+    const NonlinearFactor::shared_ptr& factor = isam2_.getFactorsUnsafe().at(slot);
+    if(factor) {
+      exchangeKeys.insert(factor->begin(), factor->end());
+    }
+  }
+  for(Key key: exchangeKeys) {
+    ISAM2::Nodes::const_iterator clique = isam2_.nodes().find(key);
+    if(clique != isam2_.nodes().end()) {
+      affectedCliques.insert(clique->second.get());
+    }
+  }
+  synchronizationStats_.cliquesAffected = affectedCliques.size();
+
+  if(maxSynchronizationCliques_ > 0 && affectedCliques.size() > maxSynchronizationCliques_) {
+    // Over budget: defer the exchange.  The old summarized factors stay in
+    // place, so the filter keeps running on the state it had before this
+    // call; the summarization chain below remains consistent, and the next
+    // synchronize() supersedes this exchange with a fresh summarization.
+    synchronizationStats_.deferred = true;
+  } else {
+    ISAM2Result result = isam2_.update(currentSmootherSummarization, Values(), removeFactors, boost::none, noRelinKeys, boost::none, false);
+    currentSmootherSummarizationSlots_ = result.newFactorsIndices;
+    synchronizationStats_.variablesReeliminated = result.variablesReeliminated;
+    synchronizationStats_.variablesRelinearized = result.variablesRelinearized;
+    synchronizationStats_.factorsRemoved = removeFactors.size();
+    synchronizationStats_.factorsAdded = currentSmootherSummarization.size();
+  }
 
   // Set the previous smoother summarization to the current smoother summarization and clear the smoother shortcut
   previousSmootherSummarization_ = currentSmootherSummarization;
   smootherShortcut_.resize(0);
 
+  synchronizationStats_.durationSeconds =
+      std::chrono::duration<double>(Clock::now() - syncStart).count();
+
   if(debug) std::cout << "ConcurrentIncrementalFilter::synchronize  End" << std::endl;
 
   gttoc(synchronize);
@@ -60,8 +60,28 @@ public:
     double getError() const { return error; }
   };
 
+  /** Telemetry about the most recent synchronize() call.  The separator
+   * factor exchange inside synchronize() can re-eliminate a large part of
+   * the Bayes tree depending on root-clique involvement; these counters make
+   * that cost observable per call, and record when an exchange was deferred
+   * because it exceeded the synchronization budget. */
+  struct SynchronizationStats {
+    size_t cliquesAffected; ///< Cliques containing keys touched by the separator factor exchange
+    size_t variablesReeliminated; ///< Variables re-eliminated while applying the exchange
+    size_t variablesRelinearized; ///< Variables relinearized while applying the exchange
+    size_t factorsRemoved; ///< Old smoother summarization factors removed
+    size_t factorsAdded; ///< New smoother summarization factors inserted
+    bool deferred; ///< True if the exchange exceeded the budget and was deferred
+    double durationSeconds; ///< Wall-clock latency of the synchronize() call
+
+    /// Constructor
+    SynchronizationStats() : cliquesAffected(0), variablesReeliminated(0),
+        variablesRelinearized(0), factorsRemoved(0), factorsAdded(0),
+        deferred(false), durationSeconds(0.0) {};
+  };
+
   /** Default constructor */
-  ConcurrentIncrementalFilter(const ISAM2Params& parameters = ISAM2Params()) : isam2_(parameters) {};
+  ConcurrentIncrementalFilter(const ISAM2Params& parameters = ISAM2Params()) : isam2_(parameters), maxSynchronizationCliques_(0) {};
 
   /** Default destructor */
   virtual ~ConcurrentIncrementalFilter() {};
@@ -164,6 +184,27 @@ public:
    */
   virtual void postsync();
 
+  /** Set the synchronization budget: the maximum number of cliques a single
+   * synchronize() call may touch when exchanging the smoother summarization
+   * factors.  When an exchange would affect more cliques, it is deferred -
+   * the filter keeps running on the previous summarization, which is exactly
+   * the state it was in before the call, and the next synchronize()
+   * supersedes the deferred exchange with a fresh summarization.  A budget
+   * of 0 (the default) means unbounded. */
+  void setSynchronizationBudget(size_t maxCliquesPerSync) {
+    maxSynchronizationCliques_ = maxCliquesPerSync;
+  }
+
+  /** The current synchronization budget, 0 if unbounded */
+  size_t getSynchronizationBudget() const {
+    return maxSynchronizationCliques_;
+  }
+
+  /** Telemetry about the most recent synchronize() call */
+  const SynchronizationStats& getSynchronizationStats() const {
+    return synchronizationStats_;
+  }
+
 protected:
 
   ISAM2 isam2_; ///< The iSAM2 inference engine
@@ -177,6 +218,9 @@ protected:
   NonlinearFactorGraph smootherFactors_;  ///< A temporary holding place for the set of full nonlinear factors being sent to the smoother
   Values smootherValues_; ///< A temporary holding place for the linearization points of all keys being sent to the smoother
 
+  size_t maxSynchronizationCliques_; ///< Bound on cliques touched per synchronize(), 0 = unbounded
+  SynchronizationStats synchronizationStats_; ///< Telemetry about the most recent synchronize()
+
 private:
 
   /** Traverse the iSAM2 Bayes Tree, inserting all descendants of the provided index/key into 'additionalKeys' */
@@ -46,6 +46,23 @@ void recursiveMarkAffectedKeys(const Key& key,
   // If the key was not found in the separator/parents, then none of its children can have it either
 }
 
+/* ************************************************************************* */
+// Check that every frontal variable of this clique and of all of its
+// descendants is marginalizable, i.e. the clique roots a subtree that can be
+// pruned wholesale by ISAM2::marginalizeLeaves without re-elimination
+static bool cliqueFullyMarginalizable(const ISAM2Clique::shared_ptr& clique,
+    const KeySet& marginalizableKeys) {
+  for(Key frontal: clique->conditional()->frontals()) {
+    if (!marginalizableKeys.exists(frontal))
+      return false;
+  }
+  for(const ISAM2Clique::shared_ptr& child: clique->children) {
+    if (!cliqueFullyMarginalizable(child, marginalizableKeys))
+      return false;
+  }
+  return true;
+}
+
 /* ************************************************************************* */
 void IncrementalFixedLagSmoother::print(const std::string& s,
     const KeyFormatter& keyFormatter) const {
@@ -99,8 +116,23 @@ FixedLagSmoother::Result IncrementalFixedLagSmoother::update(
     std::cout << std::endl;
   }
 
+  // In steady-state operation the ordering constraints applied on previous
+  // updates have already pushed the variables now crossing the lag boundary
+  // into leaf cliques.  When that is the case, and no new or removed factor
+  // touches them, the constrained reordering and forced re-elimination below
+  // would only reproduce the existing tree structure at the cost of
+  // re-eliminating everything between the marginalizable keys and the root,
+  // so they are skipped and marginalizeLeaves prunes the leaves directly.
+  const bool alreadyLeaves = marginalizableKeysAreLeaves(marginalizableKeys,
+      newFactors, factorsToRemove);
+
+  if (debug && alreadyLeaves)
+    std::cout << "Marginalizable keys are already leaves, skipping reordering"
+        << std::endl;
+
   // Force iSAM2 to put the marginalizable variables at the beginning
-  createOrderingConstraints(marginalizableKeys, constrainedKeys);
+  if (!alreadyLeaves)
+    createOrderingConstraints(marginalizableKeys, constrainedKeys);
 
   if (debug) {
     std::cout << "Constrained Keys: ";
@@ -116,10 +148,12 @@ FixedLagSmoother::Result IncrementalFixedLagSmoother::update(
 
   // Mark additional keys between the marginalized keys and the leaves
   std::set<Key> additionalKeys;
-  for(Key key: marginalizableKeys) {
-    ISAM2Clique::shared_ptr clique = isam_[key];
-    for(const ISAM2Clique::shared_ptr& child: clique->children) {
-      recursiveMarkAffectedKeys(key, child, additionalKeys);
+  if (!alreadyLeaves) {
+    for(Key key: marginalizableKeys) {
+      ISAM2Clique::shared_ptr clique = isam_[key];
+      for(const ISAM2Clique::shared_ptr& child: clique->children) {
+        recursiveMarkAffectedKeys(key, child, additionalKeys);
+      }
     }
   }
   KeyList additionalMarkedKeys(additionalKeys.begin(), additionalKeys.end());
@@ -172,6 +206,48 @@ void IncrementalFixedLagSmoother::eraseKeysBefore(double timestamp) {
   }
 }
 
+/* ************************************************************************* */
+bool IncrementalFixedLagSmoother::marginalizableKeysAreLeaves(
+    const KeyVector& marginalizableKeys, const NonlinearFactorGraph& newFactors,
+    const FactorIndices& factorsToRemove) const {
+  if (marginalizableKeys.empty())
+    return false;
+
+  const KeySet marginalizableSet(marginalizableKeys.begin(),
+      marginalizableKeys.end());
+
+  // Any factor added or removed on a marginalizable variable will cause its
+  // clique to be re-eliminated, so the ordering constraints are still needed
+  for(const NonlinearFactor::shared_ptr& factor: newFactors) {
+    for(Key key: factor->keys()) {
+      if (marginalizableSet.exists(key))
+        return false;
+    }
+  }
+  for(size_t slot: factorsToRemove) {
+    const NonlinearFactor::shared_ptr& factor = isam_.getFactorsUnsafe()[slot];
+    if (factor) {
+      for(Key key: factor->keys()) {
+        if (marginalizableSet.exists(key))
+          return false;
+      }
+    }
+  }
+
+  // Every marginalizable variable must live in a clique whose subtree contains
+  // only marginalizable frontal variables
+  std::set<ISAM2Clique::shared_ptr> checked;
+  for(Key key: marginalizableKeys) {
+    const ISAM2::Nodes::const_iterator node = isam_.nodes().find(key);
+    if (node == isam_.nodes().end())
+      return false;
+    if (checked.insert(node->second).second
+        && !cliqueFullyMarginalizable(node->second, marginalizableSet))
+      return false;
+  }
+  return true;
+}
+
 /* ************************************************************************* */
 void IncrementalFixedLagSmoother::createOrderingConstraints(
     const KeyVector& marginalizableKeys,
@@ -132,6 +132,15 @@ protected:
   /** Erase any keys associated with timestamps before the provided time */
   void eraseKeysBefore(double timestamp);
 
+  /** Check whether the marginalizable keys already form leaf subtrees of the
+   * Bayes tree and are untouched by the new and removed factors.  In that case
+   * the ordering constraints and the forced re-elimination of everything
+   * between those keys and the root can be skipped, bounding the per-update
+   * marginalization cost in steady-state operation. */
+  bool marginalizableKeysAreLeaves(const KeyVector& marginalizableKeys,
+      const NonlinearFactorGraph& newFactors,
+      const FactorIndices& factorsToRemove) const;
+
   /** Fill in an iSAM2 ConstrainedKeys structure such that the provided keys are eliminated before all others */
   void createOrderingConstraints(const KeyVector& marginalizableKeys,
       boost::optional<FastMap<Key, int> >& constrainedKeys) const;
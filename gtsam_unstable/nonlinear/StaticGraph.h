@@ -0,0 +1,303 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file StaticGraph.h
+ * @brief Compile-time factor graph for small problems with fixed topology
+ * @author Frank Dellaert
+ * @date Aug 30, 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/Manifold.h>
+#include <gtsam/base/OptionalJacobian.h>
+
+#include <tuple>
+
+namespace gtsam {
+
+namespace internal {
+
+/// Tangent dimension of the I-th type in a variable list, all compile time
+template <size_t I, class... VARIABLES>
+struct StaticListDim;
+
+template <class VARIABLE, class... VARIABLES>
+struct StaticListDim<0, VARIABLE, VARIABLES...> {
+  static const int value = traits<VARIABLE>::dimension;
+};
+
+template <size_t I, class VARIABLE, class... VARIABLES>
+struct StaticListDim<I, VARIABLE, VARIABLES...> {
+  static const int value = StaticListDim<I - 1, VARIABLES...>::value;
+};
+
+/// Offset of the I-th variable in the stacked tangent vector
+template <size_t I, class... VARIABLES>
+struct StaticListOffset;
+
+template <class VARIABLE, class... VARIABLES>
+struct StaticListOffset<0, VARIABLE, VARIABLES...> {
+  static const int value = 0;
+};
+
+template <size_t I, class VARIABLE, class... VARIABLES>
+struct StaticListOffset<I, VARIABLE, VARIABLES...> {
+  static const int value =
+      traits<VARIABLE>::dimension + StaticListOffset<I - 1, VARIABLES...>::value;
+};
+
+/// Total tangent dimension of a variable list
+template <class... VARIABLES>
+struct StaticListTotalDim;
+
+template <>
+struct StaticListTotalDim<> {
+  static const int value = 0;
+};
+
+template <class VARIABLE, class... VARIABLES>
+struct StaticListTotalDim<VARIABLE, VARIABLES...> {
+  static const int value =
+      traits<VARIABLE>::dimension + StaticListTotalDim<VARIABLES...>::value;
+};
+
+}  // namespace internal
+
+/**
+ * Fixed set of manifold variables, identified by position instead of Key.
+ * The stacked tangent dimension, per-variable offsets, and the retract
+ * loop are all resolved at compile time, so updating the values after a
+ * solve touches no heap and no virtual dispatch.  This is the Values
+ * analogue for StaticGraph below.
+ */
+template <class... VARIABLES>
+class StaticValues {
+ public:
+  /// Total dimension of the stacked tangent space
+  static const int dimension = internal::StaticListTotalDim<VARIABLES...>::value;
+
+  typedef Eigen::Matrix<double, dimension, 1> TangentVector;
+
+  /// Type of the I-th variable
+  template <size_t I>
+  using Type = typename std::tuple_element<I, std::tuple<VARIABLES...> >::type;
+
+  /// Tangent dimension and offset of the I-th variable
+  template <size_t I>
+  static constexpr int Dim() {
+    return internal::StaticListDim<I, VARIABLES...>::value;
+  }
+  template <size_t I>
+  static constexpr int Offset() {
+    return internal::StaticListOffset<I, VARIABLES...>::value;
+  }
+
+  StaticValues() {}
+
+  explicit StaticValues(const VARIABLES&... values) : values_(values...) {}
+
+  /// Access the I-th variable
+  template <size_t I>
+  const Type<I>& at() const {
+    return std::get<I>(values_);
+  }
+
+  template <size_t I>
+  Type<I>& at() {
+    return std::get<I>(values_);
+  }
+
+  /// Retract all variables along the stacked tangent vector delta
+  void retractInPlace(const TangentVector& delta) {
+    retract_<0>(delta);
+  }
+
+ private:
+  std::tuple<VARIABLES...> values_;
+
+  template <size_t I>
+  typename std::enable_if<I == sizeof...(VARIABLES)>::type retract_(
+      const TangentVector&) {}
+
+  template <size_t I>
+      typename std::enable_if < I<sizeof...(VARIABLES)>::type retract_(
+                                    const TangentVector& delta) {
+    typedef typename std::tuple_element<I, std::tuple<VARIABLES...> >::type T;
+    std::get<I>(values_) = traits<T>::Retract(
+        std::get<I>(values_), delta.template segment<Dim<I>()>(Offset<I>()));
+    retract_<I + 1>(delta);
+  }
+};
+
+/**
+ * Unary measurement on the I-th variable of a StaticValues.  ERROR_FUNC is a
+ * functor returning the fixed-size unwhitened error and optionally the
+ * Jacobian:
+ *
+ *   Eigen::Matrix<double,M,1> operator()(const X&, OptionalJacobian<M,D>) const
+ *
+ * sigmas plays the role of a diagonal noise model; whitening is a
+ * componentwise multiply by the precomputed inverse sigmas.
+ */
+template <size_t I, int M, class ERROR_FUNC>
+class StaticUnaryFactor {
+ public:
+  StaticUnaryFactor(const ERROR_FUNC& h, const Eigen::Matrix<double, M, 1>& sigmas)
+      : h_(h), invSigmas_(sigmas.cwiseInverse()) {}
+
+  /// Add this factor's contribution to the dense normal equations H*delta = g
+  template <class VALUES, int N>
+  void accumulate(const VALUES& x, Eigen::Matrix<double, N, N>* H,
+                  Eigen::Matrix<double, N, 1>* g) const {
+    const int O = VALUES::template Offset<I>();
+    Eigen::Matrix<double, M, VALUES::template Dim<I>()> A;
+    Eigen::Matrix<double, M, 1> b = -h_(x.template at<I>(), A);
+    A.array().colwise() *= invSigmas_.array();
+    b.array() *= invSigmas_.array();
+    H->template block<VALUES::template Dim<I>(), VALUES::template Dim<I>()>(O, O) +=
+        A.transpose() * A;
+    g->template segment<VALUES::template Dim<I>()>(O) += A.transpose() * b;
+  }
+
+  /// Contribution to the total error 0.5 * |whitened|^2
+  template <class VALUES>
+  double error(const VALUES& x) const {
+    Eigen::Matrix<double, M, 1> e = h_(x.template at<I>(), boost::none);
+    return 0.5 * e.cwiseProduct(invSigmas_).squaredNorm();
+  }
+
+ private:
+  ERROR_FUNC h_;
+  Eigen::Matrix<double, M, 1> invSigmas_;
+};
+
+/**
+ * Binary measurement between the I-th and J-th variables, I != J.
+ * ERROR_FUNC follows the same convention as for StaticUnaryFactor but with
+ * two arguments and two optional Jacobians.
+ */
+template <size_t I, size_t J, int M, class ERROR_FUNC>
+class StaticBinaryFactor {
+ public:
+  StaticBinaryFactor(const ERROR_FUNC& h, const Eigen::Matrix<double, M, 1>& sigmas)
+      : h_(h), invSigmas_(sigmas.cwiseInverse()) {
+    static_assert(I != J, "StaticBinaryFactor needs two distinct variables");
+  }
+
+  template <class VALUES, int N>
+  void accumulate(const VALUES& x, Eigen::Matrix<double, N, N>* H,
+                  Eigen::Matrix<double, N, 1>* g) const {
+    const int Oi = VALUES::template Offset<I>(), Oj = VALUES::template Offset<J>();
+    Eigen::Matrix<double, M, VALUES::template Dim<I>()> Ai;
+    Eigen::Matrix<double, M, VALUES::template Dim<J>()> Aj;
+    Eigen::Matrix<double, M, 1> b = -h_(x.template at<I>(), x.template at<J>(), Ai, Aj);
+    Ai.array().colwise() *= invSigmas_.array();
+    Aj.array().colwise() *= invSigmas_.array();
+    b.array() *= invSigmas_.array();
+    H->template block<VALUES::template Dim<I>(), VALUES::template Dim<I>()>(Oi, Oi) +=
+        Ai.transpose() * Ai;
+    H->template block<VALUES::template Dim<J>(), VALUES::template Dim<J>()>(Oj, Oj) +=
+        Aj.transpose() * Aj;
+    const Eigen::Matrix<double, VALUES::template Dim<I>(), VALUES::template Dim<J>()>
+        Aij = Ai.transpose() * Aj;
+    H->template block<VALUES::template Dim<I>(), VALUES::template Dim<J>()>(Oi, Oj) += Aij;
+    H->template block<VALUES::template Dim<J>(), VALUES::template Dim<I>()>(Oj, Oi) +=
+        Aij.transpose();
+    g->template segment<VALUES::template Dim<I>()>(Oi) += Ai.transpose() * b;
+    g->template segment<VALUES::template Dim<J>()>(Oj) += Aj.transpose() * b;
+  }
+
+  template <class VALUES>
+  double error(const VALUES& x) const {
+    Eigen::Matrix<double, M, 1> e =
+        h_(x.template at<I>(), x.template at<J>(), boost::none, boost::none);
+    return 0.5 * e.cwiseProduct(invSigmas_).squaredNorm();
+  }
+
+ private:
+  ERROR_FUNC h_;
+  Eigen::Matrix<double, M, 1> invSigmas_;
+};
+
+/**
+ * Factor graph whose topology is fixed at compile time: the variables are a
+ * StaticValues instantiation and the factors a tuple of Static*Factor types
+ * above.  Linearization accumulates directly into a dense fixed-size
+ * information matrix, which a stack-allocated LDLT then solves; for the
+ * handful of variables this is meant for, that is equivalent to eliminating
+ * in any order and avoids all of the dynamic machinery (Keys, VariableIndex,
+ * elimination trees, shared_ptr factors).  Everything lives on the stack,
+ * so iterate/optimize are allocation-free and deterministic.
+ *
+ * Intended for embedded problems such as a short IMU chain with a few GPS
+ * factors; for anything whose topology is decided at run time, use
+ * NonlinearFactorGraph.
+ */
+template <class VALUES, class... FACTORS>
+class StaticGraph {
+ public:
+  static const int N = VALUES::dimension;
+  typedef Eigen::Matrix<double, N, N> HessianMatrix;
+  typedef Eigen::Matrix<double, N, 1> TangentVector;
+
+  explicit StaticGraph(const FACTORS&... factors) : factors_(factors...) {}
+
+  /// Total error 0.5 * sum of squared whitened errors, as in NonlinearFactorGraph
+  double error(const VALUES& x) const {
+    return error_<0>(x);
+  }
+
+  /// Build and solve the normal equations at x, returning the update delta
+  TangentVector linearizeAndSolve(const VALUES& x) const {
+    HessianMatrix H = HessianMatrix::Zero();
+    TangentVector g = TangentVector::Zero();
+    accumulate_<0>(x, &H, &g);
+    return H.ldlt().solve(g);
+  }
+
+  /// A fixed number of Gauss-Newton iterations, no early-out bookkeeping
+  VALUES optimize(VALUES x, size_t iterations = 10) const {
+    for (size_t i = 0; i < iterations; i++)
+      x.retractInPlace(linearizeAndSolve(x));
+    return x;
+  }
+
+ private:
+  std::tuple<FACTORS...> factors_;
+
+  template <size_t K>
+  typename std::enable_if<K == sizeof...(FACTORS)>::type accumulate_(
+      const VALUES&, HessianMatrix*, TangentVector*) const {}
+
+  template <size_t K>
+      typename std::enable_if < K<sizeof...(FACTORS)>::type accumulate_(
+                                    const VALUES& x, HessianMatrix* H,
+                                    TangentVector* g) const {
+    std::get<K>(factors_).accumulate(x, H, g);
+    accumulate_<K + 1>(x, H, g);
+  }
+
+  template <size_t K>
+  typename std::enable_if<K == sizeof...(FACTORS), double>::type error_(
+      const VALUES&) const {
+    return 0.0;
+  }
+
+  template <size_t K>
+      typename std::enable_if <
+      K<sizeof...(FACTORS), double>::type error_(const VALUES& x) const {
+    return std::get<K>(factors_).error(x) + error_<K + 1>(x);
+  }
+};
+
+}  // \ namespace gtsam
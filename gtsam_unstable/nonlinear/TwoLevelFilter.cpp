@@ -0,0 +1,138 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TwoLevelFilter.cpp
+ * @brief   A two-level solver separating fast trajectory variables from a
+ *          slowly-changing map layer with lazily refreshed summarization.
+ * @author  Stephen Williams
+ */
+#include <gtsam_unstable/nonlinear/TwoLevelFilter.h>
+#include <gtsam_unstable/nonlinear/ConcurrentFilteringAndSmoothing.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void TwoLevelFilter::print(const std::string& s, const KeyFormatter& keyFormatter) const {
+  std::cout << s;
+  isam2_.print("Trajectory Layer:\n");
+  mapFactors_.print("Map Factors:\n");
+  mapValues_.print("Map Values:\n");
+}
+
+/* ************************************************************************* */
+bool TwoLevelFilter::equals(const TwoLevelFilter& rhs, double tol) const {
+  return isam2_.equals(rhs.isam2_)
+      && mapFactors_.equals(rhs.mapFactors_, tol)
+      && mapValues_.equals(rhs.mapValues_, tol)
+      && (mapKeys_ == rhs.mapKeys_)
+      && (mapSummarySlots_.size() == rhs.mapSummarySlots_.size())
+      && std::equal(mapSummarySlots_.begin(), mapSummarySlots_.end(), rhs.mapSummarySlots_.begin());
+}
+
+/* ************************************************************************* */
+ISAM2Result TwoLevelFilter::update(const NonlinearFactorGraph& newFactors, const Values& newTheta,
+    const KeySet& newMapKeys) {
+
+  gttic(update);
+
+  // Register the new map keys and store their linearization points
+  mapKeys_.insert(newMapKeys.begin(), newMapKeys.end());
+  Values trajectoryTheta;
+  for(const Values::ConstKeyValuePair& key_value: newTheta) {
+    if(mapKeys_.count(key_value.key) > 0) {
+      if(!mapValues_.exists(key_value.key)) {
+        mapValues_.insert(key_value.key, key_value.value);
+      }
+    } else {
+      trajectoryTheta.insert(key_value.key, key_value.value);
+    }
+  }
+
+  // Route each factor to the layer it belongs to: any factor touching a map
+  // variable stays out of the active tree until the next refreshMap()
+  NonlinearFactorGraph trajectoryFactors;
+  for(const NonlinearFactor::shared_ptr& factor: newFactors) {
+    bool touchesMap = false;
+    if(factor) {
+      for(Key key: *factor) {
+        if(mapKeys_.count(key) > 0) {
+          touchesMap = true;
+          break;
+        }
+      }
+    }
+    if(touchesMap) {
+      mapFactors_.push_back(factor);
+      ++mapFactorsSinceRefresh_;
+    } else {
+      trajectoryFactors.push_back(factor);
+    }
+  }
+
+  // Update the active tree with the trajectory-layer information only
+  ISAM2Result result = isam2_.update(trajectoryFactors, trajectoryTheta);
+
+  gttoc(update);
+
+  return result;
+}
+
+/* ************************************************************************* */
+void TwoLevelFilter::refreshMap(const Values& updatedMapValues) {
+
+  gttic(refresh_map);
+
+  // Adopt improved map linearization points, if any were provided
+  for(const Values::ConstKeyValuePair& key_value: updatedMapValues) {
+    if(mapValues_.exists(key_value.key)) {
+      mapValues_.update(key_value.key, key_value.value);
+    } else {
+      mapValues_.insert(key_value.key, key_value.value);
+    }
+  }
+
+  if(mapFactors_.size() > 0) {
+    // Collect the poses observed by the map layer; they remain after the
+    // map variables are marginalized out
+    KeySet separatorKeys = mapFactors_.keys();
+    for(Key key: mapKeys_) {
+      separatorKeys.erase(key);
+    }
+
+    // Linearize the map layer at the stored map values and the active
+    // tree's current pose linearization points
+    Values values = mapValues_;
+    for(Key key: separatorKeys) {
+      values.insert(key, isam2_.getLinearizationPoint().at(key));
+    }
+    NonlinearFactorGraph summary = internal::calculateMarginalFactors(mapFactors_, values, separatorKeys,
+        isam2_.params().getEliminationFunction());
+
+    // Force iSAM2 not to relinearize anything during the summary exchange
+    FastList<Key> noRelinKeys;
+    for(const Values::ConstKeyValuePair& key_value: isam2_.getLinearizationPoint()) {
+      noRelinKeys.push_back(key_value.key);
+    }
+
+    // Swap the new summary into the active tree, removing the previous one
+    ISAM2Result result = isam2_.update(summary, Values(), mapSummarySlots_, boost::none, noRelinKeys, boost::none, false);
+    mapSummarySlots_ = result.newFactorsIndices;
+  }
+
+  mapFactorsSinceRefresh_ = 0;
+
+  gttoc(refresh_map);
+}
+
+/* ************************************************************************* */
+} // namespace gtsam
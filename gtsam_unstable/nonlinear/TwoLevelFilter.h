@@ -0,0 +1,146 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TwoLevelFilter.h
+ * @brief   A two-level solver separating fast trajectory variables from a
+ *          slowly-changing map layer with lazily refreshed summarization.
+ * @author  Stephen Williams
+ */
+
+// \callgraph
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam_unstable/dllexport.h>
+
+namespace gtsam {
+
+/**
+ * A layered solver for problems where a small set of trajectory variables
+ * updates at high rate while a large map changes slowly.  The trajectory
+ * lives in a small active iSAM2 Bayes tree, conditioned on a frozen linear
+ * summary of the map layer (a set of LinearContainerFactors on the poses
+ * that observe map variables).  Map factors accumulate outside the active
+ * tree and only enter it when refreshMap() re-eliminates the map layer and
+ * swaps the summary, so the cost of a foreground update() is independent
+ * of the map size.
+ *
+ * Like the Concurrent Filtering and Smoothing classes, this class performs
+ * no threading itself: refreshMap() is safe to call at any update boundary,
+ * so a background thread (or any periodic scheduler) may prepare improved
+ * map values and apply them whenever the foreground is idle.
+ */
+class GTSAM_UNSTABLE_EXPORT TwoLevelFilter {
+
+public:
+
+  typedef boost::shared_ptr<TwoLevelFilter> shared_ptr;
+
+  /** Default constructor */
+  TwoLevelFilter(const ISAM2Params& parameters = ISAM2Params()) : isam2_(parameters), mapFactorsSinceRefresh_(0) {};
+
+  /** Default destructor */
+  virtual ~TwoLevelFilter() {};
+
+  /** Implement a GTSAM standard 'print' function */
+  void print(const std::string& s = "Two-Level Filter:\n", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /** Check if two Two-Level Filters are equal */
+  bool equals(const TwoLevelFilter& rhs, double tol = 1e-9) const;
+
+  /** Access the active trajectory-layer inference engine */
+  const ISAM2& getISAM2() const {
+    return isam2_;
+  }
+
+  /** Access the accumulated map-layer factors */
+  const NonlinearFactorGraph& getMapFactors() const {
+    return mapFactors_;
+  }
+
+  /** Access the map-layer linearization points */
+  const Values& getMapValues() const {
+    return mapValues_;
+  }
+
+  /** Access the set of keys assigned to the map layer */
+  const KeySet& getMapKeys() const {
+    return mapKeys_;
+  }
+
+  /** The number of map-layer factors received since the last refreshMap(),
+   * i.e. the factors whose information the active tree does not see yet.
+   * A scheduler can use this to decide when a refresh is worthwhile. */
+  size_t mapFactorsPendingRefresh() const {
+    return mapFactorsSinceRefresh_;
+  }
+
+  /** Compute the current best estimate of the trajectory variables */
+  Values calculateEstimate() const {
+    return isam2_.calculateEstimate();
+  }
+
+  /** Compute the current best estimate of a single trajectory variable */
+  template<class VALUE>
+  VALUE calculateEstimate(Key key) const {
+    return isam2_.calculateEstimate<VALUE>(key);
+  }
+
+  /**
+   * Add new factors and variables to the filter.
+   *
+   * Factors involving only trajectory variables are applied to the active
+   * tree immediately.  Factors involving at least one map variable are
+   * routed to the map layer and take effect at the next refreshMap().
+   * Trajectory variables must be connected by at least one trajectory
+   * factor, so they are always represented in the active tree.
+   *
+   * @param newFactors The new factors to be added
+   * @param newTheta Initialization points for new variables; values for
+   * map keys are stored as map-layer linearization points
+   * @param newMapKeys Keys in newTheta that belong to the map layer
+   */
+  ISAM2Result update(const NonlinearFactorGraph& newFactors = NonlinearFactorGraph(), const Values& newTheta = Values(),
+      const KeySet& newMapKeys = KeySet());
+
+  /**
+   * Re-eliminate the map layer and swap the resulting summary into the
+   * active tree, replacing the previous summary factors.  The map variables
+   * are marginalized onto the poses that observe them, at the current
+   * map-layer linearization points and the active tree's pose linearization
+   * points.
+   *
+   * @param updatedMapValues Optional improved linearization points for map
+   * variables (e.g. computed by a background optimizer over getMapFactors()
+   * and getMapValues()); provided values replace the stored ones before the
+   * summary is computed
+   */
+  void refreshMap(const Values& updatedMapValues = Values());
+
+protected:
+
+  ISAM2 isam2_; ///< The active trajectory-layer inference engine
+
+  NonlinearFactorGraph mapFactors_; ///< All factors routed to the map layer
+  Values mapValues_; ///< Linearization points of the map variables
+  KeySet mapKeys_; ///< The keys assigned to the map layer
+  FactorIndices mapSummarySlots_; ///< Slots in the active tree occupied by the current map summary
+  size_t mapFactorsSinceRefresh_; ///< Map factors received since the last refreshMap()
+
+}; // TwoLevelFilter
+
+/// traits
+template<>
+struct traits<TwoLevelFilter> : public Testable<TwoLevelFilter> {
+};
+
+} //\ namespace gtsam
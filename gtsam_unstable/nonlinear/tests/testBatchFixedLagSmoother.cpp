@@ -237,6 +237,58 @@ TEST( BatchFixedLagSmoother, Example )
   }
 }
 
+/* ************************************************************************* */
+TEST( BatchFixedLagSmoother, MetisOrdering )
+{
+  // With the METIS ordering type the window solve uses a nested dissection
+  // ordering instead of constrained COLAMD, partitioning the window into
+  // weakly coupled blocks that are eliminated independently. The estimates
+  // must be identical to a full batch solve, as in the Example test.
+
+  SharedDiagonal odometerNoise = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.1));
+
+  typedef BatchFixedLagSmoother::KeyTimestampMap Timestamps;
+  LevenbergMarquardtParams parameters;
+  parameters.orderingType = Ordering::METIS;
+  BatchFixedLagSmoother smoother(5.0, parameters);
+
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+
+  {
+    Key key0(0);
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    Timestamps newTimestamps;
+    newFactors.addPrior(key0, Point2(0.0, 0.0), odometerNoise);
+    newValues.insert(key0, Point2(0.01, 0.01));
+    newTimestamps[key0] = 0.0;
+    fullgraph.push_back(newFactors);
+    fullinit.insert(newValues);
+    smoother.update(newFactors, newValues, newTimestamps);
+    CHECK(check_smoother(fullgraph, fullinit, smoother, key0));
+  }
+
+  for(size_t i = 1; i <= 10; ++i) {
+    Key key1(i-1);
+    Key key2(i);
+
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    Timestamps newTimestamps;
+    newFactors.push_back(BetweenFactor<Point2>(key1, key2, Point2(1.0, 0.0), odometerNoise));
+    newValues.insert(key2, Point2(double(i)+0.1, -0.1));
+    newTimestamps[key2] = double(i);
+
+    fullgraph.push_back(newFactors);
+    fullinit.insert(newValues);
+
+    smoother.update(newFactors, newValues, newTimestamps);
+
+    CHECK(check_smoother(fullgraph, fullinit, smoother, key2));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam_unstable/nonlinear/ConcurrentBatchFilter.h>
+#include <gtsam_unstable/nonlinear/ConcurrentBatchSmoother.h>
 #include <gtsam/nonlinear/PriorFactor.h>
 #include <gtsam/slam/BetweenFactor.h>
 #include <gtsam/nonlinear/ISAM2.h>
@@ -1331,6 +1332,56 @@ TEST( ConcurrentBatchFilter, removeFactors_values )
 //  // Generate a non-empty smoother update, simulating synchronizing with a non-empty smoother
 //}
 
+/* ************************************************************************* */
+TEST( ConcurrentBatchFilter, concurrent_synchronizer )
+{
+  // The split-phase ConcurrentSynchronizer must reproduce the results of the
+  // serial 'synchronize' function when the two halves alternate
+  LevenbergMarquardtParams parameters;
+  ConcurrentBatchFilter expectedFilter(parameters);
+  ConcurrentBatchSmoother expectedSmoother(parameters);
+  ConcurrentBatchFilter actualFilter(parameters);
+  ConcurrentBatchSmoother actualSmoother(parameters);
+  ConcurrentSynchronizer synchronizer(actualFilter, actualSmoother);
+
+  // Nothing staged yet: the smoother half has nothing to do
+  CHECK(!synchronizer.trySynchronizeSmoother(boost::function<void()>()));
+
+  Pose3 currentPose;
+  for(Key index = 1; index <= 6; ++index) {
+    // Add an odometry step to both filters
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    if(index == 1) {
+      newFactors.addPrior(1, poseInitial, noisePrior);
+      newValues.insert(1, Pose3().compose(poseError));
+    } else {
+      newFactors.push_back(BetweenFactor<Pose3>(index - 1, index, poseOdometry, noiseOdometery));
+      currentPose = currentPose.compose(poseOdometry);
+      newValues.insert(index, currentPose.compose(poseError));
+    }
+    FastList<Key> keysToMove;
+    if(index > 3)
+      keysToMove.push_back(index - 3);
+    expectedFilter.update(newFactors, newValues, keysToMove);
+    actualFilter.update(newFactors, newValues, keysToMove);
+
+    // Serial exchange
+    synchronize(expectedFilter, expectedSmoother);
+    expectedSmoother.update();
+
+    // Split-phase exchange: filter half first, then the smoother half with
+    // the smoother update in between
+    CHECK(synchronizer.trySynchronizeFilter());
+    CHECK(!synchronizer.trySynchronizeFilter()); // buffers now owned by the smoother
+    CHECK(synchronizer.trySynchronizeSmoother([&actualSmoother](){ actualSmoother.update(); }));
+    CHECK(!synchronizer.trySynchronizeSmoother(boost::function<void()>()));
+
+    CHECK(assert_equal(expectedFilter.calculateEstimate(), actualFilter.calculateEstimate(), 1e-6));
+    CHECK(assert_equal(expectedSmoother.calculateEstimate(), actualSmoother.calculateEstimate(), 1e-6));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
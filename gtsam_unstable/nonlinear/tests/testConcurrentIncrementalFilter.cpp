@@ -706,6 +706,72 @@ TEST( ConcurrentIncrementalFilter, synchronize_2 )
   CHECK(assert_equal(expectedFilterSeparatorValues, actualFilterSeparatorValues, 1e-6));
 }
 
+/* ************************************************************************* */
+TEST( ConcurrentIncrementalFilter, synchronization_stats )
+{
+  // Create a set of optimizer parameters
+  ISAM2Params parameters;
+  parameters.relinearizeThreshold = 0;
+  parameters.relinearizeSkip = 1;
+
+  // Create a Concurrent IncrementalFilter
+  ConcurrentIncrementalFilter filter(parameters);
+  EXPECT_LONGS_EQUAL(0, filter.getSynchronizationBudget());
+  filter.setSynchronizationBudget(100);
+  EXPECT_LONGS_EQUAL(100, filter.getSynchronizationBudget());
+
+  // Two disconnected chains, marginalizing the head of each so that the
+  // separator keys end up in different cliques
+  NonlinearFactorGraph newFactors;
+  newFactors.addPrior(1, poseInitial, noisePrior);
+  newFactors.push_back(BetweenFactor<Pose3>(1, 2, poseOdometry, noiseOdometery));
+  newFactors.addPrior(11, poseInitial, noisePrior);
+  newFactors.push_back(BetweenFactor<Pose3>(11, 12, poseOdometry, noiseOdometery));
+  Values newValues;
+  newValues.insert(1, Pose3().compose(poseError));
+  newValues.insert(2, newValues.at<Pose3>(1).compose(poseOdometry).compose(poseError));
+  newValues.insert(11, Pose3().compose(poseError));
+  newValues.insert(12, newValues.at<Pose3>(11).compose(poseOdometry).compose(poseError));
+  FastList<Key> keysToMove;
+  keysToMove.push_back(1);
+  keysToMove.push_back(11);
+  filter.update(newFactors, newValues, keysToMove);
+
+  // A generous budget: the exchange is applied and instrumented
+  NonlinearFactorGraph smootherSummarization;
+  Values smootherSeparatorValues;
+  filter.presync();
+  filter.synchronize(smootherSummarization, smootherSeparatorValues);
+  filter.postsync();
+  ConcurrentIncrementalFilter::SynchronizationStats stats = filter.getSynchronizationStats();
+  EXPECT(!stats.deferred);
+  EXPECT(stats.durationSeconds >= 0.0);
+  EXPECT(stats.factorsAdded > 0); // the new summarization on the two separators
+  EXPECT(stats.cliquesAffected > 1); // the separators live in different cliques
+  const size_t factorsAdded = stats.factorsAdded;
+
+  // A budget of one clique is exceeded by the two-clique exchange: the
+  // exchange is deferred and the old summarization factors stay in place
+  filter.setSynchronizationBudget(1);
+  filter.presync();
+  filter.synchronize(smootherSummarization, smootherSeparatorValues);
+  filter.postsync();
+  stats = filter.getSynchronizationStats();
+  EXPECT(stats.deferred);
+  EXPECT_LONGS_EQUAL(0, stats.factorsAdded);
+  EXPECT_LONGS_EQUAL(0, stats.factorsRemoved);
+
+  // Removing the budget lets the next sync supersede the deferred exchange,
+  // removing exactly the factors that were installed before the deferral
+  filter.setSynchronizationBudget(0);
+  filter.presync();
+  filter.synchronize(smootherSummarization, smootherSeparatorValues);
+  filter.postsync();
+  stats = filter.getSynchronizationStats();
+  EXPECT(!stats.deferred);
+  EXPECT_LONGS_EQUAL(factorsAdded, stats.factorsRemoved);
+}
+
 /* ************************************************************************* */
 TEST( ConcurrentIncrementalFilter, synchronize_3 )
 {
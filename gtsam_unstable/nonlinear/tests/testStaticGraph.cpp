@@ -0,0 +1,135 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testStaticGraph.cpp
+ * @brief Unit tests for the compile-time fixed-topology factor graph
+ * @author Frank Dellaert
+ * @date Aug 30, 2026
+ */
+
+#include <gtsam_unstable/nonlinear/StaticGraph.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Measurement functors for a small Pose2 chain, mirroring PriorFactor and
+// BetweenFactor unwhitened errors
+struct PriorError {
+  Pose2 measured;
+  Vector3 operator()(const Pose2& x, OptionalJacobian<3, 3> H) const {
+    return traits<Pose2>::Local(measured, x, boost::none, H);
+  }
+};
+
+struct BetweenError {
+  Pose2 measured;
+  Vector3 operator()(const Pose2& p1, const Pose2& p2, OptionalJacobian<3, 3> H1,
+                     OptionalJacobian<3, 3> H2) const {
+    Pose2 hx = traits<Pose2>::Between(p1, p2, H1, H2);
+    Matrix3 Hlocal;
+    Vector3 rval = traits<Pose2>::Local(measured, hx, boost::none,
+                                        (H1 || H2) ? &Hlocal : 0);
+    if (H1) *H1 = Hlocal * (*H1);
+    if (H2) *H2 = Hlocal * (*H2);
+    return rval;
+  }
+};
+
+typedef StaticValues<Pose2, Pose2, Pose2> Chain;
+typedef StaticUnaryFactor<0, 3, PriorError> Prior0;
+typedef StaticBinaryFactor<0, 1, 3, BetweenError> Between01;
+typedef StaticBinaryFactor<1, 2, 3, BetweenError> Between12;
+typedef StaticGraph<Chain, Prior0, Between01, Between12> ChainGraph;
+
+static const Pose2 prior(0, 0, 0), odo1(2, 0, 0.1), odo2(2, 0, -0.1);
+static const Vector3 priorSigmas(0.1, 0.1, 0.05), odoSigmas(0.2, 0.2, 0.1);
+
+static ChainGraph exampleGraph() {
+  PriorError h0;
+  h0.measured = prior;
+  BetweenError h01, h12;
+  h01.measured = odo1;
+  h12.measured = odo2;
+  return ChainGraph(Prior0(h0, priorSigmas), Between01(h01, odoSigmas),
+                    Between12(h12, odoSigmas));
+}
+
+/* ************************************************************************* */
+TEST(StaticGraph, dimensions) {
+  EXPECT_LONGS_EQUAL(9, Chain::dimension);
+  EXPECT_LONGS_EQUAL(0, Chain::Offset<0>());
+  EXPECT_LONGS_EQUAL(3, Chain::Offset<1>());
+  EXPECT_LONGS_EQUAL(6, Chain::Offset<2>());
+  EXPECT_LONGS_EQUAL(3, Chain::Dim<2>());
+}
+
+/* ************************************************************************* */
+TEST(StaticGraph, errorMatchesDynamic) {
+  ChainGraph graph = exampleGraph();
+  Chain x(Pose2(0.1, -0.1, 0.05), Pose2(2.2, 0.1, 0.2), Pose2(4.1, 0.3, 0.0));
+
+  // Same graph with the dynamic machinery
+  NonlinearFactorGraph dynamicGraph;
+  dynamicGraph.emplace_shared<PriorFactor<Pose2> >(
+      0, prior, noiseModel::Diagonal::Sigmas(priorSigmas));
+  dynamicGraph.emplace_shared<BetweenFactor<Pose2> >(
+      0, 1, odo1, noiseModel::Diagonal::Sigmas(odoSigmas));
+  dynamicGraph.emplace_shared<BetweenFactor<Pose2> >(
+      1, 2, odo2, noiseModel::Diagonal::Sigmas(odoSigmas));
+  Values values;
+  values.insert(0, x.at<0>());
+  values.insert(1, x.at<1>());
+  values.insert(2, x.at<2>());
+
+  DOUBLES_EQUAL(dynamicGraph.error(values), graph.error(x), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(StaticGraph, optimizeMatchesGaussNewton) {
+  ChainGraph graph = exampleGraph();
+  Chain x(Pose2(0.1, -0.1, 0.05), Pose2(2.2, 0.1, 0.2), Pose2(4.1, 0.3, 0.0));
+  Chain solution = graph.optimize(x);
+
+  NonlinearFactorGraph dynamicGraph;
+  dynamicGraph.emplace_shared<PriorFactor<Pose2> >(
+      0, prior, noiseModel::Diagonal::Sigmas(priorSigmas));
+  dynamicGraph.emplace_shared<BetweenFactor<Pose2> >(
+      0, 1, odo1, noiseModel::Diagonal::Sigmas(odoSigmas));
+  dynamicGraph.emplace_shared<BetweenFactor<Pose2> >(
+      1, 2, odo2, noiseModel::Diagonal::Sigmas(odoSigmas));
+  Values values;
+  values.insert(0, x.at<0>());
+  values.insert(1, x.at<1>());
+  values.insert(2, x.at<2>());
+  Values expected = GaussNewtonOptimizer(dynamicGraph, values).optimize();
+
+  EXPECT(assert_equal(expected.at<Pose2>(0), solution.at<0>(), 1e-6));
+  EXPECT(assert_equal(expected.at<Pose2>(1), solution.at<1>(), 1e-6));
+  EXPECT(assert_equal(expected.at<Pose2>(2), solution.at<2>(), 1e-6));
+
+  // At the optimum, another linearization should produce a ~zero update
+  EXPECT(assert_equal(Vector(Vector9::Zero()),
+                      Vector(graph.linearizeAndSolve(solution)), 1e-6));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,170 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testTwoLevelFilter.cpp
+ * @brief   Unit tests for the Two-Level Filter
+ * @author  Stephen Williams
+ */
+
+#include <gtsam_unstable/nonlinear/TwoLevelFilter.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+
+// Set up initial pose, odometry difference, landmark offset, and initialization errors
+const Pose3 poseInitial;
+const Pose3 poseOdometry( Rot3::RzRyRx(Vector3(0.05, 0.10, -0.75)), Point3(1.0, -0.25, 0.10) );
+const Pose3 poseLandmark( Rot3::RzRyRx(Vector3(-0.02, 0.03, 0.20)), Point3(0.5, 1.50, 0.40) );
+const Pose3 poseError( Rot3::RzRyRx(Vector3(0.01, 0.02, -0.1)), Point3(0.05, -0.05, 0.02) );
+
+// Set up noise models for the factors
+const SharedDiagonal noisePrior = noiseModel::Isotropic::Sigma(6, 0.10);
+const SharedDiagonal noiseOdometery = noiseModel::Diagonal::Sigmas((Vector(6) << 0.1, 0.1, 0.1, 0.5, 0.5, 0.5).finished());
+
+}
+
+/* ************************************************************************* */
+TEST( TwoLevelFilter, update_routing )
+{
+  // Create a Two-Level Filter
+  ISAM2Params parameters;
+  parameters.relinearizeThreshold = 0;
+  parameters.relinearizeSkip = 1;
+  TwoLevelFilter filter(parameters);
+
+  // Add trajectory factors for two poses
+  NonlinearFactorGraph newFactors;
+  newFactors.addPrior(1, poseInitial, noisePrior);
+  newFactors.push_back(BetweenFactor<Pose3>(1, 2, poseOdometry, noiseOdometery));
+  Values newValues;
+  newValues.insert(1, Pose3().compose(poseError));
+  newValues.insert(2, newValues.at<Pose3>(1).compose(poseOdometry).compose(poseError));
+  filter.update(newFactors, newValues);
+  EXPECT_LONGS_EQUAL(2, filter.getISAM2().getFactorsUnsafe().size());
+  EXPECT_LONGS_EQUAL(0, filter.mapFactorsPendingRefresh());
+
+  // Add a landmark observation, declared as a map-layer variable
+  Key landmarkKey = Symbol('l', 1);
+  NonlinearFactorGraph mapFactors;
+  mapFactors.push_back(BetweenFactor<Pose3>(2, landmarkKey, poseLandmark, noiseOdometery));
+  Values mapValues;
+  mapValues.insert(landmarkKey, newValues.at<Pose3>(2).compose(poseLandmark));
+  KeySet mapKeys;
+  mapKeys.insert(landmarkKey);
+  filter.update(mapFactors, mapValues, mapKeys);
+
+  // The map factor does not enter the active tree until the next refresh
+  EXPECT_LONGS_EQUAL(2, filter.getISAM2().getFactorsUnsafe().size());
+  EXPECT_LONGS_EQUAL(1, filter.mapFactorsPendingRefresh());
+  EXPECT_LONGS_EQUAL(1, filter.getMapFactors().size());
+  EXPECT(filter.getMapValues().exists(landmarkKey));
+  EXPECT(!filter.getISAM2().getLinearizationPoint().exists(landmarkKey));
+
+  // After the refresh, the summary occupies the active tree and the
+  // pending count is reset
+  filter.refreshMap();
+  EXPECT_LONGS_EQUAL(3, filter.getISAM2().getFactorsUnsafe().size());
+  EXPECT_LONGS_EQUAL(0, filter.mapFactorsPendingRefresh());
+}
+
+/* ************************************************************************* */
+TEST( TwoLevelFilter, refresh_summary )
+{
+  // Create a Two-Level Filter
+  ISAM2Params parameters;
+  parameters.relinearizeThreshold = 0;
+  parameters.relinearizeSkip = 1;
+  TwoLevelFilter filter(parameters);
+
+  // A short trajectory, with a landmark observed from two poses, and a
+  // landmark prior that pulls the trajectory away from its odometry-only
+  // solution
+  Key landmarkKey = Symbol('l', 1);
+  NonlinearFactorGraph trajectoryFactors;
+  trajectoryFactors.addPrior(1, poseInitial, noisePrior);
+  trajectoryFactors.push_back(BetweenFactor<Pose3>(1, 2, poseOdometry, noiseOdometery));
+  trajectoryFactors.push_back(BetweenFactor<Pose3>(2, 3, poseOdometry, noiseOdometery));
+  NonlinearFactorGraph mapFactors;
+  mapFactors.push_back(BetweenFactor<Pose3>(2, landmarkKey, poseLandmark, noiseOdometery));
+  mapFactors.push_back(BetweenFactor<Pose3>(3, landmarkKey, poseOdometry.inverse().compose(poseLandmark), noiseOdometery));
+  mapFactors.addPrior(landmarkKey, poseInitial.compose(poseOdometry).compose(poseLandmark).compose(poseError), noisePrior);
+
+  Values values;
+  values.insert(1, Pose3().compose(poseError));
+  values.insert(2, values.at<Pose3>(1).compose(poseOdometry).compose(poseError));
+  values.insert(3, values.at<Pose3>(2).compose(poseOdometry).compose(poseError));
+  Values landmarkValues;
+  landmarkValues.insert(landmarkKey, values.at<Pose3>(2).compose(poseLandmark));
+
+  KeySet mapKeys;
+  mapKeys.insert(landmarkKey);
+  filter.update(trajectoryFactors, values);
+  filter.update(mapFactors, landmarkValues, mapKeys);
+
+  // Before any refresh, the trajectory estimate ignores the map layer
+  // (the second, map-only update still relinearizes the active tree, so
+  // the reference filter gets a matching empty update)
+  TwoLevelFilter trajectoryOnly(parameters);
+  trajectoryOnly.update(trajectoryFactors, values);
+  trajectoryOnly.update();
+  EXPECT(assert_equal(trajectoryOnly.calculateEstimate<Pose3>(2), filter.calculateEstimate<Pose3>(2), 1e-9));
+
+  // Refresh twice so the summary is relinearized at the updated trajectory;
+  // the summary exchange itself never relinearizes, so a plain update()
+  // between refreshes lets the active tree relinearize its own factors
+  filter.refreshMap();
+  filter.update();
+  filter.refreshMap();
+  filter.update();
+
+  // The layered estimate matches a full batch solution over all factors
+  NonlinearFactorGraph fullGraph;
+  fullGraph.push_back(trajectoryFactors);
+  fullGraph.push_back(mapFactors);
+  Values fullValues = values;
+  fullValues.insert(landmarkValues);
+  Values batchResult = LevenbergMarquardtOptimizer(fullGraph, fullValues).optimize();
+  EXPECT(assert_equal(batchResult.at<Pose3>(1), filter.calculateEstimate<Pose3>(1), 1e-2));
+  EXPECT(assert_equal(batchResult.at<Pose3>(2), filter.calculateEstimate<Pose3>(2), 1e-2));
+  EXPECT(assert_equal(batchResult.at<Pose3>(3), filter.calculateEstimate<Pose3>(3), 1e-2));
+
+  // A background optimizer can supply improved map linearization points;
+  // once those are adopted the layered estimate converges to the batch one
+  Values updatedMapValues;
+  updatedMapValues.insert(landmarkKey, batchResult.at<Pose3>(landmarkKey));
+  filter.refreshMap(updatedMapValues);
+  filter.update();
+  filter.refreshMap();
+  filter.update();
+  EXPECT(assert_equal(batchResult.at<Pose3>(landmarkKey), filter.getMapValues().at<Pose3>(landmarkKey), 1e-9));
+  EXPECT(assert_equal(batchResult.at<Pose3>(1), filter.calculateEstimate<Pose3>(1), 1e-4));
+  EXPECT(assert_equal(batchResult.at<Pose3>(2), filter.calculateEstimate<Pose3>(2), 1e-4));
+  EXPECT(assert_equal(batchResult.at<Pose3>(3), filter.calculateEstimate<Pose3>(3), 1e-4));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
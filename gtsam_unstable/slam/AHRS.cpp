@@ -106,6 +106,87 @@ std::pair<Mechanization_bRn2, KalmanFilter::State> AHRS::initialize(double g_e)
   return std::make_pair(mech0_, state);
 }
 
+/* ************************************************************************* */
+std::pair<Mechanization_bRn2, AHRS::FixedState> AHRS::initializeFixed(double g_e) {
+  std::pair<Mechanization_bRn2, KalmanFilter::State> initial = initialize(g_e);
+  FixedState fixed;
+  fixed.dx = initial.second->mean();
+  fixed.P = initial.second->covariance();
+  return std::make_pair(initial.first, fixed);
+}
+
+/* ************************************************************************* */
+std::pair<Mechanization_bRn2, AHRS::FixedState> AHRS::integrateFixed(
+    const Mechanization_bRn2& mech, const FixedState& state,
+    const Vector3& u, double dt) const {
+
+  // Integrate full state
+  Mechanization_bRn2 newMech = mech.integrate(u, dt);
+
+  // Integrate error state Kalman filter, same model as integrate() but with
+  // the process noise Q_k = G_k * var_w_ * G_k' multiplied out per block so
+  // only fixed-size quantities appear and nothing is heap allocated
+  const Matrix3 bRn = mech.bRn().matrix();
+
+  Matrix9 Psi_k = I_9x9;  // transition matrix I + dt*F_k
+  Psi_k.block<3, 3>(0, 3) = -dt * bRn;
+  Psi_k.block<3, 3>(3, 3) += dt * F_g_;
+  Psi_k.block<3, 3>(6, 6) += dt * F_a_;
+
+  // G_k routes var_omega_w and the gyro measurement noise through -bRn into
+  // the attitude block, and the bias noises straight into their blocks
+  const Vector3 var_rho = var_w_.segment<3>(0) + var_w_.segment<3>(6);
+  Matrix9 Q_k = Matrix9::Zero();
+  Q_k.block<3, 3>(0, 0) = bRn * var_rho.asDiagonal() * bRn.transpose();
+  Q_k.block<3, 3>(3, 3) = var_w_.segment<3>(3).asDiagonal();
+  Q_k.block<3, 3>(6, 6) = var_w_.segment<3>(9).asDiagonal();
+
+  FixedState newState;
+  newState.dx = Psi_k * state.dx;
+  newState.P = Psi_k * state.P * Psi_k.transpose() + dt * Q_k;
+  return make_pair(newMech, newState);
+}
+
+/* ************************************************************************* */
+std::pair<Mechanization_bRn2, AHRS::FixedState> AHRS::aidFixed(
+    const Mechanization_bRn2& mech, const FixedState& state,
+    const Vector3& f, bool Farrell) const {
+
+  const Matrix3 bRn = mech.bRn().matrix();
+
+  // get gravity in body from accelerometer
+  const Vector3 measured_b_g = mech.x_a() - f;
+
+  // Same measurement models as aid(), assembled in fixed-size blocks
+  Matrix39 H;
+  Vector3 z;
+  Matrix3 R;
+  if (Farrell) {
+    z = n_g_ - bRn.transpose() * measured_b_g;
+    H << n_g_cross_, Z_3x3, bRn;
+    R = bRn.transpose() * ((Vector3) sigmas_v_a_.array().square()).asDiagonal() * bRn;
+  } else {
+    z = bRn * n_g_ - measured_b_g;
+    H << bRn * n_g_cross_, Z_3x3, I_3x3;
+    R = ((Vector3) sigmas_v_a_.array().square()).asDiagonal();
+  }
+
+  // Textbook Kalman update; the innovation covariance S is only 3*3 so the
+  // inverse is a fixed-size Eigen kernel, no elimination and no heap
+  const Matrix3 S = H * state.P * H.transpose() + R;
+  const Matrix93 K = state.P * H.transpose() * S.inverse();
+  const Vector9 dx = state.dx + K * (z - H * state.dx);
+
+  // update full state (rotation and accelerometer bias)
+  Mechanization_bRn2 newMech = mech.correct(dx);
+
+  // reset error state, keep covariance, as in aid()
+  FixedState newState;
+  newState.dx = Z_9x1;
+  newState.P = (I_9x9 - K * H) * state.P;
+  return make_pair(newMech, newState);
+}
+
 /* ************************************************************************* */
 std::pair<Mechanization_bRn2, KalmanFilter::State> AHRS::integrate(
     const Mechanization_bRn2& mech, KalmanFilter::State state,
@@ -165,12 +246,16 @@ std::pair<Mechanization_bRn2, KalmanFilter::State> AHRS::aid(
   // get gravity in body from accelerometer
   Vector measured_b_g = mech.x_a() - f;
 
+  // collect is varargs, so only dynamic Matrix objects may be passed to it
+  Matrix Z3 = Z_3x3, I3 = I_3x3;
+
   Matrix R, H;
   Vector z;
   if (Farrell) {
     // calculate residual gravity measurement
     z = n_g_ - trans(bRn) * measured_b_g;
-    H = collect(3, &n_g_cross_, &Z_3x3, &bRn);
+    Matrix n_g_cross = n_g_cross_;
+    H = collect(3, &n_g_cross, &Z3, &bRn);
     R = trans(bRn) * ((Vector3) sigmas_v_a_.array().square()).asDiagonal() * bRn;
   } else {
     // my measurement prediction (in body frame):
@@ -184,7 +269,7 @@ std::pair<Mechanization_bRn2, KalmanFilter::State> AHRS::aid(
     z = bRn * n_g_ - measured_b_g;
     // Now the Jacobian H
     Matrix b_g = bRn * n_g_cross_;
-    H = collect(3, &b_g, &Z_3x3, &I_3x3);
+    H = collect(3, &b_g, &Z3, &I3);
     // And the measurement noise, TODO: should be created once where sigmas_v_a is given
     R = ((Vector3) sigmas_v_a_.array().square()).asDiagonal();
   }
@@ -214,7 +299,9 @@ std::pair<Mechanization_bRn2, KalmanFilter::State> AHRS::aidGeneral(
   Vector z = f - increment * f_previous;
   //Vector z = increment * f_previous - f;
   Matrix b_g = skewSymmetric(increment* f_previous);
-  Matrix H = collect(3, &b_g, &I_3x3, &Z_3x3);
+  // collect is varargs, so only dynamic Matrix objects may be passed to it
+  Matrix Z3 = Z_3x3, I3 = I_3x3;
+  Matrix H = collect(3, &b_g, &I3, &Z3);
 //  Matrix R = diag(emul(sigmas_v_a_, sigmas_v_a_));
 //  Matrix R = diag(Vector3(1.0, 0.2, 1.0)); // good for L_twice
   Matrix R = Vector3(0.01, 0.0001, 0.01).asDiagonal();
@@ -49,12 +49,36 @@ public:
    */
   AHRS(const Matrix& stationaryU, const Matrix& stationaryF, double g_e, bool flat=false);
 
+  /**
+   * Fixed-size error-state filter state, a drop-in alternative to
+   * KalmanFilter::State for the high-rate loop: everything lives on the
+   * stack, so integrateFixed/aidFixed do no heap allocation per sample.
+   */
+  struct FixedState {
+    Vector9 dx;  ///< error state mean
+    Matrix9 P;   ///< error state covariance
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
   std::pair<Mechanization_bRn2, KalmanFilter::State> initialize(double g_e);
 
+  /// initialize, but returning the fixed-size filter state for the fast loop
+  std::pair<Mechanization_bRn2, FixedState> initializeFixed(double g_e);
+
   std::pair<Mechanization_bRn2, KalmanFilter::State> integrate(
       const Mechanization_bRn2& mech, KalmanFilter::State state,
       const Vector& u, double dt);
 
+  /**
+   * Fixed-size version of integrate: same error-state propagation, but with
+   * the covariance update written out in Matrix3/Matrix9 blocks instead of
+   * going through KalmanFilter's factor graph machinery, so a 1 kHz loop
+   * touches no heap.
+   */
+  std::pair<Mechanization_bRn2, FixedState> integrateFixed(
+      const Mechanization_bRn2& mech, const FixedState& state,
+      const Vector3& u, double dt) const;
+
   bool isAidingAvailable(const Mechanization_bRn2& mech,
       const Vector& f, const Vector& u, double ge) const;
 
@@ -69,6 +93,15 @@ public:
       const Mechanization_bRn2& mech, KalmanFilter::State state,
       const Vector& f, bool Farrell=0) const;
 
+  /**
+   * Fixed-size version of aid: the 3-dimensional measurement update is done
+   * with the textbook Kalman gain (S is only 3*3) entirely in stack types,
+   * and the error state is reset to zero just like the dynamic version.
+   */
+  std::pair<Mechanization_bRn2, FixedState> aidFixed(
+      const Mechanization_bRn2& mech, const FixedState& state,
+      const Vector3& f, bool Farrell=false) const;
+
   std::pair<Mechanization_bRn2, KalmanFilter::State> aidGeneral(
       const Mechanization_bRn2& mech, KalmanFilter::State state,
       const Vector& f, const Vector& f_expected, const Rot3& R_previous) const;
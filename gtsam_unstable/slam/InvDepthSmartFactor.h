@@ -0,0 +1,284 @@
+
+/**
+ * @file InvDepthSmartFactor.h
+ * @brief Smart inverse depth factor based on the parameterization of
+ * InvDepthFactorVariant3. A landmark is represented by a fixed bearing
+ * (theta,phi) in the anchor frame plus a single inverse depth rho. The
+ * factor involves only the camera poses: rho is kept internally and
+ * eliminated analytically during linearization. Because the landmark
+ * block is 1x1, the Schur complement only requires a scalar inversion,
+ * so inverse depth bundle adjustment avoids the 3x3 point elimination
+ * (and the generic elimination machinery) used by 3D-point factors.
+ * @author Chris Beall, Stephen Williams
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Point2.h>
+
+namespace gtsam {
+
+/**
+ * Smart factor over the anchor pose and any number of observing poses,
+ * representing all visual measurements of one inverse depth landmark
+ */
+class InvDepthSmartFactor: public NonlinearFactor {
+protected:
+
+  Point2Vector measured_;              ///< 2D measurements, one per observing camera
+  std::vector<size_t> cameraIndices_;  ///< index into keys() of the pose observing each measurement
+  double theta_;                       ///< azimuth of the landmark bearing in the anchor frame
+  double phi_;                         ///< elevation of the landmark bearing in the anchor frame
+  mutable double rho_;                 ///< current inverse depth estimate, refined during linearization
+  Cal3_S2::shared_ptr K_;              ///< shared pointer to calibration object
+  SharedIsotropic noiseModel_;         ///< isotropic measurement noise, shared by all measurements
+
+public:
+
+  /// shorthand for base class type
+  typedef NonlinearFactor Base;
+
+  /// shorthand for this class
+  typedef InvDepthSmartFactor This;
+
+  /// shorthand for a smart pointer to a factor
+  typedef boost::shared_ptr<This> shared_ptr;
+
+  /// Default constructor for I/O only
+  InvDepthSmartFactor() :
+      theta_(0.0), phi_(0.0), rho_(1.0), K_(new Cal3_S2(444, 555, 666, 777, 888)) {
+  }
+
+  /**
+   * Constructor
+   * @param anchorKey is the index of the pose the landmark bearing is anchored to
+   * @param theta is the azimuth of the landmark bearing in the anchor frame
+   * @param phi is the elevation of the landmark bearing in the anchor frame
+   * @param invDepth is the initial inverse depth along the bearing
+   * @param K shared pointer to the constant calibration
+   * @param model the isotropic 2D measurement noise, shared by all measurements
+   */
+  InvDepthSmartFactor(const Key anchorKey, double theta, double phi, double invDepth,
+      const Cal3_S2::shared_ptr& K, const SharedNoiseModel& model) :
+        theta_(theta), phi_(phi), rho_(invDepth), K_(K) {
+    keys_.push_back(anchorKey);
+    noiseModel_ = boost::dynamic_pointer_cast<noiseModel::Isotropic>(model);
+    if(!noiseModel_ || noiseModel_->dim() != 2)
+      throw std::invalid_argument("InvDepthSmartFactor: requires an isotropic 2D noise model");
+  }
+
+  /** Virtual destructor */
+  virtual ~InvDepthSmartFactor() {}
+
+  /**
+   * Add a measurement of the landmark from the camera at 'poseKey'.
+   * The anchor pose itself may observe the landmark as well.
+   * @param measured is the 2 dimensional location of point in image (the measurement)
+   * @param poseKey is the index of the observing camera pose
+   */
+  void add(const Point2& measured, const Key poseKey) {
+    size_t index = 0;
+    while(index < keys_.size() && keys_[index] != poseKey) {
+      ++index;
+    }
+    if(index == keys_.size()) {
+      keys_.push_back(poseKey);
+    }
+    measured_.push_back(measured);
+    cameraIndices_.push_back(index);
+  }
+
+  /**
+   * print
+   * @param s optional string naming the factor
+   * @param keyFormatter optional formatter useful for printing Symbols
+   */
+  virtual void print(const std::string& s = "InvDepthSmartFactor",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const {
+    Base::print(s, keyFormatter);
+    std::cout << "  bearing: (" << theta_ << ", " << phi_ << "), inverse depth: " << rho_ << std::endl;
+    for(size_t k = 0; k < measured_.size(); ++k) {
+      traits<Point2>::Print(measured_[k], s + ".z");
+    }
+  }
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& p, double tol = 1e-9) const {
+    const This *e = dynamic_cast<const This*>(&p);
+    if(!e || !Base::equals(p, tol) || measured_.size() != e->measured_.size())
+      return false;
+    for(size_t k = 0; k < measured_.size(); ++k) {
+      if(!traits<Point2>::Equals(measured_[k], e->measured_[k], tol)
+          || cameraIndices_[k] != e->cameraIndices_[k])
+        return false;
+    }
+    return std::fabs(theta_ - e->theta_) < tol
+        && std::fabs(phi_ - e->phi_) < tol
+        && this->K_->equals(*e->K_, tol);
+  }
+
+  /** Total unwhitened error dimension: two rows per measurement */
+  virtual size_t dim() const {
+    return 2 * measured_.size();
+  }
+
+  /** Calculate the error of the factor, after refining the internal inverse depth */
+  virtual double error(const Values& x) const {
+    if(measured_.empty())
+      return 0.0;
+    refineInvDepth(x);
+    Vector b;
+    linearizeMeasurements(x, rho_, NULL, NULL, &b);
+    return 0.5 * b.squaredNorm();
+  }
+
+  /**
+   * Linearize all measurements in one batch around the anchor, then
+   * eliminate the single inverse depth with a scalar Schur complement,
+   * producing a HessianFactor over just the camera poses.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    const size_t n = keys_.size();
+    refineInvDepth(x);
+    Matrix F;
+    Vector e, b;
+    linearizeMeasurements(x, rho_, &F, &e, &b);
+
+    // Augmented Hessian on the poses: [F b]'[F b], minus the rank-1 Schur
+    // correction for the eliminated inverse depth. The landmark "matrix"
+    // e'e is a scalar, so its inversion is a single division.
+    Matrix M(F.rows(), 6 * n + 1);
+    M << F, b;
+    Matrix augmented = M.transpose() * M;
+    const double d = e.squaredNorm();
+    if(d > 1e-9) {
+      const Vector v = M.transpose() * e;
+      augmented -= v * v.transpose() / d;
+    }
+
+    const std::vector<DenseIndex> dims(n, 6);
+    return boost::make_shared<HessianFactor>(keys_,
+        SymmetricBlockMatrix(dims, augmented, true));
+  }
+
+  /** The unit bearing of the landmark in the anchor frame */
+  Point3 anchorRay() const {
+    return Point3(std::cos(phi_) * std::sin(theta_), std::sin(phi_),
+        std::cos(phi_) * std::cos(theta_));
+  }
+
+  /** The current inverse depth estimate along the anchor bearing */
+  double invDepth() const {
+    return rho_;
+  }
+
+  /** The landmark in world coordinates, for visualization or initialization */
+  Point3 point(const Values& x) const {
+    return x.at<Pose3>(keys_[0]).transformFrom(anchorRay() / rho_);
+  }
+
+  /** return the number of measurements */
+  size_t nrMeasurements() const {
+    return measured_.size();
+  }
+
+  /** return the calibration object */
+  const Cal3_S2::shared_ptr calibration() const {
+    return K_;
+  }
+
+private:
+
+  /**
+   * Compute the whitened Jacobians and residuals of all measurements at
+   * inverse depth 'rho'. F (2m x 6n) holds the pose Jacobians in key order,
+   * e (2m) the inverse depth Jacobian, and b (2m) the residual z - h(x).
+   * Any of F and e may be NULL when not needed. Measurements for which the
+   * landmark is behind the camera contribute zero rows.
+   */
+  void linearizeMeasurements(const Values& x, double rho, Matrix* F, Vector* e, Vector* b) const {
+    const size_t m = measured_.size();
+    const size_t n = keys_.size();
+    if(F)
+      *F = Matrix::Zero(2 * m, 6 * n);
+    if(e)
+      *e = Vector::Zero(2 * m);
+    *b = Vector::Zero(2 * m);
+
+    // The world landmark and its anchor derivatives are shared by all measurements
+    const Pose3 anchor = x.at<Pose3>(keys_[0]);
+    const Point3 ray = anchorRay();
+    Matrix36 Ha;
+    Matrix33 Hp;
+    const Point3 world_P_landmark = anchor.transformFrom(ray / rho, Ha, Hp);
+    const Point3 Hrho = Hp * (-ray / (rho * rho));
+
+    for(size_t k = 0; k < m; ++k) {
+      const size_t j = cameraIndices_[k];
+      PinholeCamera<Cal3_S2> camera(x.at<Pose3>(keys_[j]), *K_);
+      try {
+        Matrix26 Dpose;
+        Matrix23 Dpoint;
+        const Point2 reprojection = camera.project(world_P_landmark, Dpose, Dpoint);
+        b->segment<2>(2 * k) = measured_[k] - reprojection;
+        if(F) {
+          F->block<2, 6>(2 * k, 6 * j) += Dpose;
+          F->block<2, 6>(2 * k, 0) += Dpoint * Ha;
+        }
+        if(e)
+          e->segment<2>(2 * k) = Dpoint * Hrho;
+      } catch( CheiralityException& ) {
+        // leave the rows zero, so this measurement has no influence
+      }
+    }
+
+    const double invSigma = 1.0 / noiseModel_->sigma();
+    if(F)
+      *F *= invSigma;
+    if(e)
+      *e *= invSigma;
+    *b *= invSigma;
+  }
+
+  /**
+   * Refine the internal inverse depth estimate by Gauss-Newton on rho
+   * alone, holding the poses fixed. This is the scalar analogue of the
+   * triangulation step in the 3D-point smart factors.
+   */
+  void refineInvDepth(const Values& x) const {
+    Vector e, b;
+    for(size_t iteration = 0; iteration < 5; ++iteration) {
+      linearizeMeasurements(x, rho_, NULL, &e, &b);
+      const double d = e.squaredNorm();
+      if(d < 1e-12)
+        break;
+      const double delta = e.dot(b) / d;
+      rho_ += delta;
+      if(rho_ < 1e-6)
+        rho_ = 1e-6; // keep the landmark in front of the anchor
+      if(std::fabs(delta) < 1e-10)
+        break;
+    }
+  }
+
+  /// Serialization function
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
+    ar & BOOST_SERIALIZATION_NVP(measured_);
+    ar & BOOST_SERIALIZATION_NVP(cameraIndices_);
+    ar & BOOST_SERIALIZATION_NVP(theta_);
+    ar & BOOST_SERIALIZATION_NVP(phi_);
+    ar & BOOST_SERIALIZATION_NVP(rho_);
+    ar & BOOST_SERIALIZATION_NVP(K_);
+    ar & BOOST_SERIALIZATION_NVP(noiseModel_);
+  }
+};
+
+} // \ namespace gtsam
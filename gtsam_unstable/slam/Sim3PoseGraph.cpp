@@ -0,0 +1,212 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Sim3PoseGraph.cpp
+ * @brief  Scale-drift-aware pose graph optimization over Similarity3
+ * @author Frank Dellaert
+ */
+
+#include <gtsam_unstable/slam/Sim3PoseGraph.h>
+
+#include <gtsam/linear/BinaryJacobianFactor.h>
+#include <gtsam/base/timing.h>
+
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void BetweenFactorSim3::print(const std::string& s,
+    const KeyFormatter& keyFormatter) const {
+  std::cout << s << "BetweenFactorSim3(" << keyFormatter(this->key1()) << ","
+      << keyFormatter(this->key2()) << ")\n";
+  measured_.print("  measured: ");
+  this->noiseModel_->print("  noise model: ");
+}
+
+/* ************************************************************************* */
+bool BetweenFactorSim3::equals(const NonlinearFactor& expected,
+    double tol) const {
+  const This *e = dynamic_cast<const This*>(&expected);
+  return e != nullptr && Base::equals(*e, tol)
+      && this->measured_.equals(e->measured_, tol);
+}
+
+/* ************************************************************************* */
+Vector7 BetweenFactorSim3::errorFixed(const Similarity3& measured,
+    const Similarity3& p1, const Similarity3& p2, Matrix7* H1, Matrix7* H2) {
+  Matrix7 Hb1, Hb2;
+  const Similarity3 hx = p1.between(p2, Hb1, Hb2);
+  // First-order approximation of the local-coordinates derivative, exactly
+  // as in the generic BetweenFactor (Similarity3::Logmap has no analytic
+  // derivative)
+  if (H1)
+    *H1 = Hb1;
+  if (H2)
+    *H2 = Hb2;
+  return measured.localCoordinates(hx);
+}
+
+/* ************************************************************************* */
+Vector BetweenFactorSim3::evaluateError(const Similarity3& p1,
+    const Similarity3& p2, boost::optional<Matrix&> H1,
+    boost::optional<Matrix&> H2) const {
+  Matrix7 D1, D2;
+  const Vector7 error = errorFixed(measured_, p1, p2, H1 ? &D1 : nullptr,
+      H2 ? &D2 : nullptr);
+  if (H1)
+    *H1 = D1;
+  if (H2)
+    *H2 = D2;
+  return error;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianFactor> BetweenFactorSim3::linearize(
+    const Values& x) const {
+  gttic(BetweenFactorSim3_linearize);
+  // Only linearize if the factor is active
+  if (!this->active(x))
+    return boost::shared_ptr<JacobianFactor>();
+
+  const Key key1 = this->key1(), key2 = this->key2();
+  Matrix7 H1, H2;
+  Vector7 b = -errorFixed(measured_, x.at<Similarity3>(key1),
+      x.at<Similarity3>(key2), &H1, &H2);
+
+  // Whiten the system if needed
+  const SharedNoiseModel& noiseModel = this->noiseModel();
+  if (noiseModel && !noiseModel->isUnit()) {
+    H1 = noiseModel->Whiten(H1);
+    H2 = noiseModel->Whiten(H2);
+    b = noiseModel->whiten(b);
+  }
+
+  // Create new (unit) noiseModel, preserving constraints if applicable
+  SharedDiagonal model;
+  if (noiseModel && noiseModel->isConstrained()) {
+    model = boost::static_pointer_cast<noiseModel::Constrained>(noiseModel)->unit();
+  }
+
+  return boost::make_shared<BinaryJacobianFactor<7, 7, 7> >(key1, H1, key2, H2,
+      b, model);
+}
+
+/* ************************************************************************* */
+std::pair<NonlinearFactorGraph::shared_ptr, Values::shared_ptr> readG2oSim3(
+    const std::string& filename) {
+  ifstream is(filename.c_str());
+  if (!is)
+    throw invalid_argument("readG2oSim3: can not find file " + filename);
+
+  NonlinearFactorGraph::shared_ptr graph(new NonlinearFactorGraph);
+  Values::shared_ptr initial(new Values);
+
+  string line;
+  while (getline(is, line)) {
+    istringstream ls(line);
+    string tag;
+    ls >> tag;
+
+    if (tag == "VERTEX_SIM3:QUAT") {
+      Key id;
+      double x, y, z, qx, qy, qz, qw, s;
+      ls >> id >> x >> y >> z >> qx >> qy >> qz >> qw >> s;
+      initial->insert(id,
+          Similarity3(Rot3::Quaternion(qw, qx, qy, qz), Point3(x, y, z), s));
+    }
+
+    if (tag == "EDGE_SIM3:QUAT") {
+      Key id1, id2;
+      double x, y, z, qx, qy, qz, qw, s;
+      ls >> id1 >> id2 >> x >> y >> z >> qx >> qy >> qz >> qw >> s;
+      Matrix m(7, 7);
+      for (size_t i = 0; i < 7; i++) {
+        for (size_t j = i; j < 7; j++) {
+          double mij;
+          ls >> mij;
+          m(i, j) = mij;
+          m(j, i) = mij;
+        }
+      }
+
+      // Permute from the g2o tangent ordering [translation, rotation, scale]
+      // to the gtsam ordering [rotation, translation, scale]
+      Matrix mgtsam(7, 7);
+      mgtsam.block<3, 3>(0, 0) = m.block<3, 3>(3, 3); // info rotation
+      mgtsam.block<3, 3>(3, 3) = m.block<3, 3>(0, 0); // info translation
+      mgtsam.block<3, 3>(0, 3) = m.block<3, 3>(3, 0); // off diagonal
+      mgtsam.block<3, 3>(3, 0) = m.block<3, 3>(0, 3); // off diagonal
+      mgtsam.block<3, 1>(0, 6) = m.block<3, 1>(3, 6); // rotation-scale
+      mgtsam.block<3, 1>(3, 6) = m.block<3, 1>(0, 6); // translation-scale
+      mgtsam.block<1, 3>(6, 0) = m.block<1, 3>(6, 3);
+      mgtsam.block<1, 3>(6, 3) = m.block<1, 3>(6, 0);
+      mgtsam(6, 6) = m(6, 6);
+
+      SharedNoiseModel model = noiseModel::Gaussian::Information(mgtsam);
+      graph->emplace_shared<BetweenFactorSim3>(id1, id2,
+          Similarity3(Rot3::Quaternion(qw, qx, qy, qz), Point3(x, y, z), s),
+          model);
+    }
+  }
+  return make_pair(graph, initial);
+}
+
+/* ************************************************************************* */
+Values initializeSim3(const NonlinearFactorGraph& graph) {
+  gttic(initializeSim3);
+  // Collect the Sim3 between measurements as an adjacency structure
+  typedef pair<Key, const BetweenFactorSim3*> Edge;
+  FastMap<Key, FastVector<Edge> > adjacency;
+  for (const NonlinearFactor::shared_ptr& factor : graph) {
+    const BetweenFactorSim3* between =
+        dynamic_cast<const BetweenFactorSim3*>(factor.get());
+    if (!between)
+      continue;
+    adjacency[between->key1()].push_back(make_pair(between->key2(), between));
+    adjacency[between->key2()].push_back(make_pair(between->key1(), between));
+  }
+
+  // Compose measurements along a breadth-first spanning tree, each
+  // connected component rooted at its smallest key with the identity
+  Values initial;
+  for (const auto& key_edges : adjacency) {
+    if (initial.exists(key_edges.first))
+      continue;
+    initial.insert(key_edges.first, Similarity3::identity());
+    deque<Key> queue(1, key_edges.first);
+    while (!queue.empty()) {
+      const Key parent = queue.front();
+      queue.pop_front();
+      const Similarity3 wTp = initial.at<Similarity3>(parent);
+      for (const Edge& edge : adjacency.at(parent)) {
+        if (initial.exists(edge.first))
+          continue;
+        const BetweenFactorSim3& f = *edge.second;
+        const Similarity3 wTc = (f.key1() == parent) ?
+            wTp * f.measured() : wTp * f.measured().inverse();
+        initial.insert(edge.first, wTc);
+        queue.push_back(edge.first);
+      }
+    }
+  }
+  return initial;
+}
+
+/* ************************************************************************* */
+
+} // namespace gtsam
@@ -0,0 +1,135 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Sim3PoseGraph.h
+ * @brief  Scale-drift-aware pose graph optimization over Similarity3
+ * @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam_unstable/geometry/Similarity3.h>
+#include <gtsam_unstable/dllexport.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <string>
+#include <utility>
+
+namespace gtsam {
+
+/**
+ * Between factor on Similarity3 with a fixed-size linearize fast path, for
+ * scale-drift-aware monocular pose graph optimization.  The error and both
+ * Jacobians are computed with 7x7 fixed-size matrices, and linearize()
+ * builds a BinaryJacobianFactor<7,7,7> directly, avoiding the dynamic-size
+ * temporaries of the generic BetweenFactor<Similarity3> path.
+ */
+class GTSAM_UNSTABLE_EXPORT BetweenFactorSim3: public NoiseModelFactor2<
+    Similarity3, Similarity3> {
+
+public:
+
+  typedef BetweenFactorSim3 This;
+  typedef NoiseModelFactor2<Similarity3, Similarity3> Base;
+  typedef boost::shared_ptr<This> shared_ptr;
+
+private:
+
+  Similarity3 measured_; ///< The measured similarity transform
+
+public:
+
+  /** default constructor - only use for serialization */
+  BetweenFactorSim3() {}
+
+  /** Constructor */
+  BetweenFactorSim3(Key key1, Key key2, const Similarity3& measured,
+      const SharedNoiseModel& model) :
+      Base(model, key1, key2), measured_(measured) {
+  }
+
+  virtual ~BetweenFactorSim3() {}
+
+  /// @return a deep copy of this factor
+  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /** implement functions needed for Testable */
+
+  /** print */
+  virtual void print(const std::string& s = "",
+      const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /** equals */
+  virtual bool equals(const NonlinearFactor& expected, double tol = 1e-9) const;
+
+  /** implement functions needed to derive from Factor */
+
+  /** vector of errors */
+  Vector evaluateError(const Similarity3& p1, const Similarity3& p2,
+      boost::optional<Matrix&> H1 = boost::none, //
+      boost::optional<Matrix&> H2 = boost::none) const;
+
+  /// Linearize using fixed-size matrices, into a BinaryJacobianFactor
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
+
+  /** return the measured */
+  const Similarity3& measured() const {
+    return measured_;
+  }
+
+private:
+
+  /// Fixed-size error computation shared by evaluateError and linearize
+  static Vector7 errorFixed(const Similarity3& measured, const Similarity3& p1,
+      const Similarity3& p2, Matrix7* H1, Matrix7* H2);
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template<class ARCHIVE>
+  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+    ar & boost::serialization::make_nvp("NoiseModelFactor2",
+        boost::serialization::base_object<Base>(*this));
+    ar & BOOST_SERIALIZATION_NVP(measured_);
+  }
+};
+
+/// traits
+template<>
+struct traits<BetweenFactorSim3> : public Testable<BetweenFactorSim3> {};
+
+/**
+ * Load a Sim3 pose graph from a g2o file with VERTEX_SIM3:QUAT and
+ * EDGE_SIM3:QUAT lines, as written by scale-drift-aware monocular SLAM
+ * systems.  The g2o tangent ordering [translation, rotation, scale] of the
+ * edge information matrices is permuted to the gtsam ordering
+ * [rotation, translation, scale].
+ * @param filename The g2o file to load
+ * @return the graph of BetweenFactorSim3 and the vertex initial estimates
+ */
+GTSAM_UNSTABLE_EXPORT std::pair<NonlinearFactorGraph::shared_ptr,
+    Values::shared_ptr> readG2oSim3(const std::string& filename);
+
+/**
+ * Compute an initial estimate for a Sim3 pose graph by composing the
+ * measured transforms along a breadth-first spanning tree, rooted at the
+ * smallest key with the identity.  Unlike starting from all-identity this
+ * puts every pose (and its accumulated scale drift) within the basin of
+ * convergence of the loop closures for typical monocular sequences.
+ */
+GTSAM_UNSTABLE_EXPORT Values initializeSim3(const NonlinearFactorGraph& graph);
+
+} // namespace gtsam
@@ -0,0 +1,117 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  TOAEventLocalizer.cpp
+ *  @brief Batch localization of many events from TOA measurements
+ *  @author Frank Dellaert
+ */
+
+#include <gtsam_unstable/slam/TOAEventLocalizer.h>
+
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+TOAEventLocalizer::TOAEventLocalizer(const std::vector<Point3>& anchors,
+    double speed, const SharedIsotropic& model) :
+    anchors_(anchors), speed_(speed), sigma_(1.0) {
+  if (model) {
+    if (model->dim() != 1)
+      throw invalid_argument(
+          "TOAEventLocalizer: measurement noise model must be 1-dimensional");
+    sigma_ = model->sigma();
+  }
+}
+
+/* ************************************************************************* */
+Event TOAEventLocalizer::localizeEvent(const Vector& toaMeasurements,
+    const Event& initial, size_t maxIterations, double tol) const {
+  if (size_t(toaMeasurements.size()) != anchors_.size())
+    throw invalid_argument(
+        "TOAEventLocalizer::localizeEvent: expected one measurement per anchor");
+
+  const TimeOfArrival toa(speed_);
+  const double precision = 1.0 / (sigma_ * sigma_);
+  Event event = initial;
+  for (size_t iteration = 0; iteration < maxIterations; ++iteration) {
+    // Accumulate the 4x4 normal equations over all anchors - the event
+    // block of the full bipartite Hessian, already marginalized since the
+    // anchors are known
+    Matrix4 H = Matrix4::Zero();
+    Vector4 g = Vector4::Zero();
+    for (size_t i = 0; i < anchors_.size(); ++i) {
+      Matrix14 A;
+      const double residual = toa(event, anchors_[i], A) - toaMeasurements[i];
+      H.noalias() += precision * (A.transpose() * A);
+      g.noalias() -= precision * (A.transpose() * residual);
+    }
+    const Vector4 delta = H.ldlt().solve(g);
+    event = event.retract(delta);
+    if (delta.norm() < tol)
+      break;
+  }
+  return event;
+}
+
+/* ************************************************************************* */
+std::vector<Event> TOAEventLocalizer::localizeAll(
+    const std::vector<Vector>& measurements, const std::vector<Event>& initials,
+    size_t maxIterations, double tol) const {
+  gttic(TOAEventLocalizer_localizeAll);
+  if (measurements.size() != initials.size())
+    throw invalid_argument(
+        "TOAEventLocalizer::localizeAll: measurements and initials differ in length");
+
+  std::vector<Event> events(measurements.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, measurements.size()),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i)
+          events[i] = localizeEvent(measurements[i], initials[i],
+              maxIterations, tol);
+      });
+#else
+  for (size_t i = 0; i < measurements.size(); ++i)
+    events[i] = localizeEvent(measurements[i], initials[i], maxIterations, tol);
+#endif
+  return events;
+}
+
+/* ************************************************************************* */
+double TOAEventLocalizer::error(const Vector& toaMeasurements,
+    const Event& event) const {
+  if (size_t(toaMeasurements.size()) != anchors_.size())
+    throw invalid_argument(
+        "TOAEventLocalizer::error: expected one measurement per anchor");
+  const TimeOfArrival toa(speed_);
+  double total = 0.0;
+  for (size_t i = 0; i < anchors_.size(); ++i) {
+    const double residual = toa.measure(event, anchors_[i]) - toaMeasurements[i];
+    total += residual * residual;
+  }
+  return 0.5 * total / (sigma_ * sigma_);
+}
+
+/* ************************************************************************* */
+
+} // namespace gtsam
@@ -0,0 +1,88 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  TOAEventLocalizer.h
+ *  @brief Batch localization of many events from TOA measurements
+ *  @author Frank Dellaert
+ */
+
+#pragma once
+
+#include <gtsam_unstable/geometry/Event.h>
+#include <gtsam_unstable/dllexport.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Batch event localization against a calibrated anchor network.  Given the
+ * anchor positions, the events are conditionally independent - the Hessian
+ * over events is block-diagonal, just like landmarks in bundle adjustment
+ * given the cameras - so each event reduces to an independent 4-dof
+ * Gauss-Newton solve on fixed-size normal equations, with no factor graph
+ * or elimination machinery allocated per event.  localizeAll() runs the
+ * per-event solves in parallel when TBB is available.  Joint refinement of
+ * the anchors themselves is left to the generic TOAFactor path.
+ */
+class GTSAM_UNSTABLE_EXPORT TOAEventLocalizer {
+
+ public:
+
+  typedef noiseModel::Isotropic::shared_ptr SharedIsotropic;
+
+  /**
+   * Constructor
+   * @param anchors known sensor positions; at least four non-coplanar
+   * anchors are needed for the per-event solves to be well-posed
+   * @param speed speed of signal, in m/sec
+   * @param model optional isotropic measurement noise on each TOA, in
+   * seconds (unit sigma if not given); std::invalid_argument if not 1-dim
+   */
+  TOAEventLocalizer(const std::vector<Point3>& anchors, double speed = 330,
+      const SharedIsotropic& model = SharedIsotropic());
+
+  /// The anchor positions
+  const std::vector<Point3>& anchors() const { return anchors_; }
+
+  /**
+   * Localize a single event by Gauss-Newton on the 4-dof normal equations.
+   * @param toaMeasurements times of arrival, one per anchor in anchor order
+   * (std::invalid_argument if the count differs)
+   * @param initial initial estimate, e.g. the network centroid at time zero
+   * @param maxIterations cap on Gauss-Newton iterations
+   * @param tol convergence threshold on the update norm
+   */
+  Event localizeEvent(const Vector& toaMeasurements, const Event& initial,
+      size_t maxIterations = 10, double tol = 1e-9) const;
+
+  /**
+   * Localize many events independently, in parallel when TBB is enabled.
+   * measurements and initials must have the same length; element i of the
+   * result is localizeEvent(measurements[i], initials[i]).
+   */
+  std::vector<Event> localizeAll(const std::vector<Vector>& measurements,
+      const std::vector<Event>& initials, size_t maxIterations = 10,
+      double tol = 1e-9) const;
+
+  /// Sum of squared whitened TOA residuals of an event, 0.5|h(x)-z|^2/sigma^2
+  double error(const Vector& toaMeasurements, const Event& event) const;
+
+ private:
+
+  std::vector<Point3> anchors_; ///< known sensor positions
+  double speed_;                ///< signal speed, in m/sec
+  double sigma_;                ///< isotropic TOA measurement sigma
+};
+
+} // namespace gtsam
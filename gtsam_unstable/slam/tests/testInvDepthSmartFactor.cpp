@@ -0,0 +1,198 @@
+/*
+ * testInvDepthSmartFactor.cpp
+ *
+ *  Unit tests for the smart inverse depth factor
+ */
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam_unstable/slam/InvDepthSmartFactor.h>
+#include <gtsam/nonlinear/NonlinearEquality.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/geometry/Point2.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+
+// Two poses looking in the x-direction, and a landmark in front of them
+const Pose3 pose1(Rot3::Ypr(-M_PI/2, 0., -M_PI/2), Point3(0,0,1.0));
+const Pose3 pose2(Rot3::Ypr(-M_PI/2, 0., -M_PI/2), Point3(0,0,1.5));
+const Point3 landmark(5, 0, 1);
+const Cal3_S2::shared_ptr K(new Cal3_S2(1500, 1200, 0, 640, 480));
+const SharedNoiseModel sigma(noiseModel::Isotropic::Sigma(2, 1.0));
+const Key poseKey1(1);
+const Key poseKey2(2);
+
+// The inverse depth parameterization of the landmark in the pose1 frame
+double landmarkTheta() {
+  Point3 p = pose1.transformTo(landmark);
+  return atan2(p.x(), p.z());
+}
+double landmarkPhi() {
+  Point3 p = pose1.transformTo(landmark);
+  return atan2(p.y(), sqrt(p.x()*p.x()+p.z()*p.z()));
+}
+double landmarkRho() {
+  return 1.0 / pose1.transformTo(landmark).norm();
+}
+
+// Reprojection of the bearing (theta,phi) at inverse depth rho into 'pose',
+// used to verify the analytic Jacobians numerically
+Vector reprojectionError(const Pose3& anchor, const Pose3& pose, const Vector1& rho,
+    const Point2& measured) {
+  double theta = landmarkTheta(), phi = landmarkPhi();
+  Point3 ray(cos(phi)*sin(theta), sin(phi), cos(phi)*cos(theta));
+  Point3 world_P_landmark = anchor.transformFrom(ray / rho(0));
+  PinholeCamera<Cal3_S2> camera(pose, *K);
+  return measured - camera.project(world_P_landmark);
+}
+
+}
+
+/* ************************************************************************* */
+TEST( InvDepthSmartFactor, error) {
+
+  // Create image observations
+  PinholeCamera<Cal3_S2> camera1(pose1, *K);
+  PinholeCamera<Cal3_S2> camera2(pose2, *K);
+  Point2 pixel1 = camera1.project(landmark);
+  Point2 pixel2 = camera2.project(landmark);
+
+  // A factor anchored at pose1 with the correct inverse depth
+  InvDepthSmartFactor factor(poseKey1, landmarkTheta(), landmarkPhi(), landmarkRho(), K, sigma);
+  factor.add(pixel1, poseKey1);
+  factor.add(pixel2, poseKey2);
+  EXPECT_LONGS_EQUAL(2, factor.keys().size());
+  EXPECT_LONGS_EQUAL(4, factor.dim());
+
+  Values values;
+  values.insert(poseKey1, pose1);
+  values.insert(poseKey2, pose2);
+  DOUBLES_EQUAL(0.0, factor.error(values), 1e-9);
+  EXPECT(assert_equal(landmark, factor.point(values), 1e-6));
+
+  // A wrong initial inverse depth is refined away internally
+  InvDepthSmartFactor factor2(poseKey1, landmarkTheta(), landmarkPhi(), 2.0 * landmarkRho(), K, sigma);
+  factor2.add(pixel1, poseKey1);
+  factor2.add(pixel2, poseKey2);
+  DOUBLES_EQUAL(0.0, factor2.error(values), 1e-6);
+  DOUBLES_EQUAL(landmarkRho(), factor2.invDepth(), 1e-6);
+
+  // A non-isotropic noise model is rejected
+  SharedNoiseModel bad = noiseModel::Diagonal::Sigmas(Vector2(1.0, 2.0));
+  CHECK_EXCEPTION(
+      InvDepthSmartFactor(poseKey1, landmarkTheta(), landmarkPhi(), landmarkRho(), K, bad),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( InvDepthSmartFactor, schurComplement) {
+
+  // Create image observations
+  PinholeCamera<Cal3_S2> camera1(pose1, *K);
+  PinholeCamera<Cal3_S2> camera2(pose2, *K);
+  Point2 pixel1 = camera1.project(landmark);
+  Point2 pixel2 = camera2.project(landmark);
+
+  InvDepthSmartFactor factor(poseKey1, landmarkTheta(), landmarkPhi(), landmarkRho(), K, sigma);
+  factor.add(pixel1, poseKey1);
+  factor.add(pixel2, poseKey2);
+
+  // Linearize around slightly perturbed poses
+  Values values;
+  values.insert(poseKey1, pose1.retract((Vector(6) << +0.01, -0.02, +0.03, -0.10, +0.20, -0.30).finished()));
+  values.insert(poseKey2, pose2.retract((Vector(6) << +0.01, +0.02, -0.03, -0.10, +0.20, +0.30).finished()));
+  GaussianFactor::shared_ptr actual = factor.linearize(values);
+
+  // Build the full (unreduced) system numerically and eliminate the scalar
+  // inverse depth by hand: [F e b] -> [F b]'[F b] - v v'/d with v = [F b]'e
+  const Pose3 x1 = values.at<Pose3>(poseKey1);
+  const Pose3 x2 = values.at<Pose3>(poseKey2);
+  const Vector1 rho(factor.invDepth());
+  Matrix F(4, 12), M(4, 13);
+  Vector e(4), b(4);
+  F.block<2,6>(0, 0) = -numericalDerivative11<Vector,Pose3>(
+      boost::bind(&reprojectionError, _1, x1, rho, pixel1), x1)
+    - numericalDerivative11<Vector,Pose3>(
+      boost::bind(&reprojectionError, x1, _1, rho, pixel1), x1);
+  F.block<2,6>(0, 6) = Matrix::Zero(2, 6);
+  F.block<2,6>(2, 0) = -numericalDerivative11<Vector,Pose3>(
+      boost::bind(&reprojectionError, _1, x2, rho, pixel2), x1);
+  F.block<2,6>(2, 6) = -numericalDerivative11<Vector,Pose3>(
+      boost::bind(&reprojectionError, x1, _1, rho, pixel2), x2);
+  e.segment<2>(0) = -numericalDerivative11<Vector,Vector1>(
+      boost::bind(&reprojectionError, x1, x1, _1, pixel1), rho);
+  e.segment<2>(2) = -numericalDerivative11<Vector,Vector1>(
+      boost::bind(&reprojectionError, x1, x2, _1, pixel2), rho);
+  b.segment<2>(0) = reprojectionError(x1, x1, rho, pixel1);
+  b.segment<2>(2) = reprojectionError(x1, x2, rho, pixel2);
+  M << F, b;
+  Matrix expected = M.transpose() * M;
+  Vector v = M.transpose() * e;
+  expected -= v * v.transpose() / e.squaredNorm();
+
+  EXPECT(assert_equal(expected, actual->augmentedInformation(), 1e-4));
+}
+
+/* ************************************************************************* */
+TEST( InvDepthSmartFactor, optimize) {
+
+  // A collection of landmarks in front of the cameras
+  std::vector<Point3> landmarks;
+  for(double x = 4.0; x <= 10.0; x += 3.0) {
+    for(double y = -2.0; y <= 2.0; y += 2.0) {
+      for(double z = -1.0; z <= 3.0; z += 2.0) {
+        landmarks.push_back(Point3(x, y, z));
+      }
+    }
+  }
+
+  // One smart factor per landmark, anchored at pose1, with a perturbed
+  // initial inverse depth. The first two poses are fixed to pin the scale;
+  // the third is recovered from the smart factors alone.
+  const Pose3 pose3(Rot3::Ypr(-M_PI/2, 0., -M_PI/2), Point3(0,0,2.0));
+  const Key poseKey3(3);
+  PinholeCamera<Cal3_S2> camera1(pose1, *K);
+  PinholeCamera<Cal3_S2> camera2(pose2, *K);
+  PinholeCamera<Cal3_S2> camera3(pose3, *K);
+  NonlinearFactorGraph graph;
+  graph.push_back(NonlinearEquality<Pose3>(poseKey1, pose1, 100000));
+  graph.push_back(NonlinearEquality<Pose3>(poseKey2, pose2, 100000));
+  for(size_t i = 0; i < landmarks.size(); ++i) {
+    Point3 p = pose1.transformTo(landmarks[i]);
+    double theta = atan2(p.x(), p.z());
+    double phi = atan2(p.y(), sqrt(p.x()*p.x()+p.z()*p.z()));
+    double rho = 1.0 / p.norm();
+    InvDepthSmartFactor::shared_ptr factor(
+        new InvDepthSmartFactor(poseKey1, theta, phi, 1.2 * rho, K, sigma));
+    factor->add(camera1.project(landmarks[i]), poseKey1);
+    factor->add(camera2.project(landmarks[i]), poseKey2);
+    factor->add(camera3.project(landmarks[i]), poseKey3);
+    graph.push_back(factor);
+  }
+
+  // Optimize from a perturbed third pose
+  Values values;
+  values.insert(poseKey1, pose1);
+  values.insert(poseKey2, pose2);
+  values.insert(poseKey3, pose3.retract((Vector(6) << +0.005, +0.010, -0.015, -0.05, +0.10, +0.15).finished()));
+  LevenbergMarquardtParams params;
+  Values result = LevenbergMarquardtOptimizer(graph, values, params).optimize();
+
+  // The third pose is recovered from the smart factors alone
+  EXPECT(assert_equal(pose3, result.at<Pose3>(poseKey3), 1e-4));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,125 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testSim3PoseGraph.cpp
+ * @brief  Unit tests for the Similarity3 pose graph pipeline
+ * @author Frank Dellaert
+ */
+
+#include <gtsam_unstable/slam/Sim3PoseGraph.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/Testable.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+static const SharedNoiseModel kModel = noiseModel::Isotropic::Sigma(7, 0.1);
+
+/* ************************************************************************* */
+TEST( Sim3PoseGraph, betweenFactorMatchesGeneric ) {
+  const Similarity3 measured(Rot3::Ypr(0.1, -0.2, 0.3), Point3(1, 2, 3), 1.1);
+  const BetweenFactorSim3 fast(X(1), X(2), measured, kModel);
+  const BetweenFactor<Similarity3> generic(X(1), X(2), measured, kModel);
+
+  Values values;
+  values.insert(X(1), Similarity3(Rot3::Ypr(0.05, 0, 0), Point3(0.1, 0, 0), 0.9));
+  values.insert(X(2), Similarity3(Rot3::Ypr(0.2, -0.1, 0.25), Point3(1, 2, 3.2), 1.05));
+
+  // Same error and same linearization as the generic template path
+  DOUBLES_EQUAL(generic.error(values), fast.error(values), 1e-9);
+  GaussianFactor::shared_ptr expected = generic.linearize(values);
+  GaussianFactor::shared_ptr actual = fast.linearize(values);
+  EXPECT(assert_equal(expected->augmentedInformation(),
+      actual->augmentedInformation(), 1e-9));
+
+  // Zero error when the values agree with the measurement
+  Values exact;
+  exact.insert(X(1), Similarity3(Rot3::Ypr(0.05, 0, 0), Point3(0.1, 0, 0), 0.9));
+  exact.insert(X(2), exact.at<Similarity3>(X(1)) * measured);
+  DOUBLES_EQUAL(0.0, fast.error(exact), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST( Sim3PoseGraph, readG2oSim3 ) {
+  // Write a tiny Sim3 g2o file: two vertices and one unit-information edge
+  const string filename = "testSim3PoseGraph.g2o";
+  {
+    ofstream os(filename.c_str());
+    os << "VERTEX_SIM3:QUAT 0 0 0 0 0 0 0 1 1\n";
+    os << "VERTEX_SIM3:QUAT 1 1 2 3 0 0 0 1 1.5\n";
+    os << "EDGE_SIM3:QUAT 0 1 1 2 3 0 0 0 1 1.5";
+    for (size_t i = 0; i < 7; i++)
+      for (size_t j = i; j < 7; j++)
+        os << " " << (i == j ? 1 : 0);
+    os << "\n";
+  }
+
+  NonlinearFactorGraph::shared_ptr graph;
+  Values::shared_ptr initial;
+  boost::tie(graph, initial) = readG2oSim3(filename);
+  remove(filename.c_str());
+
+  LONGS_EQUAL(1, graph->size());
+  LONGS_EQUAL(2, initial->size());
+  EXPECT(assert_equal(Similarity3(), initial->at<Similarity3>(0), 1e-9));
+  const Similarity3 expected(Rot3(), Point3(1, 2, 3), 1.5);
+  EXPECT(assert_equal(expected, initial->at<Similarity3>(1), 1e-9));
+
+  // The edge measurement matches, and the read values have zero error
+  const BetweenFactorSim3* between =
+      dynamic_cast<const BetweenFactorSim3*>(graph->at(0).get());
+  CHECK(between);
+  EXPECT(assert_equal(expected, between->measured(), 1e-9));
+  DOUBLES_EQUAL(0.0, graph->error(*initial), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST( Sim3PoseGraph, initializeAndOptimize ) {
+  // A square with scale drift along the odometry and a loop closure
+  const Similarity3 odometry(Rot3::Yaw(M_PI_2), Point3(2, 0, 0), 1.0);
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<BetweenFactorSim3>(X(0), X(1), odometry, kModel);
+  graph.emplace_shared<BetweenFactorSim3>(X(1), X(2), odometry, kModel);
+  graph.emplace_shared<BetweenFactorSim3>(X(2), X(3), odometry, kModel);
+  graph.emplace_shared<BetweenFactorSim3>(X(3), X(0), odometry, kModel);
+
+  // Spanning-tree composition visits every variable and is exact here
+  Values initial = initializeSim3(graph);
+  LONGS_EQUAL(4, initial.size());
+  EXPECT(assert_equal(Similarity3(), initial.at<Similarity3>(X(0)), 1e-9));
+  DOUBLES_EQUAL(0.0, graph.error(initial), 1e-6);
+
+  // With a prior pinning the gauge, optimization from the spanning-tree
+  // initialization stays at the consistent solution
+  graph.emplace_shared<PriorFactor<Similarity3> >(X(0), Similarity3(),
+      noiseModel::Isotropic::Sigma(7, 0.01));
+  LevenbergMarquardtOptimizer optimizer(graph, initial);
+  Values result = optimizer.optimize();
+  DOUBLES_EQUAL(0.0, graph.error(result), 1e-6);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,118 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  testTOAEventLocalizer.cpp
+ *  @brief Unit tests for batch TOA event localization
+ *  @author Frank Dellaert
+ */
+
+#include <gtsam_unstable/slam/TOAEventLocalizer.h>
+#include <gtsam_unstable/slam/TOAFactor.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/base/Testable.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+// Four non-coplanar microphones, in meters
+static const vector<Point3> kAnchors { Point3(0, 0, 0), Point3(10, 0, 0),
+    Point3(0, 10, 0), Point3(3, 3, 8) };
+static const double kSpeed = 330;
+
+// Measure the TOA at every anchor for a ground-truth event
+static Vector measureAll(const Event& event) {
+  const TimeOfArrival toa(kSpeed);
+  Vector measurements(kAnchors.size());
+  for (size_t i = 0; i < kAnchors.size(); ++i)
+    measurements[i] = toa.measure(event, kAnchors[i]);
+  return measurements;
+}
+
+/* ************************************************************************* */
+TEST( TOAEventLocalizer, localizeEvent ) {
+  const TOAEventLocalizer localizer(kAnchors, kSpeed);
+  const Event groundTruth(0.1, 2, 3, 1);
+  const Vector measurements = measureAll(groundTruth);
+
+  // Gauss-Newton from a coarse initial estimate recovers the event exactly
+  const Event initial(0, 5, 5, 2);
+  const Event actual = localizer.localizeEvent(measurements, initial);
+  EXPECT(assert_equal(groundTruth, actual, 1e-6));
+  DOUBLES_EQUAL(0.0, localizer.error(measurements, actual), 1e-12);
+
+  // The result agrees with optimizing the equivalent TOAFactor graph
+  NonlinearFactorGraph graph;
+  const Expression<Event> eventExpression(12);
+  const SharedNoiseModel model = noiseModel::Isotropic::Sigma(1, 0.5e-3);
+  for (size_t i = 0; i < kAnchors.size(); ++i)
+    graph.emplace_shared<TOAFactor>(eventExpression, kAnchors[i],
+        measurements[i], model, kSpeed);
+  Values values;
+  values.insert(12, initial);
+  const Values result = LevenbergMarquardtOptimizer(graph, values).optimize();
+  EXPECT(assert_equal(result.at<Event>(12), actual, 1e-6));
+
+  // A measurement count mismatch is rejected
+  CHECK_EXCEPTION(localizer.localizeEvent(Vector::Zero(3), initial),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( TOAEventLocalizer, localizeAll ) {
+  const TOAEventLocalizer localizer(kAnchors, kSpeed);
+
+  // Many independent events, all initialized at the network centroid
+  vector<Event> groundTruth;
+  vector<Vector> measurements;
+  vector<Event> initials;
+  for (size_t i = 0; i < 25; ++i) {
+    const Event event(0.01 * i, 1 + 0.3 * i, 8 - 0.25 * i, 0.1 * i);
+    groundTruth.push_back(event);
+    measurements.push_back(measureAll(event));
+    initials.push_back(Event(0, 4, 4, 2));
+  }
+
+  const vector<Event> actual = localizer.localizeAll(measurements, initials);
+  LONGS_EQUAL((long)groundTruth.size(), (long)actual.size());
+  for (size_t i = 0; i < groundTruth.size(); ++i)
+    EXPECT(assert_equal(groundTruth[i], actual[i], 1e-6));
+
+  // Mismatched input lengths are rejected
+  CHECK_EXCEPTION(localizer.localizeAll(measurements, vector<Event>(2)),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( TOAEventLocalizer, noiseModel ) {
+  // The sigma scales the error but not the minimizer
+  const TOAEventLocalizer::SharedIsotropic model = //
+      noiseModel::Isotropic::Sigma(1, 2e-3);
+  const TOAEventLocalizer localizer(kAnchors, kSpeed, model);
+  const Event groundTruth(0.2, 1, 2, 3);
+  const Vector measurements = measureAll(groundTruth);
+  const Event actual = localizer.localizeEvent(measurements, Event(0, 4, 4, 2));
+  EXPECT(assert_equal(groundTruth, actual, 1e-6));
+
+  // Only 1-dimensional noise models make sense for scalar TOA measurements
+  CHECK_EXCEPTION(
+      TOAEventLocalizer(kAnchors, kSpeed, noiseModel::Isotropic::Sigma(3, 1.0)),
+      std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,112 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testAdaptiveNonlinearISAM.cpp
+ * @brief Unit tests for the hybrid incremental/batch ISAM2 controller
+ * @author Frank Dellaert
+ * @date Aug 30, 2026
+ */
+
+#include <gtsam/nonlinear/AdaptiveNonlinearISAM.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedNoiseModel priorNoise = noiseModel::Diagonal::Sigmas(
+    Vector3(0.1, 0.1, 0.05));
+static const SharedNoiseModel odoNoise = noiseModel::Diagonal::Sigmas(
+    Vector3(0.2, 0.2, 0.1));
+
+/* ************************************************************************* */
+TEST(AdaptiveNonlinearISAM, noDriftNoRefinement)
+{
+  // With accurate initialization and a huge threshold, the controller must
+  // behave exactly like plain ISAM2 and never trigger a refinement
+  AdaptiveNonlinearISAM adaptive(ISAM2Params(), 1e9);
+  ISAM2 plain;
+
+  Pose2 odometry(1.0, 0.0, 0.1);
+  Pose2 pose(0, 0, 0);
+  NonlinearFactorGraph newFactors;
+  Values newValues;
+  newFactors.emplace_shared<PriorFactor<Pose2> >(0, pose, priorNoise);
+  newValues.insert(0, pose);
+  for (size_t i = 1; i <= 5; i++) {
+    adaptive.update(newFactors, newValues);
+    plain.update(newFactors, newValues);
+    newFactors = NonlinearFactorGraph();
+    newValues = Values();
+    newFactors.emplace_shared<BetweenFactor<Pose2> >(i - 1, i, odometry, odoNoise);
+    pose = pose.compose(odometry);
+    newValues.insert(i, pose);
+  }
+
+  EXPECT_LONGS_EQUAL(0, adaptive.refinementCount());
+  EXPECT(assert_equal(plain.calculateEstimate(), adaptive.estimate(), 1e-12));
+}
+
+/* ************************************************************************* */
+TEST(AdaptiveNonlinearISAM, refinementMatchesBatch)
+{
+  // Poor initialization on a rotationally significant chain: default ISAM2
+  // does not relinearize within the first relinearizeSkip updates, so the
+  // deltas grow and the drift monitor must fire
+  AdaptiveNonlinearISAM adaptive(ISAM2Params(), 0.0);  // refine every update
+
+  Pose2 odometry(2.0, 0.0, 0.3);
+  vector<Pose2> initials;
+  initials.push_back(Pose2(0.3, -0.2, 0.2));
+  initials.push_back(Pose2(2.5, 0.4, 0.6));
+  initials.push_back(Pose2(4.2, 1.5, 0.8));
+  initials.push_back(Pose2(5.3, 2.9, 1.2));
+
+  NonlinearFactorGraph fullGraph;
+  Values fullInitials;
+  NonlinearFactorGraph newFactors;
+  Values newValues;
+  newFactors.emplace_shared<PriorFactor<Pose2> >(0, Pose2(0, 0, 0), priorNoise);
+  newValues.insert(0, initials[0]);
+  for (size_t i = 1; i <= 3; i++) {
+    fullGraph.push_back(newFactors);
+    fullInitials.insert(newValues);
+    adaptive.update(newFactors, newValues);
+    newFactors = NonlinearFactorGraph();
+    newValues = Values();
+    newFactors.emplace_shared<BetweenFactor<Pose2> >(i - 1, i, odometry, odoNoise);
+    newValues.insert(i, initials[i]);
+  }
+  fullGraph.push_back(newFactors);
+  fullInitials.insert(newValues);
+  adaptive.update(newFactors, newValues);
+
+  EXPECT(adaptive.refinementCount() >= 1);
+
+  // Refining all variables at once has no boundary to anchor, so the
+  // overlay must coincide with the batch LM solution
+  KeySet allKeys = fullGraph.keys();
+  adaptive.refine(allKeys);
+  Values expected = LevenbergMarquardtOptimizer(fullGraph, fullInitials).optimize();
+  EXPECT(assert_equal(expected, adaptive.estimate(), 1e-5));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -152,6 +152,35 @@ TEST(DoglegOptimizer, Iterate) {
   }
 }
 
+/* ************************************************************************* */
+TEST(DoglegOptimizer, CachedLinearization) {
+  // really non-linear factor graph
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+
+  // config far from minimum
+  Point2 x0(3,0);
+  Values config;
+  config.insert(X(1), x0);
+
+  // The factorization cache must not change the sequence of iterates: driving
+  // the optimizer one iterate() at a time has to give the same trajectory and
+  // final estimate as a fresh optimizer run through optimize(), for both
+  // elimination orders.
+  DoglegParams multifrontalParams;
+  DoglegOptimizer expectedOptimizer(fg, config, multifrontalParams);
+  Values expected = expectedOptimizer.optimize();
+
+  DoglegOptimizer optimizer(fg, config, multifrontalParams);
+  for(size_t it = 0; it < expectedOptimizer.iterations(); ++it)
+    optimizer.iterate();
+  EXPECT(assert_equal(expected, optimizer.values()));
+
+  DoglegParams sequentialParams;
+  sequentialParams.linearSolverType = NonlinearOptimizerParams::SEQUENTIAL_CHOLESKY;
+  DoglegOptimizer sequentialOptimizer(fg, config, sequentialParams);
+  EXPECT(assert_equal(expected, sequentialOptimizer.optimize(), 1e-5));
+}
+
 /* ************************************************************************* */
 TEST(DoglegOptimizer, Constraint) {
   // Create a pose-graph graph with a constraint on the first pose
@@ -166,6 +166,53 @@ TEST(ExpressionFactor, Wide) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(f2, values, 1e-5, 1e-9);
 }
 
+/* ************************************************************************* */
+// Factors with different trace sizes share one per-thread trace buffer;
+// alternating between them grows the buffer and replays in it repeatedly,
+// which must not change any linearization
+TEST(ExpressionFactor, SharedTraceBuffer) {
+  Values values;
+  values.insert(2, Point3(0, 0, 1));
+  Point3_ point(2);
+
+  ExpressionFactor<Point2> small(model, measured, project(point));
+  Vector9 measured9;
+  measured9.setZero();
+  ExpressionFactor<Vector9> large(noiseModel::Unit::Create(9), measured9,
+      Expression<Vector9>(id9, Expression<Vector9>(wide, point)));
+
+  const GaussianFactor::shared_ptr expectedSmall = small.linearize(values);
+  const GaussianFactor::shared_ptr expectedLarge = large.linearize(values);
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT(assert_equal(*expectedSmall, *small.linearize(values), 1e-9));
+    EXPECT(assert_equal(*expectedLarge, *large.linearize(values), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+// The trace layout advances ExecutionTraceStorage pointers element-wise, so
+// TraceStorage must provide traceSize() elements, not bytes.  Touching every
+// element and then replaying the trace in the exactly-sized buffer turns an
+// undersized allocation into a deterministic failure under AddressSanitizer,
+// instead of heap corruption that may go unnoticed
+TEST(ExpressionFactor, TraceStorageBounds) {
+  Values values;
+  values.insert(2, Point3(0, 0, 1));
+  Expression<Vector9> expression(id9, Expression<Vector9>(wide, Point3_(2)));
+
+  const size_t size = expression.traceSize();
+  CHECK(size > 0);
+  internal::TraceStorage storage(size);
+  EXPECT_LONGS_EQUAL(size, storage.size());
+  memset(storage.data(), 0xab,
+      size * sizeof(internal::ExecutionTraceStorage));
+
+  internal::ExecutionTrace<Vector9> trace;
+  Vector9 value =
+      expression.root()->traceExecution(values, trace, storage.data());
+  EXPECT(assert_equal(Vector9(wide(Point3(0, 0, 1), boost::none)), value, 1e-9));
+}
+
 /* ************************************************************************* */
 static Point2 myUncal(const Cal3_S2& K, const Point2& p,
     OptionalJacobian<2,5> Dcal, OptionalJacobian<2,2> Dp) {
@@ -315,6 +362,35 @@ TEST(ExpressionFactor, tree) {
   EXPECT( assert_equal(*expected, *gf3, 1e-9));
 }
 
+/* ************************************************************************* */
+// The fused project3 node must work for any calibration, not just Cal3_S2,
+// and linearize identically to the equivalent chained expression
+TEST(ExpressionFactor, treeBundler) {
+
+  // Create some values
+  Values values;
+  values.insert(1, Pose3());
+  values.insert(2, Point3(0, 0, 1));
+  values.insert(3, Cal3Bundler());
+
+  // Create leaves
+  Pose3_ x(1);
+  Point3_ p(2);
+  Cal3Bundler_ K(3);
+
+  // Chained expression tree, one node per operation
+  ExpressionFactor<Point2> chained(model, measured,
+      uncalibrate(K, project(transformTo(x, p))));
+
+  // Fused single-node version
+  ExpressionFactor<Point2> fused(model, measured, project3(x, p, K));
+
+  EXPECT_DOUBLES_EQUAL(chained.error(values), fused.error(values), 1e-9);
+  boost::shared_ptr<GaussianFactor> expected = chained.linearize(values);
+  boost::shared_ptr<GaussianFactor> actual = fused.linearize(values);
+  EXPECT( assert_equal(*expected, *actual, 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(ExpressionFactor, Compose1) {
 
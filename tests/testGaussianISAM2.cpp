@@ -5,6 +5,8 @@
  */
 
 #include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/ISAM2-impl.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
 
 #include <tests/smallExample.h>
 #include <gtsam/slam/BetweenFactor.h>
@@ -283,6 +285,167 @@ bool isam_check(const NonlinearFactorGraph& fullgraph, const Values& fullinit, c
   return nodeGradientsOk && expectedGradOk && totalGradOk && isamEqual && isamTreeEqual && consistent;
 }
 
+/* ************************************************************************* */
+// BetweenFactor that counts how many times it is linearized
+struct CountingBetween: public BetweenFactor<Pose2> {
+  static size_t linearizeCount;
+  CountingBetween(Key key1, Key key2, const Pose2& measured,
+      const SharedNoiseModel& model) :
+      BetweenFactor<Pose2>(key1, key2, measured, model) {
+  }
+  virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    ++linearizeCount;
+    return BetweenFactor<Pose2>::linearize(x);
+  }
+};
+size_t CountingBetween::linearizeCount = 0;
+
+/* ************************************************************************* */
+TEST(ISAM2, linearizationRevisionCache)
+{
+  // Relinearize on every update with a tight threshold, cache enabled
+  const ISAM2Params params(ISAM2GaussNewtonParams(0.0), 0.001, 1, true);
+  ISAM2 isam(params);
+  ISAM2Params noCacheParams = params;
+  noCacheParams.cacheLinearizedFactors = false;
+  ISAM2 reference(noCacheParams);
+
+  // A deliberately bad initial guess, so pose 0 will relinearize next update
+  NonlinearFactorGraph priorGraph;
+  priorGraph.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  Values init0;
+  init0.insert(0, Pose2(0.1, 0.1, 0.1));
+  isam.update(priorGraph, init0);
+  reference.update(priorGraph, init0);
+
+  // Adding a factor while pose 0 relinearizes: the new factor is linearized
+  // once in step 7, and the revision signature must prevent the second,
+  // bit-identical linearization in relinearizeAffectedFactors.
+  NonlinearFactorGraph batch;
+  batch += CountingBetween(0, 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+  Values init1;
+  init1.insert(1, Pose2(1.2, -0.1, 0.05));
+  const Pose2 lin0Before = isam.getLinearizationPoint().at<Pose2>(0);
+  CountingBetween::linearizeCount = 0;
+  isam.update(batch, init1);
+  EXPECT_LONGS_EQUAL(1, CountingBetween::linearizeCount);
+  // guard against vacuity: pose 0 really was relinearized in that update
+  EXPECT(!lin0Before.equals(isam.getLinearizationPoint().at<Pose2>(0), 1e-12));
+  reference.update(batch, init1);
+  EXPECT(assert_equal(reference.calculateEstimate(), isam.calculateEstimate(), 1e-9));
+
+  // Keep going, including a loop closure that relinearizes everything; the
+  // cached-reuse solver must track the uncached reference exactly
+  for (size_t i = 1; i < 4; ++i) {
+    NonlinearFactorGraph odo;
+    odo += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(i + 1, Pose2(double(i + 1) + 0.15, 0.1, -0.05));
+    isam.update(odo, init);
+    reference.update(odo, init);
+  }
+  NonlinearFactorGraph loop;
+  loop += BetweenFactor<Pose2>(0, 4, Pose2(4.0, 0.0, 0.0), odoNoise);
+  isam.update(loop, Values());
+  reference.update(loop, Values());
+  EXPECT(assert_equal(reference.calculateEstimate(), isam.calculateEstimate(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, hotVariableOrdering)
+{
+  // A profiled solver that pins its hottest variable near the root, and a
+  // plain reference; orderings may differ but estimates must not
+  const ISAM2Params params(ISAM2GaussNewtonParams(0.0), 0.0, 1, true);
+  ISAM2Params hotParams = params;
+  hotParams.hotVariableOrderingCount = 1;
+  ISAM2 plain(params), hot(hotParams);
+
+  NonlinearFactorGraph prior;
+  prior.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  Values init0;
+  init0.insert(0, Pose2(0.01, 0.0, 0.0));
+  plain.update(prior, init0);
+  hot.update(prior, init0);
+  for (size_t i = 0; i < 5; ++i) {
+    NonlinearFactorGraph odo;
+    odo += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(i + 1, Pose2(double(i + 1) + 0.05, 0.02, 0.01));
+    plain.update(odo, init);
+    hot.update(odo, init);
+  }
+
+  // Replay telemetry saying variable 2 is re-eliminated most
+  hot.recordKeyAccess(2, 100);
+  EXPECT(hot.keyAccessCounts().at(2) >= 100);
+
+  // A loop closure re-eliminates the whole chain; afterwards the hot
+  // variable must be frontal in the root clique
+  NonlinearFactorGraph loop;
+  loop += BetweenFactor<Pose2>(0, 5, Pose2(5.0, 0.0, 0.0), odoNoise);
+  plain.update(loop, Values());
+  hot.update(loop, Values());
+  EXPECT(assert_equal(plain.calculateEstimate(), hot.calculateEstimate(), 1e-9));
+
+  EXPECT_LONGS_EQUAL(1, hot.roots().size());
+  const ISAM2::sharedClique& root = hot.roots().front();
+  bool hotIsRootFrontal = false;
+  for (auto it = root->conditional()->beginFrontals();
+       it != root->conditional()->endFrontals(); ++it)
+    if (*it == 2) hotIsRootFrontal = true;
+  EXPECT(hotIsRootFrontal);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, updateCoalescing)
+{
+  // Feed identical micro-batches to a per-packet solver and a coalescing one;
+  // with a full solve (wildfire 0) the merged update must give the same answer
+  const ISAM2Params params(ISAM2GaussNewtonParams(0.0), 0.0, 0, false);
+  ISAM2 batched(params), coalesced(params);
+
+  NonlinearFactorGraph priorBatch;
+  priorBatch.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  Values init0;
+  init0.insert(0, Pose2(0.01, 0.01, 0.01));
+  batched.update(priorBatch, init0);
+  EXPECT(!coalesced.enqueueUpdate(priorBatch, init0));
+
+  for (size_t i = 0; i < 3; ++i) {
+    NonlinearFactorGraph batch;
+    batch += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(i + 1, Pose2(double(i + 1) + 0.1, -0.1, 0.01));
+    batched.update(batch, init);
+    if (i == 2) // duplicate initializer, as when two packets see one landmark:
+      init.insert(1, Pose2(9.9, 9.9, 0.9)); // pose 1 is still in the queue
+    EXPECT(!coalesced.enqueueUpdate(batch, init));
+  }
+
+  EXPECT_LONGS_EQUAL(4, coalesced.pendingBatches());
+  coalesced.flushUpdates();
+  EXPECT_LONGS_EQUAL(0, coalesced.pendingBatches());
+  EXPECT(assert_equal(batched.calculateEstimate(), coalesced.calculateEstimate(), 1e-9));
+
+  // With a batch bound, enqueueUpdate flushes by itself once the bound is hit
+  coalesced.setMaxPendingBatches(2);
+  NonlinearFactorGraph batch;
+  batch += BetweenFactor<Pose2>(3, 4, Pose2(1.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(4, Pose2(4.1, -0.1, 0.01));
+  EXPECT(!coalesced.enqueueUpdate(batch, init));
+  NonlinearFactorGraph loop;
+  loop += BetweenFactor<Pose2>(0, 4, Pose2(4.0, 0.0, 0.0), odoNoise);
+  boost::optional<ISAM2Result> flushed = coalesced.enqueueUpdate(loop);
+  EXPECT(flushed.is_initialized());
+  EXPECT_LONGS_EQUAL(0, coalesced.pendingBatches());
+
+  batched.update(batch, init);
+  batched.update(loop, Values());
+  EXPECT(assert_equal(batched.calculateEstimate(), coalesced.calculateEstimate(), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, simple)
 {
@@ -297,6 +460,288 @@ TEST(ISAM2, simple)
   }
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, jointMarginalCovariance)
+{
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph,
+      ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false));
+
+  // Expected joint from a batch Marginals object at the same linearization
+  // point as the iSAM2 tree
+  Marginals marginals(*fullgraph.linearize(isam.getLinearizationPoint()),
+      isam.getLinearizationPoint());
+
+  // Two distant poses and a landmark, spanning several cliques
+  KeyVector variables = list_of(0)(5)(100);
+  JointMarginal expected = marginals.jointMarginalCovariance(variables);
+  JointMarginal actual = isam.jointMarginalCovariance(variables);
+  EXPECT(assert_equal(expected.fullMatrix(), actual.fullMatrix(), 1e-6));
+
+  // Diagonal blocks agree with the single-key marginals from the same tree
+  EXPECT(assert_equal(isam.marginalCovariance(5), Matrix(actual(5, 5)), 1e-9));
+
+  CHECK_EXCEPTION(isam.jointMarginalCovariance(KeyVector()), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, relinearizationBudget)
+{
+  // Three variables above threshold, one factor each; the budget of 2 only
+  // covers the two variables with the largest deltas, the third is deferred
+  ISAM2Params params;
+  params.relinearizationBudget = 2;
+  ISAM2UpdateParams updateParams;
+  UpdateImpl update(params, updateParams);
+
+  VectorValues delta;
+  delta.insert(0, Vector2(0.3, 0.0));
+  delta.insert(1, Vector2(0.9, 0.0));
+  delta.insert(2, Vector2(0.5, 0.0));
+
+  SymbolicFactorGraph graph;
+  graph.push_factor(0);
+  graph.push_factor(1);
+  graph.push_factor(2);
+  VariableIndex variableIndex(graph);
+
+  KeySet relinKeys;
+  relinKeys.insert(0);
+  relinKeys.insert(1);
+  relinKeys.insert(2);
+
+  bool deferred = false;
+  KeySet limited = update.limitRelinearizationBudget(relinKeys, delta,
+                                                     variableIndex, &deferred);
+  EXPECT(deferred);
+  EXPECT_LONGS_EQUAL(2, limited.size());
+  EXPECT(limited.count(1));
+  EXPECT(limited.count(2));
+
+  // An ample budget keeps all keys and defers nothing
+  params.relinearizationBudget = 10;
+  UpdateImpl ample(params, updateParams);
+  limited = ample.limitRelinearizationBudget(relinKeys, delta, variableIndex,
+                                             &deferred);
+  EXPECT(!deferred);
+  EXPECT_LONGS_EQUAL(3, limited.size());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, publishedEstimate)
+{
+  // These variables will be reused and accumulate factors and values
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  params.publishEstimateSnapshot = true;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // The published snapshot matches the estimate after the last update
+  boost::shared_ptr<const ISAM2::PublishedEstimate> snapshot =
+      isam.publishedEstimate();
+  CHECK(snapshot);
+  EXPECT(assert_equal(isam.calculateEstimate(), snapshot->values));
+
+  // Another update publishes a newer version; the old snapshot stays valid
+  isam.update();
+  boost::shared_ptr<const ISAM2::PublishedEstimate> snapshot2 =
+      isam.publishedEstimate();
+  EXPECT(snapshot2->version > snapshot->version);
+  EXPECT(assert_equal(isam.calculateEstimate(), snapshot2->values));
+
+  // No snapshots are published unless requested in the parameters
+  ISAM2 plain = createSlamlikeISAM2(fullinit, fullgraph,
+      ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false));
+  EXPECT(!plain.publishedEstimate());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, eventLogRingBuffer)
+{
+  // A full buffer overwrites the oldest events and counts the drops
+  ISAM2EventLog log(4);
+  EXPECT(log.enabled());
+  for (int i = 0; i < 10; ++i)
+    log.record(ISAM2Event::Wildfire, i, i, 0.001);
+  EXPECT_LONGS_EQUAL(4, log.size());
+  EXPECT_LONGS_EQUAL(10, log.totalRecorded());
+  EXPECT_LONGS_EQUAL(6, log.dropped());
+
+  // forEach visits the retained events oldest first
+  int expectedUpdate = 6;
+  log.forEach([&](const ISAM2Event& event) {
+    EXPECT_LONGS_EQUAL(expectedUpdate++, event.update);
+  });
+  EXPECT_LONGS_EQUAL(10, expectedUpdate);
+
+  log.clear();
+  EXPECT_LONGS_EQUAL(0, log.size());
+  EXPECT_LONGS_EQUAL(0, log.totalRecorded());
+
+  // A disabled log silently drops everything
+  ISAM2EventLog disabled;
+  EXPECT(!disabled.enabled());
+  disabled.record(ISAM2Event::Reeliminate, 1, 5, 0.0);
+  EXPECT_LONGS_EQUAL(0, disabled.size());
+  EXPECT_LONGS_EQUAL(0, disabled.totalRecorded());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, eventLog)
+{
+  // These variables will be reused and accumulate factors and values
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  params.eventLogCapacity = 64;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // The updates recorded re-eliminations and wildfire backsubstitutions
+  const ISAM2EventLog& log = isam.eventLog();
+  EXPECT(log.enabled());
+  EXPECT(log.totalRecorded() > 0);
+  size_t reeliminations = 0, visited = 0;
+  int lastUpdate = 0;
+  log.forEach([&](const ISAM2Event& event) {
+    ++visited;
+    EXPECT(event.update >= lastUpdate);  // Events come in chronological order
+    lastUpdate = event.update;
+    if (event.type == ISAM2Event::Reeliminate) ++reeliminations;
+  });
+  EXPECT_LONGS_EQUAL(log.size(), visited);
+  EXPECT(reeliminations > 0);
+
+  // Draining the log does not disturb the solver and keeps it enabled
+  Values estimateBefore = isam.calculateEstimate();
+  isam.eventLog().clear();
+  EXPECT_LONGS_EQUAL(0, isam.eventLog().size());
+  EXPECT(isam.eventLog().enabled());
+  EXPECT(assert_equal(estimateBefore, isam.calculateEstimate()));
+
+  // The log stays empty unless requested in the parameters
+  ISAM2 plain = createSlamlikeISAM2(fullinit, fullgraph,
+      ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false));
+  EXPECT(!plain.eventLog().enabled());
+  EXPECT_LONGS_EQUAL(0, plain.eventLog().totalRecorded());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, compressColdCliques)
+{
+  // These variables will be reused and accumulate factors and values
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph,
+      ISAM2Params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false));
+
+  // Reference results with everything in double precision
+  const Values estimateBefore = isam.calculateBestEstimate();
+  const Matrix marginalBefore = isam.marginalCovariance(0);
+
+  // Demote cliques that the most recent update did not touch
+  const size_t saved = isam.compressColdCliques(1);
+  EXPECT(saved > 0);
+  std::set<ISAM2::sharedClique> compressed;
+  for (const auto& key_clique : isam.nodes()) {
+    if (key_clique.second->isCompressed()) compressed.insert(key_clique.second);
+  }
+  EXPECT(compressed.size() > 0);
+
+  // Marginals and full backsubstitution transparently restore what they touch,
+  // reproducing the reference results up to float32 rounding
+  EXPECT(assert_equal(marginalBefore, isam.marginalCovariance(0), 1e-4));
+  EXPECT(assert_equal(estimateBefore, isam.calculateBestEstimate(), 1e-4));
+
+  // A further update works on the partially compressed tree
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(11, 12, Pose2(1.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(12, fullinit.at<Pose2>(11) * Pose2(1.0, 0.0, 0.0));
+  isam.update(newfactors, init);
+  EXPECT(isam.calculateBestEstimate().exists(12));
+
+  // decompressAllCliques returns the whole tree to the exact tier
+  isam.decompressAllCliques();
+  for (const auto& key_clique : isam.nodes()) {
+    EXPECT(!key_clique.second->isCompressed());
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, deltaConsumerThresholds)
+{
+  // A very loose global wildfire threshold, so backsubstitution normally
+  // stops at the top of the tree
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2Params params(ISAM2GaussNewtonParams(100.0), 0.0, 0, false);
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+
+  // Solve everything once so the replaced-keys mask only reflects later work
+  isam.getDelta();
+
+  // One more odometry step replaces only the top of the tree
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(11, 12, Pose2(1.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(12, Pose2(12.1, -0.1, 0.01));
+  isam.update(newfactors, init);
+
+  // Reference: the exact delta from a full backsubstitution on a copy
+  ISAM2 reference = isam;
+  Values bestEstimate = reference.calculateBestEstimate();
+
+  // A consumer registered on the oldest pose propagates exact deltas down
+  // the path to its clique, despite the loose global threshold
+  isam.registerDeltaConsumer(0, 0.0);
+  EXPECT_LONGS_EQUAL(1, isam.deltaConsumerThresholds().size());
+  Values estimate = isam.calculateEstimate();
+  EXPECT(assert_equal(bestEstimate.at<Pose2>(0), estimate.at<Pose2>(0), 1e-9));
+  EXPECT(assert_equal(bestEstimate.at<Pose2>(12), estimate.at<Pose2>(12), 1e-9));
+
+  // Registrations can be removed again
+  isam.unregisterDeltaConsumer(0);
+  EXPECT(isam.deltaConsumerThresholds().empty());
+
+  // Registering a key that is not in the tree yet is harmless
+  isam.registerDeltaConsumer(999, 0.0);
+  isam.getDelta();
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, packBayesTree)
+{
+  // Packing after every update must not change the solution
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false);
+  params.packInterval = 1;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+
+  // An explicit pack preserves the tree: same variables, same number of
+  // cliques, same estimate
+  const Values expectedEstimate = isam.calculateEstimate();
+  const size_t expectedNodes = isam.nodes().size();
+  const size_t expectedRoots = isam.roots().size();
+  isam.pack();
+  EXPECT_LONGS_EQUAL(expectedNodes, isam.nodes().size());
+  EXPECT_LONGS_EQUAL(expectedRoots, isam.roots().size());
+  EXPECT(assert_equal(expectedEstimate, isam.calculateEstimate()));
+
+  // The packed tree remains fully updatable
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(11, 12, Pose2(1.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(12, Pose2(12.1, 0.1, 0.01));
+  fullgraph.push_back(newfactors);
+  fullinit.insert(12, Pose2(12.1, 0.1, 0.01));
+  isam.update(newfactors, init);
+  CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, slamlike_solution_gaussnewton)
 {
@@ -402,6 +847,48 @@ TEST(ISAM2, removeFactors)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, factorDowndate)
+{
+  // Run identical update sequences with and without the downdate path.
+  // Removing a factor whose variables are frontal in the root clique must
+  // yield the same solution, but without re-eliminating any variables.
+  ISAM2Params params(ISAM2GaussNewtonParams(0.0), 0.0, 0, false);
+  ISAM2Params downdateParams = params;
+  downdateParams.enableFactorDowndate = true;
+  ISAM2 isam(downdateParams);
+  ISAM2 reference(params);
+
+  // A pose chain, with the last two poses constrained to the root clique
+  NonlinearFactorGraph graph;
+  Values init;
+  graph.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  init.insert((0), Pose2(0.01, 0.01, 0.01));
+  for (size_t i = 0; i < 5; ++i) {
+    graph += BetweenFactor<Pose2>(i, i+1, Pose2(1.0, 0.0, 0.0), odoNoise);
+    init.insert((i+1), Pose2(double(i+1)+0.1, -0.1, 0.01));
+  }
+  // An extra loop-closure-style factor on the last two poses, retracted below
+  graph += BetweenFactor<Pose2>(4, 5, Pose2(1.02, 0.01, 0.0), odoNoise);
+  const size_t removedIndex = graph.size() - 1;
+
+  FastMap<Key, int> constrainedKeys;
+  constrainedKeys[4] = 1;
+  constrainedKeys[5] = 1;
+  isam.update(graph, init, FactorIndices(), constrainedKeys);
+  reference.update(graph, init, FactorIndices(), constrainedKeys);
+
+  // Retract the extra factor
+  FactorIndices toRemove;
+  toRemove.push_back(removedIndex);
+  ISAM2Result result = isam.update(NonlinearFactorGraph(), Values(), toRemove);
+  reference.update(NonlinearFactorGraph(), Values(), toRemove);
+
+  // The downdate absorbed the removal, so nothing was re-eliminated
+  EXPECT_LONGS_EQUAL(0, result.variablesReeliminated);
+  EXPECT(assert_equal(reference.calculateEstimate(), isam.calculateEstimate(), 1e-6));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, removeVariables)
 {
@@ -807,6 +1294,59 @@ TEST(ISAM2, marginalCovariance)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, capacityHints)
+{
+  ISAM2Params params;
+  params.capacityHints.maxVariables = 12;
+  params.capacityHints.maxFactors = 30;
+  params.capacityHints.maxFactorsPerUpdate = 2;
+  ISAM2 isam(params);
+
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(3, 0.1);
+
+  // Updates within the declared capacity proceed normally
+  {
+    NonlinearFactorGraph graph;
+    Values init;
+    graph.push_back(PriorFactor<Pose2>(0, Pose2(), model));
+    init.insert(0, Pose2(0.01, 0, 0));
+    isam.update(graph, init);
+  }
+  for (size_t i = 1; i < 5; ++i) {
+    NonlinearFactorGraph graph;
+    Values init;
+    graph.push_back(BetweenFactor<Pose2>(i - 1, i, Pose2(1, 0, 0), model));
+    init.insert(i, Pose2(i + 0.01, 0, 0));
+    isam.update(graph, init);
+  }
+
+  // Exceeding the per-update factor bound fails fast without touching state
+  NonlinearFactorGraph tooMany;
+  Values tooManyInit;
+  for (size_t i = 5; i < 8; ++i) {
+    tooMany.push_back(BetweenFactor<Pose2>(i - 1, i, Pose2(1, 0, 0), model));
+    tooManyInit.insert(i, Pose2(i + 0.01, 0, 0));
+  }
+  const size_t nrFactorsBefore = isam.getFactorsUnsafe().size();
+  CHECK_EXCEPTION(isam.update(tooMany, tooManyInit), std::runtime_error);
+  EXPECT_LONGS_EQUAL(nrFactorsBefore, isam.getFactorsUnsafe().size());
+
+  // Exceeding the total variable bound fails too
+  ISAM2Params params2;
+  params2.capacityHints.maxVariables = 2;
+  ISAM2 isam2(params2);
+  NonlinearFactorGraph graph2;
+  Values init2;
+  graph2.push_back(PriorFactor<Pose2>(0, Pose2(), model));
+  graph2.push_back(BetweenFactor<Pose2>(0, 1, Pose2(1, 0, 0), model));
+  graph2.push_back(BetweenFactor<Pose2>(1, 2, Pose2(1, 0, 0), model));
+  init2.insert(0, Pose2());
+  init2.insert(1, Pose2(1, 0, 0));
+  init2.insert(2, Pose2(2, 0, 0));
+  CHECK_EXCEPTION(isam2.update(graph2, init2), std::runtime_error);
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, calculate_nnz)
 {
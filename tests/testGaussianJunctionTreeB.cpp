@@ -131,6 +131,77 @@ TEST( GaussianJunctionTreeB, constructor2 ) {
   EXPECT_LONGS_EQUAL(4, x1->problemSize_);
 }
 
+/* ************************************************************************* */
+// With a generous fill threshold, relaxed amalgamation merges nearly-matching
+// cliques into larger dense panels without changing the solution.
+TEST( GaussianJunctionTreeB, relaxedAmalgamation ) {
+  // create the same graph as in constructor2 above
+  NonlinearFactorGraph nlfg;
+  Values values;
+  boost::tie(nlfg, values) = createNonlinearSmoother(7);
+  GaussianFactorGraph::shared_ptr fg = nlfg.linearize(values);
+
+  Ordering ordering;
+  ordering += X(1), X(3), X(5), X(7), X(2), X(6), X(4);
+  GaussianEliminationTree etree(*fg, ordering);
+
+  // Exact amalgamation produces the four cliques checked in constructor2,
+  // while a large fill budget amalgamates everything into one dense panel.
+  GaussianJunctionTree exact(etree);
+  GaussianJunctionTree relaxed(etree, 100);
+  LONGS_EQUAL(1, relaxed.roots().size());
+  LONGS_EQUAL(0, relaxed.roots().front()->children.size());
+  LONGS_EQUAL(7, relaxed.roots().front()->orderedFrontalKeys.size());
+
+  // Eliminating the merged tree gives the same solution
+  VectorValues expected = exact.eliminate(EliminateCholesky).first->optimize();
+  VectorValues actual = relaxed.eliminate(EliminateCholesky).first->optimize();
+  EXPECT(assert_equal(expected, actual, 1e-9));
+}
+
+/* ************************************************************************* */
+// Tree shaping: a minimum supernode size absorbs tiny cliques regardless of
+// fill, while a maximum supernode size keeps relaxed merges from collapsing
+// the whole tree into a single panel.
+TEST( GaussianJunctionTreeB, treeShaping ) {
+  // create the same graph as in constructor2 above
+  NonlinearFactorGraph nlfg;
+  Values values;
+  boost::tie(nlfg, values) = createNonlinearSmoother(7);
+  GaussianFactorGraph::shared_ptr fg = nlfg.linearize(values);
+
+  Ordering ordering;
+  ordering += X(1), X(3), X(5), X(7), X(2), X(6), X(4);
+  GaussianEliminationTree etree(*fg, ordering);
+  GaussianJunctionTree exact(etree);
+  VectorValues expected = exact.eliminate(EliminateCholesky).first->optimize();
+
+  // A minimum supernode size of 2 absorbs the single-variable cliques x1 and
+  // x7 of constructor2 into their parents, leaving [x3 x2 x4 x1] over [x5 x6 x7]
+  JunctionTreeShaping absorbTiny;
+  absorbTiny.minSupernodeSize = 2;
+  GaussianJunctionTree coarse(etree, absorbTiny);
+  LONGS_EQUAL(1, coarse.roots().size());
+  LONGS_EQUAL(4, coarse.roots().front()->orderedFrontalKeys.size());
+  LONGS_EQUAL(1, coarse.roots().front()->children.size());
+  LONGS_EQUAL(3, coarse.roots().front()->children.front()->orderedFrontalKeys.size());
+  EXPECT(assert_equal(expected,
+      coarse.eliminate(EliminateCholesky).first->optimize(), 1e-9));
+
+  // The same fill budget that merged all 7 variables in relaxedAmalgamation,
+  // capped at 4 frontals, keeps the [x5 x6 x7] subtree as a separate clique
+  JunctionTreeShaping capped;
+  capped.mergeFillThreshold = 100;
+  capped.maxSupernodeSize = 4;
+  GaussianJunctionTree wide(etree, capped);
+  LONGS_EQUAL(1, wide.roots().size());
+  LONGS_EQUAL(4, wide.roots().front()->orderedFrontalKeys.size());
+  LONGS_EQUAL(1, wide.roots().front()->children.size());
+  LONGS_EQUAL(3, wide.roots().front()->children.front()->orderedFrontalKeys.size());
+  EXPECT(assert_equal(expected,
+      wide.eliminate(EliminateCholesky).first->optimize(), 1e-9));
+}
+
 ///* ************************************************************************* */
 //TEST( GaussianJunctionTreeB, optimizeMultiFrontal )
 //{
@@ -0,0 +1,95 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   testHybridEliminationSolver.cpp
+ *  @brief  Unit tests for HybridEliminationSolver
+ *  @author Frank Dellaert
+ **/
+
+#include <gtsam/linear/HybridEliminationSolver.h>
+
+#include <tests/smallExample.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static size_t N = 3;
+static ConjugateGradientParameters kParameters;
+static auto kOrdering = example::planarOrdering(N);
+
+/* ************************************************************************* */
+TEST( HybridEliminationSolver, hybrid )
+{
+  // Build a planar graph and solve it exactly for reference
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  boost::tie(Ab, xtrue) = example::planarGraph(N);
+  VectorValues expected = Ab.optimize();
+
+  // Eliminate half the variables directly, iterate on the rest
+  Ordering direct(kOrdering.begin(), kOrdering.begin() + kOrdering.size() / 2);
+  HybridEliminationSolver solver(Ab, kParameters, direct);
+  EXPECT_LONGS_EQUAL(direct.size(), solver.directPart().size());
+  VectorValues actual = solver.optimize();
+  EXPECT(assert_equal(expected, actual, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST( HybridEliminationSolver, extremes )
+{
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  boost::tie(Ab, xtrue) = example::planarGraph(N);
+  VectorValues expected = Ab.optimize();
+
+  // Empty direct ordering: pure conjugate gradients
+  HybridEliminationSolver iterative(Ab, kParameters, Ordering());
+  EXPECT_LONGS_EQUAL(0, iterative.directPart().size());
+  EXPECT(assert_equal(expected, iterative.optimize(), 1e-5));
+
+  // Full direct ordering: pure elimination, exact
+  HybridEliminationSolver exact(Ab, kParameters, kOrdering);
+  EXPECT_LONGS_EQUAL(0, exact.reducedSystem().size());
+  EXPECT(assert_equal(expected, exact.optimize(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( HybridEliminationSolver, directPrefix )
+{
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  boost::tie(Ab, xtrue) = example::planarGraph(N);
+
+  // With a generous bound the whole ordering eliminates directly
+  Ordering all = HybridEliminationSolver::DirectPrefix(Ab, kOrdering, 9);
+  EXPECT_LONGS_EQUAL(kOrdering.size(), all.size());
+
+  // A tight bound truncates where the planar fronts grow too wide
+  Ordering prefix = HybridEliminationSolver::DirectPrefix(Ab, kOrdering, 2);
+  EXPECT(prefix.size() < kOrdering.size());
+
+  // The prefix still yields the exact solution through the hybrid solver
+  HybridEliminationSolver solver(Ab, kParameters, prefix);
+  EXPECT(assert_equal(Ab.optimize(), solver.optimize(), 1e-5));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
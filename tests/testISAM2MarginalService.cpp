@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testISAM2MarginalService.cpp
+ * @brief Unit tests for the background marginal covariance service
+ * @date Aug 30, 2026
+ * @author Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/ISAM2MarginalService.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Pose2.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static const SharedNoiseModel model = noiseModel::Isotropic::Sigma(3, 0.1);
+
+/* ************************************************************************* */
+// Grow a Pose2 chain pose by pose, as an odometry front-end would
+static void extendChain(ISAM2& isam, size_t from, size_t to) {
+  for (size_t i = from; i < to; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newTheta;
+    if (i == 0) {
+      newFactors.addPrior(0, Pose2(0, 0, 0), model);
+      newTheta.insert(0, Pose2(0.01, 0.01, 0.01));
+    } else {
+      newFactors.emplace_shared<BetweenFactor<Pose2> >(i - 1, i,
+          Pose2(1, 0, 0), model);
+      newTheta.insert(i, Pose2(double(i) + 0.01, -0.01, 0.01));
+    }
+    isam.update(newFactors, newTheta);
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2MarginalService, cacheMatchesDirect) {
+  ISAM2 isam;
+  extendChain(isam, 0, 5);
+  ISAM2MarginalService service(isam);
+
+  // Nothing is cached yet
+  EXPECT(!service.cachedMarginalCovariance(2));
+
+  // A synchronous query computes, caches, and agrees with ISAM2
+  Matrix expected = isam.marginalCovariance(2);
+  EXPECT(assert_equal(expected, service.marginalCovariance(2)));
+  EXPECT_LONGS_EQUAL(1, service.misses());
+
+  boost::optional<Matrix> cached = service.cachedMarginalCovariance(2);
+  CHECK(cached);
+  EXPECT(assert_equal(expected, *cached));
+  EXPECT_LONGS_EQUAL(1, service.hits());
+
+  // A second synchronous query is served from cache
+  EXPECT(assert_equal(expected, service.marginalCovariance(2)));
+  EXPECT_LONGS_EQUAL(1, service.misses());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2MarginalService, backgroundRefreshAndInvalidation) {
+  ISAM2 isam;
+  extendChain(isam, 0, 5);
+  ISAM2MarginalService service(isam);
+
+  KeyVector keys{0, 2, 4};
+  service.refresh(keys);
+  service.wait();
+
+  // All requested keys were computed in the background
+  for (Key key : keys) {
+    boost::optional<Matrix> cached = service.cachedMarginalCovariance(key);
+    CHECK(cached);
+    EXPECT(assert_equal(isam.marginalCovariance(key), *cached));
+  }
+
+  // New measurements re-eliminate up to the root, which deletes the cached
+  // separator marginals the entries were tagged with - so they go stale
+  extendChain(isam, 5, 7);
+  EXPECT(!service.cachedMarginalCovariance(4));
+
+  // A refresh recomputes them against the new tree
+  service.refresh(keys);
+  service.wait();
+  boost::optional<Matrix> cached = service.cachedMarginalCovariance(4);
+  CHECK(cached);
+  EXPECT(assert_equal(isam.marginalCovariance(4), *cached));
+
+  // Keys absent from the tree are simply ignored by refresh
+  service.refresh(KeyVector{99});
+  service.wait();
+  EXPECT(!service.cachedMarginalCovariance(99));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -80,6 +80,30 @@ TEST( Iterative, conjugateGradientDescent )
   CHECK(assert_equal(expected,actual,1e-2));
 }
 
+/* ************************************************************************* */
+TEST( Iterative, fusedConjugateGradientDescent )
+{
+  // Create factor graph and get matrices
+  GaussianFactorGraph fg = createGaussianFactorGraph();
+  Matrix A;
+  Vector b;
+  Vector x0 = Z_6x1;
+  boost::tie(A, b) = fg.jacobian();
+  Vector expectedX = (Vector(6) << -0.1, 0.1, -0.1, -0.1, 0.1, -0.2).finished();
+
+  // The fused kernel should produce the same iterates as the template version
+  System Ab(A, b);
+  Vector expected = conjugateGradientDescent(Ab, x0, parameters);
+  Vector actual = fusedConjugateGradientDescent(Ab, x0, parameters);
+  CHECK(assert_equal(expectedX, actual, 1e-9));
+  CHECK(assert_equal(expected, actual, 1e-12));
+
+  // Also check with a warm start away from zero
+  Vector x1 = (Vector(6) << 0.1, -0.2, 0.3, 0.0, -0.1, 0.2).finished();
+  CHECK(assert_equal(conjugateGradientDescent(Ab, x1, parameters),
+                     fusedConjugateGradientDescent(Ab, x1, parameters), 1e-12));
+}
+
 /* ************************************************************************* */
 TEST( Iterative, conjugateGradientDescent_hard_constraint )
 {
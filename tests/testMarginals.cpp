@@ -123,6 +123,15 @@ TEST(Marginals, planarSLAMmarginals) {
     EXPECT(assert_equal(expectedx3, marginals.marginalCovariance(x3), 1e-8));
     EXPECT(assert_equal(expectedl1, marginals.marginalCovariance(l1), 1e-8));
     EXPECT(assert_equal(expectedl2, marginals.marginalCovariance(l2), 1e-8));
+
+    // batched queries must match the per-key marginals
+    FastMap<Key, Matrix> batch =
+        marginals.marginalCovariances(KeyVector{x1, x2, x3, l1, l2});
+    EXPECT(assert_equal(expectedx1, batch.at(x1), 1e-8));
+    EXPECT(assert_equal(expectedx2, batch.at(x2), 1e-8));
+    EXPECT(assert_equal(expectedx3, batch.at(x3), 1e-8));
+    EXPECT(assert_equal(expectedl1, batch.at(l1), 1e-8));
+    EXPECT(assert_equal(expectedl2, batch.at(l2), 1e-8));
   };
 
   auto testJointMarginals = [&] (Marginals marginals) {
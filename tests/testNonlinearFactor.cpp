@@ -30,6 +30,7 @@
 #include <tests/smallExample.h>
 #include <tests/simulated2D.h>
 #include <gtsam/linear/GaussianFactor.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/inference/Symbol.h>
 
@@ -175,6 +176,36 @@ TEST( NonlinearFactor, linearize_f4 )
   CHECK(assert_equal(*expected,*actual));
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactor, linearize_fixed_dispatch )
+{
+  // Unary and binary factors over fixed-dimension values whose noise model
+  // matches the tangent dimension take the static-dimension fast path and
+  // come back as fixed-size Unary/BinaryJacobianFactor specializations.
+  Values c = createNoisyValues();
+  NonlinearFactorGraph nfg = createNonlinearFactorGraph();
+  GaussianFactorGraph::shared_ptr linearized = nfg.linearize(c);
+  typedef UnaryJacobianFactor<2, 2> Unary22;
+  typedef BinaryJacobianFactor<2, 2, 2> Binary222;
+  CHECK(boost::dynamic_pointer_cast<Unary22>((*linearized)[0]));
+  CHECK(boost::dynamic_pointer_cast<Binary222>((*linearized)[1]));
+
+  // The values agree with the generic construction...
+  GaussianFactorGraph expected = createGaussianFactorGraph();
+  CHECK(assert_equal(expected, *linearized));
+
+  // ... and so does the fixed-size Hessian update used in elimination
+  Ordering ordering;
+  ordering.push_back(X(1));
+  ordering.push_back(L(1));
+  ordering.push_back(X(2));
+  GaussianBayesNet::shared_ptr actualBN =
+      linearized->eliminateSequential(ordering, EliminateCholesky);
+  GaussianBayesNet::shared_ptr expectedBN =
+      expected.eliminateSequential(ordering, EliminateCholesky);
+  CHECK(assert_equal(*expectedBN, *actualBN));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactor, size )
 {
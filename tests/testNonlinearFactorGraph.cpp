@@ -22,12 +22,14 @@
 #include <tests/smallExample.h>
 #include <gtsam/inference/FactorGraph.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/inference/VariableIndex.h>
 #include <gtsam/symbolic/SymbolicFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/sam/RangeFactor.h>
 #include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
 
 #include <CppUnitLite/TestHarness.h>
 
@@ -116,6 +118,205 @@ TEST( NonlinearFactorGraph, linearize )
   CHECK(assert_equal(expected,linearFG)); // Needs correct linearizations
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeArena )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  Values initial = createNoisyValues();
+  GaussianFactorGraph expected = createGaussianFactorGraph();
+  Arena arena;
+  // Two rounds, with a wholesale reset in between as in an optimizer loop
+  for (size_t iteration = 0; iteration < 2; ++iteration) {
+    GaussianFactorGraph::shared_ptr linearFG = fg.linearize(initial, arena);
+    CHECK(assert_equal(expected, *linearFG));
+    linearFG.reset(); // release factors before reclaiming their memory
+    arena.reset();
+  }
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, emplaceArena )
+{
+  // Factors emplaced into an arena behave like heap-allocated ones
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(2, 1.0);
+  Arena arena;
+  {
+    NonlinearFactorGraph fg;
+    fg.reserve(3);
+    for (size_t i = 1; i <= 3; ++i)
+      fg.emplace_shared<PriorFactor<Point2> >(arena, Key(i),
+          Point2(double(i), 0), model);
+    EXPECT_LONGS_EQUAL(3, fg.size());
+    Values values;
+    for (size_t i = 1; i <= 3; ++i)
+      values.insert(Key(i), Point2(double(i), 0));
+    DOUBLES_EQUAL(0.0, fg.error(values), 1e-9);
+  } // all arena factors released before the arena
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, moveFactor )
+{
+  // An rvalue factor binds the move overload of push_back.  Factor types
+  // with move constructors transfer their measurements and noise model
+  // shared_ptrs; types whose declared destructor suppresses the implicit
+  // move constructor (most existing factors) fall back to copying.
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(2, 1.0);
+  PriorFactor<Point2> factor(Key(1), Point2(1, 2), model);
+
+  NonlinearFactorGraph fg;
+  fg.push_back(std::move(factor));
+  EXPECT_LONGS_EQUAL(1, fg.size());
+
+  Values values;
+  values.insert(Key(1), Point2(1, 2));
+  DOUBLES_EQUAL(0.0, fg.error(values), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeInPlace )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+
+  // First call allocates the layout
+  GaussianFactorGraph linearFG;
+  Values initial = createValues();
+  fg.linearizeInPlace(initial, linearFG);
+  CHECK(assert_equal(*fg.linearize(initial), linearFG));
+
+  // Second call overwrites the matrices in place; record the factor pointers
+  // to verify no reallocation happened
+  std::vector<const GaussianFactor*> pointers;
+  for (size_t i = 0; i < linearFG.size(); ++i)
+    pointers.push_back(linearFG[i].get());
+  Values noisy = createNoisyValues();
+  fg.linearizeInPlace(noisy, linearFG);
+  CHECK(assert_equal(createGaussianFactorGraph(), linearFG));
+  for (size_t i = 0; i < linearFG.size(); ++i)
+    CHECK(pointers[i] == linearFG[i].get());
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeAndEliminatePipelined )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  Values initial = createNoisyValues();
+  const Ordering ordering = Ordering::Colamd(fg);
+
+  // Must produce the same Bayes net as the sequential two-phase solve
+  GaussianBayesNet::shared_ptr expected =
+      fg.linearize(initial)->eliminateSequential(ordering);
+  GaussianFactorGraph::shared_ptr linearized;
+  GaussianBayesNet::shared_ptr actual =
+      fg.linearizeAndEliminatePipelined(initial, ordering, &linearized);
+  EXPECT(assert_equal(expected->optimize(), actual->optimize()));
+
+  // The linearized factors come back in graph order, e.g. for damped retries
+  EXPECT(assert_equal(*fg.linearize(initial), *linearized));
+
+  // An ordering that does not cover every variable is rejected
+  Ordering incomplete;
+  incomplete.push_back(ordering[0]);
+  CHECK_EXCEPTION(fg.linearizeAndEliminatePipelined(initial, incomplete), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, gradientAt )
+{
+  // The direct gradient must match linearizing and calling gradientAtZero
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  Values noisy = createNoisyValues();
+  VectorValues expected = fg.linearize(noisy)->gradientAtZero();
+  VectorValues actual = fg.gradientAt(noisy);
+  CHECK(assert_equal(expected, actual));
+
+  // Also with a robust noise model, where the loss weights enter the gradient
+  SharedNoiseModel robust = noiseModel::Robust::Create(
+      noiseModel::mEstimator::Huber::Create(0.5),
+      noiseModel::Isotropic::Sigma(2, 0.1));
+  fg.emplace_shared<PriorFactor<Point2> >(X(1), Point2(5.0, -5.0), robust);
+  expected = fg.linearize(noisy)->gradientAtZero();
+  actual = fg.gradientAt(noisy);
+  CHECK(assert_equal(expected, actual));
+
+  // A null factor slot contributes nothing rather than crashing
+  fg.push_back(NonlinearFactor::shared_ptr());
+  CHECK(assert_equal(expected, fg.gradientAt(noisy)));
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, applyDelta )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+
+  // Build and cache the index, then edit the graph through applyDelta
+  CHECK(assert_equal(VariableIndex(fg), fg.variableIndex()));
+  NonlinearFactorGraph added;
+  added.push_back(fg[1]); // duplicate an existing factor
+  FactorIndices removed;
+  removed.push_back(0);
+  FactorIndices newIndices = fg.applyDelta(added, removed);
+
+  // The added factor took the next slot, the removed slot is nulled out
+  LONGS_EQUAL(1, newIndices.size());
+  LONGS_EQUAL(4, newIndices[0]);
+  CHECK(!fg[0]);
+
+  // The incrementally maintained index matches one rebuilt from scratch
+  CHECK(assert_equal(VariableIndex(fg), fg.variableIndex()));
+}
+
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, editJournal )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  Values initial = createNoisyValues();
+
+  // Build a linear graph and a variable index at the checkpoint, and also
+  // cache the graph's own index so the journaled mutators maintain it
+  GaussianFactorGraph linearFG = *fg.linearize(initial);
+  VariableIndex index(fg);
+  CHECK(assert_equal(index, fg.variableIndex()));
+  CHECK(!fg.journaling());
+  fg.checkpoint();
+  CHECK(fg.journaling());
+
+  // Remove the prior, replace the last factor, and re-add the prior
+  NonlinearFactor::shared_ptr prior = fg[0];
+  fg.removeJournaled(0);
+  fg.replaceJournaled(3, fg[2]);
+  FactorIndex slot = fg.addJournaled(prior);
+  LONGS_EQUAL(4, slot);
+  CHECK(!fg[0]);
+
+  const GraphEditJournal& journal = fg.editsSinceCheckpoint();
+  LONGS_EQUAL(4, journal.checkpointSize);
+  LONGS_EQUAL(2, journal.editedSlots.size());
+  LONGS_EQUAL(1, journal.addedSlots.size());
+
+  // Both the journal consumer and the cached index match a full rebuild
+  fg.applyEditsTo(index);
+  CHECK(assert_equal(VariableIndex(fg), index));
+  CHECK(assert_equal(VariableIndex(fg), fg.variableIndex()));
+
+  // Relinearizing only the journaled slots matches a full relinearization
+  fg.linearizeEdits(initial, linearFG);
+  CHECK(assert_equal(*fg.linearize(initial), linearFG));
+
+  // Expressed as an ISAM2-style update: two slots to remove, two new factors
+  NonlinearFactorGraph newFactors;
+  FactorIndices removeFactorIndices;
+  fg.editsAsUpdate(newFactors, removeFactorIndices);
+  LONGS_EQUAL(2, removeFactorIndices.size());
+  LONGS_EQUAL(0, removeFactorIndices[0]);
+  LONGS_EQUAL(3, removeFactorIndices[1]);
+  LONGS_EQUAL(2, newFactors.size());
+
+  // A linear graph of the wrong vintage is rejected
+  GaussianFactorGraph stale;
+  CHECK_EXCEPTION(fg.linearizeEdits(initial, stale), std::invalid_argument);
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, clone )
 {
@@ -153,6 +354,50 @@ TEST( NonlinearFactorGraph, rekey )
   EXPECT(assert_equal(expRekey, actRekey));
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, reorderForLocality )
+{
+  // A chain of between factors, inserted so that consecutive factors never
+  // share a variable (all even links first, then all odd links)
+  const size_t numPoses = 10;
+  SharedDiagonal sigma = noiseModel::Isotropic::Sigma(3, 0.1);
+  NonlinearFactorGraph fg;
+  Values values;
+  for (size_t i = 0; i < numPoses; ++i)
+    values.insert(X(i), Pose2(0.1 * i, 0, 0));
+  for (size_t i = 0; i + 1 < numPoses; i += 2)
+    fg += BetweenFactor<Pose2>(X(i), X(i + 1), Pose2(0.1, 0, 0), sigma);
+  for (size_t i = 1; i + 1 < numPoses; i += 2)
+    fg += BetweenFactor<Pose2>(X(i), X(i + 1), Pose2(0.1, 0, 0), sigma);
+  const double expectedError = fg.error(values);
+
+  // The locality order is a permutation of all factor indices
+  FastVector<size_t> order = fg.localityOrder();
+  LONGS_EQUAL((long)fg.size(), (long)order.size());
+  set<size_t> unique(order.begin(), order.end());
+  LONGS_EQUAL((long)fg.size(), (long)unique.size());
+
+  // After reordering, every consecutive pair of chain factors shares a
+  // variable, where the insertion order shared none
+  fg.reorderForLocality();
+  for (size_t i = 0; i + 1 < fg.size(); ++i) {
+    KeySet shared;
+    for (Key key : *fg[i])
+      if (find(fg[i + 1]->begin(), fg[i + 1]->end(), key) != fg[i + 1]->end())
+        shared.insert(key);
+    EXPECT(!shared.empty());
+  }
+
+  // Same factors, same error
+  DOUBLES_EQUAL(expectedError, fg.error(values), 1e-9);
+
+  // Null factors are preserved, at the end of the order
+  fg.push_back(NonlinearFactor::shared_ptr());
+  FastVector<size_t> withNull = fg.localityOrder();
+  LONGS_EQUAL((long)fg.size(), (long)withNull.size());
+  LONGS_EQUAL((long)(fg.size() - 1), (long)withNull.back());
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, symbolic )
 {
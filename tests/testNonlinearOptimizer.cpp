@@ -17,6 +17,7 @@
 
 #include <tests/smallExample.h>
 #include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/NonlinearConjugateGradientOptimizer.h>
@@ -113,6 +114,37 @@ TEST( NonlinearOptimizer, optimize )
   DOUBLES_EQUAL(0,fg.error(actual3),tol);
 }
 
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, optimizeForDeadline )
+{
+  NonlinearFactorGraph fg(example::createReallyNonlinearFactorGraph());
+
+  Point2 x0(3,3);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  // With a generous deadline we converge as usual
+  LevenbergMarquardtOptimizer anytime(fg, c0);
+  Values generous = anytime.optimizeForDeadline(10.0);
+  DOUBLES_EQUAL(0,fg.error(generous),tol);
+
+  // With no budget at all we get the starting estimate back, unchanged
+  LevenbergMarquardtOptimizer strapped(fg, c0);
+  Values immediate = strapped.optimizeForDeadline(0.0);
+  DOUBLES_EQUAL(fg.error(c0),fg.error(immediate),tol);
+
+  // With no iteration budget, the remaining time goes to a single linear
+  // solve with prioritized partial delta application, which may never make
+  // the estimate worse
+  KeyVector priority;
+  priority.push_back(X(1));
+  LevenbergMarquardtParams params;
+  params.maxIterations = 0;
+  LevenbergMarquardtOptimizer partial(fg, c0, params);
+  Values prioritized = partial.optimizeForDeadline(10.0, priority);
+  CHECK(fg.error(prioritized) <= fg.error(c0));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearOptimizer, SimpleLMOptimizer )
 {
@@ -126,6 +158,61 @@ TEST( NonlinearOptimizer, SimpleLMOptimizer )
   DOUBLES_EQUAL(0,fg.error(actual),tol);
 }
 
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, LMLambdaRetries )
+{
+  NonlinearFactorGraph fg(example::createReallyNonlinearFactorGraph());
+
+  Point2 x0(3,3);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  // Start with a tiny lambda so early Gauss-Newton-like steps overshoot and
+  // the inner loop has to retry with larger lambdas, exercising the in-place
+  // rescaling of the cached damped system
+  LevenbergMarquardtParams lmParams;
+  lmParams.lambdaInitial = 1e-10;
+  LevenbergMarquardtOptimizer optimizer(fg, c0, lmParams);
+  Values actual = optimizer.optimize();
+  DOUBLES_EQUAL(0,fg.error(actual),tol);
+
+  // same with diagonal damping
+  lmParams.diagonalDamping = true;
+  LevenbergMarquardtOptimizer optimizer2(fg, c0, lmParams);
+  Values actual2 = optimizer2.optimize();
+  DOUBLES_EQUAL(0,fg.error(actual2),tol);
+}
+
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, IRLSReweighting )
+{
+  // Two robust priors, one of them an outlier: with Huber losses the minimum
+  // is pulled only weakly toward the outlier
+  auto robust = noiseModel::Robust::Create(
+      noiseModel::mEstimator::Huber::Create(1.0), noiseModel::Unit::Create(2));
+  NonlinearFactorGraph fg;
+  fg.emplace_shared<PriorFactor<Point2> >(X(1), Point2(0, 0), robust);
+  fg.emplace_shared<PriorFactor<Point2> >(X(1), Point2(10, 0), robust);
+
+  Values c0;
+  c0.insert(X(1), Point2(5, 0));
+
+  LevenbergMarquardtParams params;
+  params.irlsIterations = 3;
+  LevenbergMarquardtOptimizer optimizer(fg, c0, params);
+
+  // A reweighting-only pass keeps the (here constant) Jacobians, so at the
+  // same values it reproduces the full linearization exactly
+  GaussianFactorGraph::shared_ptr full = optimizer.linearize();
+  GaussianFactorGraph::shared_ptr reweighted = optimizer.linearize();
+  EXPECT(assert_equal(*full, *reweighted));
+
+  // and the optimizer converges to the same minimum as plain LM
+  Values expected = LevenbergMarquardtOptimizer(fg, c0).optimize();
+  Values actual = optimizer.optimize();
+  EXPECT(assert_equal(expected, actual, 1e-6));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearOptimizer, SimpleGNOptimizer )
 {
@@ -165,6 +165,59 @@ TEST(PCGSolver, blockjacobi) {
   DOUBLES_EQUAL(0, fg.error(actualPCG), tol);
 }
 
+/* ************************************************************************* */
+// Test mixed-precision solver mode against the exact solution
+TEST(PCGSolver, mixedPrecisionLinear) {
+  // Create a Gaussian Factor Graph
+  GaussianFactorGraph simpleGFG;
+  SharedDiagonal unit2 = noiseModel::Diagonal::Sigmas(Vector2(0.5, 0.3));
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< 10, 0, 0, 10).finished(), (Vector(2) << -1, -1).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< -10, 0, 0, -10).finished(), 0, (Matrix(2,2)<< 10, 0, 0, 10).finished(), (Vector(2) << 2, -1).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< -5, 0, 0, -5).finished(), 1, (Matrix(2,2)<< 5, 0, 0, 5).finished(), (Vector(2) << 0, 1).finished(), unit2);
+  simpleGFG += JacobianFactor(0, (Matrix(2,2)<< -5, 0, 0, -5).finished(), 1, (Matrix(2,2)<< 5, 0, 0, 5).finished(), (Vector(2) << -1, 1.5).finished(), unit2);
+  simpleGFG += JacobianFactor(0, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+  simpleGFG += JacobianFactor(1, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+
+  // Exact solution by elimination
+  VectorValues expected = simpleGFG.optimize();
+
+  // Mixed-precision PCG: float inner iterations, double refinement
+  PCGSolverParameters params;
+  params.preconditioner_ = boost::make_shared<DummyPreconditionerParameters>();
+  params.setMixedPrecision(true);
+  params.setEpsilon_abs(1e-12);
+  PCGSolver solver(params);
+  KeyInfo keyInfo(simpleGFG);
+  std::map<Key, Vector> lambda;
+  VectorValues actual = solver.optimize(simpleGFG, keyInfo, lambda,
+      VectorValues::Zero(expected));
+
+  // The double refinement recovers more accuracy than float32 alone allows
+  EXPECT(assert_equal(expected, actual, 1e-6));
+}
+
+/* ************************************************************************* */
+// Test mixed-precision solver mode inside Levenberg-Marquardt
+TEST(PCGSolver, mixedPrecision) {
+  LevenbergMarquardtParams params;
+  params.linearSolverType = LevenbergMarquardtParams::Iterative;
+  auto pcg = boost::make_shared<PCGSolverParameters>();
+  pcg->preconditioner_ = boost::make_shared<DummyPreconditionerParameters>();
+  pcg->setMixedPrecision(true);
+  params.iterativeParams = pcg;
+
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+
+  Point2 x0(10, 10);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  Values actualPCG = LevenbergMarquardtOptimizer(fg, c0, params).optimize();
+
+  DOUBLES_EQUAL(0, fg.error(actualPCG), tol);
+}
+
 /* ************************************************************************* */
 // Test Incremental Subgraph PCG Solver
 TEST(PCGSolver, subgraph) {
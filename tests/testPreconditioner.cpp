@@ -73,6 +73,11 @@ TEST( PCGsolver, verySimpleLinearSystem) {
 
   EXPECT(assert_equal(exactSolution, deltaPCGJacobi, 1e-5));
   //deltaPCGJacobi.print("PCG Jacobi");
+
+  // With incomplete Cholesky preconditioner
+  pcg->preconditioner_ = boost::make_shared<gtsam::IncompleteCholeskyPreconditionerParameters>();
+  VectorValues deltaPCGIChol = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(exactSolution, deltaPCGIChol, 1e-5));
 }
 
 /* ************************************************************************* */
@@ -122,6 +127,103 @@ TEST(PCGSolver, simpleLinearSystem) {
   EXPECT(assert_equal(expectedSolution, deltaPCGJacobi, 1e-5));
   //deltaPCGJacobi.print("PCG Jacobi");
 
+  // With incomplete Cholesky preconditioner, which keeps the off-diagonal
+  // coupling between the three variables and converges in far fewer iterations
+  pcg->preconditioner_ = boost::make_shared<gtsam::IncompleteCholeskyPreconditionerParameters>();
+  VectorValues deltaPCGIChol = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGIChol, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(PCGSolver, additiveSchwarz) {
+  // A chain of 2D variables, long enough to be split into several subdomains
+  GaussianFactorGraph chainGFG;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  chainGFG += JacobianFactor(0, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 1, -1).finished(), unit2);
+  for (size_t i = 1; i < 12; ++i)
+    chainGFG += JacobianFactor(i-1, (Matrix(2,2)<< -1, 0, 0, -1).finished(), i, (Matrix(2,2)<< 1, 0.2, -0.2, 1).finished(), (Vector(2) << 0.5, -0.3).finished(), unit2);
+
+  // Solve the system using direct method
+  VectorValues expectedSolution = chainGFG.optimize();
+
+  // Common PCG parameters
+  gtsam::PCGSolverParameters::shared_ptr pcg = boost::make_shared<gtsam::PCGSolverParameters>();
+  pcg->setMaxIterations(500);
+  pcg->setEpsilon_abs(0.0);
+  pcg->setEpsilon_rel(0.0);
+
+  // With the overlapping additive Schwarz preconditioner
+  boost::shared_ptr<gtsam::AdditiveSchwarzPreconditionerParameters> schwarz =
+      boost::make_shared<gtsam::AdditiveSchwarzPreconditionerParameters>();
+  schwarz->numDomains_ = 3;
+  schwarz->overlap_ = 1;
+  pcg->preconditioner_ = schwarz;
+  VectorValues deltaPCGSchwarz = PCGSolver(*pcg).optimize(chainGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGSchwarz, 1e-5));
+
+  // Without overlap the subdomain blocks are weaker, but still valid
+  schwarz->overlap_ = 0;
+  VectorValues deltaPCGNoOverlap = PCGSolver(*pcg).optimize(chainGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGNoOverlap, 1e-5));
+
+  // A single domain factorizes the full Hessian: PCG converges immediately
+  schwarz->numDomains_ = 1;
+  schwarz->overlap_ = 1;
+  pcg->setMaxIterations(3);
+  VectorValues deltaPCGSingle = PCGSolver(*pcg).optimize(chainGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGSingle, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(PCGSolver, monitor) {
+  // Same system as simpleLinearSystem above
+  GaussianFactorGraph simpleGFG;
+  SharedDiagonal unit2 = noiseModel::Diagonal::Sigmas(Vector2(0.5, 0.3));
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< 10, 0, 0, 10).finished(), (Vector(2) << -1, -1).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< -10, 0, 0, -10).finished(), 0, (Matrix(2,2)<< 10, 0, 0, 10).finished(), (Vector(2) << 2, -1).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< -5, 0, 0, -5).finished(), 1, (Matrix(2,2)<< 5, 0, 0, 5).finished(), (Vector(2) << 0, 1).finished(), unit2);
+  simpleGFG += JacobianFactor(0, (Matrix(2,2)<< -5, 0, 0, -5).finished(), 1, (Matrix(2,2)<< 5, 0, 0, 5).finished(), (Vector(2) << -1, 1.5).finished(), unit2);
+  simpleGFG += JacobianFactor(0, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+  simpleGFG += JacobianFactor(1, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+  simpleGFG += JacobianFactor(2, (Matrix(2,2)<< 1, 0, 0, 1).finished(), (Vector(2) << 0, 0).finished(), unit2);
+
+  gtsam::PCGSolverParameters::shared_ptr pcg = boost::make_shared<gtsam::PCGSolverParameters>();
+  pcg->setMaxIterations(500);
+  pcg->setEpsilon_abs(0.0);
+  pcg->setEpsilon_rel(0.0);
+  pcg->preconditioner_ = boost::make_shared<gtsam::BlockJacobiPreconditionerParameters>();
+
+  // Attach a monitor with a small ring buffer and a counting callback
+  IterativeSolverMonitor::shared_ptr monitor =
+      boost::make_shared<IterativeSolverMonitor>(4);
+  size_t callbackCount = 0;
+  monitor->setCallback(
+      [&callbackCount](const IterativeSolverMonitor::Sample&) { ++callbackCount; });
+  pcg->setMonitor(monitor);
+
+  VectorValues delta = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(simpleGFG.optimize(), delta, 1e-5));
+
+  // One sample per iteration went through the ring buffer and the callback
+  CHECK(monitor->totalIterations() > 0);
+  EXPECT_LONGS_EQUAL(monitor->totalIterations(), callbackCount);
+  EXPECT_LONGS_EQUAL(4, monitor->capacity());
+  CHECK(monitor->size() <= 4);
+
+  // Samples are retained oldest-first, ending with the final iteration
+  EXPECT_LONGS_EQUAL(monitor->totalIterations(),
+      monitor->sample(monitor->size() - 1).iteration);
+  EXPECT_LONGS_EQUAL(monitor->totalIterations(), monitor->last().iteration);
+  CHECK(monitor->sample(0).iteration < monitor->sample(1).iteration);
+  CHECK(monitor->last().residualNorm2 <= monitor->sample(0).residualNorm2);
+  CHECK(monitor->last().preconditionerTime >= 0.0);
+  CHECK(monitor->last().matvecTime >= 0.0);
+  CHECK_EXCEPTION(monitor->sample(4), std::out_of_range);
+
+  // reset() forgets the samples but keeps capacity and callback
+  monitor->reset();
+  EXPECT_LONGS_EQUAL(0, monitor->totalIterations());
+  CHECK_EXCEPTION(monitor->last(), std::out_of_range);
 }
 
 /* ************************************************************************* */
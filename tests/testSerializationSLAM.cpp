@@ -32,6 +32,8 @@
 #include <gtsam/sam/RangeFactor.h>
 #include <gtsam/slam/StereoFactor.h>
 #include <gtsam/nonlinear/NonlinearEquality.h>
+#include <gtsam/nonlinear/columnarSerialization.h>
+#include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/linear/GaussianISAM.h>
 #include <gtsam/base/LieVector.h>
@@ -283,6 +285,40 @@ TEST (testSerializationSLAM, smallExample_nonlinear) {
   EXPECT(equalsBinary(c1));
 }
 
+/* ************************************************************************* */
+TEST (testSerializationSLAM, smallExample_columnar) {
+  using namespace example;
+  NonlinearFactorGraph nfg = createNonlinearFactorGraph();
+
+  // The factor types above are registered, so the graph round-trips through
+  // the binary payload of the columnar container
+  const std::string filename = "testColumnarGraph.bin";
+  saveColumnar(nfg, filename);
+  NonlinearFactorGraph actual = loadColumnarNonlinearFactorGraph(filename);
+  EXPECT(assert_equal(nfg, actual));
+  remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+TEST (testSerializationSLAM, nonlinearISAM2) {
+  using namespace example;
+  NonlinearFactorGraph nfg = createNonlinearFactorGraph();
+  Values c1 = createValues();
+
+  ISAM2 isam;
+  isam.update(nfg, c1);
+
+  EXPECT(equalsObj(isam));
+  EXPECT(equalsXML(isam));
+  EXPECT(equalsBinary(isam));
+
+  // A snapshot loaded in a fresh instance supports further incremental updates
+  ISAM2 loaded;
+  roundtrip(isam, loaded);
+  loaded.update(NonlinearFactorGraph(), Values());
+  EXPECT(assert_equal(isam.calculateEstimate(), loaded.calculateEstimate()));
+}
+
 /* ************************************************************************* */
 TEST (testSerializationSLAM, factors) {
 
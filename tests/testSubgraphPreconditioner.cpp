@@ -30,7 +30,7 @@
 #include <CppUnitLite/TestHarness.h>
 
 #include <boost/archive/xml_iarchive.hpp>
-#include <boost/assign/std/list.hpp>
+#include <boost/assign/std/vector.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/serialization/export.hpp>
 #include <boost/tuple/tuple.hpp>
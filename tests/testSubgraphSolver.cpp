@@ -74,6 +74,32 @@ TEST( SubgraphSolver, splitFactorGraph )
   EXPECT_LONGS_EQUAL(13, Ab2->size());
 }
 
+/* ************************************************************************* */
+TEST( SubgraphSolver, builderCache )
+{
+  // Build a planar graph
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  std::tie(Ab, xtrue) = example::planarGraph(N); // A*x-b
+
+  SubgraphBuilderParameters params;
+  params.augmentationFactor = 0.0;
+  SubgraphBuilder builder(params);
+  auto subgraph = builder(Ab);
+
+  // Calling the builder again on a graph with identical topology returns the
+  // cached edge selection
+  auto subgraph2 = builder(Ab);
+  EXPECT(subgraph.edgeIndices() == subgraph2.edgeIndices());
+
+  // A graph with different topology invalidates the cache
+  GaussianFactorGraph Ab2;
+  VectorValues xtrue2;
+  std::tie(Ab2, xtrue2) = example::planarGraph(N + 1);
+  auto subgraph3 = builder(Ab2);
+  EXPECT_LONGS_EQUAL(16, subgraph3.size());
+}
+
 /* ************************************************************************* */
 TEST( SubgraphSolver, constructor1 )
 {
@@ -79,6 +79,59 @@ TEST(TranslationRecovery, BAL) {
   // EXPECT_DOUBLES_EQUAL(0.0199833, actualError, 1e-5);
 }
 
+/* ************************************************************************* */
+// Same problem, but solved incrementally: start from two edges, then stream
+// in the remaining measurements via update() and check we converge to the
+// same solution as the batch version.
+TEST(TranslationRecovery, Incremental) {
+  const string filename = findExampleDataFile("dubrovnik-3-7-pre");
+  SfmData db;
+  bool success = readBAL(filename, db);
+  if (!success) throw runtime_error("Could not access file!");
+
+  size_t j = 0;
+  Values poses;
+  for (auto camera : db.cameras) {
+    poses.insert(j++, camera.pose());
+  }
+
+  // Start with all three cameras constrained, so the initial batch solve is
+  // well posed, and refresh on every second update.
+  const auto initialEdges = TranslationRecovery::SimulateMeasurements(
+      poses, {{0, 1}, {0, 2}, {1, 2}});
+  TranslationRecovery algorithm(initialEdges);
+  const double scale = 2.0;
+  const Values initialResult = algorithm.initializeIncremental(scale, 2);
+  EXPECT_LONGS_EQUAL(3, initialResult.size());
+
+  // Expected solution, determined by the prior and the simulated directions
+  const Point3 Ta = poses.at<Pose3>(0).translation(),
+               Tb = poses.at<Pose3>(1).translation(),
+               Tc = poses.at<Pose3>(2).translation();
+  const Point3 expected = (Tc - Ta) * (scale / (Tb - Ta).norm());
+
+  // First update takes the ISAM2 path: redundant reverse edges should leave
+  // the solution where it is.
+  const auto reverseEdges =
+      TranslationRecovery::SimulateMeasurements(poses, {{2, 0}, {2, 1}});
+  Values result = algorithm.update(reverseEdges);
+  EXPECT(assert_equal(Point3(0, 0, 0), result.at<Point3>(0), 1e-4));
+  EXPECT(assert_equal(expected, result.at<Point3>(2), 1e-4));
+
+  // Second update triggers the periodic batch refresh.
+  const auto lastEdge =
+      TranslationRecovery::SimulateMeasurements(poses, {{1, 0}});
+  result = algorithm.update(lastEdge);
+  EXPECT(assert_equal(Point3(0, 0, 0), result.at<Point3>(0), 1e-4));
+  EXPECT(assert_equal(expected, result.at<Point3>(2), 1e-4));
+
+  // A duplicate KeyPair is ignored, and update before initialization throws.
+  result = algorithm.update(lastEdge);
+  EXPECT(assert_equal(expected, result.at<Point3>(2), 1e-4));
+  TranslationRecovery uninitialized(initialEdges);
+  CHECK_EXCEPTION(uninitialized.update(lastEdge), std::runtime_error);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
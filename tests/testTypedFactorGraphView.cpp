@@ -0,0 +1,92 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testTypedFactorGraphView.cpp
+ * @brief   Unit tests for statically typed factor graph views
+ * @author  Frank Dellaert
+ */
+
+#include <gtsam/nonlinear/TypedFactorGraphView.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Pose2.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+static SharedNoiseModel priorModel(noiseModel::Isotropic::Sigma(3, 0.1));
+static SharedNoiseModel odoModel(noiseModel::Isotropic::Sigma(3, 0.2));
+
+/* ************************************************************************* */
+// A small pose chain: one prior and a string of between factors, the
+// homogeneous section a view is meant to peel off
+static NonlinearFactorGraph createPoseChain(size_t n) {
+  NonlinearFactorGraph graph;
+  graph.push_back(PriorFactor<Pose2>(0, Pose2(0, 0, 0), priorModel));
+  for (size_t i = 1; i < n; i++)
+    graph.push_back(
+        BetweenFactor<Pose2>(i - 1, i, Pose2(1, 0, 0.1), odoModel));
+  return graph;
+}
+
+static Values createPoseChainValues(size_t n) {
+  Values values;
+  for (size_t i = 0; i < n; i++)
+    values.insert(i, Pose2(1.05 * i, 0.1 * i, 0.1 * i + 0.01));
+  return values;
+}
+
+/* ************************************************************************* */
+TEST(TypedFactorGraphView, partition) {
+  NonlinearFactorGraph graph = createPoseChain(5);
+
+  TypedFactorGraphView<BetweenFactor<Pose2> > view(graph);
+  EXPECT_LONGS_EQUAL(4, view.typed().size());
+  EXPECT_LONGS_EQUAL(1, view.rest().size());
+
+  // Views can be nested to peel off a second type
+  TypedFactorGraphView<PriorFactor<Pose2> > view2(view.rest());
+  EXPECT_LONGS_EQUAL(1, view2.typed().size());
+  EXPECT_LONGS_EQUAL(0, view2.rest().size());
+}
+
+/* ************************************************************************* */
+TEST(TypedFactorGraphView, error) {
+  NonlinearFactorGraph graph = createPoseChain(5);
+  Values values = createPoseChainValues(5);
+
+  TypedFactorGraphView<BetweenFactor<Pose2> > view(graph);
+  DOUBLES_EQUAL(graph.error(values), view.error(values), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(TypedFactorGraphView, linearize) {
+  NonlinearFactorGraph graph = createPoseChain(5);
+  Values values = createPoseChainValues(5);
+
+  TypedFactorGraphView<BetweenFactor<Pose2> > view(graph);
+  GaussianFactorGraph::shared_ptr actual = view.linearize(values);
+  GaussianFactorGraph::shared_ptr expected = graph.linearize(values);
+
+  // The view groups the typed factors first, so compare the summed systems
+  EXPECT_LONGS_EQUAL(expected->size(), actual->size());
+  EXPECT(assert_equal(expected->augmentedHessian(), actual->augmentedHessian()));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,225 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    benchmark.h
+ * @brief   Small benchmark harness for the timing scripts: warmup,
+ *          iterations-until-stable, median/MAD statistics, JSON output and
+ *          baseline regression gating
+ * @date    Aug 2020
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+namespace benchmark {
+
+/// Statistics for one benchmark, all times in microseconds per call
+struct Result {
+  std::string name;
+  size_t iterationsPerSample;  ///< calls batched per timed sample
+  size_t samples;              ///< number of timed samples taken
+  double medianUs;             ///< median time per call
+  double madUs;                ///< median absolute deviation per call
+  double minUs;                ///< fastest sample per call
+};
+
+/// Sink that defeats dead-code elimination of benchmark kernels
+inline void doNotOptimizeAway(double value) {
+  static volatile double sink;
+  sink = value;
+}
+
+namespace internal {
+
+inline double median(std::vector<double> v) {
+  std::sort(v.begin(), v.end());
+  const size_t n = v.size();
+  return (n % 2 == 1) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+}  // namespace internal
+
+/**
+ * Run one kernel: warm it up, pick a batch size so each timed sample lasts
+ * long enough to be meaningful, then sample repeatedly until the requested
+ * number of samples is collected.  Reports median and median absolute
+ * deviation (MAD), which unlike mean/stddev are robust to the occasional
+ * sample inflated by a context switch.
+ */
+inline Result runBenchmark(const std::string& name,
+    const std::function<void()>& kernel, size_t nrSamples = 20,
+    double minSampleSeconds = 0.01) {
+  typedef std::chrono::steady_clock Clock;
+  using std::chrono::duration;
+
+  // Warmup, also yielding a first per-call estimate
+  size_t batch = 1;
+  for (;;) {
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < batch; i++)
+      kernel();
+    const double seconds = duration<double>(Clock::now() - start).count();
+    if (seconds >= minSampleSeconds)
+      break;
+    // Grow towards a batch that fills minSampleSeconds
+    batch = (seconds > 0) ?
+        std::max(batch + 1, static_cast<size_t>(
+            batch * 1.2 * minSampleSeconds / seconds)) : batch * 10;
+  }
+
+  // Collect samples
+  std::vector<double> perCallUs;
+  perCallUs.reserve(nrSamples);
+  for (size_t s = 0; s < nrSamples; s++) {
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < batch; i++)
+      kernel();
+    const double seconds = duration<double>(Clock::now() - start).count();
+    perCallUs.push_back(seconds * 1e6 / static_cast<double>(batch));
+  }
+
+  Result result;
+  result.name = name;
+  result.iterationsPerSample = batch;
+  result.samples = nrSamples;
+  result.medianUs = internal::median(perCallUs);
+  std::vector<double> deviations;
+  deviations.reserve(perCallUs.size());
+  for (double t : perCallUs)
+    deviations.push_back(std::fabs(t - result.medianUs));
+  result.madUs = internal::median(deviations);
+  result.minUs = *std::min_element(perCallUs.begin(), perCallUs.end());
+  return result;
+}
+
+/// Print one result in human-readable form
+inline void print(const Result& r, std::ostream& os = std::cout) {
+  os << std::left << std::setw(32) << r.name << std::right
+     << std::setprecision(4) << std::setw(12) << r.medianUs << " us/call"
+     << "  (MAD " << std::setprecision(2) << r.madUs << ", min "
+     << std::setprecision(4) << r.minUs << ", " << r.samples << " x "
+     << r.iterationsPerSample << " iters)" << std::endl;
+}
+
+/// Write all results as a machine-readable JSON array
+inline void writeJson(const std::vector<Result>& results, std::ostream& os) {
+  os << "[\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    os << "  {\"name\": \"" << r.name << "\", \"median_us\": " << r.medianUs
+       << ", \"mad_us\": " << r.madUs << ", \"min_us\": " << r.minUs
+       << ", \"iterations\": " << r.iterationsPerSample
+       << ", \"samples\": " << r.samples << "}"
+       << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  os << "]\n";
+}
+
+/**
+ * Compare results against a baseline JSON file previously written by
+ * writeJson.  Returns the number of benchmarks whose median exceeds the
+ * baseline median by more than the given relative tolerance, printing one
+ * line per regression - suitable for gating a release script on exit code.
+ */
+inline size_t compareToBaseline(const std::vector<Result>& results,
+    const std::string& baselineFile, double tolerance = 0.2) {
+  std::ifstream is(baselineFile.c_str());
+  if (!is) {
+    std::cout << "benchmark: could not read baseline " << baselineFile
+              << std::endl;
+    return 0;
+  }
+  size_t regressions = 0;
+  std::string line;
+  while (std::getline(is, line)) {
+    // Each baseline entry is one line; pick out the name and median fields
+    const size_t namePos = line.find("\"name\": \"");
+    const size_t medianPos = line.find("\"median_us\": ");
+    if (namePos == std::string::npos || medianPos == std::string::npos)
+      continue;
+    const size_t nameStart = namePos + std::strlen("\"name\": \"");
+    const std::string name = line.substr(nameStart,
+        line.find('"', nameStart) - nameStart);
+    const double baselineUs = std::atof(
+        line.c_str() + medianPos + std::strlen("\"median_us\": "));
+    for (const Result& r : results) {
+      if (r.name != name)
+        continue;
+      if (baselineUs > 0 && r.medianUs > baselineUs * (1.0 + tolerance)) {
+        std::cout << "REGRESSION " << name << ": " << std::setprecision(4)
+                  << r.medianUs << " us/call vs baseline " << baselineUs
+                  << " us/call" << std::endl;
+        ++regressions;
+      }
+    }
+  }
+  return regressions;
+}
+
+/**
+ * Command-line options shared by benchmark mains:
+ *   --filter=substr    only run benchmarks whose name contains substr
+ *   --json=file        write results to file as JSON
+ *   --baseline=file    compare against a previous JSON run
+ *   --tolerance=frac   relative slowdown tolerated before gating (default 0.2)
+ */
+struct Options {
+  std::string filter, jsonFile, baselineFile;
+  double tolerance;
+
+  Options(int argc, char* argv[]) : tolerance(0.2) {
+    for (int i = 1; i < argc; i++) {
+      const std::string arg = argv[i];
+      if (arg.compare(0, 9, "--filter=") == 0)
+        filter = arg.substr(9);
+      else if (arg.compare(0, 7, "--json=") == 0)
+        jsonFile = arg.substr(7);
+      else if (arg.compare(0, 11, "--baseline=") == 0)
+        baselineFile = arg.substr(11);
+      else if (arg.compare(0, 12, "--tolerance=") == 0)
+        tolerance = std::atof(arg.substr(12).c_str());
+      else
+        std::cout << "benchmark: unknown option " << arg << std::endl;
+    }
+  }
+
+  /// true if this benchmark should run under the current filter
+  bool selected(const std::string& name) const {
+    return filter.empty() || name.find(filter) != std::string::npos;
+  }
+
+  /// Write/compare per the options; returns the number of regressions
+  size_t finish(const std::vector<Result>& results) const {
+    if (!jsonFile.empty()) {
+      std::ofstream os(jsonFile.c_str());
+      writeJson(results, os);
+    }
+    if (!baselineFile.empty())
+      return compareToBaseline(results, baselineFile, tolerance);
+    return 0;
+  }
+};
+
+}  // namespace benchmark
+}  // namespace gtsam
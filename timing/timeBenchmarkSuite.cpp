@@ -0,0 +1,112 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBenchmarkSuite.cpp
+ * @brief   Unified microkernel benchmarks (linearize, eliminate,
+ *          backsubstitute, retract) with stable statistics and JSON output,
+ *          for detecting performance regressions between releases.
+ *          Run with --json=file to record a baseline, then with
+ *          --baseline=file on a candidate build; a nonzero exit code means
+ *          at least one kernel regressed beyond --tolerance.
+ * @date    Aug 2020
+ */
+
+#include "benchmark.h"
+
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/inference/Symbol.h>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam::benchmark;
+using symbol_shorthand::X;
+
+static const size_t kChainLength = 30;
+
+/* ************************************************************************* */
+// A Pose3 odometry chain, the workhorse graph shape in the timing scripts
+static NonlinearFactorGraph makeChain() {
+  NonlinearFactorGraph graph;
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(6, 0.1);
+  graph.emplace_shared<PriorFactor<Pose3> >(X(0), Pose3(), model);
+  for (size_t i = 0; i + 1 < kChainLength; i++)
+    graph.emplace_shared<BetweenFactor<Pose3> >(X(i), X(i + 1),
+        Pose3(Rot3::Rodrigues(0.1, 0.2, 0.3), Point3(1, 0, 0)), model);
+  return graph;
+}
+
+static Values makeChainValues() {
+  Values values;
+  for (size_t i = 0; i < kChainLength; i++)
+    values.insert(X(i), Pose3(Rot3::Rodrigues(0.01 * i, 0.02 * i, -0.01 * i),
+        Point3(static_cast<double>(i), 0, 0)));
+  return values;
+}
+
+/* ************************************************************************* */
+int main(int argc, char* argv[]) {
+  Options options(argc, argv);
+  vector<Result> results;
+
+  const NonlinearFactorGraph graph = makeChain();
+  const Values values = makeChainValues();
+  const GaussianFactorGraph::shared_ptr linearized = graph.linearize(values);
+  const GaussianBayesNet bayesNet = *linearized->eliminateSequential();
+  const VectorValues delta = values.zeroVectors();
+
+  // Linearize a single binary factor - the inner loop of every optimizer
+  if (options.selected("linearize")) {
+    const NonlinearFactor::shared_ptr factor = graph.front();
+    results.push_back(runBenchmark("linearize/BetweenFactorPose3", [&]() {
+      GaussianFactor::shared_ptr gf = factor->linearize(values);
+      doNotOptimizeAway(static_cast<double>(gf->size()));
+    }));
+  }
+
+  // Eliminate an odometry chain to a Bayes net
+  if (options.selected("eliminate")) {
+    results.push_back(runBenchmark("eliminate/chain30", [&]() {
+      GaussianBayesNet::shared_ptr bn = linearized->eliminateSequential();
+      doNotOptimizeAway(static_cast<double>(bn->size()));
+    }));
+  }
+
+  // Backsubstitute through the eliminated chain
+  if (options.selected("backsubstitute")) {
+    results.push_back(runBenchmark("backsubstitute/chain30", [&]() {
+      VectorValues x = bayesNet.optimize();
+      doNotOptimizeAway(x[X(0)][0]);
+    }));
+  }
+
+  // Retract a full Values - the nonlinear update step
+  if (options.selected("retract")) {
+    results.push_back(runBenchmark("retract/Pose3x30", [&]() {
+      Values retracted = values.retract(delta);
+      doNotOptimizeAway(static_cast<double>(retracted.size()));
+    }));
+  }
+
+  for (const Result& r : results)
+    print(r);
+
+  const size_t regressions = options.finish(results);
+  return regressions == 0 ? 0 : 1;
+}
+/* ************************************************************************* */